@@ -63,10 +63,14 @@ float SampleShadowFactor(uint texIndex, float4x4 lightViewProj, float4 atlasRect
 	const float bias = ShadowBias + ShadowBias * 4.0 * (1.0 - NdotL);
 	const float currentDepth = ndc.z - bias;
 
-	// Atlas remap + tile clamp bounds (in atlas UV space). ShadowTexelSize is per full-texture texel;
-	// scale by the rect so a tile's PCF step matches its sub-resolution.
+	// Atlas remap + tile clamp bounds (in atlas UV space). The PCF step is one texel of THIS tile in light
+	// UV: atlas tiles vary in size per light (ShadowAtlasAllocator), so it comes from the texture size and
+	// the rect rather than the global ShadowTexelSize (for a cascade, rect = 0..1, the two agree).
 	const float2 rectMin = atlasRect.xy;
 	const float2 rectMax = atlasRect.xy + atlasRect.zw;
+	uint mapWidth, mapHeight;
+	Textures[NonUniformResourceIndex(texIndex)].GetDimensions(mapWidth, mapHeight);
+	const float2 tileTexel = 1.0 / (float2(mapWidth, mapHeight) * atlasRect.zw);
 
 	// Hardware PCF (#60): SampleCmpLevelZero does the depth compare + bilinear filtering of the 0/1 results
 	// in ONE texture op (a 2x2 comparison-filtered tap), replacing the manual Sample()+compare. The soft
@@ -80,7 +84,7 @@ float SampleShadowFactor(uint texIndex, float4x4 lightViewProj, float4 atlasRect
 		{
 			[unroll] for (int dx = -1; dx <= 1; ++dx)
 			{
-				const float2 tap = lightUV + float2(dx, dy) * ShadowTexelSize;
+				const float2 tap = lightUV + float2(dx, dy) * tileTexel;
 				const float2 atlasUV = clamp(atlasRect.xy + tap * atlasRect.zw, rectMin, rectMax);
 				sum += Textures[NonUniformResourceIndex(texIndex)].SampleCmpLevelZero(ShadowCmpSampler, atlasUV, currentDepth);
 			}
@@ -213,8 +217,40 @@ float RayTraceSoftShadow(float3 positionWS, float3 Ng, float3 L, float tMax, flo
 // RayTraceShadow / RayTraceSoftShadow STAY above — the primary sun/point/spot lighting still traces them.
 #endif
 
-// Directional-sun shadow: RT ray query (when RTShadowEnabled) or the raster shadow map (dedicated map,
-// gated by ShadowMapIndex; 0 = no shadows). `Ng`/`L`/`pixelPos` are only used by the RT path.
+// Width of the cascade blend band, in light UV from a cascade's edge: a point that deep into the border of
+// its cascade lerps toward the next one, so the texel-density step between cascades doesn't read as a seam.
+static const float CASCADE_BLEND_BAND = 0.08;
+
+// Raster sun shadow through the cascades (1 = lit). The cascades are nested bounding spheres of successive
+// view slices, so the first one whose map covers the point is the sharpest that can answer -- selecting by
+// map footprint rather than by view depth keeps the lookup valid for every viewport, not only the camera
+// the cascades were fitted to. Past the last cascade (render.shadow.distance) the sun is unshadowed.
+float SampleSunCascades(float3 positionWS, float3 Ng, float NdotL)
+{
+	for (uint i = 0; i < CascadeCount; ++i)
+	{
+		// Orthographic: w == 1, so clip xy is the footprint directly.
+		const float2 uv = mul(float4(positionWS, 1.0), CascadeViewProj[i]).xy * 0.5 + 0.5;
+		const float edge = min(min(uv.x, uv.y), min(1.0 - uv.x, 1.0 - uv.y));
+		if (edge <= ShadowTexelSize)
+		{
+			continue; // outside this cascade (or in its last PCF texel): try the next, coarser one
+		}
+
+		float visibility = SampleShadowFactor(CascadeMapIndex[i], CascadeViewProj[i], float4(0, 0, 1, 1), positionWS, Ng, NdotL);
+		const float blend = saturate(edge / CASCADE_BLEND_BAND);
+		if (blend < 1.0 && i + 1 < CascadeCount)
+		{
+			const float next = SampleShadowFactor(CascadeMapIndex[i + 1], CascadeViewProj[i + 1], float4(0, 0, 1, 1), positionWS, Ng, NdotL);
+			visibility = lerp(next, visibility, blend);
+		}
+		return visibility;
+	}
+	return 1.0;
+}
+
+// Directional-sun shadow: RT ray query (when RTShadowEnabled) or the raster cascades (CascadeCount 0 = no
+// shadows). `Ng`/`L`/`pixelPos` are only used by the RT path.
 float SampleSunShadow(float3 positionWS, float3 Ng, float3 L, float NdotL, float2 pixelPos)
 {
 #ifdef SS_RAYTRACING
@@ -229,11 +265,7 @@ float SampleSunShadow(float3 positionWS, float3 Ng, float3 L, float NdotL, float
 		return RayTraceShadow(positionWS, Ng, L, 1e30);
 	}
 #endif
-	if (ShadowMapIndex == 0)
-	{
-		return 1.0;
-	}
-	return SampleShadowFactor(ShadowMapIndex, LightViewProj, float4(0, 0, 1, 1), positionWS, Ng, NdotL);
+	return SampleSunCascades(positionWS, Ng, NdotL);
 }
 
 // Spot shadow: RT ray query (when RTShadowEnabled and this spot casts) or the shared raster atlas at the
@@ -285,7 +317,7 @@ int PointShadowFace(float3 dir)
 	return dir.z >= 0.0 ? 4 : 5; // +Z : -Z
 }
 
-// Point (omni) shadow: RT ray query (when RTShadowEnabled and this light casts) or the raster point atlas.
+// Point (omni) shadow: RT ray query (when RTShadowEnabled and this light casts) or the raster shadow atlas.
 // `Ng` = geometric normal (ray offset), `L` = direction to the light, `distToLight` = ray length for RT.
 // Raster path picks the cube face the surface lies on and PCF-samples that face's tile, gated by the atlas
 // being bound AND a shadow slot assigned (ShadowSlot >= 0); RT path gated by ShadowSlot >= 0 alone.
@@ -633,13 +665,31 @@ float4 main(PSInput i) : SV_Target0
 		}
 	}
 
+	// Positional lights come from the clustered grid: only the lights binned into this fragment's froxel
+	// (ascending index order) instead of every light in the scene. With no grid for this view (or
+	// render.lights.clustered off) the lists are simply the whole buffers.
+	const bool clustered = ClusterEnabled != 0;
+	uint pointFirst = 0;
+	uint pointCount = uint(max(PointCount, 0));
+	uint spotFirst = 0;
+	uint spotCount = uint(max(SpotCount, 0));
+	if (clustered)
+	{
+		const LightCluster cluster = LightClusters[GetLightClusterIndex(i.PositionWS)];
+		pointFirst = cluster.Offset;
+		pointCount = cluster.PointCount;
+		spotFirst = cluster.Offset + cluster.PointCount;
+		spotCount = cluster.SpotCount;
+	}
+
 	// --- Point lights: inverse-square falloff with a smooth windowed cutoff at Range (UE4/Frostbite).
-	const int pointCount = clamp(PointCount, 0, MAX_POINT_LIGHTS);
-	[loop] for (int p = 0; p < pointCount; ++p)
+	[loop] for (uint pk = 0; pk < pointCount; ++pk)
 	{
-		const float3 toLight = PointLights[p].Position - i.PositionWS;
+		const uint p = clustered ? LightIndices[pointFirst + pk] : pk;
+		const PointLight light = PointLightBuffer[p];
+		const float3 toLight = light.Position - i.PositionWS;
 		const float dist = length(toLight);
-		const float range = max(PointLights[p].Range, 1e-4);
+		const float range = max(light.Range, 1e-4);
 		if (dist >= range) // range cull (lossless: falloff is 0 at d >= range)
 		{
 			continue;
@@ -649,9 +699,10 @@ float4 main(PSInput i) : SV_Target0
 		const float window = pow(saturate(1.0 - pow(dist / range, 4.0)), 2.0);
 		const float atten = window / max(dist * dist, 1e-4);
 		const float ndl = max(dot(N, L), 0.0);
-		const float3 radiance = PointLights[p].Color * PointLights[p].Intensity * atten;
+		const float3 radiance = light.Color * light.Intensity * atten;
 
-		if (useShadowTex)
+		// Only the first RT_SHADOW_MAX_POINT_LIGHTS are in the stochastic shadow signal.
+		if (useShadowTex && p < uint(RT_SHADOW_MAX_POINT_LIGHTS))
 		{
 			float3 diff, spec;
 			ShadePBRSplit(N, V, L, F0, albedo, metallic, roughness, radiance, diff, spec);
@@ -660,38 +711,39 @@ float4 main(PSInput i) : SV_Target0
 		}
 		else
 		{
-			const float pointShadow = SamplePointShadow(PointLights[p], i.PositionWS, N, L, dist, ndl, i.PositionCS.xy);
+			const float pointShadow = SamplePointShadow(light, i.PositionWS, N, L, dist, ndl, i.PositionCS.xy);
 			Lo += ShadePBR(N, V, L, F0, albedo, metallic, roughness, radiance) * pointShadow;
 		}
 	}
 
 	// --- Spot lights: point attenuation * smooth cone falloff.
-	const int spotCount = clamp(SpotCount, 0, MAX_SPOT_LIGHTS);
-	[loop] for (int s = 0; s < spotCount; ++s)
+	[loop] for (uint sk = 0; sk < spotCount; ++sk)
 	{
-		const float3 toLight = SpotLights[s].Position - i.PositionWS;
+		const uint s = clustered ? LightIndices[spotFirst + sk] : sk;
+		const SpotLight light = SpotLightBuffer[s];
+		const float3 toLight = light.Position - i.PositionWS;
 		const float dist = length(toLight);
-		const float range = max(SpotLights[s].Range, 1e-4);
+		const float range = max(light.Range, 1e-4);
 		if (dist >= range) // range cull
 		{
 			continue;
 		}
 
 		const float3 L = toLight / max(dist, 1e-4);
-		const float cosAngle = dot(-L, SpotLights[s].Direction);
-		if (cosAngle <= SpotLights[s].CosOuter) // cone cull
+		const float cosAngle = dot(-L, light.Direction);
+		if (cosAngle <= light.CosOuter) // cone cull
 		{
 			continue;
 		}
 
 		const float window = pow(saturate(1.0 - pow(dist / range, 4.0)), 2.0);
 		const float atten = window / max(dist * dist, 1e-4);
-		const float denom = max(SpotLights[s].CosInner - SpotLights[s].CosOuter, 1e-4);
-		const float cone = pow(saturate((cosAngle - SpotLights[s].CosOuter) / denom), 2.0);
+		const float denom = max(light.CosInner - light.CosOuter, 1e-4);
+		const float cone = pow(saturate((cosAngle - light.CosOuter) / denom), 2.0);
 		const float ndl = max(dot(N, L), 0.0);
-		const float3 radiance = SpotLights[s].Color * SpotLights[s].Intensity * atten * cone;
+		const float3 radiance = light.Color * light.Intensity * atten * cone;
 
-		if (useShadowTex)
+		if (useShadowTex && s < uint(RT_SHADOW_MAX_SPOT_LIGHTS))
 		{
 			float3 diff, spec;
 			ShadePBRSplit(N, V, L, F0, albedo, metallic, roughness, radiance, diff, spec);
@@ -700,7 +752,7 @@ float4 main(PSInput i) : SV_Target0
 		}
 		else
 		{
-			const float spotShadow = SampleSpotShadow(SpotLights[s], i.PositionWS, N, L, dist, ndl, i.PositionCS.xy);
+			const float spotShadow = SampleSpotShadow(light, i.PositionWS, N, L, dist, ndl, i.PositionCS.xy);
 			Lo += ShadePBR(N, V, L, F0, albedo, metallic, roughness, radiance) * spotShadow;
 		}
 	}
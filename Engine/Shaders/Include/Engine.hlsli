@@ -26,7 +26,7 @@ struct PointLight
 	float3 ShadowPad;
 };
 
-// 6-face shadow payload for one shadow-casting point light (cube unrolled into the point atlas). Mirrors
+// 6-face shadow payload for one shadow-casting point light (cube unrolled into the shadow atlas). Mirrors
 // GPUPointShadow in LightingUniforms.hpp field-for-field. Face order = +X,-X,+Y,-Y,+Z,-Z.
 struct PointShadow
 {
@@ -72,9 +72,20 @@ struct PSInput
 };
 
 static const int MAX_DIRECTIONAL_LIGHTS = 4;
-static const int MAX_POINT_LIGHTS = 16;
-static const int MAX_SPOT_LIGHTS = 16;
-static const int MAX_SHADOW_POINTS = 2; // hard cap on shadow-casting point lights (6 depth passes each)
+static const int MAX_SHADOW_POINTS = 8; // cap on shadow-casting point lights (6 atlas tiles each); mirrors LightingUniforms.hpp
+static const uint MAX_SHADOW_CASCADES = 4; // directional-sun cascades; mirrors kMaxShadowCascades (ShadowCascades.hpp)
+
+// Clustered light grid: 16x9 NDC tiles x 24 exponential depth slices. Mirrors kLightClusterTilesX/Y and
+// kLightClusterSlices in LightClusters.hpp.
+static const uint CLUSTER_TILES_X = 16;
+static const uint CLUSTER_TILES_Y = 9;
+static const uint CLUSTER_SLICES = 24;
+
+// The stochastic RT shadow pass (Shadow.comp) traces only the first SHADOW_MAX_POINT / SHADOW_MAX_SPOT
+// lights of each buffer; DefaultLit shades the rest directly (SamplePointShadow / SampleSpotShadow) instead
+// of through the denoised irradiance. Mirrors the constants in Shadow.comp.hlsl and RTShadowPass.cpp.
+static const int RT_SHADOW_MAX_POINT_LIGHTS = 16;
+static const int RT_SHADOW_MAX_SPOT_LIGHTS = 16;
 
 // --- SPACE 0: Global Frame Data ---
 cbuffer FrameCB : register(b0, space0)
@@ -84,26 +95,29 @@ cbuffer FrameCB : register(b0, space0)
 	float4x4 PrevViewProj; // last frame's VP -- motion vectors (#44); mirrors FrameCB in RendererService.cpp
 	float3 CameraPosition;
 	float Exposure; // linear pre-tonemap multiplier (was _Pad0; same 16-byte slot)
+	// Light block: mirrors GPULightConstants in LightingUniforms.hpp field-for-field. The point/spot lights
+	// themselves live in PointLightBuffer / SpotLightBuffer below; PointCount/SpotCount are their lengths.
 	DirectionalLight DirectionalLights[4];
 	int LightCount;
-	float3 _Pad1;
-
-	// Positional lights. Appended after the directional block; mirrors LightDataBlock's tail (each count
-	// followed by a float3 pad to keep the next array 16-byte aligned).
-	PointLight PointLights[16];
 	int PointCount;
-	float3 _PointPad;
-
-	SpotLight SpotLights[16];
 	int SpotCount;
-	float3 _SpotPad;
+	int _Pad1;
 
-	// Point (omni) shadow payloads, indexed by PointLight.ShadowSlot. Appended at the light block's tail
-	// so no existing offset moves; mirrors LightDataBlock's tail in LightingUniforms.hpp field-for-field.
-	PointShadow PointShadows[2]; // MAX_SHADOW_POINTS
+	// Point (omni) shadow payloads, indexed by PointLight.ShadowSlot.
+	PointShadow PointShadows[8]; // MAX_SHADOW_POINTS
 	int PointShadowCount;
 	float3 _PointShadowPad;
 
+	// Clustered light grid (GPULightClusterParams): view depth = dot(ClusterDepthPlane.xyz, P) + .w, slice =
+	// floor(log2(depth) * ClusterDepthScale + ClusterDepthBias). ClusterEnabled == 0 -> no grid for this view;
+	// walk the whole light buffers. ClusterFirst is this view's first element in LightClusters (a frame's
+	// views share the buffer).
+	float4 ClusterDepthPlane;
+	float ClusterDepthScale;
+	float ClusterDepthBias;
+	uint ClusterEnabled;
+	uint ClusterFirst;
+
 	// Environment: shared by the sky pass and the DefaultLit ambient term. Mirrors the FrameCB tail in
 	// RendererSingleton.cpp field-for-field (each float3 register-packed with the trailing float).
 	float3 SkyZenithColor;
@@ -113,17 +127,18 @@ cbuffer FrameCB : register(b0, space0)
 	float3 GroundColor;
 	float _EnvPad1;
 
-	// Directional shadow (sun). LightViewProj reprojects world -> light clip; ShadowMapIndex is the
-	// bindless depth-texture index (0 = no shadows). Mirrors the FrameCB tail in RendererSingleton.cpp.
-	float4x4 LightViewProj;
-	uint ShadowMapIndex;
+	// Directional shadow (sun). CascadeViewProj[i] reprojects world -> cascade i's light clip; CascadeCount
+	// is how many are live (0 = no shadows). Mirrors the FrameCB tail in RendererService.cpp.
+	float4x4 CascadeViewProj[MAX_SHADOW_CASCADES];
+	uint CascadeCount;
 	float ShadowBias;
 	float ShadowTexelSize;
 	float ShadowStrength;
 	uint ShadowSoft;            // 1 = 3x3 PCF, 0 = hard single tap
-	uint SpotShadowAtlasIndex;  // bindless index of the spot shadow atlas (0 = spots unshadowed)
-	uint PointShadowAtlasIndex; // bindless index of the point shadow atlas (0 = points unshadowed)
+	uint SpotShadowAtlasIndex;  // bindless index of the shadow atlas when a spot casts (0 = spots unshadowed)
+	uint PointShadowAtlasIndex; // same atlas when a point casts (0 = points unshadowed)
 	float ShadowNormalOffset;   // #59: normal-offset bias, world units (see RendererService FrameCB)
+	uint4 CascadeMapIndex;      // bindless depth-texture index of each cascade
 
 	// IBL: bindless indices of the baked maps (irradiance + prefiltered in Cubemaps[], BRDF LUT in
 	// Textures[]); 0 = IBL off (analytic hemisphere ambient). PrefilteredMipCount maps roughness->lod.
@@ -241,6 +256,35 @@ cbuffer FrameCB : register(b0, space0)
 	uint _FramePad2;
 };
 
+// Positional lights and the clustered index list (set 0, beside FrameCB). One froxel's list is PointCount
+// point-light indices starting at Offset, then SpotCount spot-light indices. Mirrors GPULightCluster in
+// LightClusters.hpp.
+struct LightCluster
+{
+	uint Offset;
+	uint PointCount;
+	uint SpotCount;
+	uint Pad;
+};
+
+StructuredBuffer<PointLight> PointLightBuffer : register(t1, space0);
+StructuredBuffer<SpotLight> SpotLightBuffer : register(t2, space0);
+StructuredBuffer<LightCluster> LightClusters : register(t3, space0);
+StructuredBuffer<uint> LightIndices : register(t4, space0);
+
+// The froxel (index into LightClusters, ClusterFirst included) a world position falls in. The CPU twin is LightClusterIndexAt in
+// LightClusters.cpp -- keep the two in lockstep. Only meaningful when ClusterEnabled != 0.
+uint GetLightClusterIndex(float3 positionWS)
+{
+	const float4 clip = mul(float4(positionWS, 1.0), ViewProj);
+	const float2 ndc = clip.xy / clip.w;
+	const int tx = clamp(int(floor((ndc.x * 0.5 + 0.5) * CLUSTER_TILES_X)), 0, int(CLUSTER_TILES_X) - 1);
+	const int ty = clamp(int(floor((ndc.y * 0.5 + 0.5) * CLUSTER_TILES_Y)), 0, int(CLUSTER_TILES_Y) - 1);
+	const float depth = dot(ClusterDepthPlane.xyz, positionWS) + ClusterDepthPlane.w;
+	const float slice = clamp(floor(log2(max(depth, 1e-4)) * ClusterDepthScale + ClusterDepthBias), 0.0, float(CLUSTER_SLICES - 1));
+	return ClusterFirst + (uint(slice) * CLUSTER_TILES_Y + uint(ty)) * CLUSTER_TILES_X + uint(tx);
+}
+
 // --- SPACE 1: Material Data ---
 // MUST match Material::Constants in Snowstorm/Render/Material.hpp field-for-field (16-byte rows).
 cbuffer MaterialCB : register(b0, space1)
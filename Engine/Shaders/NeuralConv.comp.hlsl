@@ -22,6 +22,13 @@
 //     weight-bound), which is why the tiling is what unlocks the win.
 // The tiled inner (oc,k) MAC over the LDS window is the register-GEMM row a cooperative-matrix (tensor-core)
 // rewrite swaps in later (#137).
+//
+// INT8 LAYERS (QuantMode == 1, tiled path only; see NeuralQuantization.hpp for the scheme): the LDS tile holds
+// the input already quantized to signed bytes (q - 128), each thread packs its KxK window four taps per uint,
+// and the MAC becomes a 4-wide int8 dot product against the packed weights in QWeights. The integer sum plus
+// the per-channel zero-point correction is rescaled once per output with the QParams scale, then bias. Dot4I8
+// is the portable emulation; swapping in dot4add_i8packed / VK_KHR_shader_integer_dot_product where the
+// device has it is a drop-in change to that one function.
 
 #ifdef SS_FP16
 StructuredBuffer<float16_t> Weights : register(t1, space0); // [outC*inC*k*k] then [outC] bias at BiasOffset (fp16)
@@ -30,6 +37,8 @@ StructuredBuffer<float> Weights : register(t1, space0);     // [outC*inC*k*k] th
 #endif
 StructuredBuffer<float> InMap : register(t0, space0);   // CHW, InChannels*H*W floats
 RWStructuredBuffer<float> OutMap : register(u2, space0); // CHW, OutChannels*H*W floats
+StructuredBuffer<uint> QWeights : register(t4, space0); // int8 layers: packed taps, Int8GpuWeights::Words
+StructuredBuffer<float> QParams : register(t5, space0); // int8 layers: [outC] scale, [outC] correction, [outC] bias
 
 cbuffer ConvCB : register(b3, space0)
 {
@@ -40,6 +49,12 @@ cbuffer ConvCB : register(b3, space0)
 	uint Activation;   // 0 none, 1 ReLU
 	uint WeightOffset; // global float index where this layer's weights begin
 	uint BiasOffset;   // global float index where this layer's bias begins
+	uint QuantMode;     // 0 float weights, 1 int8 (QWeights/QParams; SS_FP16 path only)
+	float InputScaleInv; // int8: 1 / input quantization scale
+	uint InputZeroPoint; // int8: input zero point (0..255)
+	uint QWeightOffset;  // int8: uint index of this layer's packed taps in QWeights
+	uint QParamOffset;   // int8: float index of this layer's scale/correction/bias block in QParams
+	uint3 _Pad;
 };
 
 // Read input channel c at (x,y); zero outside the image (same-padding border).
@@ -54,6 +69,28 @@ float ReadInClamped(int x, int y, uint c)
 
 #ifdef SS_FP16
 
+// Signed 4x int8 dot product of two packed words (byte i of each is lane i).
+int Dot4I8(uint a, uint b)
+{
+	int sum = 0;
+	[unroll] for (uint i = 0; i < 4; ++i)
+	{
+		const int av = (int)(a << (24 - 8 * i)) >> 24;
+		const int bv = (int)(b << (24 - 8 * i)) >> 24;
+		sum += av * bv;
+	}
+	return sum;
+}
+
+// The int8 layer input as a signed byte: quantize to uint8 with the layer's calibrated scale/zero point, then
+// shift by 128 (the correction term in QParams adds the shift back).
+float QuantizeToSignedByte(float x)
+{
+	// Same expression as QuantizeActivation (NeuralMath.hpp), so CPU and GPU agree on ties.
+	const float q = floor(min(max(x * InputScaleInv + ((float)InputZeroPoint + 0.5f), 0.0f), 255.0f));
+	return q - 128.0f;
+}
+
 // 8x8 output tile per group, 1-texel halo (max KernelSize is 3 -> radius 1) -> 10x10 cached tile. ONE input
 // channel cached at a time: 100 floats = 400 B LDS, negligible -> full occupancy (caching all channels at once
 // was ~25 KB and collapsed occupancy, measured slower). MAX_OUT_CHANNELS caps the per-thread output-accumulator
@@ -78,11 +115,15 @@ void main(uint3 gid : SV_GroupID, uint3 gtid : SV_GroupThreadID, uint3 id : SV_D
 	// Per-thread output-channel accumulators, seeded with bias. Held in registers across the input-channel loop
 	// so each input channel is read from global memory only once (into LDS), not once per output channel.
 	const uint outC = min(OutChannels, (uint)MAX_OUT_CHANNELS);
+	// (Int8 layers accumulate the exact integer dot product instead and add bias after the rescale.)
+	const bool int8 = QuantMode == 1;
 	float acc[MAX_OUT_CHANNELS];
 	for (uint oc = 0; oc < outC; ++oc)
 	{
-		acc[oc] = (float)Weights[BiasOffset + oc];
+		acc[oc] = int8 ? 0.0f : (float)Weights[BiasOffset + oc];
 	}
+	const uint taps = KernelSize * KernelSize;
+	const uint wordsPerIc = (taps + 3) / 4;
 
 	const uint tileTexels = TILE_DIM * TILE_DIM;
 	for (uint ic = 0; ic < InChannels; ++ic)
@@ -92,13 +133,36 @@ void main(uint3 gid : SV_GroupID, uint3 gtid : SV_GroupThreadID, uint3 id : SV_D
 		{
 			const uint ly = t / TILE_DIM;
 			const uint lx = t - ly * TILE_DIM;
-			gTile[t] = ReadInClamped(tileOrigin.x + (int)lx, tileOrigin.y + (int)ly, ic);
+			const float v = ReadInClamped(tileOrigin.x + (int)lx, tileOrigin.y + (int)ly, ic);
+			gTile[t] = int8 ? QuantizeToSignedByte(v) : v;
 		}
 		GroupMemoryBarrierWithGroupSync(); // tile for channel ic is visible to all threads
 
 		// MAC this channel's window into every output accumulator. All threads hit the barriers, so gate the
 		// math (not the loop) on being an in-range output pixel.
-		if (id.x < Size.x && id.y < Size.y)
+		if (int8 && id.x < Size.x && id.y < Size.y)
+		{
+			// Pack this thread's window once per channel (at most 9 taps -> 3 words), then one dot4 per word per oc.
+			uint window[3] = {0u, 0u, 0u};
+			for (uint t = 0; t < taps; ++t)
+			{
+				const uint ky = t / KernelSize;
+				const uint kx = t - ky * KernelSize;
+				const int v = (int)gTile[(winY + ky) * TILE_DIM + (winX + kx)];
+				window[t / 4] |= ((uint)v & 0xFFu) << (8 * (t % 4));
+			}
+			for (uint oc = 0; oc < outC; ++oc)
+			{
+				const uint wBase = QWeightOffset + (oc * InChannels + ic) * wordsPerIc;
+				int s = 0;
+				for (uint w = 0; w < wordsPerIc; ++w)
+				{
+					s += Dot4I8(window[w], QWeights[wBase + w]);
+				}
+				acc[oc] += (float)s;
+			}
+		}
+		else if (id.x < Size.x && id.y < Size.y)
 		{
 			for (uint oc = 0; oc < outC; ++oc)
 			{
@@ -125,6 +189,12 @@ void main(uint3 gid : SV_GroupID, uint3 gtid : SV_GroupThreadID, uint3 id : SV_D
 	for (uint oc = 0; oc < outC; ++oc)
 	{
 		float v = acc[oc];
+		if (int8)
+		{
+			// sum((q - 128) * w) + (128 - z) * sum(w) == sum((q - z) * w), then scale and bias.
+			v = QParams[QParamOffset + 2 * OutChannels + oc] +
+			    (v + QParams[QParamOffset + OutChannels + oc]) * QParams[QParamOffset + oc];
+		}
 		if (Activation == 1 && v < 0.0f)
 		{
 			v = 0.0f;
@@ -0,0 +1,150 @@
+// Fused neural-upscaler conv stack: ALL layers of the model in one dispatch, activations tile-resident in
+// groupshared memory, writing only output = bilinear base + residual (replaces the per-layer NeuralConv
+// dispatches AND NeuralResidualAdd when NeuralFusedConv.hpp's PlanFusedConv says the model fits). The per-layer
+// path streams every hidden activation through a full-res CHW buffer and back; at 4K output that traffic,
+// not the MACs, is the upscaler's cost. Here the only global reads are the input feature stack (once per
+// tile + halo) and the cache-resident weights.
+//
+// Each 8x8 group loads its tile plus a halo of sum(KernelSize / 2) texels into LDS plane 0, then runs the
+// layers over a shrinking region: layer l writes TILE + 2 * (radii of the later layers) texels per side into
+// the other plane, so the last layer produces exactly the tile, one pixel per thread. Halo texels are
+// recomputed by each neighbouring group (ALU traded for bandwidth). Taps outside the image are clipped out of
+// the loop rather than read as zero, and accumulation runs bias, ic, ky, kx — Conv2DReference's order, so
+// RunFusedReference (the CPU emulation of this kernel) matches the reference chain bit for bit.
+//
+// LDS is 2 x 3072 floats = 24 KB. That's the occupancy NeuralConv.comp deliberately avoids for a single layer;
+// fused, it buys back every inter-layer round trip, and models whose regions don't fit fall back to the
+// per-layer path. TILE, FUSED_PLANE_FLOATS and MAX_FUSED_LAYERS MUST match NeuralFusedConv.hpp.
+
+#ifdef SS_FP16
+StructuredBuffer<float16_t> Weights : register(t1, space0); // every layer's [weights..., bias...] (fp16)
+#else
+StructuredBuffer<float> Weights : register(t1, space0);     // every layer's [weights..., bias...]
+#endif
+StructuredBuffer<float> InMap : register(t0, space0); // CHW feature stack; channels 0..2 are the bilinear base
+[[vk::image_format("rgba16f")]] RWTexture2D<float4> OutImage : register(u2, space0);
+
+#define TILE 8
+#define THREADS (TILE * TILE)
+#define FUSED_PLANE_FLOATS 3072
+#define MAX_FUSED_LAYERS 8
+
+cbuffer FusedCB : register(b3, space0)
+{
+	uint2 Size;     // output W,H (== feature-map W,H)
+	uint LayerCount;
+	uint Halo;      // sum of the layer radii: input context per tile side
+	uint4 LayerShape[MAX_FUSED_LAYERS];  // InChannels, OutChannels, KernelSize, Activation (0 none / 1 ReLU)
+	uint4 LayerOffset[MAX_FUSED_LAYERS]; // WeightOffset, BiasOffset (element indices into Weights), unused x2
+};
+
+groupshared float gPlanes[2 * FUSED_PLANE_FLOATS]; // ping-pong activation regions
+
+// Read input channel c at (x,y); zero outside the image (same-padding border).
+float ReadInClamped(int x, int y, uint c)
+{
+	if (x < 0 || y < 0 || x >= (int)Size.x || y >= (int)Size.y)
+	{
+		return 0.0f;
+	}
+	return InMap[(c * Size.y + (uint)y) * Size.x + (uint)x];
+}
+
+// Output channel oc of layer li at region texel (oy,ox) / image texel g, reading the layer's input region at
+// srcBase (srcSide per side, one layer radius wider than the output region, so tap (ky,kx) is (oy+ky, ox+kx)).
+float FusedOutput(uint li, uint srcBase, uint srcSide, uint oc, uint oy, uint ox, int2 g)
+{
+	const uint4 shape = LayerShape[li];
+	const int k = (int)shape.z;
+	const int r = k / 2;
+	const int kyBegin = max(0, r - g.y);
+	const int kyEnd = min(k, (int)Size.y - g.y + r);
+	const int kxBegin = max(0, r - g.x);
+	const int kxEnd = min(k, (int)Size.x - g.x + r);
+
+	float acc = (float)Weights[LayerOffset[li].y + oc];
+	for (uint ic = 0; ic < shape.x; ++ic)
+	{
+		const uint planeBase = srcBase + ic * srcSide * srcSide;
+		const uint wBase = LayerOffset[li].x + (oc * shape.x + ic) * shape.z * shape.z;
+		for (int ky = kyBegin; ky < kyEnd; ++ky)
+		{
+			for (int kx = kxBegin; kx < kxEnd; ++kx)
+			{
+				acc += gPlanes[planeBase + (oy + ky) * srcSide + ox + kx] * (float)Weights[wBase + ky * k + kx];
+			}
+		}
+	}
+	if (shape.w == 1 && acc < 0.0f)
+	{
+		acc = 0.0f;
+	}
+	return acc;
+}
+
+[numthreads(TILE, TILE, 1)]
+void main(uint3 gid : SV_GroupID, uint3 gtid : SV_GroupThreadID, uint3 id : SV_DispatchThreadID)
+{
+	const uint threadIdx = gtid.y * TILE + gtid.x;
+	const int2 tileBase = int2(gid.xy) * TILE;
+
+	// Input region (tile + halo, every input channel) into plane 0.
+	uint side = TILE + 2 * Halo;
+	const int2 inOrigin = tileBase - (int)Halo;
+	const uint inTexels = LayerShape[0].x * side * side;
+	for (uint t = threadIdx; t < inTexels; t += THREADS)
+	{
+		const uint c = t / (side * side);
+		const uint rem = t - c * side * side;
+		const uint ly = rem / side;
+		const uint lx = rem - ly * side;
+		gPlanes[t] = ReadInClamped(inOrigin.x + (int)lx, inOrigin.y + (int)ly, c);
+	}
+	GroupMemoryBarrierWithGroupSync();
+
+	// Hidden layers: region outputs spread over the 64 threads; texels outside the image stay 0 (never read —
+	// their taps are clipped — but deterministic).
+	uint srcBase = 0;
+	uint dstBase = FUSED_PLANE_FLOATS;
+	uint margin = Halo;
+	for (uint li = 0; li + 1 < LayerCount; ++li)
+	{
+		margin -= LayerShape[li].z / 2;
+		const uint outSide = TILE + 2 * margin;
+		const uint plane = outSide * outSide;
+		const int2 outOrigin = tileBase - (int)margin;
+		for (uint t = threadIdx; t < LayerShape[li].y * plane; t += THREADS)
+		{
+			const uint oc = t / plane;
+			const uint rem = t - oc * plane;
+			const uint oy = rem / outSide;
+			const uint ox = rem - oy * outSide;
+			const int2 g = outOrigin + int2((int)ox, (int)oy);
+			const bool inside = g.x >= 0 && g.y >= 0 && g.x < (int)Size.x && g.y < (int)Size.y;
+			gPlanes[dstBase + t] = inside ? FusedOutput(li, srcBase, side, oc, oy, ox, g) : 0.0f;
+		}
+		GroupMemoryBarrierWithGroupSync(); // this layer's region is complete before the next reads it
+
+		const uint swapBase = srcBase;
+		srcBase = dstBase;
+		dstBase = swapBase;
+		side = outSide;
+	}
+
+	// Last layer: margin is now its own radius, so its output region is exactly the tile — one pixel per
+	// thread. No barrier follows, so out-of-image threads can leave.
+	if (id.x >= Size.x || id.y >= Size.y)
+	{
+		return;
+	}
+	const uint last = LayerCount - 1;
+	float3 res;
+	[unroll] for (uint oc = 0; oc < 3; ++oc)
+	{
+		res[oc] = FusedOutput(last, srcBase, side, oc, gtid.y, gtid.x, int2(id.xy));
+	}
+	const uint planeSize = Size.x * Size.y;
+	const uint pix = id.y * Size.x + id.x;
+	const float3 base = float3(InMap[pix], InMap[planeSize + pix], InMap[2 * planeSize + pix]);
+	OutImage[id.xy] = float4(base + res, 1.0f);
+}
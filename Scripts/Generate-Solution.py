@@ -26,6 +26,8 @@ PACKAGES = [
     "nlohmann-json",
     "catch2",
     "tracy",  # real-time frame/sampling profiler (client lib); connect the Tracy GUI to a running build
+    "zstd",   # dataset export: per-array shard compression
+    "lz4",    # dataset export: per-array shard compression (faster, lighter than zstd)
 ]
 
 # Pin the v143 toolset to a concrete MSVC version. Without this, "-T v143" resolves
@@ -6,7 +6,8 @@ dxc, same flags, same profiles (vs/ps/cs_6_5, entry `main`), same permutation de
 (SS_RAYTRACING, SS_FP16). Its purpose is to populate a SPIR-V directory for Scripts/rga-occupancy.py
 on a clean checkout or in CI, where booting the editor to fill Engine/cache/shaders/ is impossible
 (no GPU). This is a deliberate second copy of the engine's dxc flags; keep it in sync with
-VulkanShader.cpp when those flags change (there is no shared source of truth today).
+VulkanShader.cpp when those flags change. It does not reproduce the engine's cache keys: to fill the
+runtime cache / build the shipped bundle use Snowstorm-ShaderCook, which calls the engine's own compile.
 
 Usage (from repo root or anywhere):
     py Scripts/cook-shaders.py                 # cook the RT permutation of every shader -> cook dir
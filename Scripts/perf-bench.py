@@ -16,7 +16,14 @@ per-effect timing IS the A/B across configs, not a separate GPU scope). A traili
 config repeats the last rung with the screen-space GI producer, so it diffs against `+refl`
 (not against its neighbour) and gives the screen-space-vs-RT cost of the same effect.
 
-Needs a real GPU (Vulkan timestamps), so it's a LOCAL gate like smoke-test.py, not CI.
+Needs a real GPU (Vulkan timestamps), so it's a LOCAL gate like smoke-test.py, not CI. The
+--headless mode also runs in CI, as a Release-build report (hosted runners have no committed
+baseline): it runs Snowstorm-Bench (CPU benchmarks -- JobSystem, ECS change
+tracking, culling, asset cook/load, scene serialization, neural CPU inference; no window, no GPU),
+which writes the same JSON shape keyed by the CPU name, and diffs it against
+Scripts/perf-baseline/<cpu-slug>/headless.json. Those entries carry each benchmark's MAD (median
+absolute deviation) across repetitions, so a delta only counts as a regression when it is also
+outside the run-to-run noise.
 
 Usage (from repo root or anywhere):
     py Scripts/perf-bench.py                    # run the matrix, diff vs baseline, PASS/FAIL
@@ -26,6 +33,8 @@ Usage (from repo root or anywhere):
     py Scripts/perf-bench.py --threshold 20     # regression tolerance % (default 15)
     py Scripts/perf-bench.py --scene <path>     # benchmark a different scene
     py Scripts/perf-bench.py --gpu 5070         # pin the adapter on a multi-GPU box
+    py Scripts/perf-bench.py --headless         # CPU benchmark suite (Snowstorm-Bench), no GPU needed
+    py Scripts/perf-bench.py --headless --only cull --reps 25   # a subset, more repetitions
 
 Exit code: 0 if every config is within threshold (or --update-baseline), 1 on a regression.
 """
@@ -106,6 +115,34 @@ def run_config(name: str, env_overrides: dict, exe: Path, cwd: Path, frames: int
     return data
 
 
+def run_headless(exe: Path, cwd: Path, timeout: int, only: str | None, reps: int | None) -> dict | None:
+    """Run the CPU benchmark suite; return its parsed JSON (or None on failure)."""
+    out_path = Path(tempfile.gettempdir()) / "perf-bench-headless.json"
+    if out_path.exists():
+        out_path.unlink()
+
+    cmd = [str(exe), "--json", str(out_path)]
+    if only:
+        cmd += ["--filter", only]
+    if reps:
+        cmd += ["--reps", str(reps)]
+    try:
+        proc = subprocess.run(cmd, cwd=str(cwd), capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        print(f"  headless: FAIL (timed out after {timeout}s)")
+        return None
+    # A failed benchmark exits 1 but still writes the others; report it and compare what ran.
+    if proc.returncode != 0:
+        print(f"  headless: FAIL (exit code {proc.returncode})")
+        print("\n".join("    " + line for line in proc.stdout.splitlines() if "failed" in line))
+    if not out_path.exists():
+        print(f"  headless: FAIL (no JSON written to {out_path})")
+        return None
+    data = json.loads(out_path.read_text())
+    data["_exitCode"] = proc.returncode
+    return data
+
+
 def device_slug(device: str) -> str:
     """Filesystem-safe directory name for an adapter, e.g. 'AMD Radeon RX 9070 XT' -> 'amd-radeon-rx-9070-xt'."""
     slug = re.sub(r"[^a-z0-9]+", "-", device.lower()).strip("-")
@@ -120,44 +157,105 @@ def baseline_path(repo_root: Path, device: str, name: str) -> Path:
     return repo_root / "Scripts" / "perf-baseline" / device_slug(device) / f"{name}.json"
 
 
-def compare(name: str, current: dict, baseline: dict, threshold_pct: float) -> bool:
-    """Print a per-pass table (baseline vs current, Δ%); return True if within threshold."""
+def compare(name: str, current: dict, baseline: dict, threshold_pct: float, mad_k: float = 3.0) -> bool:
+    """Print a per-pass table (baseline vs current, Δ%); return True if within threshold.
+
+    Entries with a madMs (the headless CPU benchmarks) are also held to a noise floor: a delta is
+    only a regression if it exceeds the threshold AND mad_k times the larger of the two MADs, so a
+    noisy runner doesn't fail a benchmark whose median merely wobbled."""
     cur_passes = current.get("passes", {})
     base_passes = baseline.get("passes", {})
     all_names = sorted(set(cur_passes) | set(base_passes))
+    w = max([18] + [len(p) for p in all_names])  # headless benchmark names run longer than pass names
 
-    print(f"  {'pass':<18} {'baseline':>10} {'current':>10} {'delta':>9}")
+    print(f"  {'pass':<{w}} {'baseline':>10} {'current':>10} {'delta':>9}")
     ok = True
     for p in all_names:
         b = base_passes.get(p, {}).get("avgMs")
         c = cur_passes.get(p, {}).get("avgMs")
         if b is None:
-            print(f"  {p:<18} {'--':>10} {c:>10.3f}   (new)")
+            print(f"  {p:<{w}} {'--':>10} {c:>10.3f}   (new)")
             continue
         if c is None:
-            print(f"  {p:<18} {b:>10.3f} {'--':>10}   (gone)")
+            print(f"  {p:<{w}} {b:>10.3f} {'--':>10}   (gone)")
             continue
         # Ignore sub-0.05ms passes: timestamp noise there swamps any % and would false-fail.
         if b < 0.05 and c < 0.05:
-            print(f"  {p:<18} {b:>10.3f} {c:>10.3f}   ~0")
+            print(f"  {p:<{w}} {b:>10.3f} {c:>10.3f}   ~0")
             continue
         delta = (c - b) / b * 100.0 if b > 0 else 0.0
+        mad = max(base_passes[p].get("madMs", 0.0), cur_passes[p].get("madMs", 0.0))
         flag = ""
         if delta > threshold_pct:
-            flag = "  REGRESSION"
-            ok = False
+            if c - b > mad_k * mad:
+                flag = "  REGRESSION"
+                ok = False
+            else:
+                flag = f"  (within noise, mad {mad:.3f})"
         # FS invocations (overdraw metric, #pipeline-stats). Informational: a graphics pass's fragment-
         # shader invocations; divide by the pass's pixel count for overdraw. Not gated (it's a diagnostic).
         fi = cur_passes.get(p, {}).get("fragInvocations", 0)
         frag = f"  frags={fi / 1e6:.1f}M" if fi else ""
-        print(f"  {p:<18} {b:>10.3f} {c:>10.3f} {delta:>+8.1f}%{flag}{frag}")
+        print(f"  {p:<{w}} {b:>10.3f} {c:>10.3f} {delta:>+8.1f}%{flag}{frag}")
 
     bt, ct = baseline.get("totalGpuMs", 0.0), current.get("totalGpuMs", 0.0)
     dt = (ct - bt) / bt * 100.0 if bt > 0 else 0.0
-    print(f"  {'TOTAL gpu':<18} {bt:>10.3f} {ct:>10.3f} {dt:>+8.1f}%")
+    # Headless: the sum of the benchmark medians (same field, so the format stays one format).
+    print(f"  {'TOTAL cpu' if name == 'headless' else 'TOTAL gpu':<{w}} {bt:>10.3f} {ct:>10.3f} {dt:>+8.1f}%")
     return ok
 
 
+def main_headless(args, repo_root: Path, build_dir: Path) -> int:
+    """--headless: one Snowstorm-Bench run, diffed against the CPU's headless.json baseline."""
+    exe = build_dir / f"Snowstorm-Bench/{args.config}/Snowstorm-Bench.exe"
+    if not exe.exists():
+        # Single-config generators (Ninja) put it directly under the target's build directory.
+        exe = build_dir / "Snowstorm-Bench" / ("Snowstorm-Bench.exe" if os.name == "nt" else "Snowstorm-Bench")
+    if not exe.exists():
+        print(f"FAIL: executable not found at {exe} (build Snowstorm-Bench first, or check --config)")
+        return 1
+
+    print(f"Repo root : {repo_root}")
+    print(f"Bench exe : {exe}")
+    print(f"Filter    : {args.only or '(all)'}   Threshold: {args.threshold}% and {args.mad_k} x MAD")
+    print(f"Mode      : {'UPDATE BASELINE' if args.update_baseline else 'compare vs baseline'}\n")
+
+    print("=== headless ===")
+    # One process runs the whole suite (not one per config), so it gets ten per-config timeouts.
+    current = run_headless(exe, repo_root, args.timeout * 10, args.only, args.reps)
+    if current is None:
+        print("\n=== Summary ===\nFAIL (run failure)")
+        return 1
+    all_ok = current.pop("_exitCode") == 0
+
+    device = current.get("device", "")
+    bp = baseline_path(repo_root, device, "headless")
+    if args.update_baseline:
+        if args.only:
+            print("  refusing to write a filtered run as the baseline (drop --only)")
+            return 1
+        bp.parent.mkdir(parents=True, exist_ok=True)
+        bp.write_text(json.dumps(current, indent=2))
+        print(f"  updated baseline: {bp.relative_to(repo_root)}  (cpu: {device or '?'})")
+    elif bp.exists():
+        baseline = json.loads(bp.read_text())
+        if args.only:
+            # Diff only what ran, so a filtered run doesn't report the rest as gone.
+            baseline["passes"] = {k: v for k, v in baseline.get("passes", {}).items() if k in current["passes"]}
+            baseline["totalGpuMs"] = sum(v["avgMs"] for v in baseline["passes"].values())
+        if not compare("headless", current, baseline, args.threshold, args.mad_k):
+            all_ok = False
+    else:
+        print(f"  no baseline at {bp.relative_to(repo_root)} for '{device or 'unknown cpu'}' "
+              f"-- run with --update-baseline first.")
+        for p, s in sorted(current.get("passes", {}).items()):
+            print(f"    {p:<30} {s['avgMs']:>10.3f} ms  mad {s.get('madMs', 0.0):.3f}")
+
+    print("\n=== Summary ===")
+    print("PASS" if all_ok else "FAIL (regression or benchmark failure)")
+    return 0 if all_ok else 1
+
+
 def main() -> int:
     ap = argparse.ArgumentParser(description="GPU perf benchmark + regression gate.")
     ap.add_argument("--frames", type=int, default=300, help="Frames averaged per config (default 300)")
@@ -170,12 +268,19 @@ def main() -> int:
     ap.add_argument("--scene", default=DEFAULT_SCENE, help="Scene to benchmark")
     ap.add_argument("--gpu", default="", help="Pin the GPU (render.gpu syntax: name substring or index)")
     ap.add_argument("--update-baseline", action="store_true", help="Write current results as the new baseline")
+    ap.add_argument("--headless", action="store_true",
+                    help="Run the CPU benchmark suite (Snowstorm-Bench) instead of the GPU matrix; --only filters by name")
+    ap.add_argument("--reps", type=int, default=None, help="Headless: timed repetitions per benchmark (default 15)")
+    ap.add_argument("--mad-k", type=float, default=3.0,
+                    help="Headless: a regression must also exceed this many MADs (default 3)")
     args = ap.parse_args()
 
     script_dir = Path(__file__).resolve().parent
     repo_root = find_repo_root(script_dir)
     build_dir = (repo_root / args.build_dir).resolve()
     layer_path = (repo_root / "vcpkg" / "installed" / args.triplet / "bin").resolve()
+    if args.headless:
+        return main_headless(args, repo_root, build_dir)
     exe = build_dir / f"Snowstorm-Editor/{args.config}/Snowstorm-Editor.exe"
 
     if not exe.exists():
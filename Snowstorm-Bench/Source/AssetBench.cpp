@@ -0,0 +1,154 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Render/MeshLibrary.hpp"
+#include "Snowstorm/Render/Texture.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Asset cook and load on the CPU paths the async loader runs on workers: MeshLibrary::LoadCookedCPU (Assimp
+// parse + vertex packing + blob write when cold, blob read when warm) and Texture::DecodeCPU (stb decode + the
+// full mip chain + blob write when cold, blob read when warm). The sources are generated into the scratch
+// directory, so the numbers depend on the code, not on whatever is in the project.
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// A 256 x 256-quad heightfield grid: ~66k vertices / 393k indices after triangulation.
+		std::filesystem::path WriteGridObj(const std::filesystem::path& dir)
+		{
+			constexpr int kQuads = 256;
+			const std::filesystem::path path = dir / "grid.obj";
+			std::ofstream out(path, std::ios::trunc);
+			for (int y = 0; y <= kQuads; ++y)
+			{
+				for (int x = 0; x <= kQuads; ++x)
+				{
+					out << "v " << x << ' ' << ((x * 7 + y * 13) % 17) * 0.05f << ' ' << y << '\n';
+					out << "vt " << static_cast<float>(x) / kQuads << ' ' << static_cast<float>(y) / kQuads << '\n';
+				}
+			}
+			out << "vn 0 1 0\n";
+			for (int y = 0; y < kQuads; ++y)
+			{
+				for (int x = 0; x < kQuads; ++x)
+				{
+					const int a = y * (kQuads + 1) + x + 1; // OBJ indices are 1-based
+					const int b = a + 1;
+					const int c = a + kQuads + 1;
+					const int d = c + 1;
+					out << "f " << a << '/' << a << "/1 " << c << '/' << c << "/1 " << d << '/' << d << "/1 " << b << '/' << b << "/1\n";
+				}
+			}
+			return out ? path : std::filesystem::path();
+		}
+
+		// A 1024 x 1024 uncompressed 32-bit TGA (stb reads it; no encoder dependency needed to write it).
+		std::filesystem::path WriteTga(const std::filesystem::path& dir)
+		{
+			constexpr uint16_t kSize = 1024;
+			const std::filesystem::path path = dir / "checker.tga";
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			const uint8_t header[18] = {0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			                            kSize & 0xFF, kSize >> 8, kSize & 0xFF, kSize >> 8, 32, 8};
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
+			std::vector<uint8_t> row(kSize * 4);
+			for (uint32_t y = 0; y < kSize; ++y)
+			{
+				for (uint32_t x = 0; x < kSize; ++x)
+				{
+					const uint8_t v = ((x / 32 + y / 32) % 2) ? 230 : 25;
+					row[x * 4 + 0] = v;
+					row[x * 4 + 1] = static_cast<uint8_t>(x / 4);
+					row[x * 4 + 2] = static_cast<uint8_t>(y / 4);
+					row[x * 4 + 3] = 255;
+				}
+				out.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+			}
+			return out ? path : std::filesystem::path();
+		}
+
+		// Drop every cooked blob of a kind, so the next load is a cold cook (the scratch directory's cache only).
+		void ClearCooked(const char* kind)
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(std::filesystem::path("Engine/cache") / kind, ec);
+		}
+	}
+
+	void RegisterAssetBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env)
+	{
+		const std::filesystem::path dir = env.Scratch / "assets";
+
+		const auto mesh = [dir](BenchmarkContext& ctx, const bool cold)
+		{
+			std::filesystem::create_directories(dir);
+			const std::filesystem::path obj = WriteGridObj(dir);
+			if (obj.empty())
+			{
+				ctx.Fail("couldn't write the source mesh");
+				return;
+			}
+
+			MeshLibrary library;
+			const std::string path = obj.string();
+			const auto load = [&]
+			{
+				const std::optional<CookedMesh> cooked = library.LoadCookedCPU(path, 0);
+				if (!cooked || cooked->Indices.empty())
+				{
+					ctx.Fail("LoadCookedCPU failed");
+				}
+			};
+			if (cold)
+			{
+				ctx.Measure([&]
+				{
+					ClearCooked("mesh");
+					library.ReleaseParsedFiles();
+				}, load);
+			}
+			else
+			{
+				ctx.Measure(load);
+			}
+		};
+		runner.Add("asset.mesh.cook", [mesh](BenchmarkContext& ctx) { mesh(ctx, true); });
+		runner.Add("asset.mesh.load", [mesh](BenchmarkContext& ctx) { mesh(ctx, false); });
+
+		const auto texture = [dir](BenchmarkContext& ctx, const bool cold)
+		{
+			std::filesystem::create_directories(dir);
+			const std::filesystem::path tga = WriteTga(dir);
+			if (tga.empty())
+			{
+				ctx.Fail("couldn't write the source image");
+				return;
+			}
+
+			const auto load = [&]
+			{
+				const std::optional<CookedTexture> cooked = Texture::DecodeCPU(tga);
+				if (!cooked || cooked->MipLevels() != 11)
+				{
+					ctx.Fail("DecodeCPU failed");
+				}
+			};
+			if (cold)
+			{
+				ctx.Measure([] { ClearCooked("texture"); }, load);
+			}
+			else
+			{
+				ctx.Measure(load);
+			}
+		};
+		runner.Add("asset.texture.cook", [texture](BenchmarkContext& ctx) { texture(ctx, true); });
+		runner.Add("asset.texture.load", [texture](BenchmarkContext& ctx) { texture(ctx, false); });
+	}
+}
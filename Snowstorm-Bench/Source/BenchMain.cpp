@@ -0,0 +1,197 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// Headless CPU benchmark suite (the GPU-free perf gate). Runs the registered micro/macro benchmarks -- JobSystem
+// dispatch, TrackedRegistry change tracking, frustum culling at 10k..1M, mesh/texture cook and load, scene
+// serialization, neural CPU inference, render submission on the Null backend -- with warmup and repetitions,
+// logs median/MAD per benchmark and writes the PerfBenchAccumulator JSON shape (keyed by the CPU name) for
+// Scripts/perf-bench.py --headless to diff against a baseline.
+//
+//     Snowstorm-Bench [--filter SUBSTR] [--warmup N] [--reps N] [--json <out.json>] [--config LABEL] [--list]
+//
+// Exit 0 if every selected benchmark ran, 1 on a bad argument or a failed benchmark.
+
+namespace
+{
+	using namespace Snowstorm;
+
+	struct Options
+	{
+		BenchmarkOptions Bench;
+		std::filesystem::path Json;
+		std::string Config = "headless";
+		bool List = false;
+	};
+
+	constexpr std::string_view kUsage = "usage: Snowstorm-Bench [--filter SUBSTR] [--warmup N] [--reps N] "
+	                                    "[--json <out>] [--config LABEL] [--list]";
+
+	bool ParseArgs(const int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--filter" && hasValue)
+			{
+				options.Bench.Filter = argv[++i];
+			}
+			else if (arg == "--warmup" && hasValue)
+			{
+				options.Bench.Warmup = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (arg == "--reps" && hasValue)
+			{
+				options.Bench.Repetitions = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+			}
+			else if (arg == "--json" && hasValue)
+			{
+				options.Json = argv[++i];
+			}
+			else if (arg == "--config" && hasValue)
+			{
+				options.Config = argv[++i];
+			}
+			else if (arg == "--list")
+			{
+				options.List = true;
+			}
+			else
+			{
+				SS_CORE_ERROR("Unknown argument {} ({})", arg, kUsage);
+				return false;
+			}
+		}
+		if (options.Bench.Repetitions == 0)
+		{
+			SS_CORE_ERROR("--reps must be positive ({})", kUsage);
+			return false;
+		}
+		return true;
+	}
+
+	// The CPU brand string ("AMD Ryzen 9 7950X 16-Core Processor"): the baseline key, as the adapter name is
+	// for the GPU benchmark. Trailing padding is trimmed so the directory slug is stable.
+	std::string CpuName()
+	{
+		std::string name;
+#if defined(__x86_64__) || defined(_M_X64)
+		unsigned regs[12] = {};
+		unsigned maxLeaf = 0;
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, static_cast<int>(0x80000000u));
+		maxLeaf = static_cast<unsigned>(info[0]);
+		for (unsigned leaf = 0; maxLeaf >= 0x80000004u && leaf < 3; ++leaf)
+		{
+			__cpuid(info, static_cast<int>(0x80000002u + leaf));
+			std::memcpy(regs + leaf * 4, info, sizeof(info));
+		}
+#else
+		unsigned unused = 0;
+		__get_cpuid(0x80000000u, &maxLeaf, &unused, &unused, &unused);
+		for (unsigned leaf = 0; maxLeaf >= 0x80000004u && leaf < 3; ++leaf)
+		{
+			unsigned* r = regs + leaf * 4;
+			__get_cpuid(0x80000002u + leaf, &r[0], &r[1], &r[2], &r[3]);
+		}
+#endif
+		char brand[sizeof(regs) + 1] = {};
+		std::memcpy(brand, regs, sizeof(regs));
+		name = brand;
+#endif
+		const size_t first = name.find_first_not_of(' ');
+		const size_t last = name.find_last_not_of(' ');
+		return first == std::string::npos ? "unknown-cpu" : name.substr(first, last - first + 1);
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	Log::Init();
+
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		return 1;
+	}
+
+	// Private scratch directory as the CWD: the cook benchmarks write (and clear) the CWD-relative
+	// Engine/cache, which must not be the checkout's. It is left behind on exit (ContentHashIndex flushes
+	// into it at static destruction) and wiped by the next run.
+	const std::filesystem::path json = options.Json.empty() ? std::filesystem::path() : std::filesystem::absolute(options.Json);
+	const std::filesystem::path scratch = std::filesystem::temp_directory_path() / "Snowstorm-Bench";
+	std::error_code ec;
+	std::filesystem::remove_all(scratch, ec);
+	std::filesystem::create_directories(scratch, ec);
+	std::filesystem::current_path(scratch, ec);
+	if (ec)
+	{
+		SS_CORE_ERROR("Bench: can't use {} as the scratch directory: {}", scratch.string(), ec.message());
+		return 1;
+	}
+
+	JobSystem jobs;
+	const BenchEnvironment env{jobs, scratch};
+	BenchmarkRunner runner;
+	RegisterJobSystemBenchmarks(runner, env);
+	RegisterEcsBenchmarks(runner, env);
+	RegisterCullingBenchmarks(runner, env);
+	RegisterAssetBenchmarks(runner, env);
+	RegisterSerializationBenchmarks(runner, env);
+	RegisterNeuralBenchmarks(runner, env);
+	RegisterRenderBenchmarks(runner, env);
+
+	if (options.List)
+	{
+		for (const std::string& name : runner.Names(options.Bench.Filter))
+		{
+			SS_CORE_INFO("{}", name);
+		}
+		return 0;
+	}
+
+	const std::string device = CpuName();
+	SS_CORE_INFO("Bench: {} ({} workers), {} warmup + {} reps", device, jobs.WorkerCount(), options.Bench.Warmup,
+	             options.Bench.Repetitions);
+	const std::vector<BenchmarkResult> results = runner.Run(options.Bench);
+	if (results.empty())
+	{
+		SS_CORE_ERROR("Bench: no benchmark matches '{}'", options.Bench.Filter);
+		return 1;
+	}
+
+	if (!json.empty())
+	{
+		std::ofstream out(json, std::ios::trunc);
+		out << BenchmarkRunner::ToJson(results, device, options.Config, options.Bench.Repetitions);
+		if (!out)
+		{
+			SS_CORE_ERROR("Bench: failed to write {}", json.string());
+			return 1;
+		}
+		SS_CORE_INFO("Bench: wrote {}", json.string());
+	}
+
+	const bool allRan = std::ranges::none_of(results, &BenchmarkResult::Failed);
+	return allRan ? 0 : 1;
+}
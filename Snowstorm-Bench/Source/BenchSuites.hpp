@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Snowstorm/Debug/Benchmark.hpp"
+
+#include <filesystem>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// Everything a suite may use. The benchmarks run with the current directory set to `Scratch` (a private
+	// temp directory), so the CWD-relative Engine/cache the cook paths write to never touches the checkout's.
+	struct BenchEnvironment
+	{
+		JobSystem& Jobs;
+		std::filesystem::path Scratch;
+	};
+
+	// One function per area, each registering its benchmarks under its own name prefix.
+	void RegisterJobSystemBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);    // jobs.*
+	void RegisterEcsBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);          // ecs.*
+	void RegisterCullingBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);      // cull.*
+	void RegisterAssetBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);        // asset.*
+	void RegisterSerializationBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env); // scene.*
+	void RegisterNeuralBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);       // neural.*
+	void RegisterRenderBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env);       // render.*
+}
@@ -0,0 +1,107 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/ECS/TrackedRegistry.hpp"
+#include "Snowstorm/Systems/VisibilitySystem.hpp"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+// VisibilitySystem's frustum cull at 10k..1M renderables. The system itself needs an Application (for its
+// JobSystem) and GPU meshes (for the bounds), so this runs its loop body as the system does: snapshot the
+// candidates from a view, then ParallelGather over them reading each TransformComponent, building the model
+// matrix and calling VisibilitySystem::IsInFrustum -- the same code, minus the mesh/material/layer lookups.
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// SplitMix-style hash to [0, 1): deterministic placement, so every run culls the same set.
+		float Hash01(uint64_t x)
+		{
+			x += 0x9E3779B97F4A7C15ull;
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			x ^= x >> 31;
+			return static_cast<float>(x >> 40) / static_cast<float>(1ull << 24);
+		}
+
+		struct CullScene
+		{
+			TrackedRegistry Registry;
+			MeshBounds Bounds; // one shared unit-cube mesh, as instanced props would be
+			Frustum View;
+		};
+
+		// `count` unit cubes scattered through a box around a camera at the origin looking down -Z, sized so
+		// roughly a quarter of them survive (the camera sees one side of the scene, as in a real level).
+		void BuildScene(CullScene& scene, const size_t count)
+		{
+			const float extent = 50.0f * std::cbrt(static_cast<float>(count) / 10'000.0f);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const entt::entity e = scene.Registry.create();
+				TransformComponent& tr = scene.Registry.emplace<TransformComponent>(e);
+				tr.Position = (glm::vec3(Hash01(i * 3), Hash01(i * 3 + 1), Hash01(i * 3 + 2)) * 2.0f - 1.0f) * extent;
+				tr.Rotation.y = Hash01(i * 7) * glm::two_pi<float>();
+			}
+			scene.Registry.ClearTrackedComponents();
+
+			scene.Bounds.Box = {glm::vec3(-0.5f), glm::vec3(0.5f)};
+			scene.Bounds.Sphere = {glm::vec3(0.0f), std::sqrt(3.0f) * 0.5f};
+
+			// Same projection convention as CameraRuntimeUpdateSystem (RH, zero-to-one depth).
+			const glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2.0f * extent);
+			scene.View = Frustum::FromViewProjection(proj);
+		}
+
+		void Cull(BenchmarkContext& ctx, JobSystem& jobs, const size_t count, const bool parallel)
+		{
+			CullScene scene;
+			BuildScene(scene, count);
+			const TrackedRegistry& reg = scene.Registry;
+
+			ctx.Measure([&]
+			{
+				const auto view = reg.view<TransformComponent>();
+				const std::vector<entt::entity> candidates(view.begin(), view.end());
+				const size_t grain = parallel ? size_t{256} : candidates.size() + 1;
+
+				const std::vector<entt::entity> visible = jobs.ParallelGather<entt::entity>(
+				    candidates.size(),
+				    [&](const size_t i, auto&& emit)
+				    {
+					    const entt::entity e = candidates[i];
+					    const glm::mat4 M = reg.Read<TransformComponent>(e).GetTransformMatrix();
+					    if (VisibilitySystem::IsInFrustum(scene.View, scene.Bounds, M))
+					    {
+						    emit(e);
+					    }
+				    },
+				    grain);
+				if (visible.empty() || visible.size() == candidates.size())
+				{
+					ctx.Fail("degenerate scene: the frustum keeps none or all of it");
+				}
+			});
+		}
+	}
+
+	void RegisterCullingBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env)
+	{
+		JobSystem& jobs = env.Jobs;
+		for (const auto& [name, count] : {std::pair{"10k", size_t{10'000}}, std::pair{"100k", size_t{100'000}},
+		                                  std::pair{"1m", size_t{1'000'000}}})
+		{
+			runner.Add(std::string("cull.") + name, [&jobs, count](BenchmarkContext& ctx) { Cull(ctx, jobs, count, true); });
+		}
+		// ecs.parallel off: the serial path the parallel rows are a speedup over.
+		runner.Add("cull.100k.serial", [&jobs](BenchmarkContext& ctx) { Cull(ctx, jobs, 100'000, false); });
+	}
+}
@@ -0,0 +1,96 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+
+#include <future>
+#include <vector>
+
+// JobSystem dispatch overhead: what a task costs on top of its body (queue lock, packaged_task, future), and
+// what ParallelFor / ParallelGather add over the serial loop they replace -- the numbers behind the grain
+// sizes the systems pick.
+
+namespace Snowstorm
+{
+	void RegisterJobSystemBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env)
+	{
+		JobSystem& jobs = env.Jobs;
+
+		runner.Add("jobs.submit.x1000", [&jobs](BenchmarkContext& ctx)
+		{
+			std::vector<std::future<int>> futures;
+			futures.reserve(1000);
+			ctx.Measure([&]
+			{
+				futures.clear();
+				for (int i = 0; i < 1000; ++i)
+				{
+					futures.push_back(jobs.Submit([i] { return i; }));
+				}
+				int sum = 0;
+				for (std::future<int>& f : futures)
+				{
+					sum += f.get();
+				}
+				DoNotOptimize(sum);
+			});
+		});
+
+		// Same 1M-element saxpy, fanned out at the engine's default grain and run inline: the difference is the
+		// dispatch + barrier cost, the ratio is the speedup the pool actually delivers on this machine.
+		const auto saxpy = [&jobs](BenchmarkContext& ctx, const size_t grain)
+		{
+			constexpr size_t kCount = 1'000'000;
+			std::vector<float> x(kCount, 1.5f);
+			std::vector<float> y(kCount, 0.5f);
+			ctx.Measure([&]
+			{
+				jobs.ParallelFor(kCount, [&](const size_t begin, const size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						y[i] = 0.999f * x[i] + y[i];
+					}
+				}, grain);
+				DoNotOptimize(y[kCount / 2]);
+			});
+		};
+		runner.Add("jobs.parallelfor.1m", [saxpy](BenchmarkContext& ctx) { saxpy(ctx, 256); });
+		runner.Add("jobs.parallelfor.1m.serial", [saxpy](BenchmarkContext& ctx) { saxpy(ctx, 0); });
+
+		// Tiny bodies, many chunks: pure scheduling cost per chunk.
+		runner.Add("jobs.parallelfor.chunks.x4096", [&jobs](BenchmarkContext& ctx)
+		{
+			std::vector<uint32_t> out(4096 * 16);
+			ctx.Measure([&]
+			{
+				jobs.ParallelFor(out.size(), [&](const size_t begin, const size_t end)
+				{
+					for (size_t i = begin; i < end; ++i)
+					{
+						out[i] = static_cast<uint32_t>(i);
+					}
+				}, 16);
+				DoNotOptimize(out.back());
+			});
+		});
+
+		runner.Add("jobs.gather.1m", [&jobs](BenchmarkContext& ctx)
+		{
+			constexpr size_t kCount = 1'000'000;
+			ctx.Measure([&]
+			{
+				const std::vector<uint32_t> odd = jobs.ParallelGather<uint32_t>(kCount, [](const size_t i, auto&& emit)
+				{
+					if (i % 2 == 1)
+					{
+						emit(static_cast<uint32_t>(i));
+					}
+				});
+				if (odd.size() != kCount / 2)
+				{
+					ctx.Fail("ParallelGather lost elements");
+				}
+			});
+		});
+	}
+}
@@ -0,0 +1,70 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Render/Neural/NeuralInference.hpp"
+#include "Snowstorm/Render/Neural/NeuralWeights.hpp"
+
+#include <cstdint>
+
+// Neural CPU inference (the CPU-only CI path of the upscaler): the default residual refiner's conv stack on a
+// 270p frame, threaded and single-threaded, and the whole 270p -> 540p Upscale. The weights are the identity
+// refiner's, which cost exactly what trained ones do -- the arithmetic doesn't look at the values.
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint32_t kWidth = 480;
+		constexpr uint32_t kHeight = 270;
+
+		Neural::FeatureMap MakeFrame()
+		{
+			Neural::FeatureMap frame;
+			frame.Channels = 3;
+			frame.Height = kHeight;
+			frame.Width = kWidth;
+			frame.Data.resize(static_cast<size_t>(3) * kHeight * kWidth);
+			for (size_t i = 0; i < frame.Data.size(); ++i)
+			{
+				frame.Data[i] = static_cast<float>((i * 2654435761u) % 1000u) / 1000.0f;
+			}
+			return frame;
+		}
+
+		void Refine(BenchmarkContext& ctx, JobSystem* jobs)
+		{
+			Neural::CpuInference inference(Neural::MakeIdentityRefiner(3));
+			const Neural::FeatureMap input = MakeFrame();
+			Neural::FeatureMap output;
+			ctx.Measure([&]
+			{
+				if (!inference.Run(input, output, jobs))
+				{
+					ctx.Fail("CpuInference::Run failed");
+				}
+			});
+		}
+	}
+
+	void RegisterNeuralBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env)
+	{
+		JobSystem& jobs = env.Jobs;
+
+		runner.Add("neural.refiner.270p", [&jobs](BenchmarkContext& ctx) { Refine(ctx, &jobs); });
+		runner.Add("neural.refiner.270p.serial", [](BenchmarkContext& ctx) { Refine(ctx, nullptr); });
+
+		runner.Add("neural.upscale.270p-540p", [&jobs](BenchmarkContext& ctx)
+		{
+			Neural::CpuInference inference(Neural::MakeIdentityRefiner(3));
+			const Neural::FeatureMap input = MakeFrame();
+			Neural::FeatureMap output;
+			ctx.Measure([&]
+			{
+				if (!inference.Upscale(input, kWidth * 2, kHeight * 2, output, &jobs))
+				{
+					ctx.Fail("CpuInference::Upscale failed");
+				}
+			});
+		});
+	}
+}
@@ -0,0 +1,93 @@
+#include "BenchSuites.hpp"
+
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Snowstorm/World/SceneBinarySerializer.hpp"
+#include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/World.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Scene save and load, in memory so disk speed stays out of it: the JSON .world path (RTTR property walk) and
+// the binary .ssworld path (generated codecs, chunks decoded on the JobSystem), on a 10k-entity scene of
+// named, transformed entities.
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr int kEntities = 10'000;
+
+		std::unique_ptr<World> MakeScene()
+		{
+			auto world = std::make_unique<World>();
+			for (int i = 0; i < kEntities; ++i)
+			{
+				Entity e = world->CreateEntity("Prop " + std::to_string(i));
+				TransformComponent& tr = e.AddComponent<TransformComponent>();
+				tr.Position = {static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)};
+				tr.Rotation.y = static_cast<float>(i) * 0.01f;
+			}
+			return world;
+		}
+
+		// A load fills a fresh World each sample (both loaders only add entities); building and dropping the
+		// previous one happens in the untimed setup.
+		template <typename Load>
+		void MeasureLoad(BenchmarkContext& ctx, Load&& load)
+		{
+			std::unique_ptr<World> target;
+			ctx.Measure([&] { target = std::make_unique<World>(); },
+			            [&]
+			            {
+				            if (!load(*target))
+				            {
+					            ctx.Fail("the scene didn't load");
+				            }
+			            });
+		}
+	}
+
+	void RegisterSerializationBenchmarks(BenchmarkRunner& runner, const BenchEnvironment& env)
+	{
+		JobSystem& jobs = env.Jobs;
+
+		runner.Add("scene.json.save.10k", [](BenchmarkContext& ctx)
+		{
+			const std::unique_ptr<World> scene = MakeScene();
+			ctx.Measure([&]
+			{
+				const std::string json = SceneSerializer::SerializeToString(*scene);
+				if (json.empty())
+				{
+					ctx.Fail("SerializeToString failed");
+				}
+			});
+		});
+
+		runner.Add("scene.json.load.10k", [](BenchmarkContext& ctx)
+		{
+			const std::string json = SceneSerializer::SerializeToString(*MakeScene());
+			MeasureLoad(ctx, [&](World& world) { return SceneSerializer::DeserializeFromString(world, json); });
+		});
+
+		runner.Add("scene.binary.save.10k", [](BenchmarkContext& ctx)
+		{
+			const std::unique_ptr<World> scene = MakeScene();
+			ctx.Measure([&]
+			{
+				const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(*scene);
+				DoNotOptimize(bytes.size());
+			});
+		});
+
+		runner.Add("scene.binary.load.10k", [&jobs](BenchmarkContext& ctx)
+		{
+			const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(*MakeScene());
+			MeasureLoad(ctx, [&](World& world) { return SceneBinarySerializer::DeserializeFromBytes(world, bytes, &jobs); });
+		});
+	}
+}
@@ -0,0 +1,161 @@
+#include "Snowstorm/Core/PlatformDetection.hpp"
+
+// Dormant: PlatformDetection.hpp #errors out on Linux today (engine is Windows-only for now),
+// so SS_PLATFORM_LINUX is never defined and this whole file compiles to an empty translation
+// unit. Kept so the watcher has a working backend the day Linux support lands.
+#ifdef SS_PLATFORM_LINUX
+
+#include "Snowstorm/Core/FileWatcher.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <unordered_map>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// inotify watches are per directory (no recursive flag), so every subdirectory of a root gets its own
+		// watch, and directories created later are added as their IN_CREATE arrives.
+		class LinuxFileWatcherBackend final : public FileWatcher::Backend
+		{
+		public:
+			LinuxFileWatcherBackend()
+			    : m_Fd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+			{
+			}
+
+			~LinuxFileWatcherBackend() override
+			{
+				if (m_Fd >= 0)
+				{
+					close(m_Fd); // drops every watch with it
+				}
+			}
+
+			[[nodiscard]] bool Valid() const { return m_Fd >= 0; }
+			[[nodiscard]] bool Empty() const { return m_Directories.empty(); }
+
+			// Watch `root` and everything below it. Files already inside a directory discovered after the fact
+			// (created together with it, e.g. an unzip) are reported into `existing` so they aren't missed.
+			void AddTree(const std::filesystem::path& root, std::vector<std::filesystem::path>* existing)
+			{
+				AddDirectory(root);
+				std::error_code ec;
+				for (auto it = std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, ec);
+				     !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+				{
+					if (it->is_directory(ec))
+					{
+						AddDirectory(it->path());
+					}
+					else if (existing)
+					{
+						existing->push_back(it->path());
+					}
+				}
+			}
+
+			bool Poll(std::vector<std::filesystem::path>& out, bool& overflowed, const uint32_t timeoutMs) override
+			{
+				pollfd pfd{m_Fd, POLLIN, 0};
+				const int ready = poll(&pfd, 1, static_cast<int>(timeoutMs));
+				if (ready < 0)
+				{
+					return errno == EINTR;
+				}
+				if (ready == 0)
+				{
+					return true;
+				}
+
+				alignas(inotify_event) char buffer[64 * 1024];
+				for (;;)
+				{
+					const ssize_t n = read(m_Fd, buffer, sizeof(buffer));
+					if (n < 0)
+					{
+						return errno == EAGAIN || errno == EINTR; // EAGAIN = drained
+					}
+
+					for (ssize_t offset = 0; offset < n;)
+					{
+						const auto* ev = reinterpret_cast<const inotify_event*>(buffer + offset);
+						offset += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+
+						if (ev->mask & IN_Q_OVERFLOW)
+						{
+							overflowed = true;
+							continue;
+						}
+						if (ev->mask & IN_IGNORED)
+						{
+							m_Directories.erase(ev->wd); // directory removed: the kernel dropped its watch
+							continue;
+						}
+
+						const auto dir = m_Directories.find(ev->wd);
+						if (dir == m_Directories.end() || ev->len == 0)
+						{
+							continue;
+						}
+						const std::filesystem::path path = dir->second / ev->name;
+
+						if (ev->mask & IN_ISDIR)
+						{
+							if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+							{
+								AddTree(path, &out);
+							}
+							continue;
+						}
+						// CLOSE_WRITE = an in-place save finished; MOVED_TO = a save-to-temp-then-rename landed.
+						if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+						{
+							out.push_back(path);
+						}
+					}
+				}
+			}
+
+		private:
+			void AddDirectory(const std::filesystem::path& dir)
+			{
+				const int wd = inotify_add_watch(m_Fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+				if (wd < 0)
+				{
+					SS_CORE_WARN("FileWatcher: cannot watch {} (errno={})", dir.string(), errno);
+					return;
+				}
+				m_Directories[wd] = dir;
+			}
+
+			int m_Fd = -1;
+			std::unordered_map<int, std::filesystem::path> m_Directories; // watch descriptor -> directory
+		};
+	}
+
+	std::unique_ptr<FileWatcher::Backend> FileWatcher::Backend::Create(const std::vector<std::filesystem::path>& roots)
+	{
+		auto backend = std::make_unique<LinuxFileWatcherBackend>();
+		if (!backend->Valid())
+		{
+			return nullptr;
+		}
+		for (const std::filesystem::path& root : roots)
+		{
+			backend->AddTree(root, nullptr);
+		}
+		if (backend->Empty())
+		{
+			return nullptr;
+		}
+		return backend;
+	}
+}
+
+#endif
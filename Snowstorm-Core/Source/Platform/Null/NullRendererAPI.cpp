@@ -0,0 +1,57 @@
+#include "NullRendererAPI.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+namespace Snowstorm
+{
+	void NullRendererAPI::Init(void* /*windowHandle*/)
+	{
+		m_Context = CreateRef<RecordingCommandContext>();
+
+		TextureDesc texDesc;
+		texDesc.Format = GetSurfaceFormat();
+		texDesc.Usage = TextureUsage::ColorAttachment;
+		texDesc.Width = kSwapchainWidth;
+		texDesc.Height = kSwapchainHeight;
+		texDesc.DebugName = "NullSwapchain";
+		const Ref<Texture> backbuffer = CreateRef<NullTexture>(texDesc);
+
+		RenderTargetDesc desc;
+		desc.Width = kSwapchainWidth;
+		desc.Height = kSwapchainHeight;
+		desc.IsSwapchainTarget = true;
+
+		RenderTargetAttachment color;
+		color.View = backbuffer->GetDefaultView();
+		desc.ColorAttachments.push_back(color);
+
+		m_SwapchainTarget = CreateRef<NullRenderTarget>(std::move(desc));
+		m_CurrentFrameIndex = 0;
+
+		SS_CORE_INFO("Null renderer initialized (headless, commands are recorded, not executed)");
+	}
+
+	void NullRendererAPI::Shutdown()
+	{
+		m_SwapchainTarget.reset();
+		m_Context.reset();
+	}
+
+	bool NullRendererAPI::BeginFrame()
+	{
+		// A frame's recording starts empty, as a freshly begun command buffer does.
+		m_Context->Reset();
+		return true;
+	}
+
+	void NullRendererAPI::EndFrame()
+	{
+		m_CurrentFrameIndex = (m_CurrentFrameIndex + 1) % kFramesInFlight;
+	}
+
+	const std::vector<std::string>& NullRendererAPI::GetGpuNames() const
+	{
+		static const std::vector<std::string> kNone;
+		return kNone;
+	}
+}
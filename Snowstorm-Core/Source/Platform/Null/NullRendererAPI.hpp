@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Platform/Null/RecordingCommandContext.hpp"
+
+#include "Snowstorm/Render/RendererAPI.hpp"
+
+namespace Snowstorm
+{
+	// RendererAPI::API::Null: no device, no surface, no window. One RecordingCommandContext serves every frame
+	// (BeginFrame resets its log), and the "swapchain" is a fixed-size stub target so passes that render to
+	// the backbuffer still record their pass. Capabilities report the conservative answer (no RT, no OMM, no
+	// fp16), so the render path takes its raster fallbacks -- the ones every machine runs.
+	class NullRendererAPI final : public RendererAPI
+	{
+	public:
+		static constexpr uint32_t kSwapchainWidth = 1280;
+		static constexpr uint32_t kSwapchainHeight = 720;
+
+		void Init(void* windowHandle) override;
+		void Shutdown() override;
+
+		void WaitIdle() override {}
+
+		bool BeginFrame() override;
+		void EndFrame() override;
+
+		float GetLastGpuWaitMs() const override { return 0.0f; }
+		float GetLastGpuFrameMs() const override { return 0.0f; }
+
+		void SetVSync(const bool enabled) override { m_VSync = enabled; }
+		bool IsVSync() const override { return m_VSync; }
+
+		uint32_t GetCurrentFrameIndex() const override { return m_CurrentFrameIndex; }
+		uint32_t GetFramesInFlight() const override { return kFramesInFlight; }
+
+		PixelFormat GetSurfaceFormat() const override { return PixelFormat::BGRA8_sRGB; }
+
+		Ref<RenderTarget> GetSwapchainTarget() const override { return m_SwapchainTarget; }
+
+		// The strictest value a desktop device reports, so uniform ring offsets are laid out as on hardware.
+		uint32_t GetMinUniformBufferOffsetAlignment() const override { return 256; }
+
+		std::string GetDeviceName() const override { return "Null (recording)"; }
+
+		bool IsRayTracingSupported() const override { return false; }
+		bool IsOpacityMicromapSupported() const override { return false; }
+		const std::vector<std::string>& GetGpuNames() const override;
+		int GetSelectedGpuIndex() const override { return -1; }
+		bool IsFloat16Supported() const override { return false; }
+		uint32_t GetMaxSampleCount() const override { return 8; }
+
+		Ref<CommandContext> GetGraphicsCommandContext() override { return m_Context; }
+
+		// The recording itself, for tests and benchmarks that inspect what a frame submitted.
+		[[nodiscard]] RecordingCommandContext& GetRecordingContext() const { return *m_Context; }
+
+		// No ImGui backend: nothing to draw into.
+		void InitImGuiBackend(void* /*windowHandle*/) override {}
+		void ShutdownImGuiBackend() override {}
+		void ImGuiNewFrame() override {}
+		void RenderImGuiDrawData(CommandContext& /*context*/) override {}
+
+	private:
+		// Matches the Vulkan backend, so per-frame rings and descriptor sets are sized the same.
+		static constexpr uint32_t kFramesInFlight = 2;
+
+		Ref<RecordingCommandContext> m_Context;
+		Ref<RenderTarget> m_SwapchainTarget;
+
+		uint32_t m_CurrentFrameIndex = 0;
+		bool m_VSync = true;
+	};
+}
@@ -0,0 +1,72 @@
+#include "NullResources.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <cstring>
+
+namespace Snowstorm
+{
+	NullBuffer::NullBuffer(const size_t size, const BufferUsage usage, const void* initialData, const bool hostVisible)
+	    : m_Usage(usage), m_Size(size)
+	{
+		if (hostVisible || usage == BufferUsage::Readback)
+		{
+			m_Memory.resize(size);
+		}
+		if (initialData)
+		{
+			SetData(initialData, size, 0);
+		}
+	}
+
+	void* NullBuffer::Map()
+	{
+		// Same contract as VulkanBuffer: only host-visible memory maps.
+		return m_Memory.empty() ? nullptr : m_Memory.data();
+	}
+
+	void NullBuffer::SetData(const void* data, const size_t size, const size_t offset)
+	{
+		SS_CORE_ASSERT(offset + size <= m_Size, "NullBuffer::SetData out of range");
+		if (!m_Memory.empty() && data && size > 0)
+		{
+			std::memcpy(m_Memory.data() + offset, data, size);
+		}
+	}
+
+	NullTexture::NullTexture(TextureDesc desc)
+	    : m_Desc(std::move(desc))
+	{
+	}
+
+	Ref<TextureView> NullTexture::GetDefaultView()
+	{
+		if (Ref<TextureView> view = m_DefaultView.lock())
+		{
+			return view;
+		}
+		Ref<TextureView> view = CreateRef<NullTextureView>(shared_from_this(), MakeFullViewDesc(m_Desc));
+		m_DefaultView = view;
+		return view;
+	}
+
+	NullTextureView::NullTextureView(const Ref<Texture>& texture, const TextureViewDesc& desc)
+	    : m_Texture(texture), m_Desc(desc)
+	{
+		SS_CORE_ASSERT(m_Texture, "NullTextureView requires a texture");
+	}
+
+	NullPipeline::NullPipeline(PipelineDesc desc)
+	    : m_Desc(std::move(desc))
+	{
+		constexpr uint32_t kSetCount = 4; // 0 = Frame, 1 = Material, 2 = Object, 3 = bindless
+		m_SetLayouts.reserve(kSetCount);
+		for (uint32_t set = 0; set < kSetCount; ++set)
+		{
+			DescriptorSetLayoutDesc layout;
+			layout.SetIndex = set;
+			layout.DebugName = m_Desc.DebugName + "_Set" + std::to_string(set);
+			m_SetLayouts.push_back(CreateRef<NullDescriptorSetLayout>(std::move(layout)));
+		}
+	}
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "Snowstorm/Render/Buffer.hpp"
+#include "Snowstorm/Render/DescriptorSet.hpp"
+#include "Snowstorm/Render/DescriptorSetLayout.hpp"
+#include "Snowstorm/Render/Pipeline.hpp"
+#include "Snowstorm/Render/RenderTarget.hpp"
+#include "Snowstorm/Render/Sampler.hpp"
+#include "Snowstorm/Render/Shader.hpp"
+#include "Snowstorm/Render/Texture.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// CPU-side stand-ins for the GPU resources, handed out by the Create* factories under RendererAPI::API::Null.
+// They keep their desc (so every GetDesc()/GetWidth() caller behaves as on a device) and nothing else, except
+// where engine code reads state back: host-visible buffers own real memory (the uniform ring maps and writes
+// into it), and textures track the layout they're in so the recording context emits a barrier exactly where
+// the Vulkan backend would (a transition to the current layout is a no-op there too).
+
+namespace Snowstorm
+{
+	class NullBuffer final : public Buffer
+	{
+	public:
+		NullBuffer(size_t size, BufferUsage usage, const void* initialData, bool hostVisible);
+
+		void* Map() override;
+		void Unmap() override {}
+		void SetData(const void* data, size_t size, size_t offset = 0) override;
+
+		// No device address space; 0 reads as "no buffer" to the RT paths, which the Null backend reports
+		// unsupported anyway.
+		uint64_t GetGPUAddress() const override { return 0; }
+		size_t GetSize() const override { return m_Size; }
+		BufferUsage GetUsage() const override { return m_Usage; }
+
+	private:
+		BufferUsage m_Usage;
+		size_t m_Size;
+
+		// Backing store for host-visible / readback buffers only (what Map() exposes). Device-local buffers
+		// have none: their uploads are dropped, nothing on the CPU can observe them.
+		std::vector<std::byte> m_Memory;
+	};
+
+	// The layouts VulkanCommandContext distinguishes, collapsed to what decides whether a transition emits a
+	// barrier. Depth and color attachments share one state: a texture is only ever one or the other.
+	enum class NullTextureLayout : uint8_t
+	{
+		Undefined,
+		Attachment,
+		Sampled,
+		Storage,
+		TransferSrc,
+	};
+
+	class NullTexture final : public Texture
+	{
+	public:
+		explicit NullTexture(TextureDesc desc);
+
+		[[nodiscard]] const TextureDesc& GetDesc() const override { return m_Desc; }
+		[[nodiscard]] Ref<TextureView> GetDefaultView() override;
+
+		void SetData(const void* /*data*/, uint32_t /*size*/) override {}
+		void SetMipData(const std::vector<std::vector<uint8_t>>& /*levels*/) override {}
+		void SetCubeData(const std::vector<std::vector<std::vector<uint8_t>>>& /*faces*/) override {}
+
+		bool operator==(const Texture& other) const override { return this == &other; }
+
+		[[nodiscard]] NullTextureLayout GetLayout() const { return m_Layout; }
+		void SetLayout(const NullTextureLayout layout) { m_Layout = layout; }
+
+		// Set when the texture last entered a write layout (attachment / storage) and cleared by the
+		// write -> compute-read barrier: the same bookkeeping as VulkanTexture's recorded write scope.
+		[[nodiscard]] bool HasPendingWrite() const { return m_PendingWrite; }
+		void SetPendingWrite(const bool pending) { m_PendingWrite = pending; }
+
+	private:
+		TextureDesc m_Desc;
+		std::weak_ptr<TextureView> m_DefaultView;
+		NullTextureLayout m_Layout = NullTextureLayout::Undefined;
+		bool m_PendingWrite = false;
+	};
+
+	// No bindless table: every view keeps slot 0 (the white texture's on a device), so Renderer::Init's
+	// "white texture must be index 0" holds however often a test re-inits the renderer.
+	class NullTextureView final : public TextureView
+	{
+	public:
+		NullTextureView(const Ref<Texture>& texture, const TextureViewDesc& desc);
+
+		[[nodiscard]] const TextureViewDesc& GetDesc() const override { return m_Desc; }
+		[[nodiscard]] const Ref<Texture>& GetTexture() const override { return m_Texture; }
+
+		[[nodiscard]] uint64_t GetUIID() const override { return reinterpret_cast<uint64_t>(this); }
+
+		bool operator==(const TextureView& other) const override { return this == &other; }
+
+	private:
+		Ref<Texture> m_Texture;
+		TextureViewDesc m_Desc;
+	};
+
+	class NullSampler final : public Sampler
+	{
+	public:
+		explicit NullSampler(SamplerDesc desc)
+		    : m_Desc(std::move(desc))
+		{
+		}
+
+		[[nodiscard]] const SamplerDesc& GetDesc() const override { return m_Desc; }
+
+	private:
+		SamplerDesc m_Desc;
+	};
+
+	class NullDescriptorSetLayout final : public DescriptorSetLayout
+	{
+	public:
+		explicit NullDescriptorSetLayout(DescriptorSetLayoutDesc desc)
+		    : m_Desc(std::move(desc))
+		{
+		}
+
+		[[nodiscard]] const DescriptorSetLayoutDesc& GetDesc() const override { return m_Desc; }
+
+	private:
+		DescriptorSetLayoutDesc m_Desc;
+	};
+
+	// Writes are accepted and dropped; nothing reads a set's contents back on the CPU.
+	class NullDescriptorSet final : public DescriptorSet
+	{
+	public:
+		NullDescriptorSet(const Ref<DescriptorSetLayout>& layout, DescriptorSetDesc desc)
+		    : m_Layout(layout), m_Desc(std::move(desc))
+		{
+		}
+
+		[[nodiscard]] const DescriptorSetDesc& GetDesc() const override { return m_Desc; }
+		[[nodiscard]] const Ref<DescriptorSetLayout>& GetLayout() const override { return m_Layout; }
+
+		void SetBuffer(uint32_t /*binding*/, const BufferBinding& /*buffer*/, uint32_t /*arrayIndex*/ = 0) override {}
+		void SetTexture(uint32_t /*binding*/, const Ref<TextureView>& /*textureView*/, uint32_t /*arrayIndex*/ = 0) override {}
+		void SetSampler(uint32_t /*binding*/, const Ref<Sampler>& /*sampler*/, uint32_t /*arrayIndex*/ = 0) override {}
+		void Commit() override {}
+
+	private:
+		Ref<DescriptorSetLayout> m_Layout;
+		DescriptorSetDesc m_Desc;
+	};
+
+	// There is no SPIR-V to reflect, so every pipeline reports the engine's fixed set table -- sets 0..2 plus
+	// the bindless set 3, each an empty layout -- which keeps the renderer's positional GetSetLayouts()[N]
+	// indexing valid for graphics and compute pipelines alike.
+	class NullPipeline final : public Pipeline
+	{
+	public:
+		explicit NullPipeline(PipelineDesc desc);
+
+		[[nodiscard]] const PipelineDesc& GetDesc() const override { return m_Desc; }
+		[[nodiscard]] const std::vector<Ref<DescriptorSetLayout>>& GetSetLayouts() const override { return m_SetLayouts; }
+
+		void SetSampleCount(const uint32_t samples) override { m_Desc.SampleCount = samples; }
+
+	private:
+		PipelineDesc m_Desc;
+		std::vector<Ref<DescriptorSetLayout>> m_SetLayouts;
+	};
+
+	class NullRenderTarget final : public RenderTarget
+	{
+	public:
+		explicit NullRenderTarget(RenderTargetDesc desc)
+		    : m_Desc(std::move(desc))
+		{
+		}
+
+		const RenderTargetDesc& GetDesc() const override { return m_Desc; }
+
+		void Resize(const uint32_t width, const uint32_t height) override
+		{
+			m_Desc.Width = width;
+			m_Desc.Height = height;
+		}
+
+	private:
+		RenderTargetDesc m_Desc;
+	};
+
+	// Never compiles: ready from construction, with no artifacts on disk.
+	class NullShader final : public Shader
+	{
+	public:
+		explicit NullShader(std::string path)
+		    : m_Path(std::move(path))
+		{
+		}
+
+		[[nodiscard]] const std::string& GetPath() const override { return m_Path; }
+		[[nodiscard]] std::string GetShaderPath() override { return m_Path; }
+		[[nodiscard]] std::string GetCompiledPath(ShaderStageKind /*stage*/) const override { return {}; }
+
+		[[nodiscard]] bool IsReady() const override { return true; }
+		[[nodiscard]] uint64_t GetVersion() const override { return m_Version; }
+
+		[[nodiscard]] ShaderPermutation GetPermutation() const override { return m_Permutation; }
+		void SetPermutation(const ShaderPermutation p) override { m_Permutation = p; }
+
+	protected:
+		// A recompile still publishes a new version, so version-keyed caches rebuild as they would.
+		void Compile() override { ++m_Version; }
+
+	private:
+		std::string m_Path;
+		uint64_t m_Version = 1;
+		ShaderPermutation m_Permutation = ShaderPermutation::Auto;
+	};
+}
@@ -0,0 +1,394 @@
+#include "RecordingCommandContext.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+
+namespace Snowstorm
+{
+	void RecordingCommandContext::Reset()
+	{
+		SS_CORE_ASSERT(!m_IsRendering, "RecordingCommandContext reset inside a render pass");
+		m_Commands.clear();
+		m_Names.clear();
+		m_Stats = {};
+		m_SkippedBinds = {};
+		m_ScopeDepth = 0;
+		ResetState();
+	}
+
+	uint32_t RecordingCommandContext::Count(const RecordedOp op) const
+	{
+		return static_cast<uint32_t>(std::ranges::count(m_Commands, op, &RecordedCommand::Op));
+	}
+
+	void RecordingCommandContext::Record(const RecordedOp op, const uint32_t a, const uint32_t b, const uint32_t c,
+	                                     const void* object)
+	{
+		m_Commands.push_back({op, a, b, c, object});
+	}
+
+	uint32_t RecordingCommandContext::Intern(const std::string& name)
+	{
+		// Pass and label names repeat a handful of times a frame; a linear scan beats hashing at that size.
+		const auto it = std::ranges::find(m_Names, name);
+		if (it != m_Names.end())
+		{
+			return static_cast<uint32_t>(it - m_Names.begin());
+		}
+		m_Names.push_back(name);
+		return static_cast<uint32_t>(m_Names.size() - 1);
+	}
+
+	void RecordingCommandContext::RecordBarrier(const RecordedBarrier kind, const void* texture)
+	{
+		SS_CORE_ASSERT(!m_IsRendering, "Barrier recorded inside a render pass");
+		Record(RecordedOp::Barrier, static_cast<uint32_t>(kind), 0, 0, texture);
+		++m_Stats.Barriers;
+	}
+
+	void RecordingCommandContext::Transition(const Ref<Texture>& texture, const NullTextureLayout layout)
+	{
+		SS_CORE_ASSERT(texture, "Transition of a null texture");
+		const auto tex = std::static_pointer_cast<NullTexture>(texture);
+		if (tex->GetLayout() == layout)
+		{
+			return;
+		}
+		tex->SetLayout(layout);
+		if (layout == NullTextureLayout::Attachment || layout == NullTextureLayout::Storage)
+		{
+			tex->SetPendingWrite(true);
+		}
+		RecordBarrier(RecordedBarrier::Transition, tex.get());
+	}
+
+	void RecordingCommandContext::BeginRenderPass(const RenderTarget& target)
+	{
+		SS_CORE_ASSERT(!m_IsRendering, "BeginRenderPass called while already rendering");
+
+		// The same attachment bookkeeping as VulkanCommandContext::BeginRenderPass: every attachment into
+		// the attachment layout first, then remember which ones EndRenderPass makes sampleable.
+		const RenderTargetDesc& desc = target.GetDesc();
+		m_CurrentColorTargets.clear();
+		m_CurrentSampledDepthTarget.reset();
+		m_CurrentTargetIsSwapchain = desc.IsSwapchainTarget;
+		for (const RenderTargetAttachment& a : desc.ColorAttachments)
+		{
+			const Ref<Texture>& tex = a.View->GetTexture();
+			Transition(tex, NullTextureLayout::Attachment);
+			if (a.ResolveView)
+			{
+				const Ref<Texture>& resolveTex = a.ResolveView->GetTexture();
+				Transition(resolveTex, NullTextureLayout::Attachment);
+				m_CurrentColorTargets.push_back(resolveTex);
+			}
+			else
+			{
+				m_CurrentColorTargets.push_back(tex);
+			}
+		}
+		if (desc.DepthAttachment.has_value())
+		{
+			const Ref<Texture>& depthTex = desc.DepthAttachment->View->GetTexture();
+			Transition(depthTex, NullTextureLayout::Attachment);
+			if (HasUsage(depthTex->GetDesc().Usage, TextureUsage::Sampled))
+			{
+				m_CurrentSampledDepthTarget = depthTex;
+			}
+		}
+
+		Record(RecordedOp::BeginRenderPass, target.GetWidth(), target.GetHeight(),
+		       static_cast<uint32_t>(desc.ColorAttachments.size()), &target);
+		++m_Stats.RenderPasses;
+		m_IsRendering = true;
+
+		// The device backend defaults viewport + scissor to the target; so does the recording.
+		SetViewport(0.0f, 0.0f, static_cast<float>(target.GetWidth()), static_cast<float>(target.GetHeight()));
+		SetScissor(0, 0, target.GetWidth(), target.GetHeight());
+	}
+
+	void RecordingCommandContext::EndRenderPass()
+	{
+		SS_CORE_ASSERT(m_IsRendering, "EndRenderPass called but no render pass is active");
+		Record(RecordedOp::EndRenderPass);
+		m_IsRendering = false;
+
+		if (!m_CurrentTargetIsSwapchain)
+		{
+			for (const Ref<Texture>& tex : m_CurrentColorTargets)
+			{
+				Transition(tex, NullTextureLayout::Sampled);
+			}
+		}
+		m_CurrentColorTargets.clear();
+
+		if (m_CurrentSampledDepthTarget)
+		{
+			Transition(m_CurrentSampledDepthTarget, NullTextureLayout::Sampled);
+			m_CurrentSampledDepthTarget.reset();
+		}
+	}
+
+	void RecordingCommandContext::BarrierDepthWriteToRead(const Ref<Texture>& depth)
+	{
+		RecordBarrier(RecordedBarrier::DepthWriteToRead, depth.get());
+	}
+
+	void RecordingCommandContext::SetViewport(const float /*x*/, const float /*y*/, const float width, const float height,
+	                                          const float /*minDepth*/, const float /*maxDepth*/)
+	{
+		Record(RecordedOp::SetViewport, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+		++m_Stats.DynamicStateSets;
+	}
+
+	void RecordingCommandContext::SetScissor(const uint32_t /*x*/, const uint32_t /*y*/, const uint32_t width,
+	                                         const uint32_t height)
+	{
+		Record(RecordedOp::SetScissor, width, height);
+		++m_Stats.DynamicStateSets;
+	}
+
+	void RecordingCommandContext::ClearDepthRect(const uint32_t /*x*/, const uint32_t /*y*/, const uint32_t width,
+	                                             const uint32_t height, const float /*depth*/)
+	{
+		SS_CORE_ASSERT(m_IsRendering, "ClearDepthRect outside a render pass");
+		Record(RecordedOp::ClearDepthRect, width, height);
+	}
+
+	void RecordingCommandContext::BindPipeline(const Ref<Pipeline>& pipeline)
+	{
+		SS_CORE_ASSERT(pipeline, "BindPipeline called with null pipeline");
+		if (m_BoundPipeline == pipeline.get())
+		{
+			++m_SkippedBinds.PipelineBinds;
+			return;
+		}
+		const bool compute = pipeline->GetDesc().Type == PipelineType::Compute;
+		Record(RecordedOp::BindPipeline, compute ? 1u : 0u, 0, 0, pipeline.get());
+		++m_Stats.PipelineBinds;
+		m_BoundPipeline = pipeline.get();
+		m_BoundSets.fill(nullptr);
+		m_GlobalResourcesBound = false;
+	}
+
+	void RecordingCommandContext::BindSets(const uint32_t firstSet, const DescriptorSet* const* sets, const uint32_t count,
+	                                       const uint32_t dynamicOffsetCount)
+	{
+		SS_CORE_ASSERT(m_BoundPipeline, "Descriptor sets bound before any pipeline");
+
+		// Trimmed to the span between the first and last changed set, as VulkanCommandContext does. Dynamic
+		// offsets can point the same set at a different slice, so such a bind is always recorded and leaves its
+		// slot unknown.
+		uint32_t begin = count;
+		uint32_t end = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			SS_CORE_ASSERT(sets[i], "BindDescriptorSets: null set");
+			const uint32_t index = firstSet + i;
+			if (dynamicOffsetCount > 0 || index >= kMaxTrackedSets || m_BoundSets[index] != sets[i])
+			{
+				begin = std::min(begin, i);
+				end = i + 1;
+			}
+		}
+		if (begin == count)
+		{
+			m_SkippedBinds.DescriptorSets += count;
+			return;
+		}
+		m_SkippedBinds.DescriptorSets += count - (end - begin);
+
+		Record(RecordedOp::BindDescriptorSets, firstSet + begin, end - begin, dynamicOffsetCount, sets[begin]);
+		++m_Stats.DescriptorBinds;
+		m_Stats.DescriptorSetsBound += end - begin;
+		for (uint32_t i = begin; i < end && firstSet + i < kMaxTrackedSets; ++i)
+		{
+			m_BoundSets[firstSet + i] = dynamicOffsetCount > 0 ? nullptr : sets[i];
+			if (firstSet + i == kGlobalResourcesSet)
+			{
+				m_GlobalResourcesBound = false;
+			}
+		}
+	}
+
+	void RecordingCommandContext::BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet, const uint32_t setIndex)
+	{
+		const DescriptorSet* set = descriptorSet.get();
+		BindSets(setIndex, &set, 1, 0);
+	}
+
+	void RecordingCommandContext::BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet, const uint32_t setIndex,
+	                                                const uint32_t* /*dynamicOffsets*/, const uint32_t dynamicOffsetCount)
+	{
+		const DescriptorSet* set = descriptorSet.get();
+		BindSets(setIndex, &set, 1, dynamicOffsetCount);
+	}
+
+	void RecordingCommandContext::BindDescriptorSets(const uint32_t firstSet, const std::vector<Ref<DescriptorSet>>& sets)
+	{
+		std::array<const DescriptorSet*, kMaxTrackedSets> raw{};
+		SS_CORE_ASSERT(sets.size() <= raw.size(), "BindDescriptorSets: more sets than the engine's set table");
+		if (sets.empty())
+		{
+			return; // nothing reaches the command buffer, as on the device
+		}
+		const auto count = static_cast<uint32_t>(std::min(sets.size(), raw.size()));
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			raw[i] = sets[i].get();
+		}
+		BindSets(firstSet, raw.data(), count, 0);
+	}
+
+	void RecordingCommandContext::BindVertexBuffer(const Ref<Buffer>& vertexBuffer, const uint32_t binding,
+	                                               const uint64_t offset)
+	{
+		if (binding < kTrackedVertexBindings)
+		{
+			if (m_BoundVertexBuffers[binding] == vertexBuffer.get() && m_BoundVertexOffsets[binding] == offset)
+			{
+				++m_SkippedBinds.VertexBuffers;
+				return;
+			}
+			m_BoundVertexBuffers[binding] = vertexBuffer.get();
+			m_BoundVertexOffsets[binding] = offset;
+		}
+		Record(RecordedOp::BindVertexBuffer, binding, 0, 0, vertexBuffer.get());
+		++m_Stats.VertexBufferBinds;
+	}
+
+	void RecordingCommandContext::BindGlobalResources()
+	{
+		SS_CORE_ASSERT(m_BoundPipeline, "Must bind pipeline before global resources");
+		if (m_GlobalResourcesBound)
+		{
+			++m_SkippedBinds.DescriptorSets;
+			return;
+		}
+		Record(RecordedOp::BindGlobalResources);
+		++m_Stats.DescriptorBinds;
+		++m_Stats.DescriptorSetsBound;
+		m_BoundSets[kGlobalResourcesSet] = nullptr;
+		m_GlobalResourcesBound = true;
+	}
+
+	void RecordingCommandContext::PushConstants(const void* /*data*/, const uint32_t size, const uint32_t offset)
+	{
+		Record(RecordedOp::PushConstants, size, offset);
+		++m_Stats.PushConstantWrites;
+	}
+
+	void RecordingCommandContext::Draw(const uint32_t vertexCount, const uint32_t instanceCount, const uint32_t /*firstVertex*/)
+	{
+		SS_CORE_ASSERT(m_IsRendering, "Draw outside a render pass");
+		Record(RecordedOp::Draw, vertexCount, instanceCount);
+		++m_Stats.DrawCalls;
+		m_Stats.Instances += instanceCount;
+		m_Stats.Triangles += vertexCount / 3u * instanceCount;
+	}
+
+	void RecordingCommandContext::DrawIndexed(const Ref<Buffer>& indexBuffer, const uint32_t indexCount,
+	                                          const uint32_t instanceCount, const uint32_t /*firstIndex*/,
+	                                          const int32_t /*vertexOffset*/, const uint32_t firstInstance)
+	{
+		SS_CORE_ASSERT(m_IsRendering, "DrawIndexed outside a render pass");
+		if (indexBuffer.get() != m_BoundIndexBuffer)
+		{
+			Record(RecordedOp::BindIndexBuffer, 0, 0, 0, indexBuffer.get());
+			++m_Stats.IndexBufferBinds;
+			m_BoundIndexBuffer = indexBuffer.get();
+		}
+		else
+		{
+			++m_SkippedBinds.IndexBuffers;
+		}
+		Record(RecordedOp::DrawIndexed, indexCount, instanceCount, firstInstance, indexBuffer.get());
+		++m_Stats.DrawCalls;
+		m_Stats.Instances += instanceCount;
+		m_Stats.Triangles += indexCount / 3u * instanceCount;
+	}
+
+	void RecordingCommandContext::Dispatch(const uint32_t groupX, const uint32_t groupY, const uint32_t groupZ)
+	{
+		SS_CORE_ASSERT(!m_IsRendering, "Dispatch inside a render pass");
+		Record(RecordedOp::Dispatch, groupX, groupY, groupZ);
+		++m_Stats.Dispatches;
+	}
+
+	void RecordingCommandContext::TransitionToStorage(const Ref<Texture>& texture)
+	{
+		Transition(texture, NullTextureLayout::Storage);
+	}
+
+	void RecordingCommandContext::TransitionToSampled(const Ref<Texture>& texture)
+	{
+		Transition(texture, NullTextureLayout::Sampled);
+	}
+
+	void RecordingCommandContext::BarrierColorWriteToComputeRead(const Ref<Texture>& texture)
+	{
+		// Always emitted, like the device backend's (which falls back to a color-write scope when nothing was
+		// recorded); the pending write is consumed.
+		RecordBarrier(RecordedBarrier::ColorWriteToComputeRead, texture.get());
+		if (texture)
+		{
+			std::static_pointer_cast<NullTexture>(texture)->SetPendingWrite(false);
+		}
+	}
+
+	void RecordingCommandContext::BarrierComputeStorage()
+	{
+		RecordBarrier(RecordedBarrier::ComputeStorage, nullptr);
+	}
+
+	void RecordingCommandContext::CopyTextureToBuffer(const Ref<Texture>& texture, const Ref<Buffer>& dst,
+	                                                  const uint32_t mipLevel, const uint32_t arrayLayer)
+	{
+		SS_CORE_ASSERT(texture && dst, "CopyTextureToBuffer: null texture or buffer");
+		// Sampled -> transfer source -> sampled around the copy, as VulkanCommandContext does. The buffer
+		// keeps whatever it held: there are no texels to read back.
+		Transition(texture, NullTextureLayout::TransferSrc);
+		Record(RecordedOp::CopyTextureToBuffer, mipLevel, arrayLayer, 0, texture.get());
+		++m_Stats.Copies;
+		Transition(texture, NullTextureLayout::Sampled);
+	}
+
+	void RecordingCommandContext::ResetState()
+	{
+		m_BoundPipeline = nullptr;
+		m_BoundSets.fill(nullptr);
+		m_GlobalResourcesBound = false;
+		m_BoundVertexBuffers.fill(nullptr);
+		m_BoundVertexOffsets.fill(0);
+		m_BoundIndexBuffer = nullptr;
+	}
+
+	void RecordingCommandContext::BeginGpuScope(const std::string& name)
+	{
+		Record(RecordedOp::BeginScope, Intern(name), m_ScopeDepth);
+		++m_ScopeDepth;
+	}
+
+	void RecordingCommandContext::EndGpuScope()
+	{
+		SS_CORE_ASSERT(m_ScopeDepth > 0, "EndGpuScope without a matching BeginGpuScope");
+		--m_ScopeDepth;
+		Record(RecordedOp::EndScope);
+	}
+
+	void RecordingCommandContext::BeginDebugLabel(const std::string& name, float /*r*/, float /*g*/, float /*b*/)
+	{
+		Record(RecordedOp::BeginLabel, Intern(name));
+	}
+
+	void RecordingCommandContext::EndDebugLabel()
+	{
+		Record(RecordedOp::EndLabel);
+	}
+
+	void RecordingCommandContext::InsertDebugLabel(const std::string& name, float /*r*/, float /*g*/, float /*b*/)
+	{
+		Record(RecordedOp::InsertLabel, Intern(name));
+	}
+}
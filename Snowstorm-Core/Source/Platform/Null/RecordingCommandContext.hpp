@@ -0,0 +1,215 @@
+#pragma once
+
+#include "NullResources.hpp"
+
+#include "Snowstorm/Render/CommandContext.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	// What a recorded command did. The A/B/C payload of a RecordedCommand is op-specific:
+	//   BeginRenderPass      A = width, B = height, C = color attachment count; Object = the RenderTarget
+	//   Barrier              A = RecordedBarrier kind; Object = the texture (null for a global barrier)
+	//   SetViewport/Scissor  A = width, B = height
+	//   ClearDepthRect       A = width, B = height
+	//   BindPipeline         A = 1 for a compute pipeline; Object = the pipeline
+	//   BindDescriptorSets   A = first set, B = set count, C = dynamic offset count; Object = the first set
+	//   BindVertexBuffer     A = binding; Object = the buffer
+	//   BindIndexBuffer      Object = the buffer
+	//   PushConstants        A = size, B = offset
+	//   Draw                 A = vertex count, B = instance count
+	//   DrawIndexed          A = index count, B = instance count, C = first instance; Object = the index buffer
+	//   Dispatch             A/B/C = group counts
+	//   CopyTextureToBuffer  A = mip, B = array layer; Object = the texture
+	//   BeginScope           A = index into RecordingCommandContext::Names(), B = nesting depth
+	//   BeginLabel/InsertLabel  A = index into RecordingCommandContext::Names()
+	enum class RecordedOp : uint8_t
+	{
+		BeginRenderPass,
+		EndRenderPass,
+		Barrier,
+		SetViewport,
+		SetScissor,
+		ClearDepthRect,
+		BindPipeline,
+		BindDescriptorSets,
+		BindGlobalResources,
+		BindVertexBuffer,
+		BindIndexBuffer,
+		PushConstants,
+		Draw,
+		DrawIndexed,
+		Dispatch,
+		CopyTextureToBuffer,
+		BeginScope,
+		EndScope,
+		BeginLabel,
+		EndLabel,
+		InsertLabel,
+	};
+
+	enum class RecordedBarrier : uint8_t
+	{
+		Transition,              // a layout change (attachment / sampled / storage / transfer)
+		DepthWriteToRead,        // BarrierDepthWriteToRead
+		ColorWriteToComputeRead, // BarrierColorWriteToComputeRead
+		ComputeStorage,          // BarrierComputeStorage
+	};
+
+	// One entry of the command log: 24 bytes, no heap. Object identifies the resource the command touched so
+	// a test can tell binds apart; it is an identity only -- the log holds no reference, so it may dangle once
+	// the resource dies and must never be dereferenced.
+	struct RecordedCommand
+	{
+		RecordedOp Op = RecordedOp::EndRenderPass;
+		uint32_t A = 0;
+		uint32_t B = 0;
+		uint32_t C = 0;
+		const void* Object = nullptr;
+	};
+
+	// Running totals of a recording (since the last Reset): the CPU submit cost of a frame, in the units the
+	// driver charges for -- calls, state changes and barriers.
+	struct RecordedCommandStats
+	{
+		uint32_t RenderPasses = 0;
+		uint32_t DrawCalls = 0; // Draw + DrawIndexed
+		uint32_t Instances = 0; // summed instance counts of those draws
+		uint32_t Triangles = 0; // vertices (Draw) or indices (DrawIndexed) / 3, times instances
+		uint32_t Dispatches = 0;
+
+		uint32_t PipelineBinds = 0;
+		uint32_t DescriptorBinds = 0; // bind calls, BindGlobalResources included
+		uint32_t DescriptorSetsBound = 0;
+		uint32_t VertexBufferBinds = 0;
+		uint32_t IndexBufferBinds = 0;
+		uint32_t PushConstantWrites = 0;
+		uint32_t DynamicStateSets = 0; // viewport + scissor
+
+		uint32_t Barriers = 0;
+		uint32_t Copies = 0;
+
+		[[nodiscard]] uint32_t StateChanges() const
+		{
+			return PipelineBinds + DescriptorBinds + VertexBufferBinds + IndexBufferBinds + PushConstantWrites +
+			       DynamicStateSets;
+		}
+	};
+
+	// The Null backend's command context: records the command stream into a compact in-memory log instead
+	// of a command buffer. Mirrors VulkanCommandContext's bookkeeping where it decides what gets emitted --
+	// attachments move to the attachment layout on BeginRenderPass and back to sampled on EndRenderPass, a
+	// transition to the current layout records nothing -- so barrier counts match what the device backend
+	// would record -- and redundant binds are dropped by the same rules, so the log holds only the binds the
+	// device would see and GetSkippedBinds reports what was filtered. Asserts the same structural rules (no nested passes, no draws outside one, no barriers
+	// inside one), so a broken command stream fails a headless test rather than a GPU validation run.
+	class RecordingCommandContext final : public CommandContext
+	{
+	public:
+		// Drop the log, the stats and the bound state; the texture layouts persist (they live on the
+		// textures, across frames, as on the device).
+		void Reset();
+
+		[[nodiscard]] const std::vector<RecordedCommand>& Commands() const { return m_Commands; }
+		[[nodiscard]] const std::vector<std::string>& Names() const { return m_Names; }
+		[[nodiscard]] const RecordedCommandStats& Stats() const { return m_Stats; }
+
+		// How many recorded commands have op `op`.
+		[[nodiscard]] uint32_t Count(RecordedOp op) const;
+
+		void BeginRenderPass(const RenderTarget& target) override;
+		void EndRenderPass() override;
+
+		void BarrierDepthWriteToRead(const Ref<Texture>& depth) override;
+
+		void SetViewport(float x, float y, float width, float height,
+		                 float minDepth = 0.0f, float maxDepth = 1.0f) override;
+		void SetScissor(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void ClearDepthRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, float depth = 1.0f) override;
+
+		void BindPipeline(const Ref<Pipeline>& pipeline) override;
+
+		void BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet, uint32_t setIndex) override;
+		void BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet,
+		                       uint32_t setIndex,
+		                       const uint32_t* dynamicOffsets,
+		                       uint32_t dynamicOffsetCount) override;
+		void BindDescriptorSets(uint32_t firstSet, const std::vector<Ref<DescriptorSet>>& sets) override;
+
+		void BindVertexBuffer(const Ref<Buffer>& vertexBuffer, uint32_t binding = 0, uint64_t offset = 0) override;
+
+		void BindGlobalResources() override;
+
+		void PushConstants(const void* data, uint32_t size, uint32_t offset = 0) override;
+
+		void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0) override;
+
+		void DrawIndexed(const Ref<Buffer>& indexBuffer, uint32_t indexCount,
+		                 uint32_t instanceCount = 1,
+		                 uint32_t firstIndex = 0,
+		                 int32_t vertexOffset = 0,
+		                 uint32_t firstInstance = 0) override;
+
+		void Dispatch(uint32_t groupX, uint32_t groupY, uint32_t groupZ) override;
+
+		void TransitionToStorage(const Ref<Texture>& texture) override;
+		void TransitionToSampled(const Ref<Texture>& texture) override;
+		void BarrierColorWriteToComputeRead(const Ref<Texture>& texture) override;
+		void BarrierComputeStorage() override;
+		void CopyTextureToBuffer(const Ref<Texture>& texture, const Ref<Buffer>& dst,
+		                         uint32_t mipLevel = 0, uint32_t arrayLayer = 0) override;
+
+		void ResetState() override;
+		SkippedBindStats GetSkippedBinds() const override { return m_SkippedBinds; }
+
+		// Scopes are recorded (they bracket the passes in the log) but never timed: no timestamps, so
+		// CollectGpuScopes reports nothing, as on a device without timestamp support.
+		void BeginGpuScope(const std::string& name) override;
+		void EndGpuScope() override;
+		std::vector<GpuScope> CollectGpuScopes() override { return {}; }
+
+		void BeginDebugLabel(const std::string& name, float r, float g, float b) override;
+		void EndDebugLabel() override;
+		void InsertDebugLabel(const std::string& name, float r, float g, float b) override;
+
+	private:
+		// Highest descriptor set index tracked for redundant-bind detection (the engine uses 0..3).
+		static constexpr uint32_t kMaxTrackedSets = 8;
+		static constexpr uint32_t kGlobalResourcesSet = 3;
+		static constexpr uint32_t kTrackedVertexBindings = 4;
+
+		void Record(RecordedOp op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, const void* object = nullptr);
+		uint32_t Intern(const std::string& name);
+
+		void Transition(const Ref<Texture>& texture, NullTextureLayout layout);
+		void RecordBarrier(RecordedBarrier kind, const void* texture);
+		void BindSets(uint32_t firstSet, const DescriptorSet* const* sets, uint32_t count, uint32_t dynamicOffsetCount);
+
+		std::vector<RecordedCommand> m_Commands;
+		std::vector<std::string> m_Names;
+		RecordedCommandStats m_Stats;
+		SkippedBindStats m_SkippedBinds;
+
+		// Bound state (cleared by ResetState, like VulkanCommandContext's bind cache). A null entry is unknown.
+		// Set slots are cleared on every pipeline change: each Null pipeline has its own layouts, as each Vulkan
+		// one does, and the device context drops its sets on a layout change. The bindless set is slot 3 on the
+		// device; here it has no object, so its own flag stands in.
+		const Pipeline* m_BoundPipeline = nullptr;
+		std::array<const DescriptorSet*, kMaxTrackedSets> m_BoundSets{};
+		bool m_GlobalResourcesBound = false;
+		std::array<const Buffer*, kTrackedVertexBindings> m_BoundVertexBuffers{};
+		std::array<uint64_t, kTrackedVertexBindings> m_BoundVertexOffsets{};
+		const Buffer* m_BoundIndexBuffer = nullptr;
+
+		// The open render pass: which targets EndRenderPass hands back to the sampled layout.
+		bool m_IsRendering = false;
+		bool m_CurrentTargetIsSwapchain = false;
+		std::vector<Ref<Texture>> m_CurrentColorTargets;
+		Ref<Texture> m_CurrentSampledDepthTarget;
+
+		uint32_t m_ScopeDepth = 0;
+	};
+}
@@ -11,6 +11,8 @@
 #include "Platform/Vulkan/VulkanGraphicsPipeline.hpp"
 #include "Platform/Vulkan/VulkanDescriptorSet.hpp"
 
+#include <algorithm>
+
 namespace Snowstorm
 {
 	namespace
@@ -124,6 +126,8 @@ namespace Snowstorm
 	void VulkanCommandContext::Begin()
 	{
 		m_IsRendering = false;
+		m_SkippedBinds = {};
+		InvalidateBindCache();
 
 		SS_CORE_ASSERT(m_CommandBuffer != VK_NULL_HANDLE, "Command buffer not initialized");
 
@@ -378,17 +382,39 @@ namespace Snowstorm
 		vkCmdSetScissor(m_CommandBuffer, 0, 1, &scissor);
 	}
 
+	void VulkanCommandContext::ClearDepthRect(const uint32_t x, const uint32_t y,
+	                                          const uint32_t width, const uint32_t height, const float depth)
+	{
+		SS_CORE_ASSERT(m_IsRendering, "ClearDepthRect called outside a render pass");
+
+		// vkCmdClearAttachments is the in-pass clear: it ignores the scissor and the pipeline, and touches only
+		// the rect given, so the rest of a loaded atlas keeps its depth.
+		const VkClearAttachment attachment{
+		    .aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT,
+		    .colorAttachment = 0,
+		    .clearValue = {.depthStencil = {.depth = depth, .stencil = 0}}};
+		const VkClearRect rect{
+		    .rect = {.offset = {static_cast<int32_t>(x), static_cast<int32_t>(y)}, .extent = {width, height}},
+		    .baseArrayLayer = 0,
+		    .layerCount = 1};
+
+		vkCmdClearAttachments(m_CommandBuffer, 1, &attachment, 1, &rect);
+	}
+
 	void VulkanCommandContext::BindPipeline(const Ref<Pipeline>& pipeline)
 	{
 		SS_CORE_ASSERT(pipeline, "BindPipeline called with null pipeline");
 
 		// Bind graphics or compute based on the pipeline's type; only one "current" pointer is live at a
 		// time (the other is reset) so PushConstants knows which layout/stages to use.
+		const VkPipelineLayout previousLayout = m_CurrentPipelineLayout;
+		const VkPipelineBindPoint previousBindPoint = m_CurrentBindPoint;
+		VkPipeline handle;
 		if (pipeline->GetDesc().Type == PipelineType::Compute)
 		{
 			m_CurrentComputePipeline = std::static_pointer_cast<VulkanComputePipeline>(pipeline);
 			m_CurrentGraphicsPipeline.reset();
-			vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_CurrentComputePipeline->GetHandle());
+			handle = m_CurrentComputePipeline->GetHandle();
 			m_CurrentPipelineLayout = m_CurrentComputePipeline->GetPipelineLayout();
 			m_CurrentBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
 		}
@@ -396,10 +422,62 @@ namespace Snowstorm
 		{
 			m_CurrentGraphicsPipeline = std::static_pointer_cast<VulkanGraphicsPipeline>(pipeline);
 			m_CurrentComputePipeline.reset();
-			vkCmdBindPipeline(m_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_CurrentGraphicsPipeline->GetHandle());
+			handle = m_CurrentGraphicsPipeline->GetHandle();
 			m_CurrentPipelineLayout = m_CurrentGraphicsPipeline->GetPipelineLayout();
 			m_CurrentBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 		}
+
+		// The same pipeline as the last bind leaves layout and bind point unchanged too, so the whole bind is a
+		// no-op. Any other pipeline is recorded, and a new layout or bind point drops the tracked sets.
+		if (handle == m_BoundPipeline)
+		{
+			++m_SkippedBinds.PipelineBinds;
+			return;
+		}
+		vkCmdBindPipeline(m_CommandBuffer, m_CurrentBindPoint, handle);
+		m_BoundPipeline = handle;
+		if (m_CurrentPipelineLayout != previousLayout || m_CurrentBindPoint != previousBindPoint)
+		{
+			m_BoundSets.fill(VK_NULL_HANDLE);
+		}
+	}
+
+	void VulkanCommandContext::BindSetsFiltered(const uint32_t firstSet, const VkDescriptorSet* handles,
+	                                            const uint32_t count)
+	{
+		// Narrow [firstSet, firstSet + count) to the span between the first and last set that differ from what's
+		// bound; the unchanged sets inside that span ride along (one contiguous call beats splitting it).
+		uint32_t begin = count;
+		uint32_t end = 0;
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const uint32_t slot = firstSet + i;
+			if (slot >= kTrackedSets || m_BoundSets[slot] != handles[i])
+			{
+				begin = std::min(begin, i);
+				end = i + 1;
+			}
+		}
+		if (begin == count)
+		{
+			m_SkippedBinds.DescriptorSets += count;
+			return;
+		}
+		m_SkippedBinds.DescriptorSets += count - (end - begin);
+
+		vkCmdBindDescriptorSets(
+		    m_CommandBuffer,
+		    m_CurrentBindPoint,
+		    m_CurrentPipelineLayout,
+		    firstSet + begin,
+		    end - begin,
+		    handles + begin,
+		    0,
+		    nullptr);
+		for (uint32_t i = begin; i < end && firstSet + i < kTrackedSets; ++i)
+		{
+			m_BoundSets[firstSet + i] = handles[i];
+		}
 	}
 
 	void VulkanCommandContext::BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet, const uint32_t setIndex)
@@ -411,15 +489,7 @@ namespace Snowstorm
 		const auto vkSet = std::static_pointer_cast<VulkanDescriptorSet>(descriptorSet);
 		const VkDescriptorSet setHandle = vkSet->GetHandle();
 
-		vkCmdBindDescriptorSets(
-		    m_CommandBuffer,
-		    m_CurrentBindPoint,
-		    m_CurrentPipelineLayout,
-		    setIndex,
-		    1,
-		    &setHandle,
-		    0,
-		    nullptr);
+		BindSetsFiltered(setIndex, &setHandle, 1);
 	}
 
 	void VulkanCommandContext::BindDescriptorSets(const uint32_t firstSet, const std::vector<Ref<DescriptorSet>>& sets)
@@ -441,15 +511,7 @@ namespace Snowstorm
 			handles.push_back(std::static_pointer_cast<VulkanDescriptorSet>(set)->GetHandle());
 		}
 
-		vkCmdBindDescriptorSets(
-		    m_CommandBuffer,
-		    m_CurrentBindPoint,
-		    m_CurrentPipelineLayout,
-		    firstSet,
-		    static_cast<uint32_t>(handles.size()),
-		    handles.data(),
-		    0,
-		    nullptr);
+		BindSetsFiltered(firstSet, handles.data(), static_cast<uint32_t>(handles.size()));
 	}
 
 	void VulkanCommandContext::BindDescriptorSet(const Ref<DescriptorSet>& descriptorSet,
@@ -475,6 +537,13 @@ namespace Snowstorm
 		    &setHandle,
 		    dynamicOffsetCount,
 		    dynamicOffsets);
+
+		// Always recorded: the same set at new offsets is new state, and the cache doesn't track offsets. The
+		// slot becomes unknown so a later plain bind of this set isn't mistaken for a repeat.
+		if (setIndex < kTrackedSets)
+		{
+			m_BoundSets[setIndex] = VK_NULL_HANDLE;
+		}
 	}
 
 	void VulkanCommandContext::PushConstants(const void* data, const uint32_t size, const uint32_t offset)
@@ -637,6 +706,16 @@ namespace Snowstorm
 		m_CurrentBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 		m_CurrentGraphicsPipeline.reset();
 		m_CurrentComputePipeline.reset();
+		InvalidateBindCache();
+	}
+
+	void VulkanCommandContext::InvalidateBindCache()
+	{
+		m_BoundPipeline = VK_NULL_HANDLE;
+		m_BoundSets.fill(VK_NULL_HANDLE);
+		m_BoundVertexBuffers.fill(VK_NULL_HANDLE);
+		m_BoundVertexOffsets.fill(0);
+		m_BoundIndexBuffer = VK_NULL_HANDLE;
 	}
 
 	void VulkanCommandContext::BeginGpuScope(const std::string& name)
@@ -796,6 +875,16 @@ namespace Snowstorm
 		const VkBuffer buf = vkBuffer->GetHandle();
 		const VkDeviceSize offs = offset;
 
+		if (binding < kTrackedVertexBindings)
+		{
+			if (m_BoundVertexBuffers[binding] == buf && m_BoundVertexOffsets[binding] == offs)
+			{
+				++m_SkippedBinds.VertexBuffers;
+				return;
+			}
+			m_BoundVertexBuffers[binding] = buf;
+			m_BoundVertexOffsets[binding] = offs;
+		}
 		vkCmdBindVertexBuffers(m_CommandBuffer, binding, 1, &buf, &offs);
 	}
 
@@ -804,11 +893,8 @@ namespace Snowstorm
 		SS_CORE_ASSERT(m_CurrentPipelineLayout != VK_NULL_HANDLE, "Must bind pipeline before global resources");
 
 		// Bind Set 3 (Bindless)
-		VkDescriptorSet bindlessSet = VulkanBindlessManager::Get().GetDescriptorSet();
-		vkCmdBindDescriptorSets(m_CommandBuffer,
-		                        m_CurrentBindPoint,
-		                        m_CurrentPipelineLayout,
-		                        3, 1, &bindlessSet, 0, nullptr);
+		const VkDescriptorSet bindlessSet = VulkanBindlessManager::Get().GetDescriptorSet();
+		BindSetsFiltered(3, &bindlessSet, 1);
 	}
 
 	void VulkanCommandContext::Draw(const uint32_t vertexCount, const uint32_t instanceCount,
@@ -831,7 +917,16 @@ namespace Snowstorm
 		// You may want to store index type in your Buffer or Pipeline.
 		const VkIndexType indexType = VK_INDEX_TYPE_UINT32;
 
-		vkCmdBindIndexBuffer(m_CommandBuffer, buf, 0, indexType);
+		// Every indexed draw names its index buffer; consecutive draws of one mesh only need it bound once.
+		if (buf != m_BoundIndexBuffer)
+		{
+			vkCmdBindIndexBuffer(m_CommandBuffer, buf, 0, indexType);
+			m_BoundIndexBuffer = buf;
+		}
+		else
+		{
+			++m_SkippedBinds.IndexBuffers;
+		}
 		vkCmdDrawIndexed(m_CommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 	}
 
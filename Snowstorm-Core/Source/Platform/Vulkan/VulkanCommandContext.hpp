@@ -4,6 +4,7 @@
 
 #include "Snowstorm/Render/CommandContext.hpp"
 
+#include <array>
 #include <vector>
 
 namespace Snowstorm
@@ -33,6 +34,7 @@ namespace Snowstorm
 		void SetViewport(float x, float y, float width, float height,
 		                 float minDepth = 0.0f, float maxDepth = 1.0f) override;
 		void SetScissor(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+		void ClearDepthRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, float depth = 1.0f) override;
 
 		void BindPipeline(const Ref<Pipeline>& pipeline) override;
 
@@ -71,6 +73,11 @@ namespace Snowstorm
 		                         uint32_t mipLevel = 0, uint32_t arrayLayer = 0) override;
 
 		void ResetState() override;
+		SkippedBindStats GetSkippedBinds() const override { return m_SkippedBinds; }
+
+		// Forget what's bound, so the next bind of every kind is recorded. Call after anything records binds
+		// straight into GetVulkanCommandBuffer() behind this context's back (ImGui's renderer does).
+		void InvalidateBindCache();
 
 		void BeginGpuScope(const std::string& name) override;
 		void EndGpuScope() override;
@@ -129,6 +136,25 @@ namespace Snowstorm
 		Ref<VulkanGraphicsPipeline> m_CurrentGraphicsPipeline;
 		Ref<VulkanComputePipeline> m_CurrentComputePipeline;
 
+		// --- Redundant-bind filtering ---
+		// What this recording last bound, so a bind that asks for the state already in place is dropped rather
+		// than recorded again (sorted batches hand us long runs sharing a pipeline / material / mesh). The set
+		// slots are only meaningful for the current layout + bind point: BindPipeline clears them when either
+		// changes, as a layout switch may disturb them. VK_NULL_HANDLE means "unknown", never a match. Sets and
+		// vertex bindings past the tracked range are always recorded. Cleared by Begin, ResetState and
+		// InvalidateBindCache; m_SkippedBinds accumulates over the recording.
+		static constexpr uint32_t kTrackedSets = 4; // sets 0..2 + the bindless set 3
+		static constexpr uint32_t kTrackedVertexBindings = 4;
+		VkPipeline m_BoundPipeline = VK_NULL_HANDLE;
+		std::array<VkDescriptorSet, kTrackedSets> m_BoundSets{};
+		std::array<VkBuffer, kTrackedVertexBindings> m_BoundVertexBuffers{};
+		std::array<VkDeviceSize, kTrackedVertexBindings> m_BoundVertexOffsets{};
+		VkBuffer m_BoundIndexBuffer = VK_NULL_HANDLE;
+		SkippedBindStats m_SkippedBinds;
+
+		// Record one set bind through the cache: trims a range bind to the sets that changed, or drops it.
+		void BindSetsFiltered(uint32_t firstSet, const VkDescriptorSet* handles, uint32_t count);
+
 		// Color attachments of the active render pass, and whether it targets the swapchain.
 		// Used by EndRenderPass to leave offscreen color targets in SHADER_READ_ONLY so they can be
 		// sampled afterwards (e.g. the editor viewport texture).
@@ -10,6 +10,7 @@
 
 #include "VulkanBindlessManager.hpp"
 #include "VulkanDescriptorSetLayout.hpp"
+#include "VulkanPipelineCache.hpp"
 
 namespace Snowstorm
 {
@@ -208,7 +209,7 @@ namespace Snowstorm
 		pipeCI.stage = stage;
 		pipeCI.layout = m_PipelineLayout;
 
-		SS_CORE_VERIFY(vkCreateComputePipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCI, nullptr, &m_Pipeline) == VK_SUCCESS,
+		SS_CORE_VERIFY(vkCreateComputePipelines(m_Device, VulkanPipelineCache::Get().GetHandle(), 1, &pipeCI, nullptr, &m_Pipeline) == VK_SUCCESS,
 		               "Failed to create Vulkan compute pipeline");
 
 		vkDestroyShaderModule(m_Device, module, nullptr);
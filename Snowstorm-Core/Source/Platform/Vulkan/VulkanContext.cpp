@@ -21,6 +21,7 @@
 #include <vk_mem_alloc.h>
 
 #include "VulkanBindlessManager.hpp"
+#include "VulkanPipelineCache.hpp"
 
 #define VK_CHECK(expr)                                           \
 	{                                                            \
@@ -679,6 +680,7 @@ namespace Snowstorm
 		VK_CHECK(vmaCreateAllocator(&allocatorInfo, &m_Allocator));
 
 		VulkanBindlessManager::Get().Init();
+		VulkanPipelineCache::Get().Init();
 
 		// 7. Swapchain
 		CreateSwapchain();
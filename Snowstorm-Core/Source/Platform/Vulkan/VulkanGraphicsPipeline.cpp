@@ -1,11 +1,15 @@
 #include "VulkanGraphicsPipeline.hpp"
 
+#include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Debug/Instrumentor.hpp"
 
 #include <array>
 #include <fstream>
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <utility>
 
@@ -14,6 +18,7 @@
 
 #include "VulkanBindlessManager.hpp"
 #include "VulkanDescriptorSetLayout.hpp"
+#include "VulkanPipelineCache.hpp"
 
 namespace Snowstorm
 {
@@ -261,6 +266,8 @@ namespace Snowstorm
 				SetSignature Sig;
 			};
 			static Reference s_shared[kReflectedSetCount]; // indexed by set; only 0 and 2 are checked
+			static std::mutex s_sharedMutex; // async builds reflect on JobSystem workers
+			std::lock_guard lock(s_sharedMutex);
 
 			constexpr uint32_t kSharedSets[] = {0, 2};
 			for (const uint32_t set : kSharedSets)
@@ -335,7 +342,7 @@ namespace Snowstorm
 		m_SetLayouts.push_back(DescriptorSetLayout::CreateFromExternal(bindlessHandle));
 	}
 
-	VulkanGraphicsPipeline::VulkanGraphicsPipeline(PipelineDesc desc)
+	VulkanGraphicsPipeline::VulkanGraphicsPipeline(PipelineDesc desc, const bool deferBuild)
 	    : m_Desc(std::move(desc))
 	{
 		SS_CORE_ASSERT(m_Desc.Type == PipelineType::Graphics, "VulkanGraphicsPipeline requires PipelineType::Graphics");
@@ -345,21 +352,118 @@ namespace Snowstorm
 		SS_CORE_ASSERT(m_Desc.Shader, "PipelineDesc.Shader must be set");
 
 		m_Device = GetVulkanDevice();
-		Build();
+		if (!deferBuild)
+		{
+			Build();
+			m_Ready.store(true, std::memory_order_release);
+		}
+	}
+
+	void VulkanGraphicsPipeline::BuildAsync(JobSystem& jobs)
+	{
+		WaitForBuild();
+		m_Ready.store(false, std::memory_order_release);
+
+		// Captures `this`, not a Ref: the job must never be the last owner, or the destructor (which drains the
+		// device) would run on a worker. The destructor waits on m_PendingBuild instead.
+		m_PendingBuild = jobs.Submit([this]()
+		                             {
+			SS_PROFILE_SCOPE("VulkanGraphicsPipeline::BuildAsync");
+			Build();
+			m_Ready.store(true, std::memory_order_release); });
+	}
+
+	void VulkanGraphicsPipeline::WaitForBuild()
+	{
+		if (m_PendingBuild.valid())
+		{
+			m_PendingBuild.wait();
+			m_PendingBuild = {};
+		}
 	}
 
 	void VulkanGraphicsPipeline::Build()
 	{
-		// --- Shader modules ---
+		const CompiledStages code = ReadCompiledStages();
+		CreateLayout(code.Vert, code.Frag);
+		CreatePipelineObject(code.Vert, code.Frag);
+
+		m_BuiltShaderVersion = m_Desc.Shader->GetVersion();
+	}
+
+	VulkanGraphicsPipeline::CompiledStages VulkanGraphicsPipeline::ReadCompiledStages() const
+	{
 		const std::string vertPath = m_Desc.Shader->GetCompiledPath(ShaderStageKind::Vertex);
 		const std::string fragPath = m_Desc.Shader->GetCompiledPath(ShaderStageKind::Fragment);
 
 		SS_CORE_ASSERT(!vertPath.empty(), "Shader returned empty compiled vertex SPIR-V path");
 		SS_CORE_ASSERT(!fragPath.empty(), "Shader returned empty compiled fragment SPIR-V path");
 
-		const auto vertCode = ReadFile(vertPath);
-		const auto fragCode = ReadFile(fragPath);
+		return {ReadFile(vertPath), ReadFile(fragPath)};
+	}
+
+	void VulkanGraphicsPipeline::CreateLayout(const std::vector<char>& vertCode, const std::vector<char>& fragCode)
+	{
+		CreateDescriptorSetLayouts(vertCode, fragCode);
+
+		m_VkPushConstantRanges.clear();
+
+		if (!m_Desc.PushConstants.empty())
+		{
+			// Explicit override: a pipeline may still hand-declare ranges (validated early for a clearer error
+			// than Vulkan's). Kept as an escape hatch, but shaders normally rely on reflection below.
+			ValidatePushConstantRangesOrAssert(m_Desc.PushConstants);
+			m_VkPushConstantRanges.reserve(m_Desc.PushConstants.size());
+			for (const PushConstantRangeDesc& r : m_Desc.PushConstants)
+			{
+				VkPushConstantRange vkRange{};
+				vkRange.offset = r.Offset;
+				vkRange.size = r.Size;
+				vkRange.stageFlags = ToVkShaderStages(r.Stages);
+				SS_CORE_ASSERT(vkRange.stageFlags != 0, "PushConstantRangeDesc.Stages must not be None");
+				m_VkPushConstantRanges.push_back(vkRange);
+			}
+		}
+		else
+		{
+			// Default: reflect push-constant ranges from the shaders (symmetric with descriptor-set reflection
+			// in CreateDescriptorSetLayouts). A shader declaring [[vk::push_constant]] gets its layout range
+			// automatically — no PipelineDesc.PushConstants needed, and no "shader uses push constants but the
+			// layout has none" pipeline-creation failure.
+			std::map<uint32_t, VkPushConstantRange> reflected;
+			ReflectPushConstantsInto(vertCode, ShaderStage::Vertex, reflected);
+			ReflectPushConstantsInto(fragCode, ShaderStage::Fragment, reflected);
+			m_VkPushConstantRanges.reserve(reflected.size());
+			for (const auto& [offset, range] : reflected)
+			{
+				m_VkPushConstantRanges.push_back(range);
+			}
+		}
+
+		// Pipeline layout: use all set layouts
+		std::vector<VkDescriptorSetLayout> vkSetLayouts;
+		vkSetLayouts.reserve(m_SetLayouts.size());
+		for (const auto& s : m_SetLayouts)
+		{
+			SS_CORE_ASSERT(s, "Null DescriptorSetLayout in pipeline");
+			const auto vkLayout = std::static_pointer_cast<VulkanDescriptorSetLayout>(s);
+			vkSetLayouts.push_back(vkLayout->GetHandle());
+		}
+
+		VkPipelineLayoutCreateInfo layoutCI{};
+		layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+		layoutCI.setLayoutCount = static_cast<uint32_t>(vkSetLayouts.size());
+		layoutCI.pSetLayouts = vkSetLayouts.data();
+		layoutCI.pushConstantRangeCount = static_cast<uint32_t>(m_VkPushConstantRanges.size());
+		layoutCI.pPushConstantRanges = m_VkPushConstantRanges.empty() ? nullptr : m_VkPushConstantRanges.data();
+
+		const VkResult res = vkCreatePipelineLayout(m_Device, &layoutCI, nullptr, &m_PipelineLayout);
+		SS_CORE_ASSERT(res == VK_SUCCESS, "Failed to create VkPipelineLayout");
+	}
 
+	void VulkanGraphicsPipeline::CreatePipelineObject(const std::vector<char>& vertCode, const std::vector<char>& fragCode)
+	{
+		// --- Shader modules ---
 		const VkShaderModule vertModule = CreateShaderModule(m_Device, vertCode);
 		const VkShaderModule fragModule = CreateShaderModule(m_Device, fragCode);
 
@@ -518,62 +622,6 @@ namespace Snowstorm
 		blend.attachmentCount = static_cast<uint32_t>(blendAttachments.size());
 		blend.pAttachments = blendAttachments.data();
 
-		// --- Pipeline layout / descriptors ---
-		CreateDescriptorSetLayouts(vertCode, fragCode);
-
-		m_VkPushConstantRanges.clear();
-
-		if (!m_Desc.PushConstants.empty())
-		{
-			// Explicit override: a pipeline may still hand-declare ranges (validated early for a clearer error
-			// than Vulkan's). Kept as an escape hatch, but shaders normally rely on reflection below.
-			ValidatePushConstantRangesOrAssert(m_Desc.PushConstants);
-			m_VkPushConstantRanges.reserve(m_Desc.PushConstants.size());
-			for (const PushConstantRangeDesc& r : m_Desc.PushConstants)
-			{
-				VkPushConstantRange vkRange{};
-				vkRange.offset = r.Offset;
-				vkRange.size = r.Size;
-				vkRange.stageFlags = ToVkShaderStages(r.Stages);
-				SS_CORE_ASSERT(vkRange.stageFlags != 0, "PushConstantRangeDesc.Stages must not be None");
-				m_VkPushConstantRanges.push_back(vkRange);
-			}
-		}
-		else
-		{
-			// Default: reflect push-constant ranges from the shaders (symmetric with descriptor-set reflection
-			// in CreateDescriptorSetLayouts). A shader declaring [[vk::push_constant]] gets its layout range
-			// automatically — no PipelineDesc.PushConstants needed, and no "shader uses push constants but the
-			// layout has none" pipeline-creation failure.
-			std::map<uint32_t, VkPushConstantRange> reflected;
-			ReflectPushConstantsInto(vertCode, ShaderStage::Vertex, reflected);
-			ReflectPushConstantsInto(fragCode, ShaderStage::Fragment, reflected);
-			m_VkPushConstantRanges.reserve(reflected.size());
-			for (const auto& [offset, range] : reflected)
-			{
-				m_VkPushConstantRanges.push_back(range);
-			}
-		}
-
-		// Pipeline layout: use all set layouts
-		std::vector<VkDescriptorSetLayout> vkSetLayouts;
-		vkSetLayouts.reserve(m_SetLayouts.size());
-		for (const auto& s : m_SetLayouts)
-		{
-			SS_CORE_ASSERT(s, "Null DescriptorSetLayout in pipeline");
-			const auto vkLayout = std::static_pointer_cast<VulkanDescriptorSetLayout>(s);
-			vkSetLayouts.push_back(vkLayout->GetHandle());
-		}
-
-		VkPipelineLayoutCreateInfo layoutCI{};
-		layoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		layoutCI.setLayoutCount = static_cast<uint32_t>(vkSetLayouts.size());
-		layoutCI.pSetLayouts = vkSetLayouts.data();
-		layoutCI.pushConstantRangeCount = static_cast<uint32_t>(m_VkPushConstantRanges.size());
-		layoutCI.pPushConstantRanges = m_VkPushConstantRanges.empty() ? nullptr : m_VkPushConstantRanges.data();
-
-		VkResult res = vkCreatePipelineLayout(m_Device, &layoutCI, nullptr, &m_PipelineLayout);
-		SS_CORE_ASSERT(res == VK_SUCCESS, "Failed to create VkPipelineLayout");
 
 		// --- Dynamic rendering formats ---
 		std::vector<VkFormat> colorVkFormats;
@@ -621,13 +669,11 @@ namespace Snowstorm
 		pipeCI.renderPass = VK_NULL_HANDLE; // dynamic rendering
 		pipeCI.subpass = 0;
 
-		res = vkCreateGraphicsPipelines(m_Device, VK_NULL_HANDLE, 1, &pipeCI, nullptr, &m_Pipeline);
+		const VkResult res = vkCreateGraphicsPipelines(m_Device, VulkanPipelineCache::Get().GetHandle(), 1, &pipeCI, nullptr, &m_Pipeline);
 		SS_CORE_ASSERT(res == VK_SUCCESS, "Failed to create Vulkan graphics pipeline");
 
 		vkDestroyShaderModule(m_Device, fragModule, nullptr);
 		vkDestroyShaderModule(m_Device, vertModule, nullptr);
-
-		m_BuiltShaderVersion = m_Desc.Shader->GetVersion();
 	}
 
 	void VulkanGraphicsPipeline::Destroy()
@@ -649,6 +695,8 @@ namespace Snowstorm
 
 	void VulkanGraphicsPipeline::Reload()
 	{
+		WaitForBuild(); // a background build still owns the GPU objects
+
 		// Nothing to do if the shader hasn't recompiled since we last built.
 		if (m_Desc.Shader->GetVersion() == m_BuiltShaderVersion)
 		{
@@ -681,24 +729,43 @@ namespace Snowstorm
 
 	void VulkanGraphicsPipeline::SetSampleCount(const uint32_t samples)
 	{
+		WaitForBuild();
+
 		const uint32_t s = samples == 0 ? 1 : samples;
 		if (m_Desc.SampleCount == s)
 		{
 			return;
 		}
 
-		// Rebuild in place at the new sample count. Drain first (any in-flight command buffer may reference the
-		// old VkPipeline). Same swap-the-handle mechanism as Reload, so existing Ref<Pipeline> holders (material
-		// instances) bind the new one next frame — no re-resolution needed.
+		// Drop only the VkPipeline: the sample count is not part of the descriptor/pipeline layout, so
+		// m_SetLayouts and m_PipelineLayout stay valid and nobody holding them (cached descriptor sets) is
+		// disturbed. No drain here — the caller switches every scene pipeline in one go and idles the device
+		// once in front of them (see AssetManagerSingleton::RebuildPipelinesForSampleCount); a wait per pipeline
+		// stalled an MSAA toggle N times over for nothing.
 		m_Desc.SampleCount = s;
-		vkDeviceWaitIdle(m_Device);
-		Destroy();
-		Build();
-		SS_CORE_INFO("Rebuilt graphics pipeline '{}' at {}x MSAA.", m_Desc.DebugName, s);
+		if (m_Pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(m_Device, m_Pipeline, nullptr);
+			m_Pipeline = VK_NULL_HANDLE;
+		}
+
+		// Recompile on a worker so an MSAA toggle with N materials costs max(compile) instead of sum(compile)
+		// on the main thread (and ~nothing once the pipeline cache has seen this sample count). Until it lands
+		// IsReady() is false and the renderer skips batches using this pipeline for a frame or two.
+		m_Ready.store(false, std::memory_order_release);
+		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
+		m_PendingBuild = jobs.Submit([this]()
+		                             {
+			SS_PROFILE_SCOPE("VulkanGraphicsPipeline::SetSampleCount");
+			const CompiledStages code = ReadCompiledStages();
+			CreatePipelineObject(code.Vert, code.Frag);
+			m_Ready.store(true, std::memory_order_release); });
+		SS_CORE_INFO("Rebuilding graphics pipeline '{}' at {}x MSAA (background).", m_Desc.DebugName, s);
 	}
 
 	VulkanGraphicsPipeline::~VulkanGraphicsPipeline()
 	{
+		WaitForBuild();
 		if (m_Pipeline != VK_NULL_HANDLE || m_PipelineLayout != VK_NULL_HANDLE)
 		{
 			vkDeviceWaitIdle(m_Device);
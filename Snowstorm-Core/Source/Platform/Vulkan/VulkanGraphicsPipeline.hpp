@@ -3,23 +3,38 @@
 #include "Snowstorm/Render/Pipeline.hpp"
 #include "Platform/Vulkan/VulkanCommon.hpp"
 
+#include <atomic>
+#include <future>
+
 namespace Snowstorm
 {
+	class JobSystem;
+
 	class VulkanGraphicsPipeline final : public Pipeline
 	{
 	public:
-		explicit VulkanGraphicsPipeline(PipelineDesc desc);
+		// deferBuild: construct without any GPU objects; the owner then calls BuildAsync (Pipeline::CreateAsync).
+		explicit VulkanGraphicsPipeline(PipelineDesc desc, bool deferBuild = false);
 		~VulkanGraphicsPipeline() override;
 
 		[[nodiscard]] const PipelineDesc& GetDesc() const override { return m_Desc; }
 
+		// False while a background build (BuildAsync / SetSampleCount) is still compiling. Acquire-load, so a
+		// true result also publishes the handles + set layouts the worker wrote.
+		[[nodiscard]] bool IsReady() const override { return m_Ready.load(std::memory_order_acquire); }
+
+		// Run Build() on a JobSystem worker. Vulkan object creation is free-threaded and the shared
+		// VkPipelineCache is internally synchronized, so several pipelines compile in parallel.
+		void BuildAsync(JobSystem& jobs);
+
 		// Shader hot-reload: destroy the current VkPipeline/layout/set-layouts and rebuild them from m_Desc
 		// (whose Shader now has freshly recompiled SPIR-V on disk), swapping m_Pipeline in place so existing
 		// Ref<Pipeline> holders bind the new one next frame. No-op if the shader version hasn't advanced.
 		void Reload() override;
 
 		// Live MSAA: rebuild in place at a new rasterization sample count (updates m_Desc.SampleCount, swaps the
-		// VkPipeline). No-op if unchanged. Caller ensures GPU idle (ViewportResizeSystem drains before it).
+		// VkPipeline). No-op if unchanged. Only the VkPipeline is recompiled, on a worker (layouts are kept);
+		// IsReady() is false until it lands. Caller ensures GPU idle (ViewportResizeSystem drains before it).
 		void SetSampleCount(uint32_t samples) override;
 
 		// Pipeline interface
@@ -44,6 +59,22 @@ namespace Snowstorm
 		// and Reload(). Records the shader version it built against so Reload() can skip no-op rebuilds.
 		void Build();
 
+		struct CompiledStages
+		{
+			std::vector<char> Vert;
+			std::vector<char> Frag;
+		};
+		[[nodiscard]] CompiledStages ReadCompiledStages() const;
+
+		// The two halves of Build(): reflected set layouts + push constants + VkPipelineLayout, then the
+		// VkPipeline itself. SetSampleCount only needs the second.
+		void CreateLayout(const std::vector<char>& vertCode, const std::vector<char>& fragCode);
+		void CreatePipelineObject(const std::vector<char>& vertCode, const std::vector<char>& fragCode);
+
+		// Block until a background build has finished (no-op when none is pending). Every path that touches
+		// the GPU objects on the main thread (Reload, SetSampleCount, destructor) calls this first.
+		void WaitForBuild();
+
 		// Tear down the VkPipeline + layout + reflected set layouts (idempotent). Reload() calls this before
 		// re-Build(); the destructor calls it too. Does NOT wait for device idle — callers do that once.
 		void Destroy();
@@ -67,5 +98,8 @@ namespace Snowstorm
 		// which would invalidate the renderer's cached descriptor sets (keyed by pipeline pointer) — we log
 		// and keep the old pipeline instead of silently corrupting bindings. Set-layout hot-swap is future work.
 		std::string m_LayoutSignature;
+
+		std::atomic<bool> m_Ready{false};
+		std::future<void> m_PendingBuild; // valid while a BuildAsync/SetSampleCount job is outstanding
 	};
 }
@@ -0,0 +1,174 @@
+#include "VulkanPipelineCache.hpp"
+
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint32_t kMagic = 0x43505353; // "SSPC"
+		constexpr uint32_t kVersion = 1;
+
+		// Our own prefix in front of the driver's blob. The driver's VkPipelineCacheHeaderVersionOne carries
+		// vendor/device/UUID too, but not the driver version, and we want to reject a stale blob ourselves.
+		struct Header
+		{
+			uint32_t Magic = kMagic;
+			uint32_t Version = kVersion;
+			uint32_t VendorID = 0;
+			uint32_t DeviceID = 0;
+			uint32_t DriverVersion = 0;
+			uint8_t CacheUUID[VK_UUID_SIZE]{};
+			uint64_t DataSize = 0;
+		};
+
+		Header MakeHeader(const VkPhysicalDeviceProperties& props)
+		{
+			Header h{};
+			h.VendorID = props.vendorID;
+			h.DeviceID = props.deviceID;
+			h.DriverVersion = props.driverVersion;
+			std::memcpy(h.CacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+			return h;
+		}
+
+		bool SameDevice(const Header& a, const Header& b)
+		{
+			return a.Magic == b.Magic && a.Version == b.Version && a.VendorID == b.VendorID && a.DeviceID == b.DeviceID &&
+			       a.DriverVersion == b.DriverVersion && std::memcmp(a.CacheUUID, b.CacheUUID, VK_UUID_SIZE) == 0;
+		}
+
+		std::vector<char> ReadBlob(const std::filesystem::path& path, const Header& expected)
+		{
+			std::ifstream in(path, std::ios::binary);
+			if (!in.is_open())
+			{
+				return {}; // first run on this device/driver
+			}
+
+			Header h{};
+			in.read(reinterpret_cast<char*>(&h), sizeof(h));
+			if (!in || !SameDevice(h, expected) || h.DataSize == 0 || h.DataSize > (512ull << 20))
+			{
+				SS_CORE_INFO("Pipeline cache {} is for another device/driver; starting empty.", path.filename().string());
+				return {};
+			}
+
+			std::vector<char> data(h.DataSize);
+			in.read(data.data(), static_cast<std::streamsize>(data.size()));
+			if (!in)
+			{
+				return {}; // truncated: drop it rather than feed the driver half a blob
+			}
+			return data;
+		}
+	}
+
+	VulkanPipelineCache& VulkanPipelineCache::Get()
+	{
+		static VulkanPipelineCache instance;
+		return instance;
+	}
+
+	std::filesystem::path VulkanPipelineCache::GetCachePath() const
+	{
+		// One file per (device, driver) so a dual-GPU box or a driver rollback keeps each cache warm.
+		ContentHasher hasher;
+		hasher.UpdateValue(m_DeviceProps.vendorID);
+		hasher.UpdateValue(m_DeviceProps.deviceID);
+		hasher.UpdateValue(m_DeviceProps.driverVersion);
+		hasher.Update(m_DeviceProps.pipelineCacheUUID, VK_UUID_SIZE);
+		return std::filesystem::path("Engine/cache/pipelines") / (DerivedDataKey{hasher.Digest()}.ToString() + ".bin");
+	}
+
+	void VulkanPipelineCache::Init()
+	{
+		m_Device = GetVulkanDevice();
+		vkGetPhysicalDeviceProperties(GetVulkanPhysicalDevice(), &m_DeviceProps);
+
+		const std::vector<char> initial = ReadBlob(GetCachePath(), MakeHeader(m_DeviceProps));
+
+		VkPipelineCacheCreateInfo ci{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+		ci.initialDataSize = initial.size();
+		ci.pInitialData = initial.empty() ? nullptr : initial.data();
+
+		if (vkCreatePipelineCache(m_Device, &ci, nullptr, &m_Cache) != VK_SUCCESS)
+		{
+			// A driver may reject its own stale blob; retry empty before giving up on caching entirely.
+			ci.initialDataSize = 0;
+			ci.pInitialData = nullptr;
+			if (vkCreatePipelineCache(m_Device, &ci, nullptr, &m_Cache) != VK_SUCCESS)
+			{
+				SS_CORE_WARN("vkCreatePipelineCache failed; pipelines will compile uncached.");
+				m_Cache = VK_NULL_HANDLE;
+				return;
+			}
+		}
+
+		SS_CORE_INFO("Pipeline cache: {} ({} KiB warm).", GetCachePath().filename().string(), initial.size() / 1024);
+	}
+
+	void VulkanPipelineCache::Shutdown()
+	{
+		if (m_Cache == VK_NULL_HANDLE)
+		{
+			return;
+		}
+
+		size_t size = 0;
+		std::vector<char> data;
+		if (vkGetPipelineCacheData(m_Device, m_Cache, &size, nullptr) == VK_SUCCESS && size > 0)
+		{
+			data.resize(size);
+			if (vkGetPipelineCacheData(m_Device, m_Cache, &size, data.data()) != VK_SUCCESS)
+			{
+				data.clear();
+			}
+			data.resize(size);
+		}
+
+		vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+		m_Cache = VK_NULL_HANDLE;
+
+		if (data.empty())
+		{
+			return;
+		}
+
+		const std::filesystem::path path = GetCachePath();
+		std::error_code ec;
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+		Header h = MakeHeader(m_DeviceProps);
+		h.DataSize = data.size();
+
+		const std::filesystem::path tmp = DerivedDataCache::MakeTempPath(path);
+		{
+			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+			{
+				SS_CORE_WARN("Could not write pipeline cache {}", tmp.string());
+				return;
+			}
+			out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+			out.write(data.data(), static_cast<std::streamsize>(data.size()));
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(tmp, ec);
+				return;
+			}
+		}
+		if (!DerivedDataCache::CommitTempFile(tmp, path))
+		{
+			SS_CORE_WARN("Could not commit pipeline cache {}", path.string());
+		}
+	}
+}
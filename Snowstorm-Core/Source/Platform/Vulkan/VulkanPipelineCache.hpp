@@ -0,0 +1,40 @@
+#pragma once
+
+#include "VulkanCommon.hpp"
+
+#include <filesystem>
+
+namespace Snowstorm
+{
+	// Process-wide VkPipelineCache, persisted to disk between runs. Every graphics/compute pipeline is created
+	// against it, so a warm launch hands the driver its own previously-compiled binaries instead of re-running
+	// the backend compiler for every pipeline (the SPIR-V was already cached; the VkPipeline objects were not).
+	//
+	// The blob is only meaningful to the exact device + driver that produced it, so the file is named by and
+	// prefixed with (vendorID, deviceID, driverVersion, pipelineCacheUUID). A mismatch (GPU swap, driver update,
+	// render.gpu picking another adapter) just starts empty — we never hand a foreign blob to the driver, some
+	// of which don't validate it as carefully as the spec asks. VkPipelineCache is internally synchronized, so
+	// JobSystem workers building pipelines in parallel share the one handle without a lock.
+	class VulkanPipelineCache
+	{
+	public:
+		// Create the cache, seeded from Engine/cache/pipelines/<device-key>.bin when it matches this device.
+		// After VulkanContext has picked + created the device.
+		void Init();
+
+		// Write the cache back to disk (atomic temp-then-rename) and destroy it. Device must still be alive.
+		void Shutdown();
+
+		static VulkanPipelineCache& Get();
+
+		// VK_NULL_HANDLE before Init / after Shutdown (pipeline creation then just runs uncached).
+		[[nodiscard]] VkPipelineCache GetHandle() const { return m_Cache; }
+
+	private:
+		[[nodiscard]] std::filesystem::path GetCachePath() const;
+
+		VkDevice m_Device = VK_NULL_HANDLE;
+		VkPipelineCache m_Cache = VK_NULL_HANDLE;
+		VkPhysicalDeviceProperties m_DeviceProps{};
+	};
+}
@@ -4,6 +4,7 @@
 #include "imgui_impl_vulkan.h"
 #include "VulkanBindlessManager.hpp"
 #include "VulkanOmmBaker.hpp"
+#include "VulkanPipelineCache.hpp"
 
 #include "Snowstorm/Core/Base.hpp"
 #include "Snowstorm/Core/Log.hpp"
@@ -188,6 +189,9 @@ namespace Snowstorm
 
 		VulkanBindlessManager::Get().Shutdown();
 
+		// Persist the driver's compiled pipelines for the next launch (needs the live device).
+		VulkanPipelineCache::Get().Shutdown();
+
 		// Function-local-static singleton owning the OMM bake pipeline + sampler; release here (device still alive)
 		// so its Refs don't destruct at process exit on a dead device. No-op when OMM never baked (m_Pipeline null).
 		VulkanOmmBaker::Get().Shutdown();
@@ -588,6 +592,8 @@ namespace Snowstorm
 		if (drawData && drawData->CmdListsCount > 0)
 		{
 			ImGui_ImplVulkan_RenderDrawData(drawData, cmd);
+			// ImGui bound its own pipeline, font set and buffers straight into the command buffer.
+			vkContext.InvalidateBindCache();
 		}
 	}
 }
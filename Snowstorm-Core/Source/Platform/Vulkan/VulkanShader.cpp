@@ -3,12 +3,15 @@
 #include "Snowstorm/Core/EngineCVars.hpp"
 #include "Snowstorm/Core/Log.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
+#include "Snowstorm/Render/ShaderBundle.hpp"
+#include "Snowstorm/Render/ShaderDependencies.hpp"
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -97,34 +100,19 @@ namespace Snowstorm
 			return GetEngineRoot() / "Tools" / "dxc" / "dxc.exe";
 		}
 
-		// Fold every shared .hlsli header into the cache key. The cache key otherwise hashes only the
-		// top-level .hlsl source, so editing an included header (e.g. Engine.hlsli, which defines the
-		// FrameCB/MaterialCB layouts shared by all shaders) would NOT invalidate the cached SPIR-V —
-		// the stale shader keeps the old cbuffer layout while C++ uploads the new one, silently
-		// corrupting every cbuffer read (symptom: black/unlit geometry). A full #include dependency
-		// parse is overkill for a single flat include dir; hashing all headers in it is a deliberately
-		// smaller version that catches any header edit. Headers are sorted so the hash is order-stable.
-		uint64_t HashIncludeHeaders()
+		// Fold the shader's include closure into the cache key. The top-level source hash alone would miss an
+		// edit to an included header (e.g. Engine.hlsli, which defines the FrameCB/MaterialCB layouts shared by
+		// all shaders): the stale .spv keeps the old cbuffer layout while C++ uploads the new one, silently
+		// corrupting every cbuffer read (symptom: black/unlit geometry). Only headers this source actually
+		// reaches are hashed (CollectShaderIncludes walks the #include graph with dxc's resolution order), so a
+		// header edit re-keys its dependents and leaves every other shader's cache entry warm. The closure is
+		// sorted, so the hash is order-stable.
+		uint64_t HashIncludeClosure(const fs::path& srcPath)
 		{
-			const fs::path includeDir = GetEngineRoot() / "Engine" / "Shaders" / "Include";
-			std::error_code ec;
-			if (!fs::exists(includeDir, ec))
-			{
-				return 0;
-			}
-
-			std::vector<fs::path> headers;
-			for (const auto& entry : fs::directory_iterator(includeDir, ec))
-			{
-				if (entry.is_regular_file() && entry.path().extension() == ".hlsli")
-				{
-					headers.push_back(entry.path());
-				}
-			}
-			std::ranges::sort(headers);
+			const std::vector<fs::path> includeDirs{GetEngineRoot() / "Engine" / "Shaders"};
 
 			uint64_t h = 0;
-			for (const fs::path& header : headers)
+			for (const fs::path& header : CollectShaderIncludes(srcPath, includeDirs))
 			{
 				const std::string text = ReadTextFileOrEmpty(header);
 				h ^= Hash64(text.data(), text.size());
@@ -137,6 +125,14 @@ namespace Snowstorm
 			return GetEngineRoot() / "Engine" / "cache" / "shaders";
 		}
 
+		// The cooked permutation bundle shipped next to the engine shaders (Snowstorm-ShaderCook output), opened
+		// once. Null when there is none (a dev checkout that never ran the cook) — every miss then compiles.
+		const ShaderBundle* GetShippedBundle()
+		{
+			static const std::optional<ShaderBundle> bundle = ShaderBundle::Open(GetEngineRoot() / ShaderBundle::GetDefaultPath());
+			return bundle ? &*bundle : nullptr;
+		}
+
 		std::wstring QuoteArg(const std::wstring& s)
 		{
 			// Always quote; simplest.
@@ -396,14 +392,7 @@ namespace Snowstorm
 			{
 				srcPath = GetEngineRoot() / srcPath;
 			}
-			const fs::path dxcExe = GetDxcExePath();
 			const fs::path cacheDir = GetShaderCacheDir();
-
-			if (!fs::exists(dxcExe))
-			{
-				SS_CORE_ERROR("DXC not found at {}", dxcExe.string());
-				return false;
-			}
 			fs::create_directories(cacheDir);
 
 			const std::string fullText = ReadTextFileOrEmpty(srcPath);
@@ -413,11 +402,11 @@ namespace Snowstorm
 				return false;
 			}
 
-			// Cache key: hash(source + all .hlsli headers + a per-profile flags tag). Same recipe as the
-			// legacy path; the flags tag keeps vs/ps/cs caches distinct.
+			// Cache key: hash(source + every header it includes + a per-profile flags tag). The flags tag keeps
+			// vs/ps/cs caches distinct.
 			uint64_t h = 0;
 			h ^= Hash64(fullText.data(), fullText.size());
-			h ^= HashIncludeHeaders();
+			h ^= HashIncludeClosure(srcPath);
 			h ^= Hash64(flagsTag, std::strlen(flagsTag));
 			// Variant defines change the emitted SPIR-V, so every enabled define must key the cache — otherwise
 			// two variants of the same source would collide on one .spv. Hashed in order (the caller keeps the
@@ -475,6 +464,30 @@ namespace Snowstorm
 				return true;
 			}
 
+			// Cooked ahead of time? Then this is a file extraction, not a compile: a permutation switch (the
+			// DefaultLit RT swap) or a first use in a shipped build never spawns dxc. The entry name is the
+			// cache file name, so a bundle only serves sources byte-identical to the ones it was cooked from.
+			const ShaderBundle* bundle = GetShippedBundle();
+			if (bundle && bundle->Extract(outSpvPath.filename().string(), outSpvPath))
+			{
+				outSpv = outSpvPath.string();
+				return true;
+			}
+
+			// Only now is dxc needed at all (a packaged build without Tools/dxc still runs from the bundle).
+			const fs::path dxcExe = GetDxcExePath();
+			if (!fs::exists(dxcExe))
+			{
+				SS_CORE_ERROR("DXC not found at {} and {} is not in the shader bundle", dxcExe.string(), outSpvPath.filename().string());
+				return false;
+			}
+			if (bundle)
+			{
+				SS_CORE_WARN("Shader permutation {} is missing from the shader bundle; compiling it now (add it to "
+				             "Engine/Shaders/Permutations.json and re-run Snowstorm-ShaderCook)",
+				             outSpvPath.filename().string());
+			}
+
 			// Compile the real source file directly (DXC resolves #include via -I; the file is unmodified).
 			if (!CompileStageWithDxc(dxcExe, srcPath, outSpvPath, profile, defines, debug))
 			{
@@ -487,6 +500,25 @@ namespace Snowstorm
 
 	}
 
+	bool VulkanShader::CompileStage(const std::string& sourcePath, const ShaderStageKind stage, const ShaderDefines& defines,
+	                                const bool debug, std::string& outSpv)
+	{
+		// SM 6.5 (was 6.0) everywhere: the fragment stage may use inline ray query for RT sun shadows (#118) and
+		// compute needs it for RayQuery/TraceRayInline; it's a strict superset, so shaders that don't use it
+		// compile identically. The flags tag keys the cache per profile so a vert and frag of the same content
+		// don't collide.
+		switch (stage)
+		{
+		case ShaderStageKind::Vertex:
+			return CompileStageFileToSpirvCache(sourcePath, L"vs_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_vs65", defines, debug, outSpv);
+		case ShaderStageKind::Fragment:
+			return CompileStageFileToSpirvCache(sourcePath, L"ps_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_ps65", defines, debug, outSpv);
+		case ShaderStageKind::Compute:
+			return CompileStageFileToSpirvCache(sourcePath, L"cs_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_cs65", defines, debug, outSpv);
+		}
+		return false;
+	}
+
 	// NOTE: the constructors deliberately do NOT compile. Compilation spawns dxc.exe (seconds on a cold
 	// cache) and is kicked onto a JobSystem worker by ShaderLibrary::Load right after construction, so the
 	// object exists immediately in a not-ready state and the main thread never blocks. Compile() is called
@@ -541,9 +573,10 @@ namespace Snowstorm
 		}
 
 		// fp16 capability axis (# fp16 inference): emit SS_FP16 when the device supports fp16 shader math +
-		// 16-bit storage. Only NeuralConv.comp wraps its Weights buffer in #ifdef SS_FP16; every other shader
-		// ignores the define (no #ifdef), so this is a no-op for them but keeps the .spv cache key correct
-		// (an fp16-capable machine caches distinct SPIR-V). A non-fp16 device never emits it -> the fp32 path.
+		// 16-bit storage. Only NeuralConv.comp and NeuralConvFused.comp wrap their Weights buffer in #ifdef
+		// SS_FP16; every other shader ignores the define (no #ifdef), so this is a no-op for them but keeps the
+		// .spv cache key correct (an fp16-capable machine caches distinct SPIR-V). A non-fp16 device never
+		// emits it -> the fp32 path.
 		if (Renderer::IsFloat16Supported())
 		{
 			defines.emplace_back("SS_FP16=1");
@@ -559,10 +592,8 @@ namespace Snowstorm
 		if (!m_FragPath.empty())
 		{
 			std::string vert, frag;
-			// SM 6.5 (was 6.0): the fragment stage may use inline ray query for RT sun shadows (#118); it's a
-			// strict superset so vertex/fragment shaders that don't use it compile identically.
-			if (!CompileStageFileToSpirvCache(m_VertPath, L"vs_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_vs65", defines, debug, vert) ||
-			    !CompileStageFileToSpirvCache(m_FragPath, L"ps_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_ps65", defines, debug, frag))
+			if (!CompileStage(m_VertPath, ShaderStageKind::Vertex, defines, debug, vert) ||
+			    !CompileStage(m_FragPath, ShaderStageKind::Fragment, defines, debug, frag))
 			{
 				SS_CORE_ERROR("VulkanShader: failed to compile graphics shader {}", m_Filepath);
 				return; // leaves m_Ready false: the pipeline never builds, rather than building from garbage
@@ -579,8 +610,6 @@ namespace Snowstorm
 
 		// Single-path: a compute shader. Since graphics shaders are now two-path (separate vert+frag
 		// files), a single-path shader is unambiguously compute — compile the file directly as cs_6_5.
-		// SM 6.5 (was 6.0) is required for inline ray query (RayQuery/TraceRayInline, #118) and is a strict
-		// superset, so every existing compute shader still compiles unchanged.
 		const fs::path p(m_VertPath);
 		if (p.extension() != ".hlsl")
 		{
@@ -589,7 +618,7 @@ namespace Snowstorm
 		}
 
 		std::string comp;
-		if (!CompileStageFileToSpirvCache(m_VertPath, L"cs_6_5", "v4_vulkan1.2_dxlayout_Zpr_preservebind_cs65", defines, debug, comp))
+		if (!CompileStage(m_VertPath, ShaderStageKind::Compute, defines, debug, comp))
 		{
 			SS_CORE_ERROR("VulkanShader: failed to compile compute shader {}", m_VertPath);
 			return;
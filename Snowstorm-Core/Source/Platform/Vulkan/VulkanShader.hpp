@@ -27,6 +27,13 @@ namespace Snowstorm
 		[[nodiscard]] ShaderPermutation GetPermutation() const override { return m_Permutation.load(std::memory_order_relaxed); }
 		void SetPermutation(const ShaderPermutation p) override { m_Permutation.store(p, std::memory_order_relaxed); }
 
+		// Compile one stage of `sourcePath` under `defines` into the .spv cache and return its path. Served from
+		// the cache first, then the cooked ShaderBundle, and only then by dxc. Shared by Compile() and the offline
+		// cook (Snowstorm-ShaderCook), so a cooked permutation lands under exactly the key a runtime lookup
+		// computes. Thread-safe (per-output lock); safe to call from any number of workers.
+		static bool CompileStage(const std::string& sourcePath, ShaderStageKind stage, const ShaderDefines& defines, bool debug,
+		                         std::string& outSpv);
+
 	protected:
 		// Runs the DXC compile for every stage and publishes the resulting SPIR-V paths. Called on a
 		// JobSystem worker by ShaderLibrary (or synchronously by Recompile/hot-reload). Thread-safe:
@@ -1,8 +1,12 @@
 #include "VulkanTlas.hpp"
 
+#include "VulkanCommandContext.hpp"
+
 #include "Snowstorm/Core/Base.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/Renderer.hpp"
 
+#include <algorithm>
 #include <cstring>
 
 namespace Snowstorm
@@ -61,6 +65,64 @@ namespace Snowstorm
 			SS_CORE_ASSERT(result == VK_SUCCESS, "Failed to create TLAS buffer");
 			capacity = needed;
 		}
+
+		// One instance record. Vulkan wants a row-major 3x4 (transform[row][col]); glm is column-major, so
+		// transpose the upper 3x4 of the world matrix.
+		VkAccelerationStructureInstanceKHR MakeInstance(const TLASInstance& instance, const uint32_t index)
+		{
+			const glm::mat4 t = glm::transpose(instance.Transform);
+			VkAccelerationStructureInstanceKHR inst{};
+			std::memcpy(&inst.transform, &t, sizeof(VkTransformMatrixKHR)); // first 3 rows = 12 floats
+			inst.instanceCustomIndex = index;
+			inst.mask = 0xFF;
+			inst.flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
+			// Masked (glTF MASK) instances must be non-opaque so RayQuery surfaces their triangles as
+			// candidates for the any-hit alpha test; this instance bit overrides the geometry's OPAQUE bit
+			// below. Without it cutout foliage renders solid in every RT pass (#151).
+			if (instance.ForceNonOpaque)
+			{
+				inst.flags |= VK_GEOMETRY_INSTANCE_FORCE_NO_OPAQUE_BIT_KHR;
+			}
+			inst.accelerationStructureReference = instance.BlasAddress;
+			return inst;
+		}
+
+		// Geometry = the instance array by device address.
+		VkAccelerationStructureGeometryKHR MakeInstancesGeometry(VkBuffer instanceBuffer)
+		{
+			VkAccelerationStructureGeometryKHR geometry{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
+			geometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+			geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+			geometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+			geometry.geometry.instances.arrayOfPointers = VK_FALSE;
+			geometry.geometry.instances.data.deviceAddress = RawBufferAddress(instanceBuffer);
+			return geometry;
+		}
+
+		// ALLOW_UPDATE so transform-only changes can refit (Refit) instead of rebuilding; the build and every
+		// update must use the same flags. Costs a little trace speed and AS memory, paid back by the first
+		// refit of a moving prop.
+		constexpr VkBuildAccelerationStructureFlagsKHR kTlasBuildFlags =
+		    VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR | VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
+
+		// The stages that trace the TLAS: ray queries run in fragment (forward RT shadows/reflections) and
+		// compute (AO/GI/path tracing/picking) shaders.
+		constexpr VkPipelineStageFlags2 kTraceStages = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+		void AsMemoryBarrier(const VkCommandBuffer cmd, const VkPipelineStageFlags2 srcStage, const VkAccessFlags2 srcAccess,
+		                     const VkPipelineStageFlags2 dstStage, const VkAccessFlags2 dstAccess)
+		{
+			VkMemoryBarrier2 barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+			barrier.srcStageMask = srcStage;
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstStageMask = dstStage;
+			barrier.dstAccessMask = dstAccess;
+
+			VkDependencyInfo dep{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+			dep.memoryBarrierCount = 1;
+			dep.pMemoryBarriers = &barrier;
+			vkCmdPipelineBarrier2(cmd, &dep);
+		}
 	}
 
 	VulkanTlas::VulkanTlas(const std::string& debugName)
@@ -72,9 +134,12 @@ namespace Snowstorm
 	{
 		vkDeviceWaitIdle(GetVulkanDevice());
 		Destroy();
-		if (m_InstanceBuffer != VK_NULL_HANDLE)
+		for (const FrameInstances& frame : m_FrameInstances)
 		{
-			vmaDestroyBuffer(GetAllocator(), m_InstanceBuffer, m_InstanceAllocation);
+			if (frame.Buffer != VK_NULL_HANDLE)
+			{
+				vmaDestroyBuffer(GetAllocator(), frame.Buffer, frame.Allocation);
+			}
 		}
 		if (m_ScratchBuffer != VK_NULL_HANDLE)
 		{
@@ -103,56 +168,55 @@ namespace Snowstorm
 		const uint32_t count = static_cast<uint32_t>(instances.size());
 		m_InstanceCount = count;
 
-		// The previous AS/backing must be torn down before we build a new one (rebuild-each-call). The GPU
-		// isn't using it here — TlasBuildSystem runs in PreRender, before this frame's ray-query pass, and the
-		// prior build's ImmediateSubmit already fenced. A device wait keeps it simple and safe at this scale.
+		// The previous AS/backing must be torn down before we build a new one (rebuild-each-call), and earlier
+		// frames still in flight may be tracing it (and the bindless slot that names it is rewritten after this
+		// build). Builds only follow a topology change or a spent refit budget; the per-frame transform path is
+		// Refit, which doesn't drain.
 		vkDeviceWaitIdle(device);
 		Destroy();
 
-		// 1. Fill the host-visible instance array. Vulkan wants a row-major 3x4 (transform[row][col]); glm is
-		//    column-major, so transpose the upper 3x4 of each world matrix.
+		// 1. Encode the instances and fill the host-visible instance array. Copy 0 feeds this build; every copy
+		// is allocated now, and the others pick the new contents up on their first refit (all slots carry the
+		// new serial, so each copy's catch-up rewrites everything once).
+		m_HostInstances.resize(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			m_HostInstances[i] = MakeInstance(instances[i], i);
+		}
+		++m_RefitSerial;
+		m_SlotSerials.assign(count, m_RefitSerial);
+		m_RecordedSerial = m_RefitSerial;
+
+		m_FrameInstances.resize(std::max(1u, Renderer::GetFramesInFlight()));
 		const VkDeviceSize instancesBytes = std::max<VkDeviceSize>(1, count) * sizeof(VkAccelerationStructureInstanceKHR);
-		EnsureBuffer(instancesBytes, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR, true, 0,
-		             m_InstanceBuffer, m_InstanceAllocation, m_InstanceCapacity, "TLAS_Instances");
+		for (FrameInstances& frame : m_FrameInstances)
+		{
+			const VkBuffer previous = frame.Buffer;
+			EnsureBuffer(instancesBytes, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR, true, 0,
+			             frame.Buffer, frame.Allocation, frame.Capacity, "TLAS_Instances");
+			if (frame.Buffer != previous)
+			{
+				frame.SyncedSerial = 0; // fresh memory: nothing in it is current
+			}
+		}
 
+		FrameInstances& buildCopy = m_FrameInstances[0];
 		if (count > 0)
 		{
 			VmaAllocationInfo allocInfo{};
-			vmaGetAllocationInfo(GetAllocator(), m_InstanceAllocation, &allocInfo);
-			auto* dst = static_cast<VkAccelerationStructureInstanceKHR*>(allocInfo.pMappedData);
-			for (uint32_t i = 0; i < count; ++i)
-			{
-				const glm::mat4 t = glm::transpose(instances[i].Transform);
-				VkAccelerationStructureInstanceKHR inst{};
-				std::memcpy(&inst.transform, &t, sizeof(VkTransformMatrixKHR)); // first 3 rows = 12 floats
-				inst.instanceCustomIndex = i;
-				inst.mask = 0xFF;
-				inst.flags = VK_GEOMETRY_INSTANCE_TRIANGLE_FACING_CULL_DISABLE_BIT_KHR;
-				// Masked (glTF MASK) instances must be non-opaque so RayQuery surfaces their triangles as
-				// candidates for the any-hit alpha test; this instance bit overrides the geometry's OPAQUE bit
-				// below. Without it cutout foliage renders solid in every RT pass (#151).
-				if (instances[i].ForceNonOpaque)
-				{
-					inst.flags |= VK_GEOMETRY_INSTANCE_FORCE_NO_OPAQUE_BIT_KHR;
-				}
-				inst.accelerationStructureReference = instances[i].BlasAddress;
-				dst[i] = inst;
-			}
-			vmaFlushAllocation(GetAllocator(), m_InstanceAllocation, 0, count * sizeof(VkAccelerationStructureInstanceKHR));
+			vmaGetAllocationInfo(GetAllocator(), buildCopy.Allocation, &allocInfo);
+			std::memcpy(allocInfo.pMappedData, m_HostInstances.data(), count * sizeof(VkAccelerationStructureInstanceKHR));
+			vmaFlushAllocation(GetAllocator(), buildCopy.Allocation, 0, count * sizeof(VkAccelerationStructureInstanceKHR));
 		}
+		buildCopy.SyncedSerial = m_RefitSerial;
 
 		// 2. Geometry = the instance array by device address.
-		VkAccelerationStructureGeometryKHR geometry{VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR};
-		geometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
-		geometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-		geometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
-		geometry.geometry.instances.arrayOfPointers = VK_FALSE;
-		geometry.geometry.instances.data.deviceAddress = RawBufferAddress(m_InstanceBuffer);
+		VkAccelerationStructureGeometryKHR geometry = MakeInstancesGeometry(buildCopy.Buffer);
 
 		VkAccelerationStructureBuildGeometryInfoKHR buildInfo{
 		    VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR};
 		buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
-		buildInfo.flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR;
+		buildInfo.flags = kTlasBuildFlags;
 		buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
 		buildInfo.geometryCount = 1;
 		buildInfo.pGeometries = &geometry;
@@ -184,7 +248,8 @@ namespace Snowstorm
 		props2.pNext = &asProps;
 		vkGetPhysicalDeviceProperties2(GetVulkanPhysicalDevice(), &props2);
 
-		EnsureBuffer(sizeInfo.buildScratchSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, false,
+		// Sized for the larger of build and update, so a later Refit reuses it as is.
+		EnsureBuffer(std::max(sizeInfo.buildScratchSize, sizeInfo.updateScratchSize), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, false,
 		             asProps.minAccelerationStructureScratchOffsetAlignment, m_ScratchBuffer, m_ScratchAllocation,
 		             m_ScratchCapacity, "TLAS_Scratch");
 
@@ -204,4 +269,96 @@ namespace Snowstorm
 			                    VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR, m_DebugName.c_str());
 		}
 	}
+
+	bool VulkanTlas::Refit(const std::vector<TLASInstance>& instances, const std::span<const TlasSlotRange> dirty)
+	{
+		const auto count = static_cast<uint32_t>(instances.size());
+		if (m_AccelStruct == VK_NULL_HANDLE || count == 0 || count != m_InstanceCount)
+		{
+			return false;
+		}
+
+		// CPU only: re-encode the moved instances and stamp their slots. The instance buffers and the AS are
+		// written by RecordPendingRefit on the frame's own command buffer, where they can be ordered against
+		// the frames still in flight instead of draining the device.
+		++m_RefitSerial;
+		for (const TlasSlotRange& range : dirty)
+		{
+			const uint32_t end = std::min(range.First + range.Count, count);
+			for (uint32_t i = range.First; i < end; ++i)
+			{
+				m_HostInstances[i] = MakeInstance(instances[i], i);
+				m_SlotSerials[i] = m_RefitSerial;
+			}
+		}
+		return true;
+	}
+
+	void VulkanTlas::RecordPendingRefit(CommandContext& ctx, const uint32_t frameIndex)
+	{
+		if (m_RecordedSerial == m_RefitSerial || m_AccelStruct == VK_NULL_HANDLE)
+		{
+			return;
+		}
+		SS_CORE_ASSERT(frameIndex < m_FrameInstances.size(), "TLAS refit recorded for an unknown frame slot");
+
+		// 1. Bring this frame's instance array up to date: the slots moved since the copy was last written, which
+		// covers the staged refits of frames that recorded into the other copies. A linear pass over the slot
+		// serials; only the moved runs are written and flushed. BeginFrame waited on this slot's fence, so the
+		// frame that last built from the copy has retired.
+		FrameInstances& frame = m_FrameInstances[frameIndex];
+		VmaAllocationInfo allocInfo{};
+		vmaGetAllocationInfo(GetAllocator(), frame.Allocation, &allocInfo);
+		auto* dst = static_cast<VkAccelerationStructureInstanceKHR*>(allocInfo.pMappedData);
+		for (uint32_t i = 0; i < m_InstanceCount;)
+		{
+			if (m_SlotSerials[i] <= frame.SyncedSerial)
+			{
+				++i;
+				continue;
+			}
+			const uint32_t first = i;
+			while (i < m_InstanceCount && m_SlotSerials[i] > frame.SyncedSerial)
+			{
+				dst[i] = m_HostInstances[i];
+				++i;
+			}
+			vmaFlushAllocation(GetAllocator(), frame.Allocation, first * sizeof(VkAccelerationStructureInstanceKHR),
+			                   (i - first) * sizeof(VkAccelerationStructureInstanceKHR));
+		}
+		frame.SyncedSerial = m_RefitSerial;
+
+		// 2. UPDATE-mode build, source = destination (an in-place refit of the existing BVH), reading this
+		// frame's instance array.
+		VkAccelerationStructureGeometryKHR geometry = MakeInstancesGeometry(frame.Buffer);
+
+		VkAccelerationStructureBuildGeometryInfoKHR buildInfo{
+		    VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR};
+		buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR;
+		buildInfo.flags = kTlasBuildFlags;
+		buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+		buildInfo.srcAccelerationStructure = m_AccelStruct;
+		buildInfo.dstAccelerationStructure = m_AccelStruct;
+		buildInfo.geometryCount = 1;
+		buildInfo.pGeometries = &geometry;
+		buildInfo.scratchData.deviceAddress = RawBufferAddress(m_ScratchBuffer);
+
+		VkAccelerationStructureBuildRangeInfoKHR rangeInfo{};
+		rangeInfo.primitiveCount = m_InstanceCount;
+		const VkAccelerationStructureBuildRangeInfoKHR* pRange = &rangeInfo;
+
+		// The AS and the scratch buffer are shared by every frame. The barrier's first scope reaches back into
+		// earlier submissions on the queue: the update waits for the previous frames' ray queries still reading
+		// the AS and for the previous refit's writes, and this frame's traces wait for the update. That orders
+		// the refit on the GPU timeline alone -- the CPU never waits.
+		const VkCommandBuffer cmd = static_cast<VulkanCommandContext&>(ctx).GetVulkanCommandBuffer();
+		AsMemoryBarrier(cmd, kTraceStages | VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+		                VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR, VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+		                VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR | VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR);
+		vkCmdBuildAccelerationStructuresKHR(cmd, 1, &buildInfo, &pRange);
+		AsMemoryBarrier(cmd, VK_PIPELINE_STAGE_2_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_ACCESS_2_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+		                kTraceStages, VK_ACCESS_2_ACCELERATION_STRUCTURE_READ_BIT_KHR);
+
+		m_RecordedSerial = m_RefitSerial;
+	}
 }
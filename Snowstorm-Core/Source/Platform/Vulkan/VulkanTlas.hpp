@@ -7,9 +7,11 @@
 namespace Snowstorm
 {
 	// Vulkan top-level acceleration structure (#118). Owns a VkAccelerationStructureKHR plus the buffers that
-	// back it: the AS storage, the VkAccelerationStructureInstanceKHR array (host-visible, rewritten each
-	// build), and a scratch buffer. Rebuilds fully on each Build() — cheap at this scene scale. The AS handle
-	// is written into the bindless set (binding 2) so ray-query shaders trace it.
+	// back it: the AS storage, one VkAccelerationStructureInstanceKHR array per frame in flight (host-visible,
+	// persistently mapped), and a scratch buffer sized for both build and update. Build recreates the AS
+	// synchronously; Refit only stages the moved instances, and RecordPendingRefit updates the AS in place
+	// (UPDATE mode) on the frame's command buffer, so the handle is stable across refits. The AS handle is
+	// written into the bindless set (binding 2) so ray-query shaders trace it.
 	class VulkanTlas final : public TLAS
 	{
 	public:
@@ -17,6 +19,8 @@ namespace Snowstorm
 		~VulkanTlas() override;
 
 		void Build(const std::vector<TLASInstance>& instances) override;
+		bool Refit(const std::vector<TLASInstance>& instances, std::span<const TlasSlotRange> dirty) override;
+		void RecordPendingRefit(CommandContext& ctx, uint32_t frameIndex) override;
 
 		[[nodiscard]] uint32_t GetInstanceCount() const override { return m_InstanceCount; }
 
@@ -32,9 +36,24 @@ namespace Snowstorm
 		VkBuffer m_AsBuffer = VK_NULL_HANDLE; // AS storage
 		VmaAllocation m_AsAllocation = nullptr;
 
-		VkBuffer m_InstanceBuffer = VK_NULL_HANDLE; // host-visible instance array
-		VmaAllocation m_InstanceAllocation = nullptr;
-		VkDeviceSize m_InstanceCapacity = 0; // bytes currently allocated for the instance array
+		// One instance array per frame in flight. The CPU may only rewrite a copy once the frame that last
+		// built from it has retired, which BeginFrame's fence wait guarantees for the current slot -- so a
+		// refit writes the current slot's copy while earlier frames still refit from theirs.
+		struct FrameInstances
+		{
+			VkBuffer Buffer = VK_NULL_HANDLE;
+			VmaAllocation Allocation = nullptr;
+			VkDeviceSize Capacity = 0; // bytes currently allocated
+			uint64_t SyncedSerial = 0; // refit serial this copy was last brought up to
+		};
+		std::vector<FrameInstances> m_FrameInstances;
+
+		// The encoded instance array, plus which refit last touched each slot: a copy catches up by rewriting
+		// the slots changed after its SyncedSerial, i.e. this frame's moves and those of the frames in between.
+		std::vector<VkAccelerationStructureInstanceKHR> m_HostInstances;
+		std::vector<uint64_t> m_SlotSerials;
+		uint64_t m_RefitSerial = 0;    // bumped by every staged Refit (and by Build)
+		uint64_t m_RecordedSerial = 0; // the serial the AS on the GPU reflects once recorded work runs
 
 		VkBuffer m_ScratchBuffer = VK_NULL_HANDLE; // build scratch
 		VmaAllocation m_ScratchAllocation = nullptr;
@@ -0,0 +1,165 @@
+#include "Snowstorm/Core/FileWatcher.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// One ReadDirectoryChangesW subscription (recursive) on a watch root. The notification buffer is owned here
+		// and must stay put while a read is outstanding, so instances live behind unique_ptr and never move.
+		struct WatchedDirectory
+		{
+			std::filesystem::path Root;
+			HANDLE Directory = INVALID_HANDLE_VALUE;
+			OVERLAPPED Overlapped{};
+			// DWORD-aligned as FILE_NOTIFY_INFORMATION requires; 64 KiB is the ceiling for network shares.
+			std::vector<DWORD> Buffer = std::vector<DWORD>(16 * 1024);
+		};
+
+		class WindowsFileWatcherBackend final : public FileWatcher::Backend
+		{
+		public:
+			~WindowsFileWatcherBackend() override
+			{
+				for (const auto& w : m_Watches)
+				{
+					// Cancel, then wait for the cancellation to land: the kernel may still write into Buffer until
+					// the overlapped read has completed.
+					DWORD bytes = 0;
+					CancelIoEx(w->Directory, &w->Overlapped);
+					GetOverlappedResult(w->Directory, &w->Overlapped, &bytes, TRUE);
+					CloseHandle(w->Overlapped.hEvent);
+					CloseHandle(w->Directory);
+				}
+			}
+
+			bool Add(const std::filesystem::path& root)
+			{
+				auto w = std::make_unique<WatchedDirectory>();
+				w->Root = root;
+				w->Directory = CreateFileW(root.wstring().c_str(), FILE_LIST_DIRECTORY,
+				                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+				                           FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+				if (w->Directory == INVALID_HANDLE_VALUE)
+				{
+					SS_CORE_WARN("FileWatcher: cannot open {} (Win32 error={})", root.string(), static_cast<uint32_t>(GetLastError()));
+					return false;
+				}
+				w->Overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+				if (!w->Overlapped.hEvent || !Arm(*w))
+				{
+					SS_CORE_WARN("FileWatcher: cannot watch {} (Win32 error={})", root.string(), static_cast<uint32_t>(GetLastError()));
+					if (w->Overlapped.hEvent)
+					{
+						CloseHandle(w->Overlapped.hEvent);
+					}
+					CloseHandle(w->Directory);
+					return false;
+				}
+				m_Watches.push_back(std::move(w));
+				return true;
+			}
+
+			[[nodiscard]] bool Empty() const { return m_Watches.empty(); }
+
+			bool Poll(std::vector<std::filesystem::path>& out, bool& overflowed, const uint32_t timeoutMs) override
+			{
+				std::vector<HANDLE> events;
+				events.reserve(m_Watches.size());
+				for (const auto& w : m_Watches)
+				{
+					events.push_back(w->Overlapped.hEvent);
+				}
+
+				const DWORD res = WaitForMultipleObjects(static_cast<DWORD>(events.size()), events.data(), FALSE, timeoutMs);
+				if (res == WAIT_TIMEOUT)
+				{
+					return true;
+				}
+				if (res >= WAIT_OBJECT_0 + events.size())
+				{
+					return false;
+				}
+
+				// Service every completed read, not just the first signaled one, so a busy root can't starve another.
+				for (const auto& w : m_Watches)
+				{
+					if (!HasOverlappedIoCompleted(&w->Overlapped))
+					{
+						continue;
+					}
+
+					DWORD bytes = 0;
+					if (!GetOverlappedResult(w->Directory, &w->Overlapped, &bytes, FALSE))
+					{
+						return false; // the watched directory went away (deleted / drive unplugged)
+					}
+
+					// Zero bytes on success = the kernel's change buffer overflowed and the events are gone.
+					if (bytes == 0)
+					{
+						overflowed = true;
+					}
+					else
+					{
+						Collect(*w, out);
+					}
+
+					if (!Arm(*w))
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+		private:
+			static bool Arm(WatchedDirectory& w)
+			{
+				ResetEvent(w.Overlapped.hEvent);
+				// LAST_WRITE covers in-place saves, FILE_NAME covers save-to-temp-then-rename editors (the new file
+				// appears under its final name). Directory adds/removes are not interesting on their own.
+				return ReadDirectoryChangesW(w.Directory, w.Buffer.data(), static_cast<DWORD>(w.Buffer.size() * sizeof(DWORD)),
+				                             TRUE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+				                             nullptr, &w.Overlapped, nullptr) != FALSE;
+			}
+
+			static void Collect(const WatchedDirectory& w, std::vector<std::filesystem::path>& out)
+			{
+				const auto* base = reinterpret_cast<const uint8_t*>(w.Buffer.data());
+				for (size_t offset = 0;;)
+				{
+					const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(base + offset);
+					// A removed file (or the old name of a rename) has nothing to reload.
+					if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME)
+					{
+						const std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+						out.push_back(w.Root / name);
+					}
+					if (info->NextEntryOffset == 0)
+					{
+						break;
+					}
+					offset += info->NextEntryOffset;
+				}
+			}
+
+			std::vector<std::unique_ptr<WatchedDirectory>> m_Watches;
+		};
+	}
+
+	std::unique_ptr<FileWatcher::Backend> FileWatcher::Backend::Create(const std::vector<std::filesystem::path>& roots)
+	{
+		auto backend = std::make_unique<WindowsFileWatcherBackend>();
+		for (const std::filesystem::path& root : roots)
+		{
+			(void)backend->Add(root);
+		}
+		if (backend->Empty())
+		{
+			return nullptr;
+		}
+		return backend;
+	}
+}
@@ -12,8 +12,9 @@ namespace Snowstorm
 		if (ec)
 			return 0;
 
-		// Convert file_time_type to a count. This is implementation-defined but stable enough per machine.
-		// Good for cache invalidation. If you later want cross-machine stability, switch to hashing file contents.
+		// Convert file_time_type to a count. This is implementation-defined but stable enough per machine —
+		// which is why it is only the ContentHashIndex's "unchanged since last hash" shortcut. Cooked artifacts
+		// are keyed by content hash (DerivedDataCache), never by this value, so they survive checkouts/copies.
 		return static_cast<uint64_t>(ft.time_since_epoch().count());
 	}
 }
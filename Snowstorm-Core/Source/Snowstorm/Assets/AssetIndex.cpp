@@ -0,0 +1,1218 @@
+#include "AssetIndex.hpp"
+
+#include "Snowstorm/Assets/AssetFileTime.hpp"
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Assets/ContentHashIndex.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint32_t kIndexMagic = 0x58444941; // "AIDX"
+		constexpr uint32_t kThumbMagic = 0x424D4854; // "THMB"
+		constexpr uint32_t kVersion = 1;
+
+		// Entries hashed per idle step: small enough that a command posted meanwhile waits a few ms at most.
+		constexpr size_t kHashBatch = 64;
+
+		// How often a long walk (or thumbnail batch) publishes what it has so far. Each publish copies and sorts
+		// the whole list, so not every frame.
+		constexpr auto kPublishInterval = std::chrono::milliseconds(250);
+
+		// The index is written once nothing has changed for this long (and on Close).
+		constexpr auto kSaveDelay = std::chrono::seconds(2);
+
+		// Directory entries between stop / query checks inside a walk.
+		constexpr size_t kWalkCheckInterval = 1024;
+
+		struct Header
+		{
+			uint32_t Magic = kIndexMagic;
+			uint32_t Version = kVersion;
+			uint64_t EntryCount = 0;
+		};
+
+		struct StoredEntry
+		{
+			uint64_t Size = 0;
+			uint64_t WriteTime = 0;
+			uint64_t Hash = 0;
+			uint64_t Handle = 0;
+			uint32_t Thumbnail = AssetIndex::kNoThumbnail;
+			uint8_t Type = 0;
+			uint8_t Padding[3] = {};
+		};
+
+		struct ThumbHeader
+		{
+			uint32_t Magic = kThumbMagic;
+			uint32_t Version = kVersion;
+			uint32_t AtlasSize = AssetIndex::kAtlasSize;
+			uint32_t ThumbnailSize = AssetIndex::kThumbnailSize;
+			uint32_t NextSlot = 0;
+			uint32_t Reserved = 0;
+		};
+
+		constexpr uint32_t kMaxStoredPath = 4096;
+
+		void ToLowerInto(const std::string_view text, std::string& out)
+		{
+			out.assign(text);
+			std::ranges::transform(out, out.begin(), [](const unsigned char c)
+			                       { return static_cast<char>(std::tolower(c)); });
+		}
+
+		bool IsWordStart(const std::string_view text, const size_t i)
+		{
+			if (i == 0)
+			{
+				return true;
+			}
+			const char prev = text[i - 1];
+			return prev == ' ' || prev == '_' || prev == '-' || prev == '.' || prev == '/';
+		}
+
+		bool ReadString(std::ifstream& in, std::string& out, const bool allowEmpty)
+		{
+			uint32_t length = 0;
+			in.read(reinterpret_cast<char*>(&length), sizeof(length));
+			if (!in || length > kMaxStoredPath || (length == 0 && !allowEmpty))
+			{
+				return false;
+			}
+			out.assign(length, '\0');
+			in.read(out.data(), length);
+			return static_cast<bool>(in);
+		}
+
+		void WriteString(std::ofstream& out, const std::string& text)
+		{
+			const auto length = static_cast<uint32_t>(text.size());
+			out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+			out.write(text.data(), length);
+		}
+
+		// Same temp-then-rename dance as ContentHashIndex::Flush: a crash mid-write leaves the old file intact.
+		bool ReplaceFile(const std::string& temporary, const std::filesystem::path& target)
+		{
+			std::error_code ec;
+			std::filesystem::rename(temporary, target, ec);
+			if (ec)
+			{
+				std::filesystem::remove(target, ec);
+				ec.clear();
+				std::filesystem::rename(temporary, target, ec);
+			}
+			return !ec;
+		}
+
+		std::filesystem::path ThumbnailPath(const std::filesystem::path& indexPath)
+		{
+			return indexPath.string() + ".thumbs";
+		}
+
+		// Engine/cache/ inside the asset directory holds cooked artifacts, not sources.
+		bool IsInCacheDirectory(const std::string_view key, const size_t from)
+		{
+			const size_t at = key.find("/cache", from);
+			return at != std::string_view::npos && (at + 6 == key.size() || key[at + 6] == '/');
+		}
+	}
+
+	AssetIndex::~AssetIndex()
+	{
+		Close();
+	}
+
+	std::filesystem::path AssetIndex::DefaultIndexPath(const std::filesystem::path& projectDirectory)
+	{
+		const std::string key = FileWatcher::MakeKey(projectDirectory);
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.bin",
+		              static_cast<unsigned long long>(HashBytes64(key.data(), key.size())));
+		return std::filesystem::path("Engine/cache/assetindex") / name;
+	}
+
+	void AssetIndex::Open(const std::filesystem::path& projectDirectory, const std::filesystem::path& assetDirectory,
+	                      const std::filesystem::path& indexPath)
+	{
+		const std::filesystem::path project = FileWatcher::MakeKey(projectDirectory);
+		const std::filesystem::path assets = FileWatcher::MakeKey(assetDirectory);
+		if (IsOpen() && project == m_ProjectDirectory && assets == m_AssetDirectory && indexPath == m_IndexPath)
+		{
+			return;
+		}
+		Close();
+
+		m_ProjectDirectory = project;
+		m_AssetDirectory = assets;
+		m_IndexPath = indexPath;
+		m_AssetKey = assets.generic_string();
+
+		// Worker-owned state starts over (the thread isn't running). Revisions keep counting so a reader
+		// comparing against the previous project's numbers still sees a change.
+		m_Entries.clear();
+		m_ByPath.clear();
+		m_Seen.clear();
+		m_Atlas.assign(static_cast<size_t>(kAtlasSize) * kAtlasSize * 4, 0);
+		m_SlotOwners.assign(kThumbnailSlots, {});
+		m_NextSlot = 0;
+		m_ThumbnailFailed.clear();
+		m_HashCursor = 0;
+		m_EntriesDirty = false;
+		m_AtlasDirty = false;
+		m_NeedsSave = false;
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Commands.clear();
+			m_Stopping = false;
+			m_Scanning = true; // the first walk starts right away; say so before the first frame asks
+			m_QueryChanged = true;
+			m_Snapshot = std::make_shared<const Snapshot>();
+			m_Result.reset();
+			m_RegistryChecks.clear();
+			m_PublishedAtlas.clear();
+		}
+
+		m_StopRequested = false;
+		m_Thread = std::thread([this]
+		                       { Run(); });
+	}
+
+	void AssetIndex::Close()
+	{
+		if (!m_Thread.joinable())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stopping = true;
+		}
+		m_StopRequested = true;
+		m_Wake.notify_all();
+		m_Thread.join();
+
+		Save(); // the worker is gone: its state is ours now
+
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Scanning = false;
+			m_SyncDone = m_SyncIssued; // nobody will answer these any more
+		}
+		m_Synced.notify_all();
+	}
+
+	void AssetIndex::Post(Command command)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Commands.push_back(std::move(command));
+		}
+		m_Wake.notify_one();
+	}
+
+	void AssetIndex::RequestRescan()
+	{
+		if (IsOpen())
+		{
+			Post(Command{CommandType::Rescan});
+		}
+	}
+
+	void AssetIndex::NotifyChanged(const std::span<const std::string> paths, const bool overflowed)
+	{
+		if (!IsOpen())
+		{
+			return;
+		}
+		if (overflowed)
+		{
+			Post(Command{CommandType::Rescan});
+			return;
+		}
+
+		// The watcher also reports the engine's shader directory: only forward what lies under the assets.
+		Command command{CommandType::Changed};
+		for (const std::string& path : paths)
+		{
+			if (path.size() > m_AssetKey.size() && path.compare(0, m_AssetKey.size(), m_AssetKey) == 0 &&
+			    path[m_AssetKey.size()] == '/')
+			{
+				command.Paths.push_back(path);
+			}
+		}
+		if (!command.Paths.empty())
+		{
+			Post(std::move(command));
+		}
+	}
+
+	void AssetIndex::SetHandle(const std::string& path, const uint64_t handle)
+	{
+		if (IsOpen())
+		{
+			Post(Command{CommandType::SetHandle, {path}, handle});
+		}
+	}
+
+	void AssetIndex::RequestThumbnails(std::vector<std::string> paths)
+	{
+		if (IsOpen() && !paths.empty())
+		{
+			Post(Command{CommandType::Thumbnails, std::move(paths)});
+		}
+	}
+
+	void AssetIndex::SetQuery(Query query)
+	{
+		{
+			std::lock_guard lock(m_Mutex);
+			if (query.Type == m_Query.Type && query.Text == m_Query.Text)
+			{
+				return;
+			}
+			m_Query = std::move(query);
+			m_QueryChanged = true;
+		}
+		m_Wake.notify_one();
+	}
+
+	std::shared_ptr<const AssetIndex::Snapshot> AssetIndex::GetSnapshot() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Snapshot;
+	}
+
+	std::shared_ptr<const AssetIndex::QueryResult> AssetIndex::GetQueryResult() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Result;
+	}
+
+	void AssetIndex::TakeRegistryChecks(std::vector<RegistryCheck>& out, const size_t max)
+	{
+		std::lock_guard lock(m_Mutex);
+		const size_t count = std::min(max, m_RegistryChecks.size());
+		out.insert(out.end(), std::make_move_iterator(m_RegistryChecks.begin()),
+		           std::make_move_iterator(m_RegistryChecks.begin() + static_cast<ptrdiff_t>(count)));
+		m_RegistryChecks.erase(m_RegistryChecks.begin(), m_RegistryChecks.begin() + static_cast<ptrdiff_t>(count));
+	}
+
+	bool AssetIndex::CopyThumbnailAtlas(std::vector<uint8_t>& out, uint64_t& revision) const
+	{
+		std::lock_guard lock(m_Mutex);
+		if (m_PublishedAtlas.empty() || m_AtlasRevision == revision)
+		{
+			return false;
+		}
+		out = m_PublishedAtlas;
+		revision = m_AtlasRevision;
+		return true;
+	}
+
+	bool AssetIndex::IsScanning() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Scanning;
+	}
+
+	void AssetIndex::Sync()
+	{
+		if (!IsOpen())
+		{
+			return;
+		}
+		std::unique_lock lock(m_Mutex);
+		const uint64_t ticket = ++m_SyncIssued;
+		m_Commands.push_back(Command{CommandType::Sync, {}, ticket});
+		m_Wake.notify_one();
+		m_Synced.wait(lock, [&]
+		              { return m_SyncDone >= ticket; });
+	}
+
+	AssetType AssetIndex::TypeFromExtension(const std::string_view ext)
+	{
+		if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb")
+		{
+			return AssetType::Mesh;
+		}
+		if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".dds" || ext == ".bmp")
+		{
+			return AssetType::Texture;
+		}
+		if (ext == ".ssmat")
+		{
+			return AssetType::Material;
+		}
+		if (ext == ".hlsl")
+		{
+			return AssetType::Shader;
+		}
+		if (ext == ".world" || ext == ".ssworld" || ext == ".sspartition")
+		{
+			return AssetType::Scene;
+		}
+		return AssetType::None;
+	}
+
+	int AssetIndex::FuzzyScore(const std::string_view text, const std::string_view query)
+	{
+		if (query.empty())
+		{
+			return 0;
+		}
+
+		// Greedy left-to-right subsequence match. Not optimal alignment (fzf's DP), but a file-name list wants
+		// "did it match, and roughly how well", and this is linear.
+		int score = 0;
+		size_t t = 0;
+		size_t first = std::string_view::npos;
+		size_t last = std::string_view::npos;
+		for (const char q : query)
+		{
+			while (t < text.size() && text[t] != q)
+			{
+				++t;
+			}
+			if (t == text.size())
+			{
+				return -1;
+			}
+
+			score += 1;
+			if (last != std::string_view::npos)
+			{
+				if (t == last + 1)
+				{
+					score += 4; // continuing a run
+				}
+				else
+				{
+					score -= static_cast<int>(std::min<size_t>(t - last - 1, 3)); // a gap, capped
+				}
+			}
+			if (IsWordStart(text, t))
+			{
+				score += 6;
+			}
+			if (first == std::string_view::npos)
+			{
+				first = t;
+			}
+			last = t;
+			++t;
+		}
+
+		if (text.find(query) != std::string_view::npos)
+		{
+			score += 2 * static_cast<int>(query.size()) + 10;
+		}
+		score -= static_cast<int>(std::min<size_t>(first, 10)); // matches near the front of the name rank up
+		return std::max(score, 0);
+	}
+
+	void AssetIndex::MakeThumbnail(const uint8_t* rgba, const uint32_t width, const uint32_t height, uint8_t* out)
+	{
+		constexpr uint32_t k = kThumbnailSize;
+		std::fill_n(out, static_cast<size_t>(k) * k * 4, uint8_t{0});
+		if (width == 0 || height == 0)
+		{
+			return;
+		}
+
+		// Fit the longer side; the shorter one is centred on transparent.
+		const double scale = std::min(static_cast<double>(k) / width, static_cast<double>(k) / height);
+		const uint32_t dw = std::clamp(static_cast<uint32_t>(width * scale + 0.5), 1u, k);
+		const uint32_t dh = std::clamp(static_cast<uint32_t>(height * scale + 0.5), 1u, k);
+		const uint32_t ox = (k - dw) / 2;
+		const uint32_t oy = (k - dh) / 2;
+
+		for (uint32_t y = 0; y < dh; ++y)
+		{
+			const uint64_t y0 = static_cast<uint64_t>(y) * height / dh;
+			const uint64_t y1 = std::max<uint64_t>(y0 + 1, static_cast<uint64_t>(y + 1) * height / dh);
+			for (uint32_t x = 0; x < dw; ++x)
+			{
+				const uint64_t x0 = static_cast<uint64_t>(x) * width / dw;
+				const uint64_t x1 = std::max<uint64_t>(x0 + 1, static_cast<uint64_t>(x + 1) * width / dw);
+
+				uint64_t sum[4] = {};
+				for (uint64_t sy = y0; sy < y1; ++sy)
+				{
+					const uint8_t* row = rgba + (sy * width + x0) * 4;
+					for (uint64_t sx = x0; sx < x1; ++sx, row += 4)
+					{
+						sum[0] += row[0];
+						sum[1] += row[1];
+						sum[2] += row[2];
+						sum[3] += row[3];
+					}
+				}
+
+				const uint64_t count = (y1 - y0) * (x1 - x0);
+				uint8_t* dst = out + ((static_cast<size_t>(oy) + y) * k + ox + x) * 4;
+				for (int c = 0; c < 4; ++c)
+				{
+					dst[c] = static_cast<uint8_t>((sum[c] + count / 2) / count);
+				}
+			}
+		}
+	}
+
+	// ------------------------------------------------------------------------------------------------------------
+	// Worker thread
+	// ------------------------------------------------------------------------------------------------------------
+
+	void AssetIndex::Run()
+	{
+		const auto rescan = [this]
+		{
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Scanning = true;
+			}
+			Walk(m_AssetDirectory, true);
+			{
+				std::lock_guard lock(m_Mutex);
+				m_Scanning = false;
+			}
+		};
+
+		// Last session's list first: the browser is populated before the walk has looked at a single file.
+		Load();
+		Publish();
+		rescan();
+		Publish();
+
+		while (true)
+		{
+			std::vector<Command> commands;
+			{
+				std::unique_lock lock(m_Mutex);
+				const bool dirty = m_EntriesDirty || m_AtlasDirty;
+				const bool hashing = !dirty && m_HashCursor < m_Entries.size();
+				const auto ready = [&]
+				{ return m_Stopping || !m_Commands.empty() || m_QueryChanged || hashing; };
+
+				// Pending changes are published at most every kPublishInterval; the index is saved once
+				// everything has been quiet for kSaveDelay. Otherwise sleep until asked.
+				if (dirty)
+				{
+					m_Wake.wait_until(lock, m_LastPublish + kPublishInterval, ready);
+				}
+				else if (m_NeedsSave && !hashing)
+				{
+					m_Wake.wait_until(lock, m_LastChange + kSaveDelay, ready);
+				}
+				else
+				{
+					m_Wake.wait(lock, ready);
+				}
+
+				if (m_Stopping)
+				{
+					break;
+				}
+				commands.assign(std::make_move_iterator(m_Commands.begin()), std::make_move_iterator(m_Commands.end()));
+				m_Commands.clear();
+			}
+
+			uint64_t syncTicket = 0;
+			for (Command& command : commands)
+			{
+				if (m_StopRequested)
+				{
+					break;
+				}
+				switch (command.Type)
+				{
+				case CommandType::Rescan:
+					rescan();
+					break;
+				case CommandType::Changed:
+					for (const std::string& path : command.Paths)
+					{
+						ApplyChanged(path);
+					}
+					break;
+				case CommandType::SetHandle:
+					if (const auto it = m_ByPath.find(command.Paths.front()); it != m_ByPath.end())
+					{
+						if (Entry& entry = m_Entries[it->second]; entry.Handle != command.Value)
+						{
+							entry.Handle = command.Value;
+							m_EntriesDirty = true;
+							m_NeedsSave = true;
+						}
+					}
+					break;
+				case CommandType::Thumbnails:
+					MakeThumbnails(command.Paths);
+					break;
+				case CommandType::Sync:
+					syncTicket = std::max(syncTicket, command.Value);
+					break;
+				}
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			const bool dirty = m_EntriesDirty || m_AtlasDirty;
+			if (dirty && (syncTicket != 0 || now - m_LastPublish >= kPublishInterval))
+			{
+				Publish();
+			}
+			else
+			{
+				AnswerQuery();
+			}
+
+			if (syncTicket != 0)
+			{
+				{
+					std::lock_guard lock(m_Mutex);
+					m_SyncDone = std::max(m_SyncDone, syncTicket);
+				}
+				m_Synced.notify_all();
+			}
+
+			if (commands.empty() && !m_EntriesDirty && !m_AtlasDirty && !HashSome() && m_NeedsSave &&
+			    now - m_LastChange >= kSaveDelay)
+			{
+				Save();
+			}
+		}
+	}
+
+	void AssetIndex::Load()
+	{
+		std::ifstream in(m_IndexPath, std::ios::binary);
+		if (!in.is_open())
+		{
+			return; // first open of this project: the walk fills everything in
+		}
+
+		Header h{};
+		in.read(reinterpret_cast<char*>(&h), sizeof(h));
+		if (!in || h.Magic != kIndexMagic || h.Version != kVersion)
+		{
+			return;
+		}
+
+		std::vector<Entry> loaded;
+		loaded.reserve(static_cast<size_t>(std::min<uint64_t>(h.EntryCount, 1u << 20)));
+		for (uint64_t i = 0; i < h.EntryCount; ++i)
+		{
+			Entry entry;
+			StoredEntry stored{};
+			if (!ReadString(in, entry.Path, false))
+			{
+				return; // truncated/corrupt: start empty rather than trust half of it
+			}
+			in.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+			if (!in)
+			{
+				return;
+			}
+			entry.DisplayName = std::filesystem::path(entry.Path).filename().string();
+			entry.Type = static_cast<AssetType>(stored.Type);
+			entry.Size = stored.Size;
+			entry.WriteTime = stored.WriteTime;
+			entry.Hash = stored.Hash;
+			entry.Handle = stored.Handle;
+			entry.Thumbnail = stored.Thumbnail;
+			if (entry.Type != AssetType::None)
+			{
+				loaded.push_back(std::move(entry));
+			}
+		}
+
+		// The atlas is optional: without it every entry just loses its thumbnail.
+		bool atlasLoaded = false;
+		if (std::ifstream thumbs(ThumbnailPath(m_IndexPath), std::ios::binary); thumbs.is_open())
+		{
+			ThumbHeader th{};
+			thumbs.read(reinterpret_cast<char*>(&th), sizeof(th));
+			if (thumbs && th.Magic == kThumbMagic && th.Version == kVersion && th.AtlasSize == kAtlasSize &&
+			    th.ThumbnailSize == kThumbnailSize && th.NextSlot < kThumbnailSlots)
+			{
+				std::vector<std::string> owners(kThumbnailSlots);
+				bool ok = true;
+				for (std::string& owner : owners)
+				{
+					if (!ReadString(thumbs, owner, true))
+					{
+						ok = false;
+						break;
+					}
+				}
+				if (ok)
+				{
+					thumbs.read(reinterpret_cast<char*>(m_Atlas.data()), static_cast<std::streamsize>(m_Atlas.size()));
+				}
+				if (ok && thumbs)
+				{
+					m_SlotOwners = std::move(owners);
+					m_NextSlot = th.NextSlot;
+					atlasLoaded = true;
+				}
+				else
+				{
+					std::ranges::fill(m_Atlas, uint8_t{0});
+				}
+			}
+		}
+
+		m_Entries = std::move(loaded);
+		m_ByPath.reserve(m_Entries.size());
+		for (size_t i = 0; i < m_Entries.size(); ++i)
+		{
+			Entry& entry = m_Entries[i];
+			if (entry.Thumbnail != kNoThumbnail &&
+			    (!atlasLoaded || entry.Thumbnail >= kThumbnailSlots || m_SlotOwners[entry.Thumbnail] != entry.Path))
+			{
+				entry.Thumbnail = kNoThumbnail;
+			}
+			m_ByPath.emplace(entry.Path, i);
+		}
+		for (std::string& owner : m_SlotOwners)
+		{
+			if (!owner.empty() && !m_ByPath.contains(owner))
+			{
+				owner.clear();
+			}
+		}
+
+		// The registry may have been edited (or lost) since: have the main thread re-confirm every handle.
+		{
+			std::lock_guard lock(m_Mutex);
+			for (const Entry& entry : m_Entries)
+			{
+				if (entry.Type != AssetType::Scene)
+				{
+					m_RegistryChecks.push_back(RegistryCheck{entry.Path, entry.Type, entry.Handle});
+				}
+			}
+		}
+
+		m_EntriesDirty = true;
+		m_AtlasDirty = atlasLoaded;
+		SS_CORE_INFO("Asset index: {} entries from {}", m_Entries.size(), m_IndexPath.generic_string());
+	}
+
+	void AssetIndex::Save()
+	{
+		if (!m_NeedsSave)
+		{
+			return;
+		}
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_IndexPath.parent_path(), ec);
+
+		bool ok = true;
+		{
+			const std::string tmp = m_IndexPath.string() + ".tmp";
+			{
+				std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+				Header h{};
+				h.EntryCount = m_Entries.size();
+				out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+				for (const Entry& entry : m_Entries)
+				{
+					StoredEntry stored{};
+					stored.Size = entry.Size;
+					stored.WriteTime = entry.WriteTime;
+					stored.Hash = entry.Hash;
+					stored.Handle = entry.Handle;
+					stored.Thumbnail = entry.Thumbnail;
+					stored.Type = static_cast<uint8_t>(entry.Type);
+					WriteString(out, entry.Path);
+					out.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+				}
+				ok = static_cast<bool>(out);
+			}
+			ok = ok && ReplaceFile(tmp, m_IndexPath);
+		}
+		{
+			const std::filesystem::path thumbsPath = ThumbnailPath(m_IndexPath);
+			const std::string tmp = thumbsPath.string() + ".tmp";
+			{
+				std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+				ThumbHeader th{};
+				th.NextSlot = m_NextSlot;
+				out.write(reinterpret_cast<const char*>(&th), sizeof(th));
+				for (const std::string& owner : m_SlotOwners)
+				{
+					WriteString(out, owner);
+				}
+				out.write(reinterpret_cast<const char*>(m_Atlas.data()), static_cast<std::streamsize>(m_Atlas.size()));
+				ok = ok && static_cast<bool>(out);
+			}
+			ok = ok && ReplaceFile(tmp, thumbsPath);
+		}
+
+		// The hashes filled in by HashSome live in the shared memo too.
+		(void)ContentHashIndex::Get().Flush();
+
+		if (!ok)
+		{
+			SS_CORE_WARN("Asset index: failed to write {}", m_IndexPath.generic_string());
+		}
+		m_NeedsSave = false; // a failed write isn't retried until something changes again
+	}
+
+	bool AssetIndex::Walk(const std::filesystem::path& root, const bool full)
+	{
+		if (full)
+		{
+			m_Seen.clear();
+			m_Seen.reserve(m_Entries.size());
+		}
+
+		std::error_code ec;
+		size_t visited = 0;
+		std::string ext;
+		for (auto it = std::filesystem::recursive_directory_iterator(
+		         root, std::filesystem::directory_options::skip_permission_denied, ec);
+		     it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		{
+			if (ec)
+			{
+				continue;
+			}
+
+			if (++visited % kWalkCheckInterval == 0)
+			{
+				if (m_StopRequested)
+				{
+					return false; // entries not met yet must not be taken for deleted
+				}
+				Interleave();
+			}
+
+			const std::filesystem::directory_entry& entry = *it;
+			if (entry.is_directory(ec))
+			{
+				// Skip Engine/cache/: generated cooked artifacts (gitignored), not source assets.
+				if (entry.path().filename() == "cache")
+				{
+					it.disable_recursion_pending();
+				}
+				continue;
+			}
+			if (!entry.is_regular_file(ec))
+			{
+				continue;
+			}
+
+			ToLowerInto(entry.path().extension().string(), ext);
+			const AssetType type = TypeFromExtension(ext);
+			if (type == AssetType::None)
+			{
+				continue;
+			}
+
+			// directory_entry caches the stat on Windows (it comes with the directory listing), so a re-walk of an
+			// unchanged tree opens no files.
+			const uint64_t size = entry.file_size(ec);
+			if (ec)
+			{
+				continue;
+			}
+			const auto writeTime = entry.last_write_time(ec);
+			if (ec)
+			{
+				continue;
+			}
+
+			const size_t index = Upsert(entry.path(), type, size, static_cast<uint64_t>(writeTime.time_since_epoch().count()));
+			if (full)
+			{
+				m_Seen.insert(m_Entries[index].Path);
+			}
+		}
+
+		if (full)
+		{
+			std::vector<std::string> gone;
+			for (const Entry& entry : m_Entries)
+			{
+				if (!m_Seen.contains(entry.Path))
+				{
+					gone.push_back(entry.Path);
+				}
+			}
+			for (const std::string& path : gone)
+			{
+				Remove(path);
+			}
+			m_Seen.clear();
+		}
+		return true;
+	}
+
+	void AssetIndex::ApplyChanged(const std::string& key)
+	{
+		if (key.size() <= m_AssetKey.size() || key.compare(0, m_AssetKey.size(), m_AssetKey) != 0 ||
+		    key[m_AssetKey.size()] != '/' || IsInCacheDirectory(key, m_AssetKey.size()))
+		{
+			return;
+		}
+
+		const std::filesystem::path absolute(key);
+		std::error_code ec;
+		const std::filesystem::file_status status = std::filesystem::status(absolute, ec);
+		if (std::filesystem::is_directory(status))
+		{
+			Walk(absolute, false); // created or moved in: everything under it is new
+			return;
+		}
+		if (std::filesystem::is_regular_file(status))
+		{
+			std::string ext;
+			ToLowerInto(absolute.extension().string(), ext);
+			if (const AssetType type = TypeFromExtension(ext); type != AssetType::None)
+			{
+				const uint64_t size = std::filesystem::file_size(absolute, ec);
+				if (!ec)
+				{
+					Upsert(absolute, type, size, GetFileWriteTimeU64(absolute));
+				}
+			}
+			return;
+		}
+
+		// Gone: a file, or a whole directory (deleted or moved out) -- drop everything under it.
+		const std::string relative = absolute.lexically_relative(m_ProjectDirectory).generic_string();
+		const std::string prefix = relative + "/";
+		std::vector<std::string> gone;
+		for (const Entry& entry : m_Entries)
+		{
+			if (entry.Path == relative || entry.Path.starts_with(prefix))
+			{
+				gone.push_back(entry.Path);
+			}
+		}
+		for (const std::string& path : gone)
+		{
+			Remove(path);
+		}
+	}
+
+	size_t AssetIndex::Upsert(const std::filesystem::path& absolute, const AssetType type, const uint64_t size,
+	                          const uint64_t writeTime)
+	{
+		// Project-relative, matching the relative paths stored in AssetRegistry.json.
+		std::string relative = absolute.lexically_relative(m_ProjectDirectory).generic_string();
+
+		if (const auto it = m_ByPath.find(relative); it != m_ByPath.end())
+		{
+			Entry& entry = m_Entries[it->second];
+			if (entry.Size != size || entry.WriteTime != writeTime || entry.Type != type)
+			{
+				entry.Size = size;
+				entry.WriteTime = writeTime;
+				entry.Type = type;
+				entry.Hash = 0;
+				ReleaseThumbnail(entry);
+				m_ThumbnailFailed.erase(entry.Path);
+				m_HashCursor = std::min(m_HashCursor, it->second);
+				m_EntriesDirty = true;
+				m_NeedsSave = true;
+			}
+			return it->second;
+		}
+
+		Entry entry;
+		entry.Path = std::move(relative);
+		entry.DisplayName = absolute.filename().string();
+		entry.Type = type;
+		entry.Size = size;
+		entry.WriteTime = writeTime;
+
+		// Scenes are opened by path (double-click), not referenced by handle: not registry assets.
+		if (type != AssetType::Scene)
+		{
+			std::lock_guard lock(m_Mutex);
+			m_RegistryChecks.push_back(RegistryCheck{entry.Path, type, 0});
+		}
+
+		const size_t index = m_Entries.size();
+		m_ByPath.emplace(entry.Path, index);
+		m_Entries.push_back(std::move(entry));
+		m_HashCursor = std::min(m_HashCursor, index);
+		m_EntriesDirty = true;
+		m_NeedsSave = true;
+		return index;
+	}
+
+	void AssetIndex::Remove(const std::string& path)
+	{
+		const auto it = m_ByPath.find(path);
+		if (it == m_ByPath.end())
+		{
+			return;
+		}
+
+		const size_t index = it->second;
+		ReleaseThumbnail(m_Entries[index]);
+		m_ThumbnailFailed.erase(path);
+		m_ByPath.erase(it);
+
+		// Swap-and-pop; the moved entry may not have been hashed yet, so the cursor steps back to it.
+		if (index + 1 != m_Entries.size())
+		{
+			m_Entries[index] = std::move(m_Entries.back());
+			m_ByPath[m_Entries[index].Path] = index;
+		}
+		m_Entries.pop_back();
+		m_HashCursor = std::min(m_HashCursor, index);
+		m_EntriesDirty = true;
+		m_NeedsSave = true;
+	}
+
+	bool AssetIndex::HashSome()
+	{
+		if (m_HashCursor >= m_Entries.size())
+		{
+			return false;
+		}
+
+		const size_t end = std::min(m_Entries.size(), m_HashCursor + kHashBatch);
+		for (; m_HashCursor < end; ++m_HashCursor)
+		{
+			Entry& entry = m_Entries[m_HashCursor];
+			if (entry.Hash != 0)
+			{
+				continue;
+			}
+			if (const std::optional<uint64_t> hash = ContentHashIndex::Get().GetHash(m_ProjectDirectory / entry.Path))
+			{
+				entry.Hash = *hash;
+				m_NeedsSave = true;
+				m_LastChange = std::chrono::steady_clock::now();
+			}
+		}
+
+		// Hashes are published in one go at the end of a pass, not per batch: nothing on screen shows them.
+		if (m_HashCursor >= m_Entries.size() && m_NeedsSave)
+		{
+			m_EntriesDirty = true;
+		}
+		return true;
+	}
+
+	void AssetIndex::MakeThumbnails(const std::vector<std::string>& paths)
+	{
+		std::vector<uint8_t> thumbnail(static_cast<size_t>(kThumbnailSize) * kThumbnailSize * 4);
+		for (const std::string& path : paths)
+		{
+			if (m_StopRequested)
+			{
+				return;
+			}
+
+			const auto it = m_ByPath.find(path);
+			if (it == m_ByPath.end() || m_ThumbnailFailed.contains(path))
+			{
+				continue;
+			}
+			if (const Entry& entry = m_Entries[it->second];
+			    entry.Type != AssetType::Texture || entry.Thumbnail != kNoThumbnail)
+			{
+				continue;
+			}
+
+			int width = 0;
+			int height = 0;
+			int channels = 0;
+			stbi_uc* pixels = stbi_load((m_ProjectDirectory / path).string().c_str(), &width, &height, &channels, 4);
+			if (!pixels)
+			{
+				m_ThumbnailFailed.insert(path); // e.g. .dds: not something stb decodes
+				continue;
+			}
+			MakeThumbnail(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), thumbnail.data());
+			stbi_image_free(pixels);
+
+			// Slots are handed out round-robin: once the atlas is full, the oldest thumbnail makes room.
+			const uint32_t slot = m_NextSlot;
+			m_NextSlot = (m_NextSlot + 1) % kThumbnailSlots;
+			if (!m_SlotOwners[slot].empty())
+			{
+				if (const auto owner = m_ByPath.find(m_SlotOwners[slot]); owner != m_ByPath.end())
+				{
+					m_Entries[owner->second].Thumbnail = kNoThumbnail;
+				}
+			}
+			m_SlotOwners[slot] = path;
+			m_Entries[it->second].Thumbnail = slot;
+
+			constexpr uint32_t perRow = kAtlasSize / kThumbnailSize;
+			const size_t x = static_cast<size_t>(slot % perRow) * kThumbnailSize;
+			const size_t y = static_cast<size_t>(slot / perRow) * kThumbnailSize;
+			for (uint32_t row = 0; row < kThumbnailSize; ++row)
+			{
+				std::copy_n(thumbnail.data() + static_cast<size_t>(row) * kThumbnailSize * 4, kThumbnailSize * 4,
+				            m_Atlas.data() + ((y + row) * kAtlasSize + x) * 4);
+			}
+
+			m_EntriesDirty = true;
+			m_AtlasDirty = true;
+			m_NeedsSave = true;
+			Interleave();
+		}
+	}
+
+	void AssetIndex::ReleaseThumbnail(Entry& entry)
+	{
+		if (entry.Thumbnail != kNoThumbnail)
+		{
+			m_SlotOwners[entry.Thumbnail].clear();
+			entry.Thumbnail = kNoThumbnail;
+		}
+	}
+
+	void AssetIndex::Publish()
+	{
+		auto snapshot = std::make_shared<Snapshot>();
+		snapshot->Revision = ++m_Revision;
+		snapshot->Entries = m_Entries;
+		std::ranges::sort(snapshot->Entries, [](const Entry& a, const Entry& b)
+		                  {
+			if (a.Type != b.Type) return a.Type < b.Type;
+			if (a.DisplayName != b.DisplayName) return a.DisplayName < b.DisplayName;
+			return a.Path < b.Path; });
+
+		std::vector<uint8_t> atlas;
+		if (m_AtlasDirty)
+		{
+			atlas = m_Atlas;
+		}
+
+		Query query;
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Snapshot = snapshot;
+			if (m_AtlasDirty)
+			{
+				m_PublishedAtlas = std::move(atlas);
+				++m_AtlasRevision;
+			}
+			query = m_Query;
+			m_QueryChanged = false;
+		}
+
+		m_EntriesDirty = false;
+		m_AtlasDirty = false;
+		m_LastPublish = std::chrono::steady_clock::now();
+		m_LastChange = m_LastPublish;
+
+		RunQuery(snapshot, query);
+	}
+
+	void AssetIndex::AnswerQuery()
+	{
+		std::shared_ptr<const Snapshot> snapshot;
+		Query query;
+		{
+			std::lock_guard lock(m_Mutex);
+			if (!m_QueryChanged || !m_Snapshot)
+			{
+				return;
+			}
+			m_QueryChanged = false;
+			snapshot = m_Snapshot;
+			query = m_Query;
+		}
+		RunQuery(snapshot, query);
+	}
+
+	void AssetIndex::Interleave()
+	{
+		if ((m_EntriesDirty || m_AtlasDirty) && std::chrono::steady_clock::now() - m_LastPublish >= kPublishInterval)
+		{
+			Publish();
+		}
+		else
+		{
+			AnswerQuery();
+		}
+	}
+
+	void AssetIndex::RunQuery(const std::shared_ptr<const Snapshot>& snapshot, const Query& query)
+	{
+		auto result = std::make_shared<QueryResult>();
+		result->Source = snapshot;
+		result->Filter = query;
+
+		const std::vector<Entry>& entries = snapshot->Entries;
+		std::string needle;
+		ToLowerInto(query.Text, needle);
+
+		if (needle.empty())
+		{
+			// Snapshot order is (Type, Name), so the unfiltered listing groups naturally: a header row each time
+			// the type changes.
+			result->Rows.reserve(entries.size() + 8);
+			AssetType section = AssetType::None;
+			for (uint32_t i = 0; i < entries.size(); ++i)
+			{
+				const Entry& entry = entries[i];
+				if (query.Type != AssetType::None && entry.Type != query.Type)
+				{
+					continue;
+				}
+				if (query.Type == AssetType::None && entry.Type != section)
+				{
+					section = entry.Type;
+					result->Rows.push_back(QueryResult::kHeaderBit | static_cast<uint32_t>(section));
+				}
+				result->Rows.push_back(i);
+			}
+		}
+		else
+		{
+			std::vector<std::pair<int, uint32_t>> scored;
+			std::string name;
+			for (uint32_t i = 0; i < entries.size(); ++i)
+			{
+				const Entry& entry = entries[i];
+				if (query.Type != AssetType::None && entry.Type != query.Type)
+				{
+					continue;
+				}
+				ToLowerInto(entry.DisplayName, name);
+				if (const int score = FuzzyScore(name, needle); score >= 0)
+				{
+					scored.emplace_back(score, i);
+				}
+			}
+			std::ranges::sort(scored, [](const auto& a, const auto& b)
+			                  {
+				if (a.first != b.first) return a.first > b.first;
+				return a.second < b.second; });
+
+			result->Rows.reserve(scored.size());
+			for (const auto& [score, i] : scored)
+			{
+				result->Rows.push_back(i);
+			}
+		}
+
+		std::lock_guard lock(m_Mutex);
+		m_Result = std::move(result);
+	}
+}
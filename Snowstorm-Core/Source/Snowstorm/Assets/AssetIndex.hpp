@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Snowstorm/Assets/AssetTypes.hpp"
+#include "Snowstorm/Service/Service.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Application-scoped asset database behind the Content Browser. The browser used to walk the whole asset
+	// directory with recursive_directory_iterator on the main thread and rebuild its list from scratch -- a
+	// multi-second freeze on a 200k-file asset repo. Now one worker thread owns the list:
+	//
+	// - It is persistent: the last known state (path, type, size, write time, content hash, registry handle,
+	//   thumbnail slot) is written under Engine/cache and read back on the next Open, so the browser is full
+	//   immediately while the worker re-stats the tree behind it.
+	// - It is incremental: FileWatcher changes (forwarded by ShaderReloadSystem, which owns the drain) update
+	//   only the files they name. A full re-walk happens on Open, on Rescan, and when the watcher lost events.
+	// - Queries run on the worker too: type filter + fuzzy name search, published as a list of rows into an
+	//   immutable snapshot the main thread renders without touching the filesystem.
+	// - Texture thumbnails are decoded on the worker (on request, for the rows on screen) into one CPU atlas,
+	//   cached on disk next to the index; the browser uploads the atlas when it changes.
+	//
+	// Everything the main thread sees is a shared_ptr to something the worker never mutates again, swapped
+	// under a mutex, so reads are a pointer copy. Content hashes go through ContentHashIndex (the same memo
+	// the derived-data cache keys on), filled in idle time after the walk.
+	class AssetIndex final : public Service
+	{
+	public:
+		static constexpr uint32_t kNoThumbnail = UINT32_MAX;
+		static constexpr uint32_t kThumbnailSize = 32; // px, square
+		static constexpr uint32_t kAtlasSize = 1024;   // px, square RGBA8: 32 x 32 thumbnails
+		static constexpr uint32_t kThumbnailSlots = (kAtlasSize / kThumbnailSize) * (kAtlasSize / kThumbnailSize);
+
+		struct Entry
+		{
+			std::string Path;        // generic, relative to the project directory (e.g. assets/meshes/cube.obj)
+			std::string DisplayName; // filename only
+			AssetType Type = AssetType::None;
+			uint64_t Size = 0;
+			uint64_t WriteTime = 0;              // GetFileWriteTimeU64 units (machine-local)
+			uint64_t Hash = 0;                   // XXH64 of the contents; 0 until the worker gets to it
+			uint64_t Handle = 0;                 // registry handle, as last confirmed by the main thread
+			uint32_t Thumbnail = kNoThumbnail;   // atlas slot
+		};
+
+		// An immutable view of the index, sorted by (Type, DisplayName).
+		struct Snapshot
+		{
+			uint64_t Revision = 0;
+			std::vector<Entry> Entries;
+		};
+
+		struct Query
+		{
+			AssetType Type = AssetType::None; // None: every type
+			std::string Text;                 // fuzzy; empty: everything, in snapshot order
+		};
+
+		struct QueryResult
+		{
+			// A row with this bit set is a section header for the AssetType in its low bits (the unfiltered
+			// "All" listing is grouped by type); any other row indexes Source->Entries.
+			static constexpr uint32_t kHeaderBit = 1u << 31;
+
+			std::shared_ptr<const Snapshot> Source;
+			Query Filter;
+			std::vector<uint32_t> Rows; // display order: best match first when searching
+		};
+
+		// A file the main thread should make sure is in the asset registry (AssetManagerSingleton is main-thread
+		// only): every entry once after Open, then each new one. Confirm the handle back with SetHandle.
+		struct RegistryCheck
+		{
+			std::string Path;
+			AssetType Type = AssetType::None;
+			uint64_t Handle = 0; // what the index believes
+		};
+
+		AssetIndex() = default;
+		~AssetIndex() override;
+
+		// Index `assetDirectory` (paths are stored relative to `projectDirectory`), persisted at `indexPath`.
+		// Cheap to call every frame: restarts the worker only when the arguments change (a project switch).
+		void Open(const std::filesystem::path& projectDirectory, const std::filesystem::path& assetDirectory,
+		          const std::filesystem::path& indexPath);
+
+		// Engine/cache/assetindex/<hash of the project directory>.bin: the index is machine-local (write times
+		// don't travel), like ContentHashIndex.
+		static std::filesystem::path DefaultIndexPath(const std::filesystem::path& projectDirectory);
+
+		// Stop the worker and write the index. Also done by the destructor and by Open on a switch.
+		void Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_Thread.joinable(); }
+
+		// Re-walk the whole asset directory (the Rescan button; the watcher lost events).
+		void RequestRescan();
+
+		// Files (or directories) that changed on disk: FileWatcher::MakeKey strings. Paths outside the asset
+		// directory are ignored. `overflowed` means the list is incomplete: re-walk instead.
+		void NotifyChanged(std::span<const std::string> paths, bool overflowed = false);
+
+		// Record the registry handle the main thread resolved for a path (after a RegistryCheck / import).
+		void SetHandle(const std::string& path, uint64_t handle);
+
+		// Decode thumbnails for these (texture) paths, if they don't have one yet.
+		void RequestThumbnails(std::vector<std::string> paths);
+
+		// Replace the live query; its result is republished whenever the index changes.
+		void SetQuery(Query query);
+
+		[[nodiscard]] std::shared_ptr<const Snapshot> GetSnapshot() const;
+		[[nodiscard]] std::shared_ptr<const QueryResult> GetQueryResult() const;
+
+		// Move up to `max` pending registry checks into `out` (appended).
+		void TakeRegistryChecks(std::vector<RegistryCheck>& out, size_t max);
+
+		// If the thumbnail atlas changed since `revision`, copy it into `out` (kAtlasSize^2 RGBA8), update
+		// `revision` and return true.
+		bool CopyThumbnailAtlas(std::vector<uint8_t>& out, uint64_t& revision) const;
+
+		// True while the worker walks the tree (the browser shows "indexing...").
+		[[nodiscard]] bool IsScanning() const;
+
+		// Block until the worker has handled everything requested before the call and published the result.
+		// Tests and tools; the editor never waits on the index.
+		void Sync();
+
+		// Fuzzy match of `query` against `text` (both already lower-case): -1 when some query character doesn't
+		// occur in order; otherwise a score, higher is better. Contiguous runs, matches at the start of a word
+		// and a plain substring hit rank up; skipped characters cost a little.
+		static int FuzzyScore(std::string_view text, std::string_view query);
+
+		// Fit an RGBA8 image into a kThumbnailSize square (box filter, aspect kept, centred on transparent).
+		static void MakeThumbnail(const uint8_t* rgba, uint32_t width, uint32_t height, uint8_t* out);
+
+		// Importable asset type of a lower-case extension (with the dot); None: not an asset.
+		static AssetType TypeFromExtension(std::string_view extension);
+
+	private:
+		enum class CommandType : uint8_t
+		{
+			Rescan,
+			Changed,
+			SetHandle,
+			Thumbnails,
+			Sync
+		};
+
+		struct Command
+		{
+			CommandType Type = CommandType::Rescan;
+			std::vector<std::string> Paths;
+			uint64_t Value = 0; // SetHandle: the handle; Sync: the ticket
+		};
+
+		// --- Worker thread ---
+		void Run();
+		void Load();
+		void Save();
+		bool Walk(const std::filesystem::path& root, bool full); // false: stopped part-way
+		void ApplyChanged(const std::string& key);
+		size_t Upsert(const std::filesystem::path& absolute, AssetType type, uint64_t size, uint64_t writeTime);
+		void Remove(const std::string& path);
+		bool HashSome();
+		void MakeThumbnails(const std::vector<std::string>& paths);
+		void ReleaseThumbnail(Entry& entry);
+		void Publish();
+		void RunQuery(const std::shared_ptr<const Snapshot>& snapshot, const Query& query);
+		void AnswerQuery(); // run the live query against the current snapshot, if it changed
+		void Interleave();  // inside long work (a walk, a thumbnail batch): publish progress, answer queries
+
+		void Post(Command command);
+
+		// Set by Open, read by the worker (it only runs while these are fixed).
+		std::filesystem::path m_ProjectDirectory;
+		std::filesystem::path m_AssetDirectory;
+		std::filesystem::path m_IndexPath;
+		std::string m_AssetKey; // FileWatcher::MakeKey(m_AssetDirectory)
+
+		std::thread m_Thread;
+		std::atomic<bool> m_StopRequested{false}; // polled inside long walks
+
+		// Commands and published results, guarded by m_Mutex.
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_Wake;
+		std::condition_variable m_Synced;
+		std::deque<Command> m_Commands;
+		bool m_Stopping = false;
+		bool m_Scanning = false;
+		uint64_t m_SyncIssued = 0;
+		uint64_t m_SyncDone = 0;
+		Query m_Query;
+		bool m_QueryChanged = false;
+		std::shared_ptr<const Snapshot> m_Snapshot;
+		std::shared_ptr<const QueryResult> m_Result;
+		std::deque<RegistryCheck> m_RegistryChecks;
+		std::vector<uint8_t> m_PublishedAtlas;
+		uint64_t m_AtlasRevision = 0;
+
+		// Owned by the worker thread.
+		std::vector<Entry> m_Entries;                    // unordered; m_ByPath indexes it
+		std::unordered_map<std::string, size_t> m_ByPath;
+		std::unordered_set<std::string> m_Seen;          // paths met by the current full walk
+		std::vector<uint8_t> m_Atlas;
+		std::vector<std::string> m_SlotOwners;           // path holding each atlas slot ("" = free)
+		uint32_t m_NextSlot = 0;                         // oldest-first reuse once the atlas is full
+		std::unordered_set<std::string> m_ThumbnailFailed; // undecodable (e.g. .dds): not retried
+		size_t m_HashCursor = 0;
+		uint64_t m_Revision = 0;
+		std::chrono::steady_clock::time_point m_LastPublish;
+		std::chrono::steady_clock::time_point m_LastChange;
+		bool m_EntriesDirty = false;                     // since the last Publish
+		bool m_AtlasDirty = false;
+		bool m_NeedsSave = false;
+	};
+}
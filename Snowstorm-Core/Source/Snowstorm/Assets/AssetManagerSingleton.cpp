@@ -1,15 +1,18 @@
 #include "AssetManagerSingleton.hpp"
 
-#include "AssetFileTime.hpp"
+#include "ContentHashIndex.hpp"
 #include "MeshBoundsBuilder.hpp"
 #include "MeshMetaCache.hpp"
 #include "Snowstorm/Core/Application.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
 #include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Events/DeferredEvents.hpp"
 #include "Snowstorm/Service/ServiceManager.hpp"
 #include "Snowstorm/World/World.hpp"
 #include "Snowstorm/World/Entity.hpp"
 #include "Snowstorm/Render/MeshLibrary.hpp"
+#include "Snowstorm/Render/PipelinePrewarmList.hpp"
 #include "Snowstorm/Render/Shader.hpp"
 #include "Snowstorm/Render/Texture.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
@@ -351,6 +354,141 @@ namespace Snowstorm
 		return nullptr;
 	}
 
+	void AssetManagerSingleton::AcquireAssetReferences(const std::span<const AssetHandle> handles)
+	{
+		for (const AssetHandle handle : handles)
+		{
+			if (handle == 0 || m_AssetRefCounts[handle.Value()]++ > 0)
+			{
+				continue;
+			}
+
+			// First reference to a material: its textures become counted too, so the last cell using the
+			// material takes them down with it. Read from the .ssmat rather than the cached instance, which
+			// may not exist yet (MaterialResolveSystem builds it later).
+			const AssetMetadata* meta = m_Registry.GetMetadata(handle);
+			if (!meta || meta->Type != AssetType::Material || !Project::GetActive())
+			{
+				continue;
+			}
+			MaterialAsset matAsset{};
+			if (!MaterialAssetIO::Load(ResolveAssetPath(meta->Path), matAsset))
+			{
+				continue;
+			}
+			std::vector<AssetHandle> textures;
+			for (const AssetHandle texture : {matAsset.AlbedoTexture, matAsset.NormalTexture, matAsset.MetallicRoughnessTexture,
+			                                  matAsset.AOTexture, matAsset.EmissiveTexture})
+			{
+				if (texture != 0)
+				{
+					textures.push_back(texture);
+				}
+			}
+			AcquireAssetReferences(textures);
+			m_MaterialTextureRefs[handle.Value()] = std::move(textures);
+		}
+	}
+
+	void AssetManagerSingleton::ReleaseAssetReferences(const std::span<const AssetHandle> handles)
+	{
+		for (const AssetHandle handle : handles)
+		{
+			const auto it = m_AssetRefCounts.find(handle.Value());
+			if (it == m_AssetRefCounts.end())
+			{
+				continue; // never acquired (or handle 0)
+			}
+			if (--it->second == 0)
+			{
+				m_AssetRefCounts.erase(it);
+				EvictAsset(handle);
+			}
+		}
+	}
+
+	uint32_t AssetManagerSingleton::GetAssetReferenceCount(const AssetHandle handle) const
+	{
+		const auto it = m_AssetRefCounts.find(handle.Value());
+		return it != m_AssetRefCounts.end() ? it->second : 0;
+	}
+
+	void AssetManagerSingleton::EvictAsset(const AssetHandle handle)
+	{
+		const AssetMetadata* meta = m_Registry.GetMetadata(handle);
+		if (!meta)
+		{
+			return;
+		}
+
+		const uint32_t retireFrames = Renderer::GetFramesInFlight() + 1;
+		switch (meta->Type)
+		{
+		case AssetType::Mesh:
+		{
+			if (const auto it = m_MeshCache.find(handle.Value()); it != m_MeshCache.end())
+			{
+				m_RetiredAssets.push_back({.MeshResource = it->second, .FramesLeft = retireFrames});
+				m_MeshCache.erase(it);
+			}
+			if (m_InFlightMeshes.contains(handle.Value()))
+			{
+				m_DiscardedMeshLoads.insert(handle.Value());
+			}
+			break;
+		}
+		case AssetType::Material:
+		{
+			if (const auto it = m_MaterialInstanceCache.find(handle.Value()); it != m_MaterialInstanceCache.end())
+			{
+				m_RetiredAssets.push_back({.MaterialResource = it->second, .FramesLeft = retireFrames});
+				m_MaterialInstanceCache.erase(it);
+			}
+			if (const auto it = m_MaterialTextureRefs.find(handle.Value()); it != m_MaterialTextureRefs.end())
+			{
+				const std::vector<AssetHandle> textures = std::move(it->second);
+				m_MaterialTextureRefs.erase(it);
+				ReleaseAssetReferences(textures);
+			}
+			break;
+		}
+		case AssetType::Texture:
+		{
+			for (const bool srgb : {true, false})
+			{
+				auto& cache = srgb ? m_TextureViewCache : m_TextureViewCacheLinear;
+				const uint64_t key = handle.Value() ^ (srgb ? 0x1ULL : 0x0ULL) << 63;
+
+				// A decode still in flight now lands stale (generation mismatch) and is dropped.
+				if (m_InFlightTextures.erase(key))
+				{
+					++m_TextureGenerations[key];
+				}
+
+				const auto cached = cache.find(handle.Value());
+				Ref<Texture> image;
+				if (const auto resident = m_ResidentTextures.find(key); resident != m_ResidentTextures.end())
+				{
+					image = std::move(resident->second);
+					m_ResidentTextures.erase(resident);
+				}
+				if (cached != cache.end())
+				{
+					if (cached->second)
+					{
+						m_PlaceholderSlots.erase(cached->second->GetGlobalBindlessIndex());
+					}
+					m_RetiredTextures.push_back({image, cached->second, retireFrames});
+					cache.erase(cached);
+				}
+			}
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
 	Ref<Mesh> AssetManagerSingleton::GetMesh(const AssetHandle handle)
 	{
 		if (handle == 0)
@@ -371,14 +509,14 @@ namespace Snowstorm
 		// operate on the right file and part. A plain mesh has SubmeshIndex == -1 (whole file).
 		const SubmeshRef sub = ParseSubmeshPath(meta->Path.string());
 		const std::filesystem::path filePath = ResolveAssetPath(sub.FilePath);
-		const uint64_t sourceTime = GetFileWriteTimeU64(filePath);
+		const uint64_t sourceHash = ContentHashIndex::Get().GetHash(filePath).value_or(0);
 
 		MeshBounds bounds{};
 		bool haveBounds = false;
 
 		if (auto cached = MeshMetaCacheIO::Load(handle))
 		{
-			if (cached->SourceWriteTime == sourceTime && !cached->SourcePath.empty())
+			if (sourceHash != 0 && cached->SourceHash == sourceHash && !cached->SourcePath.empty())
 			{
 				bounds = cached->Bounds;
 				haveBounds = true;
@@ -392,7 +530,7 @@ namespace Snowstorm
 				MeshMetaCache out{};
 				out.Handle = handle;
 				out.SourcePath = filePath;
-				out.SourceWriteTime = sourceTime;
+				out.SourceHash = sourceHash;
 				out.Bounds = bounds;
 				(void)MeshMetaCacheIO::Save(out);
 				haveBounds = true;
@@ -404,7 +542,7 @@ namespace Snowstorm
 		// source file at most once total, not once per part. Whole-file loads keep the plain path (they
 		// flatten every submesh and aren't the startup hot spot).
 		Ref<Mesh> mesh = (sub.SubmeshIndex >= 0)
-		                     ? meshLib.LoadCached(filePath.string(), sub.SubmeshIndex, handle)
+		                     ? meshLib.LoadCached(filePath.string(), sub.SubmeshIndex)
 		                     : meshLib.Load(filePath.string());
 
 		if (mesh && haveBounds)
@@ -437,9 +575,11 @@ namespace Snowstorm
 			return it->second;
 		}
 
-		// Already being loaded -> nothing to do, caller retries next frame.
+		// Already being loaded -> nothing to do, caller retries next frame. (Wanted again after an eviction:
+		// keep the result after all.)
 		if (m_InFlightMeshes.contains(handle))
 		{
+			m_DiscardedMeshLoads.erase(handle.Value());
 			return nullptr;
 		}
 
@@ -462,7 +602,7 @@ namespace Snowstorm
 		// main thread. Capture by value (handle, paths) — the singleton outlives the app's JobSystem, which
 		// is joined at shutdown before this singleton is destroyed, so `this` stays valid for the job.
 		m_InFlightMeshes.insert(handle);
-		++m_PendingTotal;
+		CountPendingLoad();
 
 		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
 		auto& meshLib = Application::Get().GetServiceManager().GetService<MeshLibrary>();
@@ -479,12 +619,37 @@ namespace Snowstorm
 
 			// CPU-only work on the worker: read the cooked blob or parse+cook the source. No GPU, no
 			// m_MeshCache/m_Meshes access (those are main-thread-only).
-			if (auto cooked = meshLib.LoadCookedCPU(filePath, submeshIndex, handle))
+			if (auto cooked = meshLib.LoadCookedCPU(filePath, submeshIndex))
 			{
 				done.Cooked = std::move(*cooked);
 				done.Success = true;
+
+				// Bounds are part of the per-submesh cook, so they run here in parallel with the other parts
+				// instead of serially on the main thread at finalize. Prefer the disk-cached sidecar, but ALWAYS
+				// fall back to computing from the cooked vertices we already have in hand: on a cold load the
+				// .json sidecar may not exist yet, and a mesh left with default zero bounds gets frustum-culled
+				// the moment the camera moves off-center (the "Sponza disappears" bug). Persist so later loads
+				// hit the sidecar. The hash is a map lookup here (the cook just indexed it).
+				const uint64_t sourceHash = ContentHashIndex::Get().GetHash(filePath).value_or(0);
+				if (auto cachedMeta = MeshMetaCacheIO::Load(handle); cachedMeta && sourceHash != 0 && cachedMeta->SourceHash == sourceHash)
+				{
+					done.Bounds = cachedMeta->Bounds;
+					done.HaveBounds = true;
+				}
+				else if (ComputeMeshBoundsFromVertices(done.Cooked.Vertices, done.Bounds))
+				{
+					done.HaveBounds = true;
+					MeshMetaCache out{};
+					out.Handle = handle;
+					out.SourcePath = filePath;
+					out.SourceHash = sourceHash;
+					out.Bounds = done.Bounds;
+					(void)MeshMetaCacheIO::Save(out);
+				}
 			}
 
+			Application::PostEvent(AssetDecodedEvent{handle.Value(), AssetType::Mesh, done.Success});
+
 			std::lock_guard lock(m_CompletedMutex);
 			m_CompletedMeshes.push_back(std::move(done)); });
 
@@ -493,6 +658,22 @@ namespace Snowstorm
 
 	void AssetManagerSingleton::ProcessCompletedLoads()
 	{
+		PumpPipelinePrewarm();
+
+		// Age out textures replaced by earlier uploads once no in-flight frame can still sample them.
+		for (RetiredTexture& retired : m_RetiredTextures)
+		{
+			--retired.FramesLeft;
+		}
+		std::erase_if(m_RetiredTextures, [](const RetiredTexture& r)
+		              { return r.FramesLeft == 0; });
+		for (RetiredAsset& retired : m_RetiredAssets)
+		{
+			--retired.FramesLeft;
+		}
+		std::erase_if(m_RetiredAssets, [](const RetiredAsset& r)
+		              { return r.FramesLeft == 0; });
+
 		// Move both completed batches out under the lock, then do the GPU work unlocked (workers keep producing).
 		std::vector<CompletedMeshLoad> meshBatch;
 		std::vector<CompletedTextureLoad> texBatch;
@@ -515,10 +696,15 @@ namespace Snowstorm
 			{
 				CompletedMeshLoad& done = meshBatch[meshDone];
 				m_InFlightMeshes.erase(done.Handle.Value());
+				if (m_DiscardedMeshLoads.erase(done.Handle.Value()))
+				{
+					continue; // its last residency reference went while it loaded
+				}
 
 				if (!done.Success)
 				{
 					SS_CORE_ERROR("Async mesh load failed for handle {}", done.Handle.Value());
+					Application::PostEvent(AssetLoadedEvent{done.Handle.Value(), AssetType::Mesh, false});
 					continue;
 				}
 
@@ -526,35 +712,13 @@ namespace Snowstorm
 				Ref<Mesh> mesh = meshLib.FinalizeCooked(done.FilePath, done.SubmeshIndex, done.Cooked);
 				if (mesh)
 				{
-					// Bounds: prefer the disk-cached sidecar, but ALWAYS fall back to computing from the
-					// cooked vertices we already have in hand. This fallback is essential and was missing:
-					// on a cold load the .json sidecar may not exist yet, so without it the mesh kept its
-					// default zero bounds and got frustum-culled the moment the camera moved off-center
-					// (the "Sponza disappears" bug). Computing from the cooked verts is cheap, needs no
-					// Assimp, and works cold; persist it so later loads hit the sidecar.
-					MeshBounds bounds{};
-					bool haveBounds = false;
-					if (auto cachedMeta = MeshMetaCacheIO::Load(done.Handle))
+					if (done.HaveBounds)
 					{
-						bounds = cachedMeta->Bounds;
-						haveBounds = true;
-					}
-					else if (ComputeMeshBoundsFromVertices(done.Cooked.Vertices, bounds))
-					{
-						haveBounds = true;
-						MeshMetaCache out{};
-						out.Handle = done.Handle;
-						out.SourcePath = done.FilePath;
-						out.SourceWriteTime = GetFileWriteTimeU64(done.FilePath);
-						out.Bounds = bounds;
-						(void)MeshMetaCacheIO::Save(out);
-					}
-					if (haveBounds)
-					{
-						mesh->SetBounds(bounds);
+						mesh->SetBounds(done.Bounds);
 					}
 					m_MeshCache[done.Handle.Value()] = mesh;
 				}
+				Application::PostEvent(AssetLoadedEvent{done.Handle.Value(), AssetType::Mesh, mesh != nullptr});
 			}
 		}
 
@@ -580,11 +744,16 @@ namespace Snowstorm
 		for (; texDone < texBatch.size() && texDone < kMaxTextureFinalizePerFrame; ++texDone)
 		{
 			CompletedTextureLoad& done = texBatch[texDone];
+			if (done.Generation != m_TextureGenerations[done.Key])
+			{
+				continue; // overtaken by a newer reload of the same key, which still owns the in-flight entry
+			}
 			m_InFlightTextures.erase(done.Key);
 
 			if (!done.Success)
 			{
 				SS_CORE_ERROR("Async texture load failed for handle {} (slot stays placeholder)", done.Handle.Value());
+				Application::PostEvent(AssetLoadedEvent{done.Handle.Value(), AssetType::Texture, false});
 				continue;
 			}
 
@@ -594,6 +763,7 @@ namespace Snowstorm
 			Ref<Texture> real = Texture::CreateFromPixels(done.Cooked, done.Srgb, done.DebugName);
 			if (!real)
 			{
+				Application::PostEvent(AssetLoadedEvent{done.Handle.Value(), AssetType::Texture, false});
 				continue;
 			}
 			Ref<TextureView> realView = TextureView::Create(real, MakeFullViewDesc(real->GetDesc()));
@@ -608,11 +778,21 @@ namespace Snowstorm
 			// the 10k budget; #follow-up.)
 			realView->SetGlobalBindlessIndex(done.Slot);
 
-			m_ResidentTextures[done.Key] = real;
+			// The image (and view) this replaces — the placeholder view on a first load, the previous real texture
+			// on a hot reload — may still be sampled by frames in flight, so retire rather than destroy it.
+			Ref<Texture>& resident = m_ResidentTextures[done.Key];
+			Ref<TextureView>& cached = (done.Srgb ? m_TextureViewCache : m_TextureViewCacheLinear)[done.Handle.Value()];
+			if (resident || cached)
+			{
+				m_RetiredTextures.push_back({resident, cached, Renderer::GetFramesInFlight() + 1});
+			}
+
+			resident = real;
 			m_PlaceholderSlots.erase(done.Slot); // real pixels are in the slot now -> resident (a failed load kept it)
 			// Swap the cache entry from the placeholder view to the real view so a later GetTextureView(Async)
 			// returns the real one. Both share slot `done.Slot` on the GPU now.
-			(done.Srgb ? m_TextureViewCache : m_TextureViewCacheLinear)[done.Handle.Value()] = realView;
+			cached = realView;
+			Application::PostEvent(AssetLoadedEvent{done.Handle.Value(), AssetType::Texture, true});
 		}
 
 		// Re-queue the textures we didn't finalize this frame (they stay in-flight; PendingLoadCount still
@@ -630,10 +810,26 @@ namespace Snowstorm
 		// progress high-water mark for the next load burst.
 		if (m_InFlightMeshes.empty() && m_InFlightTextures.empty())
 		{
+			// End of a load burst: persist any newly-hashed sources so the next startup skips rehashing them.
+			if (m_PendingTotal > 0)
+			{
+				(void)ContentHashIndex::Get().Flush();
+				// Every submesh job of the burst has finished, so the retained Assimp scenes have no readers.
+				Application::Get().GetServiceManager().GetService<MeshLibrary>().ReleaseParsedFiles();
+				Application::PostEvent(AssetLoadsSettledEvent{m_PendingTotal});
+			}
 			m_PendingTotal = 0;
 		}
 	}
 
+	void AssetManagerSingleton::CountPendingLoad()
+	{
+		if (m_PendingTotal++ == 0)
+		{
+			Application::PostEvent(AssetLoadsStartedEvent{});
+		}
+	}
+
 	uint32_t AssetManagerSingleton::PendingLoadCount() const
 	{
 		// Both meshes and textures still loading OR waiting for GPU finalize. (Textures re-queued past the
@@ -753,35 +949,123 @@ namespace Snowstorm
 			return placeholder;
 		}
 		m_InFlightTextures.insert(key);
-		++m_PendingTotal;
+		CountPendingLoad();
 
-		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
-		const std::string path = ResolveAssetPath(meta->Path).string();
-		const std::string debugName = meta->Path.filename().string();
-		const uint64_t sourceTime = GetFileWriteTimeU64(path);
 		const uint32_t slot = placeholder->GetGlobalBindlessIndex();
 		m_PlaceholderSlots.insert(slot); // slot now shows the placeholder; cleared when the real image is uploaded
 
-		(void)jobs.Submit([this, key, handle, srgb, slot, path, sourceTime, debugName]()
+		SubmitTextureDecode(key, handle, srgb, slot, ResolveAssetPath(meta->Path).string(), meta->Path.filename().string());
+
+		return placeholder;
+	}
+
+	void AssetManagerSingleton::SubmitTextureDecode(const uint64_t key, const AssetHandle handle, const bool srgb, const uint32_t slot,
+	                                                const std::string& path, const std::string& debugName)
+	{
+		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
+		const uint32_t generation = m_TextureGenerations[key];
+
+		(void)jobs.Submit([this, key, handle, srgb, slot, generation, path, debugName]()
 		                  {
 			CompletedTextureLoad done;
 			done.Key = key;
 			done.Handle = handle;
 			done.Srgb = srgb;
 			done.Slot = slot;
+			done.Generation = generation;
 			done.DebugName = debugName;
 
 			// CPU-only on the worker: cooked-blob read or stb decode (+ cache write). No GPU.
-			if (auto cooked = Texture::DecodeCPU(path, handle, sourceTime))
+			if (auto cooked = Texture::DecodeCPU(path))
 			{
 				done.Cooked = std::move(*cooked);
 				done.Success = true;
 			}
 
+			Application::PostEvent(AssetDecodedEvent{handle.Value(), AssetType::Texture, done.Success});
+
 			std::lock_guard lock(m_CompletedMutex);
 			m_CompletedTextures.push_back(std::move(done)); });
+	}
 
-		return placeholder;
+	void AssetManagerSingleton::ReloadTexture(const AssetHandle handle)
+	{
+		const AssetMetadata* meta = ResolveMetaOrWarn(handle, AssetType::Texture, "texture");
+		if (!meta)
+		{
+			return;
+		}
+
+		for (const bool srgb : {true, false})
+		{
+			const auto& cache = srgb ? m_TextureViewCache : m_TextureViewCacheLinear;
+			const auto it = cache.find(handle);
+			if (it == cache.end() || !it->second)
+			{
+				continue; // never requested in this color space
+			}
+
+			const uint64_t key = handle.Value() ^ (srgb ? 0x1ULL : 0x0ULL) << 63;
+			++m_TextureGenerations[key]; // any decode still in flight for this key now lands as stale
+			if (m_InFlightTextures.insert(key).second)
+			{
+				CountPendingLoad();
+			}
+
+			// Reuse the slot materials already baked; the old pixels stay visible until the new ones land.
+			SubmitTextureDecode(key, handle, srgb, it->second->GetGlobalBindlessIndex(), ResolveAssetPath(meta->Path).string(),
+			                    meta->Path.filename().string());
+		}
+	}
+
+	void AssetManagerSingleton::OnSourceFilesChanged(const std::vector<std::string>& changedFiles)
+	{
+		// Registry paths are project-relative; without an active project only absolute entries could resolve,
+		// and ResolveAssetPath would (rightly) complain about every other one.
+		if (changedFiles.empty() || !Project::GetActive())
+		{
+			return;
+		}
+
+		const std::unordered_set<std::string> changed(changedFiles.begin(), changedFiles.end());
+		std::vector<AssetHandle> textures;
+		std::vector<AssetHandle> materials;
+		m_Registry.Iterate([&](const AssetMetadata& meta)
+		                   {
+			if (meta.Type != AssetType::Texture && meta.Type != AssetType::Material)
+			{
+				return;
+			}
+			if (!changed.contains(FileWatcher::MakeKey(ResolveAssetPath(meta.Path))))
+			{
+				return;
+			}
+			(meta.Type == AssetType::Texture ? textures : materials).push_back(meta.Handle); });
+
+		for (const AssetHandle handle : textures)
+		{
+			SS_CORE_INFO("Texture hot reload: {}", m_Registry.GetMetadata(handle)->Path.string());
+			ReloadTexture(handle);
+		}
+
+		if (materials.empty())
+		{
+			return;
+		}
+		for (const AssetHandle handle : materials)
+		{
+			SS_CORE_INFO("Material hot reload: {}", m_Registry.GetMetadata(handle)->Path.string());
+			ReloadMaterial(handle);
+		}
+		// Same touch the material inspector does after a save: MaterialResolveSystem re-pulls Changed entities.
+		auto& reg = m_World->GetRegistry();
+		for (const entt::entity e : reg.view<MaterialComponent>())
+		{
+			if (std::ranges::find(materials, reg.Read<MaterialComponent>(e).Material) != materials.end())
+			{
+				(void)reg.Write<MaterialComponent>(e);
+			}
+		}
 	}
 
 	Ref<Pipeline> AssetManagerSingleton::GetOrCreatePipeline(const std::string& fragmentShaderPath)
@@ -791,7 +1075,11 @@ namespace Snowstorm
 		// All mesh materials share the standard mesh vertex stage; only the fragment differs.
 		const std::string fragPath = fragmentShaderPath.empty() ? kDefaultFragmentShader : fragmentShaderPath;
 		if (auto it = m_PipelineCache.find(fragPath); it != m_PipelineCache.end())
-			return it->second;
+		{
+			// Cached but still compiling on a worker (first build, or a live-MSAA rebuild) -> not usable yet,
+			// the material stays unresolved for another frame exactly as with an unready shader.
+			return it->second->IsReady() ? it->second : nullptr;
+		}
 
 		auto& shaderLib = Application::Get().GetServiceManager().GetService<ShaderLibrary>();
 		Ref<Shader> shader = shaderLib.Load("Engine/Shaders/Mesh.vert.hlsl", fragPath);
@@ -845,9 +1133,51 @@ namespace Snowstorm
 		// legible without the engine hardcoding any shader name.
 		p.DebugName = std::filesystem::path(fragPath).stem().string() + "Pipeline(Asset)";
 
-		Ref<Pipeline> pipeline = Pipeline::Create(p);
+		// The driver compile runs on a worker against the persistent VkPipelineCache; cache the pending
+		// pipeline now so later frames poll it instead of starting a second compile.
+		Ref<Pipeline> pipeline = Pipeline::CreateAsync(p);
 		m_PipelineCache[fragPath] = pipeline;
-		return pipeline;
+
+		// Remember it for the next session's pre-warm (a new shader is a rare event, so save right away).
+		LoadPrewarmList(); // never overwrite last session's list before it was read
+		if (std::ranges::find(m_PrewarmRecorded, fragPath) == m_PrewarmRecorded.end())
+		{
+			m_PrewarmRecorded.push_back(fragPath);
+			(void)PipelinePrewarmListIO::Save(PipelinePrewarmListIO::GetDefaultPath(), m_PrewarmRecorded);
+		}
+
+		return pipeline->IsReady() ? pipeline : nullptr;
+	}
+
+	void AssetManagerSingleton::LoadPrewarmList()
+	{
+		if (m_PrewarmLoaded)
+		{
+			return;
+		}
+		m_PrewarmLoaded = true;
+		m_PrewarmRecorded = PipelinePrewarmListIO::Load(PipelinePrewarmListIO::GetDefaultPath());
+		for (const std::string& frag : m_PrewarmRecorded)
+		{
+			// A shader deleted since it was recorded would make ShaderLibrary::Load throw on its stat.
+			std::error_code ec;
+			if (std::filesystem::exists(frag, ec))
+			{
+				m_PrewarmQueue.push_back(frag);
+			}
+		}
+	}
+
+	void AssetManagerSingleton::PumpPipelinePrewarm()
+	{
+		LoadPrewarmList();
+
+		// GetOrCreatePipeline kicks the (async) shader compile, then the (async) pipeline compile once the
+		// SPIR-V is ready; an entry is done as soon as its pipeline exists, ready or not.
+		std::erase_if(m_PrewarmQueue, [this](const std::string& frag)
+		              {
+			(void)GetOrCreatePipeline(frag);
+			return m_PipelineCache.contains(frag); });
 	}
 
 	Ref<MaterialInstance> AssetManagerSingleton::CreateMaterialInstanceUnique(AssetHandle handle)
@@ -935,11 +1265,26 @@ namespace Snowstorm
 		// object no-ops when its sample count already matches, so this is cheap when nothing changed. Only the
 		// scene-target pipelines live here; the sky pipeline self-heals in SkyPass::EnsurePipeline, and post/
 		// G-buffer/velocity pipelines stay single-sample (never in this cache).
+		// SetSampleCount recompiles on a worker, so N materials rebuild in parallel (and mostly from the
+		// pipeline cache on a repeat toggle) while batches using a not-yet-ready pipeline are skipped.
+		const uint32_t s = samples == 0 ? 1 : samples;
+		const bool anyChanged = std::ranges::any_of(m_PipelineCache, [s](const auto& entry)
+		{
+			return entry.second && entry.second->GetDesc().SampleCount != s;
+		});
+		if (!anyChanged)
+		{
+			return;
+		}
+
+		// SetSampleCount destroys the old VkPipeline on the spot, and in-flight command buffers may still
+		// reference it. Drain once here for the whole set rather than once per pipeline.
+		Renderer::WaitIdle();
 		for (auto& [path, pipeline] : m_PipelineCache)
 		{
 			if (pipeline)
 			{
-				pipeline->SetSampleCount(samples);
+				pipeline->SetSampleCount(s);
 			}
 		}
 	}
@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <functional>
 #include <mutex>
+#include <span>
 #include <vector>
 
 namespace Snowstorm
@@ -97,12 +98,31 @@ namespace Snowstorm
 		// re-pulls the fresh instance. No-op if the handle was never resolved/cached.
 		void ReloadMaterial(AssetHandle handle);
 
+		// Re-decode a texture from disk into the bindless slot(s) it already occupies (both color spaces it was
+		// requested in). Materials keep their baked slot index; the new pixels swap in when the async decode
+		// lands in ProcessCompletedLoads. No-op if the handle was never resolved.
+		void ReloadTexture(AssetHandle handle);
+
+		// FileWatcher hook (driven by ShaderReloadSystem): reload every registered texture / material whose
+		// source is among `changedFiles` (FileWatcher::MakeKey form), and mark the entities using a reloaded
+		// material Changed so MaterialResolveSystem re-pulls it — the same seam the editor's inspector uses.
+		void OnSourceFilesChanged(const std::vector<std::string>& changedFiles);
+
 		// Live MSAA: rebuild every cached scene-material pipeline in place at the new sample count. Material
 		// instances hold a Ref to the same Pipeline object, so the in-place swap reaches them with no cache
 		// eviction or re-resolution. Called (with the GPU drained) when render.msaa changes, alongside the scene
 		// target reallocation, so pipelines and targets agree on the sample count. No-op if nothing is cached.
 		void RebuildPipelinesForSampleCount(uint32_t samples);
 
+		// Residency refcounts (level streaming). Each handle in `handles` gains / loses one reference; when a
+		// handle's last reference is released its cached GPU resource is evicted (held for the frames-in-flight
+		// window first), and an async load still in flight for it is dropped on arrival. Acquiring a material
+		// also acquires the textures its .ssmat names, so they go with it. Only counted handles are ever evicted
+		// this way: anything the streaming system never acquired stays cached for the session, as before.
+		void AcquireAssetReferences(std::span<const AssetHandle> handles);
+		void ReleaseAssetReferences(std::span<const AssetHandle> handles);
+		[[nodiscard]] uint32_t GetAssetReferenceCount(AssetHandle handle) const;
+
 		const AssetMetadata* GetMetadata(AssetHandle handle) const { return m_Registry.GetMetadata(handle); }
 
 		// Visit every registered asset (editor UI: asset picker, content browser).
@@ -112,8 +132,14 @@ namespace Snowstorm
 		AssetHandle FindHandle(const std::filesystem::path& path, const AssetType type) const { return m_Registry.FindHandleByPath(path, type); }
 
 	private:
+		// Returns null until the (asynchronously compiled) pipeline is ready; callers retry next frame.
 		Ref<Pipeline> GetOrCreatePipeline(const std::string& fragmentShaderPath);
 
+		// Start compiling last session's material pipelines (PipelinePrewarmList) before any material asks for
+		// them. Loads the list on first call; each frame re-polls entries whose shader is still compiling.
+		void PumpPipelinePrewarm();
+		void LoadPrewarmList(); // idempotent; fills m_PrewarmRecorded + m_PrewarmQueue from disk
+
 		// Copy a loaded MaterialAsset's colors/factors/maps onto a base Material (shared by the cached
 		// and unique material-instance paths). Resolves each texture handle in the correct color space.
 		void ApplyMaterialAsset(Material& base, const MaterialAsset& matAsset);
@@ -123,7 +149,13 @@ namespace Snowstorm
 		// classic "registry stale/missing" failure and otherwise fails silently (nothing renders).
 		const AssetMetadata* ResolveMetaOrWarn(AssetHandle handle, AssetType expected, const char* what);
 
+		// Drop a handle's cached resources after its last residency reference went (see ReleaseAssetReferences).
+		void EvictAsset(AssetHandle handle);
+
 	private:
+		// Count one more in-flight load toward PendingLoadTotal; the first of a burst posts AssetLoadsStartedEvent.
+		void CountPendingLoad();
+
 		AssetRegistry m_Registry;
 
 		std::unordered_set<uint64_t> m_WarnedHandles;
@@ -138,6 +170,9 @@ namespace Snowstorm
 		std::unordered_map<uint64_t, Ref<MaterialInstance>> m_MaterialInstanceCache;
 
 		std::unordered_map<std::string, Ref<Pipeline>> m_PipelineCache; // key = fragment-shader path
+		std::vector<std::string> m_PrewarmQueue;    // recorded shaders whose pipeline hasn't been created yet
+		std::vector<std::string> m_PrewarmRecorded; // every material shader seen (persisted, first-use order)
+		bool m_PrewarmLoaded = false;
 
 		// --- Async mesh loading (#84) ---
 		// A worker-completed CPU load waiting for main-thread GPU finalize.
@@ -147,6 +182,8 @@ namespace Snowstorm
 			std::string FilePath;
 			int SubmeshIndex = -1;
 			CookedMesh Cooked; // empty on load failure (still drained so the handle stops being in-flight)
+			MeshBounds Bounds; // cooked on the worker alongside the vertices (sidecar hit or computed)
+			bool HaveBounds = false;
 			bool Success = false;
 		};
 
@@ -169,6 +206,7 @@ namespace Snowstorm
 			AssetHandle Handle{};
 			bool Srgb = true;
 			uint32_t Slot = 0; // the stable bindless slot the placeholder view occupies
+			uint32_t Generation = 0;
 			CookedTexture Cooked;
 			bool Success = false;
 			std::string DebugName;
@@ -187,9 +225,46 @@ namespace Snowstorm
 
 		Ref<TextureView> EnsurePlaceholderView(const std::string& debugName);
 
+		// Submit the worker decode whose result ProcessCompletedLoads uploads into `slot`. Shared by the first
+		// async load and hot reload. Stamped with the key's current generation (see m_TextureGenerations).
+		void SubmitTextureDecode(uint64_t key, AssetHandle handle, bool srgb, uint32_t slot, const std::string& path,
+		                         const std::string& debugName);
+
+		// Bumped per (handle,srgb) key on every reload. A decode that completes with an older generation was
+		// overtaken by a newer edit and is dropped, so out-of-order completions never leave stale pixels.
+		std::unordered_map<uint64_t, uint32_t> m_TextureGenerations;
+
+		// Textures + views replaced by a reload (or the placeholder view swapped out on first load). Frames
+		// already submitted may still sample them and Vulkan objects are destroyed on release, so they are held
+		// for the frames-in-flight window before being dropped.
+		struct RetiredTexture
+		{
+			Ref<Texture> Image;
+			Ref<TextureView> View;
+			uint32_t FramesLeft = 0;
+		};
+		std::vector<RetiredTexture> m_RetiredTextures;
+
 		// Bindless slots still showing the magenta placeholder (real pixels not uploaded yet). A slot is added
 		// when its placeholder view is created and removed when ProcessCompletedLoads repoints it to the real
 		// image. Main-thread-only (like the caches above), so no lock. Backs IsTextureSlotResident.
 		std::unordered_set<uint32_t> m_PlaceholderSlots;
+
+		// --- Residency refcounts (level streaming) ---
+		std::unordered_map<uint64_t, uint32_t> m_AssetRefCounts;
+		// Textures each counted material acquired (from its .ssmat), released with the material.
+		std::unordered_map<uint64_t, std::vector<AssetHandle>> m_MaterialTextureRefs;
+		// Meshes evicted while their async load was in flight: the completion is dropped instead of cached.
+		std::unordered_set<uint64_t> m_DiscardedMeshLoads;
+
+		// Meshes / material instances evicted from the caches, held for the frames-in-flight window like
+		// m_RetiredTextures (a frame already submitted may still draw them).
+		struct RetiredAsset
+		{
+			Ref<Mesh> MeshResource;
+			Ref<MaterialInstance> MaterialResource;
+			uint32_t FramesLeft = 0;
+		};
+		std::vector<RetiredAsset> m_RetiredAssets;
 	};
 }
\ No newline at end of file
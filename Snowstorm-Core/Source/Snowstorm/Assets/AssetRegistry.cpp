@@ -25,11 +25,17 @@ namespace Snowstorm
 			                       { return static_cast<char>(std::tolower(c)); });
 			return s;
 		}
+
+		std::string LookupKey(const std::filesystem::path& p, const AssetType type)
+		{
+			return PathKey(p) + '|' + std::to_string(static_cast<uint32_t>(type));
+		}
 	}
 
 	bool AssetRegistry::LoadFromFile(const std::filesystem::path& filePath)
 	{
 		m_Metadata.clear();
+		m_ByPath.clear();
 
 		std::ifstream in(filePath);
 		if (!in.is_open())
@@ -62,6 +68,7 @@ namespace Snowstorm
 				continue;
 			}
 
+			m_ByPath.emplace(LookupKey(m.Path, m.Type), m.Handle);
 			m_Metadata[m.Handle] = std::move(m);
 		}
 
@@ -92,17 +99,8 @@ namespace Snowstorm
 
 	AssetHandle AssetRegistry::FindHandleByPath(const std::filesystem::path& assetPath, const AssetType type) const
 	{
-		const std::string key = PathKey(assetPath);
-
-		for (const auto& m : m_Metadata | std::views::values)
-		{
-			if (m.Type == type && PathKey(m.Path) == key)
-			{
-				return m.Handle;
-			}
-		}
-
-		return AssetHandle{0};
+		const auto it = m_ByPath.find(LookupKey(assetPath, type));
+		return it != m_ByPath.end() ? it->second : AssetHandle{0};
 	}
 
 	AssetHandle AssetRegistry::Import(const std::filesystem::path& assetPath, const AssetType type)
@@ -117,6 +115,7 @@ namespace Snowstorm
 		m.Type = type;
 		m.Path = NormalizePath(assetPath);
 
+		m_ByPath.emplace(LookupKey(m.Path, type), m.Handle);
 		m_Metadata[m.Handle] = std::move(m);
 		return m.Handle;
 	}
@@ -4,6 +4,7 @@
 #include "Snowstorm/Assets/AssetTypes.hpp"
 
 #include <functional>
+#include <string>
 #include <unordered_map>
 
 namespace Snowstorm
@@ -24,5 +25,9 @@ namespace Snowstorm
 
 	private:
 		std::unordered_map<UUID, AssetMetadata> m_Metadata; // key = UUID::Value()
+
+		// Path lookup for FindHandleByPath / Import: key = PathKey + '|' + type. Used to be a scan of every
+		// entry per call, which made registering a large asset tree quadratic.
+		std::unordered_map<std::string, UUID> m_ByPath;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include "ContentHash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+		constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+		constexpr uint64_t kPrime3 = 0x165667B19E3779F9ull;
+		constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ull;
+		constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ull;
+
+		constexpr uint64_t Rotl(const uint64_t x, const int r)
+		{
+			return (x << r) | (x >> (64 - r));
+		}
+
+		// Unaligned little-endian loads. memcpy compiles to a single mov on x86/ARM64; every platform we
+		// ship on is little-endian, which is what makes the digest match the reference xxHash.
+		uint64_t Read64(const uint8_t* p)
+		{
+			uint64_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		uint32_t Read32(const uint8_t* p)
+		{
+			uint32_t v;
+			std::memcpy(&v, p, sizeof(v));
+			return v;
+		}
+
+		uint64_t Round(uint64_t acc, const uint64_t input)
+		{
+			acc += input * kPrime2;
+			acc = Rotl(acc, 31);
+			return acc * kPrime1;
+		}
+
+		uint64_t MergeRound(uint64_t acc, const uint64_t val)
+		{
+			acc ^= Round(0, val);
+			return acc * kPrime1 + kPrime4;
+		}
+
+		// Consume whole 32-byte stripes into the four lanes; returns the pointer past the last full stripe.
+		const uint8_t* ConsumeStripes(uint64_t (&acc)[4], const uint8_t* p, const uint8_t* end)
+		{
+			while (end - p >= 32)
+			{
+				acc[0] = Round(acc[0], Read64(p));
+				acc[1] = Round(acc[1], Read64(p + 8));
+				acc[2] = Round(acc[2], Read64(p + 16));
+				acc[3] = Round(acc[3], Read64(p + 24));
+				p += 32;
+			}
+			return p;
+		}
+
+		// The tail (< 32 bytes) + avalanche, shared by the one-shot and streaming digests.
+		uint64_t Finalize(uint64_t h, const uint8_t* p, size_t len)
+		{
+			while (len >= 8)
+			{
+				h ^= Round(0, Read64(p));
+				h = Rotl(h, 27) * kPrime1 + kPrime4;
+				p += 8;
+				len -= 8;
+			}
+			if (len >= 4)
+			{
+				h ^= static_cast<uint64_t>(Read32(p)) * kPrime1;
+				h = Rotl(h, 23) * kPrime2 + kPrime3;
+				p += 4;
+				len -= 4;
+			}
+			while (len > 0)
+			{
+				h ^= static_cast<uint64_t>(*p) * kPrime5;
+				h = Rotl(h, 11) * kPrime1;
+				++p;
+				--len;
+			}
+
+			h ^= h >> 33;
+			h *= kPrime2;
+			h ^= h >> 29;
+			h *= kPrime3;
+			h ^= h >> 32;
+			return h;
+		}
+
+		uint64_t MergeLanes(const uint64_t (&acc)[4])
+		{
+			uint64_t h = Rotl(acc[0], 1) + Rotl(acc[1], 7) + Rotl(acc[2], 12) + Rotl(acc[3], 18);
+			h = MergeRound(h, acc[0]);
+			h = MergeRound(h, acc[1]);
+			h = MergeRound(h, acc[2]);
+			h = MergeRound(h, acc[3]);
+			return h;
+		}
+	}
+
+	ContentHasher::ContentHasher(const uint64_t seed)
+	    : m_Seed(seed)
+	{
+		m_Acc[0] = seed + kPrime1 + kPrime2;
+		m_Acc[1] = seed + kPrime2;
+		m_Acc[2] = seed;
+		m_Acc[3] = seed - kPrime1;
+	}
+
+	void ContentHasher::Update(const void* data, const size_t size)
+	{
+		if (size == 0)
+		{
+			return;
+		}
+
+		auto p = static_cast<const uint8_t*>(data);
+		const uint8_t* const end = p + size;
+		m_TotalLen += size;
+
+		// Top up a partial stripe from a previous call first.
+		if (m_BufferSize > 0)
+		{
+			const size_t fill = std::min<size_t>(32 - m_BufferSize, size);
+			std::memcpy(m_Buffer + m_BufferSize, p, fill);
+			m_BufferSize += static_cast<uint32_t>(fill);
+			p += fill;
+			if (m_BufferSize < 32)
+			{
+				return;
+			}
+			ConsumeStripes(m_Acc, m_Buffer, m_Buffer + 32);
+			m_BufferSize = 0;
+		}
+
+		p = ConsumeStripes(m_Acc, p, end);
+
+		if (p < end)
+		{
+			m_BufferSize = static_cast<uint32_t>(end - p);
+			std::memcpy(m_Buffer, p, m_BufferSize);
+		}
+	}
+
+	uint64_t ContentHasher::Digest() const
+	{
+		uint64_t h = (m_TotalLen >= 32) ? MergeLanes(m_Acc) : m_Seed + kPrime5;
+		h += m_TotalLen;
+		return Finalize(h, m_Buffer, m_BufferSize);
+	}
+
+	uint64_t HashBytes64(const void* data, const size_t size, const uint64_t seed)
+	{
+		ContentHasher hasher(seed);
+		hasher.Update(data, size);
+		return hasher.Digest();
+	}
+
+	std::optional<uint64_t> HashFileContents64(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in.is_open())
+		{
+			return std::nullopt;
+		}
+
+		// 1 MiB chunks: large enough that the per-read syscall overhead vanishes, small enough to stay cache-
+		// friendly and not balloon a worker's footprint when several hash big sources at once.
+		constexpr size_t kChunk = 1u << 20;
+		std::vector<char> chunk(kChunk);
+		ContentHasher hasher;
+		while (in)
+		{
+			in.read(chunk.data(), static_cast<std::streamsize>(kChunk));
+			const std::streamsize got = in.gcount();
+			if (got <= 0)
+			{
+				break;
+			}
+			hasher.Update(chunk.data(), static_cast<size_t>(got));
+		}
+
+		if (in.bad())
+		{
+			return std::nullopt;
+		}
+		return hasher.Digest();
+	}
+}
@@ -0,0 +1,196 @@
+#include "ContentHashIndex.hpp"
+
+#include "Snowstorm/Assets/AssetFileTime.hpp"
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
+
+#include <fstream>
+#include <vector>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint32_t kMagic = 0x58444948; // "HIDX"
+		constexpr uint32_t kVersion = 1;
+
+		struct Header
+		{
+			uint32_t Magic = kMagic;
+			uint32_t Version = kVersion;
+			uint64_t EntryCount = 0;
+		};
+
+		// One key per file regardless of how the caller spelled the path ("./a/../b.gltf" vs "b.gltf").
+		std::string NormalizeKey(const std::filesystem::path& p)
+		{
+			std::error_code ec;
+			std::filesystem::path abs = std::filesystem::absolute(p, ec);
+			if (ec)
+			{
+				abs = p;
+			}
+			return abs.lexically_normal().generic_string();
+		}
+	}
+
+	ContentHashIndex& ContentHashIndex::Get()
+	{
+		static ContentHashIndex s_Index("Engine/cache/hashindex.bin");
+		return s_Index;
+	}
+
+	ContentHashIndex::ContentHashIndex(std::filesystem::path indexPath)
+	    : m_IndexPath(std::move(indexPath))
+	{
+	}
+
+	ContentHashIndex::~ContentHashIndex()
+	{
+		(void)Flush();
+	}
+
+	void ContentHashIndex::EnsureLoadedLocked()
+	{
+		if (m_Loaded)
+		{
+			return;
+		}
+		m_Loaded = true;
+
+		std::ifstream in(m_IndexPath, std::ios::binary);
+		if (!in.is_open())
+		{
+			return; // first run: empty index
+		}
+
+		Header h{};
+		in.read(reinterpret_cast<char*>(&h), sizeof(h));
+		if (!in || h.Magic != kMagic || h.Version != kVersion)
+		{
+			return; // foreign/old index -> start empty; it self-heals on the next Flush
+		}
+
+		std::unordered_map<std::string, Entry> loaded;
+		loaded.reserve(h.EntryCount);
+		for (uint64_t i = 0; i < h.EntryCount; ++i)
+		{
+			uint32_t pathLen = 0;
+			in.read(reinterpret_cast<char*>(&pathLen), sizeof(pathLen));
+			if (!in || pathLen == 0 || pathLen > 4096)
+			{
+				return; // truncated/corrupt: drop the whole index rather than trust half of it
+			}
+			std::string key(pathLen, '\0');
+			in.read(key.data(), pathLen);
+
+			Entry e{};
+			in.read(reinterpret_cast<char*>(&e), sizeof(e));
+			if (!in)
+			{
+				return;
+			}
+			loaded.emplace(std::move(key), e);
+		}
+
+		m_Entries = std::move(loaded);
+	}
+
+	std::optional<uint64_t> ContentHashIndex::GetHash(const std::filesystem::path& source)
+	{
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::file_size(source, ec);
+		if (ec)
+		{
+			return std::nullopt;
+		}
+		const uint64_t writeTime = GetFileWriteTimeU64(source);
+		const std::string key = NormalizeKey(source);
+
+		{
+			std::lock_guard lock(m_Mutex);
+			EnsureLoadedLocked();
+			if (const auto it = m_Entries.find(key); it != m_Entries.end())
+			{
+				const Entry& e = it->second;
+				if (e.FileSize == fileSize && e.WriteTime == writeTime)
+				{
+					return e.Hash;
+				}
+			}
+		}
+
+		// Miss or stat changed: stream the file UNLOCKED so concurrent workers hash different sources in
+		// parallel. Two workers racing on the same file both compute the same digest; last write wins.
+		const std::optional<uint64_t> hash = HashFileContents64(source);
+		if (!hash)
+		{
+			return std::nullopt;
+		}
+
+		std::lock_guard lock(m_Mutex);
+		m_Entries[key] = Entry{fileSize, writeTime, *hash};
+		m_Dirty = true;
+		++m_Rehashes;
+		return hash;
+	}
+
+	bool ContentHashIndex::Flush()
+	{
+		std::lock_guard lock(m_Mutex);
+		if (!m_Dirty)
+		{
+			return true;
+		}
+
+		std::error_code ec;
+		std::filesystem::create_directories(m_IndexPath.parent_path(), ec);
+
+		Header h{};
+		h.EntryCount = m_Entries.size();
+
+		// A unique temp name, not "<index>.tmp": two editors (or test runs) flushing the same project's index
+		// must not write into, or rename, each other's half-written file.
+		const std::filesystem::path tmp = DerivedDataCache::MakeTempPath(m_IndexPath);
+		{
+			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+			{
+				return false;
+			}
+			out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+			for (const auto& [key, e] : m_Entries)
+			{
+				const auto pathLen = static_cast<uint32_t>(key.size());
+				out.write(reinterpret_cast<const char*>(&pathLen), sizeof(pathLen));
+				out.write(key.data(), pathLen);
+				out.write(reinterpret_cast<const char*>(&e), sizeof(e));
+			}
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+		}
+
+		if (!DerivedDataCache::CommitTempFile(tmp, m_IndexPath))
+		{
+			return false;
+		}
+		m_Dirty = false;
+		return true;
+	}
+
+	size_t ContentHashIndex::Size() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Entries.size();
+	}
+
+	uint64_t ContentHashIndex::RehashCount() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Rehashes;
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Snowstorm
+{
+	// Persistent (path, size, write-time) -> content-hash memo. The derived-data cache keys cooked blobs by
+	// the XXH64 of the source bytes, but rehashing every source on every startup would trade the old mtime
+	// check's false misses for a full read of the asset tree. The index remembers the last hash per path and
+	// only rehashes a file whose size or write time moved. Unlike the old SourceWriteTime gate, a stale
+	// stat here is harmless: a touched-but-identical file rehashes to the same content hash and still hits.
+	//
+	// The index is a machine-local accelerator (mtimes don't travel), so it lives under Engine/cache and is
+	// never shared; the cooked artifacts it keys are what the shared DDC moves between checkouts.
+	// Thread-safe: JobSystem workers call GetHash concurrently during async loads; hashing runs unlocked.
+	class ContentHashIndex
+	{
+	public:
+		// Engine/cache/hashindex.bin (CWD-relative, gitignored — same convention as the cook caches).
+		static ContentHashIndex& Get();
+
+		// Standalone index backed by a specific file (tests / tools). Loaded lazily on first use.
+		explicit ContentHashIndex(std::filesystem::path indexPath);
+		~ContentHashIndex();
+
+		ContentHashIndex(const ContentHashIndex&) = delete;
+		ContentHashIndex& operator=(const ContentHashIndex&) = delete;
+
+		// XXH64 of the file's contents, from the index if its size + write time are unchanged, else by
+		// streaming the file (and recording the result). nullopt if the file is missing/unreadable.
+		std::optional<uint64_t> GetHash(const std::filesystem::path& source);
+
+		// Write the index if anything changed since the last save (atomic temp-then-rename). Called when an
+		// async load burst drains and on destruction; cheap no-op when clean. Returns false on I/O failure.
+		bool Flush();
+
+		[[nodiscard]] size_t Size() const;
+
+		// Number of GetHash calls that had to read file contents (vs. served from the index). Test/stat hook.
+		[[nodiscard]] uint64_t RehashCount() const;
+
+	private:
+		struct Entry
+		{
+			uint64_t FileSize = 0;
+			uint64_t WriteTime = 0;
+			uint64_t Hash = 0;
+		};
+
+		void EnsureLoadedLocked();
+
+		std::filesystem::path m_IndexPath;
+
+		mutable std::mutex m_Mutex; // guards everything below
+		std::unordered_map<std::string, Entry> m_Entries;
+		bool m_Loaded = false;
+		bool m_Dirty = false;
+		uint64_t m_Rehashes = 0;
+	};
+}
@@ -0,0 +1,148 @@
+#include "DerivedDataCache.hpp"
+
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		std::filesystem::path ArtifactPath(const std::filesystem::path& root, const std::string_view kind, const DerivedDataKey key, const std::string_view ext)
+		{
+			std::filesystem::path p = root / std::string(kind) / key.ToString();
+			p += std::string(ext);
+			return p;
+		}
+
+		// Copy `from` to `to` via a uniquely-named temp + atomic commit, so a concurrent reader of `to` (another
+		// worker, another machine on the share) never sees a partial file.
+		bool CopyAtomically(const std::filesystem::path& from, const std::filesystem::path& to)
+		{
+			std::error_code ec;
+			std::filesystem::create_directories(to.parent_path(), ec);
+
+			const std::filesystem::path tmp = DerivedDataCache::MakeTempPath(to);
+			std::filesystem::copy_file(from, tmp, std::filesystem::copy_options::overwrite_existing, ec);
+			if (ec)
+			{
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+			return DerivedDataCache::CommitTempFile(tmp, to);
+		}
+	}
+
+	std::string DerivedDataKey::ToString() const
+	{
+		char name[17];
+		std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(Value));
+		return name;
+	}
+
+	DerivedDataKey DerivedDataCache::MakeKey(const std::string_view kind, const uint64_t sourceHash, const uint64_t settingsHash, const uint32_t cookVersion)
+	{
+		ContentHasher hasher;
+		hasher.Update(kind);
+		hasher.UpdateValue(sourceHash);
+		hasher.UpdateValue(settingsHash);
+		hasher.UpdateValue(cookVersion);
+		return DerivedDataKey{hasher.Digest()};
+	}
+
+	std::filesystem::path DerivedDataCache::GetLocalPath(const std::string_view kind, const DerivedDataKey key, const std::string_view ext)
+	{
+		return ArtifactPath("Engine/cache", kind, key, ext);
+	}
+
+	std::filesystem::path DerivedDataCache::GetSharedRoot()
+	{
+		return std::filesystem::path(CVars::DdcSharedPath.Get());
+	}
+
+	std::optional<std::filesystem::path> DerivedDataCache::Locate(const std::string_view kind, const DerivedDataKey key, const std::string_view ext)
+	{
+		std::error_code ec;
+		std::filesystem::path local = GetLocalPath(kind, key, ext);
+		if (std::filesystem::exists(local, ec))
+		{
+			return local;
+		}
+
+		const std::filesystem::path sharedRoot = GetSharedRoot();
+		if (sharedRoot.empty())
+		{
+			return std::nullopt;
+		}
+
+		const std::filesystem::path shared = ArtifactPath(sharedRoot, kind, key, ext);
+		if (!std::filesystem::exists(shared, ec))
+		{
+			return std::nullopt;
+		}
+
+		// Pull down so later lookups stay local (a network share is far slower than the local disk). If the
+		// copy fails (read-only local dir?) read straight from the share instead of re-cooking.
+		if (CopyAtomically(shared, local))
+		{
+			return local;
+		}
+		return shared;
+	}
+
+	void DerivedDataCache::Publish(const std::string_view kind, const DerivedDataKey key, const std::string_view ext)
+	{
+		const std::filesystem::path sharedRoot = GetSharedRoot();
+		if (sharedRoot.empty())
+		{
+			return;
+		}
+
+		std::error_code ec;
+		const std::filesystem::path shared = ArtifactPath(sharedRoot, kind, key, ext);
+		if (std::filesystem::exists(shared, ec))
+		{
+			return; // immutable artifact: another machine already published these exact bytes
+		}
+
+		if (!CopyAtomically(GetLocalPath(kind, key, ext), shared))
+		{
+			SS_CORE_WARN("DDC: could not publish {} to shared cache {}", shared.filename().string(), sharedRoot.string());
+		}
+	}
+
+	std::filesystem::path DerivedDataCache::MakeTempPath(const std::filesystem::path& path)
+	{
+		static std::atomic<uint64_t> s_TempCounter{0};
+		static const uint64_t s_ProcessSalt = (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+
+		const uint64_t thread = HashCombine64(s_ProcessSalt, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+		const uint64_t unique = HashCombine64(thread, s_TempCounter.fetch_add(1));
+		char suffix[32];
+		std::snprintf(suffix, sizeof(suffix), ".%llx.tmp", static_cast<unsigned long long>(unique));
+		return path.string() + suffix;
+	}
+
+	bool DerivedDataCache::CommitTempFile(const std::filesystem::path& tmp, const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		std::filesystem::rename(tmp, path, ec);
+		if (ec)
+		{
+			std::filesystem::remove(path, ec);
+			ec.clear();
+			std::filesystem::rename(tmp, path, ec);
+		}
+		if (ec)
+		{
+			std::filesystem::remove(tmp, ec);
+			return false;
+		}
+		return true;
+	}
+}
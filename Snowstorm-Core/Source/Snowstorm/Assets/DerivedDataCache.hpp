@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Snowstorm
+{
+	// Name of one cooked artifact: XXH64(cache kind, source content hash, cook settings, cook-code version).
+	// Two checkouts / machines with the same source bytes and the same cooker compute the same key, which is
+	// what lets a cooked blob be reused across them (the SourceWriteTime gate this replaces could not).
+	struct DerivedDataKey
+	{
+		uint64_t Value = 0;
+
+		[[nodiscard]] std::string ToString() const; // 16 lowercase hex digits (the on-disk file stem)
+
+		bool operator==(const DerivedDataKey&) const = default;
+	};
+
+	// Derived-data cache (cf. Unreal's DDC): where cooked blobs live and how they are found. Two tiers, same
+	// layout <root>/<kind>/<key>.<ext>:
+	//   - local:  Engine/cache (CWD-relative, gitignored) — what MeshCacheIO/TextureCacheIO read and write;
+	//   - shared: asset.ddc.shared (a directory several projects / checkouts / CI agents point at). A local
+	//             miss that hits shared is copied down to local; every local save is published up to shared.
+	// Artifacts are immutable once written (the key covers everything that affects their bytes), so neither
+	// tier needs invalidation or locking: concurrent writers of one key produce identical files and the
+	// temp-then-rename commit keeps a reader from ever seeing a half-written blob.
+	class DerivedDataCache
+	{
+	public:
+		// `kind` namespaces the cache ("mesh", "texture"); `settingsHash` folds every cook option that changes
+		// the output bytes; `cookVersion` is bumped when the cook code or blob layout changes.
+		static DerivedDataKey MakeKey(std::string_view kind, uint64_t sourceHash, uint64_t settingsHash, uint32_t cookVersion);
+
+		// Engine/cache/<kind>/<key><ext>
+		static std::filesystem::path GetLocalPath(std::string_view kind, DerivedDataKey key, std::string_view ext);
+
+		// The shared tier root (asset.ddc.shared), or empty when no shared DDC is configured.
+		static std::filesystem::path GetSharedRoot();
+
+		// Path to read a cooked artifact from: the local file if present, else the shared one copied into the
+		// local tier first (so the next lookup is local). nullopt = miss in every tier -> caller cooks.
+		static std::optional<std::filesystem::path> Locate(std::string_view kind, DerivedDataKey key, std::string_view ext);
+
+		// Push a freshly-written local artifact to the shared tier (best effort: an unreachable share only
+		// costs other machines a cook, never this one). No-op when no shared DDC is configured.
+		static void Publish(std::string_view kind, DerivedDataKey key, std::string_view ext);
+
+		// A temp name next to `path` unique to this process + thread + call. Two workers cooking the same key (two
+		// handles naming one source) must not share a ".tmp" or one could rename the other's half-written file;
+		// nor may two processes (editors, test runs) writing the shared tier, whose thread ids can coincide.
+		static std::filesystem::path MakeTempPath(const std::filesystem::path& path);
+
+		// Atomically move a fully-written temp file over `path` (rename, with the remove+rename fallback for
+		// platforms whose rename won't replace). Shared by every cache writer. Returns false on failure.
+		static bool CommitTempFile(const std::filesystem::path& tmp, const std::filesystem::path& path);
+	};
+}
@@ -1,5 +1,6 @@
 #include "MeshCache.hpp"
 
+#include "Snowstorm/Assets/ContentHash.hpp"
 #include "Snowstorm/Core/Log.hpp"
 
 #include <fstream>
@@ -8,45 +9,55 @@ namespace Snowstorm
 {
 	namespace
 	{
-		// On-disk header. Magic + version guard against stale/foreign files; SourceWriteTime invalidates the
-		// blob when the source asset changes (same gate as the bounds cache). Counts size the reads. Bumping
-		// Version (e.g. if Vertex layout changes) forces a re-cook of every mesh.
+		// On-disk header. Magic + version guard against stale/foreign files; Key must match the file name's key
+		// (a renamed/copied-over blob is rejected). Counts size the reads. Bumping Version (e.g. if Vertex layout
+		// changes) re-keys every mesh — the version is folded into the key — so old blobs are simply never hit.
+		// v2: content-hash key replaces the v1 SourceWriteTime gate.
 		constexpr uint32_t kMagic = 0x484D5353; // "SSMH"
-		constexpr uint32_t kVersion = 1;
+		constexpr uint32_t kVersion = 2;
+		constexpr std::string_view kKind = "mesh";
+		constexpr std::string_view kExt = ".ssmesh";
 
 		struct Header
 		{
 			uint32_t Magic = kMagic;
 			uint32_t Version = kVersion;
-			uint64_t SourceWriteTime = 0;
+			uint64_t Key = 0;
 			uint64_t VertexCount = 0;
 			uint64_t IndexCount = 0;
 		};
 	}
 
-	std::filesystem::path MeshCacheIO::GetCachePath(const AssetHandle handle)
+	DerivedDataKey MeshCacheIO::MakeKey(const uint64_t sourceHash, const int submeshIndex, const uint32_t importFlags)
 	{
-		std::filesystem::path p = "Engine/cache/mesh";
-		p /= handle.ToString();
-		p += ".ssmesh";
-		return p;
+		struct Settings
+		{
+			int32_t SubmeshIndex;
+			uint32_t ImportFlags;
+			uint32_t VertexSize;
+		};
+		const Settings settings{submeshIndex, importFlags, static_cast<uint32_t>(sizeof(Vertex))};
+		return DerivedDataCache::MakeKey(kKind, sourceHash, HashBytes64(&settings, sizeof(settings)), kVersion);
+	}
+
+	std::filesystem::path MeshCacheIO::GetCachePath(const DerivedDataKey key)
+	{
+		return DerivedDataCache::GetLocalPath(kKind, key, kExt);
 	}
 
-	std::optional<CookedMesh> MeshCacheIO::Load(const AssetHandle handle, const uint64_t sourceWriteTime)
+	std::optional<CookedMesh> MeshCacheIO::Load(const DerivedDataKey key)
 	{
-		const auto path = GetCachePath(handle);
+		const std::optional<std::filesystem::path> path = DerivedDataCache::Locate(kKind, key, kExt);
+		if (!path)
+			return std::nullopt;
 
-		std::ifstream in(path, std::ios::binary);
+		std::ifstream in(*path, std::ios::binary);
 		if (!in.is_open())
 			return std::nullopt;
 
 		Header h{};
 		in.read(reinterpret_cast<char*>(&h), sizeof(h));
-		if (!in || h.Magic != kMagic || h.Version != kVersion)
-			return std::nullopt;
-
-		// Stale: source changed since this blob was cooked. Caller re-parses + re-cooks.
-		if (h.SourceWriteTime != sourceWriteTime)
+		if (!in || h.Magic != kMagic || h.Version != kVersion || h.Key != key.Value)
 			return std::nullopt;
 
 		if (h.VertexCount == 0 || h.IndexCount == 0)
@@ -64,30 +75,31 @@ namespace Snowstorm
 		// A truncated/corrupt blob -> treat as a miss so the source gets re-cooked, don't return partial data.
 		if (!in)
 		{
-			SS_CORE_WARN("MeshCache: cooked blob {} was truncated/unreadable; will re-cook.", path.string());
+			SS_CORE_WARN("MeshCache: cooked blob {} was truncated/unreadable; will re-cook.", path->string());
 			return std::nullopt;
 		}
 
 		return mesh;
 	}
 
-	bool MeshCacheIO::Save(const AssetHandle handle, const uint64_t sourceWriteTime, const CookedMesh& mesh)
+	bool MeshCacheIO::Save(const DerivedDataKey key, const CookedMesh& mesh)
 	{
 		if (mesh.Vertices.empty() || mesh.Indices.empty())
 			return false;
 
-		const auto path = GetCachePath(handle);
+		const auto path = GetCachePath(key);
 		std::error_code ec;
 		std::filesystem::create_directories(path.parent_path(), ec);
 
 		Header h{};
-		h.SourceWriteTime = sourceWriteTime;
+		h.Key = key.Value;
 		h.VertexCount = mesh.Vertices.size();
 		h.IndexCount = mesh.Indices.size();
 
 		// Atomic-ish: write a temp then rename, so a crash mid-write never leaves a half-cooked blob that
-		// would pass the header check. Mirrors MeshMetaCacheIO::Save.
-		const auto tmp = path.string() + ".tmp";
+		// would pass the header check. The temp name is per-writer: two handles naming the same source
+		// submesh share a key and may cook it concurrently.
+		const auto tmp = DerivedDataCache::MakeTempPath(path);
 		{
 			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
 			if (!out.is_open())
@@ -102,13 +114,10 @@ namespace Snowstorm
 				return false;
 		}
 
-		std::filesystem::rename(tmp, path, ec);
-		if (ec)
-		{
-			std::filesystem::remove(path, ec);
-			ec.clear();
-			std::filesystem::rename(tmp, path, ec);
-		}
-		return !ec;
+		if (!DerivedDataCache::CommitTempFile(tmp, path))
+			return false;
+
+		DerivedDataCache::Publish(kKind, key, kExt);
+		return true;
 	}
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Snowstorm/Assets/AssetTypes.hpp"
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
 #include "Snowstorm/Render/Mesh.hpp"
 
 #include <cstdint>
@@ -13,7 +13,7 @@ namespace Snowstorm
 	// Cooked (import-once) mesh geometry: the packed vertex + index arrays a mesh needs to build its GPU
 	// buffers, serialized as a raw binary blob so startup skips the expensive Assimp re-parse. This is the
 	// engine's first real "cook step" (cf. Unity Library/, Unreal DDC): the .gltf/.obj is the source, this
-	// is the GPU-ready artifact keyed by asset handle. Vertex is a fixed-size POD, so the arrays blit
+	// is the GPU-ready artifact keyed by source content + cook settings (see DerivedDataCache). Vertex is a fixed-size POD, so the arrays blit
 	// directly with no per-field serialization.
 	struct CookedMesh
 	{
@@ -24,15 +24,20 @@ namespace Snowstorm
 	class MeshCacheIO
 	{
 	public:
-		// Engine/cache/mesh/<handle>.ssmesh (next to the <handle>.json bounds sidecar).
-		static std::filesystem::path GetCachePath(AssetHandle handle);
+		// Cache key for one submesh: the source file's content hash plus everything else that shapes the
+		// cooked bytes (submesh index, the Assimp import flags, the Vertex layout, the blob version). Content-
+		// keyed, so a checkout / copy / CI restore that rewrites mtimes still hits.
+		static DerivedDataKey MakeKey(uint64_t sourceHash, int submeshIndex, uint32_t importFlags);
 
-		// Load the cooked blob if it exists AND matches sourceWriteTime (stale/missing -> nullopt, so the
-		// caller re-cooks from source). The write-time gate is the same invalidation the bounds cache uses.
-		static std::optional<CookedMesh> Load(AssetHandle handle, uint64_t sourceWriteTime);
+		// Engine/cache/mesh/<key>.ssmesh
+		static std::filesystem::path GetCachePath(DerivedDataKey key);
 
-		// Write the cooked blob (creates dirs; atomic temp-then-rename). Returns false on failure — a
-		// failed cook just means the next load re-parses, never a crash.
-		static bool Save(AssetHandle handle, uint64_t sourceWriteTime, const CookedMesh& mesh);
+		// Load the cooked blob for `key` from the local cache (or the shared DDC, pulled down on hit).
+		// Missing/corrupt -> nullopt, so the caller re-cooks from source.
+		static std::optional<CookedMesh> Load(DerivedDataKey key);
+
+		// Write the cooked blob (creates dirs; atomic temp-then-rename) and publish it to the shared DDC.
+		// Returns false on failure — a failed cook just means the next load re-parses, never a crash.
+		static bool Save(DerivedDataKey key, const CookedMesh& mesh);
 	};
 }
@@ -39,9 +39,9 @@ namespace Snowstorm
 		if (root.contains("SourcePath"))
 			meta.SourcePath = root["SourcePath"].get<std::string>();
 
-		if (!root.contains("SourceWriteTime"))
+		if (!root.contains("SourceHash"))
 			return std::nullopt;
-		meta.SourceWriteTime = root["SourceWriteTime"].get<uint64_t>();
+		meta.SourceHash = root["SourceHash"].get<uint64_t>();
 
 		if (!root.contains("Bounds") || !root["Bounds"].is_object())
 			return std::nullopt;
@@ -70,7 +70,7 @@ namespace Snowstorm
 		root["Version"] = MeshMetaCache::Version;
 		root["Handle"] = meta.Handle.ToString();
 		root["SourcePath"] = meta.SourcePath.generic_string();
-		root["SourceWriteTime"] = meta.SourceWriteTime;
+		root["SourceHash"] = meta.SourceHash;
 
 		json b;
 		b["Min"] = VecToJson(meta.Bounds.Box.Min);
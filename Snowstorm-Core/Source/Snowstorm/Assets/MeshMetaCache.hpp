@@ -10,11 +10,13 @@ namespace Snowstorm
 {
 	struct MeshMetaCache
 	{
-		static constexpr uint32_t Version = 1;
+		// v2: SourceHash (content) replaces v1's SourceWriteTime, so a checkout / copy that rewrites mtimes no
+		// longer invalidates the sidecar.
+		static constexpr uint32_t Version = 2;
 
 		AssetHandle Handle{};
 		std::filesystem::path SourcePath;
-		uint64_t SourceWriteTime = 0; // epoch-ish, stable as uint64 in json
+		uint64_t SourceHash = 0; // XXH64 of the source file's bytes (ContentHashIndex)
 		MeshBounds Bounds{};
 	};
 
@@ -9,43 +9,46 @@ namespace Snowstorm
 	namespace
 	{
 		constexpr uint32_t kMagic = 0x58455453; // "STEX"
-		// v2: stores the full precomputed mip chain (v1 stored only the base level). Bumping forces a
-		// re-cook, which is fine — .sstex is a derived cache.
-		constexpr uint32_t kVersion = 2;
+		// v2: stores the full precomputed mip chain (v1 stored only the base level). v3: content-hash key
+		// replaces the SourceWriteTime gate. Bumping forces a re-cook, which is fine — .sstex is a derived cache.
+		constexpr uint32_t kVersion = 3;
+		constexpr std::string_view kKind = "texture";
+		constexpr std::string_view kExt = ".sstex";
 
 		struct Header
 		{
 			uint32_t Magic = kMagic;
 			uint32_t Version = kVersion;
-			uint64_t SourceWriteTime = 0;
+			uint64_t Key = 0;
 			uint32_t Width = 0;
 			uint32_t Height = 0;
 			uint32_t MipLevels = 0;
 		};
 	}
 
-	std::filesystem::path TextureCacheIO::GetCachePath(const AssetHandle handle)
+	DerivedDataKey TextureCacheIO::MakeKey(const uint64_t sourceHash)
 	{
-		std::filesystem::path p = "Engine/cache/texture";
-		p /= handle.ToString();
-		p += ".sstex";
-		return p;
+		return DerivedDataCache::MakeKey(kKind, sourceHash, 0, kVersion);
 	}
 
-	std::optional<CookedTexture> TextureCacheIO::Load(const AssetHandle handle, const uint64_t sourceWriteTime)
+	std::filesystem::path TextureCacheIO::GetCachePath(const DerivedDataKey key)
 	{
-		const auto path = GetCachePath(handle);
+		return DerivedDataCache::GetLocalPath(kKind, key, kExt);
+	}
 
-		std::ifstream in(path, std::ios::binary);
+	std::optional<CookedTexture> TextureCacheIO::Load(const DerivedDataKey key)
+	{
+		const std::optional<std::filesystem::path> path = DerivedDataCache::Locate(kKind, key, kExt);
+		if (!path)
+			return std::nullopt;
+
+		std::ifstream in(*path, std::ios::binary);
 		if (!in.is_open())
 			return std::nullopt;
 
 		Header h{};
 		in.read(reinterpret_cast<char*>(&h), sizeof(h));
-		if (!in || h.Magic != kMagic || h.Version != kVersion)
-			return std::nullopt;
-
-		if (h.SourceWriteTime != sourceWriteTime) // source changed -> re-decode
+		if (!in || h.Magic != kMagic || h.Version != kVersion || h.Key != key.Value)
 			return std::nullopt;
 
 		if (h.Width == 0 || h.Height == 0 || h.MipLevels == 0)
@@ -69,29 +72,29 @@ namespace Snowstorm
 
 		if (!in)
 		{
-			SS_CORE_WARN("TextureCache: cooked blob {} was truncated/unreadable; will re-decode.", path.string());
+			SS_CORE_WARN("TextureCache: cooked blob {} was truncated/unreadable; will re-decode.", path->string());
 			return std::nullopt;
 		}
 
 		return tex;
 	}
 
-	bool TextureCacheIO::Save(const AssetHandle handle, const uint64_t sourceWriteTime, const CookedTexture& tex)
+	bool TextureCacheIO::Save(const DerivedDataKey key, const CookedTexture& tex)
 	{
 		if (tex.Levels.empty() || tex.Width == 0 || tex.Height == 0)
 			return false;
 
-		const auto path = GetCachePath(handle);
+		const auto path = GetCachePath(key);
 		std::error_code ec;
 		std::filesystem::create_directories(path.parent_path(), ec);
 
 		Header h{};
-		h.SourceWriteTime = sourceWriteTime;
+		h.Key = key.Value;
 		h.Width = tex.Width;
 		h.Height = tex.Height;
 		h.MipLevels = tex.MipLevels();
 
-		const auto tmp = path.string() + ".tmp";
+		const auto tmp = DerivedDataCache::MakeTempPath(path);
 		{
 			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
 			if (!out.is_open())
@@ -107,13 +110,10 @@ namespace Snowstorm
 				return false;
 		}
 
-		std::filesystem::rename(tmp, path, ec);
-		if (ec)
-		{
-			std::filesystem::remove(path, ec);
-			ec.clear();
-			std::filesystem::rename(tmp, path, ec);
-		}
-		return !ec;
+		if (!DerivedDataCache::CommitTempFile(tmp, path))
+			return false;
+
+		DerivedDataCache::Publish(kKind, key, kExt);
+		return true;
 	}
 }
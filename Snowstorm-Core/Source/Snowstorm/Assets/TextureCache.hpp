@@ -1,6 +1,6 @@
 #pragma once
 
-#include "Snowstorm/Assets/AssetTypes.hpp"
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
 
 #include <cstdint>
 #include <filesystem>
@@ -11,7 +11,7 @@ namespace Snowstorm
 {
 	// Cooked (decode-once) texture pixels: the RGBA8 buffer stb produces from a .png/.jpg, cached as a raw
 	// blob so startup/import skips re-decoding every image. Second cook cache after meshes (#84); the source
-	// image is the input, this is the GPU-ready pixel artifact keyed by asset handle.
+	// image is the input, this is the GPU-ready pixel artifact keyed by source content (see DerivedDataCache).
 	//
 	// NOT keyed by srgb: the decoded bytes are identical regardless of color space — srgb only selects the
 	// Vulkan image FORMAT at upload time (sRGB vs UNORM), not the pixel data. So one blob serves both the
@@ -33,13 +33,18 @@ namespace Snowstorm
 	class TextureCacheIO
 	{
 	public:
-		// Engine/cache/texture/<handle>.sstex
-		static std::filesystem::path GetCachePath(AssetHandle handle);
+		// Cache key: the source image's content hash + the blob version (decode is always RGBA8 with a box-
+		// filtered mip chain, so there are no other settings). Two handles naming the same image share a blob.
+		static DerivedDataKey MakeKey(uint64_t sourceHash);
 
-		// Load the cooked pixels if present AND matching sourceWriteTime (else nullopt -> caller re-decodes).
-		static std::optional<CookedTexture> Load(AssetHandle handle, uint64_t sourceWriteTime);
+		// Engine/cache/texture/<key>.sstex
+		static std::filesystem::path GetCachePath(DerivedDataKey key);
 
-		// Write cooked pixels (creates dirs; atomic temp-then-rename). Returns false on failure.
-		static bool Save(AssetHandle handle, uint64_t sourceWriteTime, const CookedTexture& tex);
+		// Load the cooked pixels from the local cache (or the shared DDC) (else nullopt -> caller re-decodes).
+		static std::optional<CookedTexture> Load(DerivedDataKey key);
+
+		// Write cooked pixels (creates dirs; atomic temp-then-rename), then publish to the shared DDC.
+		// Returns false on failure.
+		static bool Save(DerivedDataKey key, const CookedTexture& tex);
 	};
 }
@@ -148,6 +148,11 @@ namespace Snowstorm
 			const Timestep ts = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
+			// Deliver the deferred notifications posted since last frame (asset / streaming / job events from
+			// any thread), one batch per event type, before anything updates. Also while minimized, so the
+			// channels don't pile up.
+			m_EventBus->DispatchDeferred();
+
 			// Pause when minimized
 			if (!m_Minimized)
 			{
@@ -35,6 +35,17 @@ namespace Snowstorm
 
 		EventBus& GetEventBus() const { return *m_EventBus; }
 
+		// Queue a deferred notification (EventBus::Post) on the app's bus. Any thread -- asset jobs post from
+		// workers. Dropped when there is no Application (headless tests, tools): nobody is listening there.
+		template <typename T>
+		static void PostEvent(const T& event)
+		{
+			if (s_Instance)
+			{
+				s_Instance->m_EventBus->Post(event);
+			}
+		}
+
 	protected:
 		Scope<ServiceManager> m_ServiceManager;
 
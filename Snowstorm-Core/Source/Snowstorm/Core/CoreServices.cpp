@@ -2,6 +2,8 @@
 
 #include "Snowstorm/Service/ServiceManager.hpp"
 
+#include "Snowstorm/Assets/AssetIndex.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
 #include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Render/RendererService.hpp"
 #include "Snowstorm/Render/MeshLibrary.hpp"
@@ -14,6 +16,10 @@ namespace Snowstorm
 		// Job system first: it's the off-main-thread work pool the others may eventually submit to (async
 		// asset loading), and it's device-independent so it can exist before the Vulkan-bound services.
 		services.RegisterService<JobSystem>();
+		// Hot-reload event source. Idle (no thread) until ShaderReloadSystem hands it the directories to watch.
+		services.RegisterService<FileWatcher>();
+		// Content Browser's asset database. Idle (no thread) until the browser opens it on a project.
+		services.RegisterService<AssetIndex>();
 
 		// Device-bound, application-scoped subsystems. Registered after Renderer::Init so the Vulkan device
 		// exists. Order among these is not significant (none tick, none depend on another at construction).
@@ -3,6 +3,8 @@
 #include "Snowstorm/Core/Log.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
 
+#include <bit>
+
 namespace Snowstorm::CVars
 {
 	CVar<int> SmokeFrames{"smoke.frames", 0, "Run N frames then exit cleanly (0 = until window closed)", CVarFlags::ReadOnly};
@@ -54,6 +56,8 @@ namespace Snowstorm::CVars
 	// CLI) like Unreal's r.Shaders.Optimize, not live-toggled from a settings checkbox mid-session.
 	CVar<bool> ShadersDebug{"render.shaders.debug", false, "Compile shaders unoptimized (-Od) with debug info for RenderDoc/PIX source-stepping (off = optimized, the ship default). Startup-only: set it in SnowstormStartup.cfg / CLI and relaunch.", CVarFlags::ReadOnly};
 
+	CVar<std::string> DdcSharedPath{"asset.ddc.shared", "", "Shared derived-data-cache directory: cooked mesh/texture blobs missing from Engine/cache are pulled from here, and fresh cooks are published to it, so projects / checkouts / CI agents reuse each other's cooks (content-hash keyed, never stale). Empty = local cache only. Startup-only.", CVarFlags::ReadOnly};
+
 	CVar<std::string> BakeScene{"scene.bake", "", "Bake a scene to Assets/Scenes/<name>.world then exit. Value: 'stress' (procedural) or a model path (.gltf/.glb/.obj/.fbx)", CVarFlags::ReadOnly};
 
 	CVar<std::string> DumpMeshTangents{"debug.dump_mesh_tangents", "", "Analyze a model's UV/tangent structure across seams (#74) then exit. Value: model path", CVarFlags::ReadOnly};
@@ -72,6 +76,14 @@ namespace Snowstorm::CVars
 	CVar<std::string> GpuSelect{"render.gpu", "", "Select the physical GPU by case-insensitive name substring (e.g. \"9070\", \"NVIDIA\") or candidate index (\"0\",\"1\"); empty = auto (prefer a discrete GPU). Read once at device creation, so a change applies on the next launch. Persisted; the editor's GPU picker writes it.", CVarFlags::Persist};
 
 	CVar<bool> OmmEnabled{"render.omm", true, "Use opacity micromaps (VK_EXT_opacity_micromap) for RT cutout geometry when supported; off = the inline any-hit alpha test alone. Read at TLAS build (change forces a rebuild).", CVarFlags::Persist};
+	CVar<int> TlasMaxRefits{"render.rt.tlas_max_refits", 32, "Transform-only TLAS changes refit the TLAS in place (UPDATE mode) instead of rebuilding it; after this many refits in a row the next change rebuilds to restore trace quality (0..1024, 0 = always rebuild).", CVarFlags::Persist};
+
+	CVar<float> StreamingCellSize{"world.streaming.cell_size", 64.0f, "Grid cell edge (world units, XZ) used when splitting a scene into streaming cells (8..4096). Read by the split tool; an existing .sspartition keeps the cell size it was split with.", CVarFlags::Persist};
+	CVar<float> StreamingLoadRadius{"world.streaming.load_radius", 192.0f, "Streaming cells whose bounds come within this distance of the camera (XZ) are loaded (0..100000).", CVarFlags::Persist};
+	CVar<float> StreamingUnloadMargin{"world.streaming.unload_margin", 64.0f, "Extra distance past world.streaming.load_radius before a loaded cell unloads, so a camera on a cell edge doesn't thrash it (0..100000).", CVarFlags::Persist};
+	CVar<int> StreamingBudgetMb{"world.streaming.budget_mb", 1024, "Memory budget for streamed cells (MiB, estimated from cell + referenced asset file sizes): the nearest cells that fit are kept, farther ones unload (16..65536).", CVarFlags::Persist};
+	CVar<int> StreamingCommitPerFrame{"world.streaming.commit_per_frame", 512, "Max streamed entities added to the registry per frame; a larger cell finishes over several frames (16..65536).", CVarFlags::Persist};
+	CVar<int> StreamingMaxLoads{"world.streaming.max_loads", 2, "Max cells reading + decoding on JobSystem workers at once (1..16).", CVarFlags::Persist};
 
 	CVar<float> Exposure{"render.exposure", 1.0f, "Linear exposure multiplier applied before tonemapping (1.0 = neutral)", CVarFlags::Persist};
 
@@ -91,7 +103,7 @@ namespace Snowstorm::CVars
 
 	CVar<bool> MetricsLog{"render.metrics.log", false, "Log PSNR/SSIM over a ~1s window (like debug.frame_stats) so a headless benchmark run prints the trace. Requires render.metrics (#45)"};
 
-	CVar<bool> DatasetExport{"dataset.export", false, "Dump per-frame (low-res color, motion vectors, full-res ground truth) tuples to disk as .npy + manifest.json — training data for the neural upscaler (#46). Requires render.compare (ground truth); forces the velocity pass on and the camera path onto a fixed timestep so the dataset is regenerable. Serializes synchronously on the main thread (slow by design)."};
+	CVar<bool> DatasetExport{"dataset.export", false, "Dump per-frame (low-res color, motion vectors, full-res ground truth) tuples to disk as .npy + manifest.json — training data for the neural upscaler (#46). Requires render.compare (ground truth); forces the velocity pass on and the camera path onto a fixed timestep so the dataset is regenerable. Frames are written by a bounded background writer (dataset.export.queue); see dataset.export.shard/.compression for the on-disk layout."};
 
 	CVar<bool> DatasetJitter{"dataset.jitter", false, "Apply camera jitter while capturing (dataset.export). Off (default) = unjittered LR, matching a purely SPATIAL upscaler's inference (#102). On = jittered LR, the substrate a TEMPORAL upscaler accumulates (#98). The spatial refiner trains/infers on unjittered, so leave this off for it."};
 
@@ -101,6 +113,12 @@ namespace Snowstorm::CVars
 
 	CVar<int> DatasetExportWarmup{"dataset.export.warmup", 60, "Frames to skip before the FIRST dataset tuple is captured. Early headless-capture frames are pre-content (asset streaming + TLAS build unfinished) and the viewport resolution is still settling — capturing them pollutes the set with blank/wrong-size tuples. Skipping N leaves every written frame steady-state + same-size (on-disk index still starts at 0). Mirrors profile.capture_delay."};
 
+	CVar<int> DatasetExportShard{"dataset.export.shard", 0, "Frames per tar shard (shard_NNNNNN.tar) for dataset.export; 0 = one loose .npy per array (the v1 layout). Shards keep a multi-day capture to thousands of files instead of millions; the manifest records each array's shard + byte offset so readers seek straight to it. Read when the export starts."};
+
+	CVar<std::string> DatasetExportCompression{"dataset.export.compression", "none", "Per-array compression for dataset.export: none | zstd | lz4. Compressed on the writer's worker threads; zstd (level 1) roughly halves half-float frames, lz4 is cheaper and lighter. Read when the export starts."};
+
+	CVar<int> DatasetExportQueue{"dataset.export.queue", 8, "Frames the dataset writer may hold (captured, not yet on disk) before capture waits. Bounds the writer's memory; stalls are counted in the stats overlay, and a growing count means the disk or compressor can't keep up with the frame rate."};
+
 	CVar<int> GtSsaa{"render.gt.ssaa", 1, "Ground-truth supersampling factor for the compare/dataset reference (1 = off, 2 = render the GT at 2x then box-downsample = anti-aliased reference). For a DLAA dataset the GT must be ANTI-ALIASED (a single native GT frame is aliased and not a valid AA target); SSAA is that reference. Capture-only cost (the GT is a 2nd render); clamped to {1,2}.", CVarFlags::Persist};
 
 	CVar<int> Upscaler{"render.upscaler", 0, "Upscale method when render.scale < 1: 0 = Bilinear (baseline), 1 = Neural Spatial (compute CNN residual refiner, single frame, #47), 2 = Neural Temporal (adds MV-warped previous-output + motion vector as extra inputs, DLSS/XeSS-style, #98). Both neural modes run the loaded .ssnn model; with the default identity weights each reproduces bilinear (the correctness baseline). Read per-frame; only active when upscaling (scale < 1). The temporal mode also forces the velocity pass on.", CVarFlags::Persist};
@@ -129,12 +147,24 @@ namespace Snowstorm::CVars
 
 	CVar<int> ShadowsMode{"render.shadows.mode", 1, "Shadow technique: 0 = Off, 1 = Shadow Map (raster depth maps + PCF), 2 = Ray Traced (hardware ray query, requires an RT GPU; falls back to Off on a non-RT device). Mode 2 skips the raster shadow passes entirely. Replaces the old render.shadows/render.shadows.rt toggles (#118)", CVarFlags::Persist};
 
-	CVar<int> ShadowResolution{"render.shadow.resolution", 2048, "Shadow-map resolution (square); changing it rebuilds the shadow target", CVarFlags::Persist};
+	CVar<int> ShadowResolution{"render.shadow.resolution", 2048, "Shadow-map resolution (square); changing it rebuilds the shadow target. Per sun cascade, and the largest spot/point atlas tile.", CVarFlags::Persist};
+
+	CVar<int> ShadowAtlasSize{"render.shadow.atlas_size", 4096, "Side (texels, power of two, 1024..16384) of the shared spot/point shadow atlas. Tiles are sized per light by screen coverage and ShadowPriority; when the atlas is full, low-priority tiles shrink first. Changing it rebuilds the atlas.", CVarFlags::Persist};
+
+	CVar<int> ShadowCascades{"render.shadow.cascades", 3, "Directional-sun shadow cascades (1..4). Each covers a slice of the view distance (render.shadow.distance) with its own render.shadow.resolution map, so texel density follows the camera instead of being spread over the whole scene.", CVarFlags::Persist};
+
+	CVar<float> ShadowDistance{"render.shadow.distance", 150.0f, "View distance (world units) the sun shadow cascades cover; beyond it the sun is unshadowed. Capped by the camera's far plane.", CVarFlags::Persist};
+
+	CVar<float> ShadowSplitLambda{"render.shadow.split_lambda", 0.75f, "Cascade split scheme: 0 = uniform slices, 1 = logarithmic (matches perspective texel density), in between = the practical blend. Higher spends more resolution near the camera.", CVarFlags::Persist};
+
+	CVar<bool> ShadowCascadeCache{"render.shadow.cache", true, "Cache the far half of the sun cascades: they snap to a coarse grid (slightly fewer texels per unit) and re-render only when the camera crosses it, the sun moves, or a caster inside them changes. Off = every cascade renders every frame.", CVarFlags::Persist};
 
 	CVar<bool> ShadowSoft{"render.shadow.soft", true, "Soft shadows: 3x3 PCF for the raster shadow map; cone-sampled penumbra for RT shadows (each shadow ray jittered within the light's size, TAA-denoised). Off = hard single tap / single ray. Needs TAA (render.aa = TAA) for a clean RT penumbra.", CVarFlags::Persist};
 
 	CVar<float> ShadowStrength{"render.shadow.strength", 1.0f, "Shadow darkness (1 = full occlusion, 0 = none)", CVarFlags::Persist};
 
+	CVar<bool> LightsClustered{"render.lights.clustered", true, "Clustered forward lighting: bin point/spot lights into a 16x9x24 view-frustum grid each frame so a fragment shades only the lights that can reach it. Off = every fragment loops over every light (identical image, the cost reference).", CVarFlags::Persist};
+
 	CVar<float> ShadowScale{"render.shadows.scale", 1.0f, "Stochastic RT shadow internal resolution: the shadow-ratio trace runs at this fraction of viewport res, then a depth-aware bilateral upsample restores full res. DEFAULT 1.0 (FULL-RES): shadows are the highest-frequency signal in the frame (sharp contact/thin shadows), so a half-res trace + bilateral upsample can't reconstruct them and looks blocky/soft — production stochastic shadows (MegaLights/RTXDI) trace per full-res pixel. 0.5 = quarter the pixels (~4x cheaper) for a perf/quality A/B. Clamped to [0.25, 1.0].", CVarFlags::Persist};
 
 	CVar<float> ShadowNormalBias{"render.shadows.normalbias", 0.02f, "RT sun-shadow ray-origin normal offset in world units: pushes the shadow ray start off the surface along the geometric normal to avoid self-intersection (shadow acne). Too small = acne (surfaces shadow themselves); too large = peter-panning (contact shadows detach). Clamped to [0, 0.2].", CVarFlags::Persist};
@@ -436,6 +466,132 @@ namespace Snowstorm::CVars
 		return s;
 	}
 
+	int ClampedTlasMaxRefits()
+	{
+		const int n = TlasMaxRefits.Get();
+		if (n < 0)
+		{
+			return 0;
+		}
+		if (n > 1024)
+		{
+			return 1024;
+		}
+		return n;
+	}
+
+	float ClampedStreamingCellSize()
+	{
+		const float v = StreamingCellSize.Get();
+		if (v < 8.0f)
+		{
+			return 8.0f;
+		}
+		if (v > 4096.0f)
+		{
+			return 4096.0f;
+		}
+		return v;
+	}
+
+	float ClampedStreamingLoadRadius()
+	{
+		const float v = StreamingLoadRadius.Get();
+		if (v < 0.0f)
+		{
+			return 0.0f;
+		}
+		if (v > 100000.0f)
+		{
+			return 100000.0f;
+		}
+		return v;
+	}
+
+	float ClampedStreamingUnloadMargin()
+	{
+		const float v = StreamingUnloadMargin.Get();
+		if (v < 0.0f)
+		{
+			return 0.0f;
+		}
+		if (v > 100000.0f)
+		{
+			return 100000.0f;
+		}
+		return v;
+	}
+
+	int ClampedStreamingBudgetMb()
+	{
+		const int n = StreamingBudgetMb.Get();
+		if (n < 16)
+		{
+			return 16;
+		}
+		if (n > 65536)
+		{
+			return 65536;
+		}
+		return n;
+	}
+
+	int ClampedStreamingCommitPerFrame()
+	{
+		const int n = StreamingCommitPerFrame.Get();
+		if (n < 16)
+		{
+			return 16;
+		}
+		if (n > 65536)
+		{
+			return 65536;
+		}
+		return n;
+	}
+
+	int ClampedStreamingMaxLoads()
+	{
+		const int n = StreamingMaxLoads.Get();
+		if (n < 1)
+		{
+			return 1;
+		}
+		if (n > 16)
+		{
+			return 16;
+		}
+		return n;
+	}
+
+	int ClampedShadowAtlasSize()
+	{
+		const int n = ShadowAtlasSize.Get();
+		if (n < 1024)
+		{
+			return 1024;
+		}
+		if (n > 16384)
+		{
+			return 16384;
+		}
+		return static_cast<int>(std::bit_floor(static_cast<unsigned>(n))); // tiles are power-of-two quadrants
+	}
+
+	int ClampedShadowCascades()
+	{
+		const int n = ShadowCascades.Get();
+		if (n < 1)
+		{
+			return 1;
+		}
+		if (n > 4)
+		{
+			return 4;
+		}
+		return n;
+	}
+
 	int ClampedShadowRayCount()
 	{
 		const int n = ShadowRayCount.Get();
@@ -114,6 +114,13 @@ namespace Snowstorm::CVars
 	// (dxc 1.9 crash on -fspv-debug + inline ray query).
 	extern CVar<bool> ShadersDebug;
 
+	// Shared derived-data-cache directory (cf. Unreal's shared DDC). Empty (default) = local cache only
+	// (Engine/cache). When set, cooked mesh/texture blobs missing locally are pulled from here, and every
+	// fresh local cook is published here, so several projects, checkouts and CI agents reuse one set of
+	// cooks. Blobs are keyed by source CONTENT hash + cook settings + cook version, so a share never serves a
+	// stale artifact. Typically set per machine via SS_ASSET_DDC_SHARED or SnowstormStartup.cfg. Startup-only.
+	extern CVar<std::string> DdcSharedPath;
+
 	// One-shot bake tool: populate a fresh scene, serialize it to a .world under Assets/Scenes/, then
 	// exit. Afterwards the scene is opened from the Content Browser like any other .world. Empty
 	// (default) = no bake. The value selects what to bake:
@@ -152,6 +159,32 @@ namespace Snowstorm::CVars
 	// Off = the inline any-hit test alone (FORCE_NO_OPAQUE). Read at TLAS build; an A/B knob + a safety switch.
 	extern CVar<bool> OmmEnabled;
 
+	// Refit budget of the TLAS (TlasBuildSystem): a frame where only instance transforms changed refits the
+	// TLAS in place instead of rebuilding it, up to this many times in a row (a refit keeps the old BVH, which
+	// loosens as instances drift); the next change then rebuilds. 0 = always rebuild. Clamp with
+	// ClampedTlasMaxRefits().
+	extern CVar<int> TlasMaxRefits;
+	[[nodiscard]] int ClampedTlasMaxRefits();
+
+	// Level streaming (LevelStreamingSystem, WorldPartition). Cells whose bounds come within LoadRadius of the
+	// camera (XZ) stream in, nearest first, until their estimated memory reaches BudgetMb; a loaded cell
+	// only streams out past LoadRadius + UnloadMargin (the margin stops a camera on a cell edge from
+	// thrashing it). CellSize is the grid used when splitting a scene into cells. Each loaded cell's
+	// entities are added to the registry at most CommitPerFrame per frame, with at most MaxLoads cells
+	// decoding on workers at once. Clamp with the Clamped* helpers.
+	extern CVar<float> StreamingCellSize;
+	extern CVar<float> StreamingLoadRadius;
+	extern CVar<float> StreamingUnloadMargin;
+	extern CVar<int> StreamingBudgetMb;
+	extern CVar<int> StreamingCommitPerFrame;
+	extern CVar<int> StreamingMaxLoads;
+	[[nodiscard]] float ClampedStreamingCellSize();
+	[[nodiscard]] float ClampedStreamingLoadRadius();
+	[[nodiscard]] float ClampedStreamingUnloadMargin();
+	[[nodiscard]] int ClampedStreamingBudgetMb();
+	[[nodiscard]] int ClampedStreamingCommitPerFrame();
+	[[nodiscard]] int ClampedStreamingMaxLoads();
+
 	// Linear exposure multiplier applied before tonemapping in DefaultLit. 1.0 = neutral; raise to
 	// brighten, lower to darken. Runtime-tweakable from the editor's Settings panel.
 	extern CVar<float> Exposure;
@@ -258,6 +291,11 @@ namespace Snowstorm::CVars
 	extern CVar<int> DatasetExportFrames;
 	// Frames to skip before the first captured tuple (streaming + resolution settle). See the .cpp description.
 	extern CVar<int> DatasetExportWarmup;
+	// Async writer layout: frames per tar shard (0 = loose files), per-array compression ("none"/"zstd"/"lz4")
+	// and the bounded queue depth before capture stalls on the disk.
+	extern CVar<int> DatasetExportShard;
+	extern CVar<std::string> DatasetExportCompression;
+	extern CVar<int> DatasetExportQueue;
 
 	// Apply camera jitter during dataset.export (#102). Off (default) = unjittered LR for the spatial
 	// upscaler; on = jittered LR for the temporal upscaler (#98).
@@ -294,14 +332,36 @@ namespace Snowstorm::CVars
 	[[nodiscard]] bool ShadowsRTActive();
 
 	// Shadow-map resolution (square). Changing it rebuilds the shadow target. Higher = sharper, costlier.
+	// Each sun cascade is this size; for spot/point lights it is the LARGEST atlas tile (a light's tile
+	// scales down from it with its screen coverage and ShadowPriority).
 	extern CVar<int> ShadowResolution;
 
+	// Side of the shared spot/point shadow atlas, texels (a power of two, clamp with ClampedShadowAtlasSize()).
+	// Every shadowed spot and point face gets a tile of it from ShadowAtlasAllocator; when they don't all fit
+	// at their wanted size, low-priority tiles shrink first. Changing it rebuilds the atlas and repacks.
+	extern CVar<int> ShadowAtlasSize;
+	[[nodiscard]] int ClampedShadowAtlasSize();
+
+	// Directional-sun cascades (raster shadow maps): how many (1..4, clamp with ClampedShadowCascades()), the
+	// view distance they cover, the practical split blend (0 = uniform, 1 = logarithmic), and whether the far
+	// half is cached -- re-rendered only when the camera crosses their snapping grid, the sun moves, or a
+	// caster inside them changes.
+	extern CVar<int> ShadowCascades;
+	[[nodiscard]] int ClampedShadowCascades();
+	extern CVar<float> ShadowDistance;
+	extern CVar<float> ShadowSplitLambda;
+	extern CVar<bool> ShadowCascadeCache;
+
 	// Soft shadows: 3x3 PCF for the raster shadow map; cone-sampled penumbra for RT shadows. Off = hard.
 	extern CVar<bool> ShadowSoft;
 
 	// How dark shadows get: 1 = full occlusion, 0 = none. Lerps the sun's visibility toward 1.
 	extern CVar<float> ShadowStrength;
 
+	// Clustered forward lighting: the forward pass shades only the point/spot lights binned into each
+	// fragment's froxel. Off = every fragment walks every light (the A/B reference for the culling).
+	extern CVar<bool> LightsClustered;
+
 	// RT sun-shadow half-res internal resolution (fraction of viewport res). The sun-visibility trace runs at
 	// this scale, then a bilateral upsample restores full res. Clamp with ClampedShadowScale(). Mirrors
 	// render.ao.scale / render.gi.scale; independent of both (its own half-res grid).
@@ -30,15 +30,15 @@ inline int main(int argc, char** argv)
 	// (e.g. Vulkan validation) are read during instance creation inside CreateApplication().
 	Snowstorm::CVarRegistry::Get().Initialize(argc, argv);
 
-	// Convenience: a bare positional argument ending in ".world" is treated as the startup scene, so
-	// you can `Snowstorm-Editor.exe assets/scenes/Sponza.world` the way an editor "opens" a file —
+	// Convenience: a bare positional argument ending in ".world" (or the binary ".ssworld", or a streamed
+	// ".sspartition") is treated as the startup scene, so you can `Snowstorm-Editor.exe assets/scenes/Sponza.world` the way an editor "opens" a file —
 	// no need to remember the --startup.scene= flag. An explicit --startup.scene= or SS_STARTUP_SCENE
 	// (resolved above) always wins, so we only fill an otherwise-empty value.
 	if (Snowstorm::CVars::StartupScene.Get().empty())
 	{
 		for (int i = 1; i < argc; ++i)
 		{
-			if (const std::string_view arg = argv[i]; !arg.starts_with("--") && arg.ends_with(".world"))
+			if (const std::string_view arg = argv[i]; !arg.starts_with("--") && (arg.ends_with(".world") || arg.ends_with(".ssworld") || arg.ends_with(".sspartition")))
 			{
 				Snowstorm::CVars::StartupScene.Set(std::string(arg));
 				break;
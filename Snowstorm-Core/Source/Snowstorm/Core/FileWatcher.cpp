@@ -0,0 +1,127 @@
+#include "FileWatcher.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// How long the backend may block before re-checking the stop flag. Bounds shutdown / root-switch latency;
+		// events themselves are delivered as soon as the OS signals them.
+		constexpr uint32_t kPollTimeoutMs = 100;
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		Stop();
+	}
+
+	std::string FileWatcher::MakeKey(const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		std::filesystem::path abs = std::filesystem::absolute(path, ec);
+		if (ec)
+		{
+			abs = path;
+		}
+		return abs.lexically_normal().generic_string();
+	}
+
+	void FileWatcher::SetWatchRoots(std::vector<std::filesystem::path> roots)
+	{
+		std::vector<std::filesystem::path> normalized;
+		normalized.reserve(roots.size());
+		for (const std::filesystem::path& root : roots)
+		{
+			std::error_code ec;
+			if (!root.empty() && std::filesystem::is_directory(root, ec))
+			{
+				normalized.emplace_back(MakeKey(root));
+			}
+		}
+		std::ranges::sort(normalized);
+		normalized.erase(std::ranges::unique(normalized).begin(), normalized.end());
+
+		if (normalized == m_Roots)
+		{
+			return;
+		}
+
+		Stop();
+		m_Roots = std::move(normalized);
+		Start();
+	}
+
+	bool FileWatcher::Drain(std::vector<std::string>& out)
+	{
+		std::string path;
+		while (m_Events.TryPop(path))
+		{
+			out.push_back(std::move(path));
+		}
+		return m_Overflowed.exchange(false, std::memory_order_acq_rel);
+	}
+
+	void FileWatcher::Start()
+	{
+		if (m_Roots.empty())
+		{
+			return;
+		}
+
+		// Created here (not on the thread) so a refused watch is logged once, synchronously, and the consumer's
+		// IsActive() check sees the result on the very next frame.
+		std::unique_ptr<Backend> backend = Backend::Create(m_Roots);
+		if (!backend)
+		{
+			SS_CORE_WARN("FileWatcher: change notifications unavailable; hot reload falls back to polling");
+			return;
+		}
+
+		m_StopRequested.store(false, std::memory_order_relaxed);
+		m_Active.store(true, std::memory_order_release);
+		m_Thread = std::thread([this, b = std::move(backend)]() mutable
+		                       { Run(std::move(b)); });
+	}
+
+	void FileWatcher::Stop()
+	{
+		if (m_Thread.joinable())
+		{
+			m_StopRequested.store(true, std::memory_order_relaxed);
+			m_Thread.join();
+		}
+		m_Active.store(false, std::memory_order_release);
+	}
+
+	void FileWatcher::Run(std::unique_ptr<Backend> backend)
+	{
+		std::vector<std::filesystem::path> changed;
+		while (!m_StopRequested.load(std::memory_order_relaxed))
+		{
+			changed.clear();
+			bool overflowed = false;
+			if (!backend->Poll(changed, overflowed, kPollTimeoutMs))
+			{
+				SS_CORE_WARN("FileWatcher: backend failed; hot reload falls back to polling");
+				m_Overflowed.store(true, std::memory_order_release); // whatever was pending is gone -> rescan
+				m_Active.store(false, std::memory_order_release);
+				return;
+			}
+
+			for (const std::filesystem::path& path : changed)
+			{
+				if (!m_Events.TryPush(MakeKey(path)))
+				{
+					overflowed = true;
+				}
+			}
+			if (overflowed)
+			{
+				m_Overflowed.store(true, std::memory_order_release);
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Snowstorm/Core/SpscQueue.hpp"
+#include "Snowstorm/Service/Service.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Application-scoped directory watcher: the event source for hot reload. Instead of every consumer stat()ing
+	// every file it knows about on a timer (ShaderLibrary::ReloadAll's 1s mtime poll), one backend thread blocks
+	// in the OS change-notification API — ReadDirectoryChangesW on Windows, inotify on Linux — and pushes the
+	// absolute path of each touched file into a lock-free SPSC ring. The main thread drains the ring once a frame
+	// (ShaderReloadSystem) and hands the paths to whoever depends on them, so an edit reaches the shader library,
+	// the texture cache and the material cache within a frame and nothing is polled while nobody is editing.
+	//
+	// Paths come out as MakeKey strings (absolute, lexically normal, '/' separated) so a consumer can compare
+	// them against its own dependency keys with plain string equality.
+	//
+	// Nothing is lost silently: if the ring fills (an editor touching thousands of files) or the OS drops events
+	// (its own buffer overflowed), Drain reports an overflow and the consumer falls back to a full rescan.
+	class FileWatcher final : public Service
+	{
+	public:
+		FileWatcher() = default;
+		~FileWatcher() override;
+
+		// Watch these directories recursively. Main thread only; cheap to call every frame — the backend thread
+		// is only restarted when the set actually changed (e.g. a project switch moved the asset directory).
+		// Directories that don't exist are skipped.
+		void SetWatchRoots(std::vector<std::filesystem::path> roots);
+
+		// Move every queued change into `out` (appended; duplicates possible — one save is often several OS
+		// events). Returns true if events were dropped since the last drain, i.e. `out` is incomplete and the
+		// caller must rescan everything it cares about.
+		bool Drain(std::vector<std::string>& out);
+
+		// False when no backend is running (no roots, unsupported platform, or the OS refused the watch);
+		// consumers keep their polling fallback in that case.
+		[[nodiscard]] bool IsActive() const { return m_Active.load(std::memory_order_acquire); }
+
+		// Canonical comparison key for a path: absolute, lexically normal, generic ('/') separators.
+		static std::string MakeKey(const std::filesystem::path& path);
+
+		// Platform notification backend, defined in Platform/<OS>/<OS>FileWatcher.cpp. Owned by the watcher's
+		// thread; Poll blocks for at most `timeoutMs` so the thread can notice a stop request.
+		class Backend
+		{
+		public:
+			virtual ~Backend() = default;
+
+			// nullptr if no root could be watched.
+			static std::unique_ptr<Backend> Create(const std::vector<std::filesystem::path>& roots);
+
+			// Append the absolute paths of files changed since the last call. Sets `overflowed` when the OS
+			// reported lost events. Returns false on an unrecoverable error (the watcher then goes inactive).
+			virtual bool Poll(std::vector<std::filesystem::path>& out, bool& overflowed, uint32_t timeoutMs) = 0;
+		};
+
+	private:
+		void Start();
+		void Stop();
+		void Run(std::unique_ptr<Backend> backend);
+
+		std::vector<std::filesystem::path> m_Roots;
+
+		std::thread m_Thread;
+		std::atomic<bool> m_StopRequested{false};
+		std::atomic<bool> m_Active{false};
+
+		// Producer: m_Thread. Consumer: the main thread (Drain).
+		SpscQueue<std::string> m_Events{4096};
+		std::atomic<bool> m_Overflowed{false};
+	};
+}
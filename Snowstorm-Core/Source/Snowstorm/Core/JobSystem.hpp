@@ -30,7 +30,8 @@ namespace Snowstorm
 	// Threading contract: submitted tasks run on worker threads, so anything they touch must be safe to use
 	// off the main thread. In particular GPU resource creation (Vulkan) MUST stay on the main thread — the
 	// intended pattern is "cook/parse CPU data on a worker, then create GPU buffers on the main thread from
-	// the result" (see the async-load follow-up).
+	// the result" (see the async-load follow-up). The one exception is pipeline compilation
+	// (Pipeline::CreateAsync): vkCreate*Pipelines allocates no device memory and is free-threaded per the spec.
 	class JobSystem final : public Service
 	{
 	public:
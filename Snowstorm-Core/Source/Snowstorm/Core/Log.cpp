@@ -1,14 +1,314 @@
 #include "Log.hpp"
 
 #include "LogBuffer.hpp"
+#include "SpscQueue.hpp"
 
+#include "spdlog/details/os.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace Snowstorm
 {
 	std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
 
+	namespace
+	{
+		// Records per thread before the producer has to wait for the log thread. A cold load logs a few
+		// hundred lines per worker per frame at most; 1024 slots (~300 KB) absorb that without ever waiting.
+		constexpr size_t kRingCapacity = 1024;
+
+		// How long the log thread sleeps when there is nothing to do. Producers never wake it for an ordinary
+		// line (that would cost a syscall per line); only Flush and a full ring do.
+		constexpr std::chrono::milliseconds kIdleWait{4};
+
+		struct ThreadRing
+		{
+			SpscQueue<LogRecord> Queue{kRingCapacity};
+			std::atomic<bool> Abandoned{false}; // owner thread exited: drop the ring once drained
+		};
+
+		// The owning thread's ring; marks it abandoned on thread exit so the log thread can let it go.
+		struct RingHandle
+		{
+			std::shared_ptr<ThreadRing> Ring;
+
+			~RingHandle()
+			{
+				if (Ring)
+				{
+					Ring->Abandoned.store(true, std::memory_order_release);
+				}
+			}
+		};
+
+		thread_local RingHandle t_Ring;
+		thread_local bool t_OnLogThread = false;
+
+		const std::shared_ptr<spdlog::logger>& GetLogger(const uint8_t channel)
+		{
+			return channel == static_cast<uint8_t>(Log::Channel::Core) ? Log::GetCoreLogger() : Log::GetClientLogger();
+		}
+
+		// Format one record and hand it to its logger's sinks -- the work spdlog's logger::log would have
+		// done on the calling thread, with the caller's timestamp and thread id.
+		void Emit(const LogRecord& record)
+		{
+			const std::shared_ptr<spdlog::logger>& logger = GetLogger(record.Channel);
+			if (!logger)
+			{
+				return;
+			}
+
+			spdlog::memory_buf_t text;
+			if (record.Format)
+			{
+				try
+				{
+					record.Format(record.FormatString, record.ArgBytes.data(), text);
+				}
+				catch (const std::exception& e)
+				{
+					// A bad format string only shows up here, on the log thread; say so rather than drop the line.
+					text.clear();
+					fmt::format_to(fmt::appender(text), "[log format error: {}] {}", e.what(), record.FormatString);
+				}
+			}
+			else
+			{
+				text.append(record.Text.data(), record.Text.data() + record.Text.size());
+			}
+
+			spdlog::details::log_msg msg(record.Time, spdlog::source_loc{}, logger->name(), record.Level,
+			                             spdlog::string_view_t(text.data(), text.size()));
+			msg.thread_id = record.ThreadId;
+			for (const spdlog::sink_ptr& sink : logger->sinks())
+			{
+				if (sink->should_log(msg.level))
+				{
+					sink->log(msg);
+				}
+			}
+			if (record.Level >= logger->flush_level() && record.Level != spdlog::level::off)
+			{
+				logger->flush();
+			}
+		}
+
+		// The consumer side of the pipeline: every thread that logs gets its own SPSC ring (so producers never
+		// contend with each other or take a lock), and one log thread drains all rings, orders each batch by
+		// timestamp and formats it.
+		//
+		// Leaked on purpose: thread_local ring handles and the atexit Shutdown may run after static
+		// destructors would have torn it down.
+		class LogBackend
+		{
+		public:
+			static LogBackend& Get()
+			{
+				static auto* backend = new LogBackend();
+				return *backend;
+			}
+
+			void Start()
+			{
+				if (m_Running.load(std::memory_order_acquire))
+				{
+					return;
+				}
+				{
+					std::lock_guard lock(m_WakeMutex);
+					m_Stopping = false;
+					m_Exited = false;
+				}
+				m_Thread = std::thread([this] { Run(); });
+				m_Running.store(true, std::memory_order_release);
+			}
+
+			void Stop()
+			{
+				if (!m_Running.exchange(false, std::memory_order_acq_rel))
+				{
+					return;
+				}
+				{
+					std::lock_guard lock(m_WakeMutex);
+					m_Stopping = true;
+				}
+				m_Wake.notify_one();
+				m_Thread.join();
+
+				// A producer that checked m_Running just before it flipped may have pushed after the last pass.
+				std::vector<LogRecord> batch;
+				DrainRings(batch);
+				EmitBatch(batch);
+			}
+
+			void Submit(LogRecord&& record)
+			{
+				if (!m_Running.load(std::memory_order_acquire) || t_OnLogThread)
+				{
+					// Before Init / after Shutdown, or a sink that logs: no log thread to hand it to.
+					Emit(record);
+					return;
+				}
+
+				ThreadRing& ring = LocalRing();
+				while (!ring.Queue.TryPush(std::move(record)))
+				{
+					// Full: wait for the log thread rather than drop the line.
+					RequestPass();
+					std::this_thread::yield();
+					if (!m_Running.load(std::memory_order_acquire))
+					{
+						Emit(record);
+						return;
+					}
+				}
+			}
+
+			// Wait for a drain pass that starts after this call, i.e. one that sees everything this thread
+			// pushed before calling.
+			void Flush()
+			{
+				if (!m_Running.load(std::memory_order_acquire) || t_OnLogThread)
+				{
+					return;
+				}
+				std::unique_lock lock(m_WakeMutex);
+				const uint64_t ticket = m_PassesBegun + 1;
+				m_WakeRequested = true;
+				m_Wake.notify_one();
+				m_Progress.wait(lock, [&] { return m_PassesDone >= ticket || m_Exited; });
+			}
+
+		private:
+			LogBackend() = default;
+
+			ThreadRing& LocalRing()
+			{
+				if (!t_Ring.Ring)
+				{
+					t_Ring.Ring = std::make_shared<ThreadRing>();
+					std::lock_guard lock(m_RingsMutex);
+					m_Rings.push_back(t_Ring.Ring);
+				}
+				return *t_Ring.Ring;
+			}
+
+			void RequestPass()
+			{
+				{
+					std::lock_guard lock(m_WakeMutex);
+					m_WakeRequested = true;
+				}
+				m_Wake.notify_one();
+			}
+
+			void Run()
+			{
+				t_OnLogThread = true;
+				std::vector<LogRecord> batch;
+				bool drained = false;
+				for (;;)
+				{
+					uint64_t pass = 0;
+					bool stopping = false;
+					{
+						std::unique_lock lock(m_WakeMutex);
+						// Straight on while lines keep coming; otherwise sleep until asked or the idle wait ends.
+						if (!drained)
+						{
+							m_Wake.wait_for(lock, kIdleWait, [this] { return m_WakeRequested || m_Stopping; });
+						}
+						m_WakeRequested = false;
+						stopping = m_Stopping;
+						pass = ++m_PassesBegun;
+					}
+
+					DrainRings(batch);
+					drained = !batch.empty();
+					EmitBatch(batch);
+
+					{
+						std::lock_guard lock(m_WakeMutex);
+						m_PassesDone = pass;
+						if (stopping && !drained)
+						{
+							m_Exited = true;
+						}
+					}
+					m_Progress.notify_all();
+
+					if (stopping && !drained)
+					{
+						return;
+					}
+				}
+			}
+
+			// Pop up to one ring's worth from every ring (a thread that never stops logging can't starve the
+			// others), and release the rings of threads that have exited once they are empty.
+			void DrainRings(std::vector<LogRecord>& batch)
+			{
+				std::lock_guard lock(m_RingsMutex);
+				for (size_t i = 0; i < m_Rings.size();)
+				{
+					ThreadRing& ring = *m_Rings[i];
+					// Read before popping: once abandoned, no more pushes follow, so empty after this pass means done.
+					const bool abandoned = ring.Abandoned.load(std::memory_order_acquire);
+					LogRecord record;
+					for (size_t n = 0; n < kRingCapacity && ring.Queue.TryPop(record); ++n)
+					{
+						batch.push_back(std::move(record));
+					}
+					if (abandoned && ring.Queue.SizeApprox() == 0)
+					{
+						m_Rings[i] = std::move(m_Rings.back());
+						m_Rings.pop_back();
+						continue;
+					}
+					++i;
+				}
+			}
+
+			// Interleave the threads' lines by the time they were logged (each ring is already in order).
+			static void EmitBatch(std::vector<LogRecord>& batch)
+			{
+				std::ranges::stable_sort(batch, {}, &LogRecord::Time);
+				for (const LogRecord& record : batch)
+				{
+					Emit(record);
+				}
+				batch.clear();
+			}
+
+			std::mutex m_RingsMutex;
+			std::vector<std::shared_ptr<ThreadRing>> m_Rings;
+
+			std::thread m_Thread;
+			std::atomic<bool> m_Running{false};
+
+			// Wake-ups and drain progress, guarded by m_WakeMutex.
+			std::mutex m_WakeMutex;
+			std::condition_variable m_Wake;
+			std::condition_variable m_Progress;
+			bool m_WakeRequested = false;
+			bool m_Stopping = false;
+			bool m_Exited = false;
+			uint64_t m_PassesBegun = 0;
+			uint64_t m_PassesDone = 0;
+		};
+	}
+
 	void Log::Init()
 	{
 		// Include the level name (%l) so logs are machine-greppable (e.g. by the smoke test),
@@ -23,5 +323,78 @@ namespace Snowstorm
 		// Add an in-memory sink (alongside stdout) so the editor's Console panel can show the log stream.
 		// Harmless in headless/runtime builds — it just captures into a bounded buffer nobody reads.
 		InstallLogBufferSink();
+
+		LogBackend::Get().Start();
+
+		// Drain on exit even when nobody calls Shutdown. LogBuffer is created first so that it is destroyed
+		// after the atexit handler has pushed the last lines into it.
+		static bool s_AtExitRegistered = false;
+		if (!s_AtExitRegistered)
+		{
+			LogBuffer::Get();
+			std::atexit(&Log::Shutdown);
+			s_AtExitRegistered = true;
+		}
+	}
+
+	void Log::Flush()
+	{
+		LogBackend::Get().Flush();
+		for (const auto& logger : {s_CoreLogger, s_ClientLogger})
+		{
+			if (logger)
+			{
+				logger->flush();
+			}
+		}
+	}
+
+	void Log::Shutdown()
+	{
+		LogBackend::Get().Stop();
+		for (const auto& logger : {s_CoreLogger, s_ClientLogger})
+		{
+			if (logger)
+			{
+				logger->flush();
+			}
+		}
+	}
+
+	bool Log::ShouldLog(const Channel channel, const spdlog::level::level_enum level)
+	{
+		const std::shared_ptr<spdlog::logger>& logger = GetLogger(static_cast<uint8_t>(channel));
+		return logger && logger->should_log(level);
+	}
+
+	void Log::Submit(const Channel channel, const spdlog::level::level_enum level, LogRecord&& record)
+	{
+		record.Time = spdlog::log_clock::now();
+		record.ThreadId = spdlog::details::os::thread_id();
+		record.Channel = static_cast<uint8_t>(channel);
+		record.Level = level;
+		LogBackend::Get().Submit(std::move(record));
+
+		// An error may be the last thing the process says (an assert breaks right after): get it out now.
+		if (level >= spdlog::level::err)
+		{
+			Flush();
+		}
+	}
+
+	void Log::SubmitText(const Channel channel, const spdlog::level::level_enum level, const std::string_view text)
+	{
+		LogRecord record;
+		if (sizeof(uint32_t) + text.size() <= LogRecord::kInlineArgs)
+		{
+			record.Format = &LogDetail::FormatDeferred<std::string_view>;
+			record.FormatString = "{}";
+			LogDetail::Encode(record.ArgBytes.data(), text);
+		}
+		else
+		{
+			record.Text.assign(text);
+		}
+		Submit(channel, level, std::move(record));
 	}
 }
@@ -4,32 +4,227 @@
 #include "spdlog/spdlog.h"
 #include "spdlog/fmt/ostr.h"
 
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
 namespace Snowstorm
 {
+	// One log call on its way from the calling thread to the log thread: the format string (a literal, so it
+	// is the record's "format id" -- only its pointer travels) plus the arguments packed as raw bytes, and the
+	// function that knows how to unpack and format them. Formatting, the pattern and every sink run on the log
+	// thread; the caller only copies a few bytes.
+	struct LogRecord
+	{
+		static constexpr size_t kInlineArgs = 192;
+
+		using FormatFn = void (*)(std::string_view format, const uint8_t* args, spdlog::memory_buf_t& out);
+
+		FormatFn Format = nullptr; // null: Text already holds the message
+		std::string_view FormatString;
+		spdlog::log_clock::time_point Time;
+		size_t ThreadId = 0;
+		uint8_t Channel = 0;
+		spdlog::level::level_enum Level = spdlog::level::info;
+		std::string Text; // messages too big to defer (formatted by the caller)
+		std::array<uint8_t, kInlineArgs> ArgBytes; // the arguments, packed by LogDetail::Encode
+	};
+
+	// Argument packing for LogRecord. Arithmetic values and void pointers are copied as-is; anything that
+	// reads as a string is copied as length + bytes and comes back as a string_view into the record, which
+	// fmt formats exactly like the original std::string / const char*. Other types (those with their own fmt
+	// formatter) aren't deferred: the caller formats the message and sends the text.
+	namespace LogDetail
+	{
+		template <typename T>
+		using Plain = std::remove_cvref_t<T>;
+
+		template <typename T>
+		constexpr bool kIsText = std::is_convertible_v<const Plain<T>&, std::string_view>;
+
+		template <typename T>
+		constexpr bool kIsDeferrable = std::is_arithmetic_v<Plain<T>> || kIsText<T> || std::is_same_v<Plain<T>, const void*> ||
+		                               std::is_same_v<Plain<T>, void*>;
+
+		template <typename T>
+		using Decoded = std::conditional_t<kIsText<T>, std::string_view, Plain<T>>;
+
+		template <typename T>
+		std::string_view AsText(const T& value)
+		{
+			if constexpr (std::is_pointer_v<std::decay_t<T>>)
+			{
+				return value ? std::string_view(value) : std::string_view("(null)");
+			}
+			else
+			{
+				return std::string_view(value);
+			}
+		}
+
+		template <typename T>
+		size_t EncodedSize(const T& value)
+		{
+			if constexpr (kIsText<T>)
+			{
+				return sizeof(uint32_t) + AsText(value).size();
+			}
+			else
+			{
+				return sizeof(Plain<T>);
+			}
+		}
+
+		template <typename T>
+		uint8_t* Encode(uint8_t* out, const T& value)
+		{
+			if constexpr (kIsText<T>)
+			{
+				const std::string_view text = AsText(value);
+				const auto size = static_cast<uint32_t>(text.size());
+				std::memcpy(out, &size, sizeof(size));
+				std::memcpy(out + sizeof(size), text.data(), size);
+				return out + sizeof(size) + size;
+			}
+			else
+			{
+				const Plain<T> copy = value;
+				std::memcpy(out, &copy, sizeof(copy));
+				return out + sizeof(copy);
+			}
+		}
+
+		template <typename T>
+		T Decode(const uint8_t*& cursor)
+		{
+			if constexpr (std::is_same_v<T, std::string_view>)
+			{
+				uint32_t size = 0;
+				std::memcpy(&size, cursor, sizeof(size));
+				const std::string_view text(reinterpret_cast<const char*>(cursor + sizeof(size)), size);
+				cursor += sizeof(size) + size;
+				return text;
+			}
+			else
+			{
+				T value;
+				std::memcpy(&value, cursor, sizeof(T));
+				cursor += sizeof(T);
+				return value;
+			}
+		}
+
+		template <typename... Ts>
+		void FormatDeferred(const std::string_view format, const uint8_t* args, spdlog::memory_buf_t& out)
+		{
+			const uint8_t* cursor = args;
+			// Braced initialization evaluates left to right: the arguments unpack in the order they were packed.
+			const std::tuple<Ts...> values{Decode<Ts>(cursor)...};
+			std::apply([&](const auto&... value)
+			           { fmt::vformat_to(fmt::appender(out), fmt::string_view(format.data(), format.size()), fmt::make_format_args(value...)); },
+			           values);
+		}
+	}
+
+	// Engine logging. The SS_* macros don't format on the calling thread: they pack the call into a
+	// LogRecord and push it into the calling thread's own lock-free ring (SpscQueue); one log thread drains
+	// every ring, orders the batch by timestamp, formats the lines and hands them to the spdlog sinks (stdout,
+	// the editor console's LogBuffer). A JobSystem worker streaming assets pays a memcpy per line, not a
+	// format + a console write under a lock.
+	//
+	// Errors and criticals wait for the log thread before returning (Flush), so the line is out before an
+	// assert breaks or the process dies. A full ring makes its thread wait for the log thread -- lines are
+	// never dropped. Before Init and after Shutdown (and on the log thread itself) lines are written
+	// synchronously.
 	class Log
 	{
 	public:
+		enum class Channel : uint8_t
+		{
+			Core,
+			Client
+		};
+
+		// Create the loggers and start the log thread. Shutdown is registered to run at exit.
 		static void Init();
 
+		// Block until every line logged before the call has reached the sinks, then flush them.
+		static void Flush();
+
+		// Drain and stop the log thread; later lines are written synchronously.
+		static void Shutdown();
+
 		static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
 		static std::shared_ptr<spdlog::logger>& GetClientLogger() { return s_ClientLogger; }
 
+		template <typename... Args>
+		static void Write(const Channel channel, const spdlog::level::level_enum level, spdlog::format_string_t<Args...> format, Args&&... args)
+		{
+			if (!ShouldLog(channel, level))
+			{
+				return;
+			}
+
+			const fmt::string_view formatView = format;
+			if constexpr ((LogDetail::kIsDeferrable<Args> && ...))
+			{
+				const size_t size = (size_t{0} + ... + LogDetail::EncodedSize(args));
+				if (size <= LogRecord::kInlineArgs)
+				{
+					LogRecord record;
+					record.Format = &LogDetail::FormatDeferred<LogDetail::Decoded<Args>...>;
+					record.FormatString = std::string_view(formatView.data(), formatView.size());
+					uint8_t* out = record.ArgBytes.data();
+					((out = LogDetail::Encode(out, args)), ...);
+					Submit(channel, level, std::move(record));
+					return;
+				}
+			}
+			SubmitText(channel, level, fmt::format(format, std::forward<Args>(args)...));
+		}
+
+		// A single argument is the message itself, not a format string (as in spdlog).
+		template <typename T>
+		static void Write(const Channel channel, const spdlog::level::level_enum level, const T& message)
+		{
+			if (!ShouldLog(channel, level))
+			{
+				return;
+			}
+
+			if constexpr (LogDetail::kIsText<T>)
+			{
+				SubmitText(channel, level, LogDetail::AsText(message));
+			}
+			else
+			{
+				SubmitText(channel, level, fmt::format("{}", message));
+			}
+		}
+
 	private:
+		static bool ShouldLog(Channel channel, spdlog::level::level_enum level);
+		static void Submit(Channel channel, spdlog::level::level_enum level, LogRecord&& record);
+		static void SubmitText(Channel channel, spdlog::level::level_enum level, std::string_view text);
+
 		static std::shared_ptr<spdlog::logger> s_CoreLogger;
 		static std::shared_ptr<spdlog::logger> s_ClientLogger;
 	};
 }
 
 // Core log macros
-#define SS_CORE_TRACE(...) ::Snowstorm::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define SS_CORE_INFO(...) ::Snowstorm::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define SS_CORE_WARN(...) ::Snowstorm::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define SS_CORE_ERROR(...) ::Snowstorm::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define SS_CORE_CRITICAL(...) ::Snowstorm::Log::GetCoreLogger()->critical(__VA_ARGS__)
+#define SS_CORE_TRACE(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Core, ::spdlog::level::trace, __VA_ARGS__)
+#define SS_CORE_INFO(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Core, ::spdlog::level::info, __VA_ARGS__)
+#define SS_CORE_WARN(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Core, ::spdlog::level::warn, __VA_ARGS__)
+#define SS_CORE_ERROR(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Core, ::spdlog::level::err, __VA_ARGS__)
+#define SS_CORE_CRITICAL(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Core, ::spdlog::level::critical, __VA_ARGS__)
 
 // Client log macros
-#define SS_TRACE(...) ::Snowstorm::Log::GetClientLogger()->trace(__VA_ARGS__)
-#define SS_INFO(...) ::Snowstorm::Log::GetClientLogger()->info(__VA_ARGS__)
-#define SS_WARN(...) ::Snowstorm::Log::GetClientLogger()->warn(__VA_ARGS__)
-#define SS_ERROR(...) ::Snowstorm::Log::GetClientLogger()->error(__VA_ARGS__)
-#define SS_CRITICAL(...) ::Snowstorm::Log::GetClientLogger()->critical(__VA_ARGS__)
+#define SS_TRACE(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Client, ::spdlog::level::trace, __VA_ARGS__)
+#define SS_INFO(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Client, ::spdlog::level::info, __VA_ARGS__)
+#define SS_WARN(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Client, ::spdlog::level::warn, __VA_ARGS__)
+#define SS_ERROR(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Client, ::spdlog::level::err, __VA_ARGS__)
+#define SS_CRITICAL(...) ::Snowstorm::Log::Write(::Snowstorm::Log::Channel::Client, ::spdlog::level::critical, __VA_ARGS__)
@@ -4,6 +4,7 @@
 
 #include "spdlog/sinks/base_sink.h"
 
+#include <algorithm>
 #include <mutex>
 
 namespace Snowstorm
@@ -14,31 +15,64 @@ namespace Snowstorm
 		return instance;
 	}
 
-	void LogBuffer::Push(const Level level, std::string text)
+	LogBuffer::LogBuffer()
+	    : m_Slots(kCapacity)
+	{
+	}
+
+	void LogBuffer::Push(const Level level, const std::string_view text)
 	{
 		std::lock_guard lock(m_Mutex);
-		m_Entries.push_back({level, std::move(text)});
-		if (m_Entries.size() > m_Capacity)
+		Entry* slot = nullptr;
+		if (m_Count < kCapacity)
+		{
+			slot = &m_Slots[(m_Head + m_Count) % kCapacity];
+			++m_Count;
+		}
+		else
 		{
-			// Evict oldest. erase-from-front on a vector is O(n) but only fires once per line past capacity
-			// (steady state), and 5000-element shifts are trivial next to the ImGui render — not worth a
-			// deque/ring index for this.
-			m_Entries.erase(m_Entries.begin());
+			slot = &m_Slots[m_Head];
+			m_Head = (m_Head + 1) % kCapacity;
 		}
+		slot->LevelValue = level;
+		slot->Text.assign(text); // reuses the evicted line's buffer once the ring has wrapped
 		++m_Revision;
 	}
 
+	LogBuffer::ReadResult LogBuffer::ReadSince(const uint64_t revision, std::vector<Entry>& out) const
+	{
+		std::lock_guard lock(m_Mutex);
+		ReadResult result{m_Revision, revision < m_ClearedRevision};
+		// Since the last Clear every revision step is one Push, so the distance is the number of new lines.
+		const uint64_t since = result.Cleared ? m_ClearedRevision : revision;
+		const uint64_t pushed = m_Revision > since ? m_Revision - since : 0;
+		CopyNewest(static_cast<size_t>(std::min<uint64_t>(pushed, m_Count)), out);
+		return result;
+	}
+
 	std::vector<LogBuffer::Entry> LogBuffer::Snapshot() const
 	{
+		std::vector<Entry> entries;
 		std::lock_guard lock(m_Mutex);
-		return m_Entries; // copy under lock; caller renders without holding it
+		CopyNewest(m_Count, entries);
+		return entries;
+	}
+
+	void LogBuffer::CopyNewest(const size_t count, std::vector<Entry>& out) const
+	{
+		out.reserve(out.size() + count);
+		for (size_t i = m_Count - count; i < m_Count; ++i)
+		{
+			out.push_back(m_Slots[(m_Head + i) % kCapacity]);
+		}
 	}
 
 	void LogBuffer::Clear()
 	{
 		std::lock_guard lock(m_Mutex);
-		m_Entries.clear();
-		++m_Revision;
+		m_Head = 0;
+		m_Count = 0;
+		m_ClearedRevision = ++m_Revision;
 	}
 
 	uint64_t LogBuffer::Revision() const
@@ -71,8 +105,9 @@ namespace Snowstorm
 		}
 
 		// spdlog sink that formats each message with the logger's pattern and appends it to the LogBuffer.
-		// base_sink<std::mutex> serializes sink_it_ across threads, so LogBuffer::Push is only ever hit one
-		// message at a time from here (and Push is itself locked, guarding the editor's concurrent reads).
+		// Normally only the log thread calls it; base_sink<std::mutex> still serializes the synchronous
+		// writes made before Log::Init / after Shutdown (and Push is itself locked, guarding the editor's
+		// concurrent reads).
 		class LogBufferSink final : public spdlog::sinks::base_sink<std::mutex>
 		{
 		protected:
@@ -80,13 +115,13 @@ namespace Snowstorm
 			{
 				spdlog::memory_buf_t formatted;
 				formatter_->format(msg, formatted);
-				std::string text = fmt::to_string(formatted);
 				// Drop the trailing newline the pattern appends — the console renders one entry per line.
-				while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+				size_t length = formatted.size();
+				while (length > 0 && (formatted[length - 1] == '\n' || formatted[length - 1] == '\r'))
 				{
-					text.pop_back();
+					--length;
 				}
-				LogBuffer::Get().Push(ToBufferLevel(msg.level), std::move(text));
+				LogBuffer::Get().Push(ToBufferLevel(msg.level), std::string_view(formatted.data(), length));
 			}
 
 			void flush_() override {}
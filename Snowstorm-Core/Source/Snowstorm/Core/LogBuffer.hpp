@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace Snowstorm
@@ -11,11 +12,15 @@ namespace Snowstorm
 	// IDE terminal. A custom spdlog sink (see LogBuffer.cpp) pushes every formatted line here alongside the
 	// existing stdout sink — IDE logging is unchanged; the editor just gets a second view.
 	//
-	// Thread-safe: log calls come from the main thread AND JobSystem workers, so both the sink's writes and
-	// the editor's reads are mutex-guarded. Bounded (ring buffer) so a long session can't grow unbounded.
+	// Thread-safe: the sink writes from the log thread (or any thread before Log::Init / after Shutdown)
+	// while the editor reads, so both are mutex-guarded. A fixed ring of kCapacity slots: a push past the
+	// capacity overwrites the oldest line in place (reusing its string's storage), and a reader fetches only
+	// the lines it hasn't seen yet (ReadSince) instead of copying the whole buffer every frame.
 	class LogBuffer
 	{
 	public:
+		static constexpr size_t kCapacity = 5000; // last N lines kept
+
 		// Mirrors spdlog::level so the console can color/filter without pulling in spdlog headers.
 		enum class Level : uint8_t
 		{
@@ -33,28 +38,43 @@ namespace Snowstorm
 			std::string Text; // fully formatted line, e.g. "[12:00:00] [info] SNOWSTORM: message"
 		};
 
+		struct ReadResult
+		{
+			uint64_t Revision = 0; // pass to the next ReadSince
+			bool Cleared = false;  // the buffer was cleared since `revision`: drop what you had before appending
+		};
+
 		static LogBuffer& Get();
 
-		// Called by the sink (any thread). Appends one entry, evicting the oldest past the capacity.
-		void Push(Level level, std::string text);
+		// Called by the sink. Appends one entry, overwriting the oldest past the capacity.
+		void Push(Level level, std::string_view text);
+
+		// Append to `out` the entries pushed after `revision` (a Revision() / ReadResult::Revision value, 0 for
+		// everything), oldest first. A reader that fell more than kCapacity lines behind gets the newest
+		// kCapacity. Copies only the new lines, under the lock; the caller renders without holding it.
+		ReadResult ReadSince(uint64_t revision, std::vector<Entry>& out) const;
 
-		// Snapshot the current entries (copy under lock) for the editor to render. A copy keeps the UI
-		// decoupled from concurrent writes without holding the lock across ImGui calls.
+		// Every current entry, oldest first.
 		[[nodiscard]] std::vector<Entry> Snapshot() const;
 
 		void Clear();
 
-		// Monotonic counter bumped on every Push; lets the console detect "new lines arrived" cheaply
-		// (for autoscroll) without diffing the whole buffer.
+		// Monotonic counter bumped on every Push and Clear; lets the console detect "new lines arrived"
+		// cheaply (for autoscroll and ReadSince) without diffing the buffer.
 		[[nodiscard]] uint64_t Revision() const;
 
 	private:
-		LogBuffer() = default;
+		LogBuffer();
+
+		// The `count` newest entries, oldest first. Caller holds m_Mutex.
+		void CopyNewest(size_t count, std::vector<Entry>& out) const;
 
 		mutable std::mutex m_Mutex;
-		std::vector<Entry> m_Entries; // ring buffer (oldest evicted at capacity)
-		size_t m_Capacity = 5000;     // last N lines kept
+		std::vector<Entry> m_Slots; // kCapacity slots
+		size_t m_Head = 0;          // oldest entry
+		size_t m_Count = 0;
 		uint64_t m_Revision = 0;
+		uint64_t m_ClearedRevision = 0; // m_Revision right after the last Clear
 	};
 
 	// Install the in-memory sink onto both engine loggers. Called from Log::Init() after the loggers exist.
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace Snowstorm
+{
+	// Bounded multi-producer / single-consumer ring (Vyukov's bounded queue, one consumer). ANY number of
+	// threads may call TryPush concurrently and exactly ONE thread TryPop. Producers claim a slot with a CAS
+	// on the tail and publish it through the slot's sequence number, so a push never takes a lock and never
+	// waits on another producer's copy; the consumer reads slots in claim order.
+	//
+	// As with SpscQueue, full is reported, not waited out: TryPush returns false and the producer decides
+	// what to do with the item.
+	template <typename T>
+	class MpscQueue
+	{
+	public:
+		// Capacity is rounded up to a power of two (index wrap is a mask, not a modulo).
+		explicit MpscQueue(const size_t capacity)
+		    : m_Capacity(RoundUpPow2(capacity)), m_Mask(m_Capacity - 1), m_Slots(std::make_unique<Slot[]>(m_Capacity))
+		{
+			for (size_t i = 0; i < m_Capacity; ++i)
+			{
+				m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MpscQueue(const MpscQueue&) = delete;
+		MpscQueue& operator=(const MpscQueue&) = delete;
+
+		// Any thread. False when the ring is full (the value is left untouched).
+		bool TryPush(T&& value)
+		{
+			size_t tail = m_Tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				Slot& slot = m_Slots[tail & m_Mask];
+				const size_t sequence = slot.Sequence.load(std::memory_order_acquire);
+				const auto lag = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(tail);
+				if (lag == 0)
+				{
+					// The slot is free for this lap: claim it, then fill and publish it.
+					if (m_Tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+					{
+						slot.Value = std::move(value);
+						slot.Sequence.store(tail + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (lag < 0)
+				{
+					return false; // the consumer hasn't freed this slot from the previous lap: full
+				}
+				else
+				{
+					tail = m_Tail.load(std::memory_order_relaxed); // another producer claimed it first
+				}
+			}
+		}
+
+		bool TryPush(const T& value)
+		{
+			T copy = value;
+			return TryPush(std::move(copy));
+		}
+
+		// Consumer thread only. False when the ring is empty -- or when the oldest claimed slot is still
+		// being filled by its producer (it shows up on the next call).
+		bool TryPop(T& out)
+		{
+			const size_t head = m_Head.load(std::memory_order_relaxed);
+			Slot& slot = m_Slots[head & m_Mask];
+			if (slot.Sequence.load(std::memory_order_acquire) != head + 1)
+			{
+				return false;
+			}
+			out = std::move(slot.Value);
+			slot.Sequence.store(head + m_Capacity, std::memory_order_release); // free for the next lap
+			m_Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Snapshot only (claimed slots, including ones still being filled).
+		[[nodiscard]] size_t SizeApprox() const
+		{
+			return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] size_t Capacity() const { return m_Capacity; }
+
+	private:
+		struct Slot
+		{
+			std::atomic<size_t> Sequence{0}; // == index: free; == index + 1: filled; advances one lap per pop
+			T Value{};
+		};
+
+		static size_t RoundUpPow2(const size_t n)
+		{
+			size_t p = 1;
+			while (p < n)
+			{
+				p <<= 1;
+			}
+			return p;
+		}
+
+		size_t m_Capacity;
+		size_t m_Mask;
+		std::unique_ptr<Slot[]> m_Slots;
+
+		// Head and tail on separate cache lines: the tail is contended by the producers, the head written by
+		// the consumer alone.
+		alignas(64) std::atomic<size_t> m_Head{0}; // next slot to pop (written by the consumer)
+		alignas(64) std::atomic<size_t> m_Tail{0}; // next slot to claim (CAS by the producers)
+	};
+}
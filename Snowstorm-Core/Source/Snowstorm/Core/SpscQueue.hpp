@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Bounded single-producer / single-consumer ring (cf. Rigtorp's SPSCQueue / folly::ProducerConsumerQueue).
+	// Exactly ONE thread may call TryPush and exactly ONE (other) thread TryPop; under that contract neither side
+	// ever takes a lock or blocks — the producer publishes a slot with a release store of the tail, the consumer
+	// claims it with an acquire load, and vice versa for the head. The FileWatcher's backend thread is the
+	// producer and the main thread the consumer, so a burst of file events never contends with the frame loop.
+	//
+	// Full is reported, not waited out: TryPush returns false and the producer decides what losing an item
+	// means (the watcher flags an overflow so the consumer falls back to a full rescan).
+	template <typename T>
+	class SpscQueue
+	{
+	public:
+		// Capacity is rounded up to a power of two (index wrap is a mask, not a modulo).
+		explicit SpscQueue(const size_t capacity)
+		    : m_Slots(RoundUpPow2(capacity)), m_Mask(m_Slots.size() - 1)
+		{
+		}
+
+		SpscQueue(const SpscQueue&) = delete;
+		SpscQueue& operator=(const SpscQueue&) = delete;
+
+		// Producer thread only. False when the ring is full (the value is left untouched).
+		bool TryPush(T&& value)
+		{
+			const size_t tail = m_Tail.load(std::memory_order_relaxed);
+			if (tail - m_Head.load(std::memory_order_acquire) == m_Slots.size())
+			{
+				return false;
+			}
+			m_Slots[tail & m_Mask] = std::move(value);
+			m_Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool TryPush(const T& value)
+		{
+			T copy = value;
+			return TryPush(std::move(copy));
+		}
+
+		// Consumer thread only. False when the ring is empty.
+		bool TryPop(T& out)
+		{
+			const size_t head = m_Head.load(std::memory_order_relaxed);
+			if (head == m_Tail.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+			out = std::move(m_Slots[head & m_Mask]);
+			m_Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Snapshot only (either side may call it; the other side can move it immediately after).
+		[[nodiscard]] size_t SizeApprox() const
+		{
+			return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] size_t Capacity() const { return m_Slots.size(); }
+
+	private:
+		static size_t RoundUpPow2(const size_t n)
+		{
+			size_t p = 1;
+			while (p < n)
+			{
+				p <<= 1;
+			}
+			return p;
+		}
+
+		std::vector<T> m_Slots;
+		size_t m_Mask;
+
+		// Head and tail on separate cache lines: each is written by one side and only read by the other, so
+		// sharing a line would bounce it between the two cores on every push/pop.
+		alignas(64) std::atomic<size_t> m_Head{0}; // next slot to pop (written by the consumer)
+		alignas(64) std::atomic<size_t> m_Tail{0}; // next slot to push (written by the producer)
+	};
+}
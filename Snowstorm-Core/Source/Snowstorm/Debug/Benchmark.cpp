@@ -0,0 +1,190 @@
+#include "Benchmark.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <sstream>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Same escaping and number format as PerfBench.cpp, so the two JSON producers stay byte-compatible.
+		std::string JsonEscape(const std::string& s)
+		{
+			std::string out;
+			out.reserve(s.size() + 2);
+			for (const char c : s)
+			{
+				if (c == '"' || c == '\\')
+				{
+					out += '\\';
+				}
+				out += c;
+			}
+			return out;
+		}
+
+		std::string Ms(const double v)
+		{
+			std::ostringstream ss;
+			ss.setf(std::ios::fixed);
+			ss.precision(4);
+			ss << v;
+			return ss.str();
+		}
+
+		// Median of an already sorted, non-empty list.
+		double SortedMedian(const std::vector<double>& sorted)
+		{
+			const size_t n = sorted.size();
+			return n % 2 == 1 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+		}
+
+		// Written through by DoNotOptimizeAddress. An atomic store from a different TU is something no
+		// optimizer may drop, and it costs one relaxed store per call.
+		std::atomic<const void*> g_Sink{nullptr};
+	}
+
+	BenchmarkStats ComputeBenchmarkStats(std::vector<double> samplesMs)
+	{
+		BenchmarkStats stats;
+		if (samplesMs.empty())
+		{
+			return stats;
+		}
+
+		std::ranges::sort(samplesMs);
+		stats.Samples = static_cast<uint32_t>(samplesMs.size());
+		stats.MinMs = samplesMs.front();
+		stats.MaxMs = samplesMs.back();
+		stats.MedianMs = SortedMedian(samplesMs);
+
+		for (double& s : samplesMs)
+		{
+			s = std::abs(s - stats.MedianMs);
+		}
+		std::ranges::sort(samplesMs);
+		stats.MadMs = SortedMedian(samplesMs);
+		return stats;
+	}
+
+	void DoNotOptimizeAddress(const void* address)
+	{
+		g_Sink.store(address, std::memory_order_relaxed);
+	}
+
+	bool BenchmarkContext::BeginMeasure()
+	{
+		if (m_Measured)
+		{
+			Fail("Measure called more than once");
+			return false;
+		}
+		m_Measured = true;
+		m_Samples.reserve(m_Repetitions);
+		return !m_Failed;
+	}
+
+	void BenchmarkContext::Fail(std::string reason)
+	{
+		if (!m_Failed)
+		{
+			m_Failed = true;
+			m_FailureReason = std::move(reason);
+		}
+	}
+
+	void BenchmarkRunner::Add(std::string name, Function function)
+	{
+		m_Benchmarks.push_back({std::move(name), std::move(function)});
+	}
+
+	std::vector<std::string> BenchmarkRunner::Names(const std::string& filter) const
+	{
+		std::vector<std::string> names;
+		for (const Entry& entry : m_Benchmarks)
+		{
+			if (filter.empty() || entry.Name.find(filter) != std::string::npos)
+			{
+				names.push_back(entry.Name);
+			}
+		}
+		return names;
+	}
+
+	std::vector<BenchmarkResult> BenchmarkRunner::Run(const BenchmarkOptions& options) const
+	{
+		std::vector<BenchmarkResult> results;
+		for (const Entry& entry : m_Benchmarks)
+		{
+			if (!options.Filter.empty() && entry.Name.find(options.Filter) == std::string::npos)
+			{
+				continue;
+			}
+
+			BenchmarkContext context(options.Warmup, std::max(1u, options.Repetitions));
+			entry.Fn(context);
+			if (!context.Failed() && context.Samples().empty())
+			{
+				context.Fail("never called Measure");
+			}
+
+			BenchmarkResult& result = results.emplace_back();
+			result.Name = entry.Name;
+			result.Iterations = context.Iterations();
+			result.Failed = context.Failed();
+			if (result.Failed)
+			{
+				SS_CORE_ERROR("Benchmark {} failed: {}", entry.Name, context.FailureReason());
+				continue;
+			}
+
+			result.Stats = ComputeBenchmarkStats(context.Samples());
+			SS_CORE_INFO("{:<32} median {:>10.4f} ms  mad {:>8.4f}  min {:>10.4f}  max {:>10.4f}  (x{})", entry.Name,
+			             result.Stats.MedianMs, result.Stats.MadMs, result.Stats.MinMs, result.Stats.MaxMs, result.Iterations);
+		}
+		return results;
+	}
+
+	std::string BenchmarkRunner::ToJson(const std::vector<BenchmarkResult>& results, const std::string& device,
+	                                    const std::string& config, const uint32_t repetitions)
+	{
+		std::map<std::string, const BenchmarkResult*> sorted;
+		double total = 0.0;
+		for (const BenchmarkResult& r : results)
+		{
+			if (!r.Failed)
+			{
+				sorted[r.Name] = &r;
+				total += r.Stats.MedianMs;
+			}
+		}
+
+		std::ostringstream o;
+		o << "{\n";
+		o << "  \"device\": \"" << JsonEscape(device) << "\",\n";
+		o << "  \"config\": \"" << JsonEscape(config) << "\",\n";
+		o << "  \"frames\": " << repetitions << ",\n";
+		o << "  \"timestampsSupported\": true,\n";
+		o << "  \"totalGpuMs\": " << Ms(total) << ",\n";
+		o << "  \"passes\": {";
+
+		bool first = true;
+		for (const auto& [name, r] : sorted)
+		{
+			o << (first ? "\n" : ",\n");
+			first = false;
+			o << "    \"" << JsonEscape(name) << "\": { \"avgMs\": " << Ms(r->Stats.MedianMs)
+			  << ", \"minMs\": " << Ms(r->Stats.MinMs) << ", \"maxMs\": " << Ms(r->Stats.MaxMs)
+			  << ", \"madMs\": " << Ms(r->Stats.MadMs) << ", \"iterations\": " << r->Iterations
+			  << ", \"fragInvocations\": 0, \"depth\": 0 }";
+		}
+		o << (first ? "" : "\n  ") << "}\n";
+		o << "}\n";
+		return o.str();
+	}
+}
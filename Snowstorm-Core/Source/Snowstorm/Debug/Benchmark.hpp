@@ -0,0 +1,157 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Micro/macro benchmark harness behind Snowstorm-Bench (the GPU-free perf gate). Engine-free and
+	// unit-testable like PerfBenchAccumulator: a benchmark is a named function that sets up its data and hands
+	// the timed part to BenchmarkContext::Measure; the runner does the warmup, the repetitions and the
+	// statistics, and ToJson writes the same shape as PerfBenchAccumulator so Scripts/perf-bench.py diffs it
+	// against a per-machine baseline with the code it already has for GPU passes.
+	//
+	// The statistics are median + MAD (median absolute deviation), not mean + stddev: a CI runner's samples
+	// carry the odd 10x outlier (a context switch, a page-fault burst), which drags a mean and blows up a
+	// stddev but barely moves the median. The MAD is written next to it so the gate can tell a real
+	// regression from a noisy machine.
+
+	struct BenchmarkOptions
+	{
+		uint32_t Warmup = 3;       // untimed runs first (caches, allocator pools, lazily built arenas)
+		uint32_t Repetitions = 15; // timed samples
+		std::string Filter;        // substring of the benchmark name; empty: all
+	};
+
+	struct BenchmarkStats
+	{
+		double MedianMs = 0.0;
+		double MadMs = 0.0; // raw median absolute deviation (not scaled to a normal sigma)
+		double MinMs = 0.0;
+		double MaxMs = 0.0;
+		uint32_t Samples = 0;
+	};
+
+	// Median, MAD, min and max of `samplesMs`. An even count takes the mean of the two middle values.
+	BenchmarkStats ComputeBenchmarkStats(std::vector<double> samplesMs);
+
+	// Keep `value` alive as far as the optimizer is concerned, so a benchmark body whose result is otherwise
+	// unused isn't folded away.
+	void DoNotOptimizeAddress(const void* address);
+
+	template <typename T>
+	void DoNotOptimize(const T& value)
+	{
+		DoNotOptimizeAddress(&value);
+	}
+
+	// Handed to each benchmark function. The function builds its inputs (untimed), then calls Measure exactly
+	// once with the part to time.
+	class BenchmarkContext
+	{
+	public:
+		BenchmarkContext(const uint32_t warmup, const uint32_t repetitions)
+		    : m_Warmup(warmup), m_Repetitions(repetitions)
+		{
+		}
+
+		// One sample = `iterations` back-to-back calls of `body`; a sample's time is the whole batch. Batch
+		// tiny bodies until a sample is well above timer resolution (and above perf-bench.py's 0.05 ms noise
+		// floor), and say so in the benchmark name (e.g. "jobs.submit.x1000").
+		template <typename Body>
+		void Measure(Body&& body, const uint32_t iterations = 1)
+		{
+			Measure([] {}, std::forward<Body>(body), iterations);
+		}
+
+		// As above, with `setup` run untimed before every sample (warmup included): restores the state the body
+		// consumes, e.g. deleting the cooked blob so every sample is a cold cook.
+		template <typename Setup, typename Body>
+		void Measure(Setup&& setup, Body&& body, const uint32_t iterations = 1)
+		{
+			if (!BeginMeasure())
+			{
+				return;
+			}
+			for (uint32_t rep = 0; rep < m_Warmup + m_Repetitions && !m_Failed; ++rep)
+			{
+				setup();
+				const auto start = std::chrono::steady_clock::now();
+				for (uint32_t i = 0; i < iterations; ++i)
+				{
+					body();
+				}
+				const auto end = std::chrono::steady_clock::now();
+				if (rep >= m_Warmup)
+				{
+					m_Samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+				}
+			}
+			m_Iterations = iterations;
+		}
+
+		// Abandon the benchmark (logged by the runner, reported as failed): its inputs couldn't be built, or a
+		// body found its result wrong. Safe to call from inside a body; the current sample is the last.
+		void Fail(std::string reason);
+
+		[[nodiscard]] bool Failed() const { return m_Failed; }
+		[[nodiscard]] const std::string& FailureReason() const { return m_FailureReason; }
+		[[nodiscard]] const std::vector<double>& Samples() const { return m_Samples; }
+		[[nodiscard]] uint32_t Iterations() const { return m_Iterations; }
+
+	private:
+		bool BeginMeasure(); // false (and Fail) on a second Measure
+
+		uint32_t m_Warmup = 0;
+		uint32_t m_Repetitions = 0;
+		uint32_t m_Iterations = 0;
+		std::vector<double> m_Samples;
+		bool m_Measured = false;
+		bool m_Failed = false;
+		std::string m_FailureReason;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string Name;
+		BenchmarkStats Stats;
+		uint32_t Iterations = 0; // body calls per sample
+		bool Failed = false;
+	};
+
+	class BenchmarkRunner
+	{
+	public:
+		using Function = std::function<void(BenchmarkContext&)>;
+
+		// Names are dotted "area.what[.size]" (e.g. "cull.100k"): the JSON sorts by them, so an area's
+		// benchmarks stay together in the perf-bench table.
+		void Add(std::string name, Function function);
+
+		// Registered names, in registration order, that pass `filter` (substring; empty: all).
+		[[nodiscard]] std::vector<std::string> Names(const std::string& filter = {}) const;
+
+		// Run every benchmark that passes options.Filter, in registration order, logging each result as it
+		// lands. A benchmark that fails or never calls Measure comes back with Failed set.
+		[[nodiscard]] std::vector<BenchmarkResult> Run(const BenchmarkOptions& options) const;
+
+		// perf-bench.py-compatible JSON: each benchmark is a "pass" whose avgMs is the sample median (what the
+		// gate diffs), plus madMs for the noise-aware comparison; totalGpuMs is the sum of the medians (the
+		// field name is the GPU format's). Failed benchmarks are left out. `device` keys the baseline directory
+		// (the CPU name); keys are sorted so the file is diffable.
+		[[nodiscard]] static std::string ToJson(const std::vector<BenchmarkResult>& results, const std::string& device,
+		                                        const std::string& config, uint32_t repetitions);
+
+	private:
+		struct Entry
+		{
+			std::string Name;
+			Function Fn;
+		};
+
+		std::vector<Entry> m_Benchmarks;
+	};
+}
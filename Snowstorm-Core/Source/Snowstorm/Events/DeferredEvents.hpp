@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Snowstorm/Assets/AssetTypes.hpp"
+
+#include <cstdint>
+
+namespace Snowstorm
+{
+	// Notifications delivered through EventBus's deferred channels (EventBus::Post from any thread, batched
+	// to SubscribeDeferred handlers once per frame). Plain trivially copyable structs: they are copied
+	// through a lock-free queue, so no strings or owning pointers -- asset handles travel as raw values.
+
+	// A JobSystem worker finished the CPU side of an asset load (cooked blob read / decode); the GPU upload is
+	// still to come on the main thread. Posted from the worker: per-job progress of a load burst.
+	struct AssetDecodedEvent
+	{
+		uint64_t Asset = 0;
+		AssetType Type = AssetType::None;
+		bool Success = false;
+	};
+
+	// An async asset load is finished: uploaded and live (Success), or failed and left on its placeholder.
+	struct AssetLoadedEvent
+	{
+		uint64_t Asset = 0;
+		AssetType Type = AssetType::None;
+		bool Success = false;
+	};
+
+	// The first load of a burst was queued: AssetManagerSingleton::PendingLoadCount() left 0. Each one is
+	// followed by exactly one AssetLoadsSettledEvent, so "started minus settled" says whether loads are in
+	// flight even when both land in the same dispatch.
+	struct AssetLoadsStartedEvent
+	{
+	};
+
+	// The last in-flight load of a burst finished: AssetManagerSingleton::PendingLoadCount() is back to 0.
+	struct AssetLoadsSettledEvent
+	{
+		uint32_t LoadCount = 0; // loads in the burst that just settled
+	};
+
+	// A world-partition cell finished loading (all entities committed) or was unloaded.
+	struct StreamingCellEvent
+	{
+		uint32_t Cell = 0; // index into the open partition's manifest
+		bool Loaded = false;
+	};
+}
@@ -27,7 +27,9 @@ namespace Snowstorm
 		MouseButtonPressed,
 		MouseButtonReleased,
 		MouseMoved,
-		MouseScrolled
+		MouseScrolled,
+
+		Count // not an event: the number of event types (sizes EventBus's handler table)
 	};
 
 	enum EventCategory : uint8_t
@@ -1,27 +1,50 @@
 ﻿#pragma once
 
+#include "Snowstorm/Core/MpscQueue.hpp"
 #include "Snowstorm/Events/Event.hpp"
 
-#include <unordered_map>
-#include <vector>
-#include <functional>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <type_traits>
+#include <vector>
 
 namespace Snowstorm
 {
+	// Two delivery paths:
+	//   - Immediate (Subscribe / Publish) for window and input events: handlers run inside Publish in
+	//     priority order and can consume the event to stop propagation. Main thread only.
+	//   - Deferred (SubscribeDeferred / Post / DispatchDeferred) for notifications from any thread -- an
+	//     asset finished decoding on a worker, a streaming cell went resident. Post copies a trivially
+	//     copyable event into its type's channel, a lock-free MPSC queue; the main thread drains every
+	//     channel once per frame (Application::Run) and hands each handler the whole batch as one span, so a
+	//     burst of 300 completions is one call per handler, not 300, and nobody polls a counter every frame.
+	//
+	// Subscribing, unsubscribing, Publish and DispatchDeferred are main-thread operations; Post is the only
+	// thread-safe entry point.
 	class EventBus
 	{
 	public:
 		using HandlerId = uint64_t;
 
+		// Events a deferred channel holds between dispatches before Post spills into a locked overflow list.
+		static constexpr size_t kDeferredQueueCapacity = 4096;
+		// Distinct deferred event types across the program (channel indices are global, see DeferredChannelIndex).
+		static constexpr uint32_t kMaxDeferredChannels = 64;
+		static constexpr uint32_t kImmediateChannel = UINT32_MAX;
+
 		struct Connection
 		{
 			Connection() = default;
 
-			Connection(EventBus* bus, const EventType type, const HandlerId id)
-			    : Bus(bus), Type(type), Id(id)
+			Connection(EventBus* bus, const EventType type, const HandlerId id, const uint32_t channel = kImmediateChannel)
+			    : Bus(bus), Type(type), Id(id), Channel(channel)
 			{
 			}
 
@@ -33,9 +56,11 @@ namespace Snowstorm
 				Bus = other.Bus;
 				Type = other.Type;
 				Id = other.Id;
+				Channel = other.Channel;
 				other.Bus = nullptr;
 				other.Type = EventType::None;
 				other.Id = 0;
+				other.Channel = kImmediateChannel;
 			}
 
 			Connection& operator=(Connection&& other) noexcept
@@ -46,9 +71,11 @@ namespace Snowstorm
 				Bus = other.Bus;
 				Type = other.Type;
 				Id = other.Id;
+				Channel = other.Channel;
 				other.Bus = nullptr;
 				other.Type = EventType::None;
 				other.Id = 0;
+				other.Channel = kImmediateChannel;
 				return *this;
 			}
 
@@ -58,21 +85,37 @@ namespace Snowstorm
 			{
 				if (Bus)
 				{
-					Bus->Unsubscribe(Type, Id);
+					if (Channel == kImmediateChannel)
+						Bus->Unsubscribe(Type, Id);
+					else
+						Bus->UnsubscribeDeferred(Channel, Id);
 					Bus = nullptr;
 					Type = EventType::None;
 					Id = 0;
+					Channel = kImmediateChannel;
 				}
 			}
 
 			EventBus* Bus = nullptr;
 			EventType Type = EventType::None;
 			HandlerId Id = 0;
+			uint32_t Channel = kImmediateChannel; // deferred channel index, or kImmediateChannel
 		};
 
 	public:
 		EventBus() = default;
 
+		EventBus(const EventBus&) = delete;
+		EventBus& operator=(const EventBus&) = delete;
+
+		~EventBus()
+		{
+			for (std::atomic<DeferredChannelBase*>& channel : m_DeferredChannels)
+			{
+				delete channel.load(std::memory_order_acquire);
+			}
+		}
+
 		// Subscribe<T>(handler, priority)
 		// handler returns true to consume (set e.Handled=true and stop propagation)
 		template <typename T, typename F>
@@ -91,11 +134,11 @@ namespace Snowstorm
 				return f(static_cast<T&>(e));
 			};
 
-			auto& vec = m_Handlers[type];
-			vec.push_back(std::move(h));
-
-			std::ranges::sort(vec, [](const Handler& a, const Handler& b)
-			                  { return a.Priority > b.Priority; });
+			// Insert after every handler of the same or higher priority: the list stays sorted without a
+			// re-sort per subscription, and equal priorities run in subscription order.
+			auto& vec = m_Handlers[static_cast<size_t>(type)];
+			const auto at = std::ranges::upper_bound(vec, priority, std::greater<>{}, &Handler::Priority);
+			vec.insert(at, std::move(h));
 
 			return {this, type, id};
 		}
@@ -103,11 +146,7 @@ namespace Snowstorm
 		// Publish(event): runs handlers in priority order; stops when event.Handled becomes true
 		void Publish(Event& e)
 		{
-			const auto it = m_Handlers.find(e.GetEventType());
-			if (it == m_Handlers.end())
-				return;
-
-			for (auto& h : it->second)
+			for (auto& h : m_Handlers[static_cast<size_t>(e.GetEventType())])
 			{
 				if (e.Handled)
 					return;
@@ -117,6 +156,42 @@ namespace Snowstorm
 			}
 		}
 
+		// SubscribeDeferred<T>(handler): handler(std::span<const T>) receives every T posted since the
+		// previous dispatch, in posting order per thread, once per DispatchDeferred that has any.
+		template <typename T, typename F>
+		Connection SubscribeDeferred(F&& fn)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Deferred events are copied across threads: T must be trivially copyable");
+
+			const uint32_t channel = DeferredChannelIndex<T>();
+			const HandlerId id = ++m_NextId;
+			GetDeferredChannel<T>().Subscribe(id, std::function<void(std::span<const T>)>(std::forward<F>(fn)));
+			return {this, EventType::None, id, channel};
+		}
+
+		// Post(event): queue `event` for the next DispatchDeferred. Any thread; never blocks on the main
+		// thread or other posters unless the channel overflowed.
+		template <typename T>
+		void Post(const T& event)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "Deferred events are copied across threads: T must be trivially copyable");
+			GetDeferredChannel<T>().Post(event);
+		}
+
+		// Deliver everything posted so far, one batch per channel. Main thread, once per frame. A handler may
+		// Post (delivered next dispatch) and subscribe / disconnect, but must not dispatch recursively.
+		void DispatchDeferred()
+		{
+			const uint32_t channels = std::min(s_NextDeferredChannel.load(std::memory_order_acquire), kMaxDeferredChannels);
+			for (uint32_t i = 0; i < channels; ++i)
+			{
+				if (DeferredChannelBase* channel = m_DeferredChannels[i].load(std::memory_order_acquire))
+				{
+					channel->Dispatch();
+				}
+			}
+		}
+
 	private:
 		struct Handler
 		{
@@ -125,25 +200,162 @@ namespace Snowstorm
 			std::function<bool(Event&)> Func;
 		};
 
+		struct DeferredChannelBase
+		{
+			virtual ~DeferredChannelBase() = default;
+			virtual void Dispatch() = 0;
+			virtual void Unsubscribe(HandlerId id) = 0;
+		};
+
+		template <typename T>
+		class DeferredChannel final : public DeferredChannelBase
+		{
+		public:
+			void Post(const T& event)
+			{
+				// Once anything spilled, keep spilling until the next dispatch drains the overflow, so one
+				// thread's events are never delivered out of order.
+				if (!m_Spilled.load(std::memory_order_acquire) && m_Queue.TryPush(event))
+				{
+					return;
+				}
+				std::lock_guard lock(m_OverflowMutex);
+				m_Overflow.push_back(event);
+				m_Spilled.store(true, std::memory_order_release);
+			}
+
+			void Subscribe(const HandlerId id, std::function<void(std::span<const T>)> fn)
+			{
+				// Added during a dispatch: joins after it, so the handler list never reallocates under a call.
+				(m_Dispatching ? m_Added : m_Handlers).push_back({id, true, std::move(fn)});
+			}
+
+			void Unsubscribe(const HandlerId id) override
+			{
+				if (m_Dispatching)
+				{
+					// Deactivate only; the handler may be the one running. Removed after the dispatch.
+					for (DeferredHandler& handler : m_Handlers)
+					{
+						handler.Active &= handler.Id != id;
+					}
+					std::erase_if(m_Added, [&](const DeferredHandler& handler)
+					              { return handler.Id == id; });
+					return;
+				}
+				std::erase_if(m_Handlers, [&](const DeferredHandler& handler)
+				              { return handler.Id == id; });
+			}
+
+			void Dispatch() override
+			{
+				// At most one ring's worth per dispatch, so posters that never stop can't hold the frame here.
+				m_Batch.clear();
+				T event;
+				for (size_t n = 0; n < m_Queue.Capacity() && m_Queue.TryPop(event); ++n)
+				{
+					m_Batch.push_back(event);
+				}
+				if (m_Spilled.load(std::memory_order_acquire))
+				{
+					std::lock_guard lock(m_OverflowMutex);
+					m_Batch.insert(m_Batch.end(), m_Overflow.begin(), m_Overflow.end());
+					m_Overflow.clear();
+					m_Spilled.store(false, std::memory_order_release);
+				}
+				if (m_Batch.empty())
+				{
+					return;
+				}
+
+				m_Dispatching = true;
+				const std::span<const T> batch(m_Batch);
+				for (const DeferredHandler& handler : m_Handlers)
+				{
+					if (handler.Active)
+					{
+						handler.Func(batch);
+					}
+				}
+				m_Dispatching = false;
+
+				std::erase_if(m_Handlers, [](const DeferredHandler& handler)
+				              { return !handler.Active; });
+				std::ranges::move(m_Added, std::back_inserter(m_Handlers));
+				m_Added.clear();
+			}
+
+		private:
+			struct DeferredHandler
+			{
+				HandlerId Id = 0;
+				bool Active = true;
+				std::function<void(std::span<const T>)> Func;
+			};
+
+			MpscQueue<T> m_Queue{kDeferredQueueCapacity};
+			std::atomic<bool> m_Spilled{false};
+			std::mutex m_OverflowMutex;
+			std::vector<T> m_Overflow;
+
+			// Main thread only.
+			std::vector<DeferredHandler> m_Handlers;
+			std::vector<DeferredHandler> m_Added;
+			std::vector<T> m_Batch;
+			bool m_Dispatching = false;
+		};
+
+		// One index per deferred event type, shared by every bus (handed out on the type's first use).
+		template <typename T>
+		static uint32_t DeferredChannelIndex()
+		{
+			static const uint32_t index = s_NextDeferredChannel.fetch_add(1, std::memory_order_acq_rel);
+			return index;
+		}
+
+		template <typename T>
+		DeferredChannel<T>& GetDeferredChannel()
+		{
+			const uint32_t index = DeferredChannelIndex<T>();
+			SS_CORE_ASSERT(index < kMaxDeferredChannels, "EventBus: more than {} deferred event types", kMaxDeferredChannels);
+
+			std::atomic<DeferredChannelBase*>& slot = m_DeferredChannels[index];
+			DeferredChannelBase* channel = slot.load(std::memory_order_acquire);
+			if (!channel)
+			{
+				// First use of T on this bus, possibly from two threads at once: one channel wins, the other
+				// is discarded.
+				auto created = std::make_unique<DeferredChannel<T>>();
+				if (slot.compare_exchange_strong(channel, created.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					channel = created.release();
+				}
+			}
+			return static_cast<DeferredChannel<T>&>(*channel);
+		}
+
 		void Unsubscribe(const EventType type, const HandlerId id)
 		{
 			if (type == EventType::None || id == 0)
 				return;
 
-			auto it = m_Handlers.find(type);
-			if (it == m_Handlers.end())
-				return;
-
-			auto& vec = it->second;
-			std::erase_if(vec, [&](const Handler& h)
+			std::erase_if(m_Handlers[static_cast<size_t>(type)], [&](const Handler& h)
 			              { return h.Id == id; });
+		}
 
-			if (vec.empty())
-				m_Handlers.erase(it);
+		void UnsubscribeDeferred(const uint32_t channel, const HandlerId id)
+		{
+			if (DeferredChannelBase* deferred = m_DeferredChannels[channel].load(std::memory_order_acquire))
+			{
+				deferred->Unsubscribe(id);
+			}
 		}
 
 	private:
 		HandlerId m_NextId = 0;
-		std::unordered_map<EventType, std::vector<Handler>> m_Handlers;
+		std::array<std::vector<Handler>, static_cast<size_t>(EventType::Count)> m_Handlers; // indexed by EventType
+
+		inline static std::atomic<uint32_t> s_NextDeferredChannel{0};
+		std::array<std::atomic<DeferredChannelBase*>, kMaxDeferredChannels> m_DeferredChannels{};
 	};
 }
@@ -0,0 +1,373 @@
+#include "LightClusters.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SS_CLUSTER_X64 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SS_CLUSTER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Slice 0 starts at the projection's near plane, but log-slicing needs a positive near: an ortho
+		// camera's near can be 0 (or negative), so the log range starts no closer than this fraction of far.
+		// Anything nearer still lands in slice 0 (the shader clamps).
+		constexpr float kMinNearFraction = 1.0e-5f;
+
+		// Relative padding on every froxel box (see its use in BuildLightClusters).
+		constexpr float kBoxSlack = 1.0e-4f;
+
+		struct Aabb
+		{
+			glm::vec3 Min;
+			glm::vec3 Max;
+		};
+
+		// A slice's candidate lights, struct-of-arrays so a cluster tests four at a time. Padded to a multiple
+		// of four with spheres of radius^2 = -1, which no squared distance is ever <= to.
+		struct SphereBatch
+		{
+			std::vector<float> X, Y, Z, R2;
+			std::vector<uint32_t> Light;
+
+			void Clear()
+			{
+				X.clear();
+				Y.clear();
+				Z.clear();
+				R2.clear();
+				Light.clear();
+			}
+
+			void Push(const glm::vec3& center, const float radius, const uint32_t light)
+			{
+				X.push_back(center.x);
+				Y.push_back(center.y);
+				Z.push_back(center.z);
+				R2.push_back(radius * radius);
+				Light.push_back(light);
+			}
+
+			void Pad()
+			{
+				while (X.size() % 4 != 0)
+				{
+					Push(glm::vec3(0.0f), 0.0f, 0);
+					R2.back() = -1.0f;
+				}
+			}
+		};
+
+		struct ViewSphere
+		{
+			glm::vec3 Center;
+			float Radius;
+		};
+
+		// Bit i set when sphere [first + i] overlaps `box`: the squared distance from the center to the box is
+		// within radius^2. All three paths evaluate the same expression in the same order, so they agree
+		// bit-for-bit.
+		uint32_t OverlapMask4(const SphereBatch& batch, const size_t first, const Aabb& box)
+		{
+#if SS_CLUSTER_X64
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 cx = _mm_loadu_ps(batch.X.data() + first);
+			const __m128 cy = _mm_loadu_ps(batch.Y.data() + first);
+			const __m128 cz = _mm_loadu_ps(batch.Z.data() + first);
+			const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.Min.x), cx), _mm_sub_ps(cx, _mm_set1_ps(box.Max.x))), zero);
+			const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.Min.y), cy), _mm_sub_ps(cy, _mm_set1_ps(box.Max.y))), zero);
+			const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(box.Min.z), cz), _mm_sub_ps(cz, _mm_set1_ps(box.Max.z))), zero);
+			const __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+			return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(batch.R2.data() + first))));
+#elif SS_CLUSTER_NEON
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			const float32x4_t cx = vld1q_f32(batch.X.data() + first);
+			const float32x4_t cy = vld1q_f32(batch.Y.data() + first);
+			const float32x4_t cz = vld1q_f32(batch.Z.data() + first);
+			const float32x4_t dx = vmaxq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(box.Min.x), cx), vsubq_f32(cx, vdupq_n_f32(box.Max.x))), zero);
+			const float32x4_t dy = vmaxq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(box.Min.y), cy), vsubq_f32(cy, vdupq_n_f32(box.Max.y))), zero);
+			const float32x4_t dz = vmaxq_f32(vmaxq_f32(vsubq_f32(vdupq_n_f32(box.Min.z), cz), vsubq_f32(cz, vdupq_n_f32(box.Max.z))), zero);
+			const float32x4_t d2 = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+			const uint32x4_t inside = vcleq_f32(d2, vld1q_f32(batch.R2.data() + first));
+			const uint32_t bitValues[4] = {1, 2, 4, 8};
+			return vaddvq_u32(vandq_u32(inside, vld1q_u32(bitValues)));
+#else
+			uint32_t mask = 0;
+			for (size_t i = 0; i < 4; ++i)
+			{
+				const size_t s = first + i;
+				const float dx = std::max(std::max(box.Min.x - batch.X[s], batch.X[s] - box.Max.x), 0.0f);
+				const float dy = std::max(std::max(box.Min.y - batch.Y[s], batch.Y[s] - box.Max.y), 0.0f);
+				const float dz = std::max(std::max(box.Min.z - batch.Z[s], batch.Z[s] - box.Max.z), 0.0f);
+				if (dx * dx + dy * dy + dz * dz <= batch.R2[s])
+				{
+					mask |= 1u << i;
+				}
+			}
+			return mask;
+#endif
+		}
+
+		// Tightest sphere around a spot's cone (apex at the light, slant length Range, half-angle from
+		// CosOuter). Wide cones are bounded by their cap circle; narrow ones by the circumsphere through the
+		// apex and the cap rim. Cones of 90 degrees or more fall back to the full range sphere.
+		ViewSphere SpotBounds(const GPUSpotLight& spot, const glm::mat4& view)
+		{
+			const glm::vec3 apex = glm::vec3(view * glm::vec4(spot.Position, 1.0f));
+			const float range = std::max(spot.Range, 0.0f);
+			const float cosAngle = std::min(spot.CosOuter, 1.0f);
+			if (cosAngle <= 0.0f || !(glm::dot(spot.Direction, spot.Direction) > 0.0f))
+			{
+				return {apex, range};
+			}
+
+			const glm::vec3 axis = glm::normalize(glm::vec3(view * glm::vec4(spot.Direction, 0.0f)));
+			constexpr float kCos45 = 0.70710678f;
+			if (cosAngle < kCos45)
+			{
+				const float sinAngle = std::sqrt(std::max(1.0f - cosAngle * cosAngle, 0.0f));
+				return {apex + axis * (range * cosAngle), range * sinAngle};
+			}
+			const float radius = range / (2.0f * cosAngle);
+			return {apex + axis * radius, radius};
+		}
+
+		bool IsFinite(const glm::mat4& m)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				for (int r = 0; r < 4; ++r)
+				{
+					if (!std::isfinite(m[c][r]))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+	}
+
+	void BuildLightClusters(const LightClusterView& view, const std::span<const GPUPointLight> points,
+	                        const std::span<const GPUSpotLight> spots, LightClusterGrid& grid, JobSystem* jobs)
+	{
+		grid.Params = {};
+		grid.Clusters.assign(kLightClusterCount, GPULightCluster{});
+		grid.LightIndices.clear();
+
+		// Clip -> view space. Everything below (froxel corners, light spheres) lives in view space, where
+		// depth is simply -z.
+		const glm::mat4 clipToView = view.View * glm::inverse(view.ViewProjection);
+		if (!IsFinite(clipToView))
+		{
+			return;
+		}
+		const auto unproject = [&clipToView](const float x, const float y, const float z)
+		{
+			const glm::vec4 p = clipToView * glm::vec4(x, y, z, 1.0f);
+			return glm::vec3(p) / p.w;
+		};
+
+		const float nearDepth = -unproject(0.0f, 0.0f, 0.0f).z;
+		const float farDepth = -unproject(0.0f, 0.0f, 1.0f).z;
+		const float sliceNear = std::max(nearDepth, farDepth * kMinNearFraction);
+		if (!std::isfinite(nearDepth) || !std::isfinite(farDepth) || !(farDepth > sliceNear))
+		{
+			return;
+		}
+
+		const float logRange = std::log2(farDepth / sliceNear);
+		const float sliceCount = static_cast<float>(kLightClusterSlices);
+		grid.Params.DepthScale = sliceCount / logRange;
+		grid.Params.DepthBias = -sliceCount * std::log2(sliceNear) / logRange;
+		// depth = -(View * p).z, i.e. minus View's third row.
+		grid.Params.DepthPlane = -glm::vec4(view.View[0][2], view.View[1][2], view.View[2][2], view.View[3][2]);
+		grid.Params.Enabled = 1;
+
+		// Slice boundaries (the shader's formula inverted). Slice 0 reaches back to the real near plane and
+		// the last slice ends exactly at far, so every visible depth has a slice whose box contains it.
+		std::array<float, kLightClusterSlices + 1> sliceDepth{};
+		for (uint32_t k = 0; k <= kLightClusterSlices; ++k)
+		{
+			sliceDepth[k] = sliceNear * std::exp2(static_cast<float>(k) * logRange / sliceCount);
+		}
+		sliceDepth[0] = std::min(nearDepth, sliceNear);
+		sliceDepth[kLightClusterSlices] = farDepth;
+
+		// The near/far points of each tile-corner ray. Interpolating along these (rather than assuming a
+		// symmetric frustum) keeps the boxes exact for jittered and off-center projections.
+		constexpr uint32_t kCornersX = kLightClusterTilesX + 1;
+		constexpr uint32_t kCornersY = kLightClusterTilesY + 1;
+		std::array<glm::vec3, kCornersX * kCornersY> rayNear{};
+		std::array<glm::vec3, kCornersX * kCornersY> rayFar{};
+		for (uint32_t y = 0; y < kCornersY; ++y)
+		{
+			for (uint32_t x = 0; x < kCornersX; ++x)
+			{
+				const float ndcX = -1.0f + 2.0f * static_cast<float>(x) / static_cast<float>(kLightClusterTilesX);
+				const float ndcY = -1.0f + 2.0f * static_cast<float>(y) / static_cast<float>(kLightClusterTilesY);
+				rayNear[y * kCornersX + x] = unproject(ndcX, ndcY, 0.0f);
+				rayFar[y * kCornersX + x] = unproject(ndcX, ndcY, 1.0f);
+			}
+		}
+		const auto cornerAt = [&](const uint32_t corner, const float depth)
+		{
+			const glm::vec3& a = rayNear[corner];
+			const glm::vec3& b = rayFar[corner];
+			const float span = b.z - a.z;
+			const float t = span != 0.0f ? (-depth - a.z) / span : 0.0f;
+			return a + (b - a) * t;
+		};
+
+		// Light bounds in view space, points first then spots; index i >= points.size() is spot
+		// i - points.size().
+		std::vector<ViewSphere> spheres;
+		spheres.reserve(points.size() + spots.size());
+		for (const GPUPointLight& light : points)
+		{
+			spheres.push_back({glm::vec3(view.View * glm::vec4(light.Position, 1.0f)), std::max(light.Range, 0.0f)});
+		}
+		for (const GPUSpotLight& light : spots)
+		{
+			spheres.push_back(SpotBounds(light, view.View));
+		}
+		const uint32_t pointCount = static_cast<uint32_t>(points.size());
+
+		// One job per depth slice: gather the lights whose depth extent reaches the slice, then test them
+		// against the slice's tile boxes. Each slice writes its own index list and its own clusters; a serial
+		// pass stitches the lists together afterwards.
+		constexpr uint32_t kTilesPerSlice = kLightClusterTilesX * kLightClusterTilesY;
+		std::array<std::vector<uint32_t>, kLightClusterSlices> sliceIndices;
+		const auto binSlices = [&](const size_t begin, const size_t end)
+		{
+			SphereBatch batch;
+			for (size_t slice = begin; slice < end; ++slice)
+			{
+				const float zNear = sliceDepth[slice];
+				const float zFar = sliceDepth[slice + 1];
+
+				batch.Clear();
+				for (uint32_t i = 0; i < static_cast<uint32_t>(spheres.size()); ++i)
+				{
+					const float depth = -spheres[i].Center.z;
+					if (depth + spheres[i].Radius >= zNear && depth - spheres[i].Radius <= zFar)
+					{
+						batch.Push(spheres[i].Center, spheres[i].Radius, i);
+					}
+				}
+				batch.Pad();
+
+				std::vector<uint32_t>& out = sliceIndices[slice];
+				out.clear();
+				std::vector<uint32_t> spotScratch;
+				for (uint32_t ty = 0; ty < kLightClusterTilesY; ++ty)
+				{
+					for (uint32_t tx = 0; tx < kLightClusterTilesX; ++tx)
+					{
+						// The froxel's box: the 8 points where its 4 corner rays cross the slice planes.
+						Aabb box{glm::vec3(std::numeric_limits<float>::max()), glm::vec3(-std::numeric_limits<float>::max())};
+						for (const uint32_t corner : {ty * kCornersX + tx, ty * kCornersX + tx + 1,
+						                              (ty + 1) * kCornersX + tx, (ty + 1) * kCornersX + tx + 1})
+						{
+							for (const float depth : {zNear, zFar})
+							{
+								const glm::vec3 p = cornerAt(corner, depth);
+								box.Min = glm::min(box.Min, p);
+								box.Max = glm::max(box.Max, p);
+							}
+						}
+						// The shader finds its froxel with its own float math (clip divide, log2), which can land
+						// a fragment sitting on a boundary in the neighbor; a hair of slack keeps it covered.
+						const glm::vec3 slack = (box.Max - box.Min) * kBoxSlack;
+						box.Min -= slack;
+						box.Max += slack;
+
+						GPULightCluster& cluster = grid.Clusters[slice * kTilesPerSlice + ty * kLightClusterTilesX + tx];
+						cluster.Offset = static_cast<uint32_t>(out.size());
+						spotScratch.clear();
+						for (size_t first = 0; first < batch.X.size(); first += 4)
+						{
+							uint32_t mask = OverlapMask4(batch, first, box);
+							while (mask != 0)
+							{
+								const uint32_t lane = static_cast<uint32_t>(std::countr_zero(mask));
+								mask &= mask - 1;
+								const uint32_t light = batch.Light[first + lane];
+								if (light < pointCount)
+								{
+									out.push_back(light);
+								}
+								else
+								{
+									spotScratch.push_back(light - pointCount);
+								}
+							}
+						}
+						cluster.PointCount = static_cast<uint32_t>(out.size()) - cluster.Offset;
+						cluster.SpotCount = static_cast<uint32_t>(spotScratch.size());
+						out.insert(out.end(), spotScratch.begin(), spotScratch.end());
+					}
+				}
+			}
+		};
+
+		if (jobs)
+		{
+			jobs->ParallelFor(kLightClusterSlices, binSlices, 1);
+		}
+		else
+		{
+			binSlices(0, kLightClusterSlices);
+		}
+
+		size_t total = 0;
+		for (const std::vector<uint32_t>& list : sliceIndices)
+		{
+			total += list.size();
+		}
+		grid.LightIndices.reserve(total);
+		for (uint32_t slice = 0; slice < kLightClusterSlices; ++slice)
+		{
+			const uint32_t base = static_cast<uint32_t>(grid.LightIndices.size());
+			for (uint32_t t = 0; t < kTilesPerSlice; ++t)
+			{
+				grid.Clusters[slice * kTilesPerSlice + t].Offset += base;
+			}
+			grid.LightIndices.insert(grid.LightIndices.end(), sliceIndices[slice].begin(), sliceIndices[slice].end());
+		}
+	}
+
+	uint32_t LightClusterIndexAt(const LightClusterGrid& grid, const glm::mat4& viewProjection, const glm::vec3& positionWS)
+	{
+		if (grid.Params.Enabled == 0)
+		{
+			return std::numeric_limits<uint32_t>::max();
+		}
+
+		const glm::vec4 clip = viewProjection * glm::vec4(positionWS, 1.0f);
+		const float ndcX = clip.x / clip.w;
+		const float ndcY = clip.y / clip.w;
+		const int tx = std::clamp(static_cast<int>(std::floor((ndcX * 0.5f + 0.5f) * kLightClusterTilesX)), 0,
+		                          static_cast<int>(kLightClusterTilesX) - 1);
+		const int ty = std::clamp(static_cast<int>(std::floor((ndcY * 0.5f + 0.5f) * kLightClusterTilesY)), 0,
+		                          static_cast<int>(kLightClusterTilesY) - 1);
+
+		const float depth = glm::dot(glm::vec3(grid.Params.DepthPlane), positionWS) + grid.Params.DepthPlane.w;
+		const float sliceF = std::floor(std::log2(std::max(depth, 1.0e-4f)) * grid.Params.DepthScale + grid.Params.DepthBias);
+		const int slice = static_cast<int>(std::clamp(sliceF, 0.0f, static_cast<float>(kLightClusterSlices - 1)));
+
+		return (static_cast<uint32_t>(slice) * kLightClusterTilesY + static_cast<uint32_t>(ty)) * kLightClusterTilesX +
+		       static_cast<uint32_t>(tx);
+	}
+}
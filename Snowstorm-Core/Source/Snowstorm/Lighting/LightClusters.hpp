@@ -0,0 +1,64 @@
+#pragma once
+
+#include "LightingUniforms.hpp"
+
+#include "Snowstorm/Math/Math.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// Froxel grid for clustered forward lighting: kLightClusterTilesX x kLightClusterTilesY screen tiles (in
+	// NDC, so the grid is resolution-independent) x kLightClusterSlices exponential view-depth slices. Mirrored
+	// by CLUSTER_TILES_X/Y and CLUSTER_SLICES in Engine.hlsli -- keep them in lockstep.
+	constexpr uint32_t kLightClusterTilesX = 16;
+	constexpr uint32_t kLightClusterTilesY = 9;
+	constexpr uint32_t kLightClusterSlices = 24;
+	constexpr uint32_t kLightClusterCount = kLightClusterTilesX * kLightClusterTilesY * kLightClusterSlices;
+
+	// One froxel's slice of the light index list: PointCount point-light indices starting at Offset, then
+	// SpotCount spot-light indices. Mirrors LightCluster in Engine.hlsli (a 16-byte StructuredBuffer element).
+	struct GPULightCluster
+	{
+		uint32_t Offset = 0;
+		uint32_t PointCount = 0;
+		uint32_t SpotCount = 0;
+		uint32_t Pad = 0;
+	};
+
+	// The camera the grid is built for. ViewProjection must be the matrix FrameCB carries (the jittered one
+	// on the forward color pass): the shader derives its tile from that clip position, so binning against a
+	// different projection would misplace lights near tile edges.
+	struct LightClusterView
+	{
+		glm::mat4 View{1.0f};
+		glm::mat4 ViewProjection{1.0f};
+	};
+
+	// A built grid: the FrameCB constants, one GPULightCluster per froxel (x fastest, then y, then slice) and
+	// the compact index list they point into. Lists are in ascending light order, so a build is deterministic
+	// whatever the job split.
+	struct LightClusterGrid
+	{
+		GPULightClusterParams Params;
+		std::vector<GPULightCluster> Clusters;
+		std::vector<uint32_t> LightIndices;
+	};
+
+	// Bin every point/spot light into the froxels its bounding sphere (a spot's cone is bounded by the
+	// tightest sphere around it) overlaps. Each depth slice is one JobSystem chunk; within a slice a cluster
+	// tests its candidate lights four at a time (SSE/NEON, scalar elsewhere). `jobs` == nullptr runs inline.
+	// A view whose projection can't be sliced (non-invertible, or no positive depth range) yields
+	// Params.Enabled == 0 and the shader falls back to looping over every light.
+	void BuildLightClusters(const LightClusterView& view, std::span<const GPUPointLight> points,
+	                        std::span<const GPUSpotLight> spots, LightClusterGrid& grid, JobSystem* jobs = nullptr);
+
+	// The froxel (index into LightClusterGrid::Clusters) the shader assigns to a world position -- the CPU
+	// twin of GetLightClusterIndex in Engine.hlsli, minus its ClusterFirst base. UINT32_MAX when the grid is
+	// disabled. For tests and debugging.
+	uint32_t LightClusterIndexAt(const LightClusterGrid& grid, const glm::mat4& viewProjection, const glm::vec3& positionWS);
+}
@@ -24,7 +24,8 @@ namespace Snowstorm
 		    .property("Color", &PointLightComponent::Color)(metadata("Color", true))
 		    .property("Intensity", &PointLightComponent::Intensity)(metadata("Min", 0.0f), metadata("Speed", 0.01f))
 		    .property("Range", &PointLightComponent::Range)(metadata("Min", 0.0f), metadata("Speed", 0.1f))
-		    .property("CastShadows", &PointLightComponent::CastShadows); // inspector: checkbox
+		    .property("CastShadows", &PointLightComponent::CastShadows) // inspector: checkbox
+		    .property("ShadowPriority", &PointLightComponent::ShadowPriority)(metadata("Min", 0.0f), metadata("Speed", 0.05f));
 
 		registration::class_<SpotLightComponent>("Snowstorm::SpotLightComponent")
 		    .property("Enabled", &SpotLightComponent::Enabled) // inspector: checkbox (per-light on/off)
@@ -33,7 +34,8 @@ namespace Snowstorm
 		    .property("Range", &SpotLightComponent::Range)(metadata("Min", 0.0f), metadata("Speed", 0.1f))
 		    .property("InnerAngleDeg", &SpotLightComponent::InnerAngleDeg)(metadata("Min", 0.0f), metadata("Max", 89.0f), metadata("Speed", 0.5f))
 		    .property("OuterAngleDeg", &SpotLightComponent::OuterAngleDeg)(metadata("Min", 0.0f), metadata("Max", 89.0f), metadata("Speed", 0.5f))
-		    .property("CastShadows", &SpotLightComponent::CastShadows); // inspector: checkbox
+		    .property("CastShadows", &SpotLightComponent::CastShadows) // inspector: checkbox
+		    .property("ShadowPriority", &SpotLightComponent::ShadowPriority)(metadata("Min", 0.0f), metadata("Speed", 0.05f));
 	}
 
 	// Spot cone invariant: the outer angle must be >= the inner angle, or the falloff denominator
@@ -35,10 +35,15 @@ namespace Snowstorm
 		float Range = 10.0f; // distance at which the light's contribution smoothly reaches zero
 
 		// Whether this omni light casts shadows (per-light toggle, like Spot/Directional CastShadows).
-		// A shadow-casting point is rendered as 6 perspective depth faces (cube unrolled into an atlas);
-		// casters are assigned a shadow slot up to a hard cap (ShadowPass::kMaxShadowPoints) because each
-		// costs 6 depth passes. The global render.shadows CVar is the scalability kill-switch above this.
+		// A shadow-casting point is rendered as 6 perspective depth faces (cube unrolled into the shadow
+		// atlas); casters are assigned a shadow slot up to a cap (MAX_SHADOW_POINTS) because each costs 6
+		// tiles. The global render.shadows CVar is the scalability kill-switch above this.
 		bool CastShadows = true;
+
+		// Importance of this light's shadow against the others competing for the atlas (and, for points, for
+		// the shadow slots). Multiplies the light's screen coverage: 2 = a tile twice as wide, served earlier;
+		// 0 = the smallest tile and the first to lose it.
+		float ShadowPriority = 1.0f;
 	};
 
 	// Spot light: a point light restricted to a cone. Direction = the entity transform's forward (-Z).
@@ -55,8 +60,12 @@ namespace Snowstorm
 		float OuterAngleDeg = 30.0f; // zero past this half-angle (must be >= InnerAngleDeg)
 
 		// Whether this spot casts shadows (per-light toggle, like DirectionalLightComponent::CastShadows).
-		// Shadow-casting spots are assigned an atlas tile up to a cap; the global render.shadows CVar is the
-		// scalability kill-switch above this.
+		// Shadow-casting spots are assigned a tile of the shadow atlas while it has room; the global
+		// render.shadows CVar is the scalability kill-switch above this.
 		bool CastShadows = true;
+
+		// Importance of this spot's shadow against the others competing for the atlas (see
+		// PointLightComponent::ShadowPriority).
+		float ShadowPriority = 1.0f;
 	};
 }
@@ -3,6 +3,8 @@
 #include "LightingComponents.hpp"
 #include "LightingUniforms.hpp"
 
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/CameraRuntimeComponent.hpp"
 #include "Snowstorm/Components/TransformComponent.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
 #include "Snowstorm/Core/Log.hpp"
@@ -11,7 +13,11 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
 
 namespace Snowstorm
 {
@@ -65,7 +71,7 @@ namespace Snowstorm
 		// below. Kept here so ALL shadow setup lives in the light system; RenderSystem only binds the depth
 		// resource + records the pass from this result. Gated by the global render.shadows kill-switch AND
 		// the sun's authored CastShadows flag; ComputeSunViewProj also fails (Valid stays false) when the
-		// scene has no renderable bounds, in which case RenderSystem leaves ShadowMapIndex 0 (fully lit).
+		// scene has no renderable bounds, in which case ShadowRenderer leaves CascadeCount 0 (fully lit).
 		RendererService::SunShadowFit sunFit{};
 		if (CVars::ShadowsRasterActive() && haveSun && sunCasts)
 		{
@@ -79,18 +85,45 @@ namespace Snowstorm
 		// WITHOUT consuming an atlas tile or filling the (unused-under-RT) matrices/rects.
 		const bool rtShadows = CVars::ShadowsRTActive();
 
-		// Point lights: position from the entity transform (Unity/Unreal model -- the light carries no
-		// position of its own). Joined with TransformComponent so an untransformed light is simply skipped.
-		int nextPointShadowSlot = 0; // next free point-shadow payload slot (6 atlas tiles each)
-		bool droppedPoint = false;
-		bool droppedPointShadow = false; // a casting point exceeded the shadow budget (renders unshadowed)
-		for (auto pointView = View<PointLightComponent, TransformComponent>(); auto entity : pointView)
+		// Raster shadow tiles are sized by how much of the screen the light can shadow: its range sphere's
+		// coverage of the Primary camera (else the first), times the authored ShadowPriority. Last frame's
+		// camera matrices are fine for that -- it only picks a tile size.
+		const CameraRuntimeComponent* camera = nullptr;
+		for (auto cameraView = View<CameraComponent, CameraRuntimeComponent>(); auto entity : cameraView)
 		{
-			if (lightData.PointCount >= MAX_POINT_LIGHTS)
+			const bool primary = cameraView.get<CameraComponent>(entity).Primary;
+			if (!camera || primary)
+			{
+				camera = &cameraView.get<CameraRuntimeComponent>(entity);
+			}
+			if (primary)
 			{
-				droppedPoint = true;
 				break;
 			}
+		}
+		const auto shadowPriority = [&](const glm::vec3& position, const float range, const float weight)
+		{
+			const float coverage = camera ? ShadowScreenCoverage(camera->View, camera->Projection, position, range) : 1.0f;
+			return coverage * std::max(weight, 0.0f);
+		};
+
+		// A raster-shadowed light waiting for its atlas tile(s): gathered while the lights are packed, placed
+		// in one Allocate below so spots and point faces compete for the same atlas by priority.
+		struct ShadowCandidate
+		{
+			size_t LightIndex = 0; // into lightData.PointLights / SpotLights
+			uint64_t Key = 0;
+			float Priority = 0.0f;
+		};
+		std::vector<ShadowCandidate> pointCandidates;
+		std::vector<ShadowCandidate> spotCandidates;
+
+		// Point lights: position from the entity transform (Unity/Unreal model -- the light carries no
+		// position of its own). Joined with TransformComponent so an untransformed light is simply skipped.
+		// No count cap: the renderer uploads them into a storage buffer and the forward pass only shades the
+		// ones binned into each froxel (LightClusters.hpp). Shadows keep their own budget below.
+		for (auto pointView = View<PointLightComponent, TransformComponent>(); auto entity : pointView)
+		{
 			const auto& light = pointView.get<PointLightComponent>(entity);
 			if (!light.Enabled) // per-light off: skip entirely (no light, no shadow slot)
 			{
@@ -98,76 +131,31 @@ namespace Snowstorm
 			}
 			const auto& transform = pointView.get<TransformComponent>(entity);
 
-			// Assign a shadow payload slot if this omni casts, shadows are globally enabled, and a slot is
-			// free (cap = MAX_SHADOW_POINTS -- each costs 6 depth passes). ShadowSlot < 0 => unshadowed. Fill
-			// the slot's 6 cube-face view-projs + atlas rects (the cube unrolled: 6 consecutive tiles in the
-			// kPointAtlasCols grid, tile index = slot*6 + face). The matrices/rects are pure math here;
-			// RenderSystem renders each tile and binds the atlas texture (mirrors the spot path exactly).
-			int shadowSlot = -1;
-			if (rtShadows && light.CastShadows)
-			{
-				// RT: mark as casting (shader traces to the light); the payload slot is unused, so use 0 as a
-				// sacrificial >= 0 sentinel. No atlas budget => every caster gets a shadow.
-				shadowSlot = 0;
-			}
-			else if (shadowsEnabled && light.CastShadows)
+			// RT: mark as casting (shader traces to the light); the payload slot is unused, so use 0 as a
+			// sacrificial >= 0 sentinel. No atlas budget => every caster gets a shadow. Raster casters get
+			// their slot + tiles below, once every light's priority is known.
+			const int shadowSlot = rtShadows && light.CastShadows ? 0 : -1;
+			if (!rtShadows && shadowsEnabled && light.CastShadows)
 			{
-				if (nextPointShadowSlot < MAX_SHADOW_POINTS)
-				{
-					shadowSlot = nextPointShadowSlot++;
-					GPUPointShadow& payload = lightData.PointShadows[shadowSlot];
-					constexpr float inv = 1.0f / static_cast<float>(ShadowPass::kPointAtlasCols);
-					for (int face = 0; face < 6; ++face)
-					{
-						const int tile = shadowSlot * 6 + face;
-						const int col = tile % static_cast<int>(ShadowPass::kPointAtlasCols);
-						const int row = tile / static_cast<int>(ShadowPass::kPointAtlasCols);
-						payload.Face[face] = ShadowPass::ComputePointFaceViewProj(transform.Position, face, light.Range);
-						payload.Rect[face] = {static_cast<float>(col) * inv, static_cast<float>(row) * inv, inv, inv};
-					}
-				}
-				else
-				{
-					// More shadow-casting points than the atlas budget (each needs 6 tiles). The extra ones
-					// render unshadowed rather than fighting over tiles -- fail loud so it's not a silent gap.
-					droppedPointShadow = true;
-				}
+				pointCandidates.push_back({.LightIndex = lightData.PointLights.size(),
+				                           .Key = static_cast<uint64_t>(entt::to_integral(entity)) << 4,
+				                           .Priority = shadowPriority(transform.Position, light.Range, light.ShadowPriority)});
 			}
 
-			lightData.PointLights[lightData.PointCount++] = {
+			lightData.PointLights.push_back({
 			    .Position = transform.Position,
 			    .Range = light.Range,
 			    .Color = light.Color,
 			    .Intensity = light.Intensity,
 			    .ShadowSlot = shadowSlot,
-			    .ShadowPad = {0, 0, 0}};
+			    .ShadowPad = {0, 0, 0}});
 		}
-		lightData.PointShadowCount = nextPointShadowSlot;
-		if (droppedPoint && !m_WarnedDroppedPoint)
-		{
-			SS_CORE_WARN("More than {} point lights in scene; extra lights ignored.", MAX_POINT_LIGHTS);
-		}
-		m_WarnedDroppedPoint = droppedPoint;
-		if (droppedPointShadow && !m_WarnedDroppedPointShadow)
-		{
-			SS_CORE_WARN("More than {} shadow-casting point lights; extra ones render unshadowed (each omni "
-			             "shadow costs 6 depth passes).",
-			             MAX_SHADOW_POINTS);
-		}
-		m_WarnedDroppedPointShadow = droppedPointShadow;
 
 		// Spot lights: position + forward (-Z) from the transform; cone half-angles stored as cosines so
 		// the shader compares against dot() with no per-fragment trig. OuterAngle is clamped >= InnerAngle
 		// so cos(inner) >= cos(outer) and the falloff denominator stays positive.
-		int nextShadowTile = 0; // next free atlas tile for a shadow-casting spot
-		bool droppedSpot = false;
 		for (auto spotView = View<SpotLightComponent, TransformComponent>(); auto entity : spotView)
 		{
-			if (lightData.SpotCount >= MAX_SPOT_LIGHTS)
-			{
-				droppedSpot = true;
-				break;
-			}
 			const auto& light = spotView.get<SpotLightComponent>(entity);
 			if (!light.Enabled) // per-light off: skip entirely (no light, no shadow tile)
 			{
@@ -181,30 +169,20 @@ namespace Snowstorm
 			const float inner = glm::radians(light.InnerAngleDeg);
 			const float outer = glm::radians(std::max(light.OuterAngleDeg, light.InnerAngleDeg));
 
-			// Assign a shadow atlas tile to this spot if it casts and shadows are globally enabled and a tile
-			// is free (cap = ShadowPass::kMaxShadowSpots). ShadowIndex < 0 => unshadowed. The atlas is a
-			// kSpotAtlasCols x kSpotAtlasCols grid; tile i sits at (col,row) with a 1/cols UV rect. The matrix
-			// and rect are pure math here; RenderSystem renders each assigned tile and binds the atlas texture.
-			int shadowIndex = -1;
+			// RT: mark as casting (shader traces to the spot); the atlas tile/matrix are unused, so use 0 as a
+			// sacrificial >= 0 sentinel. No tile budget => every caster gets a shadow. A raster caster gets
+			// its matrix now and its tile (ShadowIndex + atlas rect) once the atlas is packed below.
+			const int shadowIndex = rtShadows && light.CastShadows ? 0 : -1;
 			glm::mat4 shadowViewProj(1.0f);
-			glm::vec4 atlasRect(0, 0, 1, 1);
-			if (rtShadows && light.CastShadows)
+			if (!rtShadows && shadowsEnabled && light.CastShadows)
 			{
-				// RT: mark as casting (shader traces to the spot); the atlas tile/matrix are unused, so use 0
-				// as a sacrificial >= 0 sentinel. No tile budget => every caster gets a shadow.
-				shadowIndex = 0;
-			}
-			else if (shadowsEnabled && light.CastShadows && nextShadowTile < ShadowPass::kMaxShadowSpots)
-			{
-				shadowIndex = nextShadowTile++;
 				shadowViewProj = ShadowPass::ComputeSpotViewProj(transform.Position, forward, outer, light.Range);
-				constexpr float inv = 1.0f / static_cast<float>(ShadowPass::kSpotAtlasCols);
-				const int col = shadowIndex % static_cast<int>(ShadowPass::kSpotAtlasCols);
-				const int row = shadowIndex / static_cast<int>(ShadowPass::kSpotAtlasCols);
-				atlasRect = {static_cast<float>(col) * inv, static_cast<float>(row) * inv, inv, inv};
+				spotCandidates.push_back({.LightIndex = lightData.SpotLights.size(),
+				                          .Key = static_cast<uint64_t>(entt::to_integral(entity)) << 4,
+				                          .Priority = shadowPriority(transform.Position, light.Range, light.ShadowPriority)});
 			}
 
-			lightData.SpotLights[lightData.SpotCount++] = {
+			lightData.SpotLights.push_back({
 			    .Position = transform.Position,
 			    .Range = light.Range,
 			    .Color = light.Color,
@@ -215,14 +193,99 @@ namespace Snowstorm
 			    .ShadowIndex = shadowIndex,
 			    .ShadowPad = {0, 0},
 			    .ShadowViewProj = shadowViewProj,
-			    .ShadowAtlasRect = atlasRect};
+			    .ShadowAtlasRect = {0.0f, 0.0f, 1.0f, 1.0f}});
+		}
+
+		// Point shadows also need a payload slot in FrameCB (MAX_SHADOW_POINTS). The highest priorities get
+		// them; the rest render unshadowed -- fail loud so it's not a silent gap.
+		std::ranges::stable_sort(pointCandidates, [](const ShadowCandidate& a, const ShadowCandidate& b) { return a.Priority > b.Priority; });
+		const bool droppedPointShadow = pointCandidates.size() > static_cast<size_t>(MAX_SHADOW_POINTS);
+		if (droppedPointShadow)
+		{
+			pointCandidates.resize(MAX_SHADOW_POINTS);
+		}
+		if (droppedPointShadow && !m_WarnedDroppedPointShadow)
+		{
+			SS_CORE_WARN("More than {} shadow-casting point lights; the lowest-priority ones render unshadowed.",
+			             MAX_SHADOW_POINTS);
+		}
+		m_WarnedDroppedPointShadow = droppedPointShadow;
+
+		// Pack every raster shadow into the one atlas: a tile per spot, six (the unrolled cube) per point. The
+		// key low nibble tells a light's tiles apart (spot = 0, point face = 8 + face); the allocator keeps
+		// each key's tile across frames while its wanted size holds, so the tile cache keeps hitting.
+		const auto maxTileSize = static_cast<uint32_t>(std::clamp(CVars::ShadowResolution.Get(), 256, 8192));
+		m_ShadowAtlas.Configure(static_cast<uint32_t>(CVars::ClampedShadowAtlasSize()), maxTileSize);
+		const auto maxTile = static_cast<float>(m_ShadowAtlas.GetMaxTileSize());
+		std::vector<ShadowAtlasRequest> requests;
+		requests.reserve(spotCandidates.size() + pointCandidates.size() * 6);
+		for (const ShadowCandidate& spot : spotCandidates)
+		{
+			requests.push_back({.Key = spot.Key, .IdealSize = maxTile * spot.Priority, .Priority = spot.Priority});
+		}
+		for (const ShadowCandidate& point : pointCandidates)
+		{
+			for (uint64_t face = 0; face < 6; ++face)
+			{
+				requests.push_back({.Key = point.Key | (8 + face), .IdealSize = maxTile * point.Priority, .Priority = point.Priority});
+			}
 		}
-		if (droppedSpot && !m_WarnedDroppedSpot)
+		std::vector<ShadowAtlasTile> tiles;
+		m_ShadowAtlas.Allocate(requests, tiles);
+
+		const float invAtlas = 1.0f / static_cast<float>(m_ShadowAtlas.GetAtlasSize());
+		const auto tileRect = [&](const ShadowAtlasTile& tile)
+		{
+			const float size = static_cast<float>(tile.Size) * invAtlas;
+			return glm::vec4(static_cast<float>(tile.X) * invAtlas, static_cast<float>(tile.Y) * invAtlas, size, size);
+		};
+
+		bool atlasFull = false;
+		size_t request = 0;
+		int nextShadowIndex = 0;
+		for (const ShadowCandidate& spot : spotCandidates)
+		{
+			const ShadowAtlasTile& tile = tiles[request++];
+			if (tile.Size == 0)
+			{
+				atlasFull = true; // stays ShadowIndex -1: unshadowed
+				continue;
+			}
+			GPUSpotLight& gpu = lightData.SpotLights[spot.LightIndex];
+			gpu.ShadowIndex = nextShadowIndex++;
+			gpu.ShadowAtlasRect = tileRect(tile);
+		}
+
+		int nextPointShadowSlot = 0;
+		for (const ShadowCandidate& point : pointCandidates)
+		{
+			const std::span<const ShadowAtlasTile> faces(tiles.data() + request, 6);
+			request += 6;
+			// A cube with a missing face would read "lit" across a sixth of the sphere: all six or none.
+			if (std::ranges::any_of(faces, [](const ShadowAtlasTile& tile) { return tile.Size == 0; }))
+			{
+				atlasFull = true;
+				continue;
+			}
+			GPUPointLight& gpu = lightData.PointLights[point.LightIndex];
+			gpu.ShadowSlot = nextPointShadowSlot++;
+			GPUPointShadow& payload = lightData.PointShadows[gpu.ShadowSlot];
+			for (int face = 0; face < 6; ++face)
+			{
+				payload.Face[face] = ShadowPass::ComputePointFaceViewProj(gpu.Position, face, gpu.Range);
+				payload.Rect[face] = tileRect(faces[face]);
+			}
+		}
+		lightData.PointShadowCount = nextPointShadowSlot;
+
+		if (atlasFull && !m_WarnedShadowAtlasFull)
 		{
-			SS_CORE_WARN("More than {} spot lights in scene; extra lights ignored.", MAX_SPOT_LIGHTS);
+			SS_CORE_WARN("Shadow atlas ({0}x{0}) is full; the lowest-priority shadowed lights render unshadowed. "
+			             "Raise render.shadow.atlas_size or lower light ShadowPriority.",
+			             m_ShadowAtlas.GetAtlasSize());
 		}
-		m_WarnedDroppedSpot = droppedSpot;
+		m_WarnedShadowAtlasFull = atlasFull;
 
-		renderer3DSingleton.UploadLights(lightData);
+		renderer3DSingleton.UploadLights(std::move(lightData));
 	}
 }
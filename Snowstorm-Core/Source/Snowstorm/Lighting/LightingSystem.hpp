@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include "Snowstorm/ECS/System.hpp"
+#include "Snowstorm/Render/ShadowAtlas.hpp"
 
 namespace Snowstorm
 {
@@ -19,8 +20,11 @@ namespace Snowstorm
 		// it logs only on the rising edge (not-over -> over) and re-arms once back within budget. Keeps the
 		// warning useful (fires when a scene first exceeds a cap) without repeating it every frame.
 		bool m_WarnedDroppedDirectional = false;
-		bool m_WarnedDroppedPoint = false;
 		bool m_WarnedDroppedPointShadow = false;
-		bool m_WarnedDroppedSpot = false;
+		bool m_WarnedShadowAtlasFull = false;
+
+		// Spot + point shadow tile placement. Lives across frames so a light keeps its tile (and its cached
+		// depth) while its wanted size holds.
+		ShadowAtlasAllocator m_ShadowAtlas;
 	};
 }
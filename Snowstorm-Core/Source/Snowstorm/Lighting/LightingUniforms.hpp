@@ -2,16 +2,21 @@
 
 #include "Snowstorm/Math/Math.hpp"
 
+#include <cstdint>
+#include <vector>
+
 namespace Snowstorm
 {
+	// Point and spot lights have no cap: they live in per-frame StructuredBuffers and the forward pass only
+	// visits the ones binned into its froxel (LightClusters.hpp). Directional lights stay a small FrameCB array.
 	constexpr int MAX_DIRECTIONAL_LIGHTS = 4;
-	constexpr int MAX_POINT_LIGHTS = 16;
-	constexpr int MAX_SPOT_LIGHTS = 16;
 
-	// Hard cap on shadow-casting point (omni) lights. Each costs SIX depth passes (the cube unrolled into
-	// 6 atlas tiles), so real engines cap omni shadows aggressively; 2 is the honest budget here. Only this
-	// many point lights carry the 6-matrix payload (GPUPointShadow below) -- the rest render unshadowed.
-	constexpr int MAX_SHADOW_POINTS = 2;
+	// Cap on shadow-casting point (omni) lights: how many carry the 6-matrix payload (GPUPointShadow below,
+	// 480 bytes of FrameCB each). Each is SIX atlas tiles (the cube unrolled), sized by ShadowAtlasAllocator
+	// like a spot's, and re-rendered only when something in a face changed (ShadowTileCache). Past the cap,
+	// the highest-priority casters (screen coverage x ShadowPriority) keep their shadows; the rest render
+	// unshadowed. Mirrored by MAX_SHADOW_POINTS in Engine.hlsli.
+	constexpr int MAX_SHADOW_POINTS = 8;
 
 	struct GPUDirectionalLight
 	{
@@ -38,9 +43,9 @@ namespace Snowstorm
 
 	// The 6-face shadow payload for ONE shadow-casting point light (cube unrolled into an atlas). Face[f]
 	// reprojects world -> that face's 90-degree light clip; Rect[f] (xy = UV offset, zw = UV scale) maps it
-	// into that face's tile of the shared point atlas. Face order = +X,-X,+Y,-Y,+Z,-Z (see ShadowPass).
-	// Kept separate from GPUPointLight (only MAX_SHADOW_POINTS of these exist) so the 16 point lights don't
-	// each carry 480 bytes of matrices they'll never use.
+	// into that face's tile of the shared shadow atlas. Face order = +X,-X,+Y,-Y,+Z,-Z (see ShadowPass).
+	// Kept separate from GPUPointLight (only MAX_SHADOW_POINTS of these exist) so the point-light buffer
+	// doesn't carry 480 bytes of matrices per light that it will never use.
 	struct GPUPointShadow
 	{
 		glm::mat4 Face[6];
@@ -65,30 +70,54 @@ namespace Snowstorm
 		glm::vec4 ShadowAtlasRect = {0, 0, 1, 1};
 	};
 
-	// Mirrored field-for-field into the C++ FrameCB (RendererService.cpp, which embeds this struct) and
-	// the HLSL cbuffer FrameCB (Engine.hlsli). New arrays are appended AFTER the directional block so the
-	// existing directional offsets don't move. Keep all three in lockstep -- a layout drift silently
-	// corrupts lighting (the "FrameCB mirror trap").
+	// FrameCB constants for the clustered light grid (mirrored as the Cluster* fields of FrameCB in
+	// Engine.hlsli). A world position's view depth is dot(DepthPlane.xyz, p) + DepthPlane.w, and its slice is
+	// floor(log2(depth) * DepthScale + DepthBias). Enabled == 0 means no grid was built for this view and the
+	// shader walks the whole light buffers instead. Several views can share one frame's cluster buffer, so
+	// FirstCluster is where this view's grid starts in it.
+	struct GPULightClusterParams
+	{
+		glm::vec4 DepthPlane{0.0f};
+		float DepthScale = 0.0f;
+		float DepthBias = 0.0f;
+		uint32_t Enabled = 0;
+		uint32_t FirstCluster = 0;
+	};
+
+	// The frame's lights as LightingSystem gathers them. Point and spot lights are unbounded vectors that
+	// RendererService uploads into the light StructuredBuffers; everything else is copied into FrameCB
+	// through GPULightConstants below.
 	struct LightDataBlock
 	{
 		GPUDirectionalLight Lights[MAX_DIRECTIONAL_LIGHTS];
 		int LightCount = 0;
-		float Padding[3] = {0, 0, 0};
 
-		GPUPointLight PointLights[MAX_POINT_LIGHTS];
-		int PointCount = 0;
-		float PointPadding[3] = {0, 0, 0};
+		std::vector<GPUPointLight> PointLights;
+		std::vector<GPUSpotLight> SpotLights;
+
+		// Point (omni) shadow payloads: one per shadow-casting point, indexed by GPUPointLight::ShadowSlot.
+		// Only the first PointShadowCount entries are valid; slots for non-casting points are never written/read.
+		GPUPointShadow PointShadows[MAX_SHADOW_POINTS];
+		int PointShadowCount = 0;
+	};
 
-		GPUSpotLight SpotLights[MAX_SPOT_LIGHTS];
+	// The light block of FrameCB. Mirrored field-for-field into the C++ FrameCB (RendererService.cpp, which
+	// embeds this struct) and the HLSL cbuffer FrameCB (Engine.hlsli). Keep all three in lockstep -- a layout
+	// drift silently corrupts lighting (the "FrameCB mirror trap").
+	struct GPULightConstants
+	{
+		GPUDirectionalLight Lights[MAX_DIRECTIONAL_LIGHTS];
+		int LightCount = 0;
+		// Element counts of the point/spot StructuredBuffers (the loop bound when the grid is disabled).
+		int PointCount = 0;
 		int SpotCount = 0;
-		float SpotPadding[3] = {0, 0, 0};
+		int Padding = 0;
 
-		// Point (omni) shadow payloads: one per shadow-casting point, indexed by GPUPointLight::ShadowSlot.
-		// Appended at the tail so no existing offset moves (the FrameCB mirror is order-sensitive). Only the
-		// first PointShadowCount entries are valid; slots for non-casting points are never written/read.
 		GPUPointShadow PointShadows[MAX_SHADOW_POINTS];
 		int PointShadowCount = 0;
 		float PointShadowPadding[3] = {0, 0, 0};
+
+		GPULightClusterParams Clusters;
 	};
 
 	// CPU-side environment values handed to the renderer (RendererService::UploadEnvironment), which
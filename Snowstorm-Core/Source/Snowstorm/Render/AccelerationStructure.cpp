@@ -18,6 +18,7 @@ namespace Snowstorm
 			return CreateRef<VulkanMicromap>(triangleCount, subdivisionLevel, statesData, statesSize, debugName);
 
 		case RendererAPI::API::None:
+		case RendererAPI::API::Null: // reports IsRayTracingSupported() == false; reaching here is a caller bug
 		case RendererAPI::API::OpenGL:
 		case RendererAPI::API::DX12:
 		default:
@@ -42,6 +43,7 @@ namespace Snowstorm
 			                                 albedoTextureIndex, alphaCutoff, baseColorAlpha, debugName);
 
 		case RendererAPI::API::None:
+		case RendererAPI::API::Null: // reports IsRayTracingSupported() == false; reaching here is a caller bug
 		case RendererAPI::API::OpenGL:
 		case RendererAPI::API::DX12:
 		default:
@@ -61,6 +63,7 @@ namespace Snowstorm
 			                             indexCount, debugName, micromap);
 
 		case RendererAPI::API::None:
+		case RendererAPI::API::Null: // reports IsRayTracingSupported() == false; reaching here is a caller bug
 		case RendererAPI::API::OpenGL:
 		case RendererAPI::API::DX12:
 		default:
@@ -77,6 +80,7 @@ namespace Snowstorm
 			return CreateRef<VulkanTlas>(debugName);
 
 		case RendererAPI::API::None:
+		case RendererAPI::API::Null: // reports IsRayTracingSupported() == false; reaching here is a caller bug
 		case RendererAPI::API::OpenGL:
 		case RendererAPI::API::DX12:
 		default:
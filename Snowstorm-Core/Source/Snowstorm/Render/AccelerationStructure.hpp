@@ -5,11 +5,14 @@
 #include "Snowstorm/Render/Buffer.hpp"
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace Snowstorm
 {
+	class CommandContext;
+
 	// Opacity micromap (VK_EXT_opacity_micromap, RDNA4 / Ada+): a per-triangle table of per-microtriangle
 	// opacity states (4-state, 2 bits each) attached to a BLAS so the hardware resolves cutout coverage during
 	// traversal and invokes the any-hit alpha test only on UNKNOWN (edge) microtriangles. Backend-agnostic
@@ -78,6 +81,13 @@ namespace Snowstorm
 		bool ForceNonOpaque = false;
 	};
 
+	// A run of consecutive instance slots [First, First + Count).
+	struct TlasSlotRange
+	{
+		uint32_t First = 0;
+		uint32_t Count = 0;
+	};
+
 	// Top-level acceleration structure (#118): the scene's set of instanced BLASes that ray-query shaders
 	// trace against. Rebuilt/refit per frame as the scene changes (TlasBuildSystem). Backend-agnostic handle;
 	// the Vulkan impl owns a VkAccelerationStructureKHR + instance/scratch buffers and exposes its handle to
@@ -88,11 +98,23 @@ namespace Snowstorm
 		virtual ~TLAS() = default;
 
 		// (Re)build the TLAS from the given instances. Synchronous — builds on ImmediateSubmit (graphics
-		// queue). Empty instance list => an empty (but valid) TLAS. A full rebuild each call: the scene's
-		// instance count is small and TlasBuildSystem only calls this when the scene actually changed, so the
-		// cost is negligible; incremental refit (UPDATE mode) is a deferred optimization, not needed here.
+		// queue). Empty instance list => an empty (but valid) TLAS. instanceCustomIndex = the instance's
+		// position in the vector. Built refit-capable, so later transform-only changes can go through Refit.
 		virtual void Build(const std::vector<TLASInstance>& instances) = 0;
 
+		// Stage an in-place refit (UPDATE mode) after only transforms changed: `instances` is the same set, in the
+		// same order and with the same BLASes and flags, as the last Build; only the slots in `dirty` are
+		// re-encoded. Nothing reaches the GPU here -- RecordPendingRefit records the update into a frame's command
+		// buffer, so a refit never drains the device. Much cheaper than Build, but keeps the old BVH topology, so
+		// the caller rebuilds after a number of refits. Returns false (nothing staged) when a refit isn't
+		// possible -- never built, or the instance count changed -- and the caller must Build instead.
+		virtual bool Refit(const std::vector<TLASInstance>& instances, std::span<const TlasSlotRange> dirty) = 0;
+
+		// Record the refits staged since the last call into this frame's command buffer (no-op when none are).
+		// Call after BeginFrame -- its fence wait is what frees frameIndex's copy of the instance array -- and
+		// before any pass traces the TLAS.
+		virtual void RecordPendingRefit(CommandContext& ctx, uint32_t frameIndex) = 0;
+
 		[[nodiscard]] virtual uint32_t GetInstanceCount() const = 0;
 
 		static Ref<TLAS> Create(const std::string& debugName = "");
@@ -2,6 +2,7 @@
 
 #include "RendererAPI.hpp"
 
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanBuffer.hpp"
 
 namespace Snowstorm
@@ -21,6 +22,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanBuffer>(size, usage, data, hostVisible, debugName);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullBuffer>(size, usage, data, hostVisible);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "RendererAPI::DX12 is currently not supported!");
 			return nullptr;
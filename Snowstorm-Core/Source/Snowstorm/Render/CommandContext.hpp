@@ -21,6 +21,17 @@ namespace Snowstorm
 		uint64_t FragInvocations = 0; // fragment-shader invocations this pass (0 = unmeasured / compute pass)
 	};
 
+	// Binds a context dropped because the state they asked for was already bound: the same pipeline, the same
+	// descriptor set in a slot, the same vertex buffer at a binding, the same index buffer. DescriptorSets counts
+	// sets, not bind calls -- a call that re-binds sets 0..2 when only set 1 changed counts two.
+	struct SkippedBindStats
+	{
+		uint32_t PipelineBinds = 0;
+		uint32_t DescriptorSets = 0;
+		uint32_t VertexBuffers = 0;
+		uint32_t IndexBuffers = 0;
+	};
+
 	class CommandContext
 	{
 	public:
@@ -41,6 +52,11 @@ namespace Snowstorm
 		                         float minDepth = 0.0f, float maxDepth = 1.0f) = 0;
 		virtual void SetScissor(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
 
+		// Clear a rect of the bound target's depth attachment to `depth`, inside the render pass. For targets
+		// loaded rather than cleared on BeginRenderPass (the shadow atlases), so one tile can be re-rendered
+		// while the others keep their contents.
+		virtual void ClearDepthRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, float depth = 1.0f) = 0;
+
 		// Pipeline and Resources
 		virtual void BindPipeline(const Ref<Pipeline>& pipeline) = 0;
 
@@ -113,6 +129,11 @@ namespace Snowstorm
 		// Reset the internal state between passes if the backend needs it
 		virtual void ResetState() = 0;
 
+		// Binds skipped as redundant since the context began recording (cumulative over the command buffer, so
+		// a caller measuring one scene snapshots before and diffs after). Default: a backend that doesn't
+		// filter binds skips none.
+		virtual SkippedBindStats GetSkippedBinds() const { return {}; }
+
 		// --- Per-pass GPU timing (timestamp queries) ---
 		// Bracket a render/compute pass with a named GPU scope: BeginGpuScope writes a start timestamp,
 		// EndGpuScope an end timestamp, into a per-frame query pool. The pair is resolved one frame later
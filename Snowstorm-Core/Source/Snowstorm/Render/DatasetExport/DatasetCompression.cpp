@@ -0,0 +1,175 @@
+#include "DatasetCompression.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <lz4frame.h>
+#include <zstd.h>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// zstd 1 compresses a 1080p half-float frame at several hundred MB/s per thread; higher levels buy a few
+		// percent for a multiple of the CPU, which the writer's per-frame budget can't afford.
+		constexpr int kDefaultZstdLevel = 1;
+
+		bool DecompressLz4(const std::span<const uint8_t> input, std::vector<uint8_t>& out)
+		{
+			LZ4F_dctx* dctx = nullptr;
+			if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION)))
+			{
+				SS_CORE_ERROR("DatasetCompression: cannot create an LZ4 decompression context");
+				return false;
+			}
+
+			LZ4F_frameInfo_t info{};
+			size_t consumed = input.size();
+			bool ok = !LZ4F_isError(LZ4F_getFrameInfo(dctx, &info, input.data(), &consumed));
+			out.clear();
+			out.resize(ok ? static_cast<size_t>(info.contentSize) : 0);
+			size_t inPos = consumed;
+			size_t outPos = 0;
+			while (ok && inPos < input.size())
+			{
+				size_t dstSize = out.size() - outPos;
+				size_t srcSize = input.size() - inPos;
+				const size_t hint = LZ4F_decompress(dctx, out.data() + outPos, &dstSize, input.data() + inPos, &srcSize, nullptr);
+				ok = !LZ4F_isError(hint) && (dstSize > 0 || srcSize > 0);
+				inPos += srcSize;
+				outPos += dstSize;
+				if (hint == 0)
+				{
+					break; // frame complete
+				}
+			}
+			LZ4F_freeDecompressionContext(dctx);
+			if (!ok || info.contentSize == 0 || outPos != out.size())
+			{
+				SS_CORE_ERROR("DatasetCompression: corrupt or truncated LZ4 frame");
+				return false;
+			}
+			return true;
+		}
+	}
+
+	const char* DatasetCompressionName(const DatasetCompression compression)
+	{
+		switch (compression)
+		{
+		case DatasetCompression::Zstd:
+			return "zstd";
+		case DatasetCompression::Lz4:
+			return "lz4";
+		case DatasetCompression::None:
+			break;
+		}
+		return "none";
+	}
+
+	std::optional<DatasetCompression> ParseDatasetCompression(const std::string_view name)
+	{
+		if (name.empty() || name == "none")
+		{
+			return DatasetCompression::None;
+		}
+		if (name == "zstd")
+		{
+			return DatasetCompression::Zstd;
+		}
+		if (name == "lz4")
+		{
+			return DatasetCompression::Lz4;
+		}
+		return std::nullopt;
+	}
+
+	const char* DatasetCompressionExtension(const DatasetCompression compression)
+	{
+		switch (compression)
+		{
+		case DatasetCompression::Zstd:
+			return ".zst";
+		case DatasetCompression::Lz4:
+			return ".lz4";
+		case DatasetCompression::None:
+			break;
+		}
+		return "";
+	}
+
+	bool CompressDatasetBytes(const std::span<const uint8_t> input, const DatasetCompression compression, const int level,
+	                          std::vector<uint8_t>& out)
+	{
+		switch (compression)
+		{
+		case DatasetCompression::None:
+			out.assign(input.begin(), input.end());
+			return true;
+
+		case DatasetCompression::Zstd:
+		{
+			out.resize(ZSTD_compressBound(input.size()));
+			const size_t written = ZSTD_compress(out.data(), out.size(), input.data(), input.size(),
+			                                     level > 0 ? level : kDefaultZstdLevel);
+			if (ZSTD_isError(written))
+			{
+				SS_CORE_ERROR("DatasetCompression: zstd failed: {}", ZSTD_getErrorName(written));
+				return false;
+			}
+			out.resize(written);
+			return true;
+		}
+
+		case DatasetCompression::Lz4:
+		{
+			// Record the content size in the frame header so the reader can size its output up front.
+			LZ4F_preferences_t prefs{};
+			prefs.frameInfo.contentSize = input.size();
+			prefs.compressionLevel = level > 0 ? level : 0;
+			out.resize(LZ4F_compressFrameBound(input.size(), &prefs));
+			const size_t written = LZ4F_compressFrame(out.data(), out.size(), input.data(), input.size(), &prefs);
+			if (LZ4F_isError(written))
+			{
+				SS_CORE_ERROR("DatasetCompression: lz4 failed: {}", LZ4F_getErrorName(written));
+				return false;
+			}
+			out.resize(written);
+			return true;
+		}
+		}
+		return false;
+	}
+
+	bool DecompressDatasetBytes(const std::span<const uint8_t> input, const DatasetCompression compression,
+	                            std::vector<uint8_t>& out)
+	{
+		switch (compression)
+		{
+		case DatasetCompression::None:
+			out.assign(input.begin(), input.end());
+			return true;
+
+		case DatasetCompression::Zstd:
+		{
+			const unsigned long long size = ZSTD_getFrameContentSize(input.data(), input.size());
+			if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN)
+			{
+				SS_CORE_ERROR("DatasetCompression: not a zstd frame with a recorded content size");
+				return false;
+			}
+			out.resize(static_cast<size_t>(size));
+			const size_t read = ZSTD_decompress(out.data(), out.size(), input.data(), input.size());
+			if (ZSTD_isError(read) || read != out.size())
+			{
+				SS_CORE_ERROR("DatasetCompression: corrupt zstd frame");
+				return false;
+			}
+			return true;
+		}
+
+		case DatasetCompression::Lz4:
+			return DecompressLz4(input, out);
+		}
+		return false;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Per-member compression for dataset export. Each .npy is compressed on its own (not the whole shard) so
+	// a training loader can seek to one member through the manifest's offset and decode just that array.
+	//   Zstd: a standard zstd frame (zstd CLI / python `zstandard`). Best ratio; the default level is fast.
+	//   Lz4:  an LZ4 frame (lz4 CLI / python `lz4.frame`). Lower ratio, decodes several times faster.
+	// HDR half-float images typically shrink 2-3x under zstd; the tonemapped LDR GT a little more.
+	enum class DatasetCompression
+	{
+		None,
+		Zstd,
+		Lz4,
+	};
+
+	// "none" / "zstd" / "lz4" (the manifest and dataset.export.compression spelling).
+	const char* DatasetCompressionName(DatasetCompression compression);
+	std::optional<DatasetCompression> ParseDatasetCompression(std::string_view name);
+
+	// File / archive-member suffix appended after ".npy": "", ".zst", ".lz4".
+	const char* DatasetCompressionExtension(DatasetCompression compression);
+
+	// Compress `input` into `out` (its capacity is reused). `level` <= 0 picks the codec's fast default.
+	// Returns false (logged) if the codec reports an error; None copies.
+	bool CompressDatasetBytes(std::span<const uint8_t> input, DatasetCompression compression, int level,
+	                          std::vector<uint8_t>& out);
+
+	// Inverse of CompressDatasetBytes. False (logged) on corrupt or truncated input.
+	bool DecompressDatasetBytes(std::span<const uint8_t> input, DatasetCompression compression, std::vector<uint8_t>& out);
+}
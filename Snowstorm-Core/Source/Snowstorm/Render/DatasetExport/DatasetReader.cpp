@@ -0,0 +1,90 @@
+#include "DatasetReader.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetCompression.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Read `size` bytes at `offset` (size < 0: the rest of the file).
+		bool ReadRange(const std::filesystem::path& path, const uint64_t offset, const int64_t size, std::vector<uint8_t>& out)
+		{
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
+			if (!in)
+			{
+				SS_CORE_ERROR("ReadDatasetImage: cannot open '{}'", path.string());
+				return false;
+			}
+			const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+			const uint64_t count = size < 0 ? fileSize - std::min(offset, fileSize) : static_cast<uint64_t>(size);
+			if (offset + count > fileSize)
+			{
+				SS_CORE_ERROR("ReadDatasetImage: '{}' is {} bytes, entry needs {} at offset {}", path.string(), fileSize, count, offset);
+				return false;
+			}
+			out.resize(static_cast<size_t>(count));
+			in.seekg(static_cast<std::streamoff>(offset));
+			in.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(count));
+			return static_cast<bool>(in);
+		}
+	}
+
+	std::optional<NpyArray> ReadDatasetImage(const std::filesystem::path& datasetDir, const nlohmann::json& image)
+	{
+		if (!image.is_object() || !image.contains("file") || !image["file"].is_string())
+		{
+			SS_CORE_ERROR("ReadDatasetImage: manifest entry has no 'file'");
+			return std::nullopt;
+		}
+		const std::string file = image["file"].get<std::string>();
+
+		std::vector<uint8_t> stored;
+		if (image.contains("shard"))
+		{
+			const auto& shard = image["shard"];
+			const auto& offset = image.contains("offset") ? image["offset"] : nlohmann::json();
+			const auto& bytes = image.contains("bytes") ? image["bytes"] : nlohmann::json();
+			if (!shard.is_string() || !offset.is_number_unsigned() || !bytes.is_number_unsigned())
+			{
+				SS_CORE_ERROR("ReadDatasetImage: '{}' names a shard without a valid offset/bytes", file);
+				return std::nullopt;
+			}
+			if (!ReadRange(datasetDir / shard.get<std::string>(), offset.get<uint64_t>(), bytes.get<int64_t>(), stored))
+			{
+				return std::nullopt;
+			}
+		}
+		else if (!ReadRange(datasetDir / file, 0, -1, stored))
+		{
+			return std::nullopt;
+		}
+
+		const std::string codecName = image.contains("compression") && image["compression"].is_string()
+			                              ? image["compression"].get<std::string>()
+			                              : std::string();
+		const std::optional<DatasetCompression> codec = ParseDatasetCompression(codecName);
+		if (!codec)
+		{
+			SS_CORE_ERROR("ReadDatasetImage: '{}' uses unknown compression '{}'", file, codecName);
+			return std::nullopt;
+		}
+		if (*codec == DatasetCompression::None)
+		{
+			return ParseNpy(stored, file);
+		}
+
+		std::vector<uint8_t> raw;
+		if (!DecompressDatasetBytes(stored, *codec, raw))
+		{
+			SS_CORE_ERROR("ReadDatasetImage: cannot decompress '{}'", file);
+			return std::nullopt;
+		}
+		return ParseNpy(raw, file);
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Snowstorm/Render/DatasetExport/NpyReader.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <optional>
+
+namespace Snowstorm
+{
+	// Load one array of a dataset frame from its manifest entry (e.g. `frame["lr"]`), whatever layout the
+	// DatasetWriter used: a loose `file`, or `bytes` at `offset` inside the tar `shard`, optionally
+	// zstd/LZ4-compressed per "compression". `datasetDir` is the directory holding manifest.json. Returns
+	// nullopt (logged) on a malformed entry, a missing/short file or a corrupt payload.
+	std::optional<NpyArray> ReadDatasetImage(const std::filesystem::path& datasetDir, const nlohmann::json& image);
+}
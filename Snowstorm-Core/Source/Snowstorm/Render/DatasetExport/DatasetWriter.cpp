@@ -0,0 +1,370 @@
+#include "DatasetWriter.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Loose exports rewrite the manifest every this many frames (and on Flush). Rewriting it per frame, as the
+		// synchronous exporter did, is quadratic over a multi-day run.
+		constexpr uint32_t kLooseManifestInterval = 16;
+
+		// Recycled buffers kept per queue slot: the four arrays plus their compressed copies.
+		constexpr size_t kPooledBuffersPerFrame = 8;
+
+		const char* DTypeName(const NpyDType dtype)
+		{
+			switch (dtype)
+			{
+			case NpyDType::Float32:
+				return "float32";
+			case NpyDType::UInt8:
+				return "uint8";
+			case NpyDType::Float16:
+				break;
+			}
+			return "float16";
+		}
+
+		std::string MemberName(const uint64_t frame, const std::string& name, const DatasetCompression compression)
+		{
+			char buffer[96];
+			std::snprintf(buffer, sizeof(buffer), "frame_%06llu_%s.npy%s", static_cast<unsigned long long>(frame),
+			              name.c_str(), DatasetCompressionExtension(compression));
+			return buffer;
+		}
+
+		std::string ShardName(const uint32_t index)
+		{
+			char buffer[32];
+			std::snprintf(buffer, sizeof(buffer), "shard_%06u.tar", index);
+			return buffer;
+		}
+
+		bool WriteBytes(const std::filesystem::path& path, const std::span<const uint8_t> bytes)
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!out)
+			{
+				SS_CORE_ERROR("DatasetWriter: cannot write '{}'", path.string());
+				return false;
+			}
+			return true;
+		}
+	}
+
+	DatasetWriter::DatasetWriter(JobSystem* jobs)
+		: m_Jobs(jobs)
+	{
+	}
+
+	DatasetWriter::~DatasetWriter()
+	{
+		Flush();
+	}
+
+	bool DatasetWriter::Open(const DatasetWriterConfig& config)
+	{
+		Flush();
+		m_Open = false;
+
+		std::error_code ec;
+		std::filesystem::create_directories(config.OutputDir, ec);
+		if (ec)
+		{
+			SS_CORE_ERROR("DatasetExport: cannot create output dir '{}': {}", config.OutputDir, ec.message());
+			return false;
+		}
+
+		m_Config = config;
+		m_Config.MaxQueuedFrames = std::max(m_Config.MaxQueuedFrames, 1u);
+		const bool v1 = m_Config.FramesPerShard == 0 && m_Config.Compression == DatasetCompression::None;
+		m_Manifest = nlohmann::json::object();
+		m_Manifest["format"] = v1 ? "snowstorm-sr-dataset-v1" : "snowstorm-sr-dataset-v2";
+		m_Manifest["frames"] = nlohmann::json::array();
+		if (!v1)
+		{
+			m_Manifest["compression"] = DatasetCompressionName(m_Config.Compression);
+			m_Manifest["frames_per_shard"] = m_Config.FramesPerShard;
+			m_Manifest["shards"] = nlohmann::json::array();
+		}
+		m_ShardIndex = 0;
+		m_ShardFrames = 0;
+		m_FramesSinceManifest = 0;
+		{
+			std::lock_guard lock(m_Mutex);
+			m_Stats = {};
+			m_Stats.QueueCapacity = m_Config.MaxQueuedFrames;
+		}
+		m_Open = true;
+		return true;
+	}
+
+	std::vector<uint8_t> DatasetWriter::AcquireBuffer()
+	{
+		std::lock_guard lock(m_PoolMutex);
+		if (m_FreeBuffers.empty())
+		{
+			return {};
+		}
+		std::vector<uint8_t> buffer = std::move(m_FreeBuffers.back());
+		m_FreeBuffers.pop_back();
+		buffer.clear();
+		return buffer;
+	}
+
+	void DatasetWriter::ReleaseBuffer(std::vector<uint8_t> buffer)
+	{
+		if (buffer.capacity() == 0)
+		{
+			return;
+		}
+		std::lock_guard lock(m_PoolMutex);
+		if (m_FreeBuffers.size() < (m_Config.MaxQueuedFrames + 2) * kPooledBuffersPerFrame)
+		{
+			m_FreeBuffers.push_back(std::move(buffer));
+		}
+	}
+
+	void DatasetWriter::Submit(DatasetFrame frame)
+	{
+		if (!m_Open)
+		{
+			SS_CORE_ERROR("DatasetWriter: Submit before a successful Open; frame {} dropped", frame.Index);
+			return;
+		}
+
+		uint64_t sequence = 0;
+		{
+			std::unique_lock lock(m_Mutex);
+			if (m_Queue.size() >= m_Config.MaxQueuedFrames)
+			{
+				// Backpressure: the disk (or the compressor) is behind the capture. Wait for the oldest frame to
+				// land rather than queueing without bound.
+				const auto start = std::chrono::steady_clock::now();
+				m_Changed.wait(lock, [this]
+				               { return m_Queue.size() < m_Config.MaxQueuedFrames; });
+				++m_Stats.Stalls;
+				m_Stats.StallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			}
+			sequence = m_NextSequence++;
+			Pending pending;
+			pending.Sequence = sequence;
+			m_Queue.push_back(std::move(pending));
+			++m_Stats.FramesSubmitted;
+			m_Stats.QueuedFrames = static_cast<uint32_t>(m_Queue.size());
+		}
+
+		auto task = [this, sequence, frame = std::move(frame)]() mutable
+		{
+			std::vector<EncodedImage> encoded;
+			Encode(frame, encoded);
+			Complete(sequence, std::move(frame), std::move(encoded));
+		};
+		if (m_Jobs)
+		{
+			m_Jobs->Submit(std::move(task));
+		}
+		else
+		{
+			task();
+		}
+	}
+
+	void DatasetWriter::Encode(DatasetFrame& frame, std::vector<EncodedImage>& encoded)
+	{
+		encoded.reserve(frame.Images.size());
+		for (DatasetImage& image : frame.Images)
+		{
+			EncodedImage info;
+			info.RawBytes = image.Npy.size();
+			if (m_Config.Compression != DatasetCompression::None)
+			{
+				std::vector<uint8_t> packed = AcquireBuffer();
+				if (CompressDatasetBytes(image.Npy, m_Config.Compression, m_Config.CompressionLevel, packed))
+				{
+					std::swap(image.Npy, packed);
+					info.Compression = m_Config.Compression;
+				}
+				ReleaseBuffer(std::move(packed)); // the raw .npy, or the failed attempt (stored uncompressed)
+			}
+			encoded.push_back(info);
+		}
+	}
+
+	void DatasetWriter::Complete(const uint64_t sequence, DatasetFrame frame, std::vector<EncodedImage> encoded)
+	{
+		std::unique_lock lock(m_Mutex);
+		Pending& slot = m_Queue[static_cast<size_t>(sequence - m_Queue.front().Sequence)];
+		slot.Frame = std::move(frame);
+		slot.Images = std::move(encoded);
+		slot.Encoded = true;
+
+		if (m_Writing)
+		{
+			return; // the current writer reaches this frame in order
+		}
+
+		// Take the writer token and commit every frame at the head of the queue that is ready. The head stays
+		// in the deque while it is written (deque::push_back never moves existing elements, and nobody else
+		// touches an encoded entry), so a Submit can't refill its slot before it is on disk.
+		m_Writing = true;
+		while (!m_Queue.empty() && m_Queue.front().Encoded)
+		{
+			Pending& head = m_Queue.front();
+			lock.unlock();
+			uint64_t storedBytes = 0;
+			const bool ok = WriteFrame(head, storedBytes);
+			lock.lock();
+
+			for (const EncodedImage& info : head.Images)
+			{
+				m_Stats.RawBytes += info.RawBytes;
+			}
+			m_Stats.StoredBytes += storedBytes;
+			++(ok ? m_Stats.FramesWritten : m_Stats.WriteErrors);
+			m_Queue.pop_front();
+			m_Stats.QueuedFrames = static_cast<uint32_t>(m_Queue.size());
+			m_Changed.notify_all();
+		}
+		m_Writing = false;
+		m_Changed.notify_all();
+	}
+
+	bool DatasetWriter::WriteFrame(Pending& pending, uint64_t& storedBytes)
+	{
+		DatasetFrame& frame = pending.Frame;
+		const std::filesystem::path dir(m_Config.OutputDir);
+		const bool sharded = m_Config.FramesPerShard > 0;
+
+		bool ok = true;
+		if (sharded && !m_Shard.IsOpen())
+		{
+			ok = m_Shard.Open((dir / ShardName(m_ShardIndex)).string());
+		}
+
+		nlohmann::json entry;
+		entry["frame"] = frame.Index;
+		entry["jitter_ndc"] = {frame.JitterNdc[0], frame.JitterNdc[1]};
+		entry["scale"] = frame.Scale;
+		for (size_t i = 0; ok && i < frame.Images.size(); ++i)
+		{
+			const DatasetImage& image = frame.Images[i];
+			const EncodedImage& info = pending.Images[i];
+			const std::string member = MemberName(frame.Index, image.Name, info.Compression);
+
+			nlohmann::json desc = {{"file", member}, {"w", image.Width}, {"h", image.Height}, {"c", image.Channels}, {"dtype", DTypeName(image.DType)}};
+			if (info.Compression != DatasetCompression::None)
+			{
+				desc["compression"] = DatasetCompressionName(info.Compression);
+				desc["raw_bytes"] = info.RawBytes;
+			}
+			if (sharded)
+			{
+				const int64_t offset = m_Shard.Append(member, image.Npy);
+				ok = offset >= 0;
+				desc["shard"] = ShardName(m_ShardIndex);
+				desc["offset"] = offset;
+				desc["bytes"] = image.Npy.size();
+			}
+			else
+			{
+				ok = WriteBytes(dir / member, image.Npy);
+			}
+			storedBytes += image.Npy.size();
+			entry[image.Name] = std::move(desc);
+		}
+
+		for (DatasetImage& image : frame.Images)
+		{
+			ReleaseBuffer(std::move(image.Npy));
+		}
+		if (!ok)
+		{
+			return false; // logged by the writer that failed; the frame is left out of the manifest
+		}
+
+		m_Manifest["frames"].push_back(std::move(entry));
+		if (sharded)
+		{
+			if (++m_ShardFrames >= m_Config.FramesPerShard)
+			{
+				CloseShard();
+				WriteManifest();
+			}
+		}
+		else if (++m_FramesSinceManifest >= kLooseManifestInterval)
+		{
+			WriteManifest();
+		}
+		return true;
+	}
+
+	void DatasetWriter::CloseShard()
+	{
+		if (!m_Shard.IsOpen())
+		{
+			return;
+		}
+		m_Shard.Close();
+		m_Manifest["shards"].push_back({{"file", ShardName(m_ShardIndex)}, {"frames", m_ShardFrames}, {"bytes", m_Shard.Size()}});
+		++m_ShardIndex;
+		m_ShardFrames = 0;
+
+		std::lock_guard lock(m_Mutex);
+		++m_Stats.Shards;
+	}
+
+	void DatasetWriter::WriteManifest()
+	{
+		// Write-then-rename, so a reader (or a crash) never sees a half-written manifest.
+		const std::filesystem::path dir(m_Config.OutputDir);
+		const std::filesystem::path temp = dir / "manifest.json.tmp";
+		{
+			std::ofstream out(temp, std::ios::trunc);
+			out << m_Manifest.dump(1, '\t');
+			if (!out)
+			{
+				SS_CORE_ERROR("DatasetWriter: cannot write '{}'", temp.string());
+				return;
+			}
+		}
+		std::error_code ec;
+		std::filesystem::rename(temp, dir / "manifest.json", ec);
+		if (ec)
+		{
+			SS_CORE_ERROR("DatasetWriter: cannot replace manifest.json: {}", ec.message());
+		}
+		m_FramesSinceManifest = 0;
+	}
+
+	void DatasetWriter::Flush()
+	{
+		if (!m_Open)
+		{
+			return;
+		}
+		{
+			std::unique_lock lock(m_Mutex);
+			m_Changed.wait(lock, [this]
+			               { return m_Queue.empty() && !m_Writing; });
+		}
+		CloseShard();
+		WriteManifest();
+	}
+
+	DatasetExportStats DatasetWriter::GetStats() const
+	{
+		std::lock_guard lock(m_Mutex);
+		return m_Stats;
+	}
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Snowstorm/Render/DatasetExport/DatasetCompression.hpp"
+#include "Snowstorm/Render/DatasetExport/NpyWriter.hpp"
+#include "Snowstorm/Render/DatasetExport/TarWriter.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// One array of a dataset tuple, already encoded as a complete .npy in memory (EncodeNpy into a buffer from
+	// DatasetWriter::AcquireBuffer). `Name` is the manifest key and filename suffix ("lr", "mv", "gt", "gt_ldr").
+	struct DatasetImage
+	{
+		std::string Name;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Channels = 4;
+		NpyDType DType = NpyDType::Float16;
+		std::vector<uint8_t> Npy;
+	};
+
+	// One captured tuple: its on-disk index, the per-frame metadata the manifest records, and its arrays.
+	struct DatasetFrame
+	{
+		uint64_t Index = 0;
+		std::array<float, 2> JitterNdc{};
+		float Scale = 1.0f;
+		std::vector<DatasetImage> Images;
+	};
+
+	struct DatasetWriterConfig
+	{
+		std::string OutputDir;
+		// Frames per tar shard (shard_NNNNNN.tar). 0 = one loose .npy file per array, the original layout.
+		uint32_t FramesPerShard = 0;
+		DatasetCompression Compression = DatasetCompression::None;
+		int CompressionLevel = 0; // <= 0: the codec's fast default
+		// Frames that may be queued (captured but not yet on disk) before Submit blocks. Bounds the writer's
+		// memory at roughly MaxQueuedFrames full tuples.
+		uint32_t MaxQueuedFrames = 8;
+	};
+
+	// Writer progress + backpressure, for the stats overlay and the app's stop-after-N check.
+	struct DatasetExportStats
+	{
+		uint64_t FramesSubmitted = 0;
+		uint64_t FramesWritten = 0; // fully on disk
+		uint32_t QueuedFrames = 0;  // submitted, not yet written
+		uint32_t QueueCapacity = 0;
+		uint64_t Stalls = 0;        // Submit calls that found the queue full and waited
+		double StallMs = 0.0;       // total time the capturing thread spent in those waits
+		uint64_t RawBytes = 0;      // .npy bytes before compression
+		uint64_t StoredBytes = 0;   // bytes written after compression (excluding tar framing)
+		uint32_t Shards = 0;        // shards completed
+		uint64_t WriteErrors = 0;
+	};
+
+	// Asynchronous dataset serializer (#46 follow-up). The capture side only copies the readback into an owned
+	// buffer and calls Submit; compression runs as one JobSystem task per frame (frames compress in parallel),
+	// and the finished frames are written strictly in submission order by whichever task completes the
+	// oldest outstanding frame — a single-writer "ordered commit" that never blocks a worker waiting on
+	// another task. The queue is bounded: when MaxQueuedFrames are outstanding, Submit waits (counted in the
+	// stats) so a disk slower than the frame rate throttles the capture instead of growing memory.
+	//
+	// Output: loose files (frame_NNNNNN_<name>.npy[.zst|.lz4]) or tar shards of FramesPerShard frames whose
+	// members carry the same names, plus manifest.json. An uncompressed loose export writes the original
+	// "snowstorm-sr-dataset-v1" manifest; anything else writes v2, whose per-array entries add
+	// "compression"/"raw_bytes" and, when sharded, "shard"/"offset"/"bytes" so a reader seeks to one member
+	// without scanning the archive (ReadDatasetImage). The manifest is rewritten (via a temp file + rename)
+	// whenever a shard completes, every few loose frames, and on Flush, so an interrupted run stays loadable.
+	class DatasetWriter final
+	{
+	public:
+		// `jobs` == nullptr encodes and writes inline in Submit (tests, tools).
+		explicit DatasetWriter(JobSystem* jobs);
+		~DatasetWriter(); // Flush()es
+
+		DatasetWriter(const DatasetWriter&) = delete;
+		DatasetWriter& operator=(const DatasetWriter&) = delete;
+
+		// Create the output dir and start a fresh manifest. False (logged) if the dir can't be created.
+		bool Open(const DatasetWriterConfig& config);
+		[[nodiscard]] bool IsOpen() const { return m_Open; }
+
+		// A byte buffer recycled from a written frame (capacity kept), so steady-state capture doesn't allocate
+		// and page-fault a fresh full-res buffer per array per frame.
+		std::vector<uint8_t> AcquireBuffer();
+
+		// Queue a frame; blocks while the queue is full.
+		void Submit(DatasetFrame frame);
+
+		// Wait until every submitted frame is on disk, close the open shard and rewrite the manifest. Further
+		// Submits start a new shard.
+		void Flush();
+
+		[[nodiscard]] DatasetExportStats GetStats() const;
+
+	private:
+		struct EncodedImage
+		{
+			uint64_t RawBytes = 0; // before compression
+			DatasetCompression Compression = DatasetCompression::None; // None if the codec failed (stored raw)
+		};
+
+		struct Pending
+		{
+			uint64_t Sequence = 0;
+			bool Encoded = false;
+			DatasetFrame Frame;
+			std::vector<EncodedImage> Images; // parallel to Frame.Images
+		};
+
+		void Encode(DatasetFrame& frame, std::vector<EncodedImage>& encoded);
+		void Complete(uint64_t sequence, DatasetFrame frame, std::vector<EncodedImage> encoded);
+		bool WriteFrame(Pending& pending, uint64_t& storedBytes); // writer-token holder only
+		void CloseShard();                                        // writer-token holder / quiescent only
+		void WriteManifest();                                     // writer-token holder / quiescent only
+		void ReleaseBuffer(std::vector<uint8_t> buffer);
+
+		JobSystem* m_Jobs = nullptr;
+		DatasetWriterConfig m_Config;
+		bool m_Open = false;
+
+		mutable std::mutex m_Mutex;
+		std::condition_variable m_Changed; // a frame was written / the writer token was released
+		std::deque<Pending> m_Queue;       // outstanding frames in sequence order
+		uint64_t m_NextSequence = 0;
+		bool m_Writing = false;            // the writer token: one thread drains the queue head at a time
+		DatasetExportStats m_Stats;
+
+		std::mutex m_PoolMutex;
+		std::vector<std::vector<uint8_t>> m_FreeBuffers;
+
+		// Output state, touched only by the writer-token holder (or by Flush once the queue is idle).
+		TarWriter m_Shard;
+		uint32_t m_ShardIndex = 0;
+		uint32_t m_ShardFrames = 0;
+		nlohmann::json m_Manifest;
+		uint32_t m_FramesSinceManifest = 0;
+	};
+}
@@ -0,0 +1,183 @@
+#include "NpyReader.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/Neural/NeuralQuantization.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// The quoted value following `'key':` in the header dict, or the raw token up to the next ',' / '}'.
+		std::string DictValue(const std::string& dict, const std::string& key)
+		{
+			const size_t k = dict.find("'" + key + "'");
+			if (k == std::string::npos)
+			{
+				return {};
+			}
+			size_t v = dict.find(':', k);
+			if (v == std::string::npos)
+			{
+				return {};
+			}
+			++v;
+			while (v < dict.size() && dict[v] == ' ')
+			{
+				++v;
+			}
+			if (v < dict.size() && (dict[v] == '\'' || dict[v] == '"'))
+			{
+				const size_t end = dict.find(dict[v], v + 1);
+				return end == std::string::npos ? std::string{} : dict.substr(v + 1, end - v - 1);
+			}
+			if (v < dict.size() && dict[v] == '(')
+			{
+				const size_t end = dict.find(')', v);
+				return end == std::string::npos ? std::string{} : dict.substr(v, end - v + 1);
+			}
+			const size_t end = dict.find_first_of(",}", v);
+			return dict.substr(v, end == std::string::npos ? std::string::npos : end - v);
+		}
+	}
+
+	bool ParseNpyHeaderDict(const std::string& dict, std::vector<size_t>& shape, NpyDType& dtype)
+	{
+		const std::string descr = DictValue(dict, "descr");
+		if (descr == "<f2")
+		{
+			dtype = NpyDType::Float16;
+		}
+		else if (descr == "<f4")
+		{
+			dtype = NpyDType::Float32;
+		}
+		else if (descr == "|u1" || descr == "<u1")
+		{
+			dtype = NpyDType::UInt8;
+		}
+		else
+		{
+			return false;
+		}
+
+		if (DictValue(dict, "fortran_order").rfind("False", 0) != 0)
+		{
+			return false;
+		}
+
+		const std::string tuple = DictValue(dict, "shape");
+		if (tuple.size() < 2 || tuple.front() != '(' || tuple.back() != ')')
+		{
+			return false;
+		}
+		shape.clear();
+		size_t value = 0;
+		bool inNumber = false;
+		for (size_t i = 1; i + 1 < tuple.size(); ++i)
+		{
+			const char c = tuple[i];
+			if (c >= '0' && c <= '9')
+			{
+				value = value * 10 + static_cast<size_t>(c - '0');
+				inNumber = true;
+			}
+			else if (c == ',' || c == ' ' || c == 'L')
+			{
+				if (inNumber && c != 'L')
+				{
+					shape.push_back(value);
+					value = 0;
+					inNumber = false;
+				}
+			}
+			else
+			{
+				return false;
+			}
+		}
+		if (inNumber)
+		{
+			shape.push_back(value);
+		}
+		return true;
+	}
+
+	std::optional<NpyArray> ReadNpy(const std::string& path)
+	{
+		std::ifstream f(path, std::ios::binary | std::ios::ate);
+		if (!f)
+		{
+			SS_CORE_ERROR("ReadNpy: cannot open '{}'", path);
+			return std::nullopt;
+		}
+		std::vector<uint8_t> bytes(static_cast<size_t>(f.tellg()));
+		f.seekg(0);
+		f.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		if (!f)
+		{
+			SS_CORE_ERROR("ReadNpy: cannot read '{}'", path);
+			return std::nullopt;
+		}
+		return ParseNpy(bytes, path);
+	}
+
+	std::optional<NpyArray> ParseNpy(const std::span<const uint8_t> bytes, const std::string& what)
+	{
+		const uint8_t magic[6] = {0x93, 'N', 'U', 'M', 'P', 'Y'};
+		if (bytes.size() < 10 || std::memcmp(bytes.data(), magic, sizeof(magic)) != 0 || (bytes[6] != 1 && bytes[6] != 2))
+		{
+			SS_CORE_ERROR("ReadNpy '{}': not a .npy v1/v2 file", what);
+			return std::nullopt;
+		}
+
+		// v1 stores the dict length in 2 bytes, v2 in 4 (both little-endian).
+		const size_t lenSize = bytes[6] == 1 ? 2 : 4;
+		size_t dictLen = 0;
+		for (size_t i = 0; i < lenSize; ++i)
+		{
+			dictLen |= static_cast<size_t>(bytes[8 + i]) << (8 * i);
+		}
+		const size_t dictBegin = 8 + lenSize;
+		NpyArray array;
+		if (bytes.size() < dictBegin + dictLen ||
+		    !ParseNpyHeaderDict(std::string(reinterpret_cast<const char*>(bytes.data()) + dictBegin, dictLen), array.Shape, array.DType))
+		{
+			SS_CORE_ERROR("ReadNpy '{}': unsupported header", what);
+			return std::nullopt;
+		}
+
+		size_t elems = 1;
+		for (const size_t d : array.Shape)
+		{
+			elems *= d;
+		}
+		const size_t elemSize = array.DType == NpyDType::Float16 ? 2 : array.DType == NpyDType::Float32 ? 4 : 1;
+		const std::span<const uint8_t> raw = bytes.subspan(dictBegin + dictLen);
+		if (raw.size() < elems * elemSize)
+		{
+			SS_CORE_ERROR("ReadNpy '{}': payload truncated ({} of {} bytes)", what, raw.size(), elems * elemSize);
+			return std::nullopt;
+		}
+
+		array.Data.resize(elems);
+		for (size_t i = 0; i < elems; ++i)
+		{
+			switch (array.DType)
+			{
+			case NpyDType::Float16:
+				array.Data[i] = Neural::HalfToFloat(static_cast<uint16_t>(raw[2 * i] | (raw[2 * i + 1] << 8)));
+				break;
+			case NpyDType::Float32:
+				std::memcpy(&array.Data[i], raw.data() + 4 * i, sizeof(float));
+				break;
+			case NpyDType::UInt8:
+				array.Data[i] = static_cast<float>(raw[i]);
+				break;
+			}
+		}
+		return array;
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "NpyWriter.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	// A .npy array read back as float (whatever its on-disk dtype), row-major with its original shape.
+	struct NpyArray
+	{
+		std::vector<size_t> Shape;
+		NpyDType DType = NpyDType::Float32;
+		std::vector<float> Data;
+	};
+
+	// Read a NumPy .npy v1.0/v2.0 file written by WriteNpy (or NumPy itself) in one of the NpyDType formats,
+	// widening to float: '<f2' through an exact half -> float conversion, '|u1' as the raw 0..255 code (callers
+	// normalize). C order only. Returns nullopt (logged) on a bad magic, an unsupported dtype, fortran_order, or
+	// a payload shorter than the shape implies. The consumer side of the dataset export (calibration, metrics).
+	std::optional<NpyArray> ReadNpy(const std::string& path);
+
+	// ReadNpy over a .npy already in memory (a decompressed or archived dataset member). `what` names the
+	// source in the log.
+	std::optional<NpyArray> ParseNpy(std::span<const uint8_t> bytes, const std::string& what);
+
+	// Parse just the header dict (the bytes between the preamble and the payload). Exposed for unit tests.
+	bool ParseNpyHeaderDict(const std::string& dict, std::vector<size_t>& shape, NpyDType& dtype);
+}
@@ -2,6 +2,7 @@
 
 #include "Snowstorm/Core/Log.hpp"
 
+#include <cstring>
 #include <fstream>
 
 namespace Snowstorm
@@ -104,4 +105,28 @@ namespace Snowstorm
 		}
 		return static_cast<bool>(f);
 	}
+
+	bool EncodeNpy(std::vector<uint8_t>& out, const void* data, const size_t byteCount, const std::vector<size_t>& shape,
+	               const NpyDType dtype)
+	{
+		size_t elems = 1;
+		for (const size_t d : shape)
+		{
+			elems *= d;
+		}
+		if (elems * DTypeSize(dtype) != byteCount)
+		{
+			SS_CORE_ERROR("EncodeNpy: shape implies {} bytes but got {}", elems * DTypeSize(dtype), byteCount);
+			return false;
+		}
+
+		const std::vector<uint8_t> header = BuildNpyHeader(shape, dtype);
+		out.resize(header.size() + byteCount);
+		std::memcpy(out.data(), header.data(), header.size());
+		if (byteCount > 0 && data)
+		{
+			std::memcpy(out.data() + header.size(), data, byteCount);
+		}
+		return true;
+	}
 }
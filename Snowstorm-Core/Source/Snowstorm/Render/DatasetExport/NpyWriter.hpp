@@ -22,6 +22,12 @@ namespace Snowstorm
 	bool WriteNpy(const std::string& path, const void* data, size_t byteCount,
 	              const std::vector<size_t>& shape, NpyDType dtype);
 
+	// Encode a whole .npy (header + payload) into `out` in memory, reusing its capacity — the dataset writer's
+	// form, which compresses or archives the bytes instead of writing one file per array. Same validation as
+	// WriteNpy; returns false (logged) on a shape/byteCount mismatch.
+	bool EncodeNpy(std::vector<uint8_t>& out, const void* data, size_t byteCount, const std::vector<size_t>& shape,
+	               NpyDType dtype);
+
 	// Build just the .npy header bytes for a given shape/dtype (no payload). Exposed for unit testing the
 	// header format (magic, version, 64-byte alignment, dict contents) without touching the filesystem.
 	std::vector<uint8_t> BuildNpyHeader(const std::vector<size_t>& shape, NpyDType dtype);
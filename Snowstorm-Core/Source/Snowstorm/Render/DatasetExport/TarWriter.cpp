@@ -0,0 +1,109 @@
+#include "TarWriter.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr size_t kBlock = 512;
+
+		// Zero-padded octal into a NUL-terminated field of `width` bytes (ustar numeric format).
+		void WriteOctal(uint8_t* field, const size_t width, const uint64_t value)
+		{
+			std::snprintf(reinterpret_cast<char*>(field), width, "%0*llo", static_cast<int>(width - 1),
+			              static_cast<unsigned long long>(value));
+		}
+	}
+
+	std::array<uint8_t, 512> BuildTarHeader(const std::string& name, const uint64_t size)
+	{
+		std::array<uint8_t, 512> h{};
+		std::memcpy(h.data(), name.data(), std::min<size_t>(name.size(), 100)); // name[100]
+		WriteOctal(h.data() + 100, 8, 0644);                                       // mode
+		WriteOctal(h.data() + 108, 8, 0);                                          // uid
+		WriteOctal(h.data() + 116, 8, 0);                                          // gid
+		WriteOctal(h.data() + 124, 12, size);                                      // size
+		WriteOctal(h.data() + 136, 12, 0);                                         // mtime
+		h[156] = '0';                                                              // typeflag: regular file
+		std::memcpy(h.data() + 257, "ustar", 6);                                   // magic (with NUL)
+		std::memcpy(h.data() + 263, "00", 2);                                      // version
+
+		// Checksum: the byte sum of the header with the checksum field itself read as eight spaces, stored as
+		// six octal digits, a NUL and a space.
+		std::memset(h.data() + 148, ' ', 8);
+		uint32_t sum = 0;
+		for (const uint8_t b : h)
+		{
+			sum += b;
+		}
+		WriteOctal(h.data() + 148, 7, sum);
+		h[155] = ' ';
+		return h;
+	}
+
+	TarWriter::~TarWriter()
+	{
+		Close();
+	}
+
+	bool TarWriter::Open(const std::string& path)
+	{
+		Close();
+		m_File.open(path, std::ios::binary | std::ios::trunc);
+		if (!m_File)
+		{
+			SS_CORE_ERROR("TarWriter: cannot open '{}' for writing", path);
+			return false;
+		}
+		m_Path = path;
+		m_Size = 0;
+		return true;
+	}
+
+	int64_t TarWriter::Append(const std::string& name, const std::span<const uint8_t> data)
+	{
+		if (!m_File.is_open() || name.size() > 100)
+		{
+			SS_CORE_ERROR("TarWriter '{}': cannot append '{}'", m_Path, name);
+			return -1;
+		}
+
+		const std::array<uint8_t, 512> header = BuildTarHeader(name, data.size());
+		m_File.write(reinterpret_cast<const char*>(header.data()), kBlock);
+		const int64_t dataOffset = static_cast<int64_t>(m_Size + kBlock);
+		m_File.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+		const size_t padding = (kBlock - data.size() % kBlock) % kBlock;
+		static constexpr char kZeros[kBlock] = {};
+		m_File.write(kZeros, static_cast<std::streamsize>(padding));
+		if (!m_File)
+		{
+			SS_CORE_ERROR("TarWriter '{}': write failed on '{}'", m_Path, name);
+			return -1;
+		}
+		m_Size += kBlock + data.size() + padding;
+		return dataOffset;
+	}
+
+	bool TarWriter::Close()
+	{
+		if (!m_File.is_open())
+		{
+			return true;
+		}
+		static constexpr char kZeros[2 * kBlock] = {};
+		m_File.write(kZeros, sizeof(kZeros));
+		m_Size += sizeof(kZeros);
+		const bool ok = static_cast<bool>(m_File);
+		m_File.close();
+		if (!ok)
+		{
+			SS_CORE_ERROR("TarWriter '{}': failed to finish the archive", m_Path);
+		}
+		return ok;
+	}
+}
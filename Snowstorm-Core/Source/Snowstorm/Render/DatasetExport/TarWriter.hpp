@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+
+namespace Snowstorm
+{
+	// Minimal POSIX ustar archive writer for dataset shards: regular-file members only, appended in order, each
+	// a 512-byte header followed by the data padded to 512. The result opens with `tar`, Python's tarfile and
+	// WebDataset-style loaders, and because members are stored (compression is per member, see
+	// DatasetCompression) a reader can also skip the tar layer and seek straight to a member's data offset.
+	class TarWriter final
+	{
+	public:
+		~TarWriter();
+
+		// Create/truncate `path`. False (logged) if it can't be opened.
+		bool Open(const std::string& path);
+
+		// Append one member. Returns the byte offset of the member's DATA within the archive (what the dataset
+		// manifest records), or -1 on a write error or a name longer than ustar's 100-byte field.
+		int64_t Append(const std::string& name, std::span<const uint8_t> data);
+
+		// Write the two zero end-of-archive blocks and close. Safe to call when not open.
+		bool Close();
+
+		[[nodiscard]] bool IsOpen() const { return m_File.is_open(); }
+		[[nodiscard]] uint64_t Size() const { return m_Size; }
+
+	private:
+		std::ofstream m_File;
+		std::string m_Path;
+		uint64_t m_Size = 0;
+	};
+
+	// The 512-byte ustar header for a regular file of `size` bytes (mode 0644, mtime 0 so shards are
+	// reproducible). Exposed for unit tests.
+	std::array<uint8_t, 512> BuildTarHeader(const std::string& name, uint64_t size);
+}
@@ -1,6 +1,7 @@
 ﻿#include "DescriptorSet.hpp"
 
 #include "RendererAPI.hpp"
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanDescriptorSet.hpp"
 #include "Snowstorm/Core/Log.hpp"
 
@@ -21,6 +22,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanDescriptorSet>(layout, desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullDescriptorSet>(layout, desc);
+
 		case RendererAPI::API::DX12:
 			// Implement a DX12DescriptorSet that derives from DescriptorSet and return it here.
 			SS_CORE_ASSERT(false, "DX12 DescriptorSet backend not implemented yet.");
@@ -3,6 +3,7 @@
 #include "RendererAPI.hpp"
 #include "Snowstorm/Core/Log.hpp"
 
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanDescriptorSetLayout.hpp"
 
 namespace Snowstorm
@@ -22,6 +23,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanDescriptorSetLayout>(desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullDescriptorSetLayout>(desc);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 descriptor set layouts are not implemented yet.");
 			return nullptr;
@@ -46,6 +50,10 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanDescriptorSetLayout>(internalHandle);
 
+		case RendererAPI::API::Null:
+			// Nothing external to wrap (no ImGui backend either); an empty layout stands in.
+			return CreateRef<NullDescriptorSetLayout>(DescriptorSetLayoutDesc{});
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 descriptor set layouts are not implemented yet.");
 			return nullptr;
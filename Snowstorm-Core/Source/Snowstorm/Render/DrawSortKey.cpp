@@ -0,0 +1,77 @@
+#include "DrawSortKey.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		uint64_t Field(const uint32_t value, const uint32_t bits)
+		{
+			const uint32_t max = (1u << bits) - 1u;
+			return std::min(value, max);
+		}
+	}
+
+	uint64_t MakeDrawSortKey(const uint32_t pipeline, const uint32_t material, const uint32_t mesh)
+	{
+		constexpr uint32_t kMaterialShift = kDrawSortMeshBits;
+		constexpr uint32_t kPipelineShift = kMaterialShift + kDrawSortMaterialBits;
+		return Field(pipeline, kDrawSortPipelineBits) << kPipelineShift |
+		       Field(material, kDrawSortMaterialBits) << kMaterialShift |
+		       Field(mesh, kDrawSortMeshBits);
+	}
+
+	void RadixSortDraws(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch)
+	{
+		const size_t n = entries.size();
+		if (n < 2)
+		{
+			return;
+		}
+		scratch.resize(n);
+
+		// Which bytes differ at all: a byte every key shares can't reorder anything, so its pass is skipped.
+		uint64_t varying = 0;
+		const uint64_t first = entries[0].Key;
+		for (const DrawSortEntry& e : entries)
+		{
+			varying |= e.Key ^ first;
+		}
+
+		DrawSortEntry* src = entries.data();
+		DrawSortEntry* dst = scratch.data();
+		for (uint32_t shift = 0; shift < 64; shift += 8)
+		{
+			if (((varying >> shift) & 0xFFu) == 0)
+			{
+				continue;
+			}
+
+			std::array<uint32_t, 256> offsets{};
+			for (size_t i = 0; i < n; ++i)
+			{
+				++offsets[(src[i].Key >> shift) & 0xFFu];
+			}
+			uint32_t sum = 0;
+			for (uint32_t& offset : offsets)
+			{
+				const uint32_t count = offset;
+				offset = sum;
+				sum += count;
+			}
+			for (size_t i = 0; i < n; ++i)
+			{
+				dst[offsets[(src[i].Key >> shift) & 0xFFu]++] = src[i];
+			}
+			std::swap(src, dst);
+		}
+
+		// An odd number of passes leaves the result in the scratch buffer.
+		if (src != entries.data())
+		{
+			entries.swap(scratch);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Snowstorm
+{
+	// 64-bit draw sort key, fields ordered by what a change costs on submission, most expensive first:
+	//
+	//   [63..48] pipeline  (16 bits)  a pipeline bind, and every set rebound behind it
+	//   [47..24] material  (24 bits)  the material's set 1
+	//   [23.. 0] mesh      (24 bits)  vertex + index buffer binds
+	//
+	// There is no depth field: a draw here is a RendererService batch, unique per (mesh, material) and
+	// spanning every object that shares them, so nothing is left for a depth to order once the three ids are
+	// in the key -- and a batch has no single depth to sort by anyway.
+	//
+	// The ids are dense per-frame ranks (first-seen order), not pointers: sorting only has to bring equal
+	// state together, and dense ids keep the fields narrow. An id past its field's range saturates, so a
+	// frame with more than 65536 pipelines still sorts -- the overflow just shares the last slot.
+	struct DrawSortEntry
+	{
+		uint64_t Key = 0;
+		uint32_t Index = 0; // the draw (batch) this key orders
+	};
+
+	inline constexpr uint32_t kDrawSortPipelineBits = 16;
+	inline constexpr uint32_t kDrawSortMaterialBits = 24;
+	inline constexpr uint32_t kDrawSortMeshBits = 24;
+	static_assert(kDrawSortPipelineBits + kDrawSortMaterialBits + kDrawSortMeshBits == 64);
+
+	[[nodiscard]] uint64_t MakeDrawSortKey(uint32_t pipeline, uint32_t material, uint32_t mesh);
+
+	// Stable LSD radix sort by Key, one byte per pass. Passes whose byte is the same in every key are skipped
+	// (the upper id bits are zero in all but huge frames), so a typical frame pays for four or five passes
+	// over a few hundred entries. `scratch` is caller-owned so the per-frame sort doesn't allocate.
+	void RadixSortDraws(std::vector<DrawSortEntry>& entries, std::vector<DrawSortEntry>& scratch);
+}
@@ -2,19 +2,22 @@
 
 #include "Snowstorm/Lighting/LightingUniforms.hpp"
 #include "Snowstorm/Math/Math.hpp"
+#include "Snowstorm/Render/ShadowCascades.hpp"
 
+#include <array>
 #include <cstdint>
 
 namespace Snowstorm
 {
 	// All per-frame inputs the lit/sky passes need, gathered in one place. The PreRender passes populate
 	// this each frame (camera → view/camera, LightingSystem → lights, EnvironmentSystem → environment,
-	// ShadowPass → Shadow, IBLBakePass → IBL); RendererService::AcquireFrameSet reads it to assemble the
+	// ShadowRenderer → Shadow, IBLBakePass → IBL); RendererService::AcquireFrameSet reads it to assemble the
 	// GPU FrameCB uniform. This replaces a dozen loose per-feature scalars that used to live directly on
 	// RendererService (see #72) — one struct passes fill, instead of one setter + one member per field.
 	struct FrameData
 	{
 		// Camera (set in BeginScene).
+		glm::mat4 View{1.0f};               // view matrix of the pass's camera (light-cluster depth slicing)
 		glm::mat4 ViewProjection{1.0f};
 		glm::mat4 PrevViewProjection{1.0f}; // last frame's VP — for motion vectors (#44)
 		glm::vec3 CameraPosition{0.0f};
@@ -23,15 +26,17 @@ namespace Snowstorm
 		LightDataBlock Lights{};
 		EnvironmentDataBlock Environment{};
 
-		// Directional-sun shadow (pushed by ShadowPass). ShadowMapIndex 0 = no shadows (fully lit).
-		// Resolution feeds the PCF texel-size in AcquireFrameSet.
+		// Directional-sun shadow cascades (pushed by ShadowRenderer): one world -> light clip matrix and one
+		// depth-map bindless index per cascade. CascadeCount 0 = no sun shadows (fully lit). Resolution
+		// feeds the PCF texel-size in AcquireFrameSet.
 		struct ShadowBlock
 		{
-			glm::mat4 LightViewProj{1.0f};
-			uint32_t ShadowMapIndex = 0;
+			std::array<glm::mat4, kMaxShadowCascades> CascadeViewProj{};
+			std::array<uint32_t, kMaxShadowCascades> CascadeMapIndex{};
+			uint32_t CascadeCount = 0;
 			uint32_t ShadowResolution = 2048;
-			uint32_t SpotShadowAtlasIndex = 0;  // bindless index of the spot shadow atlas (0 = spots unshadowed)
-			uint32_t PointShadowAtlasIndex = 0; // bindless index of the point shadow atlas (0 = points unshadowed)
+			uint32_t SpotShadowAtlasIndex = 0;  // bindless index of the shadow atlas when a spot casts (0 = spots unshadowed)
+			uint32_t PointShadowAtlasIndex = 0; // same atlas when a point casts (0 = points unshadowed)
 		} Shadow;
 
 		// Baked IBL bindless indices (pushed by IBLBakePass; the maps live in that pass). IrradianceCubeIndex
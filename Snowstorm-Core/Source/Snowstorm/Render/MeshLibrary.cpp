@@ -4,9 +4,10 @@
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
-#include "Snowstorm/Assets/AssetFileTime.hpp"
+#include "Snowstorm/Assets/ContentHashIndex.hpp"
 #include "Snowstorm/Assets/MeshCache.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Debug/Instrumentor.hpp"
 
 #include <glm/geometric.hpp>
 
@@ -155,8 +156,21 @@ namespace Snowstorm
 		return result;
 	}
 
+	// The importer owns the aiScene; keeping both together means the scene lives exactly as long as the last
+	// worker still extracting from it.
+	struct MeshLibrary::ParsedFile
+	{
+		Assimp::Importer Importer;
+		const aiScene* Scene = nullptr;
+		uint64_t SourceHash = 0; // content hash the parse was taken from (stale if the file changed)
+	};
+
 	namespace
 	{
+		// Import flags of the per-submesh cook. Part of the derived-data key: changing them must re-key every
+		// cooked submesh, since the flags shape the vertex data.
+		constexpr uint32_t kSubmeshImportFlags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_PreTransformVertices | aiProcess_CalcTangentSpace;
+
 		// Extract one aiMesh into CPU-side vertex/index arrays. Pure data copy, no file IO.
 		CookedMesh ExtractSubmesh(const aiMesh* mesh)
 		{
@@ -166,6 +180,7 @@ namespace Snowstorm
 			{
 				out.Vertices.push_back(ReadVertex(mesh, j));
 			}
+			out.Indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3); // triangulated
 			for (uint32_t j = 0; j < mesh->mNumFaces; j++)
 			{
 				const aiFace& face = mesh->mFaces[j];
@@ -177,28 +192,20 @@ namespace Snowstorm
 			return out;
 		}
 
-		// Parse a model file ONCE and extract EVERY submesh. Same import flags as the live path so cooked
-		// geometry is identical. Returns nullptr on parse failure. This is the fix for the cold-cook storm:
-		// one ReadFile per file instead of one per submesh.
-		std::shared_ptr<MeshLibrary::ParsedFile> ParseWholeFile(const std::string& filepath, const uint64_t sourceTime)
+		// Parse a model file ONCE. Same import flags as the live path so cooked geometry is identical.
+		// Returns nullptr on parse failure. Only the ReadFile happens here; per-submesh extraction is left to
+		// the requesting workers (see LoadCookedCPU) so it runs in parallel instead of under the file lock.
+		std::shared_ptr<MeshLibrary::ParsedFile> ParseWholeFile(const std::string& filepath, const uint64_t sourceHash)
 		{
-			Assimp::Importer importer;
-			const aiScene* scene = importer.ReadFile(filepath,
-			                                         aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices | aiProcess_PreTransformVertices | aiProcess_CalcTangentSpace);
+			auto parsed = std::make_shared<MeshLibrary::ParsedFile>();
+			parsed->SourceHash = sourceHash;
+			parsed->Scene = parsed->Importer.ReadFile(filepath, kSubmeshImportFlags);
 
-			if (!scene || !scene->mRootNode || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
+			if (!parsed->Scene || !parsed->Scene->mRootNode || parsed->Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)
 			{
-				SS_CORE_ERROR("Failed to load mesh: {} | Assimp Error: {}", filepath, importer.GetErrorString());
+				SS_CORE_ERROR("Failed to load mesh: {} | Assimp Error: {}", filepath, parsed->Importer.GetErrorString());
 				return nullptr;
 			}
-
-			auto parsed = std::make_shared<MeshLibrary::ParsedFile>();
-			parsed->SourceWriteTime = sourceTime;
-			parsed->Submeshes.reserve(scene->mNumMeshes);
-			for (uint32_t i = 0; i < scene->mNumMeshes; ++i)
-			{
-				parsed->Submeshes.push_back(ExtractSubmesh(scene->mMeshes[i]));
-			}
 			return parsed;
 		}
 	}
@@ -214,64 +221,99 @@ namespace Snowstorm
 		return lock;
 	}
 
-	std::optional<CookedMesh> MeshLibrary::LoadCookedCPU(const std::string& filepath, const int submeshIndex, const AssetHandle handle)
+	std::shared_ptr<MeshLibrary::ParsedFile> MeshLibrary::AcquireParse(const std::string& filepath, const uint64_t sourceHash)
 	{
-		// CPU-only: safe on a worker thread. No m_Meshes access (that map holds GPU resources and is
-		// main-thread-only); the caller finalizes on the main thread via FinalizeCooked.
-		const uint64_t sourceTime = GetFileWriteTimeU64(filepath);
+		const auto findRetained = [&]() -> std::shared_ptr<ParsedFile>
+		{
+			std::lock_guard guard(m_ParseMutex);
+			if (const auto it = m_ParsedFiles.find(filepath); it != m_ParsedFiles.end() && it->second->SourceHash == sourceHash)
+			{
+				return it->second;
+			}
+			return nullptr;
+		};
 
-		// Fast path: this submesh's cooked blob already on disk (no Assimp).
-		if (auto blob = MeshCacheIO::Load(handle, sourceTime))
+		if (auto parsed = findRetained())
 		{
-			return blob;
+			return parsed;
 		}
 
-		// Cold cook. Serialize per-file so N workers don't each ReadFile the whole model (the cold-Sponza
-		// storm). Under the file lock: reuse an in-memory whole-file parse if another worker just made one,
-		// else parse the whole file ONCE and share it. Then extract just this submesh.
+		// Serialize the parse per file so N workers don't each ReadFile the whole model (the cold-Sponza
+		// storm). Whoever waited here re-checks: the worker ahead of it most likely just published the scene.
 		const std::shared_ptr<std::mutex> fileLock = FileLock(filepath);
 		std::lock_guard parseGuard(*fileLock);
 
-		// Another worker may have written this blob while we waited on the lock — recheck disk.
-		if (auto blob = MeshCacheIO::Load(handle, sourceTime))
+		if (auto parsed = findRetained())
 		{
-			return blob;
+			return parsed;
 		}
 
 		std::shared_ptr<ParsedFile> parsed;
 		{
-			std::lock_guard guard(m_ParseMutex);
-			if (const auto it = m_ParsedFiles.find(filepath); it != m_ParsedFiles.end() && it->second->SourceWriteTime == sourceTime)
-			{
-				parsed = it->second;
-			}
+			SS_PROFILE_SCOPE("MeshLibrary::ParseWholeFile");
+			parsed = ParseWholeFile(filepath, sourceHash);
 		}
-		if (!parsed)
+		if (parsed)
 		{
-			parsed = ParseWholeFile(filepath, sourceTime);
-			if (!parsed)
-			{
-				return std::nullopt;
-			}
 			std::lock_guard guard(m_ParseMutex);
 			m_ParsedFiles[filepath] = parsed;
 		}
+		return parsed;
+	}
 
-		if (submeshIndex < 0 || static_cast<size_t>(submeshIndex) >= parsed->Submeshes.size())
+	std::optional<CookedMesh> MeshLibrary::LoadCookedCPU(const std::string& filepath, const int submeshIndex)
+	{
+		// CPU-only: safe on a worker thread. No m_Meshes access (that map holds GPU resources and is
+		// main-thread-only); the caller finalizes on the main thread via FinalizeCooked.
+		//
+		// The cook key is the source's CONTENT hash (served from the persistent hash index when the file's
+		// stat is unchanged, so a warm startup reads no source bytes), not its write time: a git checkout or
+		// CI cache restore that touches every mtime still hits the cooked blobs, locally or in the shared DDC.
+		const std::optional<uint64_t> sourceHash = ContentHashIndex::Get().GetHash(filepath);
+		if (!sourceHash)
 		{
-			SS_CORE_ERROR("Submesh index {} out of range ({} meshes) for {}", submeshIndex, parsed->Submeshes.size(), filepath);
+			SS_CORE_ERROR("Failed to load mesh: {} (source missing or unreadable)", filepath);
 			return std::nullopt;
 		}
+		const DerivedDataKey key = MeshCacheIO::MakeKey(*sourceHash, submeshIndex, kSubmeshImportFlags);
 
-		CookedMesh cooked = parsed->Submeshes[submeshIndex];
+		// Fast path: this submesh's cooked blob already in the DDC (no Assimp).
+		if (auto blob = MeshCacheIO::Load(key))
+		{
+			return blob;
+		}
+
+		// Cold cook: share one parse of the file, then cook just this submesh on this worker. Every other
+		// submesh of the file is being cooked concurrently by its own job, against the same scene.
+		const std::shared_ptr<ParsedFile> parsed = AcquireParse(filepath, *sourceHash);
+		if (!parsed)
+		{
+			return std::nullopt;
+		}
+
+		if (submeshIndex < 0 || static_cast<uint32_t>(submeshIndex) >= parsed->Scene->mNumMeshes)
+		{
+			SS_CORE_ERROR("Submesh index {} out of range ({} meshes) for {}", submeshIndex, parsed->Scene->mNumMeshes, filepath);
+			return std::nullopt;
+		}
+
+		SS_PROFILE_SCOPE("MeshLibrary::CookSubmesh");
+		CookedMesh cooked = ExtractSubmesh(parsed->Scene->mMeshes[submeshIndex]);
 		if (cooked.Vertices.empty() || cooked.Indices.empty())
 		{
 			return std::nullopt;
 		}
-		(void)MeshCacheIO::Save(handle, sourceTime, cooked); // persist so next startup skips the parse entirely
+		(void)MeshCacheIO::Save(key, cooked); // persist so next startup (or another checkout, via the shared DDC) skips the parse
 		return cooked;
 	}
 
+	void MeshLibrary::ReleaseParsedFiles()
+	{
+		std::lock_guard guard(m_ParseMutex);
+		m_ParsedFiles.clear();
+		m_FileLocks.clear(); // a worker mid-parse holds its own reference; a new burst just makes fresh locks
+	}
+
 	Ref<Mesh> MeshLibrary::FinalizeCooked(const std::string& filepath, const int submeshIndex, const CookedMesh& cooked)
 	{
 		// Main thread only: creates GPU buffers. Idempotent via the cache key.
@@ -290,7 +332,7 @@ namespace Snowstorm
 		return result;
 	}
 
-	Ref<Mesh> MeshLibrary::LoadCached(const std::string& filepath, const int submeshIndex, const AssetHandle handle)
+	Ref<Mesh> MeshLibrary::LoadCached(const std::string& filepath, const int submeshIndex)
 	{
 		const std::string cacheKey = filepath + "?submesh=" + std::to_string(submeshIndex);
 		if (const auto it = m_Meshes.find(cacheKey); it != m_Meshes.end())
@@ -298,7 +340,7 @@ namespace Snowstorm
 			return it->second;
 		}
 
-		auto cooked = LoadCookedCPU(filepath, submeshIndex, handle);
+		auto cooked = LoadCookedCPU(filepath, submeshIndex);
 		if (!cooked)
 		{
 			return nullptr;
@@ -27,17 +27,17 @@ namespace Snowstorm
 		// this is what model import uses to spawn one entity per part. submeshIndex must be in range.
 		Ref<Mesh> Load(const std::string& filepath, int submeshIndex);
 
-		// Cooked-cache load: tries the on-disk cooked blob for `handle` first (no Assimp parse), and only
-		// re-parses the source + re-cooks on a cache miss/stale. This is the fast startup path — the plain
-		// Load() overloads above re-parse the whole file every call (fine for one-off imports, but O(N-full-
-		// parses) for an N-submesh scene). Prefer this from GetMesh where a stable handle exists.
-		Ref<Mesh> LoadCached(const std::string& filepath, int submeshIndex, AssetHandle handle);
+		// Cooked-cache load: tries the derived-data cache for this submesh first (no Assimp parse), and only
+		// re-parses the source + re-cooks on a miss. This is the fast startup path — the plain Load()
+		// overloads above re-parse the whole file every call (fine for one-off imports, but O(N-full-parses)
+		// for an N-submesh scene). The cook is keyed by the source's content hash, not an asset handle.
+		Ref<Mesh> LoadCached(const std::string& filepath, int submeshIndex);
 
-		// CPU-only cook/load: returns the packed vertex/index data (from the cooked blob if fresh, else by
+		// CPU-only cook/load: returns the packed vertex/index data (from the cooked blob if present, else by
 		// parsing the source once and writing the blob). Creates NO GPU buffers, so it is safe to call from
 		// a JobSystem worker thread — the caller builds the Mesh (GPU upload) on the main thread from the
 		// result (see AssetManagerSingleton async load). Returns nullopt on parse failure.
-		std::optional<CookedMesh> LoadCookedCPU(const std::string& filepath, int submeshIndex, AssetHandle handle);
+		std::optional<CookedMesh> LoadCookedCPU(const std::string& filepath, int submeshIndex);
 
 		// Build + cache the GPU Mesh from already-cooked CPU data (main thread only — creates Vulkan
 		// buffers). Keyed like LoadCached so a subsequent LoadCached/LoadCookedCPU hits the cache.
@@ -52,15 +52,22 @@ namespace Snowstorm
 		// Cold-cook coordination (worker threads). A model file with N submeshes must be parsed by Assimp
 		// ONCE, not once per submesh — 25 workers each doing a full ReadFile of the same 20MB glTF is a
 		// memory/CPU storm that runs slower than a serial parse (the "cold Sponza freeze"). So the first
-		// worker to cold-cook a file parses ALL its submeshes into m_ParsedFiles under that file's mutex;
-		// the others block on the mutex, then read their submesh from the shared parse instead of re-parsing.
-		// A parsed entry is dropped once every submesh has been consumed (LoadCookedCPU tracks remaining).
+		// worker to cold-cook a file runs the ReadFile under that file's mutex and publishes the imported
+		// scene in m_ParsedFiles; the others block on the mutex only until the PARSE is done.
+		//
+		// Everything after the parse is per-submesh and runs on the requesting worker, outside the file lock:
+		// vertex packing, index flattening and the blob write. The async path already submits one job per
+		// submesh handle, so those jobs ARE the fan-out — a 25-part file cooks on every core instead of the
+		// first worker extracting all 25 serially while 24 others sleep on its lock, and each part lands in
+		// the completed queue the moment its own cook finishes. (No nested Submit-and-wait from inside a job:
+		// JobSystem has no work stealing, so a worker blocking on jobs queued behind it can deadlock the pool.)
+		// The imported scene is immutable after ReadFile, so concurrent reads of distinct aiMeshes are safe.
 	public:
-		struct ParsedFile
-		{
-			std::vector<CookedMesh> Submeshes; // indexed by submesh index
-			uint64_t SourceWriteTime = 0;
-		};
+		struct ParsedFile; // defined in MeshLibrary.cpp (owns the Assimp importer + its aiScene)
+
+		// Drop every retained whole-file parse. The AssetManager calls this when an async load burst drains;
+		// jobs still holding a parse keep it alive until they finish. A later cold miss simply re-parses.
+		void ReleaseParsedFiles();
 
 	private:
 		std::mutex m_ParseMutex;                                                    // guards m_FileLocks / m_ParsedFiles maps
@@ -68,5 +75,9 @@ namespace Snowstorm
 		std::unordered_map<std::string, std::shared_ptr<ParsedFile>> m_ParsedFiles; // shared parse result
 
 		std::shared_ptr<std::mutex> FileLock(const std::string& filepath);
+
+		// The imported scene for `filepath` at `sourceHash`: the retained one if present, else parsed now
+		// (under the per-file lock, so at most one ReadFile per file per burst). nullptr on parse failure.
+		std::shared_ptr<ParsedFile> AcquireParse(const std::string& filepath, uint64_t sourceHash);
 	};
 }
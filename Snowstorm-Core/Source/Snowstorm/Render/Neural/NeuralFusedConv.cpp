@@ -0,0 +1,205 @@
+#include "NeuralFusedConv.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace Snowstorm::Neural
+{
+	namespace
+	{
+		uint32_t RadiusAfter(const NeuralModel& model, const size_t layer)
+		{
+			uint32_t radius = 0;
+			for (size_t i = layer + 1; i < model.Layers.size(); ++i)
+			{
+				radius += model.Layers[i].KernelSize / 2;
+			}
+			return radius;
+		}
+
+		// One output of a fused layer: region texel (oy, ox) of output channel `oc`, whose image position is
+		// (gy, gx). `src` is the layer's input region (srcSide per side), which has the layer's radius more
+		// context than the output region, so tap (ky, kx) reads region texel (oy + ky, ox + kx). Taps outside
+		// the image are skipped (the ky/kx range is clipped), accumulating in Conv2DReference's order.
+		float FusedOutput(const ConvLayer& l, const float* src, const uint32_t srcSide, const uint32_t oc,
+		                  const uint32_t oy, const uint32_t ox, const int gy, const int gx, const int width, const int height)
+		{
+			const int k = static_cast<int>(l.KernelSize);
+			const int r = k / 2;
+			const int kyBegin = std::max(0, r - gy);
+			const int kyEnd = std::min(k, height - gy + r);
+			const int kxBegin = std::max(0, r - gx);
+			const int kxEnd = std::min(k, width - gx + r);
+
+			float acc = l.Bias[oc];
+			for (uint32_t ic = 0; ic < l.InChannels; ++ic)
+			{
+				const float* plane = src + static_cast<size_t>(ic) * srcSide * srcSide;
+				const float* w = l.Weights.data() + (static_cast<size_t>(oc) * l.InChannels + ic) * l.KernelSize * l.KernelSize;
+				for (int ky = kyBegin; ky < kyEnd; ++ky)
+				{
+					for (int kx = kxBegin; kx < kxEnd; ++kx)
+					{
+						acc += plane[(oy + ky) * srcSide + ox + kx] * w[ky * k + kx];
+					}
+				}
+			}
+			return ApplyActivation(acc, l.Act);
+		}
+	}
+
+	uint32_t FusedRegionSide(const NeuralModel& model, const size_t layer)
+	{
+		return kFusedTile + 2 * RadiusAfter(model, layer);
+	}
+
+	FusedConvPlan PlanFusedConv(const NeuralModel& model)
+	{
+		FusedConvPlan plan;
+		if (model.Layers.empty())
+		{
+			plan.Reason = "empty model";
+			return plan;
+		}
+		if (model.Layers.size() > kFusedMaxLayers)
+		{
+			plan.Reason = "more layers than the fused kernel's layer table";
+			return plan;
+		}
+		if (model.Layers.back().OutChannels != kFusedOutChannels)
+		{
+			plan.Reason = "last layer is not a 3-channel residual";
+			return plan;
+		}
+		for (size_t i = 0; i < model.Layers.size(); ++i)
+		{
+			const ConvLayer& l = model.Layers[i];
+			if (l.KernelSize % 2 == 0)
+			{
+				plan.Reason = "even kernel size";
+				return plan;
+			}
+			if (l.Quant.Storage == WeightStorage::Int8)
+			{
+				plan.Reason = "int8 layers run on the per-layer dot4 path";
+				return plan;
+			}
+			if (i > 0 && l.InChannels != model.Layers[i - 1].OutChannels)
+			{
+				plan.Reason = "layer channels do not chain";
+				return plan;
+			}
+			plan.Halo += l.KernelSize / 2;
+		}
+
+		// Plane 0 holds the input region and the odd layers' outputs, plane 1 the even layers'. The last layer
+		// writes straight to the image, never to a plane.
+		const uint32_t inSide = kFusedTile + 2 * plan.Halo;
+		uint32_t plane[2] = {model.Layers.front().InChannels * inSide * inSide, 0};
+		for (size_t i = 0; i + 1 < model.Layers.size(); ++i)
+		{
+			const uint32_t side = FusedRegionSide(model, i);
+			uint32_t& peak = plane[(i + 1) % 2];
+			peak = std::max(peak, model.Layers[i].OutChannels * side * side);
+		}
+		plan.PeakPlaneFloats = std::max(plane[0], plane[1]);
+		if (plan.PeakPlaneFloats > kFusedPlaneFloats)
+		{
+			plan.Reason = "activations outgrow the groupshared planes";
+			return plan;
+		}
+		plan.Fusable = true;
+		return plan;
+	}
+
+	bool RunFusedReference(const NeuralModel& model, const FeatureMap& input, FeatureMap& out)
+	{
+		const FusedConvPlan plan = PlanFusedConv(model);
+		if (!plan.Fusable)
+		{
+			SS_CORE_ERROR("RunFusedReference: model is not fusable ({})", plan.Reason);
+			return false;
+		}
+		if (input.Channels != model.Layers.front().InChannels)
+		{
+			SS_CORE_ERROR("RunFusedReference: input has {} channel(s), model expects {}", input.Channels,
+			              model.Layers.front().InChannels);
+			return false;
+		}
+
+		const int width = static_cast<int>(input.Width);
+		const int height = static_cast<int>(input.Height);
+		out.Channels = kFusedOutChannels;
+		out.Height = input.Height;
+		out.Width = input.Width;
+		out.Data.assign(static_cast<size_t>(kFusedOutChannels) * input.Height * input.Width, 0.0f);
+
+		std::vector<float> lds(2 * static_cast<size_t>(kFusedPlaneFloats), 0.0f);
+		const uint32_t tilesX = (input.Width + kFusedTile - 1) / kFusedTile;
+		const uint32_t tilesY = (input.Height + kFusedTile - 1) / kFusedTile;
+		for (uint32_t ty = 0; ty < tilesY; ++ty)
+		{
+			for (uint32_t tx = 0; tx < tilesX; ++tx)
+			{
+				const int tileX = static_cast<int>(tx * kFusedTile);
+				const int tileY = static_cast<int>(ty * kFusedTile);
+
+				// Input region: the tile plus the stack's halo, zero outside the image.
+				uint32_t side = kFusedTile + 2 * plan.Halo;
+				const int halo = static_cast<int>(plan.Halo);
+				for (uint32_t c = 0; c < input.Channels; ++c)
+				{
+					for (uint32_t ly = 0; ly < side; ++ly)
+					{
+						for (uint32_t lx = 0; lx < side; ++lx)
+						{
+							const int gy = tileY - halo + static_cast<int>(ly);
+							const int gx = tileX - halo + static_cast<int>(lx);
+							const bool inside = gx >= 0 && gy >= 0 && gx < width && gy < height;
+							lds[(static_cast<size_t>(c) * side + ly) * side + lx] =
+								inside ? input.At(c, static_cast<uint32_t>(gy), static_cast<uint32_t>(gx)) : 0.0f;
+						}
+					}
+				}
+
+				size_t srcBase = 0;
+				size_t dstBase = kFusedPlaneFloats;
+				for (size_t li = 0; li < model.Layers.size(); ++li)
+				{
+					const ConvLayer& l = model.Layers[li];
+					const bool last = li + 1 == model.Layers.size();
+					const uint32_t outSide = FusedRegionSide(model, li);
+					const int margin = static_cast<int>(RadiusAfter(model, li));
+					for (uint32_t oc = 0; oc < l.OutChannels; ++oc)
+					{
+						for (uint32_t oy = 0; oy < outSide; ++oy)
+						{
+							for (uint32_t ox = 0; ox < outSide; ++ox)
+							{
+								const int gy = tileY - margin + static_cast<int>(oy);
+								const int gx = tileX - margin + static_cast<int>(ox);
+								const bool inside = gx >= 0 && gy >= 0 && gx < width && gy < height;
+								if (last)
+								{
+									if (inside)
+									{
+										out.At(oc, static_cast<uint32_t>(gy), static_cast<uint32_t>(gx)) =
+											FusedOutput(l, lds.data() + srcBase, side, oc, oy, ox, gy, gx, width, height);
+									}
+									continue;
+								}
+								lds[dstBase + (static_cast<size_t>(oc) * outSide + oy) * outSide + ox] =
+									inside ? FusedOutput(l, lds.data() + srcBase, side, oc, oy, ox, gy, gx, width, height) : 0.0f;
+							}
+						}
+					}
+					std::swap(srcBase, dstBase);
+					side = outSide;
+				}
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Snowstorm/Render/Neural/NeuralWeights.hpp"
+
+#include <cstdint>
+
+namespace Snowstorm::Neural
+{
+	// Fused conv stack (NeuralConvFused.comp): one dispatch runs EVERY layer of the model for an 8x8 output tile
+	// with the intermediate activations resident in groupshared memory, and writes only the final
+	// output = base + residual. The per-layer path (NeuralConv.comp, one dispatch per layer) round-trips each
+	// hidden activation through a full-resolution CHW buffer — at 4K a 16-wide layer is 530 MB written and read
+	// back per layer, which is what bounds the upscaler. Fused, the only global traffic is the input feature
+	// stack, the weights (cache-resident) and the output image.
+	//
+	// Scheme: the group loads its tile plus a halo of sum(KernelSize / 2) texels on each side (the receptive
+	// field of the whole stack), then each layer shrinks the region by its own radius: layer l produces
+	// TILE + 2 * (radius of the layers after it) texels per side, so the last layer produces exactly the tile.
+	// The halo texels are recomputed by neighbouring groups — extra ALU traded for the bandwidth. Two fp32 LDS
+	// planes ping-pong the activations (the input region starts in plane 0). Taps that fall outside the image
+	// are skipped exactly like Conv2DReference's zero padding, and in the same bias, ic, ky, kx order, so the
+	// CPU emulation below is bit-identical to the per-layer reference and the shader differs only by the GPU's
+	// own rounding (fp16 weights, fused multiply-add).
+	//
+	// The constants MUST match NeuralConvFused.comp.hlsl.
+	inline constexpr uint32_t kFusedTile = 8;
+	inline constexpr uint32_t kFusedPlaneFloats = 3072; // per LDS plane: 2 x 12 KB
+	inline constexpr uint32_t kFusedMaxLayers = 8;
+	inline constexpr uint32_t kFusedOutChannels = 3; // the residual the shader adds to the base
+
+	// Whether (and how) a model can run fused. Not fusable when: a layer has an even kernel or int8 storage (the
+	// dot4 path is per-layer only), the layers don't chain, the last layer isn't a 3-channel residual, there are
+	// more than kFusedMaxLayers layers, or some region outgrows an LDS plane (wide layers or a deep receptive
+	// field) — those models keep the per-layer dispatches.
+	struct FusedConvPlan
+	{
+		bool Fusable = false;
+		uint32_t Halo = 0;            // texels of input context per tile side (sum of the layer radii)
+		uint32_t PeakPlaneFloats = 0; // largest region either LDS plane holds
+		const char* Reason = "";      // why not fusable, for the log
+	};
+
+	FusedConvPlan PlanFusedConv(const NeuralModel& model);
+
+	// Edge length of the region layer `layer` writes (the layer input region for layer 0 is TILE + 2 * Halo).
+	uint32_t FusedRegionSide(const NeuralModel& model, size_t layer);
+
+	// CPU emulation of NeuralConvFused.comp, tile by tile with the shader's regions and plane ping-pong: runs
+	// the stack on `input` (CHW, the first layer's InChannels) and writes the last layer's output (the residual,
+	// before the base add) to `out`. Returns false (logged) when the model isn't fusable or the channels
+	// mismatch. This is the oracle the fused kernel is validated against, bit for bit with the per-layer
+	// Conv2DReference chain.
+	bool RunFusedReference(const NeuralModel& model, const FeatureMap& input, FeatureMap& out);
+}
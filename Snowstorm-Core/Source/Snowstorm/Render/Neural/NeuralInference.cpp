@@ -0,0 +1,742 @@
+#include "NeuralInference.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SS_NEURAL_X64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SS_NEURAL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace Snowstorm::Neural
+{
+	namespace
+	{
+		// Micro-kernel block: kOcBlock output channels x kPixBlock pixels of accumulators. 4x8 keeps every
+		// accumulator in a register on all three paths (4 ymm on AVX2, 8 q-regs on NEON).
+		constexpr uint32_t kOcBlock = 4;
+		constexpr uint32_t kPixBlock = 8;
+
+		// Pixels per tile (one row segment). A tile's column block is K x kTileWidth floats: 144 x 128 x 4 B =
+		// 72 KB at the widest 16-channel 3x3 layer, which stays resident in L2 while every output channel
+		// block streams over it. Multiple of kPixBlock so only the row's last tile has padding.
+		constexpr uint32_t kTileWidth = 128;
+
+		// Chunks handed to the pool per worker: a few per worker so a slow chunk doesn't leave the rest idle,
+		// few enough that the per-chunk column scratch stays small.
+		constexpr size_t kChunksPerWorker = 4;
+
+		using Accumulators = float[kOcBlock][kPixBlock];
+
+		// acc[i][p] = bias[i] + sum_k w[i*K + k] * col[k*colStride + p], then the activation. `w` points at
+		// the block's first row; rows are K floats apart.
+		using MicroKernel = void (*)(const float* w, uint32_t K, const float* col, uint32_t colStride,
+		                             const float* bias, bool relu, Accumulators& acc);
+
+		void MicroKernelScalar(const float* w, const uint32_t K, const float* col, const uint32_t colStride,
+		                       const float* bias, const bool relu, Accumulators& acc)
+		{
+			// Fixed-size inner loops: the compiler keeps acc in registers and vectorizes the p loop with the
+			// baseline ISA (SSE2 on x64), so this is the portable path rather than a slow one.
+			for (uint32_t i = 0; i < kOcBlock; ++i)
+			{
+				for (uint32_t p = 0; p < kPixBlock; ++p)
+				{
+					acc[i][p] = bias[i];
+				}
+			}
+			for (uint32_t k = 0; k < K; ++k)
+			{
+				const float* c = col + static_cast<size_t>(k) * colStride;
+				for (uint32_t i = 0; i < kOcBlock; ++i)
+				{
+					const float wv = w[static_cast<size_t>(i) * K + k];
+					for (uint32_t p = 0; p < kPixBlock; ++p)
+					{
+						acc[i][p] += wv * c[p];
+					}
+				}
+			}
+			if (relu)
+			{
+				for (auto& row : acc)
+				{
+					for (float& v : row)
+					{
+						v = v > 0.0f ? v : 0.0f;
+					}
+				}
+			}
+		}
+
+#if SS_NEURAL_X64
+		// Compiled for AVX2+FMA regardless of the TU's /arch (MSVC allows the intrinsics anywhere; GCC/Clang
+		// need the target attribute) and only ever called after the runtime check below, so the binary still
+		// runs on a pre-AVX2 machine. An AVX-512 CPU takes this path too; a 16-wide kernel would slot in the
+		// same way if profiling ever asks for it.
+#if defined(__GNUC__) || defined(__clang__)
+		__attribute__((target("avx2,fma")))
+#endif
+		void MicroKernelAvx2(const float* w, const uint32_t K, const float* col, const uint32_t colStride,
+		                     const float* bias, const bool relu, Accumulators& acc)
+		{
+			__m256 a0 = _mm256_set1_ps(bias[0]);
+			__m256 a1 = _mm256_set1_ps(bias[1]);
+			__m256 a2 = _mm256_set1_ps(bias[2]);
+			__m256 a3 = _mm256_set1_ps(bias[3]);
+			const float* w0 = w;
+			const float* w1 = w + K;
+			const float* w2 = w + 2 * static_cast<size_t>(K);
+			const float* w3 = w + 3 * static_cast<size_t>(K);
+			for (uint32_t k = 0; k < K; ++k)
+			{
+				const __m256 c = _mm256_loadu_ps(col + static_cast<size_t>(k) * colStride);
+				a0 = _mm256_fmadd_ps(_mm256_set1_ps(w0[k]), c, a0);
+				a1 = _mm256_fmadd_ps(_mm256_set1_ps(w1[k]), c, a1);
+				a2 = _mm256_fmadd_ps(_mm256_set1_ps(w2[k]), c, a2);
+				a3 = _mm256_fmadd_ps(_mm256_set1_ps(w3[k]), c, a3);
+			}
+			if (relu)
+			{
+				const __m256 zero = _mm256_setzero_ps();
+				a0 = _mm256_max_ps(a0, zero);
+				a1 = _mm256_max_ps(a1, zero);
+				a2 = _mm256_max_ps(a2, zero);
+				a3 = _mm256_max_ps(a3, zero);
+			}
+			_mm256_storeu_ps(acc[0], a0);
+			_mm256_storeu_ps(acc[1], a1);
+			_mm256_storeu_ps(acc[2], a2);
+			_mm256_storeu_ps(acc[3], a3);
+		}
+
+		bool CpuHasAvx2Fma()
+		{
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			const bool fma = (info[2] & (1 << 12)) != 0;
+			if (!osxsave || !avx || !fma || (_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false; // the OS must save ymm state too, not just the CPU support it
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+		}
+#endif
+
+#if SS_NEURAL_NEON
+		void MicroKernelNeon(const float* w, const uint32_t K, const float* col, const uint32_t colStride,
+		                     const float* bias, const bool relu, Accumulators& acc)
+		{
+			float32x4_t a[kOcBlock][2];
+			for (uint32_t i = 0; i < kOcBlock; ++i)
+			{
+				a[i][0] = a[i][1] = vdupq_n_f32(bias[i]);
+			}
+			for (uint32_t k = 0; k < K; ++k)
+			{
+				const float* c = col + static_cast<size_t>(k) * colStride;
+				const float32x4_t c0 = vld1q_f32(c);
+				const float32x4_t c1 = vld1q_f32(c + 4);
+				for (uint32_t i = 0; i < kOcBlock; ++i)
+				{
+					const float32x4_t wv = vdupq_n_f32(w[static_cast<size_t>(i) * K + k]);
+					a[i][0] = vfmaq_f32(a[i][0], wv, c0);
+					a[i][1] = vfmaq_f32(a[i][1], wv, c1);
+				}
+			}
+			const float32x4_t zero = vdupq_n_f32(0.0f);
+			for (uint32_t i = 0; i < kOcBlock; ++i)
+			{
+				vst1q_f32(acc[i], relu ? vmaxq_f32(a[i][0], zero) : a[i][0]);
+				vst1q_f32(acc[i] + 4, relu ? vmaxq_f32(a[i][1], zero) : a[i][1]);
+			}
+		}
+#endif
+
+		// Picked once: NEON is baseline on AArch64; AVX2 is checked at runtime on x64.
+		MicroKernel SelectMicroKernel()
+		{
+#if SS_NEURAL_X64
+			if (CpuHasAvx2Fma())
+			{
+				return &MicroKernelAvx2;
+			}
+#elif SS_NEURAL_NEON
+			return &MicroKernelNeon;
+#endif
+			return &MicroKernelScalar;
+		}
+
+		MicroKernel GetMicroKernel()
+		{
+			static const MicroKernel kernel = SelectMicroKernel();
+			return kernel;
+		}
+
+		// The int8 kernel's pixel block is twice the float one: each vpmaddwd retires two K steps, so 4 x 16
+		// (8 ymm accumulators, two column loads per step) is what it takes to beat the FMA kernel's
+		// instructions-per-MAC rather than just match it.
+		constexpr uint32_t kInt8PixBlock = 16;
+		using Int8Accumulators = int32_t[kOcBlock][kInt8PixBlock];
+
+		// acc[i][p] = sum_j dot(pair(col, j, p), pair(w, i, j)): the int8 layer's K reduction two taps at a time.
+		// `col` holds (q - z) int16 pairs, [KPairs][colStride][2]; `w` rows are KPairs words of two int16.
+		using Int8MicroKernel = void (*)(const int32_t* w, uint32_t kPairs, const int16_t* col, uint32_t colStride,
+		                                 Int8Accumulators& acc);
+
+		void Int8MicroKernelScalar(const int32_t* w, const uint32_t kPairs, const int16_t* col, const uint32_t colStride,
+		                           Int8Accumulators& acc)
+		{
+			for (auto& row : acc)
+			{
+				std::fill(std::begin(row), std::end(row), 0);
+			}
+			for (uint32_t j = 0; j < kPairs; ++j)
+			{
+				const int16_t* c = col + static_cast<size_t>(j) * colStride * 2;
+				for (uint32_t i = 0; i < kOcBlock; ++i)
+				{
+					const uint32_t word = static_cast<uint32_t>(w[static_cast<size_t>(i) * kPairs + j]);
+					const int32_t w0 = static_cast<int16_t>(word & 0xFFFFu);
+					const int32_t w1 = static_cast<int16_t>(word >> 16);
+					for (uint32_t p = 0; p < kInt8PixBlock; ++p)
+					{
+						acc[i][p] += c[2 * p] * w0 + c[2 * p + 1] * w1;
+					}
+				}
+			}
+		}
+
+#if SS_NEURAL_X64
+		// vpmaddwd: eight pixels' (a0*w0 + a1*w1) per instruction. Products are at most 255*127, so the pairwise
+		// sum cannot overflow int32 (and, unlike vpmaddubsw, nothing saturates at int16).
+#if defined(__GNUC__) || defined(__clang__)
+		__attribute__((target("avx2")))
+#endif
+		void Int8MicroKernelAvx2(const int32_t* w, const uint32_t kPairs, const int16_t* col, const uint32_t colStride,
+		                         Int8Accumulators& acc)
+		{
+			// Named accumulators, not an array: an indexed __m256i array gets spilled to the stack.
+			__m256i a0 = _mm256_setzero_si256(), b0 = _mm256_setzero_si256();
+			__m256i a1 = _mm256_setzero_si256(), b1 = _mm256_setzero_si256();
+			__m256i a2 = _mm256_setzero_si256(), b2 = _mm256_setzero_si256();
+			__m256i a3 = _mm256_setzero_si256(), b3 = _mm256_setzero_si256();
+			const int32_t* w0 = w;
+			const int32_t* w1 = w + kPairs;
+			const int32_t* w2 = w + 2 * static_cast<size_t>(kPairs);
+			const int32_t* w3 = w + 3 * static_cast<size_t>(kPairs);
+			for (uint32_t j = 0; j < kPairs; ++j)
+			{
+				const int16_t* c = col + static_cast<size_t>(j) * colStride * 2;
+				const __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c));
+				const __m256i c1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + 16));
+				__m256i wv = _mm256_set1_epi32(w0[j]);
+				a0 = _mm256_add_epi32(a0, _mm256_madd_epi16(c0, wv));
+				b0 = _mm256_add_epi32(b0, _mm256_madd_epi16(c1, wv));
+				wv = _mm256_set1_epi32(w1[j]);
+				a1 = _mm256_add_epi32(a1, _mm256_madd_epi16(c0, wv));
+				b1 = _mm256_add_epi32(b1, _mm256_madd_epi16(c1, wv));
+				wv = _mm256_set1_epi32(w2[j]);
+				a2 = _mm256_add_epi32(a2, _mm256_madd_epi16(c0, wv));
+				b2 = _mm256_add_epi32(b2, _mm256_madd_epi16(c1, wv));
+				wv = _mm256_set1_epi32(w3[j]);
+				a3 = _mm256_add_epi32(a3, _mm256_madd_epi16(c0, wv));
+				b3 = _mm256_add_epi32(b3, _mm256_madd_epi16(c1, wv));
+			}
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[0]), a0);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[0] + 8), b0);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[1]), a1);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[1] + 8), b1);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[2]), a2);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[2] + 8), b2);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[3]), a3);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc[3] + 8), b3);
+		}
+#endif
+
+		Int8MicroKernel GetInt8MicroKernel()
+		{
+			static const Int8MicroKernel kernel = []
+			{
+#if SS_NEURAL_X64
+				if (CpuHasAvx2Fma())
+				{
+					return &Int8MicroKernelAvx2;
+				}
+#endif
+				return &Int8MicroKernelScalar;
+			}();
+			return kernel;
+		}
+
+		// Fill the column block for one tile (row y, pixels [x0, x0+n)): row k = (ic, ky, kx) holds the input
+		// sample each output pixel multiplies by weight k, zero outside the image ("same" padding) and in the
+		// padding lanes up to nPadded.
+		void Im2ColTile(const float* in, const uint32_t inChannels, const uint32_t kernelSize, const uint32_t width,
+		                const uint32_t height, const uint32_t y, const uint32_t x0, const uint32_t n,
+		                const uint32_t nPadded, float* col)
+		{
+			const int radius = static_cast<int>(kernelSize / 2);
+			const size_t plane = static_cast<size_t>(width) * height;
+			float* row = col;
+			for (uint32_t ic = 0; ic < inChannels; ++ic)
+			{
+				for (uint32_t ky = 0; ky < kernelSize; ++ky)
+				{
+					const int sy = static_cast<int>(y) + static_cast<int>(ky) - radius;
+					for (uint32_t kx = 0; kx < kernelSize; ++kx, row += kTileWidth)
+					{
+						if (sy < 0 || sy >= static_cast<int>(height))
+						{
+							std::fill_n(row, nPadded, 0.0f);
+							continue;
+						}
+
+						// Source column of lane j is j + shift; lanes outside [0, width) are padding.
+						const float* src = in + ic * plane + static_cast<size_t>(sy) * width;
+						const int shift = static_cast<int>(x0) + static_cast<int>(kx) - radius;
+						const int jBegin = std::clamp(-shift, 0, static_cast<int>(n));
+						const int jEnd = std::clamp(static_cast<int>(width) - shift, jBegin, static_cast<int>(n));
+						std::fill_n(row, jBegin, 0.0f);
+						if (jEnd > jBegin)
+						{
+							std::memcpy(row + jBegin, src + jBegin + shift, static_cast<size_t>(jEnd - jBegin) * sizeof(float));
+						}
+						std::fill(row + jEnd, row + nPadded, 0.0f);
+					}
+				}
+			}
+		}
+
+		// Im2ColTile for an Int8 layer, over the layer input already quantized to (q - z) int16: the same
+		// [K][kTileWidth] gather into `planar`, then adjacent rows interleaved into K pairs ([kPairs][kTileWidth][2])
+		// for the pairwise multiply-add. Two plain passes instead of one strided one, so both vectorize. Padding
+		// taps and the odd-K tail are 0 — exactly the quantized zero, since the input range always contains it.
+		void Im2ColTileInt8(const int16_t* in, const uint32_t inChannels, const uint32_t kernelSize, const uint32_t width,
+		                    const uint32_t height, const uint32_t y, const uint32_t x0, const uint32_t n,
+		                    const uint32_t nPadded, const uint32_t kPairs, int16_t* planar, int16_t* col)
+		{
+			const int radius = static_cast<int>(kernelSize / 2);
+			const size_t plane = static_cast<size_t>(width) * height;
+			int16_t* row = planar;
+			for (uint32_t ic = 0; ic < inChannels; ++ic)
+			{
+				for (uint32_t ky = 0; ky < kernelSize; ++ky)
+				{
+					const int sy = static_cast<int>(y) + static_cast<int>(ky) - radius;
+					for (uint32_t kx = 0; kx < kernelSize; ++kx, row += kTileWidth)
+					{
+						if (sy < 0 || sy >= static_cast<int>(height))
+						{
+							std::fill_n(row, nPadded, int16_t{0});
+							continue;
+						}
+						const int16_t* src = in + ic * plane + static_cast<size_t>(sy) * width;
+						const int shift = static_cast<int>(x0) + static_cast<int>(kx) - radius;
+						const int jBegin = std::clamp(-shift, 0, static_cast<int>(n));
+						const int jEnd = std::clamp(static_cast<int>(width) - shift, jBegin, static_cast<int>(n));
+						std::fill_n(row, jBegin, int16_t{0});
+						if (jEnd > jBegin)
+						{
+							std::memcpy(row + jBegin, src + jBegin + shift, static_cast<size_t>(jEnd - jBegin) * sizeof(int16_t));
+						}
+						std::fill(row + jEnd, row + nPadded, int16_t{0});
+					}
+				}
+			}
+			const uint32_t k = inChannels * kernelSize * kernelSize;
+			if (k & 1)
+			{
+				std::fill_n(row, nPadded, int16_t{0}); // odd K: the last pair's second tap
+			}
+
+			for (uint32_t j = 0; j < kPairs; ++j)
+			{
+				const int16_t* r0 = planar + static_cast<size_t>(2 * j) * kTileWidth;
+				const int16_t* r1 = r0 + kTileWidth;
+				int16_t* dst = col + static_cast<size_t>(j) * kTileWidth * 2;
+				uint32_t p = 0;
+#if SS_NEURAL_X64
+				// SSE2 is baseline on x64; compilers won't vectorize the two-stream interleave on their own.
+				for (; p + 8 <= nPadded; p += 8)
+				{
+					const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + p));
+					const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + p));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * p), _mm_unpacklo_epi16(v0, v1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * p + 8), _mm_unpackhi_epi16(v0, v1));
+				}
+#elif SS_NEURAL_NEON
+				for (; p + 8 <= nPadded; p += 8)
+				{
+					vst2q_s16(dst + 2 * p, int16x8x2_t{vld1q_s16(r0 + p), vld1q_s16(r1 + p)});
+				}
+#endif
+				for (; p < nPadded; ++p)
+				{
+					dst[2 * p] = r0[p];
+					dst[2 * p + 1] = r1[p];
+				}
+			}
+		}
+	}
+
+	CpuInference::CpuInference(const NeuralModel& model)
+	{
+		m_Layers.reserve(model.Layers.size());
+		for (size_t i = 0; i < model.Layers.size(); ++i)
+		{
+			const ConvLayer& src = model.Layers[i];
+			PackedLayer l;
+			l.InChannels = src.InChannels;
+			l.OutChannels = src.OutChannels;
+			l.PaddedOutChannels = (src.OutChannels + kOcBlock - 1) / kOcBlock * kOcBlock;
+			l.KernelSize = src.KernelSize;
+			l.K = src.InChannels * src.KernelSize * src.KernelSize;
+			l.Act = src.Act;
+
+			// [outC][inC][kH][kW] is already [outC][K] in im2col order: copy as-is, zero rows to the padded count.
+			l.Weights.assign(static_cast<size_t>(l.PaddedOutChannels) * l.K, 0.0f);
+			std::copy_n(src.Weights.begin(), std::min(src.Weights.size(), l.Weights.size()), l.Weights.begin());
+			l.Bias.assign(l.PaddedOutChannels, 0.0f);
+			std::copy_n(src.Bias.begin(), std::min<size_t>(src.Bias.size(), l.OutChannels), l.Bias.begin());
+
+			if (src.Quant.Storage == WeightStorage::Int8 && src.Quant.QWeights.size() == src.Weights.size() &&
+			    src.Quant.InputScale > 0.0f)
+			{
+				// Two int16-widened int8 weights per word along K, in the order the int16 column pairs are laid out.
+				l.Int8 = true;
+				l.KPairs = (l.K + 1) / 2;
+				l.WeightPairs.assign(static_cast<size_t>(l.PaddedOutChannels) * l.KPairs, 0);
+				l.OutputScale.assign(l.PaddedOutChannels, 0.0f);
+				for (uint32_t oc = 0; oc < l.OutChannels; ++oc)
+				{
+					const int8_t* q = src.Quant.QWeights.data() + static_cast<size_t>(oc) * l.K;
+					for (uint32_t j = 0; j < l.KPairs; ++j)
+					{
+						const uint32_t lo = static_cast<uint16_t>(static_cast<int16_t>(q[2 * j]));
+						const uint32_t hi = 2 * j + 1 < l.K ? static_cast<uint16_t>(static_cast<int16_t>(q[2 * j + 1])) : 0u;
+						l.WeightPairs[static_cast<size_t>(oc) * l.KPairs + j] = static_cast<int32_t>(lo | (hi << 16));
+					}
+					l.OutputScale[oc] = src.Quant.InputScale * src.Quant.WeightScales[oc];
+				}
+				l.InputScaleInv = 1.0f / src.Quant.InputScale;
+				l.InputZeroPoint = src.Quant.InputZeroPoint;
+				m_MaxKPairs = std::max(m_MaxKPairs, l.KPairs);
+				m_MaxInt8InChannels = std::max(m_MaxInt8InChannels, l.InChannels);
+			}
+
+			m_MaxK = std::max(m_MaxK, l.K);
+			if (i + 1 < model.Layers.size())
+			{
+				m_MaxHiddenChannels = std::max(m_MaxHiddenChannels, l.OutChannels); // the last layer writes `out`
+			}
+			m_Layers.push_back(std::move(l));
+		}
+	}
+
+	size_t CpuInference::Int8ScratchPerChunk() const
+	{
+		return 2 * (static_cast<size_t>(m_MaxKPairs) * 2) * kTileWidth;
+	}
+
+	void CpuInference::EnsureArena(const uint32_t width, const uint32_t height, const size_t chunkCount)
+	{
+		if (width == m_ArenaWidth && height == m_ArenaHeight && chunkCount == m_ArenaChunks)
+		{
+			return;
+		}
+		const size_t plane = static_cast<size_t>(width) * height;
+		const size_t activations = 2 * static_cast<size_t>(m_MaxHiddenChannels) * plane;
+		const size_t scratch = chunkCount * m_MaxK * kTileWidth;
+		m_Arena.assign(activations + scratch, 0.0f);
+		m_Int8Scratch.assign(chunkCount * Int8ScratchPerChunk(), 0);
+		m_Int8Input.assign(m_MaxKPairs > 0 ? m_MaxInt8InChannels * plane : 0, 0);
+		m_ArenaWidth = width;
+		m_ArenaHeight = height;
+		m_ArenaChunks = chunkCount;
+	}
+
+	void CpuInference::RunTile(const PackedLayer& layer, const float* in, float* out, const uint32_t width,
+	                           const uint32_t height, const uint32_t y, const uint32_t x0, const size_t chunk)
+	{
+		const size_t plane = static_cast<size_t>(width) * height;
+		const uint32_t n = std::min(kTileWidth, width - x0);
+		const uint32_t nPadded = (n + kPixBlock - 1) / kPixBlock * kPixBlock;
+		const bool relu = layer.Act == Activation::ReLU;
+
+		const auto store = [&](const uint32_t oc, const uint32_t p, const Accumulators& acc)
+		{
+			const uint32_t rows = std::min(kOcBlock, layer.OutChannels - std::min(oc, layer.OutChannels));
+			const uint32_t count = std::min(kPixBlock, n - p);
+			for (uint32_t i = 0; i < rows; ++i)
+			{
+				float* dst = out + (oc + i) * plane + static_cast<size_t>(y) * width + x0 + p;
+				std::memcpy(dst, acc[i], count * sizeof(float));
+			}
+		};
+
+		if (!layer.Int8)
+		{
+			const MicroKernel kernel = GetMicroKernel();
+			float* col = m_Arena.data() + 2 * static_cast<size_t>(m_MaxHiddenChannels) * plane +
+			             chunk * static_cast<size_t>(m_MaxK) * kTileWidth;
+			Im2ColTile(in, layer.InChannels, layer.KernelSize, width, height, y, x0, n, nPadded, col);
+
+			for (uint32_t oc = 0; oc < layer.PaddedOutChannels; oc += kOcBlock)
+			{
+				const float* w = layer.Weights.data() + static_cast<size_t>(oc) * layer.K;
+				for (uint32_t p = 0; p < nPadded; p += kPixBlock)
+				{
+					Accumulators acc;
+					kernel(w, layer.K, col + p, kTileWidth, layer.Bias.data() + oc, relu, acc);
+					store(oc, p, acc);
+				}
+			}
+			return;
+		}
+
+		// Int8: exact int32 dot products, then one float rescale + bias + activation per output (the same
+		// epilogue order as Conv2DInt8Reference, so the results agree to the last rounding of the rescale).
+		const Int8MicroKernel kernel = GetInt8MicroKernel();
+		const uint32_t nPadded16 = (n + kInt8PixBlock - 1) / kInt8PixBlock * kInt8PixBlock;
+		int16_t* planar = m_Int8Scratch.data() + chunk * Int8ScratchPerChunk();
+		int16_t* col = planar + (static_cast<size_t>(m_MaxKPairs) * 2) * kTileWidth;
+		Im2ColTileInt8(m_Int8Input.data(), layer.InChannels, layer.KernelSize, width, height, y, x0, n, nPadded16,
+		               layer.KPairs, planar, col);
+
+		for (uint32_t oc = 0; oc < layer.PaddedOutChannels; oc += kOcBlock)
+		{
+			const int32_t* w = layer.WeightPairs.data() + static_cast<size_t>(oc) * layer.KPairs;
+			for (uint32_t p = 0; p < nPadded16; p += kInt8PixBlock)
+			{
+				Int8Accumulators iacc;
+				kernel(w, layer.KPairs, col + 2 * static_cast<size_t>(p), kTileWidth, iacc);
+
+				for (uint32_t half = 0; half < kInt8PixBlock && p + half < n; half += kPixBlock)
+				{
+					Accumulators acc;
+					for (uint32_t i = 0; i < kOcBlock; ++i)
+					{
+						for (uint32_t j = 0; j < kPixBlock; ++j)
+						{
+							const float v = layer.Bias[oc + i] + static_cast<float>(iacc[i][half + j]) * layer.OutputScale[oc + i];
+							acc[i][j] = relu ? std::max(v, 0.0f) : v;
+						}
+					}
+					store(oc, p + half, acc);
+				}
+			}
+		}
+	}
+
+	void CpuInference::RunLayer(const PackedLayer& layer, const float* in, float* out, const uint32_t width,
+	                            const uint32_t height, JobSystem* jobs)
+	{
+		const uint32_t tilesPerRow = (width + kTileWidth - 1) / kTileWidth;
+		const size_t tileCount = static_cast<size_t>(tilesPerRow) * height;
+
+		// Int8 layers quantize their whole input once up front (every texel feeds k*k column rows), so the
+		// per-tile im2col is a plain int16 gather.
+		const size_t quantCount = layer.Int8 ? static_cast<size_t>(layer.InChannels) * width * height : 0;
+		const auto quantizeChunk = [&](const size_t chunk)
+		{
+			const int32_t z = static_cast<int32_t>(layer.InputZeroPoint);
+			const size_t end = quantCount * (chunk + 1) / m_ArenaChunks;
+			for (size_t i = quantCount * chunk / m_ArenaChunks; i < end; ++i)
+			{
+				m_Int8Input[i] = static_cast<int16_t>(static_cast<int32_t>(QuantizeActivation(in[i], layer.InputScaleInv, layer.InputZeroPoint)) - z);
+			}
+		};
+
+		const auto runChunk = [&](const size_t chunk)
+		{
+			const size_t tileBegin = tileCount * chunk / m_ArenaChunks;
+			const size_t tileEnd = tileCount * (chunk + 1) / m_ArenaChunks;
+			for (size_t t = tileBegin; t < tileEnd; ++t)
+			{
+				const uint32_t y = static_cast<uint32_t>(t / tilesPerRow);
+				const uint32_t x0 = static_cast<uint32_t>(t % tilesPerRow) * kTileWidth;
+				RunTile(layer, in, out, width, height, y, x0, chunk);
+			}
+		};
+
+		const auto forEachChunk = [&](const auto& body)
+		{
+			if (jobs && m_ArenaChunks > 1)
+			{
+				jobs->ParallelFor(m_ArenaChunks, [&](const size_t begin, const size_t end)
+				                  {
+					for (size_t c = begin; c < end; ++c)
+					{
+						body(c);
+					} }, 1);
+			}
+			else
+			{
+				for (size_t c = 0; c < m_ArenaChunks; ++c)
+				{
+					body(c);
+				}
+			}
+		};
+
+		if (layer.Int8)
+		{
+			forEachChunk(quantizeChunk);
+		}
+		forEachChunk(runChunk);
+	}
+
+	bool CpuInference::Run(const FeatureMap& input, FeatureMap& out, JobSystem* jobs)
+	{
+		return RunObserved(input, out, {}, jobs);
+	}
+
+	bool CpuInference::RunObserved(const FeatureMap& input, FeatureMap& out, const LayerObserver& observer,
+	                               JobSystem* jobs)
+	{
+		if (m_Layers.empty())
+		{
+			SS_CORE_ERROR("CpuInference: model has no layers");
+			return false;
+		}
+		if (input.Channels != m_Layers.front().InChannels ||
+		    input.Data.size() != static_cast<size_t>(input.Channels) * input.Height * input.Width)
+		{
+			SS_CORE_ERROR("CpuInference: input has {} channel(s) ({}x{}), model expects {}", input.Channels,
+			              input.Width, input.Height, m_Layers.front().InChannels);
+			return false;
+		}
+		for (size_t i = 1; i < m_Layers.size(); ++i)
+		{
+			if (m_Layers[i].InChannels != m_Layers[i - 1].OutChannels)
+			{
+				SS_CORE_ERROR("CpuInference: layer {} expects {} channel(s) but layer {} produces {}", i,
+				              m_Layers[i].InChannels, i - 1, m_Layers[i - 1].OutChannels);
+				return false;
+			}
+		}
+
+		const uint32_t width = input.Width, height = input.Height;
+		const size_t plane = static_cast<size_t>(width) * height;
+		const uint32_t tilesPerRow = (width + kTileWidth - 1) / kTileWidth;
+		const size_t tileCount = static_cast<size_t>(tilesPerRow) * height;
+		const size_t chunkCount = jobs ? std::clamp<size_t>((jobs->WorkerCount() + 1) * kChunksPerWorker, 1, std::max<size_t>(tileCount, 1)) : 1;
+		EnsureArena(width, height, chunkCount);
+
+		out.Channels = m_Layers.back().OutChannels;
+		out.Height = height;
+		out.Width = width;
+		out.Data.resize(static_cast<size_t>(out.Channels) * plane);
+		if (plane == 0)
+		{
+			return true;
+		}
+
+		// Hidden activations ping-pong between the two arena planes; layer 0 reads the caller's input in place
+		// and the last layer writes straight into `out`, so nothing is copied in or out of the arena.
+		float* ping[2] = {m_Arena.data(), m_Arena.data() + static_cast<size_t>(m_MaxHiddenChannels) * plane};
+		const float* src = input.Data.data();
+		for (size_t i = 0; i < m_Layers.size(); ++i)
+		{
+			if (observer)
+			{
+				observer(i, std::span(src, static_cast<size_t>(m_Layers[i].InChannels) * plane));
+			}
+			float* dst = (i + 1 == m_Layers.size()) ? out.Data.data() : ping[i % 2];
+			RunLayer(m_Layers[i], src, dst, width, height, jobs);
+			src = dst;
+		}
+		return true;
+	}
+
+	void CpuInference::UpsampleBilinear(const FeatureMap& in, const uint32_t outWidth, const uint32_t outHeight,
+	                                    FeatureMap& out)
+	{
+		out.Channels = in.Channels;
+		out.Width = outWidth;
+		out.Height = outHeight;
+		out.Data.resize(static_cast<size_t>(in.Channels) * outWidth * outHeight);
+		if (in.Width == 0 || in.Height == 0)
+		{
+			std::fill(out.Data.begin(), out.Data.end(), 0.0f);
+			return;
+		}
+
+		// uv = (dst + 0.5) / outSize, sampled at uv * inSize - 0.5 with both taps clamped to the edge: what
+		// LinearClamp.SampleLevel does (minus the GPU's 8-bit filter-weight quantization).
+		const auto taps = [](const uint32_t dst, const uint32_t outSize, const uint32_t inSize, uint32_t& i0,
+		                     uint32_t& i1, float& t)
+		{
+			const float s = (static_cast<float>(dst) + 0.5f) * static_cast<float>(inSize) / static_cast<float>(outSize) - 0.5f;
+			const float f = std::floor(s);
+			t = s - f;
+			const int base = static_cast<int>(f);
+			const int maxIndex = static_cast<int>(inSize) - 1;
+			i0 = static_cast<uint32_t>(std::clamp(base, 0, maxIndex));
+			i1 = static_cast<uint32_t>(std::clamp(base + 1, 0, maxIndex));
+		};
+
+		std::vector<uint32_t> x0(outWidth), x1(outWidth);
+		std::vector<float> tx(outWidth);
+		for (uint32_t x = 0; x < outWidth; ++x)
+		{
+			taps(x, outWidth, in.Width, x0[x], x1[x], tx[x]);
+		}
+		for (uint32_t c = 0; c < in.Channels; ++c)
+		{
+			for (uint32_t y = 0; y < outHeight; ++y)
+			{
+				uint32_t y0, y1;
+				float ty;
+				taps(y, outHeight, in.Height, y0, y1, ty);
+				for (uint32_t x = 0; x < outWidth; ++x)
+				{
+					const float top = in.At(c, y0, x0[x]) + (in.At(c, y0, x1[x]) - in.At(c, y0, x0[x])) * tx[x];
+					const float bottom = in.At(c, y1, x0[x]) + (in.At(c, y1, x1[x]) - in.At(c, y1, x0[x])) * tx[x];
+					out.At(c, y, x) = top + (bottom - top) * ty;
+				}
+			}
+		}
+	}
+
+	bool CpuInference::Upscale(const FeatureMap& lowRes, const uint32_t outWidth, const uint32_t outHeight,
+	                           FeatureMap& out, JobSystem* jobs)
+	{
+		if (m_Layers.empty() || m_Layers.front().InChannels != 3 || m_Layers.back().OutChannels != 3 || lowRes.Channels != 3)
+		{
+			SS_CORE_ERROR("CpuInference::Upscale needs a 3-channel input and a 3-in/3-out model (temporal models: use Run)");
+			return false;
+		}
+
+		UpsampleBilinear(lowRes, outWidth, outHeight, m_Base);
+		if (!Run(m_Base, out, jobs))
+		{
+			return false;
+		}
+		// output = bilinear base + residual (NeuralResidualAdd.comp).
+		for (size_t i = 0; i < out.Data.size(); ++i)
+		{
+			out.Data[i] += m_Base.Data[i];
+		}
+		return true;
+	}
+}
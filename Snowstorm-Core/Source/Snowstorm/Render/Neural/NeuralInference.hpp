@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Snowstorm/Render/Neural/NeuralWeights.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+}
+
+namespace Snowstorm::Neural
+{
+	// Production CPU inference for a NeuralModel: the same conv stack NeuralUpscalePass dispatches on the GPU,
+	// fast enough to upscale dataset frames and run quality regression on CPU-only CI machines (and to serve as a
+	// headless fallback where there is no device). Conv2DReference stays the oracle; this must match it within
+	// float reassociation tolerance (the accumulation order differs).
+	//
+	// Each layer is an im2col + GEMM: out[oc][pixel] = bias[oc] + sum_k W[oc][k] * col[k][pixel], where
+	// k = ic*kk + ky*ks + kx — exactly the [outC][inC][kH][kW] weight layout, so the weights ARE the GEMM's left
+	// matrix with no transpose. The image is cut into row-segment tiles small enough that one tile's column
+	// block stays in L2; a register-blocked micro-kernel (4 output channels x 8 pixels; AVX2/FMA, NEON, or
+	// plain C++ the compiler vectorizes) accumulates over k with bias and ReLU fused into the store. Tiles are
+	// spread over JobSystem workers, each with its own column scratch.
+	//
+	// Memory: every intermediate activation lives in one arena (two ping-pong planes of the widest hidden
+	// layer + the per-chunk column scratch), sized on the first Run for a resolution and reused for every
+	// later frame of the same size — steady-state inference allocates nothing.
+	//
+	// Int8 layers (LayerQuantization) take an integer path with the same tiling: the layer input is quantized
+	// once to (q - z) int16, im2col gathers it into K pairs, and the kernel multiplies them against int16-widened int8 weights with pairwise
+	// multiply-add (AVX2 vpmaddwd; plain C++ elsewhere), accumulating int32 exactly as Conv2DInt8Reference.
+	// The column block is half the bytes of the fp32 one and each instruction retires two products.
+	class CpuInference
+	{
+	public:
+		explicit CpuInference(const NeuralModel& model);
+
+		// Run the conv stack on `input` (CHW, Channels == the first layer's InChannels) and write the last
+		// layer's output to `out` (its storage is reused across calls). `jobs` == nullptr runs single-threaded.
+		// Returns false (logged) on a channel mismatch or an empty model.
+		bool Run(const FeatureMap& input, FeatureMap& out, JobSystem* jobs = nullptr);
+
+		// Run, calling `observer(layerIndex, layerInput)` before each layer with the full CHW input it is about
+		// to read — the hook activation calibration uses to collect per-layer ranges.
+		using LayerObserver = std::function<void(size_t layer, std::span<const float> input)>;
+		bool RunObserved(const FeatureMap& input, FeatureMap& out, const LayerObserver& observer, JobSystem* jobs = nullptr);
+
+		// The whole spatial upscaler as NeuralUpscalePass runs it: bilinear-upsample the 3-channel `lowRes` to
+		// outWidth x outHeight, run the stack, and add the residual back (output = bilinear + residual). Needs a
+		// 3-in / 3-out model (the temporal 8-channel path wants history the CPU path doesn't have; build that
+		// feature stack yourself and call Run).
+		bool Upscale(const FeatureMap& lowRes, uint32_t outWidth, uint32_t outHeight, FeatureMap& out,
+		             JobSystem* jobs = nullptr);
+
+		// Bilinear resample with the GPU's linear-clamp sampling (pixel centres, edge clamp) — the same
+		// resample NeuralUpsampleIn.comp does, so the CPU and GPU bases agree.
+		static void UpsampleBilinear(const FeatureMap& in, uint32_t outWidth, uint32_t outHeight, FeatureMap& out);
+
+		// Floats currently held by the activation arena (0 before the first Run).
+		[[nodiscard]] size_t ArenaFloats() const { return m_Arena.size(); }
+
+	private:
+		// A layer with its weights zero-padded to a multiple of the micro-kernel's output-channel block, so the
+		// kernel never needs an oc remainder path (the padded rows are computed and discarded).
+		struct PackedLayer
+		{
+			uint32_t InChannels = 0;
+			uint32_t OutChannels = 0;
+			uint32_t PaddedOutChannels = 0;
+			uint32_t KernelSize = 0;
+			uint32_t K = 0; // InChannels * KernelSize^2, the GEMM depth
+			Activation Act = Activation::None;
+			std::vector<float> Weights; // [PaddedOutChannels][K]
+			std::vector<float> Bias;    // [PaddedOutChannels]
+
+			// Int8 path (Quant.Storage == Int8): weights as int16 pairs along K (KPairs = ceil(K / 2) words per
+			// row, odd K padded with a zero weight), the per-channel output scale, and the input quantizer.
+			bool Int8 = false;
+			uint32_t KPairs = 0;
+			std::vector<int32_t> WeightPairs; // [PaddedOutChannels][KPairs], two int16 per word
+			std::vector<float> OutputScale;   // [PaddedOutChannels] InputScale * WeightScales[oc]
+			float InputScaleInv = 0.0f;
+			uint32_t InputZeroPoint = 0;
+		};
+
+		void EnsureArena(uint32_t width, uint32_t height, size_t chunkCount);
+		// int16 per chunk for an Int8 tile: the planar gather ([2 * m_MaxKPairs][kTileWidth]) + the paired block.
+		[[nodiscard]] size_t Int8ScratchPerChunk() const;
+		void RunLayer(const PackedLayer& layer, const float* in, float* out, uint32_t width, uint32_t height,
+		              JobSystem* jobs);
+		void RunTile(const PackedLayer& layer, const float* in, float* out, uint32_t width, uint32_t height,
+		             uint32_t y, uint32_t x0, size_t chunk);
+
+		std::vector<PackedLayer> m_Layers;
+		uint32_t m_MaxHiddenChannels = 0;
+		uint32_t m_MaxK = 0;
+		uint32_t m_MaxKPairs = 0;          // widest Int8 layer (0 = no Int8 layers, no int16 scratch)
+		uint32_t m_MaxInt8InChannels = 0;
+
+		std::vector<float> m_Arena;
+		std::vector<int16_t> m_Int8Scratch; // per-chunk int16 column blocks for Int8 layers
+		std::vector<int16_t> m_Int8Input;   // the current Int8 layer's input quantized to (q - z), CHW
+		uint32_t m_ArenaWidth = 0;
+		uint32_t m_ArenaHeight = 0;
+		size_t m_ArenaChunks = 0;
+		FeatureMap m_Base; // Upscale's bilinear base, kept for reuse like the arena
+	};
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <vector>
 
@@ -54,6 +55,28 @@ namespace Snowstorm::Neural
 		}
 	};
 
+	// How a layer's weights are stored in the .ssnn (and which inference path runs it). Float16 is storage only
+	// (Weights hold the half-rounded values); Int8 additionally runs the integer dot-product path.
+	enum class WeightStorage : uint32_t
+	{
+		Float32 = 0,
+		Float16 = 1,
+		Int8 = 2,
+	};
+
+	// Post-training int8 quantization of one layer. Weights are per-output-channel symmetric int8
+	// (w ~= QWeights * WeightScales[oc], zero point 0); the layer INPUT is asymmetric uint8 over the calibrated
+	// range (x ~= (q - InputZeroPoint) * InputScale). The range always contains 0, so the zero padding at the
+	// borders is exactly representable (q == InputZeroPoint).
+	struct LayerQuantization
+	{
+		WeightStorage Storage = WeightStorage::Float32;
+		std::vector<int8_t> QWeights;    // Int8: [outC][inC][kH][kW], same layout as Weights
+		std::vector<float> WeightScales; // Int8: [outC]
+		float InputScale = 0.0f;         // Int8: activation step; 0 = not calibrated
+		uint32_t InputZeroPoint = 0;     // Int8: uint8 code of 0.0
+	};
+
 	// One convolution layer's parameters. Weights is [outC][inC][kH][kW] flattened; Bias is [outC].
 	struct ConvLayer
 	{
@@ -61,8 +84,9 @@ namespace Snowstorm::Neural
 		uint32_t OutChannels = 0;
 		uint32_t KernelSize = 3; // square kernel, odd (1 or 3)
 		Activation Act = Activation::None;
-		std::vector<float> Weights; // size = OutChannels*InChannels*KernelSize*KernelSize
+		std::vector<float> Weights; // size = OutChannels*InChannels*KernelSize*KernelSize (dequantized for Int8)
 		std::vector<float> Bias;    // size = OutChannels
+		LayerQuantization Quant;    // Float32 unless the model was quantized (NeuralQuantization.hpp)
 	};
 
 	// Reference "same"-padded, stride-1 2D convolution + bias + activation. Output has OutChannels channels and
@@ -115,4 +139,75 @@ namespace Snowstorm::Neural
 		}
 		return out;
 	}
+
+	// Quantize one activation to its uint8 code: round-half-up of x / scale + z, clamped to [0, 255]. Written as
+	// truncation of the clamped, already non-negative x * (1 / scale) + (z + 0.5), so loops over it vectorize
+	// (cvttps2dq) instead of calling floor, and NeuralConv.comp evaluates the identical expression (same
+	// reciprocal multiply, same offset) so the paths agree on ties. max(0, NaN) == 0 sends NaN to code 0.
+	inline uint32_t QuantizeActivation(const float x, const float inputScaleInv, const uint32_t zeroPoint)
+	{
+		const float t = std::min(std::max(0.0f, x * inputScaleInv + (static_cast<float>(zeroPoint) + 0.5f)), 255.0f);
+		return static_cast<uint32_t>(static_cast<int32_t>(t));
+	}
+
+	// Reference int8 convolution: the exact integer math of the int8 inference paths (CpuInference's int8
+	// kernel and NeuralConv.comp's int8 branch). Inputs are quantized with the layer's calibrated scale/zero
+	// point, products accumulate in int32 as (q_a - z_a) * q_w, and the sum is rescaled once per output:
+	//   y = bias + acc * (InputScale * WeightScales[oc])
+	// Border taps contribute 0 (the padded input is 0.0, whose code is z_a). Requires Quant.Storage == Int8.
+	inline FeatureMap Conv2DInt8Reference(const FeatureMap& in, const ConvLayer& layer)
+	{
+		const uint32_t H = in.Height, W = in.Width;
+		const int kR = static_cast<int>(layer.KernelSize / 2);
+		const LayerQuantization& q = layer.Quant;
+		const float scaleInv = 1.0f / q.InputScale;
+
+		std::vector<int32_t> qin(in.Data.size());
+		for (size_t i = 0; i < in.Data.size(); ++i)
+		{
+			qin[i] = static_cast<int32_t>(QuantizeActivation(in.Data[i], scaleInv, q.InputZeroPoint)) - static_cast<int32_t>(q.InputZeroPoint);
+		}
+
+		FeatureMap out;
+		out.Channels = layer.OutChannels;
+		out.Height = H;
+		out.Width = W;
+		out.Data.assign(static_cast<size_t>(layer.OutChannels) * H * W, 0.0f);
+
+		for (uint32_t oc = 0; oc < layer.OutChannels; ++oc)
+		{
+			const float bias = oc < layer.Bias.size() ? layer.Bias[oc] : 0.0f;
+			const float scale = q.InputScale * q.WeightScales[oc];
+			for (uint32_t y = 0; y < H; ++y)
+			{
+				for (uint32_t x = 0; x < W; ++x)
+				{
+					int32_t acc = 0;
+					for (uint32_t ic = 0; ic < layer.InChannels; ++ic)
+					{
+						for (uint32_t ky = 0; ky < layer.KernelSize; ++ky)
+						{
+							const int sy = static_cast<int>(y) + static_cast<int>(ky) - kR;
+							if (sy < 0 || sy >= static_cast<int>(H))
+							{
+								continue;
+							}
+							for (uint32_t kx = 0; kx < layer.KernelSize; ++kx)
+							{
+								const int sx = static_cast<int>(x) + static_cast<int>(kx) - kR;
+								if (sx < 0 || sx >= static_cast<int>(W))
+								{
+									continue;
+								}
+								const size_t wIdx = ((static_cast<size_t>(oc) * layer.InChannels + ic) * layer.KernelSize + ky) * layer.KernelSize + kx;
+								acc += qin[(static_cast<size_t>(ic) * H + static_cast<uint32_t>(sy)) * W + static_cast<uint32_t>(sx)] * q.QWeights[wIdx];
+							}
+						}
+					}
+					out.At(oc, y, x) = ApplyActivation(bias + static_cast<float>(acc) * scale, layer.Act);
+				}
+			}
+		}
+		return out;
+	}
 }
@@ -0,0 +1,222 @@
+#include "NeuralQuantization.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Snowstorm::Neural
+{
+	namespace
+	{
+		size_t WeightsPerOutputChannel(const ConvLayer& l)
+		{
+			return static_cast<size_t>(l.InChannels) * l.KernelSize * l.KernelSize;
+		}
+	}
+
+	uint16_t FloatToHalf(const float value)
+	{
+		const uint32_t bits = std::bit_cast<uint32_t>(value);
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+		const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+		if (absBits >= 0x7F800000u) // inf / NaN (keep NaN quiet and non-zero)
+		{
+			return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x0200u : 0u));
+		}
+		if (absBits >= 0x477FF000u) // rounds past the largest half (65504)
+		{
+			return static_cast<uint16_t>(sign | 0x7C00u);
+		}
+		if (absBits < 0x38800000u) // below the smallest normal half: denormal or zero
+		{
+			if (absBits < 0x33000000u)
+			{
+				return sign; // under half of the smallest denormal
+			}
+			const uint32_t exponent = absBits >> 23;
+			const uint32_t mantissa = (absBits & 0x007FFFFFu) | 0x00800000u;
+			const uint32_t shift = 126u - exponent; // 14..24
+			uint32_t half = mantissa >> shift;
+			const uint32_t rest = mantissa & ((1u << shift) - 1u);
+			const uint32_t halfway = 1u << (shift - 1u);
+			if (rest > halfway || (rest == halfway && (half & 1u)))
+			{
+				++half;
+			}
+			return static_cast<uint16_t>(sign | half);
+		}
+
+		// Normal: rebias the exponent, round the 13 dropped mantissa bits to nearest even.
+		uint32_t half = ((absBits >> 13) - (112u << 10));
+		const uint32_t rest = absBits & 0x1FFFu;
+		if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+		{
+			++half; // a carry into the exponent is the correct rounding
+		}
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	float HalfToFloat(const uint16_t half)
+	{
+		const uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+		const uint32_t exponent = (half >> 10) & 0x1Fu;
+		const uint32_t mantissa = half & 0x03FFu;
+
+		if (exponent == 0)
+		{
+			// Zero or denormal: value = mantissa * 2^-24, exact in float.
+			const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+			return sign ? -magnitude : magnitude;
+		}
+		if (exponent == 0x1F)
+		{
+			return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+		}
+		return std::bit_cast<float>(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+	}
+
+	void QuantizeWeightsFloat16(ConvLayer& layer)
+	{
+		for (float& w : layer.Weights)
+		{
+			w = HalfToFloat(FloatToHalf(w));
+		}
+		layer.Quant = {};
+		layer.Quant.Storage = WeightStorage::Float16;
+	}
+
+	void QuantizeWeightsInt8(ConvLayer& layer)
+	{
+		const size_t perOc = WeightsPerOutputChannel(layer);
+		LayerQuantization& q = layer.Quant;
+		q.Storage = WeightStorage::Int8;
+		q.QWeights.assign(layer.Weights.size(), 0);
+		q.WeightScales.assign(layer.OutChannels, 1.0f);
+
+		for (uint32_t oc = 0; oc < layer.OutChannels; ++oc)
+		{
+			const auto row = std::span(layer.Weights).subspan(oc * perOc, perOc);
+			float maxAbs = 0.0f;
+			for (const float w : row)
+			{
+				maxAbs = std::max(maxAbs, std::abs(w));
+			}
+			// An all-zero channel (the identity refiner's output layer) keeps scale 1 and all-zero codes.
+			const float scale = maxAbs > 0.0f ? maxAbs / 127.0f : 1.0f;
+			q.WeightScales[oc] = scale;
+			for (size_t i = 0; i < perOc; ++i)
+			{
+				const float code = std::floor(row[i] / scale + 0.5f);
+				q.QWeights[oc * perOc + i] = static_cast<int8_t>(std::clamp(code, -127.0f, 127.0f));
+			}
+		}
+		DequantizeWeights(layer);
+	}
+
+	void DequantizeWeights(ConvLayer& layer)
+	{
+		const size_t perOc = WeightsPerOutputChannel(layer);
+		layer.Weights.resize(layer.Quant.QWeights.size());
+		for (size_t i = 0; i < layer.Weights.size(); ++i)
+		{
+			layer.Weights[i] = static_cast<float>(layer.Quant.QWeights[i]) * layer.Quant.WeightScales[i / perOc];
+		}
+	}
+
+	void ActivationRange::Observe(const std::span<const float> values)
+	{
+		for (const float v : values)
+		{
+			if (!std::isfinite(v))
+			{
+				continue; // a NaN/inf texel would blow the scale up for every other value
+			}
+			Min = Valid ? std::min(Min, v) : v;
+			Max = Valid ? std::max(Max, v) : v;
+			Valid = true;
+		}
+	}
+
+	void ApplyInputRange(ConvLayer& layer, const ActivationRange& range)
+	{
+		const float lo = std::min(range.Valid ? range.Min : 0.0f, 0.0f);
+		const float hi = std::max(range.Valid ? range.Max : 0.0f, 0.0f);
+		const float scale = hi > lo ? (hi - lo) / 255.0f : 1.0f;
+		layer.Quant.InputScale = scale;
+		layer.Quant.InputZeroPoint = static_cast<uint32_t>(std::clamp(std::floor(-lo / scale + 0.5f), 0.0f, 255.0f));
+	}
+
+	bool QuantizeModelInt8(NeuralModel& model, const std::vector<ActivationRange>& inputRanges, const bool keepEndsFloat16)
+	{
+		if (inputRanges.size() != model.Layers.size())
+		{
+			SS_CORE_ERROR("QuantizeModelInt8: {} activation range(s) for {} layer(s)", inputRanges.size(), model.Layers.size());
+			return false;
+		}
+		for (size_t i = 0; i < model.Layers.size(); ++i)
+		{
+			ConvLayer& layer = model.Layers[i];
+			const bool end = i == 0 || i + 1 == model.Layers.size();
+			if (keepEndsFloat16 && end)
+			{
+				QuantizeWeightsFloat16(layer);
+				continue;
+			}
+			QuantizeWeightsInt8(layer);
+			ApplyInputRange(layer, inputRanges[i]);
+		}
+		return true;
+	}
+
+	Int8GpuWeights PackInt8ForGpu(const NeuralModel& model)
+	{
+		Int8GpuWeights packed;
+		packed.WordOffsets.assign(model.Layers.size(), 0);
+		packed.ParamOffsets.assign(model.Layers.size(), 0);
+
+		for (size_t li = 0; li < model.Layers.size(); ++li)
+		{
+			const ConvLayer& l = model.Layers[li];
+			if (l.Quant.Storage != WeightStorage::Int8)
+			{
+				continue;
+			}
+
+			const uint32_t taps = l.KernelSize * l.KernelSize;
+			const uint32_t wordsPerIc = Int8WordsPerInputChannel(l.KernelSize);
+			packed.WordOffsets[li] = static_cast<uint32_t>(packed.Words.size());
+			packed.ParamOffsets[li] = static_cast<uint32_t>(packed.Params.size());
+
+			std::vector<float> scales(l.OutChannels), corrections(l.OutChannels);
+			for (uint32_t oc = 0; oc < l.OutChannels; ++oc)
+			{
+				int32_t weightSum = 0;
+				for (uint32_t ic = 0; ic < l.InChannels; ++ic)
+				{
+					const size_t base = (static_cast<size_t>(oc) * l.InChannels + ic) * taps;
+					for (uint32_t w = 0; w < wordsPerIc; ++w)
+					{
+						uint32_t word = 0;
+						for (uint32_t b = 0; b < 4; ++b)
+						{
+							const uint32_t t = w * 4 + b;
+							const int8_t code = t < taps ? l.Quant.QWeights[base + t] : int8_t{0};
+							word |= static_cast<uint32_t>(static_cast<uint8_t>(code)) << (8 * b);
+							weightSum += code;
+						}
+						packed.Words.push_back(word);
+					}
+				}
+				scales[oc] = l.Quant.InputScale * l.Quant.WeightScales[oc];
+				corrections[oc] = static_cast<float>((128 - static_cast<int32_t>(l.Quant.InputZeroPoint)) * weightSum);
+			}
+			packed.Params.insert(packed.Params.end(), scales.begin(), scales.end());
+			packed.Params.insert(packed.Params.end(), corrections.begin(), corrections.end());
+			packed.Params.insert(packed.Params.end(), l.Bias.begin(), l.Bias.end());
+		}
+		return packed;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Snowstorm/Render/Neural/NeuralWeights.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Snowstorm::Neural
+{
+	// Post-training quantization for .ssnn models. The upscaler's cost on the target GPUs is weight/activation
+	// bandwidth, not math, so the wins are storage: fp16 halves the weight stream, int8 quarters it and lets
+	// the conv use integer dot products over quantized activations.
+	//
+	// Int8 scheme (the one every int8 path implements, see Conv2DInt8Reference):
+	//   - weights: per-output-channel symmetric, scale = max|w| / 127, zero point 0;
+	//   - layer input: asymmetric uint8 over a calibrated [min, max] range widened to contain 0, so the conv's
+	//     zero padding is exact; scale = (max - min) / 255, zero point = round(-min / scale).
+	// The activation ranges come from running the fp32 model over real inputs (ActivationRange below,
+	// driven by the Snowstorm-NeuralQuantize tool over DatasetExportPass tuples).
+
+	// IEEE 754 binary16 conversion (round-to-nearest-even; overflow saturates to inf, NaN stays NaN).
+	uint16_t FloatToHalf(float value);
+	float HalfToFloat(uint16_t half);
+
+	// Round every weight through fp16 and tag the layer Float16 (the values the engine will load).
+	void QuantizeWeightsFloat16(ConvLayer& layer);
+
+	// Per-channel symmetric int8 weights. Fills Quant.QWeights/WeightScales, tags the layer Int8 and rewrites
+	// Weights with the dequantized values, so the in-memory model is exactly what a save + load produces.
+	// The input scale/zero point are set separately (ApplyInputRange).
+	void QuantizeWeightsInt8(ConvLayer& layer);
+
+	// Weights = QWeights * WeightScales[oc] (after loading an Int8 layer).
+	void DequantizeWeights(ConvLayer& layer);
+
+	// Observed value range of one layer's input across the calibration set.
+	struct ActivationRange
+	{
+		float Min = 0.0f;
+		float Max = 0.0f;
+		bool Valid = false;
+
+		void Observe(std::span<const float> values);
+	};
+
+	// Set the layer's uint8 input quantization from a calibrated range (widened to include 0).
+	void ApplyInputRange(ConvLayer& layer, const ActivationRange& range);
+
+	// Quantize a whole model to int8 with one calibrated range per layer input. `keepEndsFloat16` leaves the
+	// first layer (raw HDR color in) and the last (the residual out) at fp16, the usual accuracy trade for SR
+	// nets; the hidden layers carry almost all the weights anyway. False (logged) on a range/layer mismatch.
+	bool QuantizeModelInt8(NeuralModel& model, const std::vector<ActivationRange>& inputRanges, bool keepEndsFloat16);
+
+	// NeuralConv.comp's int8 operands for every Int8 layer of `model`, uploaded as two storage buffers.
+	//   Words:  per layer, per (oc, ic), ceil(k*k / 4) uints of packed signed int8 taps (tap t in byte t % 4 of
+	//           word t / 4, trailing bytes zero) — the dot4 layout.
+	//   Params: per layer, float[outC] output scale (InputScale * WeightScales[oc]), float[outC] zero-point
+	//           correction, float[outC] bias.
+	// The shader feeds activations as signed bytes (q - 128), so each output needs (128 - z) * sum(q_w) added
+	// back to equal sum((q - z) * q_w): that is the correction term. Offsets are per layer (0 for non-Int8).
+	struct Int8GpuWeights
+	{
+		std::vector<uint32_t> Words;
+		std::vector<float> Params;
+		std::vector<uint32_t> WordOffsets;
+		std::vector<uint32_t> ParamOffsets;
+	};
+	Int8GpuWeights PackInt8ForGpu(const NeuralModel& model);
+
+	// uints per (oc, ic) in Int8GpuWeights::Words for a kernel size.
+	inline uint32_t Int8WordsPerInputChannel(const uint32_t kernelSize)
+	{
+		return (kernelSize * kernelSize + 3) / 4;
+	}
+}
@@ -1,7 +1,9 @@
 #include "NeuralWeights.hpp"
 
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/Neural/NeuralQuantization.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 
@@ -10,7 +12,8 @@ namespace Snowstorm::Neural
 	namespace
 	{
 		constexpr char kMagic[4] = {'S', 'S', 'N', 'N'};
-		constexpr uint32_t kVersion = 1;
+		constexpr uint32_t kVersionFloat = 1;     // every layer fp32 (the training pipeline's format)
+		constexpr uint32_t kVersionQuantized = 2; // per-layer WeightStorage
 
 		size_t LayerWeightCount(const ConvLayer& l)
 		{
@@ -29,6 +32,96 @@ namespace Snowstorm::Neural
 			f.read(reinterpret_cast<char*>(&v), sizeof(T));
 			return static_cast<bool>(f);
 		}
+
+		template <typename T>
+		void WriteArray(std::ofstream& f, const std::vector<T>& v)
+		{
+			f.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+		}
+
+		template <typename T>
+		bool ReadArray(std::ifstream& f, std::vector<T>& v, const size_t count)
+		{
+			v.resize(count);
+			f.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(count * sizeof(T)));
+			return static_cast<bool>(f);
+		}
+
+		// Version-2 weight block for one layer (the header is already written).
+		void WriteQuantizedWeights(std::ofstream& f, const ConvLayer& l)
+		{
+			switch (l.Quant.Storage)
+			{
+			case WeightStorage::Float16:
+			{
+				std::vector<uint16_t> half(l.Weights.size());
+				for (size_t i = 0; i < half.size(); ++i)
+				{
+					half[i] = FloatToHalf(l.Weights[i]);
+				}
+				WriteArray(f, half);
+				break;
+			}
+			case WeightStorage::Int8:
+				WriteArray(f, l.Quant.QWeights);
+				WriteArray(f, l.Quant.WeightScales);
+				WritePod(f, l.Quant.InputScale);
+				WritePod(f, l.Quant.InputZeroPoint);
+				break;
+			case WeightStorage::Float32:
+				WriteArray(f, l.Weights);
+				break;
+			}
+			WriteArray(f, l.Bias);
+		}
+
+		bool ReadQuantizedWeights(std::ifstream& f, ConvLayer& l, const uint32_t storage)
+		{
+			const size_t count = LayerWeightCount(l);
+			switch (static_cast<WeightStorage>(storage))
+			{
+			case WeightStorage::Float32:
+				l.Quant.Storage = WeightStorage::Float32;
+				if (!ReadArray(f, l.Weights, count))
+				{
+					return false;
+				}
+				break;
+			case WeightStorage::Float16:
+			{
+				l.Quant.Storage = WeightStorage::Float16;
+				std::vector<uint16_t> half;
+				if (!ReadArray(f, half, count))
+				{
+					return false;
+				}
+				l.Weights.resize(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					l.Weights[i] = HalfToFloat(half[i]);
+				}
+				break;
+			}
+			case WeightStorage::Int8:
+			{
+				l.Quant.Storage = WeightStorage::Int8;
+				if (!ReadArray(f, l.Quant.QWeights, count) || !ReadArray(f, l.Quant.WeightScales, l.OutChannels) ||
+				    !ReadPod(f, l.Quant.InputScale) || !ReadPod(f, l.Quant.InputZeroPoint))
+				{
+					return false;
+				}
+				if (!(l.Quant.InputScale > 0.0f) || l.Quant.InputZeroPoint > 255)
+				{
+					return false;
+				}
+				DequantizeWeights(l);
+				break;
+			}
+			default:
+				return false;
+			}
+			return ReadArray(f, l.Bias, l.OutChannels);
+		}
 	}
 
 	size_t NeuralModel::TotalFloats() const
@@ -104,8 +197,11 @@ namespace Snowstorm::Neural
 			return false;
 		}
 
+		const bool quantized = std::ranges::any_of(model.Layers, [](const ConvLayer& l)
+		                                           { return l.Quant.Storage != WeightStorage::Float32; });
+
 		f.write(kMagic, 4);
-		WritePod(f, kVersion);
+		WritePod(f, quantized ? kVersionQuantized : kVersionFloat);
 		WritePod(f, static_cast<uint32_t>(model.Layers.size()));
 		for (const ConvLayer& l : model.Layers)
 		{
@@ -113,10 +209,14 @@ namespace Snowstorm::Neural
 			WritePod(f, l.OutChannels);
 			WritePod(f, l.KernelSize);
 			WritePod(f, static_cast<uint32_t>(l.Act));
-			f.write(reinterpret_cast<const char*>(l.Weights.data()),
-			        static_cast<std::streamsize>(l.Weights.size() * sizeof(float)));
-			f.write(reinterpret_cast<const char*>(l.Bias.data()),
-			        static_cast<std::streamsize>(l.Bias.size() * sizeof(float)));
+			if (quantized)
+			{
+				WritePod(f, static_cast<uint32_t>(l.Quant.Storage));
+				WriteQuantizedWeights(f, l);
+				continue;
+			}
+			WriteArray(f, l.Weights);
+			WriteArray(f, l.Bias);
 		}
 		return static_cast<bool>(f);
 	}
@@ -138,7 +238,7 @@ namespace Snowstorm::Neural
 			return false;
 		}
 		uint32_t version = 0, layerCount = 0;
-		if (!ReadPod(f, version) || version != kVersion)
+		if (!ReadPod(f, version) || (version != kVersionFloat && version != kVersionQuantized))
 		{
 			SS_CORE_ERROR("LoadModel: '{}' unsupported version {}", path, version);
 			return false;
@@ -166,13 +266,15 @@ namespace Snowstorm::Neural
 				SS_CORE_ERROR("LoadModel: '{}' invalid layer {} dims", path, i);
 				return false;
 			}
-			l.Weights.resize(LayerWeightCount(l));
-			l.Bias.resize(l.OutChannels);
-			f.read(reinterpret_cast<char*>(l.Weights.data()), static_cast<std::streamsize>(l.Weights.size() * sizeof(float)));
-			f.read(reinterpret_cast<char*>(l.Bias.data()), static_cast<std::streamsize>(l.Bias.size() * sizeof(float)));
-			if (!f)
+			uint32_t storage = static_cast<uint32_t>(WeightStorage::Float32);
+			if (version == kVersionQuantized && !ReadPod(f, storage))
+			{
+				SS_CORE_ERROR("LoadModel: '{}' truncated at layer {} header", path, i);
+				return false;
+			}
+			if (!ReadQuantizedWeights(f, l, storage))
 			{
-				SS_CORE_ERROR("LoadModel: '{}' truncated at layer {} data", path, i);
+				SS_CORE_ERROR("LoadModel: '{}' truncated or invalid at layer {} data", path, i);
 				return false;
 			}
 			out.Layers.push_back(std::move(l));
@@ -21,6 +21,15 @@ namespace Snowstorm::Neural
 	//              float[outC*inC*k*k] weights ([outC][inC][kH][kW]),
 	//              float[outC] bias
 	// Little-endian, tightly packed. Matches Conv2DReference's tensor layout so PyTorch state_dicts export 1:1.
+	//
+	// Version 2 (post-training quantization, written only when some layer is not fp32) adds a per-layer
+	// uint32 storage tag (WeightStorage) after the activation and changes the weight block by storage:
+	//   Float32: float[outC*inC*k*k] weights, float[outC] bias                       (as version 1)
+	//   Float16: uint16[outC*inC*k*k] IEEE half weights, float[outC] bias
+	//   Int8:    int8[outC*inC*k*k] weights, float[outC] per-channel weight scales,
+	//            float input scale, uint32 input zero point, float[outC] bias
+	// Version 1 files still load (every layer Float32), and an all-fp32 model still saves as version 1 so the
+	// training pipeline's reader (Tools/neural/ssnn.py) keeps byte parity.
 	struct NeuralModel
 	{
 		std::vector<ConvLayer> Layers;
@@ -45,7 +54,8 @@ namespace Snowstorm::Neural
 	NeuralModel MakeIdentityRefiner(uint32_t inChannels = 3);
 
 	// Serialize / parse the .ssnn format. SaveModel returns false on I/O error; LoadModel returns false on a
-	// missing file, bad magic, or truncated/inconsistent data (and leaves `out` unspecified).
+	// missing file, bad magic, or truncated/inconsistent data (and leaves `out` unspecified). Quantized layers
+	// load with Weights holding the dequantized values, so every fp32 path can still run them.
 	bool SaveModel(const std::string& path, const NeuralModel& model);
 	bool LoadModel(const std::string& path, NeuralModel& out);
 }
@@ -1,17 +1,14 @@
 #include "DatasetExportPass.hpp"
 
+#include "Snowstorm/Core/Application.hpp"
 #include "Snowstorm/Core/Base.hpp"
-#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Render/Buffer.hpp"
 #include "Snowstorm/Render/CommandContext.hpp"
 #include "Snowstorm/Render/DatasetExport/NpyWriter.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
 
-#include <nlohmann/json.hpp>
-
 #include <cstdint>
-#include <filesystem>
-#include <fstream>
 
 namespace Snowstorm
 {
@@ -31,26 +28,18 @@ namespace Snowstorm
 			return static_cast<size_t>(t->GetWidth()) * t->GetHeight() * kLdrBytesPerPixel;
 		}
 
-		std::string FramePath(const std::string& dir, const uint64_t frame, const char* suffix)
-		{
-			char name[64];
-			std::snprintf(name, sizeof(name), "frame_%06llu_%s.npy", static_cast<unsigned long long>(frame), suffix);
-			return (std::filesystem::path(dir) / name).string();
-		}
-
-		// Write one readback buffer to a .npy with shape (h, w, 4). `dtype` selects Float16 (HDR sources) or
-		// UInt8 (the tonemapped LDR GT). Returns the bare filename for the manifest (paths are relative to the
-		// export dir, so the dataset folder is relocatable).
-		std::string DumpBuffer(const std::string& dir, const uint64_t frame, const char* suffix,
-		                       const Ref<Buffer>& buf, const uint32_t w, const uint32_t h, const NpyDType dtype)
+		// Encode one mapped readback buffer as a (h, w, 4) .npy into a recycled writer buffer. `dtype` selects
+		// Float16 (HDR sources) or UInt8 (the tonemapped LDR GT). The name is the manifest key and filename suffix.
+		DatasetImage EncodeBuffer(DatasetWriter& writer, const char* name, const Ref<Buffer>& buf, const uint32_t w,
+		                          const uint32_t h, const NpyDType dtype)
 		{
 			const uint32_t bpp = (dtype == NpyDType::UInt8) ? kLdrBytesPerPixel : kBytesPerPixel;
 			const size_t bytes = static_cast<size_t>(w) * h * bpp;
+			DatasetImage image{.Name = name, .Width = w, .Height = h, .Channels = kChannels, .DType = dtype, .Npy = writer.AcquireBuffer()};
 			const void* mapped = buf->Map();
-			const std::string full = FramePath(dir, frame, suffix);
-			WriteNpy(full, mapped, bytes, {h, w, kChannels}, dtype);
+			EncodeNpy(image.Npy, mapped, bytes, {h, w, kChannels}, dtype);
 			buf->Unmap();
-			return std::filesystem::path(full).filename().string();
+			return image;
 		}
 	}
 
@@ -82,7 +71,7 @@ namespace Snowstorm
 		ensure(m_GtLdrBuffers[slot], gtLdrBytes, "DatasetExportGTLdr");
 	}
 
-	void DatasetExportPass::SerializeSlot(const uint32_t slot, const std::string& outputDir)
+	void DatasetExportPass::SerializeSlot(const uint32_t slot)
 	{
 		SlotMeta& m = m_Slots[slot];
 		if (!m.Pending)
@@ -90,57 +79,31 @@ namespace Snowstorm
 			return;
 		}
 
-		const std::string lrFile = DumpBuffer(outputDir, m.GlobalFrame, "lr", m_LrBuffers[slot], m.LrW, m.LrH, NpyDType::Float16);
-		const std::string mvFile = DumpBuffer(outputDir, m.GlobalFrame, "mv", m_MvBuffers[slot], m.MvW, m.MvH, NpyDType::Float16);
-		const std::string gtFile = DumpBuffer(outputDir, m.GlobalFrame, "gt", m_GtBuffers[slot], m.GtW, m.GtH, NpyDType::Float16);
-		const std::string gtLdrFile = DumpBuffer(outputDir, m.GlobalFrame, "gt_ldr", m_GtLdrBuffers[slot], m.GtLdrW, m.GtLdrH, NpyDType::UInt8);
-
-		// Append this frame to the manifest. The manifest is rewritten whole each frame (cheap for hundreds of
-		// frames) so an interrupted run still leaves a valid, loadable JSON for everything captured so far.
-		nlohmann::json entry;
-		entry["frame"] = m.GlobalFrame;
-		entry["jitter_ndc"] = {m.JitterNdc.x, m.JitterNdc.y};
-		entry["scale"] = m.Scale;
-		entry["lr"] = {{"file", lrFile}, {"w", m.LrW}, {"h", m.LrH}, {"c", kChannels}, {"dtype", "float16"}};
-		entry["mv"] = {{"file", mvFile}, {"w", m.MvW}, {"h", m.MvH}, {"c", kChannels}, {"dtype", "float16"}};
-		entry["gt"] = {{"file", gtFile}, {"w", m.GtW}, {"h", m.GtH}, {"c", kChannels}, {"dtype", "float16"}};
+		DatasetFrame frame;
+		frame.Index = m.GlobalFrame;
+		frame.JitterNdc = {m.JitterNdc.x, m.JitterNdc.y};
+		frame.Scale = m.Scale;
+		frame.Images.reserve(4);
+		frame.Images.push_back(EncodeBuffer(*m_Writer, "lr", m_LrBuffers[slot], m.LrW, m.LrH, NpyDType::Float16));
+		frame.Images.push_back(EncodeBuffer(*m_Writer, "mv", m_MvBuffers[slot], m.MvW, m.MvH, NpyDType::Float16));
+		frame.Images.push_back(EncodeBuffer(*m_Writer, "gt", m_GtBuffers[slot], m.GtW, m.GtH, NpyDType::Float16));
 		// The engine's ACTUAL tonemapped LDR present (sRGB bytes) — the exact target to train against (#102).
-		entry["gt_ldr"] = {{"file", gtLdrFile}, {"w", m.GtLdrW}, {"h", m.GtLdrH}, {"c", kChannels}, {"dtype", "uint8"}};
-
-		nlohmann::json manifest;
-		{
-			std::ifstream in(m_ManifestPath);
-			if (in)
-			{
-				try
-				{
-					in >> manifest;
-				}
-				catch (...)
-				{
-					manifest = nlohmann::json::object();
-				}
-			}
-		}
-		if (!manifest.contains("frames") || !manifest["frames"].is_array())
-		{
-			manifest["frames"] = nlohmann::json::array();
-			manifest["format"] = "snowstorm-sr-dataset-v1";
-		}
-		manifest["frames"].push_back(entry);
-
-		std::ofstream out(m_ManifestPath, std::ios::trunc);
-		out << manifest.dump(1, '\t');
+		frame.Images.push_back(EncodeBuffer(*m_Writer, "gt_ldr", m_GtLdrBuffers[slot], m.GtLdrW, m.GtLdrH, NpyDType::UInt8));
+		m_Writer->Submit(std::move(frame));
 
 		m.Pending = false;
-		++m_FramesWritten;
+	}
+
+	DatasetExportStats DatasetExportPass::ExportStats() const
+	{
+		return m_Writer ? m_Writer->GetStats() : DatasetExportStats{};
 	}
 
 	uint64_t DatasetExportPass::CaptureAndSerialize(const Ref<CommandContext>& ctx, const Inputs& in, const std::string& outputDir)
 	{
 		if (!ctx || !in.Lr || !in.Mv || !in.Gt || !in.GtLdr)
 		{
-			return m_FramesWritten;
+			return FramesWritten();
 		}
 
 		// Warmup: skip the first N frames of the capture entirely (no copy, no serialize, no dir/manifest). The
@@ -149,28 +112,31 @@ namespace Snowstorm
 		// frames are all steady-state and same-size; the on-disk index (m_GlobalFrame) still starts at 0.
 		if (m_ExportCalls++ < in.Warmup)
 		{
-			return m_FramesWritten;
+			return FramesWritten();
 		}
 
-		if (!m_ManifestInit)
+		if (!m_Writer)
+		{
+			m_Writer = CreateScope<DatasetWriter>(&Application::Get().GetServiceManager().GetService<JobSystem>());
+		}
+		if (!m_Writer->IsOpen())
 		{
-			std::error_code ec;
-			std::filesystem::create_directories(outputDir, ec);
-			if (ec)
+			const DatasetWriterConfig config{.OutputDir = outputDir,
+			                                 .FramesPerShard = in.FramesPerShard,
+			                                 .Compression = in.Compression,
+			                                 .MaxQueuedFrames = in.QueueDepth};
+			if (!m_Writer->Open(config))
 			{
-				SS_CORE_ERROR("DatasetExport: cannot create output dir '{}': {}", outputDir, ec.message());
-				return m_FramesWritten;
+				return FramesWritten();
 			}
-			m_ManifestPath = (std::filesystem::path(outputDir) / "manifest.json").string();
-			m_ManifestInit = true;
 		}
 
 		const uint32_t slot = in.FrameIndex;
 		EnsureCapacity(slot, ImageBytes(in.Lr), ImageBytes(in.Mv), ImageBytes(in.Gt), LdrImageBytes(in.GtLdr));
 
 		// 1-frame-lag: this slot's previous tuple (written `frames` frames ago) is now GPU-retired and readable.
-		// Serialize it BEFORE overwriting the slot's buffers with this frame's copies.
-		SerializeSlot(slot, outputDir);
+		// Copy it out to the writer BEFORE overwriting the slot's buffers with this frame's copies.
+		SerializeSlot(slot);
 
 		// Record this frame's four readback copies into the command stream.
 		ctx->CopyTextureToBuffer(in.Lr, m_LrBuffers[slot]);
@@ -192,6 +158,6 @@ namespace Snowstorm
 		m.Scale = in.Scale;
 		m.GlobalFrame = m_GlobalFrame++;
 
-		return m_FramesWritten;
+		return FramesWritten();
 	}
 }
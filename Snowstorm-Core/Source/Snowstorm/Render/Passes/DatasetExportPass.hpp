@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Snowstorm/Core/Base.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetWriter.hpp"
 #include "Snowstorm/Render/Texture.hpp"
 
 #include <glm/glm.hpp>
@@ -21,9 +22,12 @@ namespace Snowstorm
 	//
 	// Each source image is copied to a host-visible readback buffer via CommandContext::CopyTextureToBuffer
 	// (mirroring MetricsPass's per-frame-in-flight + 1-frame-lag scheme so the CPU never races the GPU: the copy
-	// is recorded this frame, and the slot written `frames` frames ago is mapped + serialized now). Buffers are
-	// written as .npy (RGBA16F -> '<f2'); a manifest.json indexes every frame with its jitter, scale, and file
-	// paths. Serialization is synchronous on the main thread — offline data-gen tolerates the stall.
+	// is recorded this frame, and the slot written `frames` frames ago is mapped + encoded now). The main thread
+	// only encodes each mapped readback into an in-memory .npy (RGBA16F -> '<f2', a memcpy behind a header) and
+	// hands the tuple to a DatasetWriter, which compresses and writes it on the JobSystem — loose files or tar
+	// shards, with a manifest.json indexing every frame's jitter, scale and location. The writer's queue is
+	// bounded, so a disk slower than the frame rate throttles capture (a visible stall count) instead of
+	// growing memory; rendering itself never waits on a write.
 	class DatasetExportPass final
 	{
 	public:
@@ -47,19 +51,27 @@ namespace Snowstorm
 			// which would pollute the dataset with blank/wrong-size tuples. Skip N so every written frame is
 			// steady-state and same-size (the on-disk index still starts at 0). Mirrors profile.capture_delay.
 			uint32_t Warmup = 0;
+			// Writer layout (dataset.export.shard / .compression / .queue), applied when the export dir is first
+			// opened; changing them mid-run takes effect on the next run.
+			uint32_t FramesPerShard = 0;
+			DatasetCompression Compression = DatasetCompression::None;
+			uint32_t QueueDepth = 8;
 		};
 
-		// Record the three readback copies for this frame, and serialize the previous occupant of this slot (if
-		// any) to disk. `outputDir` is created if missing; the manifest is rewritten there each serialized frame.
-		// Returns the running count of frames written to disk so a caller can stop after N.
+		// Record the readback copies for this frame, and queue the previous occupant of this slot (if any) for
+		// writing. `outputDir` is created if missing. Returns the running count of frames on disk so a caller can
+		// stop after N.
 		uint64_t CaptureAndSerialize(const Ref<CommandContext>& ctx, const Inputs& in, const std::string& outputDir);
 
 		// Number of complete tuples written to disk so far (across the pass's lifetime).
-		[[nodiscard]] uint64_t FramesWritten() const { return m_FramesWritten; }
+		[[nodiscard]] uint64_t FramesWritten() const { return ExportStats().FramesWritten; }
+
+		// Writer progress + backpressure for the stats overlay (zeroed until the first capture).
+		[[nodiscard]] DatasetExportStats ExportStats() const;
 
 	private:
 		void EnsureCapacity(uint32_t slot, size_t lrBytes, size_t mvBytes, size_t gtBytes, size_t gtLdrBytes);
-		void SerializeSlot(uint32_t slot, const std::string& outputDir);
+		void SerializeSlot(uint32_t slot);
 
 		struct SlotMeta
 		{
@@ -81,10 +93,8 @@ namespace Snowstorm
 		std::vector<Ref<Buffer>> m_GtLdrBuffers; // RGBA8 (uint8) tonemapped GT
 		std::vector<SlotMeta> m_Slots;
 
-		uint64_t m_GlobalFrame = 0;   // ++ each captured frame; used as the on-disk index
-		uint64_t m_FramesWritten = 0; // ++ each serialized frame
-		uint64_t m_ExportCalls = 0;   // ++ each CaptureAndSerialize call; the first `Warmup` are skipped
-		bool m_ManifestInit = false;  // manifest.json header written / dir prepared
-		std::string m_ManifestPath;
+		uint64_t m_GlobalFrame = 0; // ++ each captured frame; used as the on-disk index
+		uint64_t m_ExportCalls = 0; // ++ each CaptureAndSerialize call; the first `Warmup` are skipped
+		Scope<DatasetWriter> m_Writer; // created (and its dir opened) on the first captured frame
 	};
 }
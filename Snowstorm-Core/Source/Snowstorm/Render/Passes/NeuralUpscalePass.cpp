@@ -6,6 +6,7 @@
 #include "Snowstorm/Render/Buffer.hpp"
 #include "Snowstorm/Render/CommandContext.hpp"
 #include "Snowstorm/Render/DescriptorSet.hpp"
+#include "Snowstorm/Render/Neural/NeuralQuantization.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
 #include "Snowstorm/Render/RendererUtils.hpp"
 #include "Snowstorm/Render/Sampler.hpp"
@@ -20,7 +21,7 @@ namespace Snowstorm
 {
 	namespace
 	{
-		// Params UBOs. Layout must match the cbuffers in the three shaders.
+		// Params UBOs. Layout must match the cbuffers in the shaders.
 		struct ConvCB
 		{
 			glm::uvec2 Size{0, 0};
@@ -30,12 +31,28 @@ namespace Snowstorm
 			uint32_t Activation = 0;
 			uint32_t WeightOffset = 0; // global float index where THIS layer's weights begin
 			uint32_t BiasOffset = 0;   // global float index where this layer's bias begins
+			uint32_t QuantMode = 0;     // 1 = int8 layer (QWeights/QParams)
+			float InputScaleInv = 0.0f;
+			uint32_t InputZeroPoint = 0;
+			uint32_t QWeightOffset = 0; // uint index into QWeights
+			uint32_t QParamOffset = 0;  // float index into QParams
+			uint32_t _Pad[3] = {};
 		};
+		static_assert(sizeof(ConvCB) == 64, "ConvCB must match the NeuralConv.comp.hlsl cbuffer");
 		struct SizeCB
 		{
 			glm::uvec2 OutSize{0, 0};
 			glm::uvec2 _Pad{0, 0};
 		};
+		struct FusedCB
+		{
+			glm::uvec2 Size{0, 0};
+			uint32_t LayerCount = 0;
+			uint32_t Halo = 0;
+			glm::uvec4 LayerShape[Neural::kFusedMaxLayers]{};  // InChannels, OutChannels, KernelSize, Activation
+			glm::uvec4 LayerOffset[Neural::kFusedMaxLayers]{}; // WeightOffset, BiasOffset, unused x2
+		};
+		static_assert(sizeof(FusedCB) == 16 + 32 * Neural::kFusedMaxLayers, "FusedCB must match NeuralConvFused.comp.hlsl");
 		struct WarpCB
 		{
 			glm::uvec2 OutSize{0, 0};
@@ -82,12 +99,13 @@ namespace Snowstorm
 		const Ref<Shader> warpCs = shaderLib.Load("Engine/Shaders/NeuralWarpHistory.comp.hlsl");
 		const Ref<Shader> convCs = shaderLib.Load("Engine/Shaders/NeuralConv.comp.hlsl");
 		const Ref<Shader> addCs = shaderLib.Load("Engine/Shaders/NeuralResidualAdd.comp.hlsl");
-		if (!upCs || !warpCs || !convCs || !addCs)
+		const Ref<Shader> fusedCs = shaderLib.Load("Engine/Shaders/NeuralConvFused.comp.hlsl");
+		if (!upCs || !warpCs || !convCs || !addCs || !fusedCs)
 		{
 			SS_CORE_ERROR("[Neural] failed to load upscaler compute shaders");
 			return;
 		}
-		if (!upCs->IsReady() || !warpCs->IsReady() || !convCs->IsReady() || !addCs->IsReady())
+		if (!upCs->IsReady() || !warpCs->IsReady() || !convCs->IsReady() || !addCs->IsReady() || !fusedCs->IsReady())
 		{
 			return; // async compile; retry next frame
 		}
@@ -104,6 +122,7 @@ namespace Snowstorm
 		m_WarpPipeline = makePipe(warpCs, "NeuralWarpHistoryPipeline");
 		m_ConvPipeline = makePipe(convCs, "NeuralConvPipeline");
 		m_AddPipeline = makePipe(addCs, "NeuralResidualAddPipeline");
+		m_FusedPipeline = makePipe(fusedCs, "NeuralConvFusedPipeline");
 
 		SamplerDesc sd{};
 		sd.MinFilter = Filter::Linear;
@@ -198,6 +217,43 @@ namespace Snowstorm
 			}
 		}
 
+		// Int8 layers (a quantized .ssnn v2): the tiled fp16 conv runs them on packed int8 taps. The fp32 naive
+		// path has no int8 branch and just uses the dequantized weights already in m_Weights. Bindings 4/5 are
+		// always bound, so a model without int8 layers gets 4-byte placeholders.
+		m_Int8Layers.assign(m_Model.Layers.size(), false);
+		Neural::Int8GpuWeights int8;
+		if (m_Fp16Weights)
+		{
+			int8 = Neural::PackInt8ForGpu(m_Model);
+			for (size_t i = 0; i < m_Model.Layers.size(); ++i)
+			{
+				m_Int8Layers[i] = m_Model.Layers[i].Quant.Storage == Neural::WeightStorage::Int8;
+			}
+		}
+		m_QWeightOffsets = std::move(int8.WordOffsets);
+		m_QParamOffsets = std::move(int8.ParamOffsets);
+		const uint32_t zeroWord = 0;
+		m_QWeights = int8.Words.empty()
+			             ? Buffer::Create(sizeof(uint32_t), BufferUsage::Storage, &zeroWord, false, "NeuralQWeights")
+			             : Buffer::Create(int8.Words.size() * sizeof(uint32_t), BufferUsage::Storage, int8.Words.data(), false, "NeuralQWeights");
+		m_QParams = int8.Params.empty()
+			            ? Buffer::Create(sizeof(uint32_t), BufferUsage::Storage, &zeroWord, false, "NeuralQParams")
+			            : Buffer::Create(int8.Params.size() * sizeof(float), BufferUsage::Storage, int8.Params.data(), false, "NeuralQParams");
+
+		// Fused or per-layer, decided from the layer list. Fused, the hidden activations live in groupshared
+		// memory, so the feature buffers shrink to the input stack and the A/B ping-pong pair goes away.
+		m_FusedPlan = Neural::PlanFusedConv(m_Model);
+		if (m_FusedPlan.Fusable)
+		{
+			m_MaxChannels = inChannels;
+			SS_CORE_INFO("[Neural] {} layer(s) fused into one dispatch (halo {}, {} LDS floats per plane)",
+			             m_Model.Layers.size(), m_FusedPlan.Halo, m_FusedPlan.PeakPlaneFloats);
+		}
+		else
+		{
+			SS_CORE_INFO("[Neural] {} layer(s) run per-layer: {}", m_Model.Layers.size(), m_FusedPlan.Reason);
+		}
+
 		m_Width = 0; // force feature-buffer reallocation (channel count may have changed)
 	}
 
@@ -238,8 +294,16 @@ namespace Snowstorm
 		for (uint32_t i = 0; i < frames; ++i)
 		{
 			m_FeatureBase[i] = Buffer::Create(featureBytes, BufferUsage::Storage, nullptr, false, "NeuralFeatureBase");
-			m_FeatureA[i] = Buffer::Create(featureBytes, BufferUsage::Storage, nullptr, false, "NeuralFeatureA");
-			m_FeatureB[i] = Buffer::Create(featureBytes, BufferUsage::Storage, nullptr, false, "NeuralFeatureB");
+			if (m_FusedPlan.Fusable)
+			{
+				m_FeatureA[i] = nullptr;
+				m_FeatureB[i] = nullptr;
+			}
+			else
+			{
+				m_FeatureA[i] = Buffer::Create(featureBytes, BufferUsage::Storage, nullptr, false, "NeuralFeatureA");
+				m_FeatureB[i] = Buffer::Create(featureBytes, BufferUsage::Storage, nullptr, false, "NeuralFeatureB");
+			}
 
 			TextureDesc od{};
 			od.Dimension = TextureDimension::Texture2D;
@@ -373,6 +437,42 @@ namespace Snowstorm
 			keepBufs.push_back(ubo);
 		}
 
+		// ---- Fused: conv stack + residual add in one dispatch straight from the base into the output. ----
+		if (m_FusedPlan.Fusable)
+		{
+			ctx->BarrierComputeStorage(); // upsample/warp wrote the base
+			ctx->TransitionToStorage(output);
+
+			FusedCB cb{};
+			cb.Size = outSize;
+			cb.LayerCount = static_cast<uint32_t>(m_Model.Layers.size());
+			cb.Halo = m_FusedPlan.Halo;
+			for (size_t i = 0; i < m_Model.Layers.size(); ++i)
+			{
+				const Neural::ConvLayer& l = m_Model.Layers[i];
+				const size_t weightCount = static_cast<size_t>(l.OutChannels) * l.InChannels * l.KernelSize * l.KernelSize;
+				cb.LayerShape[i] = {l.InChannels, l.OutChannels, l.KernelSize, static_cast<uint32_t>(l.Act)};
+				cb.LayerOffset[i] = {static_cast<uint32_t>(m_LayerOffsets[i]), static_cast<uint32_t>(m_LayerOffsets[i] + weightCount), 0u, 0u};
+			}
+			const Ref<Buffer> ubo = Buffer::Create(sizeof(FusedCB), BufferUsage::Uniform, &cb, true, "NeuralFusedCB");
+
+			const Ref<DescriptorSet> set = DescriptorSet::Create(layoutFor(m_FusedPipeline), {});
+			set->SetBuffer(0, {.Buffer = featBase, .Offset = 0, .Range = featureBytes});
+			set->SetBuffer(1, {.Buffer = m_Weights, .Offset = 0, .Range = m_Weights->GetSize()});
+			set->SetTexture(2, outputView);
+			set->SetBuffer(3, {.Buffer = ubo, .Offset = 0, .Range = sizeof(FusedCB)});
+			set->Commit();
+
+			ctx->BindPipeline(m_FusedPipeline);
+			ctx->BindDescriptorSet(set, 0);
+			ctx->Dispatch(gx, gy, 1);
+
+			keepSets.push_back(set);
+			keepBufs.push_back(ubo);
+			ctx->TransitionToSampled(output); // as after the residual add below
+			return;
+		}
+
 		// ---- Stage 2: conv stack. Layer 0 reads the base; later layers ping-pong A<->B. The base buffer stays
 		// untouched for the residual add. `cur` is the input to the next layer, `next` its output.
 		ctx->BindPipeline(m_ConvPipeline);
@@ -398,6 +498,14 @@ namespace Snowstorm
 			const size_t weightCount = static_cast<size_t>(l.OutChannels) * l.InChannels * l.KernelSize * l.KernelSize;
 			cb.WeightOffset = static_cast<uint32_t>(m_LayerOffsets[i]);
 			cb.BiasOffset = static_cast<uint32_t>(m_LayerOffsets[i] + weightCount);
+			if (i < m_Int8Layers.size() && m_Int8Layers[i])
+			{
+				cb.QuantMode = 1;
+				cb.InputScaleInv = 1.0f / l.Quant.InputScale;
+				cb.InputZeroPoint = l.Quant.InputZeroPoint;
+				cb.QWeightOffset = m_QWeightOffsets[i];
+				cb.QParamOffset = m_QParamOffsets[i];
+			}
 			const Ref<Buffer> ubo = Buffer::Create(sizeof(ConvCB), BufferUsage::Uniform, &cb, true, "NeuralConvCB");
 
 			const Ref<DescriptorSet> set = DescriptorSet::Create(layoutFor(m_ConvPipeline), {});
@@ -405,6 +513,8 @@ namespace Snowstorm
 			set->SetBuffer(1, {.Buffer = m_Weights, .Offset = 0, .Range = m_Weights->GetSize()});
 			set->SetBuffer(2, {.Buffer = next, .Offset = 0, .Range = featureBytes});
 			set->SetBuffer(3, {.Buffer = ubo, .Offset = 0, .Range = sizeof(ConvCB)});
+			set->SetBuffer(4, {.Buffer = m_QWeights, .Offset = 0, .Range = m_QWeights->GetSize()});
+			set->SetBuffer(5, {.Buffer = m_QParams, .Offset = 0, .Range = m_QParams->GetSize()});
 			set->Commit();
 
 			ctx->BindDescriptorSet(set, 0);
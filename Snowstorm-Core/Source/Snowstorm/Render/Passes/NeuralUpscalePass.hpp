@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Snowstorm/Core/Base.hpp"
+#include "Snowstorm/Render/Neural/NeuralFusedConv.hpp"
 #include "Snowstorm/Render/Neural/NeuralWeights.hpp"
 #include "Snowstorm/Render/Pipeline.hpp"
 #include "Snowstorm/Render/Texture.hpp"
@@ -26,6 +27,11 @@ namespace Snowstorm
 	// Default weights are the code-defined identity refiner (zero output layer -> residual 0 -> output ==
 	// bilinear), so the untrained pass is a provable no-op that validates the whole chain. A trained .ssnn set
 	// via SetWeightsPath overrides it.
+	//
+	// Models small enough for groupshared memory (Neural::PlanFusedConv: the default refiners and most trained
+	// ones) skip the per-layer chain entirely: NeuralConvFused runs the whole stack per tile and writes the
+	// output directly, so no hidden activation ever touches VRAM. The choice is made from the layer list when
+	// the model loads; wider / deeper / int8 models keep the per-layer dispatches.
 	class NeuralUpscalePass final
 	{
 	public:
@@ -78,11 +84,12 @@ namespace Snowstorm
 		void EnsureSizedResources(uint32_t w, uint32_t h);
 
 		// Compute pipelines: input bilinear-upsample, the optional temporal history-warp, the generic per-layer
-		// conv, the residual-add output.
+		// conv, the residual-add output, and the fused whole-stack conv (conv + add in one dispatch).
 		Ref<Pipeline> m_UpsamplePipeline;
 		Ref<Pipeline> m_WarpPipeline;
 		Ref<Pipeline> m_ConvPipeline;
 		Ref<Pipeline> m_AddPipeline;
+		Ref<Pipeline> m_FusedPipeline;
 		Ref<Sampler> m_LinearClamp;
 
 		// Temporal (#98) vs spatial (#47) inference. Selects the identity model's input width and whether Infer
@@ -96,6 +103,15 @@ namespace Snowstorm
 		std::string m_WeightsPath; // empty => identity refiner
 		bool m_ModelDirty = true;
 		bool m_Fp16Weights = false; // m_Weights packed fp16 (device supports it) -> conv takes the SS_FP16 path
+		Neural::FusedConvPlan m_FusedPlan; // Fusable -> Infer runs NeuralConvFused instead of the per-layer chain
+
+		// Int8 operands for quantized layers (NeuralQuantization.hpp PackInt8ForGpu) and, per layer, whether
+		// the conv runs it on them (fp16 devices only) plus its offsets into the two buffers.
+		Ref<Buffer> m_QWeights;
+		Ref<Buffer> m_QParams;
+		std::vector<bool> m_Int8Layers;
+		std::vector<uint32_t> m_QWeightOffsets;
+		std::vector<uint32_t> m_QParamOffsets;
 
 		// Feature maps as flat CHW float storage buffers (maxChannels*W*H each). Buffers (not texture arrays)
 		// because that's the CPU reference's layout and the engine has no 2D-array texture views; chained conv
@@ -104,6 +120,7 @@ namespace Snowstorm
 		// output texture. ALL per-frame-in-flight: two frames overlap on the GPU (BarrierComputeStorage only
 		// orders within one command buffer), so a single shared set would let frame N+1's upsample clobber
 		// frame N's data mid-flight — a nondeterministic race. One slot per in-flight frame, like MetricsPass.
+		// On the fused path only Base exists (input width only) — A/B are never allocated.
 		std::vector<Ref<Buffer>> m_FeatureBase;
 		std::vector<Ref<Buffer>> m_FeatureA;
 		std::vector<Ref<Buffer>> m_FeatureB;
@@ -111,7 +128,7 @@ namespace Snowstorm
 		std::vector<Ref<TextureView>> m_OutputView;
 		uint32_t m_Width = 0;
 		uint32_t m_Height = 0;
-		uint32_t m_MaxChannels = 0; // widest layer's channel count (sizes the feature buffers)
+		uint32_t m_MaxChannels = 0; // widest layer's channel count (sizes the feature buffers; input width if fused)
 
 		// Transient per-dispatch descriptor sets / UBOs, ring-buffered by frame-in-flight index. Each Infer
 		// allocates fresh sets+UBOs; they must stay alive until the GPU finishes that frame, so we keep one
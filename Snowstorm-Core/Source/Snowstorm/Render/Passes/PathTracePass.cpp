@@ -151,8 +151,10 @@ namespace Snowstorm
 		cb.ReflGeoTableAddrLo = static_cast<uint32_t>(pr.TableAddress & 0xFFFFFFFFull);
 		cb.ReflGeoTableAddrHi = static_cast<uint32_t>(pr.TableAddress >> 32);
 
-		// Point/spot lights for NEE (raw-packed to match the shader's float4 arrays). The shader caps at 16 each.
-		const uint32_t pc = static_cast<uint32_t>(std::min(lights.PointCount, MAX_POINT_LIGHTS));
+		// Point/spot lights for NEE (raw-packed to match the shader's float4 arrays). The shader caps at 16 each
+		// (MAX_PT_POINT_LIGHTS / MAX_PT_SPOT_LIGHTS), so the reference only sees the first 16 of each buffer.
+		constexpr size_t kMaxNeeLights = 16;
+		const uint32_t pc = static_cast<uint32_t>(std::min(lights.PointLights.size(), kMaxNeeLights));
 		cb.PointCount = pc;
 		for (uint32_t i = 0; i < pc; ++i)
 		{
@@ -160,7 +162,7 @@ namespace Snowstorm
 			cb.PointLights[i * 2u] = glm::vec4(pl.Position, pl.Range);
 			cb.PointLights[i * 2u + 1u] = glm::vec4(pl.Color, pl.Intensity);
 		}
-		const uint32_t sc = static_cast<uint32_t>(std::min(lights.SpotCount, MAX_SPOT_LIGHTS));
+		const uint32_t sc = static_cast<uint32_t>(std::min(lights.SpotLights.size(), kMaxNeeLights));
 		cb.SpotCount = sc;
 		for (uint32_t i = 0; i < sc; ++i)
 		{
@@ -13,10 +13,18 @@
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+
 namespace Snowstorm
 {
 	namespace
 	{
+		// The stochastic pool: the first kMaxPoint / kMaxSpot lights of the (uncapped) light buffers. Mirrors
+		// SHADOW_MAX_POINT / SHADOW_MAX_SPOT in Shadow.comp.hlsl and RT_SHADOW_MAX_*_LIGHTS in Engine.hlsli;
+		// DefaultLit shades lights past them directly instead of through this pass's denoised irradiance.
+		constexpr int kMaxPoint = 16;
+		constexpr int kMaxSpot = 16;
+
 		// Mirrors ShadowCB in Shadow.comp.hlsl field-for-field (std140/cbuffer 16-byte rows). Keep in lockstep
 		// with the shader -- a drift silently corrupts the world-position reconstruction, the importance weights,
 		// or the per-light cast masks. Slim tracer + importance params only (NOT the raster shadow matrices).
@@ -53,11 +61,11 @@ namespace Snowstorm
 			// of that color, computed in the shader.
 			glm::vec4 DirData[MAX_DIRECTIONAL_LIGHTS]{};  // xyz = dir TO light, w unused
 			glm::vec4 DirColor[MAX_DIRECTIONAL_LIGHTS]{}; // xyz = color*intensity (radiance, no attenuation)
-			glm::vec4 PointPosRange[MAX_POINT_LIGHTS]{};  // xyz = pos, w = range
-			glm::vec4 PointColor[MAX_POINT_LIGHTS]{};     // xyz = color*intensity
-			glm::vec4 SpotPosRange[MAX_SPOT_LIGHTS]{};    // xyz = pos, w = range
-			glm::vec4 SpotDirCos[MAX_SPOT_LIGHTS]{};      // xyz = dir, w = cos(outer)
-			glm::vec4 SpotColorInner[MAX_SPOT_LIGHTS]{};  // xyz = color*intensity, w = cos(inner)
+			glm::vec4 PointPosRange[kMaxPoint]{};         // xyz = pos, w = range
+			glm::vec4 PointColor[kMaxPoint]{};            // xyz = color*intensity
+			glm::vec4 SpotPosRange[kMaxSpot]{};           // xyz = pos, w = range
+			glm::vec4 SpotDirCos[kMaxSpot]{};             // xyz = dir, w = cos(outer)
+			glm::vec4 SpotColorInner[kMaxSpot]{};         // xyz = color*intensity, w = cos(inner)
 		};
 
 		// Binding indices in Shadow.comp.hlsl set 0 (same layout as AO.comp.hlsl).
@@ -161,7 +169,7 @@ namespace Snowstorm
 		// Point: casts when ShadowSlot >= 0 (the raster cast sentinel; reused for the RT pool). Non-casters stay
 		// in the importance pool with the cast bit clear (if sampled -> vis 1, no ray) so the aggregate ratio
 		// stays correct. Weight = luma(color) * intensity (attenuation is applied per-pixel in the shader).
-		cb.PointCount = static_cast<uint32_t>(glm::clamp(lights.PointCount, 0, MAX_POINT_LIGHTS));
+		cb.PointCount = static_cast<uint32_t>(std::min(lights.PointLights.size(), static_cast<size_t>(kMaxPoint)));
 		for (uint32_t i = 0; i < cb.PointCount; ++i)
 		{
 			const GPUPointLight& L = lights.PointLights[i];
@@ -174,7 +182,7 @@ namespace Snowstorm
 		}
 
 		// Spot: casts when ShadowIndex >= 0. Cone via cos(inner/outer).
-		cb.SpotCount = static_cast<uint32_t>(glm::clamp(lights.SpotCount, 0, MAX_SPOT_LIGHTS));
+		cb.SpotCount = static_cast<uint32_t>(std::min(lights.SpotLights.size(), static_cast<size_t>(kMaxSpot)));
 		for (uint32_t i = 0; i < cb.SpotCount; ++i)
 		{
 			const GPUSpotLight& L = lights.SpotLights[i];
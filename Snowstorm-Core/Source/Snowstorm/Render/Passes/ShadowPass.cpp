@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <string>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -44,7 +45,7 @@ namespace Snowstorm
 		return true;
 	}
 
-	const Ref<RenderTarget>& ShadowPass::GetOrCreateShadowTarget()
+	const Ref<RenderTarget>& ShadowPass::GetOrCreateCascadeTarget(const uint32_t cascade)
 	{
 		// Resolution is a runtime quality setting (render.shadow.resolution). Clamp to a sane range and
 		// rebuild the target when it changes. GPUs are idle between frames here (single in-flight wait in
@@ -52,12 +53,14 @@ namespace Snowstorm
 		const int requested = std::clamp(CVars::ShadowResolution.Get(), 256, 8192);
 		const auto size = static_cast<uint32_t>(requested);
 
-		if (!m_Target || m_Target->GetWidth() != size)
+		Ref<RenderTarget>& target = m_CascadeTargets[cascade];
+		if (!target || target->GetWidth() != size)
 		{
-			m_Target = CreateShadowDepthTarget(size, "Sun");
-			SS_CORE_ASSERT(m_Target, "Failed to create shadow depth target");
+			const std::string name = "SunCascade" + std::to_string(cascade);
+			target = CreateShadowDepthTarget(size, name.c_str());
+			SS_CORE_ASSERT(target, "Failed to create shadow cascade target");
 		}
-		return m_Target;
+		return target;
 	}
 
 	void ShadowPass::EnsurePipeline(const PixelFormat depthFormat)
@@ -105,7 +108,7 @@ namespace Snowstorm
 		p.ColorFormats = {}; // depth-only: no color attachment
 		p.DepthFormat = depthFormat;
 		// Per-draw light view-projection via a 64-byte vertex-stage push constant (see Shadow.vert.hlsl):
-		// lets one command buffer render many light views (sun + each spot atlas tile), which a single
+		// lets one command buffer render many light views (sun + each atlas tile), which a single
 		// cached FrameCB can't express.
 		p.PushConstants = {{.Offset = 0, .Size = sizeof(glm::mat4), .Stages = ShaderStage::Vertex}};
 		// Render front faces (no special cull) into the shadow map — i.e. store what the light sees
@@ -124,10 +127,15 @@ namespace Snowstorm
 		m_DepthFormat = depthFormat;
 	}
 
-	void ShadowPass::RecordDepth(RendererService& renderer, const PixelFormat depthFormat, const glm::mat4& lightViewProj)
+	bool ShadowPass::RecordDepth(RendererService& renderer, const PixelFormat depthFormat, const glm::mat4& lightViewProj)
 	{
 		EnsurePipeline(depthFormat);
+		if (!m_Pipeline)
+		{
+			return false;
+		}
 		renderer.DrawBatchesDepthOnly(m_Pipeline, lightViewProj);
+		return true;
 	}
 
 	glm::mat4 ShadowPass::ComputeSpotViewProj(const glm::vec3& position, const glm::vec3& direction,
@@ -144,17 +152,16 @@ namespace Snowstorm
 		return proj * view;
 	}
 
-	const Ref<RenderTarget>& ShadowPass::GetOrCreateSpotAtlas()
+	const Ref<RenderTarget>& ShadowPass::GetOrCreateAtlas()
 	{
-		const int requested = std::clamp(CVars::ShadowResolution.Get(), 256, 8192);
-		const auto atlasSize = static_cast<uint32_t>(requested) * kSpotAtlasCols; // grid of tiles
+		const auto atlasSize = static_cast<uint32_t>(CVars::ClampedShadowAtlasSize());
 
-		if (!m_SpotAtlas || m_SpotAtlas->GetWidth() != atlasSize)
+		if (!m_Atlas || m_Atlas->GetWidth() != atlasSize)
 		{
-			m_SpotAtlas = CreateShadowDepthTarget(atlasSize, "SpotAtlas");
-			SS_CORE_ASSERT(m_SpotAtlas, "Failed to create spot shadow atlas");
+			m_Atlas = CreateShadowDepthTarget(atlasSize, "ShadowAtlas", RenderTargetLoadOp::Load);
+			SS_CORE_ASSERT(m_Atlas, "Failed to create shadow atlas");
 		}
-		return m_SpotAtlas;
+		return m_Atlas;
 	}
 
 	glm::mat4 ShadowPass::ComputePointFaceViewProj(const glm::vec3& position, const int face, const float range)
@@ -179,16 +186,4 @@ namespace Snowstorm
 		return proj * view;
 	}
 
-	const Ref<RenderTarget>& ShadowPass::GetOrCreatePointAtlas()
-	{
-		const int requested = std::clamp(CVars::ShadowResolution.Get(), 256, 8192);
-		const auto atlasSize = static_cast<uint32_t>(requested) * kPointAtlasCols; // kPointAtlasCols^2 grid of tiles
-
-		if (!m_PointAtlas || m_PointAtlas->GetWidth() != atlasSize)
-		{
-			m_PointAtlas = CreateShadowDepthTarget(atlasSize, "PointAtlas");
-			SS_CORE_ASSERT(m_PointAtlas, "Failed to create point shadow atlas");
-		}
-		return m_PointAtlas;
-	}
 }
@@ -2,49 +2,55 @@
 
 #include "Snowstorm/Render/Pipeline.hpp"
 #include "Snowstorm/Render/RenderTarget.hpp"
+#include "Snowstorm/Render/ShadowCascades.hpp"
 #include "Snowstorm/Render/Texture.hpp"
 
 #include <glm/glm.hpp>
 
+#include <array>
+
 namespace Snowstorm
 {
 	class RendererService;
 	class World;
 
-	// Directional-sun shadow pass: renders scene depth from the light's POV into a shared depth-only,
-	// sampleable shadow map; the lit pass reprojects + PCF-compares against it. Owns the depth-only
-	// pipeline and the shadow-map target. The ECS caster iteration stays in RenderSystem (like the camera
-	// mesh loop) — this pass owns the feature GPU objects + the two pure helpers (sun matrix, target).
+	// Shadow depth pass: renders scene depth from a light's POV into depth-only, sampleable maps (the sun's
+	// cascades, the shared spot/point atlas); the lit pass reprojects + PCF-compares against them. Owns
+	// the depth-only pipeline and the map targets. The ECS caster iteration stays in ShadowRenderer (like
+	// the camera mesh loop) — this pass owns the feature GPU objects + the pure matrix helpers.
 	class ShadowPass final
 	{
 	public:
-		// Fit an orthographic light frustum to the scene AABB and build the sun's view-projection (world ->
-		// light clip). Returns false if the scene has no renderable bounds yet (caller disables shadows).
-		// Static + pure: RenderSystem needs the matrix BEFORE the graph pass runs, to feed SetShadowData.
+		// Fit an orthographic light frustum to the whole scene AABB and build the sun's view-projection (world
+		// -> light clip). Returns false if the scene has no renderable bounds yet (caller disables shadows).
+		// The rendered sun shadow uses camera-fitted cascades (FitShadowCascades); this whole-scene fit is the
+		// camera-independent one LightingSystem publishes as the SunShadowFit.
 		static bool ComputeSunViewProj(World& world, const glm::vec3& lightDir, glm::mat4& outViewProj);
 
-		// The shared shadow-map render target (lazily created; rebuilt when the resolution CVar changes).
-		// Used as the shadow pass's target and as the source of the depth texture's bindless index.
-		[[nodiscard]] const Ref<RenderTarget>& GetOrCreateShadowTarget();
+		// One sun cascade's render target (lazily created; rebuilt when the resolution CVar changes). Each
+		// cascade is its own texture rather than an atlas tile: the render pass clears its whole target, and
+		// a cached cascade must keep its depth while the nearer ones re-render.
+		[[nodiscard]] const Ref<RenderTarget>& GetOrCreateCascadeTarget(uint32_t cascade);
 
 		// Record the depth-only draw of the renderer's accumulated batches into the bound shadow target,
 		// transforming by `lightViewProj` (pushed as a per-draw push constant, so one command buffer can
-		// render many light views: the sun plus each spot atlas tile). Lazily builds the depth pipeline for
-		// `depthFormat`. Call inside a shadow render pass after the renderer's caster DrawMesh accumulation.
-		void RecordDepth(RendererService& renderer, PixelFormat depthFormat, const glm::mat4& lightViewProj);
+		// render many light views: each cascade and each atlas tile). Lazily builds the depth pipeline
+		// for `depthFormat`; returns false (nothing drawn) while its shader is still compiling. Call inside a
+		// shadow render pass after the renderer's caster DrawMesh accumulation.
+		bool RecordDepth(RendererService& renderer, PixelFormat depthFormat, const glm::mat4& lightViewProj);
 
 		// Build a spot light's perspective world->light-clip matrix (FOV = 2*outer cone half-angle, square
 		// aspect, near..Range). Pure + static so the gather (LightingSystem) can compute it before the pass.
 		static glm::mat4 ComputeSpotViewProj(const glm::vec3& position, const glm::vec3& direction,
 		                                     float outerAngleRad, float range);
 
-		// Lazily create/return the spot shadow ATLAS target: one depth texture holding kSpotAtlasCols x
-		// kSpotAtlasCols tiles, each `render.shadow.resolution` px. Rebuilt when the resolution CVar changes.
-		[[nodiscard]] const Ref<RenderTarget>& GetOrCreateSpotAtlas();
-
-		// Atlas is a square grid of kSpotAtlasCols x kSpotAtlasCols tiles (2x2 => up to 4 shadow-casting spots).
-		static constexpr uint32_t kSpotAtlasCols = 2;
-		static constexpr int kMaxShadowSpots = static_cast<int>(kSpotAtlasCols * kSpotAtlasCols);
+		// Lazily create/return the shadow ATLAS target shared by every spot light and point-light cube face:
+		// one `render.shadow.atlas_size` depth texture, carved into power-of-two tiles by LightingSystem's
+		// ShadowAtlasAllocator (each light's tile rect reaches the shader in its GPU payload). Rebuilt when the
+		// atlas size changes. Loaded, not cleared, on BeginRenderPass: a pass re-renders only the tiles whose
+		// light or casters changed (ShadowTileCache) and clears each of those itself, so the others keep last
+		// frame's depth.
+		[[nodiscard]] const Ref<RenderTarget>& GetOrCreateAtlas();
 
 		// Build one of a point light's 6 cube-face perspective view-projections (world -> that face's light
 		// clip). `face` is 0..5 in the order +X,-X,+Y,-Y,+Z,-Z. Each face is a 90-degree FOV, square-aspect
@@ -52,27 +58,16 @@ namespace Snowstorm
 		// static so LightingSystem can compute all six before the graph pass runs (mirrors ComputeSpotViewProj).
 		static glm::mat4 ComputePointFaceViewProj(const glm::vec3& position, int face, float range);
 
-		// Lazily create/return the point shadow ATLAS target: kPointAtlasCols x kPointAtlasCols tiles, each
-		// `render.shadow.resolution` px. Sized to hold kMaxShadowPoints * 6 faces (4x4 = 16 >= 2*6). Rebuilt
-		// when the resolution CVar changes. Separate from the spot atlas so the two tile layouts don't mix.
-		[[nodiscard]] const Ref<RenderTarget>& GetOrCreatePointAtlas();
-
-		// Point atlas is a kPointAtlasCols^2 grid; 4x4 = 16 tiles holds MAX_SHADOW_POINTS(=2) x 6 faces = 12.
-		static constexpr uint32_t kPointAtlasCols = 4;
-
 	private:
 		void EnsurePipeline(PixelFormat depthFormat);
 
 		Ref<Pipeline> m_Pipeline;
 		PixelFormat m_DepthFormat = PixelFormat::Unknown;
 
-		// Shared shadow-map target (depth-only, sampleable). Resolution from render.shadow.resolution.
-		Ref<RenderTarget> m_Target;
-
-		// Spot shadow atlas (depth-only, sampleable): kSpotAtlasCols^2 tiles packed into one texture.
-		Ref<RenderTarget> m_SpotAtlas;
+		// Sun cascade targets (depth-only, sampleable), one per cascade. Resolution from render.shadow.resolution.
+		std::array<Ref<RenderTarget>, kMaxShadowCascades> m_CascadeTargets;
 
-		// Point shadow atlas (depth-only, sampleable): kPointAtlasCols^2 tiles; 6 consecutive tiles per point.
-		Ref<RenderTarget> m_PointAtlas;
+		// Spot + point shadow atlas (depth-only, sampleable): allocator-placed tiles packed into one texture.
+		Ref<RenderTarget> m_Atlas;
 	};
 }
@@ -1,8 +1,11 @@
 ﻿#include "Pipeline.hpp"
 
+#include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Core/Log.hpp"
 #include "RendererAPI.hpp"
 
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanComputePipeline.hpp"
 #include "Platform/Vulkan/VulkanGraphicsPipeline.hpp"
 
@@ -71,6 +74,11 @@ namespace Snowstorm
 			Register(pipeline);
 			return pipeline;
 
+		case RendererAPI::API::Null:
+			pipeline = CreateRef<NullPipeline>(desc);
+			Register(pipeline);
+			return pipeline;
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 pipelines are not implemented yet.");
 			return nullptr;
@@ -79,4 +87,17 @@ namespace Snowstorm
 		SS_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
-}
\ No newline at end of file
+
+	Ref<Pipeline> Pipeline::CreateAsync(const PipelineDesc& desc)
+	{
+		if (desc.Type == PipelineType::Compute || RendererAPI::GetAPI() != RendererAPI::API::Vulkan)
+		{
+			return Create(desc);
+		}
+
+		auto pipeline = CreateRef<VulkanGraphicsPipeline>(desc, /*deferBuild*/ true);
+		Register(pipeline);
+		pipeline->BuildAsync(Application::Get().GetServiceManager().GetService<JobSystem>());
+		return pipeline;
+	}
+}
@@ -188,11 +188,22 @@ namespace Snowstorm
 		// Live MSAA: rebuild the backend pipeline in place at a new rasterization sample count (updates the
 		// desc + swaps the internal handle, like Reload). No-op if unchanged or on pipeline types without
 		// multisample state (compute). Only the scene-target graphics pipelines (material + sky) are switched,
-		// coordinated with the scene target reallocation, when render.msaa changes. Caller ensures GPU idle.
+		// coordinated with the scene target reallocation, when render.msaa changes. Caller ensures GPU idle
+		// (once for the whole set of pipelines it switches, not per pipeline).
 		virtual void SetSampleCount(uint32_t /*samples*/) {}
 
+		// False while the backend object is still compiling on a worker (CreateAsync, or a background
+		// SetSampleCount rebuild). A pipeline must not be bound until this is true; callers that can't wait
+		// skip the draw for that frame, the same way an unready Shader keeps a material unresolved.
+		[[nodiscard]] virtual bool IsReady() const { return true; }
+
 		static Ref<Pipeline> Create(const PipelineDesc& desc);
 
+		// Like Create, but the driver compile runs on a JobSystem worker and the call returns immediately
+		// with a not-yet-ready pipeline (poll IsReady). For pipelines created on demand mid-frame — material
+		// pipelines — where a synchronous compile is a visible hitch. Compute descs build synchronously.
+		static Ref<Pipeline> CreateAsync(const PipelineDesc& desc);
+
 		// Invoke `fn` for every live pipeline (the registry holds weak refs populated by Create). Used by the
 		// shader-reload sweep to find pipelines whose shader recompiled. Dead entries are pruned as it walks.
 		static void ForEachLive(const std::function<void(const Ref<Pipeline>&)>& fn);
@@ -0,0 +1,73 @@
+#include "PipelinePrewarmList.hpp"
+
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
+
+#include <fstream>
+#include <unordered_set>
+
+namespace Snowstorm
+{
+	std::filesystem::path PipelinePrewarmListIO::GetDefaultPath()
+	{
+		return "Engine/cache/pipelines/prewarm.txt";
+	}
+
+	std::vector<std::string> PipelinePrewarmListIO::Load(const std::filesystem::path& path)
+	{
+		std::vector<std::string> out;
+		std::ifstream in(path);
+		if (!in.is_open())
+		{
+			return out;
+		}
+
+		std::unordered_set<std::string> seen;
+		std::string line;
+		while (std::getline(in, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+			{
+				line.pop_back(); // written on Windows, read anywhere
+			}
+			if (line.empty() || line.front() == '#')
+			{
+				continue;
+			}
+			if (seen.insert(line).second)
+			{
+				out.push_back(line);
+			}
+		}
+		return out;
+	}
+
+	bool PipelinePrewarmListIO::Save(const std::filesystem::path& path, const std::vector<std::string>& fragmentShaders)
+	{
+		std::error_code ec;
+		if (path.has_parent_path())
+		{
+			std::filesystem::create_directories(path.parent_path(), ec);
+		}
+
+		const std::filesystem::path tmp = DerivedDataCache::MakeTempPath(path);
+		{
+			std::ofstream out(tmp, std::ios::trunc);
+			if (!out.is_open())
+			{
+				return false;
+			}
+			out << "# Material pipelines compiled by previous sessions (pre-warmed at startup).\n";
+			for (const std::string& frag : fragmentShaders)
+			{
+				out << frag << '\n';
+			}
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+		}
+		return DerivedDataCache::CommitTempFile(tmp, path);
+	}
+}
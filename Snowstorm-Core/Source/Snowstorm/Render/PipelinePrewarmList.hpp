@@ -0,0 +1,26 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	// The material pipelines the previous session ended up needing, by fragment-shader path (the key
+	// AssetManagerSingleton::GetOrCreatePipeline caches on). On startup the asset manager queues these for a
+	// background compile before any material asks for them, so with a warm VkPipelineCache the first frames
+	// find their pipelines already built instead of popping in one by one. Plain text, one path per line,
+	// first-use order — small, diffable, and safe to delete (it is only a hint).
+	class PipelinePrewarmListIO
+	{
+	public:
+		// Engine/cache/pipelines/prewarm.txt (CWD-relative, gitignored — next to the driver pipeline cache).
+		static std::filesystem::path GetDefaultPath();
+
+		// Recorded paths in file order, de-duplicated; blank lines and '#' comments skipped. Empty if missing.
+		static std::vector<std::string> Load(const std::filesystem::path& path);
+
+		// Overwrite the list (atomic temp-then-rename). Returns false on I/O failure.
+		static bool Save(const std::filesystem::path& path, const std::vector<std::string>& fragmentShaders);
+	};
+}
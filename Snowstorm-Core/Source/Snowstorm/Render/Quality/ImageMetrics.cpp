@@ -0,0 +1,616 @@
+#include "ImageMetrics.hpp"
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <span>
+
+namespace Snowstorm::Quality
+{
+	namespace
+	{
+		using Plane = std::vector<float>;
+
+		// Rows per JobSystem chunk. A 1080p row is ~7.5 KB per plane, so a band stays cache-resident across a
+		// filter's taps while still giving every worker several chunks per pass.
+		constexpr size_t kRowGrain = 16;
+
+		// SSIM stabilization constants (Wang et al.) for L = 1 — the same values Metrics.comp uses.
+		constexpr double kSsimC1 = 0.0001;
+		constexpr double kSsimC2 = 0.0009;
+
+		// MS-SSIM per-scale exponents (Wang, Simoncelli & Bovik 2003), finest scale first.
+		constexpr std::array<double, 5> kMsSsimWeights = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+		constexpr uint32_t kMsSsimMinSide = 11; // the Gaussian window; coarser scales than this are skipped
+
+		// LDR-FLIP constants (Andersson et al. 2020).
+		constexpr double kFlipQc = 0.7;        // color-difference compression exponent
+		constexpr double kFlipQf = 0.5;        // feature-difference exponent
+		constexpr double kFlipPc = 0.4;        // color-difference redistribution knee (fraction of cmax)
+		constexpr double kFlipPt = 0.95;       // error assigned at the knee
+		constexpr double kFlipFeatureW = 0.082; // feature-detector width in degrees
+
+		template <typename Fn>
+		void ForRows(JobSystem* jobs, const uint32_t rows, Fn&& body)
+		{
+			if (jobs)
+			{
+				jobs->ParallelFor(rows, body, kRowGrain);
+			}
+			else
+			{
+				body(size_t{0}, size_t{rows});
+			}
+		}
+
+		// Sum `rowSum(y)` over every row. Partials are stored per row and added in row order, so the result
+		// doesn't depend on how the rows were split across workers.
+		template <typename Fn>
+		double SumRows(JobSystem* jobs, const uint32_t rows, Fn&& rowSum)
+		{
+			std::vector<double> partial(rows);
+			ForRows(jobs, rows, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t y = begin; y < end; ++y)
+				        {
+					        partial[y] = rowSum(static_cast<uint32_t>(y));
+				        } });
+			double total = 0.0;
+			for (const double p : partial)
+			{
+				total += p;
+			}
+			return total;
+		}
+
+		bool Comparable(const MetricImage& test, const MetricImage& reference, const char* metric)
+		{
+			const size_t pixels = static_cast<size_t>(test.Width) * test.Height;
+			if (pixels == 0 || test.Width != reference.Width || test.Height != reference.Height ||
+			    test.Planes.size() != 3 * pixels || reference.Planes.size() != 3 * pixels)
+			{
+				SS_CORE_ERROR("{}: cannot compare a {}x{} image with a {}x{} reference", metric, test.Width, test.Height,
+				              reference.Width, reference.Height);
+				return false;
+			}
+			return true;
+		}
+
+		std::vector<float> BoxKernel(const int radius)
+		{
+			return std::vector<float>(2 * radius + 1, 1.0f / static_cast<float>(2 * radius + 1));
+		}
+
+		std::vector<float> GaussianKernel(const double sigma, const int radius)
+		{
+			std::vector<float> k(2 * radius + 1);
+			double sum = 0.0;
+			for (int i = -radius; i <= radius; ++i)
+			{
+				sum += std::exp(-0.5 * i * i / (sigma * sigma));
+			}
+			for (int i = -radius; i <= radius; ++i)
+			{
+				k[i + radius] = static_cast<float>(std::exp(-0.5 * i * i / (sigma * sigma)) / sum);
+			}
+			return k;
+		}
+
+		// Separable filter with clamp-to-edge addressing (Metrics.comp clamps its window the same way): `kx`
+		// along rows, then `ky` along columns. Both are odd-length, centered. The row pass pads one row at a
+		// time; the column pass accumulates whole rows, so both inner loops are contiguous multiply-adds.
+		void Convolve(const float* src, float* dst, const uint32_t w, const uint32_t h, const std::span<const float> kx,
+		              const std::span<const float> ky, JobSystem* jobs)
+		{
+			const int rx = static_cast<int>(kx.size() / 2);
+			const int ry = static_cast<int>(ky.size() / 2);
+			Plane rows(static_cast<size_t>(w) * h);
+
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        std::vector<float> padded(w + 2 * rx);
+				        for (size_t y = begin; y < end; ++y)
+				        {
+					        const float* in = src + y * w;
+					        std::fill_n(padded.begin(), rx, in[0]);
+					        std::copy_n(in, w, padded.begin() + rx);
+					        std::fill_n(padded.begin() + rx + w, rx, in[w - 1]);
+
+					        float* out = rows.data() + y * w;
+					        std::fill_n(out, w, 0.0f);
+					        for (size_t k = 0; k < kx.size(); ++k)
+					        {
+						        const float wk = kx[k];
+						        const float* p = padded.data() + k;
+						        for (uint32_t x = 0; x < w; ++x)
+						        {
+							        out[x] += wk * p[x];
+						        }
+					        }
+				        } });
+
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t y = begin; y < end; ++y)
+				        {
+					        float* out = dst + y * w;
+					        std::fill_n(out, w, 0.0f);
+					        for (int k = -ry; k <= ry; ++k)
+					        {
+						        const int sy = std::clamp(static_cast<int>(y) + k, 0, static_cast<int>(h) - 1);
+						        const float wk = ky[k + ry];
+						        const float* in = rows.data() + static_cast<size_t>(sy) * w;
+						        for (uint32_t x = 0; x < w; ++x)
+						        {
+							        out[x] += wk * in[x];
+						        }
+					        }
+				        } });
+		}
+
+		struct SsimStats
+		{
+			double Ssim = 0.0; // mean of clamp(l * cs, 0, 1)
+			double Cs = 0.0;   // mean of clamp(cs, 0, 1): contrast-structure only, for MS-SSIM's finer scales
+		};
+
+		SsimStats ComputeSsim(const float* a, const float* b, const uint32_t w, const uint32_t h,
+		                      const std::span<const float> kernel, JobSystem* jobs)
+		{
+			const size_t n = static_cast<size_t>(w) * h;
+			Plane aa(n), bb(n), ab(n);
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t i = begin * w; i < end * w; ++i)
+				        {
+					        aa[i] = a[i] * a[i];
+					        bb[i] = b[i] * b[i];
+					        ab[i] = a[i] * b[i];
+				        } });
+
+			// Local moments: the window means of a, b, a^2, b^2, ab.
+			Plane ma(n), mb(n), maa(n), mbb(n), mab(n);
+			Convolve(a, ma.data(), w, h, kernel, kernel, jobs);
+			Convolve(b, mb.data(), w, h, kernel, kernel, jobs);
+			Convolve(aa.data(), maa.data(), w, h, kernel, kernel, jobs);
+			Convolve(bb.data(), mbb.data(), w, h, kernel, kernel, jobs);
+			Convolve(ab.data(), mab.data(), w, h, kernel, kernel, jobs);
+
+			std::vector<double> csRows(h);
+			const double ssimSum = SumRows(jobs, h, [&](const uint32_t y)
+			                               {
+				                               double ssim = 0.0, cs = 0.0;
+				                               for (size_t i = static_cast<size_t>(y) * w; i < static_cast<size_t>(y + 1) * w; ++i)
+				                               {
+					                               const double mua = ma[i], mub = mb[i];
+					                               const double va = std::max(maa[i] - mua * mua, 0.0);
+					                               const double vb = std::max(mbb[i] - mub * mub, 0.0);
+					                               const double cab = mab[i] - mua * mub;
+					                               const double l = (2.0 * mua * mub + kSsimC1) / (mua * mua + mub * mub + kSsimC1);
+					                               const double c = (2.0 * cab + kSsimC2) / (va + vb + kSsimC2);
+					                               ssim += std::clamp(l * c, 0.0, 1.0);
+					                               cs += std::clamp(c, 0.0, 1.0);
+				                               }
+				                               csRows[y] = cs;
+				                               return ssim; });
+			double csSum = 0.0;
+			for (const double c : csRows)
+			{
+				csSum += c;
+			}
+			return {ssimSum / static_cast<double>(n), csSum / static_cast<double>(n)};
+		}
+
+		// 2x2 box downsample (MS-SSIM's scale step); an odd last row/column is dropped.
+		Plane Downsample(const Plane& src, const uint32_t w, const uint32_t h, JobSystem* jobs)
+		{
+			const uint32_t ow = w / 2, oh = h / 2;
+			Plane out(static_cast<size_t>(ow) * oh);
+			ForRows(jobs, oh, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t y = begin; y < end; ++y)
+				        {
+					        const float* r0 = src.data() + 2 * y * w;
+					        const float* r1 = r0 + w;
+					        float* o = out.data() + y * ow;
+					        for (uint32_t x = 0; x < ow; ++x)
+					        {
+						        o[x] = 0.25f * (r0[2 * x] + r0[2 * x + 1] + r1[2 * x] + r1[2 * x + 1]);
+					        }
+				        } });
+			return out;
+		}
+
+		// ---- FLIP color math (linear sRGB primaries, D65) ----
+
+		struct Vec3
+		{
+			double X, Y, Z;
+		};
+
+		double SrgbToLinear(const double c)
+		{
+			return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+		}
+
+		Vec3 LinearToXyz(const Vec3& c)
+		{
+			return {0.4124564 * c.X + 0.3575761 * c.Y + 0.1804375 * c.Z,
+			        0.2126729 * c.X + 0.7151522 * c.Y + 0.0721750 * c.Z,
+			        0.0193339 * c.X + 0.1191920 * c.Y + 0.9503041 * c.Z};
+		}
+
+		Vec3 XyzToLinear(const Vec3& c)
+		{
+			return {3.2404542 * c.X - 1.5371385 * c.Y - 0.4985314 * c.Z,
+			        -0.9692660 * c.X + 1.8760108 * c.Y + 0.0415560 * c.Z,
+			        0.0556434 * c.X - 0.2040259 * c.Y + 1.0572252 * c.Z};
+		}
+
+		const Vec3 kWhite = LinearToXyz({1.0, 1.0, 1.0});
+
+		// YCxCz: CIELab with the cube root removed, the linear opponent space FLIP applies its CSFs in.
+		Vec3 XyzToYcxcz(const Vec3& c)
+		{
+			const double y = c.Y / kWhite.Y;
+			return {116.0 * y - 16.0, 500.0 * (c.X / kWhite.X - y), 200.0 * (y - c.Z / kWhite.Z)};
+		}
+
+		Vec3 YcxczToXyz(const Vec3& c)
+		{
+			const double y = (c.X + 16.0) / 116.0;
+			return {kWhite.X * (c.Y / 500.0 + y), kWhite.Y * y, kWhite.Z * (y - c.Z / 200.0)};
+		}
+
+		// CIELab with FLIP's Hunt adjustment (chroma scaled by 0.01 * L, so dark colors differ less).
+		Vec3 XyzToHuntLab(const Vec3& c)
+		{
+			constexpr double kDelta = 6.0 / 29.0;
+			const auto f = [](const double t)
+			{ return t > kDelta * kDelta * kDelta ? std::cbrt(t) : t / (3.0 * kDelta * kDelta) + 4.0 / 29.0; };
+			const double fx = f(c.X / kWhite.X), fy = f(c.Y / kWhite.Y), fz = f(c.Z / kWhite.Z);
+			const double l = 116.0 * fy - 16.0;
+			return {l, 0.01 * l * 500.0 * (fx - fy), 0.01 * l * 200.0 * (fy - fz)};
+		}
+
+		double HyAb(const Vec3& p, const Vec3& q)
+		{
+			return std::abs(p.X - q.X) + std::hypot(p.Y - q.Y, p.Z - q.Z);
+		}
+
+		// One CSF: a sum of (up to two) Gaussians a * sqrt(pi / b) * exp(-pi^2 x^2 / b), x in degrees.
+		struct Csf
+		{
+			std::array<double, 2> A;
+			std::array<double, 2> B;
+		};
+		constexpr std::array<Csf, 3> kFlipCsfs = {{
+			{{1.0, 0.0}, {0.0047, 1e-5}},  // achromatic (Y)
+			{{1.0, 0.0}, {0.0053, 1e-5}},  // red-green (Cx)
+			{{34.1, 13.5}, {0.04, 0.025}}, // blue-yellow (Cz)
+		}};
+
+		// Apply `csf` (normalized to unit DC gain) to `src`. Each Gaussian term is separable; a two-term CSF is
+		// the weighted sum of two separable passes.
+		void ApplyCsf(const float* src, float* dst, const uint32_t w, const uint32_t h, const Csf& csf, const int radius,
+		              const double pixelsPerDegree, JobSystem* jobs)
+		{
+			const size_t n = static_cast<size_t>(w) * h;
+			std::array<std::vector<float>, 2> kernels;
+			std::array<double, 2> gains{};
+			double total = 0.0;
+			for (size_t t = 0; t < 2; ++t)
+			{
+				if (csf.A[t] == 0.0)
+				{
+					continue;
+				}
+				kernels[t].resize(2 * radius + 1);
+				double sum = 0.0;
+				for (int i = -radius; i <= radius; ++i)
+				{
+					const double x = i / pixelsPerDegree;
+					kernels[t][i + radius] = static_cast<float>(std::exp(-std::numbers::pi * std::numbers::pi * x * x / csf.B[t]));
+					sum += kernels[t][i + radius];
+				}
+				gains[t] = csf.A[t] * std::sqrt(std::numbers::pi / csf.B[t]);
+				total += gains[t] * sum * sum;
+				for (float& k : kernels[t])
+				{
+					k = static_cast<float>(k / sum); // unit-sum 1D pass; the term's 2D weight goes in `gains`
+				}
+				gains[t] *= sum * sum;
+			}
+
+			std::fill_n(dst, n, 0.0f);
+			Plane term(n);
+			for (size_t t = 0; t < 2; ++t)
+			{
+				if (kernels[t].empty())
+				{
+					continue;
+				}
+				Convolve(src, term.data(), w, h, kernels[t], kernels[t], jobs);
+				const float weight = static_cast<float>(gains[t] / total);
+				ForRows(jobs, h, [&](const size_t begin, const size_t end)
+				        {
+					        for (size_t i = begin * w; i < end * w; ++i)
+					        {
+						        dst[i] += weight * term[i];
+					        }
+				        });
+			}
+		}
+
+		// Per image: the Hunt-Lab planes of the CSF-filtered color, and the feature channel (normalized
+		// unfiltered luminance).
+		struct FlipPlanes
+		{
+			std::array<Plane, 3> Lab;
+			Plane Feature;
+		};
+
+		FlipPlanes PrepareFlip(const MetricImage& image, const double pixelsPerDegree, JobSystem* jobs)
+		{
+			const uint32_t w = image.Width, h = image.Height;
+			const size_t n = static_cast<size_t>(w) * h;
+			std::array<Plane, 3> opponent = {Plane(n), Plane(n), Plane(n)};
+			FlipPlanes out;
+			out.Feature.resize(n);
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t i = begin * w; i < end * w; ++i)
+				        {
+					        const Vec3 linear = {SrgbToLinear(image.Planes[i]), SrgbToLinear(image.Planes[n + i]), SrgbToLinear(image.Planes[2 * n + i])};
+					        const Vec3 ycxcz = XyzToYcxcz(LinearToXyz(linear));
+					        opponent[0][i] = static_cast<float>(ycxcz.X);
+					        opponent[1][i] = static_cast<float>(ycxcz.Y);
+					        opponent[2][i] = static_cast<float>(ycxcz.Z);
+					        out.Feature[i] = static_cast<float>((ycxcz.X + 16.0) / 116.0);
+				        } });
+
+			// One radius for all three CSFs, from the widest Gaussian (3 sigma), as the reference does.
+			double widest = 0.0;
+			for (const Csf& csf : kFlipCsfs)
+			{
+				widest = std::max({widest, csf.B[0], csf.A[1] != 0.0 ? csf.B[1] : 0.0});
+			}
+			const int radius = static_cast<int>(std::ceil(3.0 * std::sqrt(widest / (2.0 * std::numbers::pi * std::numbers::pi)) * pixelsPerDegree));
+
+			std::array<Plane, 3> filtered = {Plane(n), Plane(n), Plane(n)};
+			for (size_t c = 0; c < 3; ++c)
+			{
+				ApplyCsf(opponent[c].data(), filtered[c].data(), w, h, kFlipCsfs[c], radius, pixelsPerDegree, jobs);
+			}
+
+			out.Lab = {Plane(n), Plane(n), Plane(n)};
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t i = begin * w; i < end * w; ++i)
+				        {
+					        Vec3 linear = XyzToLinear(YcxczToXyz({filtered[0][i], filtered[1][i], filtered[2][i]}));
+					        linear = {std::clamp(linear.X, 0.0, 1.0), std::clamp(linear.Y, 0.0, 1.0), std::clamp(linear.Z, 0.0, 1.0)};
+					        const Vec3 lab = XyzToHuntLab(LinearToXyz(linear));
+					        out.Lab[0][i] = static_cast<float>(lab.X);
+					        out.Lab[1][i] = static_cast<float>(lab.Y);
+					        out.Lab[2][i] = static_cast<float>(lab.Z);
+				        } });
+			return out;
+		}
+
+		// FLIP's feature detectors: first (edge) and second (point) derivatives of a Gaussian along x, each
+		// normalized so its positive taps sum to 1 and its negative taps to -1; the cross axis is the unit-sum
+		// Gaussian. Separable forms of the reference's 2D kernels (the normalization factors through).
+		struct FeatureKernels
+		{
+			std::vector<float> Gauss, Edge, Point;
+		};
+
+		FeatureKernels MakeFeatureKernels(const double pixelsPerDegree)
+		{
+			const double sigma = 0.5 * kFlipFeatureW * pixelsPerDegree;
+			const int radius = static_cast<int>(std::ceil(3.0 * sigma));
+			FeatureKernels k;
+			k.Gauss = GaussianKernel(sigma, radius);
+			std::vector<double> edge(2 * radius + 1), point(2 * radius + 1);
+			for (int i = -radius; i <= radius; ++i)
+			{
+				const double g = std::exp(-0.5 * i * i / (sigma * sigma));
+				edge[i + radius] = -i * g;
+				point[i + radius] = (i * i / (sigma * sigma) - 1.0) * g;
+			}
+			const auto normalize = [](const std::vector<double>& taps)
+			{
+				double pos = 0.0, neg = 0.0;
+				for (const double t : taps)
+				{
+					(t > 0.0 ? pos : neg) += t;
+				}
+				std::vector<float> out(taps.size());
+				for (size_t i = 0; i < taps.size(); ++i)
+				{
+					out[i] = static_cast<float>(taps[i] > 0.0 ? taps[i] / pos : (neg < 0.0 ? -taps[i] / neg : 0.0));
+				}
+				return out;
+			};
+			k.Edge = normalize(edge);
+			k.Point = normalize(point);
+			return k;
+		}
+
+		// Edge and point response magnitudes of the feature channel.
+		void FeatureMagnitudes(const Plane& feature, const uint32_t w, const uint32_t h, const FeatureKernels& k,
+		                       Plane& edges, Plane& points, JobSystem* jobs)
+		{
+			const size_t n = static_cast<size_t>(w) * h;
+			Plane ex(n), ey(n), px(n), py(n);
+			Convolve(feature.data(), ex.data(), w, h, k.Edge, k.Gauss, jobs);
+			Convolve(feature.data(), ey.data(), w, h, k.Gauss, k.Edge, jobs);
+			Convolve(feature.data(), px.data(), w, h, k.Point, k.Gauss, jobs);
+			Convolve(feature.data(), py.data(), w, h, k.Gauss, k.Point, jobs);
+			edges.resize(n);
+			points.resize(n);
+			ForRows(jobs, h, [&](const size_t begin, const size_t end)
+			        {
+				        for (size_t i = begin * w; i < end * w; ++i)
+				        {
+					        edges[i] = std::hypot(ex[i], ey[i]);
+					        points[i] = std::hypot(px[i], py[i]);
+				        } });
+		}
+	}
+
+	std::optional<MetricImage> MetricImageFromNpy(const NpyArray& npy, const std::string& what)
+	{
+		if (npy.Shape.size() != 3 || npy.Shape[2] < 3 || npy.Shape[0] == 0 || npy.Shape[1] == 0)
+		{
+			SS_CORE_ERROR("ImageMetrics: {} is not an (h, w, >=3) image", what);
+			return std::nullopt;
+		}
+		MetricImage image;
+		image.Height = static_cast<uint32_t>(npy.Shape[0]);
+		image.Width = static_cast<uint32_t>(npy.Shape[1]);
+		const size_t channels = npy.Shape[2];
+		const size_t n = static_cast<size_t>(image.Width) * image.Height;
+		const float range = npy.DType == NpyDType::UInt8 ? 255.0f : 1.0f;
+		image.Planes.resize(3 * n);
+		for (size_t c = 0; c < 3; ++c)
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				image.Planes[c * n + i] = npy.Data[i * channels + c] / range;
+			}
+		}
+		return image;
+	}
+
+	std::vector<float> Luma(const MetricImage& image, JobSystem* jobs)
+	{
+		const uint32_t w = image.Width;
+		const size_t n = static_cast<size_t>(w) * image.Height;
+		Plane out(n);
+		const float* r = image.Plane(0);
+		const float* g = image.Plane(1);
+		const float* b = image.Plane(2);
+		ForRows(jobs, image.Height, [&](const size_t begin, const size_t end)
+		        {
+			        for (size_t i = begin * w; i < end * w; ++i)
+			        {
+				        out[i] = 0.2126f * r[i] + 0.7152f * g[i] + 0.0722f * b[i]; // Rec.709, as Metrics.comp
+			        } });
+		return out;
+	}
+
+	std::optional<double> Psnr(const MetricImage& test, const MetricImage& reference, JobSystem* jobs)
+	{
+		if (!Comparable(test, reference, "PSNR"))
+		{
+			return std::nullopt;
+		}
+		const Plane a = Luma(test, jobs);
+		const Plane b = Luma(reference, jobs);
+		const uint32_t w = test.Width;
+		const double sse = SumRows(jobs, test.Height, [&](const uint32_t y)
+		                           {
+			                           double sum = 0.0;
+			                           for (size_t i = static_cast<size_t>(y) * w; i < static_cast<size_t>(y + 1) * w; ++i)
+			                           {
+				                           const double d = static_cast<double>(a[i]) - b[i];
+				                           sum += d * d;
+			                           }
+			                           return sum; });
+		const double mse = sse / (static_cast<double>(w) * test.Height);
+		return mse <= 1e-12 ? 100.0 : 10.0 * std::log10(1.0 / mse);
+	}
+
+	std::optional<double> Ssim(const MetricImage& test, const MetricImage& reference, const SsimWindow window, JobSystem* jobs)
+	{
+		if (!Comparable(test, reference, "SSIM"))
+		{
+			return std::nullopt;
+		}
+		const Plane a = Luma(test, jobs);
+		const Plane b = Luma(reference, jobs);
+		const std::vector<float> kernel = window == SsimWindow::Box7 ? BoxKernel(3) : GaussianKernel(1.5, 5);
+		return ComputeSsim(a.data(), b.data(), test.Width, test.Height, kernel, jobs).Ssim;
+	}
+
+	std::optional<double> MsSsim(const MetricImage& test, const MetricImage& reference, JobSystem* jobs)
+	{
+		if (!Comparable(test, reference, "MS-SSIM"))
+		{
+			return std::nullopt;
+		}
+		Plane a = Luma(test, jobs);
+		Plane b = Luma(reference, jobs);
+		uint32_t w = test.Width, h = test.Height;
+
+		// Drop the coarse scales a small image can't support, renormalizing the remaining exponents.
+		size_t levels = 1;
+		while (levels < kMsSsimWeights.size() && std::min(w, h) >> levels >= kMsSsimMinSide)
+		{
+			++levels;
+		}
+		double weightSum = 0.0;
+		for (size_t l = 0; l < levels; ++l)
+		{
+			weightSum += kMsSsimWeights[l];
+		}
+
+		const std::vector<float> kernel = GaussianKernel(1.5, 5);
+		double result = 1.0;
+		for (size_t l = 0; l < levels; ++l)
+		{
+			const SsimStats stats = ComputeSsim(a.data(), b.data(), w, h, kernel, jobs);
+			const bool coarsest = l + 1 == levels;
+			result *= std::pow(coarsest ? stats.Ssim : stats.Cs, kMsSsimWeights[l] / weightSum);
+			if (!coarsest)
+			{
+				a = Downsample(a, w, h, jobs);
+				b = Downsample(b, w, h, jobs);
+				w /= 2;
+				h /= 2;
+			}
+		}
+		return result;
+	}
+
+	std::optional<double> Flip(const MetricImage& test, const MetricImage& reference, const float pixelsPerDegree, JobSystem* jobs)
+	{
+		if (!Comparable(test, reference, "FLIP") || pixelsPerDegree <= 0.0f)
+		{
+			return std::nullopt;
+		}
+		const uint32_t w = test.Width, h = test.Height;
+		const FlipPlanes t = PrepareFlip(test, pixelsPerDegree, jobs);
+		const FlipPlanes r = PrepareFlip(reference, pixelsPerDegree, jobs);
+
+		const FeatureKernels kernels = MakeFeatureKernels(pixelsPerDegree);
+		Plane tEdges, tPoints, rEdges, rPoints;
+		FeatureMagnitudes(t.Feature, w, h, kernels, tEdges, tPoints, jobs);
+		FeatureMagnitudes(r.Feature, w, h, kernels, rEdges, rPoints, jobs);
+
+		// The largest Hunt-adjusted HyAB distance between sRGB primaries (green vs blue) sets the color scale.
+		const double cmax = std::pow(HyAb(XyzToHuntLab(LinearToXyz({0.0, 1.0, 0.0})), XyzToHuntLab(LinearToXyz({0.0, 0.0, 1.0}))), kFlipQc);
+		const double knee = kFlipPc * cmax;
+
+		const double sum = SumRows(jobs, h, [&](const uint32_t y)
+		                           {
+			                           double rowSum = 0.0;
+			                           for (size_t i = static_cast<size_t>(y) * w; i < static_cast<size_t>(y + 1) * w; ++i)
+			                           {
+				                           const double hyab = HyAb({t.Lab[0][i], t.Lab[1][i], t.Lab[2][i]}, {r.Lab[0][i], r.Lab[1][i], r.Lab[2][i]});
+				                           const double dc = std::pow(hyab, kFlipQc);
+				                           const double color = dc < knee ? kFlipPt / knee * dc
+				                                                          : kFlipPt + (dc - knee) / (cmax - knee) * (1.0 - kFlipPt);
+				                           const double feature = std::pow(std::max(std::abs(tEdges[i] - rEdges[i]), std::abs(tPoints[i] - rPoints[i])) / std::numbers::sqrt2, kFlipQf);
+				                           rowSum += std::pow(std::min(color, 1.0), 1.0 - feature);
+			                           }
+			                           return rowSum; });
+		return sum / (static_cast<double>(w) * h);
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Snowstorm/Render/DatasetExport/NpyReader.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+}
+
+namespace Snowstorm::Quality
+{
+	// Headless CPU image-quality metrics over captured LDR images (QualityCapturePass's *_ldr.npy, the dataset
+	// export's gt_ldr), so a quality gate needs no GPU. Inputs are display-encoded [0,1] RGB — the bytes the
+	// viewer sees — which is exactly what MetricsPass reads through the present target's UNORM view.
+	//
+	// PSNR and the default (Box7) SSIM are MetricsPass's definitions: Rec.709 luma of the encoded values, PSNR
+	// = 10*log10(1/MSE) capped at 100 dB, and the mean of a per-pixel 7x7 box-window SSIM (clamp-to-edge,
+	// clamped to [0,1]). They agree with the GPU pass to its fixed-point accumulation error (~1e-3 in SSIM,
+	// well under 0.1 dB in PSNR). Gaussian11 is Wang et al.'s 11x11 sigma=1.5 window; MS-SSIM (Wang 2003) uses
+	// it over up to five dyadic scales. Flip is the LDR-FLIP pipeline (Andersson et al. 2020): CSF-filtered
+	// color difference in a Hunt-adjusted HyAB space, amplified by edge/point feature differences; a mean in
+	// [0,1], lower is better. It follows the paper's constants but is not bit-matched to NVIDIA's evaluator, so
+	// baselines must be produced by this implementation.
+	//
+	// Every filter is separable (row pass, then column pass over whole rows, written as axpy loops the
+	// compiler vectorizes) and every pass is split into row bands across the JobSystem when one is given.
+	// Reductions sum per-row partials in row order, so a threaded score is bit-identical to a serial one.
+
+	// Planar [0,1] RGB: R, G and B planes of Width * Height floats each.
+	struct MetricImage
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<float> Planes;
+
+		[[nodiscard]] const float* Plane(const uint32_t c) const { return Planes.data() + static_cast<size_t>(c) * Width * Height; }
+	};
+
+	// An (h, w, c >= 3) .npy as a MetricImage: uint8 codes / 255, float16/32 taken as already in [0,1]. Alpha
+	// and further channels are dropped. Nullopt (logged, naming `what`) for any other shape.
+	std::optional<MetricImage> MetricImageFromNpy(const NpyArray& npy, const std::string& what);
+
+	enum class SsimWindow : uint8_t
+	{
+		Box7,      // MetricsPass's window (the gate-parity default)
+		Gaussian11 // Wang et al.'s reference window
+	};
+
+	// Default viewing condition for Flip: 0.7 m from a 0.7 m wide 3840-pixel display (FLIP's standard setup).
+	constexpr float kFlipDefaultPixelsPerDegree = 67.0206f;
+
+	// `test` and `reference` must be the same size (nullopt, logged, otherwise).
+	std::optional<double> Psnr(const MetricImage& test, const MetricImage& reference, JobSystem* jobs = nullptr);
+	std::optional<double> Ssim(const MetricImage& test, const MetricImage& reference, SsimWindow window = SsimWindow::Box7,
+	                           JobSystem* jobs = nullptr);
+	std::optional<double> MsSsim(const MetricImage& test, const MetricImage& reference, JobSystem* jobs = nullptr);
+	std::optional<double> Flip(const MetricImage& test, const MetricImage& reference,
+	                           float pixelsPerDegree = kFlipDefaultPixelsPerDegree, JobSystem* jobs = nullptr);
+
+	// Rec.709 luma plane of `image` (the channel PSNR/SSIM are computed on). Exposed for unit tests.
+	std::vector<float> Luma(const MetricImage& image, JobSystem* jobs = nullptr);
+}
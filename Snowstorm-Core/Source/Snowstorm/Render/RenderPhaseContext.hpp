@@ -124,7 +124,7 @@ namespace Snowstorm
 
 		// Assets still streaming this frame (#153): while true the path tracer keeps RESETTING its accumulation,
 		// so the magenta placeholder frames (unresolved textures/meshes) never bake into the converged mean. Set
-		// in the RenderSystem preamble from AssetManagerSingleton::PendingLoadCount().
+		// in the RenderSystem preamble from the asset load-burst events (AssetLoadsStarted/SettledEvent).
 		bool PathTraceSceneSettling = false;
 
 		// Whether TAA (render.aa == 2) is active with valid history targets. TemporalEffect resolves when
@@ -1,6 +1,7 @@
 ﻿#include "RenderTarget.hpp"
 
 #include "RendererAPI.hpp"
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanRenderTarget.hpp"
 #include "Snowstorm/Core/Log.hpp"
 
@@ -21,6 +22,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanRenderTarget>(desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullRenderTarget>(desc);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "RendererAPI::API::DX12 is currently not supported!");
 			return nullptr;
@@ -2,6 +2,7 @@
 
 #include "Snowstorm/Core/Log.hpp"
 #include "Snowstorm/Render/Sampler.hpp"
+#include "Platform/Null/NullRendererAPI.hpp"
 #include "Platform/Vulkan/VulkanRendererAPI.hpp"
 
 namespace Snowstorm
@@ -49,6 +50,10 @@ namespace Snowstorm
 			s_API = CreateScope<VulkanRendererAPI>();
 			break;
 
+		case RendererAPI::API::Null:
+			s_API = CreateScope<NullRendererAPI>();
+			break;
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 not implemented yet.");
 			return;
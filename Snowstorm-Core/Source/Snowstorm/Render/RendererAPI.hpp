@@ -17,6 +17,11 @@ namespace Snowstorm
 			OpenGL = 1,
 			Vulkan = 2,
 			DX12 = 3,
+			// Headless recording backend (Platform/Null): no device, no window. Create* hands out CPU-side stub
+			// resources and the command context records into an in-memory log instead of a command buffer, so
+			// the render path (RenderGraph, RendererService batching, passes) runs in tests and benchmarks and
+			// its submit cost -- draws, binds, barriers -- can be counted. Select it before Renderer::Init.
+			Null = 4,
 		};
 
 		virtual void Init(void* windowHandle) = 0;
@@ -3,6 +3,7 @@
 #include "Snowstorm/Core/Application.hpp"
 #include "Snowstorm/Core/Base.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Core/Log.hpp"
 #include "Snowstorm/Render/Buffer.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
@@ -10,7 +11,10 @@
 #include "Snowstorm/Render/Texture.hpp"
 #include "Snowstorm/Service/ServiceManager.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cstring>
+#include <span>
 
 namespace Snowstorm
 {
@@ -24,7 +28,7 @@ namespace Snowstorm
 			glm::vec3 CameraPosition;
 			float Exposure = 1.0f; // linear pre-tonemap multiplier (mirrors Engine.hlsli FrameCB)
 
-			LightDataBlock Lights;
+			GPULightConstants Lights;
 
 			// Environment (sky/ambient), shared by Sky.hlsl and DefaultLit's ambient term. Each vec3 is
 			// register-packed with the trailing float (SkyIntensity, then padding) — same trick as
@@ -36,23 +40,26 @@ namespace Snowstorm
 			glm::vec3 GroundColor;
 			float _EnvPad1 = 0.0f;
 
-			// Directional shadow (sun = DirectionalLights[0]). LightViewProj reprojects world -> light clip
-			// for the depth compare; ShadowMapIndex is the bindless index of the shadow depth texture
-			// (0 = no shadows, fully lit). The trailing row carries bias + texel size + strength. MUST match
-			// the FrameCB tail in Engine.hlsli field-for-field.
-			glm::mat4 LightViewProj{1.0f};
-			uint32_t ShadowMapIndex = 0;
+			// Directional shadow (sun = DirectionalLights[0]). CascadeViewProj[i] reprojects world -> cascade i's
+			// light clip for the depth compare; CascadeCount is how many are live (0 = no shadows, fully lit).
+			// The trailing row carries bias + texel size + strength. MUST match the FrameCB tail in Engine.hlsli
+			// field-for-field.
+			glm::mat4 CascadeViewProj[kMaxShadowCascades]{};
+			uint32_t CascadeCount = 0;
 			float ShadowBias = 0.0015f;
 			float ShadowTexelSize = 1.0f / 2048.0f;
 			float ShadowStrength = 1.0f;
 			uint32_t ShadowSoft = 1;            // 1 = 3x3 PCF, 0 = hard single tap
-			uint32_t SpotShadowAtlasIndex = 0;  // bindless index of the spot shadow atlas (0 = spots unshadowed)
-			uint32_t PointShadowAtlasIndex = 0; // bindless index of the point shadow atlas (0 = points unshadowed)
+			uint32_t SpotShadowAtlasIndex = 0;  // bindless index of the shadow atlas when a spot casts (0 = spots unshadowed)
+			uint32_t PointShadowAtlasIndex = 0; // same atlas when a point casts (0 = points unshadowed)
 			// Normal-offset shadow bias (#59, cf. UE r.Shadow.NormalBias): push the sample position along the
 			// geometric normal (in WORLD units, grazing-angle scaled) before the light-space projection. Attacks
 			// self-shadow acne along the surface plane, where a pure depth bias can't help without peter-panning,
 			// so it complements the depth ShadowBias above. Small world distance tuned for the Sponza scale.
 			float ShadowNormalOffset = 0.03f;
+			// Bindless index of each cascade's depth map (a cascade is its own texture so a cached one can be
+			// left untouched while the near ones re-render).
+			glm::uvec4 CascadeMapIndex{0u};
 
 			// IBL (Phase 6). Bindless indices of the baked maps: irradiance + prefiltered into the cube
 			// array (Cubemaps[]), BRDF LUT into the 2D array (Textures[]). 0 = IBL disabled (use the
@@ -150,6 +157,12 @@ namespace Snowstorm
 			uint32_t _FramePad1 = 0;
 			uint32_t _FramePad2 = 0;
 		};
+
+		// Set 0 bindings beside FrameCB (b0): the clustered-lighting buffers declared in Engine.hlsli.
+		constexpr uint32_t kPointLightBinding = 1;
+		constexpr uint32_t kSpotLightBinding = 2;
+		constexpr uint32_t kLightClusterBinding = 3;
+		constexpr uint32_t kLightIndexBinding = 4;
 	}
 
 	void RendererService::NewFrame()
@@ -163,6 +176,9 @@ namespace Snowstorm
 		// index (#44) and is the reusable "which frame is this" primitive (cf. Unreal GFrameCounter) for
 		// any future frame-phased effect. Incremented once per frame here, before any pass runs.
 		++m_FrameCounter;
+
+		m_Stats.ShadowTilesRendered = 0;
+		m_Stats.ShadowTilesSkipped = 0;
 	}
 
 	void RendererService::BeginScene(const CameraRuntimeComponent& cameraRt,
@@ -183,6 +199,7 @@ namespace Snowstorm
 		// velocity, ground-truth — leaves it false and gets the unjittered VP, so motion vectors and depth
 		// stay geometrically true. JitteredViewProjection == ViewProjection when render.jitter is off.
 		m_FrameData.ViewProjection = useJitteredProjection ? cameraRt.JitteredViewProjection : cameraRt.ViewProjection;
+		m_FrameData.View = cameraRt.View;
 		m_FrameData.PrevViewProjection = cameraRt.PrevViewProjection; // motion vectors (#44)
 		m_FrameData.CameraPosition = cameraWorldPosition;
 
@@ -201,13 +218,25 @@ namespace Snowstorm
 
 		m_Batches.clear();
 		m_BatchIndex.clear();
-		m_Stats = RenderStats{};
+		m_BatchOrder.clear();
+		m_BatchOrderDirty = false;
+		// Scene-pass counters only: the shadow tile counts span the frame (reset in NewFrame).
+		m_Stats = RenderStats{.ShadowTilesRendered = m_Stats.ShadowTilesRendered, .ShadowTilesSkipped = m_Stats.ShadowTilesSkipped};
+		m_SkippedBindsAtBegin = commandContext->GetSkippedBinds();
 	}
 
 	void RendererService::EndScene()
 	{
 		Flush();
 
+		// Everything this scene pass recorded through the context, the shadow / velocity / depth-normal batch
+		// passes included, lands between the two snapshots.
+		const SkippedBindStats skipped = m_CommandContext ? m_CommandContext->GetSkippedBinds() : m_SkippedBindsAtBegin;
+		m_Stats.PipelineBindsSkipped = skipped.PipelineBinds - m_SkippedBindsAtBegin.PipelineBinds;
+		m_Stats.DescriptorBindsSkipped = skipped.DescriptorSets - m_SkippedBindsAtBegin.DescriptorSets;
+		m_Stats.BufferBindsSkipped = skipped.VertexBuffers - m_SkippedBindsAtBegin.VertexBuffers +
+		                             skipped.IndexBuffers - m_SkippedBindsAtBegin.IndexBuffers;
+
 		m_CommandContext.reset();
 		m_FrameIndex = 0;
 	}
@@ -233,6 +262,7 @@ namespace Snowstorm
 			newBatch.Mesh = mesh;
 			newBatch.MaterialInstance = materialInstance;
 			m_Batches.push_back(std::move(newBatch));
+			m_BatchOrderDirty = true;
 		}
 		BatchData* batch = &m_Batches[it->second];
 
@@ -244,9 +274,9 @@ namespace Snowstorm
 		batch->Instances.push_back(instance);
 	}
 
-	void RendererService::UploadLights(const LightDataBlock& lightData)
+	void RendererService::UploadLights(LightDataBlock lightData)
 	{
-		m_FrameData.Lights = lightData;
+		m_FrameData.Lights = std::move(lightData);
 	}
 
 	void RendererService::UploadEnvironment(const EnvironmentDataBlock& environment)
@@ -261,17 +291,58 @@ namespace Snowstorm
 			return;
 		}
 
-		for (auto& batch : m_Batches)
+		for (const uint32_t index : SortedBatchOrder())
 		{
-			FlushBatch(batch, m_CommandContext, m_FrameIndex);
+			FlushBatch(m_Batches[index], m_CommandContext, m_FrameIndex);
 		}
 	}
 
+	const std::vector<uint32_t>& RendererService::SortedBatchOrder()
+	{
+		if (!m_BatchOrderDirty)
+		{
+			return m_BatchOrder;
+		}
+		m_BatchOrderDirty = false;
+
+		// Dense first-seen ids keep the key fields narrow (see DrawSortKey); the maps only need to tell equal
+		// state apart, so their storage is kept across scenes and just cleared.
+		m_SortPipelineIds.clear();
+		m_SortMaterialIds.clear();
+		m_SortMeshIds.clear();
+		const auto denseId = [](std::unordered_map<const void*, uint32_t>& ids, const void* object)
+		{
+			return ids.try_emplace(object, static_cast<uint32_t>(ids.size())).first->second;
+		};
+
+		m_SortEntries.clear();
+		m_SortEntries.reserve(m_Batches.size());
+		for (uint32_t i = 0; i < m_Batches.size(); ++i)
+		{
+			const BatchData& batch = m_Batches[i];
+			const void* pipeline = batch.MaterialInstance ? batch.MaterialInstance->GetPipeline().get() : nullptr;
+			const uint64_t key = MakeDrawSortKey(denseId(m_SortPipelineIds, pipeline),
+			                                     denseId(m_SortMaterialIds, batch.MaterialInstance.get()),
+			                                     denseId(m_SortMeshIds, batch.Mesh.get()));
+			m_SortEntries.push_back({key, i});
+		}
+		RadixSortDraws(m_SortEntries, m_SortScratch);
+
+		m_BatchOrder.resize(m_SortEntries.size());
+		for (size_t i = 0; i < m_SortEntries.size(); ++i)
+		{
+			m_BatchOrder[i] = m_SortEntries[i].Index;
+		}
+		return m_BatchOrder;
+	}
+
 	Ref<DescriptorSet> RendererService::AcquireFrameSet(const Ref<Pipeline>& pipeline, const uint32_t frameIndex)
 	{
 		const auto& setLayouts = pipeline->GetSetLayouts();
 		SS_CORE_ASSERT(!setLayouts.empty() && setLayouts[0], "Pipeline missing set=0 (Frame) layout");
 
+		PrepareLightBuffers(frameIndex);
+
 		// One (set, UBO) per (pipeline, frameIndex). The UBO is kept alive in m_FrameUniformBuffers,
 		// keyed by the DescriptorSet* (avoids storing it on DescriptorSet itself).
 		auto& perFrameFrameSets = m_FrameSets[pipeline.get()];
@@ -295,6 +366,7 @@ namespace Snowstorm
 			bb.Offset = 0;
 			bb.Range = sizeof(FrameCB);
 			perFrameFrameSets[frameIndex]->SetBuffer(0, bb);
+			BindLightBuffers(*perFrameFrameSets[frameIndex], frameIndex);
 			perFrameFrameSets[frameIndex]->Commit();
 		}
 
@@ -309,13 +381,24 @@ namespace Snowstorm
 		frame.JitterUv = m_JitterUv;                // TAA jitter (UV) for GI/AO/refl screen-UV samples; 0 unless jittered
 		frame.CameraPosition = fd.CameraPosition;
 		frame.Exposure = CVars::Exposure.Get();
-		frame.Lights = fd.Lights;
+		// Light block: the directional array and shadow payloads ride FrameCB; the point/spot counts are what
+		// PrepareLightBuffers actually uploaded, so the shader never indexes past the buffers.
+		const LightBuffers& lightBuffers = m_LightBuffers[frameIndex];
+		std::copy(std::begin(fd.Lights.Lights), std::end(fd.Lights.Lights), std::begin(frame.Lights.Lights));
+		frame.Lights.LightCount = fd.Lights.LightCount;
+		frame.Lights.PointCount = static_cast<int>(lightBuffers.PointCount);
+		frame.Lights.SpotCount = static_cast<int>(lightBuffers.SpotCount);
+		std::copy(std::begin(fd.Lights.PointShadows), std::end(fd.Lights.PointShadows), std::begin(frame.Lights.PointShadows));
+		frame.Lights.PointShadowCount = fd.Lights.PointShadowCount;
+		frame.Lights.Clusters = AcquireLightClusters(frameIndex);
 		frame.SkyZenithColor = fd.Environment.SkyZenithColor;
 		frame.SkyHorizonColor = fd.Environment.SkyHorizonColor;
 		frame.GroundColor = fd.Environment.GroundColor;
 		frame.SkyIntensity = fd.Environment.SkyIntensity;
-		frame.LightViewProj = fd.Shadow.LightViewProj;
-		frame.ShadowMapIndex = fd.Shadow.ShadowMapIndex;
+		std::copy(fd.Shadow.CascadeViewProj.begin(), fd.Shadow.CascadeViewProj.end(), std::begin(frame.CascadeViewProj));
+		frame.CascadeMapIndex = glm::uvec4(fd.Shadow.CascadeMapIndex[0], fd.Shadow.CascadeMapIndex[1],
+		                                   fd.Shadow.CascadeMapIndex[2], fd.Shadow.CascadeMapIndex[3]);
+		frame.CascadeCount = fd.Shadow.CascadeCount;
 		frame.ShadowStrength = CVars::ShadowStrength.Get();
 		frame.ShadowSoft = CVars::ShadowSoft.Get() ? 1u : 0u;
 		frame.ShadowTexelSize = 1.0f / static_cast<float>(fd.Shadow.ShadowResolution != 0 ? fd.Shadow.ShadowResolution : 2048u);
@@ -405,6 +488,157 @@ namespace Snowstorm
 		return perFrameFrameSets[frameIndex];
 	}
 
+	void RendererService::PrepareLightBuffers(const uint32_t frameIndex)
+	{
+		if (m_LightBuffers.size() <= frameIndex)
+		{
+			m_LightBuffers.resize(std::max<size_t>(Renderer::GetFramesInFlight(), frameIndex + 1));
+		}
+		LightBuffers& lb = m_LightBuffers[frameIndex];
+		if (lb.Points && lb.PreparedFrame == m_FrameCounter)
+		{
+			return;
+		}
+		lb.PreparedFrame = m_FrameCounter;
+		lb.Grids.clear();
+		lb.GridCursor = 0;
+		lb.IndexCursor = 0;
+
+		// Grow in whole power-of-two element counts (never below one: an unbound StructuredBuffer is invalid
+		// even when the shader loops zero times). The cluster/index buffers grow to the demand the busiest
+		// earlier frame recorded in AcquireLightClusters.
+		const std::vector<GPUPointLight>& points = m_FrameData.Lights.PointLights;
+		const std::vector<GPUSpotLight>& spots = m_FrameData.Lights.SpotLights;
+		bool grew = false;
+		const auto ensure = [&grew](Ref<Buffer>& buffer, uint32_t& capacity, const size_t needed, const size_t stride, const char* name)
+		{
+			if (buffer && capacity >= needed)
+			{
+				return;
+			}
+			capacity = std::bit_ceil(static_cast<uint32_t>(std::max<size_t>(needed, 1)));
+			buffer = Buffer::Create(static_cast<size_t>(capacity) * stride, BufferUsage::Storage, nullptr, true, name);
+			SS_CORE_ASSERT(buffer, "Failed to create light buffer");
+			grew = true;
+		};
+		ensure(lb.Points, lb.PointCapacity, points.size(), sizeof(GPUPointLight), "PointLightBuffer");
+		ensure(lb.Spots, lb.SpotCapacity, spots.size(), sizeof(GPUSpotLight), "SpotLightBuffer");
+		ensure(lb.Clusters, lb.GridCapacity, m_LightGridDemand, sizeof(GPULightCluster) * kLightClusterCount, "LightClusterBuffer");
+		ensure(lb.Indices, lb.IndexCapacity, m_LightIndexDemand, sizeof(uint32_t), "LightIndexBuffer");
+
+		lb.PointCount = static_cast<uint32_t>(points.size());
+		lb.SpotCount = static_cast<uint32_t>(spots.size());
+		if (!points.empty())
+		{
+			lb.Points->SetData(points.data(), points.size() * sizeof(GPUPointLight), 0);
+		}
+		if (!spots.empty())
+		{
+			lb.Spots->SetData(spots.data(), spots.size() * sizeof(GPUSpotLight), 0);
+		}
+
+		// Every set=0 Frame set of this frame-in-flight still points at the old buffers. None is bound yet
+		// this frame and the GPU is done with this frame index, so re-pointing them in place is safe.
+		if (grew)
+		{
+			for (auto& [pipeline, sets] : m_FrameSets)
+			{
+				if (frameIndex < sets.size() && sets[frameIndex])
+				{
+					BindLightBuffers(*sets[frameIndex], frameIndex);
+					sets[frameIndex]->Commit();
+				}
+			}
+		}
+	}
+
+	GPULightClusterParams RendererService::AcquireLightClusters(const uint32_t frameIndex)
+	{
+		LightBuffers& lb = m_LightBuffers[frameIndex];
+		if (!CVars::LightsClustered.Get() || (lb.PointCount == 0 && lb.SpotCount == 0))
+		{
+			return {};
+		}
+
+		// AcquireFrameSet runs per batch, so the common case is "this view already has a grid".
+		const FrameData& fd = m_FrameData;
+		for (const LightBuffers::Grid& grid : lb.Grids)
+		{
+			if (grid.ViewProjection == fd.ViewProjection && grid.View == fd.View)
+			{
+				return grid.Params;
+			}
+		}
+
+		// Bin exactly the lights PrepareLightBuffers uploaded (clamped in case a late UploadLights shrank the
+		// block since), so every index stays inside the bound buffers.
+		const LightClusterView view{fd.View, fd.ViewProjection};
+		const size_t pointCount = std::min<size_t>(lb.PointCount, fd.Lights.PointLights.size());
+		const size_t spotCount = std::min<size_t>(lb.SpotCount, fd.Lights.SpotLights.size());
+		BuildLightClusters(view, std::span(fd.Lights.PointLights.data(), pointCount),
+		                   std::span(fd.Lights.SpotLights.data(), spotCount), m_LightClusterScratch,
+		                   &Application::Get().GetServiceManager().GetService<JobSystem>());
+
+		GPULightClusterParams params = m_LightClusterScratch.Params;
+		if (params.Enabled != 0)
+		{
+			const auto indexCount = static_cast<uint32_t>(m_LightClusterScratch.LightIndices.size());
+			m_LightGridDemand = std::max(m_LightGridDemand, lb.GridCursor + 1);
+			m_LightIndexDemand = std::max(m_LightIndexDemand, lb.IndexCursor + indexCount);
+
+			if (lb.GridCursor >= lb.GridCapacity || lb.IndexCursor + indexCount > lb.IndexCapacity)
+			{
+				// No room this frame (the buffers can't grow once draws have bound them): this view walks
+				// every light, and PrepareLightBuffers makes room from the next frame on.
+				params.Enabled = 0;
+			}
+			else
+			{
+				for (GPULightCluster& cluster : m_LightClusterScratch.Clusters)
+				{
+					cluster.Offset += lb.IndexCursor;
+				}
+				constexpr size_t kGridBytes = sizeof(GPULightCluster) * kLightClusterCount;
+				lb.Clusters->SetData(m_LightClusterScratch.Clusters.data(), kGridBytes, lb.GridCursor * kGridBytes);
+				if (indexCount != 0)
+				{
+					lb.Indices->SetData(m_LightClusterScratch.LightIndices.data(), indexCount * sizeof(uint32_t),
+					                    lb.IndexCursor * sizeof(uint32_t));
+				}
+				params.FirstCluster = lb.GridCursor * kLightClusterCount;
+				++lb.GridCursor;
+				lb.IndexCursor += indexCount;
+			}
+		}
+
+		lb.Grids.push_back({fd.View, fd.ViewProjection, params});
+		return params;
+	}
+
+	void RendererService::BindLightBuffers(DescriptorSet& frameSet, const uint32_t frameIndex) const
+	{
+		const LightBuffers& lb = m_LightBuffers[frameIndex];
+		const std::vector<DescriptorBindingDesc>& declared = frameSet.GetLayout()->GetDesc().Bindings;
+		const auto bind = [&](const uint32_t binding, const Ref<Buffer>& buffer)
+		{
+			const bool isDeclared = std::any_of(declared.begin(), declared.end(), [binding](const DescriptorBindingDesc& d)
+			                                    { return d.Binding == binding && d.Type == DescriptorType::StorageBuffer; });
+			if (!isDeclared || !buffer)
+			{
+				return;
+			}
+			BufferBinding bb{};
+			bb.Buffer = buffer;
+			bb.Offset = 0;
+			bb.Range = 0; // whole buffer
+			frameSet.SetBuffer(binding, bb);
+		};
+		bind(kPointLightBinding, lb.Points);
+		bind(kSpotLightBinding, lb.Spots);
+		bind(kLightClusterBinding, lb.Clusters);
+		bind(kLightIndexBinding, lb.Indices);
+	}
+
 	void RendererService::SetIBLData(const uint32_t irradianceIndex,
 	                                 const uint32_t prefilteredIndex,
 	                                 const uint32_t brdfLutIndex,
@@ -456,10 +690,16 @@ namespace Snowstorm
 		m_FrameIndex = 0;
 	}
 
-	void RendererService::SetShadowData(const glm::mat4& lightViewProj, const uint32_t shadowMapIndex, const uint32_t shadowResolution)
+	void RendererService::SetShadowData(const ShadowCascadeSet& cascades,
+	                                    const std::array<uint32_t, kMaxShadowCascades>& mapIndices,
+	                                    const uint32_t shadowResolution)
 	{
-		m_FrameData.Shadow.LightViewProj = lightViewProj;
-		m_FrameData.Shadow.ShadowMapIndex = shadowMapIndex;
+		for (uint32_t i = 0; i < kMaxShadowCascades; ++i)
+		{
+			m_FrameData.Shadow.CascadeViewProj[i] = i < cascades.Count ? cascades.Cascades[i].ViewProj : glm::mat4(1.0f);
+			m_FrameData.Shadow.CascadeMapIndex[i] = i < cascades.Count ? mapIndices[i] : 0u;
+		}
+		m_FrameData.Shadow.CascadeCount = cascades.Count;
 		if (shadowResolution != 0)
 		{
 			m_FrameData.Shadow.ShadowResolution = shadowResolution;
@@ -556,8 +796,9 @@ namespace Snowstorm
 		// objectSet is the same for every batch this pass.
 		m_CommandContext->BindDescriptorSet(objectSet, 2);
 
-		for (auto& batch : m_Batches)
+		for (const uint32_t index : SortedBatchOrder())
 		{
+			BatchData& batch = m_Batches[index];
 			if (batch.Instances.empty() || !batch.Mesh)
 				continue;
 
@@ -594,8 +835,9 @@ namespace Snowstorm
 		// One instanced draw per batch, appending into the shared instance buffer at the running cursor.
 		// The batches are NOT cleared here — the caller's BeginScene accumulation owns clearing (same
 		// contract as DrawBatchesDepthOnly).
-		for (auto& batch : m_Batches)
+		for (const uint32_t index : SortedBatchOrder())
 		{
+			BatchData& batch = m_Batches[index];
 			if (batch.Instances.empty() || !batch.Mesh)
 				continue;
 
@@ -641,8 +883,9 @@ namespace Snowstorm
 		m_CommandContext->BindDescriptorSets(1, {samplerSet, objectSet});
 		m_CommandContext->BindGlobalResources(); // set 3 = bindless textures for the albedo alpha sample
 
-		for (auto& batch : m_Batches)
+		for (const uint32_t index : SortedBatchOrder())
 		{
+			BatchData& batch = m_Batches[index];
 			if (batch.Instances.empty() || !batch.Mesh)
 				continue;
 
@@ -674,6 +917,14 @@ namespace Snowstorm
 
 		SS_CORE_ASSERT(batch.Mesh && batch.MaterialInstance, "Invalid batch");
 
+		// A material pipeline mid-rebuild on a worker (live MSAA change) has no VkPipeline to bind yet. Drop
+		// the batch for this frame rather than stall; it draws again once the background compile lands.
+		if (!batch.MaterialInstance->GetPipeline()->IsReady())
+		{
+			batch.Instances.clear();
+			return;
+		}
+
 		// Stats: one batch == one instanced DrawIndexed covering all its instances.
 		const auto batchInstanceCount = static_cast<uint32_t>(batch.Instances.size());
 		m_Stats.Batches += 1;
@@ -5,15 +5,20 @@
 #include "Mesh.hpp"
 
 #include "Snowstorm/Components/CameraRuntimeComponent.hpp"
+#include "Snowstorm/Lighting/LightClusters.hpp"
 #include "Snowstorm/Lighting/LightingUniforms.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetWriter.hpp"
 #include "Snowstorm/Render/DescriptorSet.hpp"
+#include "Snowstorm/Render/DrawSortKey.hpp"
 #include "Snowstorm/Render/FrameData.hpp"
 #include "Snowstorm/Render/MaterialInstance.hpp"
 #include "Snowstorm/Render/Pipeline.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
+#include "Snowstorm/Render/ShadowCascades.hpp"
 #include "Snowstorm/Render/Texture.hpp"
 #include "Snowstorm/Service/Service.hpp"
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
@@ -54,6 +59,25 @@ namespace Snowstorm
 		uint32_t Instances = 0; // total renderables submitted
 		uint32_t DrawCalls = 0; // vkCmdDrawIndexed invocations
 		uint32_t Triangles = 0; // total triangles submitted
+
+		// Binds the command context dropped this scene pass because the state was already bound (see
+		// SkippedBindStats). Batches are submitted sorted by pipeline, material and mesh, so these grow with
+		// how many batches share state -- the CPU submit cost the sort saves.
+		uint32_t PipelineBindsSkipped = 0;
+		uint32_t DescriptorBindsSkipped = 0; // descriptor sets, not calls
+		uint32_t BufferBindsSkipped = 0;     // vertex + index buffers
+
+		// Shadow maps this FRAME (not per scene pass: reset in NewFrame, kept across BeginScene): sun cascades
+		// plus spot/point atlas tiles, split into re-rendered and skipped because their cache entry still
+		// matched. The skip rate is the payoff of shadow caching in a mostly static scene.
+		uint32_t ShadowTilesRendered = 0;
+		uint32_t ShadowTilesSkipped = 0;
+
+		[[nodiscard]] float ShadowTileSkipRate() const
+		{
+			const uint32_t total = ShadowTilesRendered + ShadowTilesSkipped;
+			return total > 0 ? static_cast<float>(ShadowTilesSkipped) / static_cast<float>(total) : 0.0f;
+		}
 	};
 
 	// Application-scoped renderer subsystem: owns per-frame batching, descriptor-set caches, and FrameCB
@@ -93,7 +117,10 @@ namespace Snowstorm
 		              const glm::vec4& perInstanceCustomData = glm::vec4(0.0f),
 		              const glm::mat4& prevTransform = glm::mat4(1.0f));
 
-		void UploadLights(const LightDataBlock& lightData);
+		// This frame's lights (LightingSystem, once per frame before the passes). The point/spot vectors are
+		// copied into the frame-in-flight's light buffers at the first AcquireFrameSet of the frame, so a
+		// later upload in the same frame takes effect on the next one.
+		void UploadLights(LightDataBlock lightData);
 
 		// Scene environment (sky/ambient colors) for the current frame. Mirrors UploadLights; the values
 		// are folded into FrameCB and consumed by both the sky pass and the DefaultLit ambient term.
@@ -155,19 +182,21 @@ namespace Snowstorm
 		                     uint32_t frameIndex,
 		                     const TonemapParams& params);
 
-		// Set the directional shadow data the lit pass needs: the light's view-projection (world -> light
-		// clip), the bindless index of the shadow depth texture (0 = no shadows), and the shadow map's
-		// resolution (for the PCF texel-size). The camera pass's FrameCB picks these up so DefaultLit can
-		// reproject + compare. Pushed by ShadowPass; call before the camera Flush().
-		void SetShadowData(const glm::mat4& lightViewProj, uint32_t shadowMapIndex, uint32_t shadowResolution);
+		// Set the directional shadow data the lit pass needs: each cascade's view-projection (world -> light
+		// clip), the bindless index of its depth texture, and the maps' resolution (for the PCF texel-size).
+		// An empty set (Count 0) = no sun shadows. The camera pass's FrameCB picks these up so DefaultLit can
+		// pick a cascade, reproject + compare. Pushed by ShadowRenderer; call before the camera Flush().
+		void SetShadowData(const ShadowCascadeSet& cascades,
+		                   const std::array<uint32_t, kMaxShadowCascades>& mapIndices,
+		                   uint32_t shadowResolution);
 
-		// Bindless index of the spot shadow atlas (0 = spots unshadowed). Per-spot shadow matrices + atlas
+		// Bindless index of the shadow atlas for spots (0 = spots unshadowed). Per-spot shadow matrices + atlas
 		// rects travel inside the GPUSpotLight entries; this is the one shared texture index the shader needs.
 		void SetSpotShadowAtlasIndex(const uint32_t index) { m_FrameData.Shadow.SpotShadowAtlasIndex = index; }
 
-		// Bindless index of the point (omni) shadow atlas (0 = points unshadowed). Per-light 6-face matrices
-		// + tile rects travel inside the GPUPointShadow entries; this is the one shared texture index the
-		// shader needs. Mirrors SetSpotShadowAtlasIndex.
+		// Bindless index of the shadow atlas for point (omni) lights (0 = points unshadowed): the spots' atlas
+		// (they share one), kept as its own index so each light type gates on its own. Per-light 6-face
+		// matrices + tile rects travel inside the GPUPointShadow entries. Mirrors SetSpotShadowAtlasIndex.
 		void SetPointShadowAtlasIndex(const uint32_t index) { m_FrameData.Shadow.PointShadowAtlasIndex = index; }
 
 		// CPU-side directional-sun shadow fit, computed by LightingSystem (PreRender) and consumed by
@@ -255,9 +284,17 @@ namespace Snowstorm
 		// half-dozen separate getters). Read-only snapshot for the current frame.
 		[[nodiscard]] const FrameData& GetFrameData() const { return m_FrameData; }
 
-		// Stats from the most recently submitted scene pass (reset each BeginScene).
+		// Stats from the most recently submitted scene pass (reset each BeginScene), plus this frame's shadow
+		// tile counts (reset each NewFrame).
 		[[nodiscard]] const RenderStats& GetStats() const { return m_Stats; }
 
+		// ShadowRenderer reports how many shadow maps/tiles it re-rendered vs skipped (cache hit) this frame.
+		void AddShadowTileStats(const uint32_t rendered, const uint32_t skipped)
+		{
+			m_Stats.ShadowTilesRendered += rendered;
+			m_Stats.ShadowTilesSkipped += skipped;
+		}
+
 		// Monotonic frame counter, incremented once per NewFrame(). Drives the temporal jitter Halton index
 		// (#44); a general "which frame is this" primitive for any frame-phased effect. 64-bit — never wraps.
 		[[nodiscard]] uint64_t GetFrameCounter() const { return m_FrameCounter; }
@@ -283,11 +320,12 @@ namespace Snowstorm
 		void SetMetrics(const MetricsResult& m) { m_Metrics = m; }
 		[[nodiscard]] const MetricsResult& GetMetrics() const { return m_Metrics; }
 
-		// Number of dataset-export tuples written to disk so far (#46). Set by RenderSystem from the
-		// DatasetExportPass while dataset.export is on; read by the app loop to stop after N frames and by the
-		// editor panel for a progress readout.
-		void SetDatasetFramesWritten(const uint64_t n) { m_DatasetFramesWritten = n; }
-		[[nodiscard]] uint64_t GetDatasetFramesWritten() const { return m_DatasetFramesWritten; }
+		// Dataset-export writer progress (#46): tuples on disk, queue depth and backpressure stalls. Set by
+		// RenderSystem from the DatasetExportPass while dataset.export is on; FramesWritten is read by the app
+		// loop to stop after N frames, the rest by the editor's stats overlay.
+		void SetDatasetExportStats(const DatasetExportStats& stats) { m_DatasetExportStats = stats; }
+		[[nodiscard]] const DatasetExportStats& GetDatasetExportStats() const { return m_DatasetExportStats; }
+		[[nodiscard]] uint64_t GetDatasetFramesWritten() const { return m_DatasetExportStats.FramesWritten; }
 
 		// 1 once the headless quality capture (#153, quality.capture.frames) has written its .npy to disk. Set
 		// by RenderSystem from the QualityCapturePass; read by the app loop to exit after the single capture.
@@ -344,6 +382,21 @@ namespace Snowstorm
 		// sky pass so the FrameCB assembly (incl. InvViewProj) lives in exactly one place.
 		Ref<DescriptorSet> AcquireFrameSet(const Ref<Pipeline>& pipeline, uint32_t frameIndex);
 
+		// Copy this frame's point/spot lights into `frameIndex`'s light buffers (once per frame; later calls are
+		// no-ops). This is the only point at which those buffers may grow: nothing of this frame has bound
+		// them yet, and every cached frame set of `frameIndex` is re-pointed at the new buffers.
+		void PrepareLightBuffers(uint32_t frameIndex);
+
+		// The froxel grid for the current FrameData view: reused when this frame already built one for the
+		// same matrices, otherwise built (on the JobSystem) into the next free region of `frameIndex`'s
+		// cluster/index buffers. Enabled == 0 (the shader walks every light) when clustering is off, the view
+		// can't be sliced, or the buffers are full -- they grow to that frame's demand on the next frame.
+		GPULightClusterParams AcquireLightClusters(uint32_t frameIndex);
+
+		// Point bindings 1-4 of a set=0 Frame set at `frameIndex`'s light buffers (skipping any binding the
+		// pipeline's layout doesn't declare).
+		void BindLightBuffers(DescriptorSet& frameSet, uint32_t frameIndex) const;
+
 		// Ensure the per-frame instance storage buffer for `frameIndex` exists and can hold at least
 		// `additionalNeeded` more elements past the current write cursor; (re)allocates if needed.
 		void EnsureInstanceBuffer(uint32_t frameIndex, uint32_t additionalNeeded);
@@ -360,6 +413,9 @@ namespace Snowstorm
 		// instance-write + draw the depth and lit paths agree on).
 		bool WriteBatchInstancedDraw(BatchData& batch, const char* overflowContext);
 
+		// m_Batches indices in submission order (see m_BatchOrder), sorting them on first use after a change.
+		const std::vector<uint32_t>& SortedBatchOrder();
+
 	private:
 		Ref<CommandContext> m_CommandContext;
 		uint32_t m_FrameIndex = 0;
@@ -416,6 +472,23 @@ namespace Snowstorm
 		};
 		std::unordered_map<BatchKey, size_t, BatchKeyHash> m_BatchIndex;
 
+		// The order every pass walks m_Batches in: sorted by DrawSortKey (pipeline, material instance, mesh), so
+		// batches sharing a pipeline or material reach the command context back to back and its bind filter
+		// drops the repeats. Insertion order -- a scene walk's -- interleaves them. Sorted lazily on the first
+		// pass after DrawMesh adds a batch and reused by the passes after it (shadow, velocity, depth-normal,
+		// lit); BeginScene clears it. The id maps and entry buffers are kept only so the per-scene sort reuses
+		// their storage.
+		std::vector<uint32_t> m_BatchOrder;
+		bool m_BatchOrderDirty = false;
+		std::vector<DrawSortEntry> m_SortEntries;
+		std::vector<DrawSortEntry> m_SortScratch;
+		std::unordered_map<const void*, uint32_t> m_SortPipelineIds;
+		std::unordered_map<const void*, uint32_t> m_SortMaterialIds;
+		std::unordered_map<const void*, uint32_t> m_SortMeshIds;
+
+		// The context's cumulative skipped-bind counters at BeginScene; EndScene diffs against them.
+		SkippedBindStats m_SkippedBindsAtBegin;
+
 		// Cached per-pipeline sets, per frame-in-flight
 		std::unordered_map<const Pipeline*, std::vector<Ref<DescriptorSet>>> m_FrameSets;
 		std::unordered_map<const Pipeline*, std::vector<Ref<DescriptorSet>>> m_ObjectSets;
@@ -429,6 +502,40 @@ namespace Snowstorm
 		uint32_t m_InstanceBufferCapacity = 0;      // in InstanceData elements
 		uint32_t m_InstanceWriteCursor = 0;         // elements written this frame
 
+		// Clustered forward lighting: per frame-in-flight, the frame's point/spot lights and every froxel grid
+		// built this frame (one per distinct view; each a kLightClusterCount slice of Clusters plus a run of
+		// Indices), bound beside FrameCB as set 0 bindings 1-4. Host-visible like the instance buffer, and
+		// sized in whole elements with power-of-two growth that only happens in PrepareLightBuffers.
+		struct LightBuffers
+		{
+			Ref<Buffer> Points;
+			Ref<Buffer> Spots;
+			Ref<Buffer> Clusters;
+			Ref<Buffer> Indices;
+			uint32_t PointCapacity = 0;
+			uint32_t SpotCapacity = 0;
+			uint32_t GridCapacity = 0;  // whole grids (kLightClusterCount clusters each)
+			uint32_t IndexCapacity = 0;
+
+			uint64_t PreparedFrame = 0; // m_FrameCounter of the last PrepareLightBuffers (0 = never)
+			uint32_t PointCount = 0;    // lights actually uploaded this frame (the FrameCB counts)
+			uint32_t SpotCount = 0;
+
+			struct Grid
+			{
+				glm::mat4 View{1.0f};
+				glm::mat4 ViewProjection{1.0f};
+				GPULightClusterParams Params;
+			};
+			std::vector<Grid> Grids;  // every view seen this frame (including ones left unclustered)
+			uint32_t GridCursor = 0;  // grids written to Clusters this frame
+			uint32_t IndexCursor = 0; // indices written to Indices this frame
+		};
+		std::vector<LightBuffers> m_LightBuffers; // indexed by frame-in-flight
+		uint32_t m_LightGridDemand = 0;  // grids / indices the busiest frame asked for; the next
+		uint32_t m_LightIndexDemand = 0; // PrepareLightBuffers grows the buffers to fit them
+		LightClusterGrid m_LightClusterScratch; // reused build output (keeps its allocations)
+
 		uint64_t m_FrameCounter = 0;      // monotonic; ++ per NewFrame() (temporal jitter index, #44)
 		float m_MipBias = 0.0f;           // texture mip-LOD bias for the current scene pass (TAA, #44)
 		glm::vec2 m_JitterUv{0.0f, 0.0f}; // TAA jitter (UV units) for the current pass; 0 unless jittered
@@ -442,8 +549,8 @@ namespace Snowstorm
 		// Latest upscaled-vs-ground-truth image metrics (#45), set by RenderSystem when render.metrics is on.
 		MetricsResult m_Metrics;
 
-		// Running count of dataset-export tuples written to disk (#46), set by RenderSystem when exporting.
-		uint64_t m_DatasetFramesWritten = 0;
+		// Dataset-export writer stats (#46), set by RenderSystem when exporting.
+		DatasetExportStats m_DatasetExportStats;
 
 		// 1 once the headless quality capture (#153) has written its .npy (set by RenderSystem).
 		uint64_t m_QualityCaptureWritten = 0;
@@ -273,7 +273,8 @@ namespace Snowstorm
 		return TextureView::Create(img, v);
 	}
 
-	Ref<RenderTarget> CreateShadowDepthTarget(const uint32_t size, const char* debugPrefix)
+	Ref<RenderTarget> CreateShadowDepthTarget(const uint32_t size, const char* debugPrefix,
+	                                          const RenderTargetLoadOp depthLoadOp)
 	{
 		TextureDesc depthDesc{};
 		depthDesc.Dimension = TextureDimension::Texture2D;
@@ -297,7 +298,7 @@ namespace Snowstorm
 		DepthStencilAttachment depthAtt{};
 		depthAtt.View = depthView;
 		depthAtt.ClearDepth = 1.0f;
-		depthAtt.DepthLoadOp = RenderTargetLoadOp::Clear;
+		depthAtt.DepthLoadOp = depthLoadOp;
 		depthAtt.DepthStoreOp = RenderTargetStoreOp::Store;
 		rtDesc.DepthAttachment = depthAtt;
 
@@ -78,8 +78,10 @@ namespace Snowstorm
 
 	// Depth-only, square render target for a directional shadow map: a D32_Float depth texture that is
 	// both a depth attachment (written by the shadow pass) and sampled (read by the lit shader). No color
-	// attachment. Sampled usage auto-registers it for bindless sampling.
-	Ref<RenderTarget> CreateShadowDepthTarget(uint32_t size, const char* debugPrefix);
+	// attachment. Sampled usage auto-registers it for bindless sampling. The shadow atlases pass Load, so
+	// tiles that aren't re-rendered keep last frame's depth (each re-rendered tile is cleared in-pass).
+	Ref<RenderTarget> CreateShadowDepthTarget(uint32_t size, const char* debugPrefix,
+	                                          RenderTargetLoadOp depthLoadOp = RenderTargetLoadOp::Clear);
 
 	// Camera-view partial G-buffer for half-res RT GI (#124): world-space normal in an RGBA16F color
 	// attachment + a D32 depth attachment that is ALSO Sampled (unlike the scene target's write-only
@@ -3,6 +3,7 @@
 
 #include "Snowstorm/Core/Log.hpp"
 
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanSampler.hpp"
 
 namespace Snowstorm
@@ -22,6 +23,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanSampler>(desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullSampler>(desc);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 samplers are not implemented yet.");
 			return nullptr;
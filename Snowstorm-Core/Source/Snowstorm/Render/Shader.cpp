@@ -1,15 +1,19 @@
 #include "Shader.hpp"
 
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanShader.hpp"
 
 #include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
 #include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Core/Log.hpp"
 
 #include "RendererAPI.hpp"
+#include "ShaderDependencies.hpp"
 
 #include <algorithm>
 #include <filesystem>
+#include <unordered_set>
 
 namespace Snowstorm
 {
@@ -28,6 +32,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanShader>(filepath);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(filepath);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 shader backend not implemented yet.");
 			return nullptr;
@@ -52,6 +59,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanShader>(vertPath, fragPath);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullShader>(vertPath + "|" + fragPath);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 shader backend not implemented yet.");
 			return nullptr;
@@ -76,17 +86,18 @@ namespace Snowstorm
 
 		auto shader = Shader::Create(filepath);
 		Add(shader, filepath);
-		SubmitAsyncCompile(shader);
+		(void)SubmitAsyncCompile(shader);
 
-		m_LastModifications[filepath] = std::filesystem::last_write_time(filepath);
+		TrackDependencies(filepath);
+		m_LastModifications[filepath] = NewestDependencyTime(filepath);
 
 		return shader;
 	}
 
 	Ref<Shader> ShaderLibrary::Load(const std::string& vertPath, const std::string& fragPath)
 	{
-		// Key on the composite so a (vert, frag) pair is one library entry; hot-reload watches the newer
-		// of the two files (editing either re-triggers). See ReloadAll's composite-key handling.
+		// Key on the composite so a (vert, frag) pair is one library entry; hot-reload tracks both files and
+		// their include closures (editing any of them re-triggers). See TrackDependencies.
 		const std::string key = vertPath + "|" + fragPath;
 		if (Exists(key))
 		{
@@ -95,15 +106,20 @@ namespace Snowstorm
 
 		auto shader = Shader::Create(vertPath, fragPath);
 		Add(shader, key);
-		SubmitAsyncCompile(shader);
+		(void)SubmitAsyncCompile(shader);
 
-		m_LastModifications[key] = std::max(std::filesystem::last_write_time(vertPath),
-		                                    std::filesystem::last_write_time(fragPath));
+		TrackDependencies(key);
+		m_LastModifications[key] = NewestDependencyTime(key);
 
 		return shader;
 	}
 
-	void ShaderLibrary::SubmitAsyncCompile(const Ref<Shader>& shader)
+	std::future<void> ShaderLibrary::RecompileAsync(const Ref<Shader>& shader)
+	{
+		return SubmitAsyncCompile(shader);
+	}
+
+	std::future<void> ShaderLibrary::SubmitAsyncCompile(const Ref<Shader>& shader)
 	{
 		// Compile off the main thread so a cold cache (dxc.exe spawn per stage, seconds total) doesn't
 		// block the frame loop — the editor keeps presenting chrome + sky + a progress bar while shaders
@@ -125,14 +141,16 @@ namespace Snowstorm
 		{
 			shader->Recompile();
 			m_PendingCompiles.fetch_sub(1, std::memory_order_relaxed);
-			return;
+			std::promise<void> done;
+			done.set_value();
+			return done.get_future();
 		}
 
 		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
 		// Capture the Ref by value so the shader stays alive until the compile finishes even if the library
 		// entry is replaced. Recompile() is thread-safe (see VulkanShader::Compile).
-		(void)jobs.Submit([this, shader]
-		                  {
+		return jobs.Submit([this, shader]
+		                   {
 			shader->Recompile();
 			m_PendingCompiles.fetch_sub(1, std::memory_order_relaxed); });
 	}
@@ -148,30 +166,112 @@ namespace Snowstorm
 		return m_Shaders.contains(filepath);
 	}
 
-	void ShaderLibrary::ReloadAll()
+	void ShaderLibrary::TrackDependencies(const std::string& key)
 	{
-		for (auto& [key, lastModified] : m_LastModifications)
+		// Drop the entry's old edges first: a recompile after an edit may have removed an #include.
+		if (const auto it = m_Dependencies.find(key); it != m_Dependencies.end())
+		{
+			for (const std::string& file : it->second)
+			{
+				auto& dependents = m_Dependents[file];
+				std::erase(dependents, key);
+				if (dependents.empty())
+				{
+					m_Dependents.erase(file);
+				}
+			}
+		}
+
+		// A key is a single path or a composite "vert|frag"; each constituent file is a dependency together with
+		// its include closure. Resolved like dxc does (relative to the includer, then the -I shaders root).
+		const std::vector<std::filesystem::path> includeDirs{"Engine/Shaders"};
+		std::vector<std::string> files;
+		const auto addFile = [&](const std::string& source)
 		{
-			// A key may be a single path or a composite "vert|frag" (two-path graphics shader). Take the
-			// newest mtime across its constituent file(s) so editing either stage triggers a recompile.
-			std::filesystem::file_time_type newest{};
-			const size_t sep = key.find('|');
-			if (sep == std::string::npos)
+			files.push_back(FileWatcher::MakeKey(source));
+			for (const std::filesystem::path& header : CollectShaderIncludes(source, includeDirs))
 			{
-				newest = std::filesystem::last_write_time(key);
+				files.push_back(FileWatcher::MakeKey(header));
 			}
-			else
+		};
+		if (const size_t sep = key.find('|'); sep == std::string::npos)
+		{
+			addFile(key);
+		}
+		else
+		{
+			addFile(key.substr(0, sep));
+			addFile(key.substr(sep + 1));
+		}
+		std::ranges::sort(files);
+		files.erase(std::ranges::unique(files).begin(), files.end());
+
+		for (const std::string& file : files)
+		{
+			m_Dependents[file].push_back(key);
+		}
+		m_Dependencies[key] = std::move(files);
+	}
+
+	std::filesystem::file_time_type ShaderLibrary::NewestDependencyTime(const std::string& key) const
+	{
+		std::filesystem::file_time_type newest{};
+		const auto it = m_Dependencies.find(key);
+		if (it == m_Dependencies.end())
+		{
+			return newest;
+		}
+		for (const std::string& file : it->second)
+		{
+			// A header deleted mid-edit is skipped, not fatal: the recompile it triggers reports the missing include.
+			std::error_code ec;
+			const auto time = std::filesystem::last_write_time(file, ec);
+			if (!ec)
 			{
-				newest = std::max(std::filesystem::last_write_time(key.substr(0, sep)),
-				                  std::filesystem::last_write_time(key.substr(sep + 1)));
+				newest = std::max(newest, time);
 			}
+		}
+		return newest;
+	}
 
+	void ShaderLibrary::ReloadAll()
+	{
+		// Polling fallback (no FileWatcher, or it overflowed): the newest mtime over each entry's whole dependency
+		// set, so editing a header triggers its dependents here too, not only through OnFilesChanged.
+		for (auto& [key, lastModified] : m_LastModifications)
+		{
+			const std::filesystem::file_time_type newest = NewestDependencyTime(key);
 			if (newest > lastModified)
 			{
 				Get(key)->Recompile();
 				lastModified = newest;
+				TrackDependencies(key);
 			}
 		}
 	}
 
+	uint32_t ShaderLibrary::OnFilesChanged(const std::vector<std::string>& changedFiles)
+	{
+		// Collect the affected entries first (a shared header maps to many, and one save is often several
+		// events), so each is recompiled once.
+		std::unordered_set<std::string> affected;
+		for (const std::string& file : changedFiles)
+		{
+			if (const auto it = m_Dependents.find(file); it != m_Dependents.end())
+			{
+				affected.insert(it->second.begin(), it->second.end());
+			}
+		}
+
+		for (const std::string& key : affected)
+		{
+			SS_CORE_INFO("Shader hot reload: {}", key);
+			// Synchronous, like the polling path: the caller rebuilds pipelines right after, and a hot reload
+			// touches a handful of shaders at most.
+			Get(key)->Recompile();
+			m_LastModifications[key] = NewestDependencyTime(key);
+			TrackDependencies(key);
+		}
+		return static_cast<uint32_t>(affected.size());
+	}
 }
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <atomic>
-#include <unordered_map>
 #include <filesystem>
+#include <future>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -88,8 +88,13 @@ namespace Snowstorm
 		virtual void Compile() = 0;
 	};
 
-	// Application-scoped shader cache: owns compiled shaders keyed by source path and drives hot-reload
-	// (ReloadAll re-checks mtimes). Device-lifetime, shared across every World (see RegisterCoreServices).
+	// Application-scoped shader cache: owns compiled shaders keyed by source path and drives hot-reload.
+	// Device-lifetime, shared across every World (see RegisterCoreServices).
+	//
+	// Hot reload is event-driven: each entry records its include closure (ShaderDependencies), and
+	// OnFilesChanged maps a FileWatcher event back through that graph to exactly the entries that depend on
+	// the touched file. ReloadAll (mtime poll over the same closures) remains as the fallback for when the
+	// watcher is unavailable or dropped events.
 	class ShaderLibrary final : public Service
 	{
 	public:
@@ -102,6 +107,15 @@ namespace Snowstorm
 
 		void ReloadAll();
 
+		// Recompile an already-loaded shader on a JobSystem worker (synchronously without one) — e.g. after a
+		// SetPermutation. The shader keeps serving its current SPIR-V until the new one is published; the future
+		// is ready at that point (its version has advanced unless the compile failed).
+		std::future<void> RecompileAsync(const Ref<Shader>& shader);
+
+		// Recompile every shader whose source or include closure contains one of `changedFiles`
+		// (FileWatcher::MakeKey form). Returns how many were recompiled; 0 = none of the files is a dependency.
+		uint32_t OnFilesChanged(const std::vector<std::string>& changedFiles);
+
 		// Async-compile progress for a loading bar (same idiom as AssetManagerSingleton's
 		// PendingLoadCount/Total). PendingCompileCount = shaders still compiling right now; PendingCompileTotal
 		// = high-water mark since the queue was last empty, so a bar reads "compiled = total - pending".
@@ -113,11 +127,22 @@ namespace Snowstorm
 
 		// Kick a shader's compile onto a JobSystem worker (falls back to synchronous if no JobSystem), and
 		// track it for the progress counters. Shared by both Load overloads.
-		void SubmitAsyncCompile(const Ref<Shader>& shader);
+		std::future<void> SubmitAsyncCompile(const Ref<Shader>& shader);
+
+		// (Re)scan the include closure of library entry `key` and rebuild its edges in the dependency maps. Run
+		// at Load and after every recompile (an edit can add or drop an #include).
+		void TrackDependencies(const std::string& key);
+
+		// Newest mtime across an entry's whole dependency set (its source file(s) and every header they reach).
+		std::filesystem::file_time_type NewestDependencyTime(const std::string& key) const;
 
 		std::unordered_map<std::string, Ref<Shader>> m_Shaders;
 		std::unordered_map<std::string, std::filesystem::file_time_type> m_LastModifications;
 
+		// The per-shader include-dependency graph, both directions. Files are FileWatcher::MakeKey strings.
+		std::unordered_map<std::string, std::vector<std::string>> m_Dependencies; // library key -> files
+		std::unordered_map<std::string, std::vector<std::string>> m_Dependents;   // file -> library keys
+
 		// In-flight async compiles. Incremented on submit, decremented by the worker when done. Atomic
 		// because workers touch the count off the main thread; the total resets to 0 when the count hits 0.
 		std::atomic<uint32_t> m_PendingCompiles{0};
@@ -0,0 +1,175 @@
+#include "ShaderBundle.hpp"
+
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
+#include "Snowstorm/Core/Log.hpp"
+
+#include <fstream>
+#include <unordered_set>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		constexpr uint32_t kMagic = 0x42535353; // "SSSB"
+		constexpr uint32_t kVersion = 1;
+
+		// Layout: Header, then Count index records { u32 nameLen, name, u64 offset, u64 size }, then the blobs.
+		// Offsets are absolute file positions.
+		struct Header
+		{
+			uint32_t Magic = kMagic;
+			uint32_t Version = kVersion;
+			uint32_t Count = 0;
+			uint32_t Reserved = 0;
+		};
+
+		// Guards a corrupt length field from turning into a multi-GB allocation.
+		constexpr uint32_t kMaxNameLength = 1024;
+	}
+
+	std::filesystem::path ShaderBundle::GetDefaultPath()
+	{
+		return "Engine/Shaders.ssbundle";
+	}
+
+	std::optional<ShaderBundle> ShaderBundle::Open(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in.is_open())
+			return std::nullopt;
+
+		Header h{};
+		in.read(reinterpret_cast<char*>(&h), sizeof(h));
+		if (!in || h.Magic != kMagic || h.Version != kVersion)
+			return std::nullopt;
+
+		std::error_code ec;
+		const uint64_t fileSize = std::filesystem::file_size(path, ec);
+		if (ec)
+			return std::nullopt;
+
+		ShaderBundle bundle;
+		bundle.m_Path = path;
+		bundle.m_Index.reserve(h.Count);
+		for (uint32_t i = 0; i < h.Count; ++i)
+		{
+			uint32_t nameLength = 0;
+			in.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+			if (!in || nameLength == 0 || nameLength > kMaxNameLength)
+				return std::nullopt;
+
+			std::string name(nameLength, '\0');
+			Location loc;
+			in.read(name.data(), nameLength);
+			in.read(reinterpret_cast<char*>(&loc.Offset), sizeof(loc.Offset));
+			in.read(reinterpret_cast<char*>(&loc.Size), sizeof(loc.Size));
+			if (!in || loc.Offset + loc.Size > fileSize)
+			{
+				SS_CORE_WARN("ShaderBundle: {} is truncated or corrupt; ignoring it.", path.string());
+				return std::nullopt;
+			}
+			bundle.m_Index.emplace(std::move(name), loc);
+		}
+		return bundle;
+	}
+
+	bool ShaderBundle::Write(const std::filesystem::path& path, const std::vector<Entry>& entries)
+	{
+		std::vector<const Entry*> unique;
+		std::unordered_set<std::string> seen;
+		for (const Entry& e : entries)
+		{
+			if (!e.Name.empty() && e.Name.size() <= kMaxNameLength && seen.insert(e.Name).second)
+			{
+				unique.push_back(&e);
+			}
+		}
+
+		// Blobs start right after the index, so offsets are known before anything is written.
+		uint64_t offset = sizeof(Header);
+		for (const Entry* e : unique)
+		{
+			offset += sizeof(uint32_t) + e->Name.size() + 2 * sizeof(uint64_t);
+		}
+
+		std::error_code ec;
+		if (path.has_parent_path())
+		{
+			std::filesystem::create_directories(path.parent_path(), ec);
+		}
+
+		const auto tmp = DerivedDataCache::MakeTempPath(path);
+		{
+			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+				return false;
+
+			Header h{};
+			h.Count = static_cast<uint32_t>(unique.size());
+			out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+			for (const Entry* e : unique)
+			{
+				const uint32_t nameLength = static_cast<uint32_t>(e->Name.size());
+				const uint64_t size = e->Bytes.size();
+				out.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+				out.write(e->Name.data(), nameLength);
+				out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+				out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+				offset += size;
+			}
+			for (const Entry* e : unique)
+			{
+				out.write(reinterpret_cast<const char*>(e->Bytes.data()), static_cast<std::streamsize>(e->Bytes.size()));
+			}
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+		}
+		return DerivedDataCache::CommitTempFile(tmp, path);
+	}
+
+	std::optional<std::vector<uint8_t>> ShaderBundle::Read(const std::string& name) const
+	{
+		const auto it = m_Index.find(name);
+		if (it == m_Index.end())
+			return std::nullopt;
+
+		std::ifstream in(m_Path, std::ios::binary);
+		if (!in.is_open())
+			return std::nullopt;
+
+		std::vector<uint8_t> bytes(it->second.Size);
+		in.seekg(static_cast<std::streamoff>(it->second.Offset));
+		in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		if (!in)
+			return std::nullopt;
+		return bytes;
+	}
+
+	bool ShaderBundle::Extract(const std::string& name, const std::filesystem::path& dst) const
+	{
+		const std::optional<std::vector<uint8_t>> bytes = Read(name);
+		if (!bytes)
+			return false;
+
+		std::error_code ec;
+		std::filesystem::create_directories(dst.parent_path(), ec);
+		const auto tmp = DerivedDataCache::MakeTempPath(dst);
+		{
+			std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+				return false;
+			out.write(reinterpret_cast<const char*>(bytes->data()), static_cast<std::streamsize>(bytes->size()));
+			if (!out)
+			{
+				out.close();
+				std::filesystem::remove(tmp, ec);
+				return false;
+			}
+		}
+		return DerivedDataCache::CommitTempFile(tmp, dst);
+	}
+}
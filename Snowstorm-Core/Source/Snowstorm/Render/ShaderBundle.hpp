@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Packaged shader bundle (.ssbundle): every cooked SPIR-V permutation in one file, produced offline by
+	// Snowstorm-ShaderCook from the permutation manifest. Entries are named exactly like the runtime .spv cache
+	// files ("<stem>_<cachekey>.spv", see VulkanShader), so a runtime cache miss looks the name up here before
+	// it would ever spawn dxc: a shipped build (or a fresh checkout with a cooked bundle) never compiles a
+	// shader, and a permutation switch is a file extraction, not a compile.
+	//
+	// Only the index is read at open; blobs are read on demand by offset, so a bundle of every permutation
+	// costs nothing for the ones a session never uses.
+	class ShaderBundle
+	{
+	public:
+		struct Entry
+		{
+			std::string Name;           // cache file name, e.g. "DefaultLit.frag_0123456789abcdef.spv"
+			std::vector<uint8_t> Bytes; // SPIR-V
+		};
+
+		// Engine/Shaders.ssbundle, relative to the engine root (where the runtime looks for the shipped bundle).
+		static std::filesystem::path GetDefaultPath();
+
+		// Read the header + index. nullopt if missing or malformed (callers treat that as "no bundle").
+		static std::optional<ShaderBundle> Open(const std::filesystem::path& path);
+
+		// Write a bundle (atomic temp-then-rename). Duplicate names keep the first entry. False on failure.
+		static bool Write(const std::filesystem::path& path, const std::vector<Entry>& entries);
+
+		[[nodiscard]] bool Contains(const std::string& name) const { return m_Index.contains(name); }
+		[[nodiscard]] size_t Size() const { return m_Index.size(); }
+
+		// The blob for `name`, read from disk. nullopt if absent or the file is truncated.
+		[[nodiscard]] std::optional<std::vector<uint8_t>> Read(const std::string& name) const;
+
+		// Copy `name` out to `dst` atomically (the runtime cache fill). False if absent or on IO failure.
+		bool Extract(const std::string& name, const std::filesystem::path& dst) const;
+
+	private:
+		struct Location
+		{
+			uint64_t Offset = 0;
+			uint64_t Size = 0;
+		};
+
+		std::filesystem::path m_Path;
+		std::unordered_map<std::string, Location> m_Index;
+	};
+}
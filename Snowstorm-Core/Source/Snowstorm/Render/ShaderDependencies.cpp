@@ -0,0 +1,164 @@
+#include "ShaderDependencies.hpp"
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		std::string ReadText(const std::filesystem::path& p)
+		{
+			std::ifstream in(p, std::ios::in);
+			if (!in.is_open())
+			{
+				return {};
+			}
+			std::stringstream ss;
+			ss << in.rdbuf();
+			return ss.str();
+		}
+
+		std::filesystem::path Normalize(const std::filesystem::path& p)
+		{
+			std::error_code ec;
+			std::filesystem::path abs = std::filesystem::absolute(p, ec);
+			return (ec ? p : abs).lexically_normal();
+		}
+
+		bool IsSpace(const char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+	}
+
+	std::vector<std::string> ParseShaderIncludes(const std::string_view source)
+	{
+		std::vector<std::string> includes;
+
+		bool inBlockComment = false;
+		size_t lineStart = 0;
+		while (lineStart < source.size())
+		{
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string_view::npos)
+			{
+				lineEnd = source.size();
+			}
+			std::string_view line = source.substr(lineStart, lineEnd - lineStart);
+			lineStart = lineEnd + 1;
+
+			// Strip comments so a commented-out include doesn't count. Only the comment state is tracked across
+			// lines; string literals can't contain "/*" in anything a shader includes.
+			std::string code;
+			for (size_t i = 0; i < line.size(); ++i)
+			{
+				if (inBlockComment)
+				{
+					if (line[i] == '*' && i + 1 < line.size() && line[i + 1] == '/')
+					{
+						inBlockComment = false;
+						++i;
+					}
+					continue;
+				}
+				if (line[i] == '/' && i + 1 < line.size())
+				{
+					if (line[i + 1] == '/')
+					{
+						break;
+					}
+					if (line[i + 1] == '*')
+					{
+						inBlockComment = true;
+						++i;
+						continue;
+					}
+				}
+				code.push_back(line[i]);
+			}
+
+			// `#  include "X"` — whitespace is allowed around the '#'.
+			size_t i = 0;
+			while (i < code.size() && IsSpace(code[i]))
+			{
+				++i;
+			}
+			if (i >= code.size() || code[i] != '#')
+			{
+				continue;
+			}
+			++i;
+			while (i < code.size() && IsSpace(code[i]))
+			{
+				++i;
+			}
+			constexpr std::string_view kInclude = "include";
+			if (code.compare(i, kInclude.size(), kInclude) != 0)
+			{
+				continue;
+			}
+			i += kInclude.size();
+			while (i < code.size() && IsSpace(code[i]))
+			{
+				++i;
+			}
+			if (i >= code.size() || (code[i] != '"' && code[i] != '<'))
+			{
+				continue;
+			}
+			const char close = code[i] == '"' ? '"' : '>';
+			const size_t end = code.find(close, i + 1);
+			if (end == std::string::npos || end == i + 1)
+			{
+				continue;
+			}
+			includes.push_back(code.substr(i + 1, end - i - 1));
+		}
+
+		return includes;
+	}
+
+	std::vector<std::filesystem::path> CollectShaderIncludes(const std::filesystem::path& sourcePath,
+	                                                         const std::vector<std::filesystem::path>& includeDirs)
+	{
+		const std::filesystem::path root = Normalize(sourcePath);
+
+		std::set<std::filesystem::path> visited{root};
+		std::vector<std::filesystem::path> pending{root};
+		while (!pending.empty())
+		{
+			const std::filesystem::path file = std::move(pending.back());
+			pending.pop_back();
+
+			for (const std::string& include : ParseShaderIncludes(ReadText(file)))
+			{
+				std::vector<std::filesystem::path> candidates;
+				candidates.push_back(file.parent_path() / include);
+				for (const std::filesystem::path& dir : includeDirs)
+				{
+					candidates.push_back(dir / include);
+				}
+
+				for (const std::filesystem::path& candidate : candidates)
+				{
+					std::error_code ec;
+					if (!std::filesystem::is_regular_file(candidate, ec))
+					{
+						continue;
+					}
+					const std::filesystem::path resolved = Normalize(candidate);
+					if (visited.insert(resolved).second)
+					{
+						pending.push_back(resolved);
+					}
+					break;
+				}
+			}
+		}
+
+		visited.erase(root);
+		return {visited.begin(), visited.end()};
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Snowstorm
+{
+	// Shader include-dependency scanning: the per-shader dependency graph both halves of hot reload key off.
+	//   - VulkanShader folds the CONTENTS of a source's include closure into its .spv cache key, so editing a
+	//     header re-keys only the shaders that actually include it (the old key hashed every header in
+	//     Engine/Shaders/Include into every shader, so touching RTGeometry.hlsli recompiled Sky too);
+	//   - ShaderLibrary maps every file in a shader's closure back to the library keys that depend on it, so a
+	//     FileWatcher event for a header recompiles exactly its dependents.
+	// Backend-agnostic plain text scanning — no dxc round trip (`-M` would cost a process spawn per shader).
+
+	// The targets of every `#include "..."` / `#include <...>` directive in `source`, in order of appearance.
+	// Comments are skipped. Conditional directives are NOT evaluated: an include under #ifdef counts (a
+	// dependency we over-report only costs a spurious recompile; one we miss serves stale SPIR-V).
+	std::vector<std::string> ParseShaderIncludes(std::string_view source);
+
+	// Transitive include closure of `sourcePath`: each include is resolved relative to the including file
+	// first, then against each of `includeDirs` (dxc's -I order). Returned as absolute, lexically-normal paths,
+	// sorted and unique, excluding `sourcePath` itself. Unresolvable includes are skipped (dxc reports them);
+	// include cycles terminate.
+	std::vector<std::filesystem::path> CollectShaderIncludes(const std::filesystem::path& sourcePath,
+	                                                         const std::vector<std::filesystem::path>& includeDirs);
+}
@@ -0,0 +1,173 @@
+#include "ShaderPermutationManifest.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <tuple>
+
+namespace Snowstorm
+{
+	using json = nlohmann::json;
+
+	namespace
+	{
+		bool ReadVariants(const json& j, std::vector<ShaderDefines>& out)
+		{
+			if (!j.is_array())
+				return false;
+			out.clear();
+			for (const json& variant : j)
+			{
+				if (!variant.is_array())
+					return false;
+				ShaderDefines defines;
+				for (const json& define : variant)
+				{
+					if (!define.is_string())
+						return false;
+					defines.push_back(define.get<std::string>());
+				}
+				out.push_back(std::move(defines));
+			}
+			return true;
+		}
+
+		std::optional<ShaderStageKind> ParseStage(const std::string& name)
+		{
+			if (name == "Vertex")
+				return ShaderStageKind::Vertex;
+			if (name == "Fragment")
+				return ShaderStageKind::Fragment;
+			if (name == "Compute")
+				return ShaderStageKind::Compute;
+			return std::nullopt;
+		}
+
+		// '*' in the file-name part only ("dir/*.hlsl", "dir/Neural*.comp.hlsl"); one wildcard is enough for a
+		// shader folder and keeps this from growing into a glob engine.
+		bool MatchesPattern(const std::string& name, const std::string& pattern)
+		{
+			const size_t star = pattern.find('*');
+			if (star == std::string::npos)
+				return name == pattern;
+			const std::string prefix = pattern.substr(0, star);
+			const std::string suffix = pattern.substr(star + 1);
+			return name.size() >= prefix.size() + suffix.size() && name.starts_with(prefix) && name.ends_with(suffix);
+		}
+
+		// Engine-relative sources named by one manifest entry (a literal path, or a wildcard over one directory).
+		std::vector<std::string> ExpandSource(const std::string& source, const std::filesystem::path& root)
+		{
+			const std::filesystem::path pattern(source);
+			const std::string fileName = pattern.filename().string();
+			if (fileName.find('*') == std::string::npos)
+			{
+				return {pattern.generic_string()};
+			}
+
+			std::vector<std::string> sources;
+			std::error_code ec;
+			for (const auto& entry : std::filesystem::directory_iterator(root / pattern.parent_path(), ec))
+			{
+				const std::string name = entry.path().filename().string();
+				if (entry.is_regular_file(ec) && MatchesPattern(name, fileName))
+				{
+					sources.push_back((pattern.parent_path() / name).generic_string());
+				}
+			}
+			return sources;
+		}
+	}
+
+	std::filesystem::path ShaderPermutationManifestIO::GetDefaultPath()
+	{
+		return "Engine/Shaders/Permutations.json";
+	}
+
+	ShaderStageKind ShaderPermutationManifestIO::StageFromFileName(const std::string& fileName)
+	{
+		if (fileName.ends_with(".vert.hlsl"))
+			return ShaderStageKind::Vertex;
+		if (fileName.ends_with(".frag.hlsl"))
+			return ShaderStageKind::Fragment;
+		return ShaderStageKind::Compute;
+	}
+
+	std::optional<std::vector<ShaderPermutationJob>> ShaderPermutationManifestIO::Load(const std::filesystem::path& manifestPath,
+	                                                                                    const std::filesystem::path& root)
+	{
+		std::ifstream in(manifestPath);
+		if (!in.is_open())
+			return std::nullopt;
+
+		const json manifest = json::parse(in, nullptr, false);
+		if (manifest.is_discarded() || manifest.value("Type", "") != "SnowstormShaderPermutations")
+		{
+			SS_CORE_ERROR("Shader permutation manifest {} is not valid", manifestPath.string());
+			return std::nullopt;
+		}
+
+		std::vector<ShaderDefines> defaultVariants{{}};
+		if (manifest.contains("DefaultVariants") && !ReadVariants(manifest["DefaultVariants"], defaultVariants))
+		{
+			SS_CORE_ERROR("Shader permutation manifest {}: DefaultVariants must be an array of string arrays", manifestPath.string());
+			return std::nullopt;
+		}
+
+		if (!manifest.contains("Shaders") || !manifest["Shaders"].is_array())
+		{
+			SS_CORE_ERROR("Shader permutation manifest {} has no Shaders array", manifestPath.string());
+			return std::nullopt;
+		}
+
+		std::vector<ShaderPermutationJob> jobs;
+		for (const json& entry : manifest["Shaders"])
+		{
+			if (!entry.is_object() || !entry.contains("Source") || !entry["Source"].is_string())
+			{
+				SS_CORE_ERROR("Shader permutation manifest {}: every entry needs a Source", manifestPath.string());
+				return std::nullopt;
+			}
+
+			std::vector<ShaderDefines> variants = defaultVariants;
+			if (entry.contains("Variants") && !ReadVariants(entry["Variants"], variants))
+			{
+				SS_CORE_ERROR("Shader permutation manifest {}: bad Variants for {}", manifestPath.string(), entry["Source"].get<std::string>());
+				return std::nullopt;
+			}
+
+			std::optional<ShaderStageKind> stage;
+			if (entry.contains("Stage"))
+			{
+				stage = entry["Stage"].is_string() ? ParseStage(entry["Stage"].get<std::string>()) : std::nullopt;
+				if (!stage)
+				{
+					SS_CORE_ERROR("Shader permutation manifest {}: Stage must be Vertex, Fragment or Compute", manifestPath.string());
+					return std::nullopt;
+				}
+			}
+
+			for (const std::string& source : ExpandSource(entry["Source"].get<std::string>(), root))
+			{
+				const ShaderStageKind sourceStage = stage.value_or(StageFromFileName(std::filesystem::path(source).filename().string()));
+				for (const ShaderDefines& defines : variants)
+				{
+					jobs.push_back({source, sourceStage, defines});
+				}
+			}
+		}
+
+		// Overlapping entries (a wildcard plus an explicit override) must not compile the same thing twice.
+		const auto key = [](const ShaderPermutationJob& j)
+		{ return std::tie(j.Source, j.Stage, j.Defines); };
+		std::ranges::sort(jobs, [&](const ShaderPermutationJob& a, const ShaderPermutationJob& b)
+		                  { return key(a) < key(b); });
+		const auto dup = std::ranges::unique(jobs, [&](const ShaderPermutationJob& a, const ShaderPermutationJob& b)
+		                                     { return key(a) == key(b); });
+		jobs.erase(dup.begin(), dup.end());
+		return jobs;
+	}
+}
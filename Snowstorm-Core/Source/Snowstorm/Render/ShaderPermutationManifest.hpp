@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Snowstorm/Render/Shader.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	// One compile the offline cook performs: a single-stage source under one define set.
+	struct ShaderPermutationJob
+	{
+		std::string Source; // engine-relative, as ShaderLibrary loads it (e.g. "Engine/Shaders/Sky.frag.hlsl")
+		ShaderStageKind Stage = ShaderStageKind::Compute;
+		ShaderDefines Defines;
+	};
+
+	// The permutation manifest (Engine/Shaders/Permutations.json): the list of source × defines × profile
+	// combinations the engine can ask for at runtime, so Snowstorm-ShaderCook can compile all of them ahead of
+	// time instead of the first frame that needs one. Format:
+	//
+	//   { "Type": "SnowstormShaderPermutations", "Version": 1,
+	//     "DefaultVariants": [[], ["SS_RAYTRACING=1"], ...],      // define sets applied to every entry
+	//     "Shaders": [ { "Source": "Engine/Shaders/*.hlsl" },     // '*' wildcard in the file name only
+	//                  { "Source": "Engine/Shaders/X.hlsl", "Stage": "Compute", "Variants": [[...]] } ] }
+	//
+	// The profile is not spelled out per entry: it follows from the stage, which follows from the file name
+	// ("Foo.vert.hlsl" / ".frag" / ".comp"; a stage-less single-path shader is compute), exactly as the
+	// runtime decides it. A variant must list the same defines VulkanShader::Compile emits for that
+	// permutation, or the cooked .spv lands under a key nothing asks for.
+	class ShaderPermutationManifestIO
+	{
+	public:
+		static std::filesystem::path GetDefaultPath(); // Engine/Shaders/Permutations.json
+
+		// Expand the manifest into concrete jobs (wildcards resolved against `root`, the directory the engine-
+		// relative paths are relative to). Sorted and de-duplicated. nullopt if the file is missing/malformed.
+		static std::optional<std::vector<ShaderPermutationJob>> Load(const std::filesystem::path& manifestPath,
+		                                                             const std::filesystem::path& root);
+
+		// The stage a file name implies ("Foo.frag.hlsl" -> Fragment; no stage token -> Compute, the engine's
+		// single-path rule). Same rule as Scripts/cook-shaders.py.
+		static ShaderStageKind StageFromFileName(const std::string& fileName);
+	};
+}
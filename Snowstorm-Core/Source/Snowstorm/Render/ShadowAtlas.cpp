@@ -0,0 +1,359 @@
+#include "ShadowAtlas.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <unordered_set>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// A tile changes size only once its wanted size is this many octaves past the midpoint between its
+		// current size and the next one (so 0.75 octaves from the current size). Coverage drifts smoothly as
+		// the camera moves; without the band a light sitting near a size boundary would flip every frame.
+		constexpr float kSizeHysteresis = 0.25f;
+
+		uint32_t Log2(const uint32_t powerOfTwo)
+		{
+			return static_cast<uint32_t>(std::countr_zero(powerOfTwo));
+		}
+
+		uint32_t PowerOfTwoAtLeast(const uint32_t value, const uint32_t floor)
+		{
+			return std::bit_floor(std::max(value, floor));
+		}
+	}
+
+	float ShadowScreenCoverage(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& center, const float radius)
+	{
+		if (!(radius > 0.0f))
+		{
+			return 0.0f;
+		}
+
+		// projection[1][1] maps a view-space height to NDC: cot(fovY/2) for perspective, 2/(top-bottom) for
+		// ortho. NDC spans 2 units, so a sphere of NDC radius r covers r of the screen height.
+		const float yScale = std::abs(projection[1][1]);
+		if (projection[2][3] == 0.0f) // orthographic: no perspective divide
+		{
+			return std::min(radius * yScale, 1.0f);
+		}
+
+		const float distance = glm::length(glm::vec3(view * glm::vec4(center, 1.0f)));
+		if (distance <= radius)
+		{
+			return 1.0f;
+		}
+		// Tangent of the sphere's angular radius, so a close, large light isn't underestimated.
+		const float tangent = radius / std::sqrt(distance * distance - radius * radius);
+		return std::min(tangent * yScale, 1.0f);
+	}
+
+	void ShadowAtlasAllocator::Configure(const uint32_t atlasSize, const uint32_t maxTileSize)
+	{
+		const uint32_t atlas = PowerOfTwoAtLeast(atlasSize, kMinTileSize);
+		m_MaxTileSize = std::min(PowerOfTwoAtLeast(maxTileSize, kMinTileSize), atlas);
+		if (atlas != m_AtlasSize)
+		{
+			m_AtlasSize = atlas;
+			Reset();
+		}
+	}
+
+	void ShadowAtlasAllocator::Reset()
+	{
+		m_LevelCount = Log2(m_AtlasSize / kMinTileSize) + 1;
+		m_Nodes.assign(m_LevelCount, {});
+		for (uint32_t level = 0; level < m_LevelCount; ++level)
+		{
+			m_Nodes[level].assign(size_t{1} << (2 * level), NodeState::Free);
+		}
+		m_Placed.clear();
+	}
+
+	uint32_t ShadowAtlasAllocator::LevelForSize(const uint32_t size) const
+	{
+		return Log2(m_AtlasSize / size);
+	}
+
+	uint32_t ShadowAtlasAllocator::QuantizeSize(const float ideal, const uint32_t current) const
+	{
+		const auto lo = static_cast<float>(kMinTileSize);
+		const auto hi = static_cast<float>(m_MaxTileSize);
+		const float clamped = ideal > lo ? std::min(ideal, hi) : lo; // NaN reads as the smallest tile
+		const float octave = std::log2(clamped);
+		if (current >= kMinTileSize && current <= m_MaxTileSize &&
+		    std::abs(octave - std::log2(static_cast<float>(current))) < 0.5f + kSizeHysteresis)
+		{
+			return current;
+		}
+		const auto rounded = static_cast<uint32_t>(std::lround(octave));
+		return std::clamp(1u << rounded, kMinTileSize, m_MaxTileSize);
+	}
+
+	ShadowAtlasAllocator::NodeState& ShadowAtlasAllocator::Node(const uint32_t level, const uint32_t x, const uint32_t y)
+	{
+		return m_Nodes[level][(static_cast<size_t>(y) << level) + x];
+	}
+
+	bool ShadowAtlasAllocator::Reserve(const uint32_t level, Placement& out)
+	{
+		// Best fit: the smallest free node at or above `level` (the deepest reachable one). Taking an exact
+		// fit inside an already-split region first keeps large free nodes whole for large tiles.
+		bool found = false;
+		uint32_t bestLevel = 0;
+		uint32_t bestX = 0;
+		uint32_t bestY = 0;
+		const auto search = [&](const auto& self, const uint32_t l, const uint32_t x, const uint32_t y) -> void
+		{
+			if (found && bestLevel == level)
+			{
+				return;
+			}
+			const NodeState state = Node(l, x, y);
+			if (state == NodeState::Used)
+			{
+				return;
+			}
+			if (state == NodeState::Free)
+			{
+				if (!found || l > bestLevel)
+				{
+					found = true;
+					bestLevel = l;
+					bestX = x;
+					bestY = y;
+				}
+				return;
+			}
+			if (l == level) // split at the wanted size: partly used, can't hold the tile
+			{
+				return;
+			}
+			for (uint32_t child = 0; child < 4; ++child)
+			{
+				self(self, l + 1, 2 * x + (child & 1), 2 * y + (child >> 1));
+			}
+		};
+		search(search, 0, 0, 0);
+		if (!found)
+		{
+			return false;
+		}
+
+		// Split down from the free node to the wanted level along its first child.
+		uint32_t x = bestX;
+		uint32_t y = bestY;
+		for (uint32_t l = bestLevel; l < level; ++l)
+		{
+			Node(l, x, y) = NodeState::Split;
+			x *= 2;
+			y *= 2;
+			for (uint32_t child = 0; child < 4; ++child)
+			{
+				Node(l + 1, x + (child & 1), y + (child >> 1)) = NodeState::Free;
+			}
+		}
+		Node(level, x, y) = NodeState::Used;
+		out.Level = level;
+		out.X = x;
+		out.Y = y;
+		return true;
+	}
+
+	void ShadowAtlasAllocator::Release(const Placement& placement)
+	{
+		uint32_t l = placement.Level;
+		uint32_t x = placement.X;
+		uint32_t y = placement.Y;
+		Node(l, x, y) = NodeState::Free;
+
+		// Merge back up while all four siblings are free.
+		while (l > 0)
+		{
+			const uint32_t px = x / 2;
+			const uint32_t py = y / 2;
+			for (uint32_t child = 0; child < 4; ++child)
+			{
+				if (Node(l, 2 * px + (child & 1), 2 * py + (child >> 1)) != NodeState::Free)
+				{
+					return;
+				}
+			}
+			--l;
+			x = px;
+			y = py;
+			Node(l, x, y) = NodeState::Free;
+		}
+	}
+
+	void ShadowAtlasAllocator::Allocate(const std::span<const ShadowAtlasRequest> requests, std::vector<ShadowAtlasTile>& out)
+	{
+		out.assign(requests.size(), {});
+		if (m_AtlasSize == 0)
+		{
+			return;
+		}
+		++m_Frame;
+
+		// Serve order: descending priority, ties in request order (deterministic). Duplicate keys are dropped.
+		std::vector<size_t> order;
+		order.reserve(requests.size());
+		std::unordered_set<uint64_t> requested;
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			if (requested.insert(requests[i].Key).second)
+			{
+				order.push_back(i);
+			}
+		}
+		std::stable_sort(order.begin(), order.end(),
+		                 [&](const size_t a, const size_t b) { return requests[a].Priority > requests[b].Priority; });
+
+		// Tiles of lights gone this frame free their space before anything is placed.
+		for (auto it = m_Placed.begin(); it != m_Placed.end();)
+		{
+			if (!requested.contains(it->first))
+			{
+				Release(it->second);
+				it = m_Placed.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// Wanted sizes, with hysteresis against the size each key has now. Shrinking tiles release up front
+		// (their texels may be what a higher-priority light needs) and are placed again in their turn.
+		std::vector<uint32_t> wanted(requests.size(), 0);
+		for (const size_t i : order)
+		{
+			const auto it = m_Placed.find(requests[i].Key);
+			const uint32_t current = it != m_Placed.end() ? m_AtlasSize >> it->second.Level : 0;
+			wanted[i] = QuantizeSize(requests[i].IdealSize, current);
+		}
+
+		// Fit the wanted area to the atlas: sweep from the lowest priority up, halving each tile at most once
+		// per sweep, until the total fits (or everything is at the minimum). Low priorities shrink first and
+		// furthest, and many lights share the atlas at reduced size instead of most of them being dropped.
+		const auto area = [](const uint32_t size) { return static_cast<uint64_t>(size) * size; };
+		uint64_t wantedArea = 0;
+		for (const size_t i : order)
+		{
+			wantedArea += area(wanted[i]);
+		}
+		const uint64_t atlasArea = area(m_AtlasSize);
+		bool shrunk = true;
+		while (wantedArea > atlasArea && shrunk)
+		{
+			shrunk = false;
+			for (size_t rank = order.size(); rank-- > 0 && wantedArea > atlasArea;)
+			{
+				uint32_t& size = wanted[order[rank]];
+				if (size > kMinTileSize)
+				{
+					wantedArea -= area(size) - area(size / 2);
+					size /= 2;
+					shrunk = true;
+				}
+			}
+		}
+
+		for (const size_t i : order)
+		{
+			const auto it = m_Placed.find(requests[i].Key);
+			const uint32_t current = it != m_Placed.end() ? m_AtlasSize >> it->second.Level : 0;
+			if (current > wanted[i])
+			{
+				Release(it->second);
+				m_Placed.erase(it);
+			}
+		}
+
+		for (size_t rank = 0; rank < order.size(); ++rank)
+		{
+			const size_t i = order[rank];
+			const uint64_t key = requests[i].Key;
+			const uint32_t wantLevel = LevelForSize(wanted[i]);
+
+			if (const auto it = m_Placed.find(key); it != m_Placed.end())
+			{
+				// Kept. A tile that wants to grow moves only once a bigger tile is free: it never gives up
+				// the tile it has for nothing.
+				Placement& placement = it->second;
+				for (uint32_t level = wantLevel; level < placement.Level; ++level)
+				{
+					Placement bigger;
+					if (Reserve(level, bigger))
+					{
+						Release(placement);
+						placement = bigger;
+						break;
+					}
+				}
+				placement.Frame = m_Frame;
+			}
+			else
+			{
+				Placement placement;
+				bool placed = false;
+				while (!placed)
+				{
+					for (uint32_t level = wantLevel; level < m_LevelCount && !placed; ++level)
+					{
+						placed = Reserve(level, placement);
+					}
+					if (placed)
+					{
+						break;
+					}
+
+					// Full even at the smallest size: evict the lowest-priority tile not yet served this frame.
+					bool evicted = false;
+					for (size_t later = order.size(); later-- > rank + 1;)
+					{
+						const auto victim = m_Placed.find(requests[order[later]].Key);
+						if (victim != m_Placed.end() && victim->second.Frame != m_Frame)
+						{
+							Release(victim->second);
+							m_Placed.erase(victim);
+							evicted = true;
+							break;
+						}
+					}
+					if (!evicted)
+					{
+						break;
+					}
+				}
+				if (!placed)
+				{
+					continue;
+				}
+				placement.Frame = m_Frame;
+				m_Placed[key] = placement;
+			}
+
+			const Placement& placement = m_Placed[key];
+			const uint32_t size = m_AtlasSize >> placement.Level;
+			out[i] = {.X = placement.X * size, .Y = placement.Y * size, .Size = size};
+		}
+	}
+
+	float ShadowAtlasAllocator::GetOccupancy() const
+	{
+		if (m_AtlasSize == 0)
+		{
+			return 0.0f;
+		}
+		double texels = 0.0;
+		for (const auto& [key, placement] : m_Placed)
+		{
+			const double size = static_cast<double>(m_AtlasSize >> placement.Level);
+			texels += size * size;
+		}
+		return static_cast<float>(texels / (static_cast<double>(m_AtlasSize) * static_cast<double>(m_AtlasSize)));
+	}
+}
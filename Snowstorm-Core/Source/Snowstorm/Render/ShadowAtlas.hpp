@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Snowstorm/Math/Math.hpp"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Snowstorm
+{
+	// One tile wanted in the shadow atlas this frame (a spot light, or one cube face of a point light).
+	struct ShadowAtlasRequest
+	{
+		uint64_t Key = 0;        // stable across frames for the same light/face: what placement is remembered by
+		float IdealSize = 0.0f;  // wanted tile side in texels; quantized to a power of two within the tile range
+		float Priority = 0.0f;   // higher keeps its size (and its place) first when the atlas runs out of room
+	};
+
+	// Where a request landed, in atlas texels. Size == 0: not placed (the light renders unshadowed).
+	struct ShadowAtlasTile
+	{
+		uint32_t X = 0;
+		uint32_t Y = 0;
+		uint32_t Size = 0;
+	};
+
+	// Fraction (0..1) of the view's height a light's bounding sphere spans on screen, measured by distance only
+	// -- a light behind the camera still casts shadows into view, so direction is deliberately ignored. 1 when
+	// the camera is inside the sphere. Works for perspective and orthographic projections.
+	float ShadowScreenCoverage(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& center, float radius);
+
+	// Quadtree (buddy) allocator for one square shadow atlas. Tiles are power-of-two squares aligned to their
+	// own size, so any tile size mixes with any other without fragmenting into unusable slivers, and a freed
+	// tile merges back with its siblings. Pure CPU bookkeeping: the atlas texture and its rendering live in
+	// ShadowPass/ShadowRenderer, which only see the resulting rects.
+	//
+	// Placement is sticky: a key keeps its tile while its wanted size stays within a hysteresis band of the
+	// size it has, and a growing tile only moves once the bigger tile is actually free. That keeps tiles --
+	// and the per-tile shadow cache entries keyed by their rect -- still while lights and the camera move a
+	// little, instead of repacking every frame.
+	class ShadowAtlasAllocator
+	{
+	public:
+		static constexpr uint32_t kMinTileSize = 64;
+
+		// Set the atlas side and the largest tile handed out (both clamped to powers of two >= kMinTileSize, the
+		// tile to the atlas). A change of atlas size drops every placement; a change of max tile size keeps them
+		// (oversized ones shrink on the next Allocate).
+		void Configure(uint32_t atlasSize, uint32_t maxTileSize);
+
+		// Place this frame's requests; out[i] is requests[i]'s tile. Keys absent from `requests` release their
+		// tiles. When the quantized sizes add up to more than the atlas, the lowest priorities are halved first
+		// until they fit. Requests are then served in descending priority: each gets its size, or the largest
+		// smaller size that fits; if not even kMinTileSize fits, still-unserved tiles of lower priority are
+		// evicted (lowest first) until it does. Duplicate keys: only the first is placed.
+		void Allocate(std::span<const ShadowAtlasRequest> requests, std::vector<ShadowAtlasTile>& out);
+
+		[[nodiscard]] uint32_t GetAtlasSize() const { return m_AtlasSize; }
+		[[nodiscard]] uint32_t GetMaxTileSize() const { return m_MaxTileSize; }
+
+		// Texels covered by placed tiles over the atlas area (0..1).
+		[[nodiscard]] float GetOccupancy() const;
+
+	private:
+		enum class NodeState : uint8_t
+		{
+			Free,
+			Split,
+			Used
+		};
+
+		struct Placement
+		{
+			uint32_t Level = 0;
+			uint32_t X = 0; // node coordinates at Level (tile = (X, Y) * (atlas >> Level))
+			uint32_t Y = 0;
+			uint32_t Frame = 0; // last Allocate that kept it
+		};
+
+		[[nodiscard]] uint32_t LevelForSize(uint32_t size) const;
+		[[nodiscard]] uint32_t QuantizeSize(float ideal, uint32_t current) const;
+		NodeState& Node(uint32_t level, uint32_t x, uint32_t y);
+		bool Reserve(uint32_t level, Placement& out);
+		void Release(const Placement& placement);
+		void Reset();
+
+		uint32_t m_AtlasSize = 0;
+		uint32_t m_MaxTileSize = 0;
+		uint32_t m_LevelCount = 0; // levels 0 (whole atlas) .. m_LevelCount-1 (kMinTileSize tiles)
+		std::vector<std::vector<NodeState>> m_Nodes; // [level][y * (1 << level) + x]
+		std::unordered_map<uint64_t, Placement> m_Placed;
+		uint32_t m_Frame = 0;
+	};
+}
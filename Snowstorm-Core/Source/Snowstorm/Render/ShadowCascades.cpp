@@ -0,0 +1,211 @@
+#include "ShadowCascades.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Log splits need a positive near: an ortho camera's near can be 0 (or negative), so the log term
+		// starts no closer than this fraction of far. Same guard as the light-cluster slicing.
+		constexpr float kMinNearFraction = 1.0e-4f;
+
+		// Cached cascades snap to a grid this fraction of their radius (and pad the box by half a step so the
+		// slice stays covered): ~12% fewer texels per world unit, in exchange for a map that survives camera
+		// motion across most of a step instead of re-rendering on every texel crossed.
+		constexpr float kCachedSnapFraction = 0.125f;
+
+		// Slack on the light-space depth range, relative to its span, so casters exactly on the caster-bounds
+		// faces aren't clipped by the near/far planes.
+		constexpr float kDepthSlack = 0.01f;
+
+		bool IsFinite(const glm::mat4& m)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				for (int r = 0; r < 4; ++r)
+				{
+					if (!std::isfinite(m[c][r]))
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		// Round a radius up to a power-of-two-relative quantum (1/64 of its octave). The slice sphere's
+		// radius is mathematically constant, but its float evaluation wobbles by a few ulps as the camera
+		// moves; an unquantized wobble would rescale the map every frame and undo the texel snapping.
+		float QuantizeRadius(const float radius)
+		{
+			const float quantum = std::exp2(std::floor(std::log2(radius)) - 6.0f);
+			return std::ceil(radius / quantum) * quantum;
+		}
+	}
+
+	std::array<float, kMaxShadowCascades + 1> ComputeShadowCascadeSplits(const float nearDepth, const float farDepth,
+	                                                                     const uint32_t count, const float lambda)
+	{
+		const uint32_t n = std::clamp(count, 1u, kMaxShadowCascades);
+		const float blend = std::clamp(lambda, 0.0f, 1.0f);
+		const float logNear = std::max(nearDepth, farDepth * kMinNearFraction);
+
+		std::array<float, kMaxShadowCascades + 1> splits{};
+		splits.fill(farDepth);
+		splits[0] = nearDepth;
+		for (uint32_t i = 1; i < n; ++i)
+		{
+			const float t = static_cast<float>(i) / static_cast<float>(n);
+			const float logSplit = logNear * std::pow(farDepth / logNear, t);
+			const float uniformSplit = nearDepth + (farDepth - nearDepth) * t;
+			splits[i] = blend * logSplit + (1.0f - blend) * uniformSplit;
+		}
+		return splits;
+	}
+
+	bool FitShadowCascades(const glm::mat4& cameraView, const glm::mat4& cameraProjection, const glm::vec3& lightDir,
+	                       const AABB& casterBounds, const ShadowCascadeSettings& settings, ShadowCascadeSet& out)
+	{
+		out = {};
+
+		const glm::mat4 clipToView = glm::inverse(cameraProjection);
+		const glm::mat4 viewToWorld = glm::inverse(cameraView);
+		if (!IsFinite(clipToView) || !IsFinite(viewToWorld) || glm::dot(lightDir, lightDir) <= 0.0f)
+		{
+			return false;
+		}
+		const auto unproject = [&clipToView](const float x, const float y, const float z)
+		{
+			const glm::vec4 p = clipToView * glm::vec4(x, y, z, 1.0f);
+			return glm::vec3(p) / p.w;
+		};
+
+		// The camera's four corner rays, near and far ends, in view space (depth = -z). A slice's corners are
+		// interpolated along them, which stays exact for off-center and orthographic projections.
+		std::array<glm::vec3, 4> rayNear{};
+		std::array<glm::vec3, 4> rayFar{};
+		for (int corner = 0; corner < 4; ++corner)
+		{
+			const float x = (corner & 1) ? 1.0f : -1.0f;
+			const float y = (corner & 2) ? 1.0f : -1.0f;
+			rayNear[corner] = unproject(x, y, 0.0f);
+			rayFar[corner] = unproject(x, y, 1.0f);
+		}
+		const float nearDepth = -unproject(0.0f, 0.0f, 0.0f).z;
+		const float farDepth = std::min(-unproject(0.0f, 0.0f, 1.0f).z, settings.MaxDistance);
+		if (!std::isfinite(nearDepth) || !std::isfinite(farDepth) || !(farDepth > nearDepth))
+		{
+			return false;
+		}
+
+		// Light space is a pure rotation (no eye position): translating the camera then only translates the
+		// cascade centers, which is what the texel snapping below quantizes.
+		const glm::vec3 dir = glm::normalize(lightDir);
+		const glm::vec3 up = (glm::abs(dir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		const glm::mat4 lightView = glm::lookAtRH(glm::vec3(0.0f), dir, up);
+
+		// Depth range: the caster bounds in light space, independent of the camera so cached cascades keep
+		// their matrix. The sun looks down -z, so the nearest caster has the largest z.
+		float minZ = std::numeric_limits<float>::max();
+		float maxZ = std::numeric_limits<float>::lowest();
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			const glm::vec3 p{(corner & 1) ? casterBounds.Max.x : casterBounds.Min.x,
+			                  (corner & 2) ? casterBounds.Max.y : casterBounds.Min.y,
+			                  (corner & 4) ? casterBounds.Max.z : casterBounds.Min.z};
+			const float z = (lightView * glm::vec4(p, 1.0f)).z;
+			minZ = std::min(minZ, z);
+			maxZ = std::max(maxZ, z);
+		}
+		const float depthPad = (maxZ - minZ) * kDepthSlack + 0.01f;
+		const float zNear = -maxZ - depthPad;
+		const float zFar = -minZ + depthPad;
+
+		const uint32_t count = std::clamp(settings.Count, 1u, kMaxShadowCascades);
+		const float resolution = static_cast<float>(std::max(settings.Resolution, 16u));
+		const std::array<float, kMaxShadowCascades + 1> splits =
+		    ComputeShadowCascadeSplits(nearDepth, farDepth, count, settings.SplitLambda);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			ShadowCascade& cascade = out.Cascades[i];
+			cascade.SplitNear = splits[i];
+			cascade.SplitFar = splits[i + 1];
+			cascade.Cacheable = i >= settings.FirstCachedCascade;
+
+			// The slice's 8 corners (world space) and their bounding sphere about the centroid.
+			std::array<glm::vec3, 8> corners{};
+			glm::vec3 center{0.0f};
+			for (int c = 0; c < 8; ++c)
+			{
+				const glm::vec3& a = rayNear[c & 3];
+				const glm::vec3& b = rayFar[c & 3];
+				const float depth = (c & 4) ? cascade.SplitFar : cascade.SplitNear;
+				const float span = b.z - a.z;
+				const float t = span != 0.0f ? (-depth - a.z) / span : 0.0f;
+				corners[c] = glm::vec3(viewToWorld * glm::vec4(a + (b - a) * t, 1.0f));
+				center += corners[c];
+			}
+			center /= 8.0f;
+			float radius = 0.0f;
+			for (const glm::vec3& corner : corners)
+			{
+				radius = std::max(radius, glm::length(corner - center));
+			}
+			radius = QuantizeRadius(std::max(radius, 1.0e-3f));
+
+			// Half-extent of the ortho box, the texel it yields, and the snapping step (a whole number of
+			// texels). The snapped center is up to half a step off the true one, so the box is padded by that
+			// much -- kCachedSnapFraction of the radius for a cached cascade -- plus one texel for the snap
+			// itself and the PCF footprint at the slice's edge.
+			const float snapPad = cascade.Cacheable ? radius * kCachedSnapFraction : 0.0f;
+			const float halfExtent = (radius + snapPad) * resolution / (resolution - 2.0f);
+			const float texel = 2.0f * halfExtent / resolution;
+			const float step = cascade.Cacheable
+			                       ? std::max(std::floor(2.0f * snapPad / texel), 1.0f) * texel
+			                       : texel;
+			cascade.TexelSize = texel;
+
+			const glm::vec3 centerLS = glm::vec3(lightView * glm::vec4(center, 1.0f));
+			const float x = std::round(centerLS.x / step) * step;
+			const float y = std::round(centerLS.y / step) * step;
+
+			const glm::mat4 proj = glm::orthoRH_ZO(x - halfExtent, x + halfExtent, y - halfExtent, y + halfExtent, zNear, zFar);
+			cascade.ViewProj = proj * lightView;
+		}
+
+		out.Count = count;
+		return true;
+	}
+
+	bool ShadowCascadeCache::NeedsRender(const uint32_t index, const glm::mat4& viewProj, const uint64_t casterSignature,
+	                                     const uint32_t resolution)
+	{
+		Entry& entry = m_Entries[index];
+		if (entry.Valid && entry.ViewProj == viewProj && entry.CasterSignature == casterSignature &&
+		    entry.Resolution == resolution)
+		{
+			return false;
+		}
+		entry = {.Valid = true, .ViewProj = viewProj, .CasterSignature = casterSignature, .Resolution = resolution};
+		return true;
+	}
+
+	void ShadowCascadeCache::Invalidate(const uint32_t index)
+	{
+		m_Entries[index].Valid = false;
+	}
+
+	void ShadowCascadeCache::InvalidateAll()
+	{
+		for (Entry& entry : m_Entries)
+		{
+			entry.Valid = false;
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Snowstorm/Math/Bounds.hpp"
+#include "Snowstorm/Math/Math.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace Snowstorm
+{
+	// Directional-sun cascade budget. Mirrored by MAX_SHADOW_CASCADES in Engine.hlsli (FrameCB carries one
+	// matrix + one map index per cascade) -- keep them in lockstep.
+	constexpr uint32_t kMaxShadowCascades = 4;
+
+	struct ShadowCascadeSettings
+	{
+		uint32_t Count = 3;        // clamped to 1..kMaxShadowCascades
+		float SplitLambda = 0.75f; // practical split scheme: 0 = uniform, 1 = logarithmic
+		float MaxDistance = 150.0f; // view depth the last cascade ends at (capped by the camera's far plane)
+		uint32_t Resolution = 2048; // texels per cascade side; the snapping grid is derived from it
+
+		// Cascades at or past this index are fitted for caching: their light-space origin snaps to a coarse
+		// grid (kCachedSnapFraction of the radius, with the ortho box padded to still cover the slice), so
+		// the matrix -- and therefore the rendered map -- survives camera motion until the grid step is
+		// crossed. kMaxShadowCascades = none cached.
+		uint32_t FirstCachedCascade = kMaxShadowCascades;
+	};
+
+	struct ShadowCascade
+	{
+		glm::mat4 ViewProj{1.0f}; // world -> cascade clip (orthographic, ZO depth)
+		float SplitNear = 0.0f;   // camera view-depth range this cascade was fitted to
+		float SplitFar = 0.0f;
+		float TexelSize = 0.0f;   // world units per shadow-map texel
+		bool Cacheable = false;
+	};
+
+	struct ShadowCascadeSet
+	{
+		std::array<ShadowCascade, kMaxShadowCascades> Cascades{};
+		uint32_t Count = 0;
+	};
+
+	// The practical split scheme (a lambda blend of uniform and logarithmic splits): Count + 1 view depths,
+	// [0] = nearDepth, [count] = farDepth, entries past count are farDepth.
+	std::array<float, kMaxShadowCascades + 1> ComputeShadowCascadeSplits(float nearDepth, float farDepth,
+	                                                                     uint32_t count, float lambda);
+
+	// Fit one orthographic light view-projection per camera depth slice. Each cascade is sized to the
+	// bounding sphere of its slice -- the sphere's radius is invariant under camera rotation and
+	// translation, so the texel footprint never changes size -- and its light-space origin is snapped to
+	// whole texels, so moving the camera slides the map by exact texels instead of shimmering. The depth
+	// range spans `casterBounds` (the scene's renderable AABB) so casters between the sun and the slice
+	// still land in the map. Returns false (out.Count = 0) when the camera can't be unprojected or has
+	// no positive depth range.
+	bool FitShadowCascades(const glm::mat4& cameraView, const glm::mat4& cameraProjection, const glm::vec3& lightDir,
+	                       const AABB& casterBounds, const ShadowCascadeSettings& settings, ShadowCascadeSet& out);
+
+	// What a cached cascade map was last rendered with. A cascade re-renders only when its matrix, its
+	// caster signature (a hash of what the culled casters are and where) or the map resolution differ from
+	// the last render -- i.e. when the camera crosses the cascade's snapping grid, the sun moves, or a caster
+	// inside it changes.
+	class ShadowCascadeCache
+	{
+	public:
+		// True when cascade `index` must be rendered this frame; records the new state as rendered. A caller
+		// whose render then doesn't happen (pipeline not ready yet) must Invalidate the cascade.
+		bool NeedsRender(uint32_t index, const glm::mat4& viewProj, uint64_t casterSignature, uint32_t resolution);
+
+		void Invalidate(uint32_t index);
+		void InvalidateAll();
+
+	private:
+		struct Entry
+		{
+			bool Valid = false;
+			glm::mat4 ViewProj{1.0f};
+			uint64_t CasterSignature = 0;
+			uint32_t Resolution = 0;
+		};
+		std::array<Entry, kMaxShadowCascades> m_Entries{};
+	};
+}
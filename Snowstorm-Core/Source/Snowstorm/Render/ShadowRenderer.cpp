@@ -1,23 +1,198 @@
 #include "ShadowRenderer.hpp"
 
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/CameraRuntimeComponent.hpp"
 #include "Snowstorm/Components/MaterialComponent.hpp"
 #include "Snowstorm/Components/MeshComponent.hpp"
 #include "Snowstorm/Components/TransformComponent.hpp"
 #include "Snowstorm/Components/VisibilityComponents.hpp"
+#include "Snowstorm/Core/Application.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/ECS/TrackedRegistry.hpp"
 #include "Snowstorm/Lighting/LightingComponents.hpp"
+#include "Snowstorm/Math/Bounds.hpp"
+#include "Snowstorm/Math/Frustum.hpp"
+#include "Snowstorm/Render/CommandContext.hpp"
+#include "Snowstorm/Render/Mesh.hpp"
 #include "Snowstorm/Render/RenderGraph.hpp"
 #include "Snowstorm/Render/RendererService.hpp"
 #include "Snowstorm/Render/RenderTarget.hpp"
+#include "Snowstorm/Render/SceneBounds.hpp"
+#include "Snowstorm/Service/ServiceManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_set>
 
 namespace Snowstorm
 {
+	namespace
+	{
+		// The camera the sun cascades are fitted to: the Primary camera, else the first one. Other viewports
+		// sample the same cascades (DefaultLit selects by map footprint), just without a density fitted to them.
+		const CameraRuntimeComponent* PickCascadeCamera(TrackedRegistry& reg)
+		{
+			const CameraRuntimeComponent* fallback = nullptr;
+			for (const auto cameras = reg.view<const CameraComponent, const CameraRuntimeComponent>(); const auto e : cameras)
+			{
+				const auto& runtime = reg.Read<CameraRuntimeComponent>(e);
+				if (reg.Read<CameraComponent>(e).Primary)
+				{
+					return &runtime;
+				}
+				if (!fallback)
+				{
+					fallback = &runtime;
+				}
+			}
+			return fallback;
+		}
+
+		size_t CullGrain(const size_t count)
+		{
+			return CVars::EcsParallel.Get() ? size_t{256} : count + 1;
+		}
+	}
+
 	void ShadowRenderer::RenderShadows(FrameContext& fc, World& world)
 	{
+		GatherCasters(fc.Reg);
 		SetupDirectionalShadow(fc, world);
-		SetupSpotShadows(fc);
-		SetupPointShadows(fc);
+		SetupAtlasShadows(fc);
+	}
+
+	void ShadowRenderer::InvalidateCaches()
+	{
+		m_CascadeCache.InvalidateAll();
+		m_AtlasTileCache.InvalidateAll();
+	}
+
+	void ShadowRenderer::GatherCasters(TrackedRegistry& reg)
+	{
+		// Every light frustum this frame culls the same casters, so their world bounds are computed once here.
+		// Moved comes from this frame's ChangedView: RenderSystem runs last, after every system that moves
+		// things, and tracking is cleared right after it.
+		const std::unordered_set<entt::entity> moved = reg.ChangedView<TransformComponent>();
+		const auto casterView = reg.view<const TransformComponent, const MeshComponent, const MaterialComponent, const VisibilityComponent>();
+		const std::vector<entt::entity> candidates(casterView.begin(), casterView.end());
+		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
+		m_Casters = jobs.ParallelGather<Caster>(
+		    candidates.size(),
+		    [&](const size_t c, auto&& emit)
+		    {
+			    const entt::entity e = candidates[c];
+			    const auto& mesh = reg.Read<MeshComponent>(e);
+			    if (!mesh.MeshInstance || !reg.Read<MaterialComponent>(e).MaterialInstance)
+			    {
+				    return;
+			    }
+			    const glm::mat4 M = reg.Read<TransformComponent>(e).GetTransformMatrix();
+			    const MeshBounds& localB = mesh.MeshInstance->GetBounds();
+			    emit(Caster{.Entity = e,
+			                .MeshPtr = mesh.MeshInstance.get(),
+			                .WorldSphere = TransformSphere(localB.Sphere, M),
+			                .WorldBox = TransformAABB(localB.Box, M),
+			                .Moved = moved.contains(e)});
+		    },
+		    CullGrain(candidates.size()));
+	}
+
+	std::vector<uint32_t> ShadowRenderer::CullCasters(const glm::mat4& viewProj) const
+	{
+		// The visibility system's sphere-then-AABB test against a light frustum. ParallelGather keeps the
+		// casters in snapshot order, so the list -- and any signature hashed from it -- is deterministic.
+		const Frustum frustum = Frustum::FromViewProjection(viewProj);
+		auto& jobs = Application::Get().GetServiceManager().GetService<JobSystem>();
+		return jobs.ParallelGather<uint32_t>(
+		    m_Casters.size(),
+		    [&](const size_t c, auto&& emit)
+		    {
+			    const Caster& caster = m_Casters[c];
+			    if (frustum.IntersectsSphere(caster.WorldSphere.Center, caster.WorldSphere.Radius) &&
+			        frustum.IntersectsAABB(caster.WorldBox))
+			    {
+				    emit(static_cast<uint32_t>(c));
+			    }
+		    },
+		    CullGrain(m_Casters.size()));
+	}
+
+	bool ShadowRenderer::CheckAtlasTile(ShadowTileCache& cache, const uint32_t tile, const glm::mat4& viewProj,
+	                                    const uint32_t tilePx, std::vector<uint8_t>& drawMask) const
+	{
+		// A tile's caster set: which entities its frustum keeps, with which mesh. Entering, leaving or swapping
+		// mesh changes the set; moving within the frustum is the Moved flag.
+		const std::vector<uint32_t> kept = CullCasters(viewProj);
+		ContentHasher hasher;
+		bool moved = false;
+		for (const uint32_t c : kept)
+		{
+			hasher.UpdateValue(entt::to_integral(m_Casters[c].Entity));
+			hasher.UpdateValue(m_Casters[c].MeshPtr);
+			moved = moved || m_Casters[c].Moved;
+		}
+		if (!cache.NeedsRender(tile, viewProj, hasher.Digest(), moved, tilePx))
+		{
+			return false;
+		}
+		for (const uint32_t c : kept)
+		{
+			drawMask[c] = 1;
+		}
+		return true;
+	}
+
+	std::vector<entt::entity> ShadowRenderer::MaskedCasters(const std::vector<uint8_t>& drawMask) const
+	{
+		std::vector<entt::entity> casters;
+		for (size_t c = 0; c < m_Casters.size(); ++c)
+		{
+			if (drawMask[c])
+			{
+				casters.push_back(m_Casters[c].Entity);
+			}
+		}
+		return casters;
+	}
+
+	void ShadowRenderer::RecordAtlasTiles(FrameContext& fc, CommandContext& c, const std::vector<AtlasTile>& tiles,
+	                                      const std::vector<entt::entity>& casters, ShadowTileCache& cache,
+	                                      const PixelFormat depthFormat)
+	{
+		RendererService& r = fc.Renderer;
+		TrackedRegistry& reg = fc.Reg;
+
+		// One caster accumulation shared by every tile (BeginScene sets nothing the depth draw needs beyond the
+		// batches — the matrix travels per-draw as a PC): the union of the re-rendering tiles' casters. A tile
+		// draws the others' casters too; its frustum clips them.
+		CameraRuntimeComponent lightCam{};
+		lightCam.ViewProjection = glm::mat4(1.0f);
+		r.BeginScene(lightCam, glm::vec3(0.0f), fc.Ctx, fc.FrameIndex);
+
+		for (const entt::entity e : casters)
+		{
+			r.DrawMesh(reg.Read<TransformComponent>(e).GetTransformMatrix(),
+			           reg.Read<MeshComponent>(e).MeshInstance,
+			           reg.Read<MaterialComponent>(e).MaterialInstance);
+		}
+
+		// The atlas was loaded, not cleared: clear each re-rendering tile's rect, then scissor + viewport to it
+		// and depth-draw with its matrix (push constant). Untouched tiles keep last frame's depth.
+		for (const AtlasTile& tile : tiles)
+		{
+			c.SetViewport(static_cast<float>(tile.X), static_cast<float>(tile.Y),
+			              static_cast<float>(tile.Size), static_cast<float>(tile.Size), 0.0f, 1.0f);
+			c.SetScissor(tile.X, tile.Y, tile.Size, tile.Size);
+			c.ClearDepthRect(tile.X, tile.Y, tile.Size, tile.Size);
+			// Depth shader still compiling: the tile is only cleared, so don't let the cache keep it.
+			if (!m_ShadowPass.RecordDepth(r, depthFormat, tile.ViewProj))
+			{
+				cache.Invalidate(tile.Tile);
+			}
+		}
 	}
 
 	void ShadowRenderer::SetupDirectionalShadow(FrameContext& fc, World& world)
@@ -27,19 +202,21 @@ namespace Snowstorm
 		// lives in RenderSystem::Execute) and read renderer/reg/ctx/frameIndex through it. The alias below is
 		// only for the immediate (non-deferred) setup code before AddPass.
 		RendererService& renderer = fc.Renderer;
+		TrackedRegistry& reg = fc.Reg;
 
-		// Render scene depth from the sun's POV into the shared shadow map, before any camera pass. Uses
-		// ALL renderable meshes (not a camera's visibility cache) — an off-screen caster still shadows
-		// on-screen geometry. If there is no directional light or no scene bounds, shadows are disabled
-		// (ShadowMapIndex = 0) and the lit shader falls back to fully lit.
-		renderer.SetShadowData(glm::mat4(1.0f), 0, 0); // default: no shadows unless set up below
+		// Render scene depth from the sun's POV into one map per cascade, before any camera pass. Each cascade
+		// is fitted to a depth slice of the camera's view (FitShadowCascades) and draws only the casters its
+		// light frustum keeps -- including off-screen ones between the sun and the slice, which still shadow
+		// on-screen geometry. If there is no directional light, no camera or no scene bounds, shadows are
+		// disabled (CascadeCount = 0) and the lit shader falls back to fully lit.
+		renderer.SetShadowData({}, {}, 0); // default: no shadows unless set up below
 
 		// Primary sun = first directional light (matches DirectionalLights[0] in the shader). Shadows are
 		// gated by the global render.shadows CVar (scalability kill-switch) AND the light's authored
-		// CastShadows flag — either off => no shadow pass, ShadowMapIndex stays 0 (fully lit).
+		// CastShadows flag — either off => no shadow pass, CascadeCount stays 0 (fully lit).
 		glm::vec3 sunDir{0.0f};
 		bool sunCasts = false;
-		for (const auto sunView = fc.Reg.view<const DirectionalLightComponent>(); const auto e : sunView)
+		for (const auto sunView = reg.view<const DirectionalLightComponent>(); const auto e : sunView)
 		{
 			const auto& dl = sunView.get<const DirectionalLightComponent>(e);
 			sunDir = dl.Direction;
@@ -47,197 +224,198 @@ namespace Snowstorm
 			break;
 		}
 
-		glm::mat4 lightViewProj{1.0f};
-		if (CVars::ShadowsRasterActive() && sunCasts && ShadowPass::ComputeSunViewProj(world, sunDir, lightViewProj))
+		const CameraRuntimeComponent* camera = PickCascadeCamera(reg);
+		AABB sceneBounds;
+		if (!CVars::ShadowsRasterActive() || !sunCasts || !camera || !ComputeWorldRenderableAABB(world, sceneBounds))
+		{
+			m_CascadeCache.InvalidateAll();
+			return;
+		}
+
+		const int resolution = std::clamp(CVars::ShadowResolution.Get(), 256, 8192);
+		const auto cascadeCount = static_cast<uint32_t>(CVars::ClampedShadowCascades());
+		ShadowCascadeSettings settings;
+		settings.Count = cascadeCount;
+		settings.SplitLambda = CVars::ShadowSplitLambda.Get();
+		settings.MaxDistance = std::max(CVars::ShadowDistance.Get(), 1.0f);
+		settings.Resolution = static_cast<uint32_t>(resolution);
+		// The far half of the cascades is cached (never the nearest: it carries the detail the eye is on, and
+		// its texel-exact snapping changes the matrix on almost every camera move anyway).
+		settings.FirstCachedCascade = CVars::ShadowCascadeCache.Get() ? std::max((cascadeCount + 1) / 2, 1u) : kMaxShadowCascades;
+
+		ShadowCascadeSet cascades;
+		if (!FitShadowCascades(camera->View, camera->Projection, sunDir, sceneBounds, settings, cascades))
+		{
+			m_CascadeCache.InvalidateAll();
+			return;
+		}
+
+		// Per-cascade caster culling against each cascade's light frustum (CullCasters, over this frame's
+		// caster snapshot).
+		std::array<uint32_t, kMaxShadowCascades> mapIndices{};
+		uint32_t rendered = 0;
+		uint32_t skipped = 0;
+		for (uint32_t i = 0; i < cascades.Count; ++i)
 		{
-			const Ref<RenderTarget>& shadowRT = m_ShadowPass.GetOrCreateShadowTarget();
-			const uint32_t shadowIndex =
-			    shadowRT->GetDesc().DepthAttachment->View->GetGlobalBindlessIndex();
+			const ShadowCascade& cascade = cascades.Cascades[i];
+			m_CascadeCasters[i] = CullCasters(cascade.ViewProj);
 
-			const PixelFormat shadowDepthFmt =
-			    shadowRT->GetDesc().DepthAttachment->View->GetTexture()->GetDesc().Format;
+			const Ref<RenderTarget>& cascadeRT = m_ShadowPass.GetOrCreateCascadeTarget(i);
+			mapIndices[i] = cascadeRT->GetDesc().DepthAttachment->View->GetGlobalBindlessIndex();
 
-			renderer.SetShadowData(lightViewProj, shadowIndex, shadowRT->GetWidth());
+			// A cached cascade whose matrix, casters and resolution all match its last render keeps last
+			// frame's map: no pass at all. Everything else re-renders (and a non-cacheable cascade forgets its
+			// entry, so a later switch back to cached can't match a map it has since overwritten).
+			if (cascade.Cacheable)
+			{
+				// What the cascade draws: each kept caster's entity, mesh and world matrix, in order. A caster
+				// moving, swapping mesh, entering or leaving the cascade changes it; anything outside doesn't.
+				ContentHasher signature;
+				for (const uint32_t c : m_CascadeCasters[i])
+				{
+					const entt::entity e = m_Casters[c].Entity;
+					signature.UpdateValue(entt::to_integral(e));
+					signature.UpdateValue(m_Casters[c].MeshPtr);
+					signature.UpdateValue(reg.Read<TransformComponent>(e).GetTransformMatrix());
+				}
+				if (!m_CascadeCache.NeedsRender(i, cascade.ViewProj, signature.Digest(), settings.Resolution))
+				{
+					++skipped;
+					continue;
+				}
+			}
+			else
+			{
+				m_CascadeCache.Invalidate(i);
+			}
 
-			fc.Graph.AddPass({.Name = "Shadow",
-			                  .Target = shadowRT,
-			                  .Execute = [this, &fc, lightViewProj, shadowDepthFmt](CommandContext& /*c*/)
+			++rendered;
+			const PixelFormat depthFmt = cascadeRT->GetDesc().DepthAttachment->View->GetTexture()->GetDesc().Format;
+			const glm::mat4 lightViewProj = cascade.ViewProj;
+			fc.Graph.AddPass({.Name = "ShadowCascade" + std::to_string(i),
+			                  .Target = cascadeRT,
+			                  .Execute = [this, &fc, i, lightViewProj, depthFmt](CommandContext& /*c*/)
 			                  {
 				                  RendererService& r = fc.Renderer;
-				                  TrackedRegistry& reg = fc.Reg;
+				                  TrackedRegistry& passReg = fc.Reg;
 
 				                  // Light "camera": only ViewProjection is read by BeginScene/FrameCB.
 				                  CameraRuntimeComponent lightCam{};
 				                  lightCam.ViewProjection = lightViewProj;
-
 				                  r.BeginScene(lightCam, glm::vec3(0.0f), fc.Ctx, fc.FrameIndex);
 
-				                  // Accumulate ALL renderable meshes as shadow casters (resolved instances).
-				                  for (const auto casters = reg.view<const TransformComponent, const MeshComponent, const MaterialComponent, const VisibilityComponent>();
-				                       const auto e : casters)
+				                  for (const uint32_t c : m_CascadeCasters[i])
 				                  {
-					                  const auto& mesh = reg.Read<MeshComponent>(e);
-					                  const auto& mat = reg.Read<MaterialComponent>(e);
-					                  if (!mesh.MeshInstance || !mat.MaterialInstance)
-					                  {
-						                  continue;
-					                  }
-					                  r.DrawMesh(reg.Read<TransformComponent>(e).GetTransformMatrix(),
-					                             mesh.MeshInstance, mat.MaterialInstance);
+					                  const entt::entity e = m_Casters[c].Entity;
+					                  r.DrawMesh(passReg.Read<TransformComponent>(e).GetTransformMatrix(),
+					                             passReg.Read<MeshComponent>(e).MeshInstance,
+					                             passReg.Read<MaterialComponent>(e).MaterialInstance);
 				                  }
 
-				                  m_ShadowPass.RecordDepth(r, shadowDepthFmt, lightViewProj);
+				                  // Depth shader still compiling: nothing was drawn, so don't let the cache keep
+				                  // the empty map.
+				                  if (!m_ShadowPass.RecordDepth(r, depthFmt, lightViewProj))
+				                  {
+					                  m_CascadeCache.Invalidate(i);
+				                  }
 				                  // The depth target is transitioned to shader-read by EndRenderPass (it's a
 				                  // sampleable depth attachment) — can't barrier inside the rendering instance.
 			                  }});
 		}
+
+		renderer.SetShadowData(cascades, mapIndices, static_cast<uint32_t>(resolution));
+		renderer.AddShadowTileStats(rendered, skipped);
 	}
 
-	void ShadowRenderer::SetupSpotShadows(FrameContext& fc)
+	void ShadowRenderer::SetupAtlasShadows(FrameContext& fc)
 	{
 		// See SetupDirectionalShadow: the pass lambda runs later (RenderGraph::Execute), so it captures fc by
 		// reference (lives in RenderSystem::Execute) and reads renderer/reg/ctx/frameIndex through it. The alias
 		// below is only for the immediate setup before AddPass.
 		RendererService& renderer = fc.Renderer;
 
-		// LightingSystem already assigned each shadow-casting spot a tile (ShadowIndex >= 0), its perspective
-		// matrix, and its atlas UV rect. Render ALL casters' depth once per tile into the shared atlas (each
-		// tile a viewport/scissor rect + its own push-constant matrix). One pass, N tiles. Skipped entirely
-		// when no spot casts (SpotShadowAtlasIndex stays 0 -> shader treats spots as unshadowed).
+		// LightingSystem already packed every shadow-casting spot (ShadowIndex >= 0) and every cube face of a
+		// casting point (ShadowSlot >= 0) into the one atlas: matrices + UV rects, sized per light by
+		// ShadowAtlasAllocator. Each tile re-renders only when its light or the casters in its frustum changed
+		// (ShadowTileCache); the rest keep last frame's depth. One pass for the re-rendering tiles (each a
+		// viewport/scissor rect + its own push-constant matrix), none when every tile was kept. Skipped
+		// entirely when nothing casts (both atlas indices stay 0 -> the shader treats the lights as unshadowed).
 		renderer.SetSpotShadowAtlasIndex(0);
+		renderer.SetPointShadowAtlasIndex(0);
+		m_AtlasTiles.clear();
+		m_AtlasCasters.clear();
 
 		const LightDataBlock& lights = renderer.GetLights();
-		int shadowSpotCount = 0;
-		for (int s = 0; s < lights.SpotCount; ++s)
+		const bool anySpot = std::ranges::any_of(lights.SpotLights, [](const GPUSpotLight& spot) { return spot.ShadowIndex >= 0; });
+		if (!CVars::ShadowsRasterActive() || (!anySpot && lights.PointShadowCount <= 0))
 		{
-			if (lights.SpotLights[s].ShadowIndex >= 0)
-			{
-				++shadowSpotCount;
-			}
+			m_AtlasTileCache.InvalidateAll();
+			return;
 		}
 
-		if (CVars::ShadowsRasterActive() && shadowSpotCount > 0)
+		const Ref<RenderTarget>& atlasRT = m_ShadowPass.GetOrCreateAtlas();
+		const uint32_t atlasIndex = atlasRT->GetDesc().DepthAttachment->View->GetGlobalBindlessIndex();
+		const PixelFormat atlasFmt = atlasRT->GetDesc().DepthAttachment->View->GetTexture()->GetDesc().Format;
+		const uint32_t atlasSize = atlasRT->GetWidth();
+		if (atlasSize != m_AtlasSize) // a rebuilt atlas holds no depth, and the tile ids below depend on its size
 		{
-			const Ref<RenderTarget>& atlasRT = m_ShadowPass.GetOrCreateSpotAtlas();
-			const uint32_t atlasIndex = atlasRT->GetDesc().DepthAttachment->View->GetGlobalBindlessIndex();
-			const PixelFormat atlasFmt = atlasRT->GetDesc().DepthAttachment->View->GetTexture()->GetDesc().Format;
-			const uint32_t tilePx = atlasRT->GetWidth() / ShadowPass::kSpotAtlasCols;
-
-			renderer.SetSpotShadowAtlasIndex(atlasIndex);
-
-			fc.Graph.AddPass({.Name = "SpotShadows",
-			                  .Target = atlasRT,
-			                  .Execute = [this, &fc, atlasFmt, tilePx](CommandContext& c)
-			                  {
-				                  RendererService& r = fc.Renderer;
-				                  TrackedRegistry& reg = fc.Reg;
+			m_AtlasTileCache.InvalidateAll();
+			m_AtlasSize = atlasSize;
+		}
 
-				                  // One caster accumulation shared by every tile (BeginScene sets nothing the
-				                  // depth draw needs beyond the batches — the matrix travels per-draw as a PC).
-				                  CameraRuntimeComponent lightCam{};
-				                  lightCam.ViewProjection = glm::mat4(1.0f);
-				                  r.BeginScene(lightCam, glm::vec3(0.0f), fc.Ctx, fc.FrameIndex);
+		renderer.SetSpotShadowAtlasIndex(atlasIndex);
+		renderer.SetPointShadowAtlasIndex(atlasIndex);
 
-				                  for (const auto casters = reg.view<const TransformComponent, const MeshComponent, const MaterialComponent, const VisibilityComponent>();
-				                       const auto e : casters)
-				                  {
-					                  const auto& mesh = reg.Read<MeshComponent>(e);
-					                  const auto& mat = reg.Read<MaterialComponent>(e);
-					                  if (!mesh.MeshInstance || !mat.MaterialInstance)
-					                  {
-						                  continue;
-					                  }
-					                  r.DrawMesh(reg.Read<TransformComponent>(e).GetTransformMatrix(),
-					                             mesh.MeshInstance, mat.MaterialInstance);
-				                  }
+		// Tiles are aligned to their own (power-of-two, >= kMinTileSize) size, so a tile's origin on the
+		// kMinTileSize grid names it uniquely. The cache entry also records the size, so a different light (or
+		// a resized tile) landing on the same origin re-renders.
+		constexpr uint32_t kGrid = ShadowAtlasAllocator::kMinTileSize;
+		const auto scale = static_cast<float>(atlasSize);
+		std::vector<uint8_t> drawMask(m_Casters.size(), 0);
+		uint32_t skipped = 0;
+		const auto checkTile = [&](const glm::mat4& viewProj, const glm::vec4& rect)
+		{
+			const auto x = static_cast<uint32_t>(std::lround(rect.x * scale));
+			const auto y = static_cast<uint32_t>(std::lround(rect.y * scale));
+			const auto size = static_cast<uint32_t>(std::lround(rect.z * scale));
+			const uint32_t tile = (y / kGrid) * (atlasSize / kGrid) + x / kGrid;
+			if (!CheckAtlasTile(m_AtlasTileCache, tile, viewProj, size, drawMask))
+			{
+				++skipped;
+				return;
+			}
+			m_AtlasTiles.push_back({.Tile = tile, .X = x, .Y = y, .Size = size, .ViewProj = viewProj});
+		};
 
-				                  // Render each shadow-casting spot into its tile: scissor+viewport to the tile
-				                  // rect, then a depth draw with that spot's matrix (push constant).
-				                  const LightDataBlock& ld = r.GetLights();
-				                  for (int s = 0; s < ld.SpotCount; ++s)
-				                  {
-					                  const GPUSpotLight& spot = ld.SpotLights[s];
-					                  if (spot.ShadowIndex < 0)
-					                  {
-						                  continue;
-					                  }
-					                  const auto col = static_cast<uint32_t>(spot.ShadowIndex) % ShadowPass::kSpotAtlasCols;
-					                  const auto row = static_cast<uint32_t>(spot.ShadowIndex) / ShadowPass::kSpotAtlasCols;
-					                  c.SetViewport(static_cast<float>(col * tilePx), static_cast<float>(row * tilePx),
-					                                static_cast<float>(tilePx), static_cast<float>(tilePx), 0.0f, 1.0f);
-					                  c.SetScissor(col * tilePx, row * tilePx, tilePx, tilePx);
-					                  m_ShadowPass.RecordDepth(r, atlasFmt, spot.ShadowViewProj);
-				                  }
-			                  }});
+		for (const GPUSpotLight& spot : lights.SpotLights)
+		{
+			if (spot.ShadowIndex >= 0)
+			{
+				checkTile(spot.ShadowViewProj, spot.ShadowAtlasRect);
+			}
 		}
-	}
-
-	void ShadowRenderer::SetupPointShadows(FrameContext& fc)
-	{
-		// Same shape as SetupSpotShadows (and same dangling-capture rule): LightingSystem already assigned each
-		// casting point a shadow slot and filled its 6 cube-face view-projs + atlas rects. Here we render ALL
-		// casters' depth into 6 tiles per point (tile = slot*6 + face) of the shared point atlas — one pass,
-		// PointShadowCount*6 tiles. Skipped when no point casts (PointShadowAtlasIndex stays 0 -> unshadowed).
-		RendererService& renderer = fc.Renderer;
-
-		renderer.SetPointShadowAtlasIndex(0);
+		for (int slot = 0; slot < lights.PointShadowCount; ++slot)
+		{
+			const GPUPointShadow& payload = lights.PointShadows[slot];
+			for (int face = 0; face < 6; ++face)
+			{
+				checkTile(payload.Face[face], payload.Rect[face]);
+			}
+		}
+		m_AtlasTileCache.RetireUnchecked();
+		renderer.AddShadowTileStats(static_cast<uint32_t>(m_AtlasTiles.size()), skipped);
 
-		const LightDataBlock& lights = renderer.GetLights();
-		if (!CVars::ShadowsRasterActive() || lights.PointShadowCount <= 0)
+		if (m_AtlasTiles.empty())
 		{
 			return;
 		}
+		m_AtlasCasters = MaskedCasters(drawMask);
 
-		const Ref<RenderTarget>& atlasRT = m_ShadowPass.GetOrCreatePointAtlas();
-		const uint32_t atlasIndex = atlasRT->GetDesc().DepthAttachment->View->GetGlobalBindlessIndex();
-		const PixelFormat atlasFmt = atlasRT->GetDesc().DepthAttachment->View->GetTexture()->GetDesc().Format;
-		const uint32_t tilePx = atlasRT->GetWidth() / ShadowPass::kPointAtlasCols;
-
-		renderer.SetPointShadowAtlasIndex(atlasIndex);
-
-		fc.Graph.AddPass({.Name = "PointShadows",
+		fc.Graph.AddPass({.Name = "ShadowAtlas",
 		                  .Target = atlasRT,
-		                  .Execute = [this, &fc, atlasFmt, tilePx](CommandContext& c)
+		                  .Execute = [this, &fc, atlasFmt](CommandContext& c)
 		                  {
-			                  RendererService& r = fc.Renderer;
-			                  TrackedRegistry& reg = fc.Reg;
-
-			                  // One caster accumulation shared by every tile (the face matrix travels per-draw
-			                  // as a push constant, exactly like the spot atlas).
-			                  CameraRuntimeComponent lightCam{};
-			                  lightCam.ViewProjection = glm::mat4(1.0f);
-			                  r.BeginScene(lightCam, glm::vec3(0.0f), fc.Ctx, fc.FrameIndex);
-
-			                  for (const auto casters = reg.view<const TransformComponent, const MeshComponent, const MaterialComponent, const VisibilityComponent>();
-			                       const auto e : casters)
-			                  {
-				                  const auto& mesh = reg.Read<MeshComponent>(e);
-				                  const auto& mat = reg.Read<MaterialComponent>(e);
-				                  if (!mesh.MeshInstance || !mat.MaterialInstance)
-				                  {
-					                  continue;
-				                  }
-				                  r.DrawMesh(reg.Read<TransformComponent>(e).GetTransformMatrix(),
-				                             mesh.MeshInstance, mat.MaterialInstance);
-			                  }
-
-			                  // Render each casting point's 6 cube faces, each into tile (slot*6 + face): scissor
-			                  // + viewport to the tile rect, then a depth draw with that face's matrix.
-			                  const LightDataBlock& ld = r.GetLights();
-			                  for (int slot = 0; slot < ld.PointShadowCount; ++slot)
-			                  {
-				                  const GPUPointShadow& payload = ld.PointShadows[slot];
-				                  for (int face = 0; face < 6; ++face)
-				                  {
-					                  const auto tile = static_cast<uint32_t>(slot * 6 + face);
-					                  const uint32_t col = tile % ShadowPass::kPointAtlasCols;
-					                  const uint32_t row = tile / ShadowPass::kPointAtlasCols;
-					                  c.SetViewport(static_cast<float>(col * tilePx), static_cast<float>(row * tilePx),
-					                                static_cast<float>(tilePx), static_cast<float>(tilePx), 0.0f, 1.0f);
-					                  c.SetScissor(col * tilePx, row * tilePx, tilePx, tilePx);
-					                  m_ShadowPass.RecordDepth(r, atlasFmt, payload.Face[face]);
-				                  }
-			                  }
+			                  RecordAtlasTiles(fc, c, m_AtlasTiles, m_AtlasCasters, m_AtlasTileCache, atlasFmt);
 		                  }});
 	}
 }
@@ -1,14 +1,25 @@
 #pragma once
 
+#include "Snowstorm/Math/Bounds.hpp"
 #include "Snowstorm/Render/Passes/ShadowPass.hpp"
 #include "Snowstorm/Render/RenderPhaseContext.hpp"
+#include "Snowstorm/Render/ShadowAtlas.hpp"
+#include "Snowstorm/Render/ShadowCascades.hpp"
+#include "Snowstorm/Render/ShadowTileCache.hpp"
+
+#include <entt/entt.hpp>
+
+#include <array>
+#include <vector>
 
 namespace Snowstorm
 {
+	class CommandContext;
+	class Mesh;
 	class World;
 
 	// Frame-global shadow phase, split out of RenderSystem (the "ShadowSystem" concern). Owns the shared
-	// ShadowPass (the depth pipeline + the directional map / spot atlas / point atlas targets) and appends
+	// ShadowPass (the depth pipeline + the sun cascades / shared spot+point atlas targets) and appends
 	// the directional + spot + point shadow depth passes to the graph once per frame, before the per-viewport
 	// loop. A plain collaborator RenderSystem owns and delegates to — phase-ordered inside Execute, NOT an ECS
 	// System (it has no per-entity Execute of its own; it reads ALL casters, not a camera's visibility cache).
@@ -19,16 +30,71 @@ namespace Snowstorm
 	{
 	public:
 		// Append the sun / spot / point shadow depth passes for this frame. `world` is needed only for the
-		// sun's scene-bounds fit (ShadowPass::ComputeSunViewProj). The pass Execute lambdas run later, in
+		// sun cascades' caster bounds (their light-space depth range). The pass Execute lambdas run later, in
 		// RenderGraph::Execute, so they capture fc by reference (it lives in RenderSystem::Execute) and read
 		// renderer/reg/ctx/frameIndex through it — never this method's locals (they'd dangle).
 		void RenderShadows(FrameContext& fc, World& world);
 
+		// Forget every cached shadow map and tile. RenderSystem calls this for a frame it doesn't render: the
+		// atlas tile caches read caster motion from each frame's ChangedView<TransformComponent>, and a frame
+		// nobody looked at takes its changes with it.
+		void InvalidateCaches();
+
 	private:
+		// One shadow caster this frame (a renderable with mesh + material), with its world bounds computed once
+		// for every light frustum that culls against it, and whether its transform changed this frame.
+		struct Caster
+		{
+			entt::entity Entity = entt::null;
+			const Mesh* MeshPtr = nullptr;
+			Sphere WorldSphere;
+			AABB WorldBox;
+			bool Moved = false;
+		};
+
+		// An atlas tile that re-renders this frame: its tile id, its rect in the atlas (texels), its matrix.
+		struct AtlasTile
+		{
+			uint32_t Tile = 0;
+			uint32_t X = 0;
+			uint32_t Y = 0;
+			uint32_t Size = 0;
+			glm::mat4 ViewProj{1.0f};
+		};
+
+		void GatherCasters(TrackedRegistry& reg);
+		[[nodiscard]] std::vector<uint32_t> CullCasters(const glm::mat4& viewProj) const;
+
+		// Cull the casters of one atlas tile and check it against `cache`. A tile that must re-render marks its
+		// casters in `drawMask` (indices into m_Casters) and returns true.
+		bool CheckAtlasTile(ShadowTileCache& cache, uint32_t tile, const glm::mat4& viewProj, uint32_t tilePx,
+		                    std::vector<uint8_t>& drawMask) const;
+		[[nodiscard]] std::vector<entt::entity> MaskedCasters(const std::vector<uint8_t>& drawMask) const;
+
+		// Body of the atlas pass: accumulate `casters` once, then clear and depth-render each tile.
+		void RecordAtlasTiles(FrameContext& fc, CommandContext& c, const std::vector<AtlasTile>& tiles,
+		                      const std::vector<entt::entity>& casters, ShadowTileCache& cache, PixelFormat depthFormat);
+
 		void SetupDirectionalShadow(FrameContext& fc, World& world);
-		void SetupSpotShadows(FrameContext& fc);
-		void SetupPointShadows(FrameContext& fc);
+		void SetupAtlasShadows(FrameContext& fc);
 
 		ShadowPass m_ShadowPass;
+
+		// This frame's casters, gathered once and culled against every light frustum.
+		std::vector<Caster> m_Casters;
+
+		// Sun cascades: which casters (indices into m_Casters) each cascade's light frustum keeps (filled at
+		// setup, drawn by that cascade's pass later in the frame), and what the cached cascades were last
+		// rendered with.
+		std::array<std::vector<uint32_t>, kMaxShadowCascades> m_CascadeCasters;
+		ShadowCascadeCache m_CascadeCache;
+
+		// Spot/point shadow atlas: the per-tile cache (tile id = the tile's origin on the kMinTileSize grid),
+		// the atlas size those ids were computed for, the tiles re-rendering this frame, and the union of their
+		// casters (drawn once per pass, into each tile).
+		ShadowTileCache m_AtlasTileCache;
+		uint32_t m_AtlasSize = 0;
+		std::vector<AtlasTile> m_AtlasTiles;
+		std::vector<entt::entity> m_AtlasCasters;
 	};
 }
@@ -0,0 +1,51 @@
+#include "ShadowTileCache.hpp"
+
+namespace Snowstorm
+{
+	bool ShadowTileCache::NeedsRender(const uint32_t tile, const glm::mat4& viewProj, const uint64_t casterSet,
+	                                  const bool castersMoved, const uint32_t tileSize)
+	{
+		if (tile >= m_Entries.size())
+		{
+			m_Entries.resize(tile + 1);
+		}
+
+		Entry& entry = m_Entries[tile];
+		entry.Checked = true;
+		if (entry.Valid && !castersMoved && entry.ViewProj == viewProj && entry.CasterSet == casterSet &&
+		    entry.TileSize == tileSize)
+		{
+			return false;
+		}
+		entry = {.Valid = true, .Checked = true, .ViewProj = viewProj, .CasterSet = casterSet, .TileSize = tileSize};
+		return true;
+	}
+
+	void ShadowTileCache::RetireUnchecked()
+	{
+		for (Entry& entry : m_Entries)
+		{
+			if (!entry.Checked)
+			{
+				entry.Valid = false;
+			}
+			entry.Checked = false;
+		}
+	}
+
+	void ShadowTileCache::Invalidate(const uint32_t tile)
+	{
+		if (tile < m_Entries.size())
+		{
+			m_Entries[tile].Valid = false;
+		}
+	}
+
+	void ShadowTileCache::InvalidateAll()
+	{
+		for (Entry& entry : m_Entries)
+		{
+			entry.Valid = false;
+		}
+	}
+}
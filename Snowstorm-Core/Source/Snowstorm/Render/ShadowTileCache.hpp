@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Snowstorm/Math/Math.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Snowstorm
+{
+	// What each shadow atlas tile (a spot light's tile, one cube face of a point light) was last rendered
+	// with, so a tile whose light and casters are unchanged keeps last frame's depth instead of re-rendering.
+	// A tile is keyed by its light matrix (position, direction, cone/range all fold into it), the tile size,
+	// and the signature of the caster SET its frustum keeps (which entities, with which mesh). Caster motion
+	// isn't hashed: the caller passes whether any kept caster moved this frame (ChangedView<TransformComponent>),
+	// which is the cheap test for the common case of a static interior with a few moving props.
+	//
+	// Because motion is tracked per frame rather than by value, a tile must be checked EVERY frame it's live:
+	// RetireUnchecked forgets tiles that weren't (their light lost its slot, or the atlas wasn't rendered), so
+	// a caster that moved meanwhile can't be missed when the tile comes back.
+	class ShadowTileCache
+	{
+	public:
+		// True when `tile` must be rendered this frame; records the new state as rendered. A caller whose
+		// render then doesn't happen (pipeline not ready yet) must Invalidate the tile.
+		bool NeedsRender(uint32_t tile, const glm::mat4& viewProj, uint64_t casterSet, bool castersMoved, uint32_t tileSize);
+
+		// Invalidate every tile not passed to NeedsRender since the previous call. Call once per frame, after
+		// the frame's NeedsRender checks.
+		void RetireUnchecked();
+
+		void Invalidate(uint32_t tile);
+		void InvalidateAll();
+
+	private:
+		struct Entry
+		{
+			bool Valid = false;
+			bool Checked = false;
+			glm::mat4 ViewProj{1.0f};
+			uint64_t CasterSet = 0;
+			uint32_t TileSize = 0;
+		};
+		std::vector<Entry> m_Entries;
+	};
+}
@@ -1,9 +1,10 @@
 #include "Texture.hpp"
 
 #include "RendererAPI.hpp"
-#include "Snowstorm/Assets/AssetFileTime.hpp"
+#include "Snowstorm/Assets/ContentHashIndex.hpp"
 #include "Snowstorm/Assets/TextureCache.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Platform/Null/NullResources.hpp"
 #include "Platform/Vulkan/VulkanTexture.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -29,6 +30,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanTexture>(desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullTexture>(desc);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 textures are not implemented yet.");
 			return nullptr;
@@ -76,16 +80,18 @@ namespace Snowstorm
 		}
 	}
 
-	std::optional<CookedTexture> Texture::DecodeCPU(const std::filesystem::path& filePath, const AssetHandle handle, const uint64_t sourceWriteTime)
+	std::optional<CookedTexture> Texture::DecodeCPU(const std::filesystem::path& filePath)
 	{
 		// CPU-only, worker-safe. Fast path: the cooked .sstex blob (no stb decode + no mip-gen). The decoded
 		// RGBA bytes are color-space-agnostic, so one blob serves both sRGB and linear views (srgb is applied
-		// later at GPU-upload time). Only cache handle-backed assets — handle 0 (inline/handle-less textures)
-		// would all collide on one "0.sstex", so skip the cache for those.
-		const bool useCache = (handle.Value() != 0);
-		if (useCache)
+		// later at GPU-upload time). The blob is keyed by the image's CONTENT hash, so handle-less textures
+		// cache too, and a checkout that rewrites mtimes (or another machine, via the shared DDC) still hits.
+		const std::optional<uint64_t> sourceHash = ContentHashIndex::Get().GetHash(filePath);
+		std::optional<DerivedDataKey> key;
+		if (sourceHash)
 		{
-			if (auto blob = TextureCacheIO::Load(handle, sourceWriteTime))
+			key = TextureCacheIO::MakeKey(*sourceHash);
+			if (auto blob = TextureCacheIO::Load(*key))
 			{
 				return blob;
 			}
@@ -123,9 +129,9 @@ namespace Snowstorm
 			ph = nh;
 		}
 
-		if (useCache)
+		if (key)
 		{
-			(void)TextureCacheIO::Save(handle, sourceWriteTime, cooked); // decode+mip once; next load reads the blob
+			(void)TextureCacheIO::Save(*key, cooked); // decode+mip once; next load reads the blob
 		}
 		return cooked;
 	}
@@ -160,8 +166,7 @@ namespace Snowstorm
 	{
 		// Synchronous convenience path (kept for non-async callers): decode on the calling thread, upload.
 		// The async loader instead calls DecodeCPU on a worker and CreateFromPixels on the main thread.
-		const uint64_t sourceTime = GetFileWriteTimeU64(filePath);
-		auto cooked = DecodeCPU(filePath, AssetHandle{0}, sourceTime);
+		auto cooked = DecodeCPU(filePath);
 		SS_CORE_ASSERT(cooked, "Failed to load texture image: {}", filePath.string());
 		if (!cooked)
 		{
@@ -187,6 +192,9 @@ namespace Snowstorm
 		case RendererAPI::API::Vulkan:
 			return CreateRef<VulkanTextureView>(texture, desc);
 
+		case RendererAPI::API::Null:
+			return CreateRef<NullTextureView>(texture, desc);
+
 		case RendererAPI::API::DX12:
 			SS_CORE_ASSERT(false, "DX12 texture views are not implemented yet.");
 			return nullptr;
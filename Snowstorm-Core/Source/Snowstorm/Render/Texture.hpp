@@ -137,10 +137,10 @@ namespace Snowstorm
 		// only this GPU step stays on the main thread. `srgb` picks the sampled color space (format).
 		static Ref<Texture> CreateFromPixels(const CookedTexture& cooked, bool srgb, const std::string& debugName);
 
-		// CPU-only decode: return the RGBA8 pixels for a source image, from the cooked .sstex blob if fresh
+		// CPU-only decode: return the RGBA8 pixels for a source image, from the cooked .sstex blob if cached
 		// else by stb-decoding (and writing the blob). No GPU work, so safe on a JobSystem worker. Returns
-		// nullopt on decode failure. `handle`/`sourceWriteTime` key the cook cache.
-		static std::optional<CookedTexture> DecodeCPU(const std::filesystem::path& filePath, AssetHandle handle, uint64_t sourceWriteTime);
+		// nullopt on decode failure. The cook cache is keyed by the image's content hash (ContentHashIndex).
+		static std::optional<CookedTexture> DecodeCPU(const std::filesystem::path& filePath);
 
 	protected:
 		Texture() = default;
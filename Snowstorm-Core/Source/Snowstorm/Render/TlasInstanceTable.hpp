@@ -0,0 +1,246 @@
+#pragma once
+
+#include "Snowstorm/Render/AccelerationStructure.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Snowstorm
+{
+	// What the TLAS needs this frame, decided by TlasInstanceTable::Commit.
+	enum class TlasUpdateKind : uint8_t
+	{
+		None,   // nothing traced changed (records may still need uploading)
+		Refit,  // same instances + BLASes, some transforms moved: UPDATE-mode build, dirty slots rewritten
+		Rebuild // the instance set changed, or the refit budget ran out: full build
+	};
+
+	struct TlasUpdatePlan
+	{
+		TlasUpdateKind Kind = TlasUpdateKind::None;
+		std::vector<TlasSlotRange> InstanceRanges; // slots whose TLAS instance changed (every slot on Rebuild)
+		std::vector<TlasSlotRange> RecordRanges;   // slots whose per-instance record changed
+	};
+
+	// Persistent, dense TLAS instance array with a key (entity) -> slot map, plus one Record per instance
+	// (GeometryRecord in the engine) kept in the same slot order. Pure CPU bookkeeping: it diffs what the
+	// caller upserts against what it already holds, and Commit turns the differences into a plan -- nothing,
+	// a refit of the dirty slots, or a full rebuild. A few moving props then refit the TLAS and rewrite only
+	// their own instances + records, instead of re-gathering the scene and rebuilding everything.
+	//
+	// Slots are dense because the slot IS the instanceCustomIndex the shaders index the record table with.
+	// Removing a key swaps the last slot into its hole (a topology change anyway); otherwise slots are stable.
+	template <typename Record>
+	class TlasInstanceTable
+	{
+	public:
+		// Add or replace `key`'s instance. A new key, or a different BLAS / opacity flag, changes the topology
+		// (a refit can't change what is instanced); a different transform dirties the slot's instance, and a
+		// different record the slot's record. Returns the slot.
+		uint32_t Upsert(const uint64_t key, const TLASInstance& instance, const Record& record)
+		{
+			const auto it = m_Slots.find(key);
+			if (it == m_Slots.end())
+			{
+				const auto slot = static_cast<uint32_t>(m_Instances.size());
+				m_Slots.emplace(key, slot);
+				m_Keys.push_back(key);
+				m_Instances.push_back(instance);
+				m_Records.push_back(record);
+				m_Seen.push_back(m_SyncGeneration);
+				m_InstanceDirty.push_back(0);
+				m_RecordDirty.push_back(0);
+				MarkDirty(m_InstanceDirty, m_InstanceDirtySlots, slot);
+				MarkDirty(m_RecordDirty, m_RecordDirtySlots, slot);
+				m_TopologyChanged = true;
+				return slot;
+			}
+
+			const uint32_t slot = it->second;
+			m_Seen[slot] = m_SyncGeneration;
+			TLASInstance& current = m_Instances[slot];
+			if (current.BlasAddress != instance.BlasAddress || current.ForceNonOpaque != instance.ForceNonOpaque)
+			{
+				m_TopologyChanged = true;
+				current = instance;
+				MarkDirty(m_InstanceDirty, m_InstanceDirtySlots, slot);
+			}
+			else if (current.Transform != instance.Transform)
+			{
+				current.Transform = instance.Transform;
+				MarkDirty(m_InstanceDirty, m_InstanceDirtySlots, slot);
+			}
+			if (!(m_Records[slot] == record))
+			{
+				m_Records[slot] = record;
+				MarkDirty(m_RecordDirty, m_RecordDirtySlots, slot);
+			}
+			return slot;
+		}
+
+		// A sync pass over the whole instance set: every key Upserted between BeginSync and EndSync is kept,
+		// EndSync removes the rest.
+		void BeginSync() { ++m_SyncGeneration; }
+
+		void EndSync()
+		{
+			for (size_t slot = m_Keys.size(); slot-- > 0;)
+			{
+				if (m_Seen[slot] != m_SyncGeneration)
+				{
+					Remove(m_Keys[slot]);
+				}
+			}
+		}
+
+		bool Remove(const uint64_t key)
+		{
+			const auto it = m_Slots.find(key);
+			if (it == m_Slots.end())
+			{
+				return false;
+			}
+			const uint32_t slot = it->second;
+			m_Slots.erase(it);
+
+			const auto last = static_cast<uint32_t>(m_Instances.size() - 1);
+			if (slot != last)
+			{
+				m_Keys[slot] = m_Keys[last];
+				m_Instances[slot] = m_Instances[last];
+				m_Records[slot] = m_Records[last];
+				m_Seen[slot] = m_Seen[last];
+				m_Slots[m_Keys[slot]] = slot;
+				MarkDirty(m_InstanceDirty, m_InstanceDirtySlots, slot);
+				MarkDirty(m_RecordDirty, m_RecordDirtySlots, slot);
+			}
+			m_Keys.pop_back();
+			m_Instances.pop_back();
+			m_Records.pop_back();
+			m_Seen.pop_back();
+			m_InstanceDirty.pop_back();
+			m_RecordDirty.pop_back();
+			m_TopologyChanged = true;
+			return true;
+		}
+
+		void Clear()
+		{
+			const bool hadInstances = !m_Instances.empty();
+			m_Slots.clear();
+			m_Keys.clear();
+			m_Instances.clear();
+			m_Records.clear();
+			m_Seen.clear();
+			m_InstanceDirty.clear();
+			m_RecordDirty.clear();
+			m_InstanceDirtySlots.clear();
+			m_RecordDirtySlots.clear();
+			m_TopologyChanged = m_TopologyChanged || hadInstances;
+		}
+
+		[[nodiscard]] std::optional<uint32_t> FindSlot(const uint64_t key) const
+		{
+			const auto it = m_Slots.find(key);
+			if (it == m_Slots.end())
+			{
+				return std::nullopt;
+			}
+			return it->second;
+		}
+
+		// Turn the changes since the last Commit into a plan and forget them. Rebuild on a topology change, or
+		// when transforms moved and `maxRefits` refits already ran since the last rebuild (a refit keeps the
+		// old BVH, which loosens as instances drift, so trace cost creeps up); Refit when only transforms
+		// moved; None otherwise. maxRefits = 0 never refits. The budget is charged by RecordRefit, not here: a
+		// planned refit the backend refuses runs as a full build instead.
+		TlasUpdatePlan Commit(const uint32_t maxRefits)
+		{
+			TlasUpdatePlan plan;
+			const bool moved = TakeRanges(m_InstanceDirty, m_InstanceDirtySlots, plan.InstanceRanges);
+			TakeRanges(m_RecordDirty, m_RecordDirtySlots, plan.RecordRanges);
+
+			if (m_TopologyChanged || (moved && m_RefitsSinceRebuild >= maxRefits))
+			{
+				plan.Kind = TlasUpdateKind::Rebuild;
+				plan.InstanceRanges.clear();
+				if (!m_Instances.empty())
+				{
+					plan.InstanceRanges.push_back({.First = 0, .Count = static_cast<uint32_t>(m_Instances.size())});
+				}
+				m_TopologyChanged = false;
+			}
+			else if (moved)
+			{
+				plan.Kind = TlasUpdateKind::Refit;
+			}
+			return plan;
+		}
+
+		// Report how a committed plan actually ran: an UPDATE-mode refit spends one refit of the budget, a full
+		// build (planned, or a refused refit's fallback) restores the BVH and resets it.
+		void RecordRefit() { ++m_RefitsSinceRebuild; }
+		void RecordRebuild() { m_RefitsSinceRebuild = 0; }
+
+		// Make the next Commit a Rebuild (the TLAS it described was lost, or a refit of it failed).
+		void InvalidateTopology() { m_TopologyChanged = true; }
+
+		[[nodiscard]] const std::vector<TLASInstance>& GetInstances() const { return m_Instances; }
+		[[nodiscard]] const std::vector<Record>& GetRecords() const { return m_Records; }
+		[[nodiscard]] const std::vector<uint64_t>& GetKeys() const { return m_Keys; } // key per slot
+		[[nodiscard]] uint32_t GetRefitsSinceRebuild() const { return m_RefitsSinceRebuild; }
+
+	private:
+		static void MarkDirty(std::vector<uint8_t>& flags, std::vector<uint32_t>& slots, const uint32_t slot)
+		{
+			if (!flags[slot])
+			{
+				flags[slot] = 1;
+				slots.push_back(slot);
+			}
+		}
+
+		// Coalesce the dirty slots into sorted runs and clear them. The list can hold slots popped by Remove
+		// since they were marked (and, re-added, marked twice); both are dropped here.
+		static bool TakeRanges(std::vector<uint8_t>& flags, std::vector<uint32_t>& slots, std::vector<TlasSlotRange>& out)
+		{
+			std::ranges::sort(slots);
+			const auto [first, last] = std::ranges::unique(slots);
+			slots.erase(first, last);
+			for (const uint32_t slot : slots)
+			{
+				if (slot >= flags.size() || !flags[slot])
+				{
+					continue;
+				}
+				flags[slot] = 0;
+				if (!out.empty() && out.back().First + out.back().Count == slot)
+				{
+					++out.back().Count;
+				}
+				else
+				{
+					out.push_back({.First = slot, .Count = 1});
+				}
+			}
+			slots.clear();
+			return !out.empty();
+		}
+
+		std::unordered_map<uint64_t, uint32_t> m_Slots;
+		std::vector<uint64_t> m_Keys;
+		std::vector<TLASInstance> m_Instances;
+		std::vector<Record> m_Records;
+		std::vector<uint32_t> m_Seen; // sync generation that last Upserted each slot
+		std::vector<uint8_t> m_InstanceDirty;
+		std::vector<uint8_t> m_RecordDirty;
+		std::vector<uint32_t> m_InstanceDirtySlots;
+		std::vector<uint32_t> m_RecordDirtySlots;
+		uint32_t m_SyncGeneration = 0;
+		uint32_t m_RefitsSinceRebuild = 0;
+		bool m_TopologyChanged = true; // the first Commit builds
+	};
+}
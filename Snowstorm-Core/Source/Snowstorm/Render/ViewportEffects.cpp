@@ -964,10 +964,11 @@ namespace Snowstorm
 
 				// The whole light block feeds the importance sampler (positions/dirs/ranges/cones/luma + per-light
 				// cast masks). No lights -> skip (the pass would write ratio 1 everywhere, harmless, but save it).
-				// Copy the light block by value into the lambda (per-frame, ~KB): captured across the graph
-				// build -> execute boundary, so a reference into FrameData would risk a stale/dangling read.
+				// Copy the light block by value into the lambda (per-frame; the point/spot vectors are a heap copy):
+				// captured across the graph build -> execute boundary, so a reference into FrameData would risk a
+				// stale/dangling read.
 				const LightDataBlock lights = fc.Renderer.GetLights();
-				if (lights.LightCount <= 0 && lights.PointCount <= 0 && lights.SpotCount <= 0)
+				if (lights.LightCount <= 0 && lights.PointLights.empty() && lights.SpotLights.empty())
 				{
 					return;
 				}
@@ -2160,11 +2161,11 @@ namespace Snowstorm
 				}
 
 				// ---- Dataset export (#46): copy (low-res color, motion vectors, full-res ground truth) to the CPU
-				// and serialize as .npy + manifest. Needs all three written this frame: LR (forward), MV (velocity
-				// pass, forced on above), GT (the compare 2nd render). Gated on dataset.export && compare && the
-				// velocity buffer being produced. One graph pass (IsCompute: no render target) after everything
-				// above; it declares the three targets as Sampled reads so the graph normalizes their layout, then
-				// CopyTextureToBuffer pulls each to a host-visible buffer.
+				// and queue them on the async dataset writer (.npy files or tar shards + manifest). Needs all three
+				// written this frame: LR (forward), MV (velocity pass, forced on above), GT (the compare 2nd render).
+				// Gated on dataset.export && compare && the velocity buffer being produced. One graph pass (IsCompute:
+				// no render target) after everything above; it declares the three targets as Sampled reads so the
+				// graph normalizes their layout, then CopyTextureToBuffer pulls each to a host-visible buffer.
 				const bool exporting = CVars::DatasetExport.Get() && v.Comparing;
 				if (exporting && v.VelocityNeeded && vpRT.GroundTruthTarget &&
 				    !vpRT.GroundTruthTarget->GetDesc().ColorAttachments.empty() && vpRT.GroundTruthPresentTarget &&
@@ -2180,13 +2181,25 @@ namespace Snowstorm
 					const float scale = CVars::ClampedRenderScale();
 					const std::string outDir = CVars::DatasetExportPath.Get();
 					const uint32_t warmup = static_cast<uint32_t>(std::max(0, CVars::DatasetExportWarmup.Get()));
+					const uint32_t shard = static_cast<uint32_t>(std::max(0, CVars::DatasetExportShard.Get()));
+					const uint32_t queue = static_cast<uint32_t>(std::max(1, CVars::DatasetExportQueue.Get()));
+					const std::string& compressionName = CVars::DatasetExportCompression.Get();
+					const std::optional<DatasetCompression> parsed = ParseDatasetCompression(compressionName);
+					if (!parsed && compressionName != m_WarnedCompression)
+					{
+						// Once per bad value, not per exported frame; a typo must not quietly write raw arrays.
+						SS_CORE_WARN("dataset.export.compression '{}' is not one of none | zstd | lz4; exporting uncompressed.",
+						             compressionName);
+					}
+					m_WarnedCompression = parsed ? std::string() : compressionName;
+					const DatasetCompression compression = parsed.value_or(DatasetCompression::None);
 					fc.Graph.AddPass({.Name = "DatasetExport" + passSuffix,
 					                  .IsCompute = true, // no render target; records readback copies
 					                  .Reads = {{lrImg, RenderGraph::AccessState::Sampled},
 					                            {mvImg, RenderGraph::AccessState::Sampled},
 					                            {gtImg, RenderGraph::AccessState::Sampled},
 					                            {gtLdrImg, RenderGraph::AccessState::Sampled}},
-					                  .Execute = [this, &fc, lrImg, mvImg, gtImg, gtLdrImg, jitter, scale, outDir, warmup](CommandContext& c)
+					                  .Execute = [this, &fc, lrImg, mvImg, gtImg, gtLdrImg, jitter, scale, outDir, warmup, shard, queue, compression](CommandContext& c)
 					                  {
 						                  // The GT tonemap pass wrote gtLdrImg and left it in SHADER_READ; the graph now
 						                  // emits the color-write -> compute-read barrier for every .Reads entry of this
@@ -2201,10 +2214,13 @@ namespace Snowstorm
 						                  dsin.Scale = scale;
 						                  dsin.FrameIndex = fc.FrameIndex;
 						                  dsin.Warmup = warmup;
+						                  dsin.FramesPerShard = shard;
+						                  dsin.Compression = compression;
+						                  dsin.QueueDepth = queue;
 						                  // Non-owning Ref to the graph's context (the pass API takes a Ref; the graph owns it).
 						                  const Ref<CommandContext> cref(&c, [](CommandContext*) {});
-						                  const uint64_t written = m_DatasetExportPass.CaptureAndSerialize(cref, dsin, outDir);
-						                  fc.Renderer.SetDatasetFramesWritten(written);
+						                  m_DatasetExportPass.CaptureAndSerialize(cref, dsin, outDir);
+						                  fc.Renderer.SetDatasetExportStats(m_DatasetExportPass.ExportStats());
 					                  }});
 				}
 			}
@@ -2212,7 +2228,8 @@ namespace Snowstorm
 		private:
 			RenderSystem& m_Owner;
 			MetricsPass m_MetricsPass;             // PSNR/SSIM reduction; exclusive to this effect
-			DatasetExportPass m_DatasetExportPass; // readback + .npy serialize; exclusive to this effect
+			DatasetExportPass m_DatasetExportPass; // readback + async .npy writer; exclusive to this effect
+			std::string m_WarnedCompression;       // last invalid dataset.export.compression warned about
 			// SSAA ground-truth (DLAA #98): lazily-allocated 2x GT render target + a bilinear downsample pass
 			// (2x -> 1x box average) that feeds GroundTruthTarget. Capture-only, so owned here (not on
 			// RenderTargetComponent). m_GtSsaaW/H cache the size for lazy recreate on a viewport resize.
@@ -2253,7 +2270,7 @@ namespace Snowstorm
 				// Convergence auto-stop (#160): the pass waits for streaming to finish, then checkpoints the present
 				// and captures once its frame-to-frame change drops below epsilon (PT accumulated / TAA+denoisers
 				// settled) past a minimum settle, with a max-frame safety cap. All the state lives in the pass.
-				const bool streamingDone = !v.PathTraceSceneSettling; // PathTraceSceneSettling = PendingLoadCount>0
+				const bool streamingDone = !v.PathTraceSceneSettling; // PathTraceSceneSettling = a load burst is open
 				const uint64_t frame = fc.Renderer.GetFrameCounter();
 				const uint64_t minSettle = static_cast<uint64_t>(CVars::QualityCaptureFrames.Get());
 				const int maxCVar = CVars::QualityCaptureMaxFrames.Get();
@@ -11,6 +11,7 @@
 #include "Snowstorm/Systems/CameraJitterSystem.hpp"
 #include "Snowstorm/Systems/CameraPathSystem.hpp"
 #include "Snowstorm/Systems/CameraRuntimeUpdateSystem.hpp"
+#include "Snowstorm/Systems/LevelStreamingSystem.hpp"
 #include "Snowstorm/Systems/MaterialResolveSystem.hpp"
 #include "Snowstorm/Systems/MeshResolveSystem.hpp"
 #include "Snowstorm/Systems/PrevTransformSnapshotSystem.hpp"
@@ -41,6 +42,9 @@ namespace Snowstorm
 		sm.RegisterSystem<RotatorSystem>(SystemPhase::Logic);
 
 		sm.RegisterSystem<ShaderReloadSystem>(SystemPhase::AssetSync);
+		// Stream world-partition cells in/out around the camera; before the asset pump so evictions and new
+		// cells are seen by it this frame.
+		sm.RegisterSystem<LevelStreamingSystem>(SystemPhase::AssetSync);
 		// Pump worker-completed async loads (GPU finalize) before the Resolve phase consumes them.
 		sm.RegisterSystem<AssetLoadSystem>(SystemPhase::AssetSync);
 
@@ -0,0 +1,56 @@
+#include "LevelStreamingSystem.hpp"
+
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/CameraRuntimeComponent.hpp"
+#include "Snowstorm/Components/DoNotSerializeComponent.hpp"
+#include "Snowstorm/World/LevelStreamingSingleton.hpp"
+#include "Snowstorm/World/SimulationStateSingleton.hpp"
+
+namespace Snowstorm
+{
+	void LevelStreamingSystem::Execute(Timestep)
+	{
+		auto& streaming = SingletonView<LevelStreamingSingleton>();
+		if (!streaming.IsOpen())
+		{
+			return;
+		}
+
+		// A scene wipe already destroyed the streamed entities; Close releases their asset references.
+		if (m_World->SceneGeneration() != streaming.GetSceneGeneration())
+		{
+			streaming.Close();
+			return;
+		}
+
+		const bool editing = m_World->HasSingleton<SimulationStateSingleton>() &&
+		                     !m_World->GetSingleton<SimulationStateSingleton>().IsPlaying();
+		auto& reg = m_World->GetRegistry();
+		const CameraRuntimeComponent* camera = nullptr;
+		for (auto cameraView = View<CameraComponent, CameraRuntimeComponent>(); auto entity : cameraView)
+		{
+			const bool preferred = editing ? reg.any_of<DoNotSerializeComponent>(entity) : cameraView.get<CameraComponent>(entity).Primary;
+			if (!camera || preferred)
+			{
+				camera = &cameraView.get<CameraRuntimeComponent>(entity);
+			}
+			if (preferred)
+			{
+				break;
+			}
+		}
+		if (!camera)
+		{
+			return; // nothing to stream around yet
+		}
+
+		const glm::vec3 origin = glm::vec3(glm::inverse(camera->View)[3]);
+
+		JobSystem* jobs = nullptr;
+		if (Application::Exists() && Application::Get().GetServiceManager().ServiceRegistered<JobSystem>())
+		{
+			jobs = &ServiceView<JobSystem>();
+		}
+		streaming.Update(origin, jobs);
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Snowstorm/ECS/System.hpp"
+
+namespace Snowstorm
+{
+	// Drives LevelStreamingSingleton once a frame: closes the partition after a scene wipe, finds the camera
+	// to stream around and hands it to Update(). Runs in the AssetSync phase BEFORE AssetLoadSystem, so a cell
+	// committed this frame has its meshes requested (MeshResolveSystem) the same frame, and an eviction is
+	// seen by this frame's asset pump. The camera position is last frame's (CameraRuntimeUpdateSystem runs
+	// later, in Resolve) -- one frame behind is nothing at streaming distances.
+	//
+	// Which camera: in the editor's Edit mode the Scene-view camera (the DoNotSerialize one), so cells
+	// stream around wherever the level designer is looking; otherwise the Primary camera, else the first.
+	class LevelStreamingSystem final : public System
+	{
+	public:
+		explicit LevelStreamingSystem(const WorldRef world)
+		    : System(world)
+		{
+		}
+
+		void Execute(Timestep ts) override;
+	};
+}
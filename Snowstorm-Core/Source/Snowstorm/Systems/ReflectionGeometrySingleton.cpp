@@ -0,0 +1,141 @@
+#include "ReflectionGeometrySingleton.hpp"
+
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/Buffer.hpp"
+#include "Snowstorm/Render/Renderer.hpp"
+
+#include "Platform/Vulkan/VulkanBuffer.hpp"
+#include "Platform/Vulkan/VulkanCommandContext.hpp"
+
+#include <algorithm>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// vkCmdUpdateBuffer's per-call limit. The update is inlined into the command buffer, which is the point:
+		// a moving prop's record is 144 bytes, and no staging buffer has to outlive the frame.
+		constexpr uint32_t kMaxInlineUpdateBytes = 65536;
+	}
+
+	void ReflectionGeometrySingleton::Publish(const std::span<const GeometryRecord> records,
+	                                          const std::span<const TlasSlotRange> changed)
+	{
+		if (records.empty())
+		{
+			m_Records.clear();
+			m_SlotSerials.clear();
+			TableAddress = 0; // no table this frame -> shader uses the sky-cube fallback
+			return;
+		}
+
+		const auto count = static_cast<uint32_t>(records.size());
+		if (m_Frames.empty() || m_Capacity < count)
+		{
+			// DEVICE-LOCAL (hostVisible=false): the table is read on the GPU hot path — every reflection/GI
+			// ray that hits geometry does several RawBufferLoads here plus vertex/index fetches — but written
+			// only for the records that changed. A host-visible allocation lands in system RAM on a discrete
+			// GPU, so those hot reads would cross PCIe; device-local keeps them in VRAM. Fresh copies are filled
+			// through SetData's staging upload; freeing the outgrown ones drains the device (VulkanBuffer's
+			// destructor), which only happens when the scene outgrows the table.
+			m_Capacity = count;
+			m_Frames.assign(std::max(1u, Renderer::GetFramesInFlight()), {});
+			for (FrameTable& frame : m_Frames)
+			{
+				frame.Table = Buffer::Create(static_cast<size_t>(count) * sizeof(GeometryRecord), BufferUsage::Storage,
+				                             records.data(), false, "ReflectionGeometryTable");
+				frame.SyncedSerial = m_Serial;
+			}
+			m_Records.assign(records.begin(), records.end());
+			m_SlotSerials.assign(count, m_Serial);
+			return;
+		}
+
+		// Stage only the changed runs: a moving prop rewrites its own 144 bytes, not the whole scene's table.
+		// Nothing touches the GPU copies here — the reflection/GI shaders of frames still in flight read them by
+		// device address (a raw read sync validation can't see), and overwriting one mid-read tore a record
+		// into a garbage VertexAddress → GPU READ_INVALID → VK_ERROR_DEVICE_LOST. Each copy is rewritten by
+		// RecordPendingUpdates on its own frame, once that slot's fence has retired the frame that read it.
+		m_Records.resize(count);
+		m_SlotSerials.resize(count, 0);
+		if (changed.empty())
+		{
+			return;
+		}
+		++m_Serial;
+		for (const TlasSlotRange& range : changed)
+		{
+			const uint32_t end = std::min(range.First + range.Count, count);
+			for (uint32_t i = range.First; i < end; ++i)
+			{
+				m_Records[i] = records[i];
+				m_SlotSerials[i] = m_Serial;
+			}
+		}
+	}
+
+	void ReflectionGeometrySingleton::RecordPendingUpdates(CommandContext& ctx, const uint32_t frameIndex)
+	{
+		if (Tlas)
+		{
+			Tlas->RecordPendingRefit(ctx, frameIndex);
+		}
+
+		if (m_Records.empty() || m_Frames.empty())
+		{
+			return;
+		}
+		SS_CORE_ASSERT(frameIndex < m_Frames.size(), "Geometry table recorded for an unknown frame slot");
+
+		// Catch this frame's copy up on every record published since it was last written — this frame's
+		// changes and those of the frames that recorded into the other copies. BeginFrame's fence wait retired
+		// the frame that last read this copy, so the writes need no barrier in front; the one behind makes
+		// them visible to this frame's traces.
+		FrameTable& frame = m_Frames[frameIndex];
+		if (frame.SyncedSerial != m_Serial)
+		{
+			const VkCommandBuffer cmd = static_cast<VulkanCommandContext&>(ctx).GetVulkanCommandBuffer();
+			const VkBuffer buffer = std::static_pointer_cast<VulkanBuffer>(frame.Table)->GetHandle();
+			const auto count = static_cast<uint32_t>(m_Records.size());
+			for (uint32_t i = 0; i < count;)
+			{
+				if (m_SlotSerials[i] <= frame.SyncedSerial)
+				{
+					++i;
+					continue;
+				}
+				const uint32_t first = i;
+				while (i < count && m_SlotSerials[i] > frame.SyncedSerial)
+				{
+					++i;
+				}
+
+				const auto* bytes = reinterpret_cast<const uint8_t*>(m_Records.data() + first);
+				const VkDeviceSize offset = static_cast<VkDeviceSize>(first) * sizeof(GeometryRecord);
+				const VkDeviceSize size = static_cast<VkDeviceSize>(i - first) * sizeof(GeometryRecord);
+				for (VkDeviceSize done = 0; done < size; done += kMaxInlineUpdateBytes)
+				{
+					vkCmdUpdateBuffer(cmd, buffer, offset + done, std::min<VkDeviceSize>(kMaxInlineUpdateBytes, size - done),
+					                  bytes + done);
+				}
+			}
+
+			VkMemoryBarrier2 barrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+			barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+			barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+			barrier.dstStageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+			barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+
+			VkDependencyInfo dep{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+			dep.memoryBarrierCount = 1;
+			dep.pMemoryBarriers = &barrier;
+			vkCmdPipelineBarrier2(cmd, &dep);
+
+			frame.SyncedSerial = m_Serial;
+		}
+
+		// Publish the address every frame the table is populated: it names this frame's copy, and the copies
+		// survive an RT-off cycle (Publish's empty branch zeroes the address but frees nothing).
+		TableAddress = frame.Table->GetGPUAddress();
+	}
+}
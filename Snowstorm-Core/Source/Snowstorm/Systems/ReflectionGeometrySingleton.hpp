@@ -3,12 +3,16 @@
 #include "Snowstorm/Core/Base.hpp"
 #include "Snowstorm/ECS/Singleton.hpp"
 #include "Snowstorm/Math/Math.hpp"
+#include "Snowstorm/Render/AccelerationStructure.hpp"
 
 #include <cstdint>
+#include <span>
+#include <vector>
 
 namespace Snowstorm
 {
 	class Buffer;
+	class CommandContext;
 
 	// One record per TLAS instance, letting an inline reflection ray resolve a committed hit to a shadeable
 	// surface (RT reflections, #118 follow-up). The record carries the hit mesh's vertex/index buffer DEVICE
@@ -53,18 +57,47 @@ namespace Snowstorm
 		float EmissiveR = 0.0f;                     // [132] emissive color factor, per channel
 		float EmissiveG = 0.0f;                     // [136]
 		float EmissiveB = 0.0f;                     // [140]
+
+		// TlasBuildSystem re-uploads only the records that changed.
+		bool operator==(const GeometryRecord&) const = default;
 	};
 	static_assert(sizeof(GeometryRecord) == 144, "GeometryRecord must be 144 bytes to match the HLSL RawBufferLoad offsets");
 
-	// Holds the GPU buffer of per-instance GeometryRecords + its device address. Written by TlasBuildSystem
-	// (in the same gather loop that builds the TLAS), read by RendererService which pushes the address into
-	// FrameCB so DefaultLit's reflection trace can resolve hits. Only maintained while RT reflections are
+	// Holds the GPU buffers of per-instance GeometryRecords + the scene TLAS, and records their per-frame
+	// updates. Published by TlasBuildSystem (in the same gather loop that builds the TLAS) during PreRender;
+	// RenderSystem then records the staged GPU work at the top of the frame's command buffer and pushes
+	// TableAddress into FrameCB so DefaultLit's reflection trace can resolve hits. Only maintained while RT is
 	// active; empty (address 0) otherwise, and the shader falls back to the sky cube.
 	class ReflectionGeometrySingleton final : public Singleton
 	{
 	public:
-		Ref<Buffer> Table;         // device-address storage buffer of GeometryRecord[]; grown as needed
-		uint32_t Capacity = 0;     // records the current Table can hold
-		uint64_t TableAddress = 0; // Table's GPU device address (0 = no table this frame)
+		// Bring the table in line with `records` (TLAS slot order); `changed` lists the slots that differ from the
+		// last publish. A set that outgrows the table reallocates every frame's copy with the full contents (a
+		// rare, draining step); otherwise the changed records are only staged for RecordPendingUpdates. An empty
+		// set publishes no table.
+		void Publish(std::span<const GeometryRecord> records, std::span<const TlasSlotRange> changed);
+
+		// Record the staged GPU work into this frame's command buffer, ahead of every pass that traces: the TLAS
+		// refit, then this frame's copy of the table catching up on the records changed since it was last
+		// written. Points TableAddress at that copy. Call right after BeginFrame.
+		void RecordPendingUpdates(CommandContext& ctx, uint32_t frameIndex);
+
+		Ref<TLAS> Tlas;            // the scene TLAS (TlasBuildSystem); null until the first RT-enabled build
+		uint64_t TableAddress = 0; // this frame's table copy by GPU device address (0 = no table this frame)
+
+	private:
+		// One DEVICE-LOCAL table per frame in flight, so a frame rewrites its own copy while earlier frames still
+		// read theirs. SyncedSerial = the publish serial the copy was last brought up to.
+		struct FrameTable
+		{
+			Ref<Buffer> Table;
+			uint64_t SyncedSerial = 0;
+		};
+
+		std::vector<FrameTable> m_Frames;
+		std::vector<GeometryRecord> m_Records; // the published table, CPU side
+		std::vector<uint64_t> m_SlotSerials;   // publish serial that last changed each record
+		uint64_t m_Serial = 0;
+		uint32_t m_Capacity = 0; // records each copy can hold
 	};
 }
@@ -16,6 +16,7 @@
 
 #include "Snowstorm/Assets/AssetManagerSingleton.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Events/DeferredEvents.hpp"
 #include "Snowstorm/Systems/ReflectionGeometrySingleton.hpp"
 #include "Snowstorm/Render/RenderGraph.hpp"
 #include "Snowstorm/Render/Renderer.hpp"
@@ -53,6 +54,18 @@ namespace Snowstorm
 		}
 	}
 
+	RenderSystem::RenderSystem(const WorldRef world)
+	    : System(world)
+	{
+		if (Application::Exists())
+		{
+			auto& bus = Application::Get().GetEventBus();
+			const auto refresh = [this](auto) { m_AssetsStreaming = SingletonView<AssetManagerSingleton>().PendingLoadCount() > 0; };
+			m_LoadsStarted = bus.SubscribeDeferred<AssetLoadsStartedEvent>(refresh);
+			m_LoadsSettled = bus.SubscribeDeferred<AssetLoadsSettledEvent>(refresh);
+		}
+	}
+
 	void RenderSystem::Execute(const Timestep /*ts*/)
 	{
 		auto& reg = m_World->GetRegistry();
@@ -105,6 +118,8 @@ namespace Snowstorm
 		// EndFrame must not run if BeginFrame didn't start a frame.
 		if (!Renderer::BeginFrame())
 		{
+			// The shadow atlas caches track caster motion frame by frame; this frame's moves go unseen.
+			m_ShadowRenderer.InvalidateCaches();
 			return;
 		}
 
@@ -124,14 +139,20 @@ namespace Snowstorm
 		// scope. The resolved times feed the editor's "GPU passes" overlay (1-frame lag, like the frame total).
 		renderer.SetGpuPassTimes(ctx->CollectGpuScopes());
 
+		// TlasBuildSystem (PreRender) only staged this frame's TLAS refit and geometry-record changes; record
+		// them ahead of every pass that traces. Recording here rather than in PreRender is what lets them skip
+		// a device drain: BeginFrame has just retired this slot's previous frame.
+		auto& rtGeometry = SingletonView<ReflectionGeometrySingleton>();
+		rtGeometry.RecordPendingUpdates(*ctx, frameIndex);
+
 		RenderGraph graph;
 
 		FrameContext fc{.Graph = graph, .Renderer = renderer, .Ctx = ctx, .Reg = reg, .FrameIndex = frameIndex};
 
-		// RT reflections (#118): hand the per-instance geometry-table address (TlasBuildSystem filled it in
-		// PreRender) to the renderer so AcquireFrameSet folds it into FrameCB. 0 when reflections are off ->
+		// RT reflections (#118): hand the per-instance geometry-table address (this frame's copy, set by
+		// RecordPendingUpdates above) to the renderer so AcquireFrameSet folds it into FrameCB. 0 when reflections are off ->
 		// the shader's reflection trace falls back to the sky cube.
-		renderer.SetReflectionGeometryAddress(SingletonView<ReflectionGeometrySingleton>().TableAddress);
+		renderer.SetReflectionGeometryAddress(rtGeometry.TableAddress);
 
 		const EnvironmentDataBlock& env = renderer.GetEnvironment();
 		SetupIBL(fc, env);
@@ -390,8 +411,10 @@ namespace Snowstorm
 		v.GBufferNeeded = gbufferNeeded;
 
 		// While assets stream in, meshes/textures show the magenta placeholder; keep the path tracer resetting so
-		// those frames never bake into the converged accumulation (#153).
-		v.PathTraceSceneSettling = SingletonView<AssetManagerSingleton>().PendingLoadCount() > 0;
+		// those frames never bake into the converged accumulation (#153). The flag trails the asset manager by a
+		// frame (events are delivered at the next frame start): a burst's first placeholder frame is discarded by
+		// the reset that follows it, and the frame after the last load resets once more.
+		v.PathTraceSceneSettling = m_AssetsStreaming;
 
 		// Tonemap debug params (#44/#124): visualize an aux buffer ONLY when its debug view is explicitly
 		// selected — NOT merely when the buffer is being rendered (TAA/GI render their buffers but must show
@@ -36,10 +36,7 @@ namespace Snowstorm
 	class RenderSystem final : public System
 	{
 	public:
-		explicit RenderSystem(const WorldRef world)
-		    : System(world)
-		{
-		}
+		explicit RenderSystem(WorldRef world);
 
 		void Execute(Timestep ts) override;
 
@@ -141,5 +138,14 @@ namespace Snowstorm
 		// finished loading after the deferred startup load, so the first bake saw an empty/default world), we
 		// invalidate the bake so it re-runs against the real sky. nullopt = never baked. (#64)
 		std::optional<EnvironmentDataBlock> m_BakedEnvironment;
+
+		// Whether asset loads are in flight, which keeps the path tracer resetting
+		// (ViewportRenderContext::PathTraceSceneSettling). Refreshed from the asset manager when a load burst
+		// starts or settles (AssetLoadsStarted/SettledEvent) rather than read every frame; re-reading on the
+		// event, instead of toggling on it, stays right when a burst's start and end share a dispatch or a
+		// replaced World's last events arrive late.
+		bool m_AssetsStreaming = false;
+		EventBus::Connection m_LoadsStarted; // last: disconnect before the flag goes away
+		EventBus::Connection m_LoadsSettled;
 	};
 }
@@ -1,13 +1,23 @@
 #include "ShaderReloadSystem.hpp"
 
+#include "Snowstorm/Assets/AssetIndex.hpp"
+#include "Snowstorm/Assets/AssetManagerSingleton.hpp"
 #include "Snowstorm/Assets/MaterialAsset.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Project/Project.hpp"
 #include "Snowstorm/Render/Pipeline.hpp"
 #include "Snowstorm/Render/Shader.hpp"
 
 namespace Snowstorm
 {
+	namespace
+	{
+		// How long the event stream must stay quiet before a batch of changes is acted on.
+		constexpr float kChangeSettleSeconds = 0.1f;
+	}
+
 	void ShaderReloadSystem::Execute(const Timestep ts)
 	{
 		auto& shaderLibrary = ServiceView<ShaderLibrary>();
@@ -15,9 +25,21 @@ namespace Snowstorm
 		bool needPipelineRebuild = false;
 
 		// DefaultLit RT-permutation swap (#118 perf): the lit shader compiles the cheap non-RT variant when no
-		// RT effect is active, and the heavy RT variant otherwise. A permutation change is NOT an mtime change,
-		// so ReloadAll below won't catch it — drive it explicitly here. Checked every frame (a cheap CVar read)
-		// so toggling an RT effect swaps promptly. The key is the composite the mesh pipeline loads.
+		// RT effect is active, and the heavy RT variant otherwise. A permutation change is NOT a file change, so
+		// the hot-reload path below won't catch it — drive it explicitly here. Checked every frame (a cheap CVar
+		// read) so toggling an RT effect swaps promptly. The key is the composite the mesh pipeline loads.
+		//
+		// The recompile runs on a worker: with a cooked bundle (Snowstorm-ShaderCook) it is a cache lookup /
+		// extraction, and without one it may be a full dxc compile — either way the render thread keeps drawing
+		// with the current variant and the pipelines are rebuilt on the first frame after it lands. A toggle
+		// during an in-flight swap is picked up once it finishes.
+		if (m_LitSwap.valid() && m_LitSwap.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			m_LitSwap.get();
+			needPipelineRebuild = true;
+		}
+
+		if (!m_LitSwap.valid())
 		{
 			const std::string litKey = std::string("Engine/Shaders/Mesh.vert.hlsl|") + kDefaultFragmentShader;
 			if (shaderLibrary.Exists(litKey))
@@ -30,8 +52,7 @@ namespace Snowstorm
 					if (lit->GetPermutation() != desired)
 					{
 						lit->SetPermutation(desired);
-						lit->Recompile(); // synchronous; warm .spv cache makes this a fs::exists check after first build
-						needPipelineRebuild = true;
+						m_LitSwap = shaderLibrary.RecompileAsync(lit);
 						SS_CORE_INFO("DefaultLit RT permutation -> {}", wantRT ? "RT" : "non-RT");
 					}
 					m_LastWantRT = wantRT;
@@ -45,17 +66,72 @@ namespace Snowstorm
 		// multi-second synchronous stall we deliberately don't do mid-session (Unreal's r.Shaders.Optimize
 		// model — the old live checkbox froze the editor). Change it in SnowstormStartup.cfg / CLI and relaunch.
 
-		static float timeSinceLastCheck = 0.0f;
-		timeSinceLastCheck += ts.GetSeconds();
+		// Hot reload is event-driven: the FileWatcher service watches the engine shaders and the active project's
+		// assets and queues every touched file; here the queue is drained and each path is routed through the
+		// dependency graphs — ShaderLibrary recompiles the shaders whose include closure contains it, the asset
+		// manager re-decodes textures / re-reads materials whose source it is. Nothing is stat()ed while nobody
+		// is editing. Roots are (re)set only when the project's asset directory moved.
+		auto& watcher = ServiceView<FileWatcher>();
+		const Ref<Project> project = Project::GetActive();
+		const std::filesystem::path assetDir = project ? project->GetAssetDirectory() : std::filesystem::path{};
+		if (!m_WatchRootsSet || assetDir != m_WatchedAssetDir)
+		{
+			watcher.SetWatchRoots({"Engine/Shaders", assetDir});
+			m_WatchedAssetDir = assetDir;
+			m_WatchRootsSet = true;
+		}
+
+		if (watcher.IsActive())
+		{
+			std::vector<std::string> changed;
+			if (watcher.Drain(changed))
+			{
+				m_RescanPending = true;
+			}
+			if (!changed.empty())
+			{
+				m_PendingChanges.insert(changed.begin(), changed.end());
+				m_QuietTime = 0.0f;
+			}
+			m_QuietTime += ts.GetSeconds();
+
+			if ((!m_PendingChanges.empty() || m_RescanPending) && m_QuietTime >= kChangeSettleSeconds)
+			{
+				if (m_RescanPending)
+				{
+					// Events were lost, so the targeted path can't be trusted for shaders: re-check every one.
+					SS_CORE_WARN("FileWatcher dropped events; rescanning all shaders (reload edited textures/materials by re-saving them)");
+					shaderLibrary.ReloadAll();
+					needPipelineRebuild = true;
+				}
 
-		//-- check for source edits every 1 second (hot reload)
-		if (timeSinceLastCheck > 1.0f)
+				const std::vector<std::string> files(m_PendingChanges.begin(), m_PendingChanges.end());
+				if (!m_RescanPending && shaderLibrary.OnFilesChanged(files) > 0)
+				{
+					needPipelineRebuild = true;
+				}
+				SingletonView<AssetManagerSingleton>().OnSourceFilesChanged(files);
+
+				// The Content Browser's index updates just these entries (or re-walks, if events were lost).
+				ServiceView<AssetIndex>().NotifyChanged(files, m_RescanPending);
+
+				m_PendingChanges.clear();
+				m_RescanPending = false;
+			}
+		}
+		else
 		{
-			// Recompile any shader whose source (or an included header) changed -> bumps its version and writes
-			// fresh SPIR-V to the cache. (ReloadAll self-skips unchanged shaders.)
-			shaderLibrary.ReloadAll();
-			needPipelineRebuild = true; // a changed shader bumps its version; the sweep below self-skips otherwise
-			timeSinceLastCheck = 0.0f;
+			// No watcher (unsupported platform / the OS refused the watch): the old mtime poll, once a second.
+			static float timeSinceLastCheck = 0.0f;
+			timeSinceLastCheck += ts.GetSeconds();
+			if (timeSinceLastCheck > 1.0f)
+			{
+				// Recompile any shader whose source (or an included header) changed -> bumps its version and
+				// writes fresh SPIR-V to the cache. (ReloadAll self-skips unchanged shaders.)
+				shaderLibrary.ReloadAll();
+				needPipelineRebuild = true; // a changed shader bumps its version; the sweep below self-skips otherwise
+				timeSinceLastCheck = 0.0f;
+			}
 		}
 
 		if (needPipelineRebuild)
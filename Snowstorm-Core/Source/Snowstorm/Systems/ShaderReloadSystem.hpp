@@ -2,6 +2,11 @@
 
 #include "Snowstorm/ECS/System.hpp"
 
+#include <filesystem>
+#include <future>
+#include <string>
+#include <unordered_set>
+
 namespace Snowstorm
 {
 	class ShaderReloadSystem final : public System
@@ -20,5 +25,17 @@ namespace Snowstorm
 		// first ready frame to establish the correct variant even when it matches the device default.
 		bool m_LitInitialized = false;
 		bool m_LastWantRT = false;
+		std::future<void> m_LitSwap; // in-flight permutation recompile; pipelines rebuild when it lands
+
+		// FileWatcher drain state. Changes are batched until the stream has been quiet for a moment: one editor
+		// save is often several OS events (truncate, write, rename), and reloading on the first would read a
+		// half-written file.
+		std::unordered_set<std::string> m_PendingChanges;
+		bool m_RescanPending = false; // the watcher dropped events -> full ReloadAll instead of a targeted reload
+		float m_QuietTime = 0.0f;
+
+		// Roots last handed to the watcher (the asset directory moves with the active project).
+		std::filesystem::path m_WatchedAssetDir;
+		bool m_WatchRootsSet = false;
 	};
 }
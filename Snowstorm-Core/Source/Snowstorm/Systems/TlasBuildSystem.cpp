@@ -6,6 +6,7 @@
 #include "Snowstorm/Components/TransformComponent.hpp"
 #include "Snowstorm/Core/EngineCVars.hpp"
 #include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Events/DeferredEvents.hpp"
 #include "Snowstorm/Render/Buffer.hpp"
 #include "Snowstorm/Render/MaterialInstance.hpp"
 #include "Snowstorm/Render/Mesh.hpp"
@@ -17,13 +18,35 @@
 #include "Platform/Vulkan/VulkanBindlessManager.hpp"
 #include "Platform/Vulkan/VulkanTlas.hpp"
 
+#include <algorithm>
+#include <span>
+
 namespace Snowstorm
 {
-	bool TlasBuildSystem::IsSceneDirtyThisFrame() const
+	TlasBuildSystem::TlasBuildSystem(const WorldRef world)
+	    : System(world)
+	{
+		// A texture going resident is the one scene change no component dirty flag reports, and a cutout's OMM
+		// can only bake once its albedo is resident (see SyncAllInstances). Hear about it from the asset
+		// manager's deferred AssetLoadedEvent instead of polling its pending count every frame. No Application
+		// (unit tests) means no bus and no streaming.
+		if (Application::Exists())
+		{
+			m_AssetLoads = Application::Get().GetEventBus().SubscribeDeferred<AssetLoadedEvent>(
+			    [this](const std::span<const AssetLoadedEvent> loads)
+			    {
+				    m_TexturesLanded = m_TexturesLanded || std::ranges::any_of(loads, [](const AssetLoadedEvent& e)
+				                                                               { return e.Success && e.Type == AssetType::Texture; });
+			    });
+		}
+	}
+
+	bool TlasBuildSystem::IsInstanceSetDirtyThisFrame() const
 	{
-		// The TLAS instances are exactly the (Transform + Mesh) entities. It needs a rebuild only when the
-		// instance SET changes (a mesh/transform added or removed, a mesh resolved) or an instance's
-		// PLACEMENT changes (the transform of a MESH entity moved).
+		// The TLAS instances are exactly the (Transform + Mesh) entities. The whole set needs re-syncing only
+		// when it may have CHANGED: a mesh/transform added or removed, a mesh resolved, a material changed.
+		// Re-syncing doesn't mean rebuilding: the instance table diffs the result, and only a real change to
+		// what's instanced (an instance added/removed, a BLAS swapped) rebuilds the TLAS.
 		//
 		// Add/remove are one-shot events (spawn/despawn) — cheap to over-trigger, so left unfiltered.
 		if (!ChangedView<MeshComponent>().empty()) // mesh resolved / swapped
@@ -52,19 +75,34 @@ namespace Snowstorm
 		if (!ChangedView<MaterialComponent>().empty())
 			return true;
 
-		// Placement change is the PER-FRAME hot path: only a changed transform that belongs to a mesh entity
-		// moves an instance. This filters out the camera — whose transform CameraControllerSystem rewrites
-		// every frame you move — so free-flying the view does NOT rebuild the TLAS (the camera isn't an
-		// instance; moving it changes no geometry).
+		// A moved transform is NOT a set change: it's the per-frame hot path, handled incrementally by
+		// SyncMovedInstances (a refit of just the moved instances).
+		return false;
+	}
+
+	void TlasBuildSystem::SyncMovedInstances()
+	{
+		// Placement change is the PER-FRAME hot path: only a changed transform that belongs to an instance
+		// moves it. This filters out the camera — whose transform CameraControllerSystem rewrites every frame
+		// you move — so free-flying the view does NOT touch the TLAS (the camera isn't an instance; moving it
+		// changes no geometry). A mesh entity that isn't an instance yet (mesh/BLAS still resolving) joins
+		// through the set-change path when it resolves.
 		const auto& reg = m_World->GetRegistry();
 		for (const entt::entity e : ChangedView<TransformComponent>())
 		{
-			if (reg.all_of<MeshComponent>(e))
+			const uint64_t key = entt::to_integral(e);
+			const std::optional<uint32_t> slot = m_Instances.FindSlot(key);
+			if (!slot)
 			{
-				return true;
+				continue;
 			}
+			const glm::mat4 model = reg.Read<TransformComponent>(e).GetTransformMatrix();
+			TLASInstance instance = m_Instances.GetInstances()[*slot];
+			GeometryRecord record = m_Instances.GetRecords()[*slot];
+			instance.Transform = model;
+			record.Model = model;
+			m_Instances.Upsert(key, instance, record);
 		}
-		return false;
 	}
 
 	void TlasBuildSystem::Execute(Timestep)
@@ -84,44 +122,58 @@ namespace Snowstorm
 			return;
 		}
 
-		// Toggling render.omm swaps which BLAS each cutout instance uses (OMM vs any-hit); force a rebuild on
+		// Toggling render.omm swaps which BLAS each cutout instance uses (OMM vs any-hit); force a re-sync on
 		// the edge so the A/B / safety switch takes effect on a static scene.
 		const bool ommEnabled = CVars::OmmEnabled.Get();
 		const bool ommToggled = m_BuiltOnce && ommEnabled != m_LastOmmEnabled;
 		m_LastOmmEnabled = ommEnabled;
 
-		// While textures are still streaming, keep rebuilding: a cutout instance whose albedo isn't resident yet
-		// uses the any-hit fallback BLAS this frame (correct but unoptimized) and its OMM must bake once the real
-		// pixels arrive. Nothing else marks the scene dirty on a texture-only completion, so gate on the async
-		// load count. m_PrevPendingLoads carries one extra frame past the drain so the just-resident albedo
-		// triggers the final rebuild that bakes its OMM.
+		// A texture that went resident since the last sync may be a cutout's albedo: a cutout instance whose
+		// albedo isn't resident yet uses the any-hit fallback BLAS (correct but unoptimized) and its OMM must
+		// bake once the real pixels arrive. Nothing else marks the scene dirty on a texture-only completion,
+		// so re-sync on the frame after each batch of texture loads (the AssetLoadedEvent handler sets the
+		// flag), and after a sync that had to skip an OMM because its bake pipeline was still compiling. A
+		// static, fully-loaded scene re-syncs nothing. (A swapped BLAS is a topology change: it rebuilds.)
 		auto& assets = SingletonView<AssetManagerSingleton>();
-		const uint32_t pendingLoads = assets.PendingLoadCount();
-		const bool streaming = pendingLoads > 0 || m_PrevPendingLoads > 0;
-		m_PrevPendingLoads = pendingLoads;
+		const bool streaming = m_TexturesLanded || m_OmmBuildPending;
+		m_TexturesLanded = false;
 
-		// Rebuild when the scene changed OR RT just turned on OR render.omm toggled OR assets are still streaming
-		// (the scene's per-frame dirty flags were consumed on prior frames, so a plain dirty-check would miss
-		// those edges).
-		if (m_BuiltOnce && !justEnabled && !ommToggled && !streaming && !IsSceneDirtyThisFrame())
+		// Re-sync the whole instance set when it may have changed OR RT just turned on OR render.omm toggled OR
+		// assets landed (the scene's per-frame dirty flags were consumed on prior frames, so a plain
+		// dirty-check would miss those edges). Otherwise only the moved instances are updated. Either way the
+		// instance table diffs the result, so the TLAS work below is exactly what changed: nothing, a refit of
+		// the moved instances, or a rebuild.
+		if (!m_BuiltOnce || justEnabled || ommToggled || streaming || IsInstanceSetDirtyThisFrame())
 		{
-			return;
+			if (justEnabled) // the TLAS and its bindless slot may be stale after an RT-off spell
+			{
+				m_Instances.InvalidateTopology();
+			}
+			SyncAllInstances(assets, ommEnabled);
 		}
+		else
+		{
+			SyncMovedInstances();
+		}
+
+		const TlasUpdatePlan plan = m_Instances.Commit(static_cast<uint32_t>(CVars::ClampedTlasMaxRefits()));
+		UploadGeometryRecords(plan);
+		if (plan.Kind != TlasUpdateKind::None)
+		{
+			UpdateTlas(plan);
+		}
+	}
 
+	void TlasBuildSystem::SyncAllInstances(AssetManagerSingleton& assets, const bool ommEnabled)
+	{
 		auto& reg = m_World->GetRegistry();
 
-		// Gather one instance per (Transform + resolved Mesh) entity, building each mesh's BLAS lazily.
-		// The entity of each emitted instance is recorded in lockstep (same order, same skips) so the RT
-		// picking path can map a committed instance index back to its entity. VulkanTlas stamps
-		// instanceCustomIndex = the instance's position in this vector, which is exactly instanceEntities'
-		// index — so instanceEntities[CommittedInstanceID()] resolves the hit.
-		std::vector<TLASInstance> instances;
-		std::vector<entt::entity> instanceEntities;
-		// Per-instance geometry/material table (#118), gathered whenever any RT effect is active. A reflected/
-		// GI hit resolves to a shadeable surface through it, and shadow/AO any-hit rays alpha-test cutout
-		// geometry through it (Inc 2). Filled in lockstep with `instances`, so record[i] describes the
-		// instance the GPU stamps instanceCustomIndex = i.
-		std::vector<GeometryRecord> geoRecords;
+		// One instance per (Transform + resolved Mesh) entity, keyed by entity, building each mesh's BLAS
+		// lazily. Each comes with its geometry/material record (#118): a reflected/GI hit resolves to a
+		// shadeable surface through it, and shadow/AO any-hit rays alpha-test cutout geometry through it
+		// (Inc 2). The table keeps instance i and record i in the same slot, and VulkanTlas stamps
+		// instanceCustomIndex = the slot, so record[CommittedInstanceID()] describes the hit.
+		m_Instances.BeginSync();
 
 		// A cutout (glTF MASK) instance uses an OMM-carrying BLAS on an OMM-capable device (the micromap resolves
 		// coverage during traversal, any-hit only on UNKNOWN edges); elsewhere it falls back to the
@@ -129,6 +181,7 @@ namespace Snowstorm
 		const bool ommDevice = Renderer::IsOpacityMicromapSupported() && ommEnabled;
 		constexpr uint32_t kOmmSubdivisionLevel = 3;
 		uint32_t ommDeferred = 0; // cutout instances on the any-hit fallback this frame because their albedo isn't resident
+		m_OmmBuildPending = false;
 		for (auto view = reg.view<TransformComponent, MeshComponent>(); const entt::entity e : view)
 		{
 			const auto& mc = reg.Read<MeshComponent>(e);
@@ -166,6 +219,7 @@ namespace Snowstorm
 				blas = mc.MeshInstance->GetOrBuildOmmBlas(kOmmSubdivisionLevel, c->AlbedoTextureIndex, c->AlphaCutoff,
 				                                          c->BaseColor.a);
 				ommBuilt = blas != nullptr;
+				m_OmmBuildPending = m_OmmBuildPending || !ommBuilt;
 			}
 			if (!ommBuilt)
 			{
@@ -178,12 +232,11 @@ namespace Snowstorm
 
 			const auto& tc = reg.Read<TransformComponent>(e);
 			const glm::mat4 model = tc.GetTransformMatrix();
-			instances.push_back({model, blas->GetDeviceAddress()});
-			instanceEntities.push_back(e);
+			TLASInstance instance{model, blas->GetDeviceAddress()};
 			// Masked geometry must traverse non-opaque so the alpha test runs. With an OMM the micromap drives
 			// opacity (and FORCE_NO_OPAQUE would OVERRIDE it, forcing any-hit everywhere), so only the non-OMM
 			// fallback sets the instance flag; the OMM BLAS is already built non-opaque.
-			instances.back().ForceNonOpaque = masked && !ommBuilt;
+			instance.ForceNonOpaque = masked && !ommBuilt;
 
 			GeometryRecord rec{};
 			rec.VertexAddress = mc.MeshInstance->GetVertexBuffer()->GetGPUAddress();
@@ -206,85 +259,74 @@ namespace Snowstorm
 				rec.EmissiveG = c->EmissiveColor.g;
 				rec.EmissiveB = c->EmissiveColor.b;
 			}
-			geoRecords.push_back(rec);
+			m_Instances.Upsert(entt::to_integral(e), instance, rec);
 		}
+		m_Instances.EndSync();
 
-		// Publish the index->entity table for RT picking (consumed by the editor). Rebuilt every TLAS build
-		// so it never drifts from what the GPU traces.
-		SingletonView<TlasInstanceMapSingleton>().Instances = std::move(instanceEntities);
-
-		// Publish the geometry table (consumed by RendererService -> DefaultLit / GI / Reflection). Grow the
-		// GPU buffer when the instance count outgrows it (device-address Storage so the shader can RawBufferLoad
-		// records); address 0 when RT is off or the scene is empty so the shader falls back to the sky cube.
-		auto& reflGeo = SingletonView<ReflectionGeometrySingleton>();
-		if (!geoRecords.empty())
+		// Cutouts whose albedo hasn't streamed in bake no OMM this frame and run on the any-hit fallback (correct,
+		// just unoptimized); they re-bake once resident. Log the count only when it changes (settles to 0 as
+		// textures land) so a slow load doesn't spam.
+		if (ommDeferred != m_LastOmmDeferredLogged)
 		{
-			const uint32_t needed = static_cast<uint32_t>(geoRecords.size());
-			if (!reflGeo.Table || reflGeo.Capacity < needed)
+			if (ommDeferred > 0)
 			{
-				reflGeo.Capacity = needed;
-				// DEVICE-LOCAL (hostVisible=false): the table is read on the GPU hot path — every reflection/GI
-				// ray that hits geometry does several RawBufferLoads here plus vertex/index fetches — but written
-				// only on a rare rebuild (scene edit). A host-visible allocation lands in system RAM on a discrete
-				// GPU, so those hot reads would cross PCIe; device-local keeps them in VRAM. SetData takes the
-				// staging-upload path for a device-local buffer (one copy on the rare write), the right tradeoff
-				// for hot-read/rare-write data (mirrors how meshes' own vertex/index buffers are stored).
-				reflGeo.Table = Buffer::Create(static_cast<size_t>(needed) * sizeof(GeometryRecord),
-				                               BufferUsage::Storage, nullptr, false, "ReflectionGeometryTable");
+				SS_CORE_INFO("OMM bake deferred for {} cutout instance(s) awaiting albedo residency.", ommDeferred);
 			}
-			// Drain before overwriting the table. The reflection/GI shaders read it by device address, and up to
-			// framesInFlight prior frames may still be reading LAST rebuild's contents on the GPU. Rewriting it
-			// without a drain tore a record mid-read on a rebuild (e.g. deleting a mesh while RT reflections are
-			// on) → the shader RawBufferLoad'd a half-written VertexAddress → GPU READ_INVALID →
-			// VK_ERROR_DEVICE_LOST. Confirmed via VK_EXT_device_fault (READ_INVALID at a garbage address). Sync
-			// validation can't see it (it's a raw-device-address read, not a tracked VkBuffer hazard). The drain
-			// is needed for EITHER allocation type: even the device-local staging copy writes m_Buffer on the
-			// graphics queue and can overlap a prior frame's read without a cross-submit barrier. Rebuilds are
-			// rare, so a full wait is cheap and matches how VulkanTlas::Build / the AS destructors serialize.
-			Renderer::WaitIdle();
-			reflGeo.Table->SetData(geoRecords.data(), needed * sizeof(GeometryRecord), 0);
-			// Publish the address EVERY time the table is populated, not only when the buffer is (re)created.
-			// The buffer survives an RT-off cycle (it's cached, not freed), while the else-branch below zeroes
-			// TableAddress when the table isn't needed. So re-enabling reflections/GI after a shadows/AO-only
-			// spell reuses the existing buffer, skips the creation branch, and — if the address were set only
-			// there — would leave TableAddress 0 forever (GI/reflections dead until restart). Set it here.
-			reflGeo.TableAddress = reflGeo.Table->GetGPUAddress();
-		}
-		else
-		{
-			reflGeo.TableAddress = 0; // no table this frame -> shader uses the sky-cube fallback
+			m_LastOmmDeferredLogged = ommDeferred;
 		}
+	}
+
+	void TlasBuildSystem::UploadGeometryRecords(const TlasUpdatePlan& plan)
+	{
+		// Publish the geometry table (consumed by RendererService -> DefaultLit / GI / Reflection). Only the
+		// changed records are staged; RenderSystem copies them into the frame's own table on the GPU timeline
+		// (ReflectionGeometrySingleton::RecordPendingUpdates), so a moving prop never drains the device.
+		SingletonView<ReflectionGeometrySingleton>().Publish(m_Instances.GetRecords(), plan.RecordRanges);
+	}
 
+	void TlasBuildSystem::UpdateTlas(const TlasUpdatePlan& plan)
+	{
 		if (!m_TLAS)
 		{
 			m_TLAS = TLAS::Create("SceneTLAS");
+			SingletonView<ReflectionGeometrySingleton>().Tlas = m_TLAS; // RenderSystem records its staged refits
 		}
+
+		// Transform-only frames refit in place (same AS handle, so the bindless slot stays valid): Refit stages
+		// the moved instances and the update is recorded into this frame's command buffer after BeginFrame. A
+		// refit the backend refuses (never built, count mismatch) falls back to a full build.
+		const std::vector<TLASInstance>& instances = m_Instances.GetInstances();
+		if (plan.Kind == TlasUpdateKind::Refit && m_BuiltOnce && m_TLAS->Refit(instances, plan.InstanceRanges))
+		{
+			m_Instances.RecordRefit();
+			return;
+		}
+
 		m_TLAS->Build(instances);
+		m_Instances.RecordRebuild();
 		m_BuiltOnce = true;
 
 		// Point the bindless TLAS slot at the freshly built AS so ray-query shaders trace this scene.
 		const auto vkTlas = std::static_pointer_cast<VulkanTlas>(m_TLAS);
 		VulkanBindlessManager::Get().WriteAccelerationStructure(vkTlas->GetHandle());
 
-		// Log only when the instance count changes (streaming settle, scene switch) — not every transform
-		// tweak — so dragging an object in the editor (a rebuild per frame) doesn't spam the log.
+		// Publish the index->entity table for RT picking (consumed by the editor). Slots only move on a
+		// rebuild, so it never drifts from what the GPU traces.
+		auto& instanceMap = SingletonView<TlasInstanceMapSingleton>();
+		instanceMap.Instances.clear();
+		instanceMap.Instances.reserve(m_Instances.GetKeys().size());
+		for (const uint64_t key : m_Instances.GetKeys())
+		{
+			instanceMap.Instances.push_back(static_cast<entt::entity>(key));
+		}
+
+		// Log only when the instance count changes (streaming settle, scene switch) — not every rebuild — so
+		// a scene that keeps rebuilding (refit budget spent while dragging) doesn't spam the log.
 		const uint32_t count = m_TLAS->GetInstanceCount();
 		if (count != m_LastLoggedCount)
 		{
 			SS_CORE_INFO("TLAS rebuilt: {} instance(s).", count);
 			m_LastLoggedCount = count;
 		}
-
-		// Cutouts whose albedo hasn't streamed in bake no OMM this frame and run on the any-hit fallback (correct,
-		// just unoptimized); they re-bake once resident. Log the count only when it changes (settles to 0 as
-		// textures land) so a slow load doesn't spam.
-		if (ommDeferred != m_LastOmmDeferredLogged)
-		{
-			if (ommDeferred > 0)
-			{
-				SS_CORE_INFO("OMM bake deferred for {} cutout instance(s) awaiting albedo residency.", ommDeferred);
-			}
-			m_LastOmmDeferredLogged = ommDeferred;
-		}
 	}
 }
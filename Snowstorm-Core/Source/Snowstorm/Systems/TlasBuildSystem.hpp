@@ -2,23 +2,27 @@
 
 #include "Snowstorm/ECS/System.hpp"
 #include "Snowstorm/Render/AccelerationStructure.hpp"
+#include "Snowstorm/Render/TlasInstanceTable.hpp"
+#include "Snowstorm/Systems/ReflectionGeometrySingleton.hpp"
 
 namespace Snowstorm
 {
+	class AssetManagerSingleton;
+
 	// Builds and maintains the scene's top-level acceleration structure (#118). Runs in PreRender, before
-	// the RT shadow pass consumes the TLAS. Mirrors VisibilitySystem's dirty-signal pattern: it rebuilds the
-	// TLAS only when the renderable set or any transform changed (Init/Fini/ChangedView on Mesh/Transform),
-	// gathers one instance per (Transform + resolved-Mesh) entity, builds each mesh's BLAS lazily, and points
-	// the bindless TLAS slot at the result. No-op unless some RT effect is active (RT shadows/AO/reflections/
+	// the RT shadow pass consumes the TLAS. Mirrors VisibilitySystem's dirty-signal pattern: it re-gathers the
+	// instance set (one instance per Transform + resolved-Mesh entity, each mesh's BLAS built lazily) only when
+	// the renderable set may have changed (Init/Fini/ChangedView on Mesh/Material, destroys); a frame where
+	// only transforms moved updates just the moved instances. A persistent TlasInstanceTable diffs either
+	// into a plan: a refit of the moved instances (UPDATE mode, only their instance records + geometry
+	// records rewritten) or, on a topology change or once render.rt.tlas_max_refits ran out, a full rebuild
+	// that points the bindless TLAS slot at the result. No-op unless some RT effect is active (RT shadows/AO/reflections/
 	// GI): nothing samples the TLAS otherwise, so building it there is pure waste (BLAS builds + a TLAS build
 	// per scene change). The first frame after any RT effect turns ON forces a rebuild.
 	class TlasBuildSystem final : public System
 	{
 	public:
-		explicit TlasBuildSystem(const WorldRef world)
-		    : System(world)
-		{
-		}
+		explicit TlasBuildSystem(WorldRef world);
 
 		void Execute(Timestep ts) override;
 
@@ -27,17 +31,28 @@ namespace Snowstorm
 		[[nodiscard]] bool RunsInEditMode() const override { return true; }
 
 	private:
-		// True when a rebuild is warranted: any add/remove/change to the transforms or meshes that make up
-		// the instance set. Cheap early-out on a static scene (same pattern as VisibilitySystem).
-		[[nodiscard]] bool IsSceneDirtyThisFrame() const;
+		// True when the instance set must be re-gathered: any add/remove/change to the meshes, materials or
+		// transforms-as-components that make it up. Cheap early-out on a static scene (same pattern as
+		// VisibilitySystem). Moved transforms alone don't count; SyncMovedInstances handles those.
+		[[nodiscard]] bool IsInstanceSetDirtyThisFrame() const;
+
+		// Upsert every (Transform + resolved Mesh) entity into m_Instances and drop the ones gone.
+		void SyncAllInstances(AssetManagerSingleton& assets, bool ommEnabled);
+		// Upsert the new transforms of the instances whose entity moved this frame.
+		void SyncMovedInstances();
+
+		void UploadGeometryRecords(const TlasUpdatePlan& plan);
+		void UpdateTlas(const TlasUpdatePlan& plan);
 
-		Ref<TLAS> m_TLAS; // created lazily on first RT-enabled build; scene-scoped
+		TlasInstanceTable<GeometryRecord> m_Instances; // slot = instanceCustomIndex = geometry-table index
+		Ref<TLAS> m_TLAS;                              // created lazily on first RT-enabled build; scene-scoped
 		bool m_BuiltOnce = false;
 		bool m_WasRTActive = false;                    // RT-active state last frame — detects the off->on edge to force a rebuild
 		bool m_LastOmmEnabled = true;                  // render.omm last build — a toggle forces a rebuild (OMM vs any-hit)
 		uint32_t m_LastLoggedCount = UINT32_MAX;       // de-dupe the instance-count log across per-frame rebuilds
-		uint32_t m_PrevPendingLoads = 0;               // async loads in flight last frame; keeps rebuilding through the
-		                                               // drain so a cutout's OMM bakes once its albedo streams in
+		bool m_TexturesLanded = false;                 // a texture went resident since the last sync (AssetLoadedEvent)
+		bool m_OmmBuildPending = false;                // last sync fell back from an OMM BLAS whose bake pipeline was compiling
 		uint32_t m_LastOmmDeferredLogged = UINT32_MAX; // de-dupe the OMM-deferred log across per-frame rebuilds
+		EventBus::Connection m_AssetLoads;             // last: disconnects before the state its handler writes goes away
 	};
 }
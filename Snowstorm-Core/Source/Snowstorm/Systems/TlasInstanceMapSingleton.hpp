@@ -8,10 +8,10 @@
 namespace Snowstorm
 {
 	// Maps a TLAS instance index back to the entity that produced it (RT editor picking). TlasBuildSystem
-	// gathers one instance per (Transform + resolved-Mesh) entity in view order and stamps
-	// instanceCustomIndex = i (VulkanTlas::Build); the GPU pick trace returns that same i via
-	// CommittedInstanceID(), and the editor resolves Instances[i] -> entity. Rebuilt in lockstep with the
-	// TLAS (same gather loop), so it never drifts from what the GPU traces. A pick that lands while the
+	// keeps one instance per (Transform + resolved-Mesh) entity in a persistent slot and stamps
+	// instanceCustomIndex = slot (VulkanTlas::Build); the GPU pick trace returns that same slot via
+	// CommittedInstanceID(), and the editor resolves Instances[slot] -> entity. Republished on every TLAS
+	// rebuild (slots only move on one; a refit keeps them), so it never drifts from what the GPU traces. A pick that lands while the
 	// table is momentarily stale (mid-edit) just mis-resolves one click and self-corrects on the next —
 	// acceptable, no locking. Empty until the first RT-enabled TLAS build.
 	class TlasInstanceMapSingleton final : public Singleton
@@ -156,23 +156,10 @@ namespace Snowstorm
 				    const auto& tr = reg.Read<TransformComponent>(e);
 				    const glm::mat4 M = tr.GetTransformMatrix();
 
-				    const MeshBounds& localB = mesh.MeshInstance->GetBounds();
-
-				    // Sphere first (cheap)
-				    const Sphere ws = TransformSphere(localB.Sphere, M);
-				    if (!camRT.frustum.IntersectsSphere(ws.Center, ws.Radius))
+				    if (IsInFrustum(camRT.frustum, mesh.MeshInstance->GetBounds(), M))
 				    {
-					    return;
+					    emit(e);
 				    }
-
-				    // AABB second (tighter)
-				    const AABB wa = TransformAABB(localB.Box, M);
-				    if (!camRT.frustum.IntersectsAABB(wa))
-				    {
-					    return;
-				    }
-
-				    emit(e);
 			    },
 			    grain);
 
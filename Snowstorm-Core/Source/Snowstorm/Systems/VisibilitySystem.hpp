@@ -1,5 +1,7 @@
 ﻿#pragma once
 #include "Snowstorm/ECS/System.hpp"
+#include "Snowstorm/Math/Bounds.hpp"
+#include "Snowstorm/Math/Frustum.hpp"
 
 namespace Snowstorm
 {
@@ -9,6 +11,18 @@ namespace Snowstorm
 		using System::System;
 		void Execute(Timestep ts) override;
 
+		// The per-renderable cull test: local bounds placed by `model`, bounding sphere first (cheap), then
+		// the world AABB (tighter). Public so Snowstorm-Bench times the same code without an Application.
+		[[nodiscard]] static bool IsInFrustum(const Frustum& frustum, const MeshBounds& localBounds, const glm::mat4& model)
+		{
+			const Sphere ws = TransformSphere(localBounds.Sphere, model);
+			if (!frustum.IntersectsSphere(ws.Center, ws.Radius))
+			{
+				return false;
+			}
+			return frustum.IntersectsAABB(TransformAABB(localBounds.Box, model));
+		}
+
 	private:
 		[[nodiscard]] bool IsVisibilityDirtyThisFrame() const;
 	};
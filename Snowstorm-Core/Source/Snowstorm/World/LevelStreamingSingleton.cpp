@@ -0,0 +1,254 @@
+#include "LevelStreamingSingleton.hpp"
+
+#include "Snowstorm/Assets/AssetManagerSingleton.hpp"
+#include "Snowstorm/Components/IDComponent.hpp"
+#include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Events/DeferredEvents.hpp"
+
+#include <chrono>
+
+namespace Snowstorm
+{
+	bool LevelStreamingSingleton::Open(const std::filesystem::path& manifestPath)
+	{
+		Close();
+
+		std::optional<WorldPartitionManifest> manifest = WorldPartition::LoadManifest(manifestPath);
+		if (!manifest)
+		{
+			return false;
+		}
+
+		// The persistent scene (cameras, sun, environment) loads whole and up front: nothing else can start
+		// without a camera to stream around.
+		DecodedScene persistent;
+		const std::filesystem::path directory = manifestPath.parent_path();
+		if (!manifest->PersistentFile.empty() && !SceneBinarySerializer::DecodeFile((directory / manifest->PersistentFile).string(), persistent))
+		{
+			SS_CORE_WARN("World partition: failed to load the persistent scene '{}'", manifest->PersistentFile);
+			return false;
+		}
+		std::vector<Entity> created;
+		persistent.CommitSlice(*m_World, persistent.GetEntityCount(), &created);
+		Track(m_PersistentEntities, created);
+		m_PersistentAssets = WorldPartition::CollectAssetReferences(created);
+		m_World->GetSingleton<AssetManagerSingleton>().AcquireAssetReferences(m_PersistentAssets);
+
+		m_Open = true;
+		m_SceneGeneration = m_World->SceneGeneration();
+		m_ManifestPath = manifestPath;
+		m_Manifest = std::move(*manifest);
+		m_Cells = std::vector<CellRuntime>(m_Manifest.Cells.size());
+
+		SS_CORE_INFO("World partition: opened '{}' ({} cells, {} persistent entities)", manifestPath.string(), m_Manifest.Cells.size(),
+		             m_PersistentEntities.size());
+		return true;
+	}
+
+	void LevelStreamingSingleton::Close()
+	{
+		if (!m_Open)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < m_Cells.size(); ++i)
+		{
+			UnloadCell(i);
+		}
+		// Abandoned decodes own nothing but their own result (they capture the file path by value), so the
+		// futures can simply be dropped.
+		m_Cells.clear();
+
+		DestroyEntities(m_PersistentEntities);
+		m_World->GetSingleton<AssetManagerSingleton>().ReleaseAssetReferences(m_PersistentAssets);
+		m_PersistentAssets.clear();
+
+		m_Open = false;
+		m_Manifest = {};
+		m_ManifestPath.clear();
+	}
+
+	void LevelStreamingSingleton::Update(const glm::vec3& origin, JobSystem* jobs)
+	{
+		if (!m_Open)
+		{
+			return;
+		}
+
+		// 1. Collect finished decodes.
+		uint32_t decoding = 0;
+		for (CellRuntime& cell : m_Cells)
+		{
+			if (cell.State != CellState::Decoding)
+			{
+				continue;
+			}
+			if (cell.Pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++decoding;
+				continue;
+			}
+			DecodedScene scene = cell.Pending.get();
+			if (cell.Cancelled)
+			{
+				cell.State = CellState::Unloaded;
+				cell.Cancelled = false;
+				continue;
+			}
+			cell.Staged = std::move(scene);
+			cell.State = CellState::Committing;
+		}
+
+		// 2. Plan around the camera and act on it.
+		std::vector<CellResidency> residency(m_Cells.size(), CellResidency::Unloaded);
+		for (size_t i = 0; i < m_Cells.size(); ++i)
+		{
+			switch (m_Cells[i].State)
+			{
+			case CellState::Unloaded:
+				break;
+			case CellState::Decoding:
+			case CellState::Committing:
+				residency[i] = CellResidency::Loading;
+				break;
+			case CellState::Loaded:
+				residency[i] = CellResidency::Loaded;
+				break;
+			}
+			// A cancelled decode that is wanted again just keeps its result.
+			m_Cells[i].Cancelled = false;
+		}
+
+		const auto maxLoads = static_cast<uint32_t>(CVars::ClampedStreamingMaxLoads());
+		StreamingPlanSettings settings;
+		settings.Origin = origin;
+		settings.LoadRadius = CVars::ClampedStreamingLoadRadius();
+		settings.UnloadRadius = settings.LoadRadius + CVars::ClampedStreamingUnloadMargin();
+		settings.BudgetBytes = static_cast<uint64_t>(CVars::ClampedStreamingBudgetMb()) * 1024 * 1024;
+		settings.MaxNewLoads = decoding < maxLoads ? maxLoads - decoding : 0;
+		const StreamingPlan plan = WorldPartition::PlanStreaming(m_Manifest.Cells, residency, settings);
+
+		for (const uint32_t cell : plan.Unload)
+		{
+			UnloadCell(cell);
+		}
+		for (const uint32_t cell : plan.Load)
+		{
+			StartLoad(cell, jobs);
+		}
+
+		// 3. Commit decoded cells within this frame's entity budget, in cell order (a cell finishes before
+		// the next starts, so cells complete -- and take their asset references -- as early as possible).
+		auto& assets = m_World->GetSingleton<AssetManagerSingleton>();
+		auto budget = static_cast<uint32_t>(CVars::ClampedStreamingCommitPerFrame());
+		std::vector<Entity> created;
+		for (CellRuntime& cell : m_Cells)
+		{
+			if (budget == 0)
+			{
+				break;
+			}
+			if (cell.State != CellState::Committing)
+			{
+				continue;
+			}
+			created.clear();
+			budget -= cell.Staged->CommitSlice(*m_World, budget, &created);
+			Track(cell.Entities, created);
+			if (cell.Staged->IsFullyCommitted())
+			{
+				std::vector<Entity> entities;
+				entities.reserve(cell.Entities.size());
+				for (const StreamedEntity& streamed : cell.Entities)
+				{
+					entities.push_back(streamed.Handle);
+				}
+				cell.Assets = WorldPartition::CollectAssetReferences(entities);
+				assets.AcquireAssetReferences(cell.Assets);
+				cell.Staged.reset();
+				cell.State = CellState::Loaded;
+				Application::PostEvent(StreamingCellEvent{static_cast<uint32_t>(&cell - m_Cells.data()), true});
+			}
+		}
+	}
+
+	void LevelStreamingSingleton::StartLoad(const size_t cell, JobSystem* jobs)
+	{
+		CellRuntime& runtime = m_Cells[cell];
+		const std::string path = (m_ManifestPath.parent_path() / m_Manifest.Cells[cell].File).string();
+
+		// Decode single-threaded inside the job: it already runs on a worker, and a nested ParallelFor there
+		// could wait on itself. Cells load in parallel with each other instead.
+		const auto decode = [path]()
+		{
+			DecodedScene scene;
+			if (!SceneBinarySerializer::DecodeFile(path, scene))
+			{
+				SS_CORE_WARN("World partition: failed to load cell '{}'", path);
+			}
+			return scene;
+		};
+
+		if (jobs)
+		{
+			runtime.Pending = jobs->Submit(decode);
+			runtime.State = CellState::Decoding;
+		}
+		else
+		{
+			runtime.Staged = decode();
+			runtime.State = CellState::Committing;
+		}
+		runtime.Cancelled = false;
+	}
+
+	void LevelStreamingSingleton::UnloadCell(const size_t cell)
+	{
+		CellRuntime& runtime = m_Cells[cell];
+		switch (runtime.State)
+		{
+		case CellState::Unloaded:
+			return;
+		case CellState::Decoding:
+			runtime.Cancelled = true; // stays Decoding (and counted against max_loads) until the worker finishes
+			return;
+		case CellState::Committing:
+			runtime.Staged.reset();
+			break;
+		case CellState::Loaded:
+			m_World->GetSingleton<AssetManagerSingleton>().ReleaseAssetReferences(runtime.Assets);
+			runtime.Assets.clear();
+			Application::PostEvent(StreamingCellEvent{static_cast<uint32_t>(cell), false});
+			break;
+		}
+		DestroyEntities(runtime.Entities);
+		runtime.State = CellState::Unloaded;
+	}
+
+	void LevelStreamingSingleton::DestroyEntities(std::vector<StreamedEntity>& entities) const
+	{
+		for (const StreamedEntity& streamed : entities)
+		{
+			// Skip what is already gone: deleted by hand, or wiped with the scene (and maybe recycled since).
+			if (streamed.Handle.IsValid() && streamed.Handle.HasComponent<IDComponent>() &&
+			    streamed.Handle.GetComponent<IDComponent>().Id == streamed.Id)
+			{
+				m_World->DestroyEntity(streamed.Handle);
+			}
+		}
+		entities.clear();
+	}
+
+	void LevelStreamingSingleton::Track(std::vector<StreamedEntity>& out, const std::vector<Entity>& created) const
+	{
+		out.reserve(out.size() + created.size());
+		for (const Entity entity : created)
+		{
+			out.push_back({entity, entity.GetComponent<IDComponent>().Id});
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Snowstorm/ECS/Singleton.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Snowstorm/World/SceneBinarySerializer.hpp"
+#include "Snowstorm/World/WorldPartition.hpp"
+
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// Runtime state of an open world partition (.sspartition): which cells are loaded around the camera.
+	// Open() loads the manifest and the persistent scene; LevelStreamingSystem then calls Update() once a
+	// frame with the camera position, which
+	//   - reads + decodes newly wanted cells on JobSystem workers (SceneBinarySerializer::DecodeFile, no
+	//     registry access), at most world.streaming.max_loads at a time;
+	//   - commits decoded cells to the registry on the main thread, world.streaming.commit_per_frame
+	//     entities per frame across all cells (DecodedScene::CommitSlice), so a big cell never hitches a frame;
+	//   - unloads cells that fell out of range or out of the memory budget (WorldPartition::PlanStreaming).
+	// A fully committed cell holds a residency reference on every asset its entities use
+	// (AssetManagerSingleton::AcquireAssetReferences); unloading releases them, so meshes and textures no
+	// other loaded cell uses are evicted with the cell.
+	//
+	// Streamed entities are ordinary scene entities. A scene wipe (World::SceneGeneration changing) closes
+	// the partition; an entity deleted by hand is simply skipped when its cell unloads.
+	class LevelStreamingSingleton final : public Singleton
+	{
+	public:
+		using WorldRef = World*;
+
+		explicit LevelStreamingSingleton(const WorldRef world)
+		    : m_World(world)
+		{
+		}
+
+		enum class CellState : uint8_t
+		{
+			Unloaded,
+			Decoding,   // file read + decode running on a worker
+			Committing, // decoded; entities being added to the registry in slices
+			Loaded
+		};
+
+		// Close any open partition, then open `manifestPath`: load the manifest and its persistent scene
+		// (added to the world, like SceneSerializer::Deserialize -- the caller clears the world first). No
+		// cell is loaded yet; the first Update() starts streaming. False if the manifest or persistent scene
+		// can't be read.
+		bool Open(const std::filesystem::path& manifestPath);
+
+		// Destroy every streamed entity (cells and persistent scene) that still exists and release their
+		// asset references. Cells still decoding are abandoned (their results are dropped).
+		void Close();
+
+		// One streaming step around `origin`. `jobs` decodes cells in the background; null decodes them
+		// inline (headless tools, tests).
+		void Update(const glm::vec3& origin, JobSystem* jobs);
+
+		[[nodiscard]] bool IsOpen() const { return m_Open; }
+		[[nodiscard]] uint64_t GetSceneGeneration() const { return m_SceneGeneration; }
+		[[nodiscard]] const std::filesystem::path& GetManifestPath() const { return m_ManifestPath; }
+		[[nodiscard]] const WorldPartitionManifest& GetManifest() const { return m_Manifest; }
+		[[nodiscard]] CellState GetCellState(const size_t cell) const { return m_Cells[cell].State; }
+
+	private:
+		// An entity this partition created, with its UUID: entt recycles handles, so a handle alone could
+		// point at an unrelated entity by the time its cell unloads.
+		struct StreamedEntity
+		{
+			Entity Handle;
+			UUID Id;
+		};
+
+		struct CellRuntime
+		{
+			CellState State = CellState::Unloaded;
+			std::future<DecodedScene> Pending; // Decoding
+			bool Cancelled = false;            // Decoding, but no longer wanted: drop the result on arrival
+			std::optional<DecodedScene> Staged; // Committing
+			std::vector<StreamedEntity> Entities;
+			std::vector<AssetHandle> Assets; // residency references held (Loaded)
+		};
+
+		void StartLoad(size_t cell, JobSystem* jobs);
+		void UnloadCell(size_t cell);
+		void DestroyEntities(std::vector<StreamedEntity>& entities) const;
+		void Track(std::vector<StreamedEntity>& out, const std::vector<Entity>& created) const;
+
+		WorldRef m_World;
+
+		bool m_Open = false;
+		uint64_t m_SceneGeneration = 0; // World::SceneGeneration at Open; a different one means the scene was wiped
+		std::filesystem::path m_ManifestPath;
+		WorldPartitionManifest m_Manifest;
+		std::vector<CellRuntime> m_Cells; // parallel to m_Manifest.Cells
+
+		std::vector<StreamedEntity> m_PersistentEntities;
+		std::vector<AssetHandle> m_PersistentAssets;
+	};
+}
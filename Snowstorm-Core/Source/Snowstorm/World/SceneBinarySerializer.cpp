@@ -0,0 +1,1021 @@
+#include "SceneBinarySerializer.hpp"
+
+#include "SceneSerializer.hpp"
+
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/CameraTargetComponent.hpp"
+#include "Snowstorm/Components/ComponentRegistry.hpp"
+#include "Snowstorm/Components/DoNotSerializeComponent.hpp"
+#include "Snowstorm/Components/IDComponent.hpp"
+#include "Snowstorm/Components/MaterialComponent.hpp"
+#include "Snowstorm/Components/MeshComponent.hpp"
+#include "Snowstorm/Components/RotatorComponent.hpp"
+#include "Snowstorm/Components/TagComponent.hpp"
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Components/VisibilityComponents.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Lighting/LightingComponents.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Generated binary codecs: a component with a BinaryFields specialization is stored as one SoA column per
+		// listed member (raw bytes, so every member must be trivially copyable) and read back by the same list
+		// -- no RTTR. List what the JSON path serializes; runtime caches (Ref<Mesh>, resolved entt handles) stay
+		// out and come back default-constructed, exactly as after a JSON load. Optional `Skip(const T&)`: leave
+		// an entity's component out of the file (mirrors a JSON load dropping it).
+		//
+		// `Names` are the members' RTTR property names, in the same order (a test checks they cover every
+		// registered property). The chunk layout hash covers the columns' names, sizes and order, so reordering,
+		// renaming, adding or resizing listed members -- even a swap of two same-sized ones -- makes older files
+		// skip the chunk. Members left out of the list (and where the listed ones sit in the struct) don't
+		// matter: each column is written and read through its member pointer.
+		template <typename T>
+		struct BinaryFields;
+
+		template <>
+		struct BinaryFields<TransformComponent>
+		{
+			static constexpr auto Members = std::tuple{&TransformComponent::Position, &TransformComponent::Rotation,
+			                                           &TransformComponent::Scale};
+			static constexpr std::array Names{"Position", "Rotation", "Scale"};
+		};
+
+		template <>
+		struct BinaryFields<CameraComponent>
+		{
+			static constexpr auto Members = std::tuple{&CameraComponent::Projection, &CameraComponent::PerspectiveFOV,
+			                                           &CameraComponent::PerspectiveNear, &CameraComponent::PerspectiveFar,
+			                                           &CameraComponent::OrthographicSize, &CameraComponent::OrthographicNear,
+			                                           &CameraComponent::OrthographicFar, &CameraComponent::Primary,
+			                                           &CameraComponent::FixedAspectRatio, &CameraComponent::AspectRatio};
+			static constexpr std::array Names{"Projection", "PerspectiveFOV", "PerspectiveNear", "PerspectiveFar",
+			                                   "OrthographicSize", "OrthographicNear", "OrthographicFar", "Primary",
+			                                   "FixedAspectRatio", "AspectRatio"};
+		};
+
+		template <>
+		struct BinaryFields<CameraTargetComponent>
+		{
+			static constexpr auto Members = std::tuple{&CameraTargetComponent::TargetViewportUUID};
+			static constexpr std::array Names{"TargetViewportUUID"};
+		};
+
+		template <>
+		struct BinaryFields<MeshComponent>
+		{
+			static constexpr auto Members = std::tuple{&MeshComponent::MeshHandle};
+			static constexpr std::array Names{"Mesh"};
+
+			static bool Skip(const MeshComponent& mc) { return mc.MeshHandle.Value() == 0; }
+		};
+
+		template <>
+		struct BinaryFields<MaterialComponent>
+		{
+			static constexpr auto Members = std::tuple{&MaterialComponent::Material};
+			static constexpr std::array Names{"Material"};
+
+			static bool Skip(const MaterialComponent& mc) { return mc.Material.Value() == 0; }
+		};
+
+		template <>
+		struct BinaryFields<RotatorComponent>
+		{
+			static constexpr auto Members = std::tuple{&RotatorComponent::Axis, &RotatorComponent::SpeedDegPerSec};
+			static constexpr std::array Names{"Axis", "SpeedDegPerSec"};
+		};
+
+		template <>
+		struct BinaryFields<VisibilityComponent>
+		{
+			static constexpr auto Members = std::tuple{&VisibilityComponent::Mask};
+			static constexpr std::array Names{"Mask"};
+		};
+
+		template <>
+		struct BinaryFields<CameraVisibilityComponent>
+		{
+			static constexpr auto Members = std::tuple{&CameraVisibilityComponent::Mask};
+			static constexpr std::array Names{"Mask"};
+		};
+
+		template <>
+		struct BinaryFields<DirectionalLightComponent>
+		{
+			static constexpr auto Members = std::tuple{&DirectionalLightComponent::Enabled, &DirectionalLightComponent::Direction,
+			                                           &DirectionalLightComponent::Color, &DirectionalLightComponent::Intensity,
+			                                           &DirectionalLightComponent::CastShadows};
+			static constexpr std::array Names{"Enabled", "Direction", "Color", "Intensity", "CastShadows"};
+		};
+
+		template <>
+		struct BinaryFields<PointLightComponent>
+		{
+			static constexpr auto Members = std::tuple{&PointLightComponent::Enabled, &PointLightComponent::Color,
+			                                           &PointLightComponent::Intensity, &PointLightComponent::Range,
+			                                           &PointLightComponent::CastShadows, &PointLightComponent::ShadowPriority};
+			static constexpr std::array Names{"Enabled", "Color", "Intensity", "Range", "CastShadows", "ShadowPriority"};
+		};
+
+		template <>
+		struct BinaryFields<SpotLightComponent>
+		{
+			static constexpr auto Members = std::tuple{&SpotLightComponent::Enabled, &SpotLightComponent::Color,
+			                                           &SpotLightComponent::Intensity, &SpotLightComponent::Range,
+			                                           &SpotLightComponent::InnerAngleDeg, &SpotLightComponent::OuterAngleDeg,
+			                                           &SpotLightComponent::CastShadows, &SpotLightComponent::ShadowPriority};
+			static constexpr std::array Names{"Enabled", "Color", "Intensity", "Range", "InnerAngleDeg", "OuterAngleDeg",
+			                                   "CastShadows", "ShadowPriority"};
+		};
+
+		constexpr uint32_t kMagic = 0x44575353; // "SSWD" in file byte order
+		constexpr uint32_t kVersion = 1;
+
+		// Entities per chunk. Bounds one decode task, so a component every entity has (Transform) splits into
+		// several tasks instead of serializing the load behind one worker.
+		constexpr uint32_t kMaxChunkEntities = 16384;
+
+		enum class ChunkEncoding : uint32_t
+		{
+			Columns = 0, // generated SoA columns (BinaryFields)
+			Json = 1     // per-entity SceneSerializer component JSON, as CBOR
+		};
+
+		class ByteWriter
+		{
+		public:
+			explicit ByteWriter(std::vector<uint8_t>& out) : m_Out(out) {}
+
+			void WriteBytes(const void* data, const size_t size)
+			{
+				const auto* bytes = static_cast<const uint8_t*>(data);
+				m_Out.insert(m_Out.end(), bytes, bytes + size);
+			}
+
+			template <typename T>
+			void Write(const T& value)
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "ByteWriter::Write needs a trivially-copyable type");
+				WriteBytes(&value, sizeof(T));
+			}
+
+			void WriteString(const std::string_view text)
+			{
+				Write(static_cast<uint32_t>(text.size()));
+				WriteBytes(text.data(), text.size());
+			}
+
+			// Reserve a value to fill in once it's known (a payload size), returned as its offset.
+			template <typename T>
+			size_t WritePlaceholder()
+			{
+				const size_t offset = m_Out.size();
+				Write(T{});
+				return offset;
+			}
+
+			template <typename T>
+			void Patch(const size_t offset, const T& value)
+			{
+				std::memcpy(m_Out.data() + offset, &value, sizeof(T));
+			}
+
+			[[nodiscard]] size_t Size() const { return m_Out.size(); }
+
+		private:
+			std::vector<uint8_t>& m_Out;
+		};
+
+		// Bounds-checked reader. A read past the end fails the reader (sticky) and yields zeros, so decode code
+		// reads straight through and checks Ok() once instead of after every field.
+		class ByteReader
+		{
+		public:
+			explicit ByteReader(const std::span<const uint8_t> bytes) : m_Bytes(bytes) {}
+
+			bool ReadBytes(void* out, const size_t size)
+			{
+				if (m_Failed || size > m_Bytes.size() - m_Offset)
+				{
+					m_Failed = true;
+					std::memset(out, 0, size);
+					return false;
+				}
+				std::memcpy(out, m_Bytes.data() + m_Offset, size);
+				m_Offset += size;
+				return true;
+			}
+
+			template <typename T>
+			T Read()
+			{
+				static_assert(std::is_trivially_copyable_v<T>, "ByteReader::Read needs a trivially-copyable type");
+				T value{};
+				ReadBytes(&value, sizeof(T));
+				return value;
+			}
+
+			// A view of the next `size` bytes (empty + failed if there aren't that many).
+			std::span<const uint8_t> Take(const size_t size)
+			{
+				if (m_Failed || size > m_Bytes.size() - m_Offset)
+				{
+					m_Failed = true;
+					return {};
+				}
+				const std::span<const uint8_t> view = m_Bytes.subspan(m_Offset, size);
+				m_Offset += size;
+				return view;
+			}
+
+			std::string_view ReadString()
+			{
+				const auto size = Read<uint32_t>();
+				const std::span<const uint8_t> view = Take(size);
+				return {reinterpret_cast<const char*>(view.data()), view.size()};
+			}
+
+			[[nodiscard]] bool Ok() const { return !m_Failed; }
+			[[nodiscard]] bool AtEnd() const { return m_Offset == m_Bytes.size(); }
+
+		private:
+			std::span<const uint8_t> m_Bytes;
+			size_t m_Offset = 0;
+			bool m_Failed = false;
+		};
+
+		uint64_t StableComponentId(const std::string_view typeName)
+		{
+			return HashBytes64(typeName.data(), typeName.size());
+		}
+
+		template <typename M>
+		struct MemberTraits;
+
+		template <typename C, typename F>
+		struct MemberTraits<F C::*>
+		{
+			using Field = F;
+		};
+
+		// Hash of every column's name and size, in order: what a reader has to agree on to read a chunk's
+		// payload into the right members. Deliberately not the members' struct offsets -- those don't affect
+		// the encoding, and hashing them would drop every old chunk whenever an unlisted member moved.
+		template <typename T>
+		uint32_t ColumnLayout()
+		{
+			static_assert(BinaryFields<T>::Names.size() == std::tuple_size_v<decltype(BinaryFields<T>::Members)>,
+			              "BinaryFields Names must name every member");
+
+			uint64_t hash = 0;
+			size_t index = 0;
+			std::apply(
+			    [&](const auto... members)
+			    {
+				    const auto addColumn = [&](const auto member)
+				    {
+					    using Field = typename MemberTraits<std::remove_cv_t<decltype(member)>>::Field;
+					    const std::string_view name = BinaryFields<T>::Names[index++];
+					    hash = HashCombine64(hash, HashBytes64(name.data(), name.size()));
+					    hash = HashCombine64(hash, sizeof(Field));
+				    };
+				    (addColumn(members), ...);
+			    },
+			    BinaryFields<T>::Members);
+			return static_cast<uint32_t>(hash);
+		}
+
+		// Decoded chunk, built on a worker and applied to the registry on the World's thread. Apply hands values
+		// [first, first + entities.size()) to `entities`; a chunk may be applied in several runs (sliced commits).
+		struct DecodedChunk
+		{
+			virtual ~DecodedChunk() = default;
+			virtual void Apply(size_t first, std::span<const Entity> entities) = 0;
+		};
+
+		template <typename T>
+		struct DecodedColumns final : DecodedChunk
+		{
+			std::vector<T> Values;
+
+			void Apply(const size_t first, const std::span<const Entity> entities) override
+			{
+				for (size_t i = 0; i < entities.size(); ++i)
+				{
+					Entity entity = entities[i];
+					entity.AddOrReplaceComponent<T>(std::move(Values[first + i]));
+				}
+			}
+		};
+
+		struct DecodedJson final : DecodedChunk
+		{
+			std::string TypeName;
+			std::vector<nlohmann::json> Values;
+
+			void Apply(const size_t first, const std::span<const Entity> entities) override
+			{
+				for (size_t i = 0; i < entities.size(); ++i)
+				{
+					SceneSerializer::DeserializeComponent(entities[i], TypeName, Values[first + i]);
+				}
+			}
+		};
+
+		// One component type's binary handling, type-erased. Built once from the component registry.
+		struct ComponentCodec
+		{
+			std::string TypeName;
+			uint64_t Id = 0;
+			ChunkEncoding Encoding = ChunkEncoding::Json;
+			uint32_t Layout = 0;
+			std::vector<std::string> FieldNames; // Columns only: the BinaryFields names
+
+			std::function<bool(Entity)> IncludesFn;
+			std::function<void(std::span<const Entity>, ByteWriter&)> EncodeFn;
+			std::function<std::unique_ptr<DecodedChunk>(std::span<const uint8_t>, uint32_t)> DecodeFn; // null on bad data
+		};
+
+		template <typename T>
+		ComponentCodec MakeColumnCodec(const std::string& typeName)
+		{
+			ComponentCodec codec;
+			codec.TypeName = typeName;
+			codec.Id = StableComponentId(typeName);
+			codec.Encoding = ChunkEncoding::Columns;
+			codec.Layout = ColumnLayout<T>();
+			codec.FieldNames.assign(BinaryFields<T>::Names.begin(), BinaryFields<T>::Names.end());
+
+			codec.IncludesFn = [](const Entity entity)
+			{
+				if (!entity.HasComponent<T>())
+				{
+					return false;
+				}
+				if constexpr (requires(const T& c) { BinaryFields<T>::Skip(c); })
+				{
+					return !BinaryFields<T>::Skip(entity.GetComponent<T>());
+				}
+				return true;
+			};
+
+			codec.EncodeFn = [](const std::span<const Entity> entities, ByteWriter& writer)
+			{
+				std::vector<const T*> values;
+				values.reserve(entities.size());
+				for (const Entity entity : entities)
+				{
+					values.push_back(&entity.GetComponent<T>());
+				}
+
+				std::apply(
+				    [&](const auto... members)
+				    {
+					    const auto writeColumn = [&](const auto member)
+					    {
+						    for (const T* value : values)
+						    {
+							    writer.Write(value->*member);
+						    }
+					    };
+					    (writeColumn(members), ...);
+				    },
+				    BinaryFields<T>::Members);
+			};
+
+			codec.DecodeFn = [](const std::span<const uint8_t> payload, const uint32_t count) -> std::unique_ptr<DecodedChunk>
+			{
+				auto decoded = std::make_unique<DecodedColumns<T>>();
+				decoded->Values.resize(count);
+
+				ByteReader reader(payload);
+				std::apply(
+				    [&](const auto... members)
+				    {
+					    const auto readColumn = [&](const auto member)
+					    {
+						    using Field = typename MemberTraits<std::remove_cv_t<decltype(member)>>::Field;
+						    static_assert(std::is_trivially_copyable_v<Field>, "BinaryFields members must be trivially copyable");
+						    for (T& value : decoded->Values)
+						    {
+							    reader.ReadBytes(&(value.*member), sizeof(Field));
+						    }
+					    };
+					    (readColumn(members), ...);
+				    },
+				    BinaryFields<T>::Members);
+
+				if (!reader.Ok() || !reader.AtEnd())
+				{
+					return nullptr;
+				}
+				return decoded;
+			};
+
+			return codec;
+		}
+
+		ComponentCodec MakeJsonCodec(const ComponentInfo& info)
+		{
+			ComponentCodec codec;
+			codec.TypeName = info.Type.get_name().to_string();
+			codec.Id = StableComponentId(codec.TypeName);
+			codec.Encoding = ChunkEncoding::Json;
+
+			codec.IncludesFn = info.HasFn;
+
+			codec.EncodeFn = [info](const std::span<const Entity> entities, ByteWriter& writer)
+			{
+				for (const Entity entity : entities)
+				{
+					nlohmann::json component;
+					SceneSerializer::SerializeComponent(entity, info, component);
+					const std::vector<uint8_t> cbor = nlohmann::json::to_cbor(component);
+					writer.Write(static_cast<uint32_t>(cbor.size()));
+					writer.WriteBytes(cbor.data(), cbor.size());
+				}
+			};
+
+			codec.DecodeFn = [typeName = codec.TypeName](const std::span<const uint8_t> payload, const uint32_t count) -> std::unique_ptr<DecodedChunk>
+			{
+				auto decoded = std::make_unique<DecodedJson>();
+				decoded->TypeName = typeName;
+				decoded->Values.reserve(count);
+
+				ByteReader reader(payload);
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					const std::span<const uint8_t> cbor = reader.Take(reader.Read<uint32_t>());
+					if (!reader.Ok())
+					{
+						return nullptr;
+					}
+					nlohmann::json value = nlohmann::json::from_cbor(cbor.begin(), cbor.end(), true, false);
+					if (value.is_discarded())
+					{
+						return nullptr;
+					}
+					decoded->Values.push_back(std::move(value));
+				}
+
+				if (!reader.AtEnd())
+				{
+					return nullptr;
+				}
+				return decoded;
+			};
+
+			return codec;
+		}
+
+		template <typename T>
+		void AddColumnCodec(std::unordered_map<std::string, ComponentCodec>& generated)
+		{
+			const std::string typeName = rttr::type::get<T>().get_name().to_string();
+			generated.emplace(typeName, MakeColumnCodec<T>(typeName));
+		}
+
+		// Every serializable registered component except the identity ones (stored in the entity table), in
+		// registry order: the generated codec where there is one, the JSON codec otherwise. Built on first use,
+		// after static registration has filled the component registry.
+		const std::vector<ComponentCodec>& GetComponentCodecs()
+		{
+			static const std::vector<ComponentCodec> s_Codecs = []
+			{
+				std::unordered_map<std::string, ComponentCodec> generated;
+				AddColumnCodec<TransformComponent>(generated);
+				AddColumnCodec<CameraComponent>(generated);
+				AddColumnCodec<CameraTargetComponent>(generated);
+				AddColumnCodec<MeshComponent>(generated);
+				AddColumnCodec<MaterialComponent>(generated);
+				AddColumnCodec<RotatorComponent>(generated);
+				AddColumnCodec<VisibilityComponent>(generated);
+				AddColumnCodec<CameraVisibilityComponent>(generated);
+				AddColumnCodec<DirectionalLightComponent>(generated);
+				AddColumnCodec<PointLightComponent>(generated);
+				AddColumnCodec<SpotLightComponent>(generated);
+
+				std::vector<ComponentCodec> codecs;
+				for (const ComponentInfo& info : GetComponentRegistry())
+				{
+					if (!info.Type.is_valid() || !info.Serializable || !info.HasFn || !info.GetInstanceFn)
+					{
+						continue;
+					}
+					std::string typeName = info.Type.get_name().to_string();
+					if (typeName == "Snowstorm::IDComponent" || typeName == "Snowstorm::TagComponent")
+					{
+						continue;
+					}
+
+					if (const auto it = generated.find(typeName); it != generated.end())
+					{
+						codecs.push_back(std::move(it->second));
+					}
+					else
+					{
+						codecs.push_back(MakeJsonCodec(info));
+					}
+				}
+
+				return codecs;
+			}();
+			return s_Codecs;
+		}
+
+		class StringTable
+		{
+		public:
+			uint32_t Intern(const std::string& text)
+			{
+				const auto [it, inserted] = m_Indices.try_emplace(text, static_cast<uint32_t>(m_Strings.size()));
+				if (inserted)
+				{
+					m_Strings.push_back(text);
+				}
+				return it->second;
+			}
+
+			[[nodiscard]] const std::vector<std::string>& GetStrings() const { return m_Strings; }
+
+		private:
+			std::unordered_map<std::string, uint32_t> m_Indices;
+			std::vector<std::string> m_Strings;
+		};
+
+		// A chunk as found in the file, before decoding.
+		struct ChunkView
+		{
+			uint64_t Id = 0;
+			uint32_t TypeName = 0;
+			ChunkEncoding Encoding = ChunkEncoding::Json;
+			uint32_t Layout = 0;
+			uint32_t Count = 0;
+			std::span<const uint8_t> EntityIndices;
+			std::span<const uint8_t> Payload;
+		};
+
+		bool ReadFile(const std::string& filePath, std::vector<uint8_t>& out)
+		{
+			std::ifstream in(filePath, std::ios::binary | std::ios::ate);
+			if (!in.is_open())
+			{
+				return false;
+			}
+			const std::streamsize size = in.tellg();
+			if (size < 0)
+			{
+				return false;
+			}
+			out.resize(static_cast<size_t>(size));
+			in.seekg(0);
+			return static_cast<bool>(in.read(reinterpret_cast<char*>(out.data()), size));
+		}
+
+		bool WriteFile(const std::string& filePath, const std::span<const uint8_t> bytes)
+		{
+			std::ofstream out(filePath, std::ios::binary | std::ios::trunc);
+			if (!out.is_open())
+			{
+				return false;
+			}
+			out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			return static_cast<bool>(out);
+		}
+	}
+
+	// Staging for a decoded scene: the entity table, and per chunk its (ascending) entity indices with the
+	// decoded values. Committed entities are kept by index so later slices can resolve chunk members.
+	struct DecodedScene::Data
+	{
+		struct Chunk
+		{
+			std::vector<uint32_t> Entities;
+			std::unique_ptr<DecodedChunk> Values;
+			size_t Next = 0; // first member not yet committed
+		};
+
+		std::vector<uint64_t> Uuids;
+		std::vector<std::string> Names;
+		std::vector<Chunk> Chunks;
+		std::vector<Entity> Created;
+		uint32_t Committed = 0;
+	};
+
+	DecodedScene::DecodedScene() : m_Data(std::make_unique<Data>()) {}
+	DecodedScene::~DecodedScene() = default;
+	DecodedScene::DecodedScene(DecodedScene&&) noexcept = default;
+	DecodedScene& DecodedScene::operator=(DecodedScene&&) noexcept = default;
+
+	uint32_t DecodedScene::GetEntityCount() const
+	{
+		return m_Data ? static_cast<uint32_t>(m_Data->Uuids.size()) : 0;
+	}
+
+	uint32_t DecodedScene::GetCommittedCount() const
+	{
+		return m_Data ? m_Data->Committed : 0;
+	}
+
+	uint32_t DecodedScene::CommitSlice(World& world, const uint32_t maxEntities, std::vector<Entity>* created)
+	{
+		if (!m_Data)
+		{
+			return 0;
+		}
+		Data& data = *m_Data;
+		const uint32_t begin = data.Committed;
+		const uint32_t end = begin + std::min(maxEntities, GetEntityCount() - begin);
+		if (begin == end)
+		{
+			return 0;
+		}
+
+		data.Created.reserve(data.Uuids.size());
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			data.Created.push_back(world.CreateEntityWithUUID(UUID(data.Uuids[i]), data.Names[i]));
+		}
+
+		// Every chunk lists its entities in ascending order, so the members inside this slice are the run
+		// starting at the chunk's cursor.
+		std::vector<Entity> members;
+		for (Data::Chunk& chunk : data.Chunks)
+		{
+			const size_t first = chunk.Next;
+			members.clear();
+			while (chunk.Next < chunk.Entities.size() && chunk.Entities[chunk.Next] < end)
+			{
+				members.push_back(data.Created[chunk.Entities[chunk.Next]]);
+				++chunk.Next;
+			}
+			if (!members.empty())
+			{
+				chunk.Values->Apply(first, members);
+			}
+		}
+
+		data.Committed = end;
+		if (created)
+		{
+			created->insert(created->end(), data.Created.begin() + begin, data.Created.begin() + end);
+		}
+		if (data.Committed == data.Uuids.size())
+		{
+			data.Chunks.clear(); // the staged values have all been moved out; free them now, not with the scene
+		}
+		return end - begin;
+	}
+
+	bool SceneBinarySerializer::IsBinaryScenePath(const std::string& filePath)
+	{
+		return std::filesystem::path(filePath).extension() == kExtension;
+	}
+
+	std::vector<SceneBinarySerializer::ColumnFieldList> SceneBinarySerializer::GetColumnFieldLists()
+	{
+		std::vector<ColumnFieldList> lists;
+		for (const ComponentCodec& codec : GetComponentCodecs())
+		{
+			if (codec.Encoding == ChunkEncoding::Columns)
+			{
+				lists.push_back({codec.TypeName, codec.FieldNames});
+			}
+		}
+		return lists;
+	}
+
+	std::vector<uint8_t> SceneBinarySerializer::SerializeToBytes(const World& world)
+	{
+		// Same entity set as the JSON writer: everything with an identity, minus the editor's DoNotSerialize
+		// entities.
+		std::vector<Entity> entities;
+		auto& reg = world.GetRegistry();
+		for (const entt::entity e : reg.view<IDComponent, TagComponent>())
+		{
+			if (!reg.any_of<DoNotSerializeComponent>(e))
+			{
+				entities.emplace_back(e, const_cast<World*>(&world));
+			}
+		}
+		return SerializeEntitiesToBytes(entities);
+	}
+
+	std::vector<uint8_t> SceneBinarySerializer::SerializeEntitiesToBytes(const std::span<const Entity> entities)
+	{
+		StringTable strings;
+		std::vector<uint32_t> names;
+		names.reserve(entities.size());
+		for (const Entity entity : entities)
+		{
+			names.push_back(strings.Intern(entity.GetComponent<TagComponent>().Tag));
+		}
+
+		// Chunks go to their own buffer first: their type names still have to enter the string table, which
+		// precedes them in the file.
+		std::vector<uint8_t> chunkBytes;
+		ByteWriter chunks(chunkBytes);
+		uint32_t chunkCount = 0;
+
+		std::vector<uint32_t> indices;
+		std::vector<Entity> members;
+		for (const ComponentCodec& codec : GetComponentCodecs())
+		{
+			indices.clear();
+			for (uint32_t i = 0; i < entities.size(); ++i)
+			{
+				if (codec.IncludesFn(entities[i]))
+				{
+					indices.push_back(i);
+				}
+			}
+
+			const uint32_t typeName = indices.empty() ? 0 : strings.Intern(codec.TypeName);
+			for (size_t first = 0; first < indices.size(); first += kMaxChunkEntities)
+			{
+				const auto count = static_cast<uint32_t>(std::min<size_t>(kMaxChunkEntities, indices.size() - first));
+				members.clear();
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					members.push_back(entities[indices[first + i]]);
+				}
+
+				chunks.Write(codec.Id);
+				chunks.Write(typeName);
+				chunks.Write(static_cast<uint32_t>(codec.Encoding));
+				chunks.Write(codec.Layout);
+				chunks.Write(count);
+				const size_t payloadSizeAt = chunks.WritePlaceholder<uint64_t>();
+				chunks.WriteBytes(indices.data() + first, count * sizeof(uint32_t));
+
+				const size_t payloadStart = chunks.Size();
+				codec.EncodeFn(members, chunks);
+				chunks.Patch(payloadSizeAt, static_cast<uint64_t>(chunks.Size() - payloadStart));
+				++chunkCount;
+			}
+		}
+
+		std::vector<uint8_t> bytes;
+		ByteWriter writer(bytes);
+		writer.Write(kMagic);
+		writer.Write(kVersion);
+		writer.Write(static_cast<uint32_t>(entities.size()));
+		writer.Write(static_cast<uint32_t>(strings.GetStrings().size()));
+		writer.Write(chunkCount);
+
+		for (const std::string& text : strings.GetStrings())
+		{
+			writer.WriteString(text);
+		}
+
+		// Entity table, SoA: all UUIDs, then all name indices.
+		for (const Entity entity : entities)
+		{
+			writer.Write(entity.GetComponent<IDComponent>().Id.Value());
+		}
+		writer.WriteBytes(names.data(), names.size() * sizeof(uint32_t));
+
+		writer.WriteBytes(chunkBytes.data(), chunkBytes.size());
+		return bytes;
+	}
+
+	bool SceneBinarySerializer::Decode(const std::span<const uint8_t> bytes, DecodedScene& out, JobSystem* jobs)
+	{
+		out = DecodedScene{};
+
+		ByteReader reader(bytes);
+		if (reader.Read<uint32_t>() != kMagic)
+		{
+			SS_CORE_WARN("Binary scene: not a .ssworld file");
+			return false;
+		}
+		if (const auto version = reader.Read<uint32_t>(); version != kVersion)
+		{
+			SS_CORE_WARN("Binary scene: unsupported version {} (expected {})", version, kVersion);
+			return false;
+		}
+		const auto entityCount = reader.Read<uint32_t>();
+		const auto stringCount = reader.Read<uint32_t>();
+		const auto chunkCount = reader.Read<uint32_t>();
+
+		std::vector<std::string_view> strings;
+		strings.reserve(std::min<size_t>(stringCount, bytes.size() / sizeof(uint32_t)));
+		for (uint32_t i = 0; i < stringCount && reader.Ok(); ++i)
+		{
+			strings.push_back(reader.ReadString());
+		}
+
+		const std::span<const uint8_t> uuids = reader.Take(size_t{entityCount} * sizeof(uint64_t));
+		const std::span<const uint8_t> names = reader.Take(size_t{entityCount} * sizeof(uint32_t));
+
+		std::vector<ChunkView> chunks;
+		for (uint32_t c = 0; c < chunkCount && reader.Ok(); ++c)
+		{
+			ChunkView& chunk = chunks.emplace_back();
+			chunk.Id = reader.Read<uint64_t>();
+			chunk.TypeName = reader.Read<uint32_t>();
+			chunk.Encoding = static_cast<ChunkEncoding>(reader.Read<uint32_t>());
+			chunk.Layout = reader.Read<uint32_t>();
+			chunk.Count = reader.Read<uint32_t>();
+			const auto payloadSize = reader.Read<uint64_t>();
+			chunk.EntityIndices = reader.Take(size_t{chunk.Count} * sizeof(uint32_t));
+			chunk.Payload = reader.Take(static_cast<size_t>(payloadSize));
+		}
+
+		if (!reader.Ok() || !reader.AtEnd())
+		{
+			SS_CORE_WARN("Binary scene: truncated or malformed file");
+			return false;
+		}
+
+		DecodedScene::Data& data = *out.m_Data;
+		data.Uuids.resize(entityCount);
+		data.Names.reserve(entityCount);
+		std::memcpy(data.Uuids.data(), uuids.data(), uuids.size());
+		for (uint32_t i = 0; i < entityCount; ++i)
+		{
+			uint32_t name = 0;
+			std::memcpy(&name, names.data() + size_t{i} * sizeof(uint32_t), sizeof(uint32_t));
+			data.Names.emplace_back(name < strings.size() ? strings[name] : std::string_view{});
+		}
+
+		std::unordered_map<uint64_t, const ComponentCodec*> codecsById;
+		for (const ComponentCodec& codec : GetComponentCodecs())
+		{
+			codecsById.emplace(codec.Id, &codec);
+		}
+
+		// Match chunks to codecs and resolve their entity lists; anything unusable is skipped with a warning
+		// (a component the engine no longer has, or a layout from an older build).
+		std::vector<const ComponentCodec*> chunkCodecs(chunks.size(), nullptr);
+		std::vector<std::vector<uint32_t>> chunkEntities(chunks.size());
+		bool valid = true;
+		for (size_t c = 0; c < chunks.size(); ++c)
+		{
+			const ChunkView& chunk = chunks[c];
+			const std::string_view typeName = chunk.TypeName < strings.size() ? strings[chunk.TypeName] : "<unknown>";
+			const auto it = codecsById.find(chunk.Id);
+			if (it == codecsById.end())
+			{
+				SS_CORE_WARN("Binary scene: skipping {} ({} entities): component not registered", typeName, chunk.Count);
+				continue;
+			}
+			const ComponentCodec& codec = *it->second;
+			if (chunk.Encoding != codec.Encoding || chunk.Layout != codec.Layout)
+			{
+				SS_CORE_WARN("Binary scene: skipping {} ({} entities): written with a different field layout; re-export the scene from its .world",
+				             typeName, chunk.Count);
+				continue;
+			}
+
+			// Indices must be in range and strictly ascending (the writer's order), which sliced commits rely on.
+			std::vector<uint32_t>& members = chunkEntities[c];
+			members.resize(chunk.Count);
+			std::memcpy(members.data(), chunk.EntityIndices.data(), chunk.EntityIndices.size());
+			const bool ordered = std::ranges::adjacent_find(members, std::greater_equal<>{}) == members.end();
+			if (!ordered || (!members.empty() && members.back() >= entityCount))
+			{
+				SS_CORE_WARN("Binary scene: {} chunk has an invalid entity list; skipped", typeName);
+				members.clear();
+				valid = false;
+				continue;
+			}
+			chunkCodecs[c] = &codec;
+		}
+
+		// Decode every chunk in parallel: pure CPU work on the chunk's own bytes into its own staging buffer.
+		std::vector<std::unique_ptr<DecodedChunk>> decoded(chunks.size());
+		const auto decodeRange = [&](const size_t begin, const size_t end)
+		{
+			for (size_t c = begin; c < end; ++c)
+			{
+				if (chunkCodecs[c])
+				{
+					decoded[c] = chunkCodecs[c]->DecodeFn(chunks[c].Payload, chunks[c].Count);
+				}
+			}
+		};
+		if (jobs)
+		{
+			jobs->ParallelFor(chunks.size(), decodeRange, 1);
+		}
+		else
+		{
+			decodeRange(0, chunks.size());
+		}
+
+		// Keep file order: it is the order components get added in.
+		for (size_t c = 0; c < chunks.size(); ++c)
+		{
+			if (!chunkCodecs[c])
+			{
+				continue;
+			}
+			if (!decoded[c])
+			{
+				SS_CORE_WARN("Binary scene: {} chunk is corrupt; skipped", chunkCodecs[c]->TypeName);
+				valid = false;
+				continue;
+			}
+			data.Chunks.push_back({.Entities = std::move(chunkEntities[c]), .Values = std::move(decoded[c])});
+		}
+
+		return valid;
+	}
+
+	bool SceneBinarySerializer::DecodeFile(const std::string& filePath, DecodedScene& out, JobSystem* jobs)
+	{
+		std::vector<uint8_t> bytes;
+		if (!ReadFile(filePath, bytes))
+		{
+			out = DecodedScene{};
+			return false;
+		}
+		return Decode(bytes, out, jobs);
+	}
+
+	bool SceneBinarySerializer::DeserializeFromBytes(World& world, const std::span<const uint8_t> bytes, JobSystem* jobs)
+	{
+		DecodedScene scene;
+		const bool valid = Decode(bytes, scene, jobs);
+
+		// A damaged buffer decodes to nothing; a corrupt chunk only loses that chunk.
+		scene.CommitSlice(world, scene.GetEntityCount());
+		return valid;
+	}
+
+	bool SceneBinarySerializer::Serialize(const World& world, const std::string& filePath)
+	{
+		return WriteFile(filePath, SerializeToBytes(world));
+	}
+
+	bool SceneBinarySerializer::Deserialize(World& world, const std::string& filePath, JobSystem* jobs)
+	{
+		std::vector<uint8_t> bytes;
+		if (!ReadFile(filePath, bytes))
+		{
+			return false;
+		}
+		return DeserializeFromBytes(world, bytes, jobs);
+	}
+
+	bool SceneBinarySerializer::SerializeEntities(const std::span<const Entity> entities, const std::string& filePath)
+	{
+		return WriteFile(filePath, SerializeEntitiesToBytes(entities));
+	}
+
+	std::vector<uint8_t> SceneBinarySerializer::ConvertJsonToBinary(const std::string& jsonText)
+	{
+		World scratch;
+		if (!SceneSerializer::DeserializeFromString(scratch, jsonText))
+		{
+			return {};
+		}
+		return SerializeToBytes(scratch);
+	}
+
+	std::string SceneBinarySerializer::ConvertBinaryToJson(const std::span<const uint8_t> bytes)
+	{
+		World scratch;
+		if (!DeserializeFromBytes(scratch, bytes))
+		{
+			return {};
+		}
+		return SceneSerializer::SerializeToString(scratch);
+	}
+
+	bool SceneBinarySerializer::ConvertFile(const std::string& sourcePath, const std::string& destinationPath)
+	{
+		// Load with whichever reader the source's extension picks, write with the destination's.
+		World scratch;
+		if (!SceneSerializer::Deserialize(scratch, sourcePath))
+		{
+			SS_CORE_WARN("Scene conversion: failed to read '{}'", sourcePath);
+			return false;
+		}
+		if (!SceneSerializer::Serialize(scratch, destinationPath))
+		{
+			SS_CORE_WARN("Scene conversion: failed to write '{}'", destinationPath);
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Snowstorm/World/World.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// A binary scene decoded but not yet in any World: the entity table plus every chunk's decoded components.
+	// Decoding touches no World, so it can run on any thread; committing creates the entities on the World's
+	// thread, all at once or in bounded slices (level streaming spreads a cell over several frames).
+	class DecodedScene
+	{
+	public:
+		DecodedScene();
+		~DecodedScene();
+		DecodedScene(DecodedScene&&) noexcept;
+		DecodedScene& operator=(DecodedScene&&) noexcept;
+
+		[[nodiscard]] uint32_t GetEntityCount() const;
+		[[nodiscard]] uint32_t GetCommittedCount() const;
+		[[nodiscard]] bool IsFullyCommitted() const { return GetCommittedCount() == GetEntityCount(); }
+
+		// Create up to `maxEntities` more entities, in file order, each with all of its components (an entity
+		// never shows up half-built), appending them to `created` when given. Returns how many were created.
+		uint32_t CommitSlice(World& world, uint32_t maxEntities, std::vector<Entity>* created = nullptr);
+
+	private:
+		friend class SceneBinarySerializer;
+
+		struct Data;
+		std::unique_ptr<Data> m_Data;
+	};
+
+	// Binary scene format (.ssworld): the load-fast counterpart of SceneSerializer's JSON .world, which stays
+	// the format for diffs, hand edits and interchange. Same content -- every serializable component of every
+	// entity SceneSerializer would write -- laid out for loading, not reading:
+	//
+	//  - one string table (entity names, component type names), so repeated tags are stored once;
+	//  - an entity table of UUIDs + name indices;
+	//  - per-component chunks keyed by a stable component id (a hash of the reflected type name, so ids
+	//    survive registration-order changes). A chunk lists its entities, then the component data as SoA
+	//    columns -- one contiguous column per field -- written and read by functions generated at compile
+	//    time from a field list (see BinaryFields in the .cpp), with no RTTR property walk.
+	//
+	// Components without a field list (non-POD ones: material overrides, scripts, ...) are stored as their
+	// per-entity SceneSerializer JSON in CBOR, so the format is lossless for everything the JSON path handles.
+	//
+	// Loading decodes every chunk in parallel on the JobSystem (when given one) into a DecodedScene, then
+	// creates the entities and adds the decoded components on the calling thread (the registry isn't
+	// thread-safe). Chunks are capped in size so one big component (every entity has a Transform) still splits
+	// across workers.
+	//
+	// The file is a cache-like artifact of the engine that wrote it: a chunk whose field layout no longer
+	// matches this build's (a component gained a field) is skipped with a warning. Re-export from the JSON.
+	class SceneBinarySerializer
+	{
+	public:
+		static constexpr const char* kExtension = ".ssworld";
+
+		// Whether `filePath` names a binary scene (by extension).
+		[[nodiscard]] static bool IsBinaryScenePath(const std::string& filePath);
+
+		// The component types stored as generated columns, each with its column (RTTR property) names in file
+		// order. For checking the field lists against reflection.
+		struct ColumnFieldList
+		{
+			std::string TypeName;
+			std::vector<std::string> Fields;
+		};
+		[[nodiscard]] static std::vector<ColumnFieldList> GetColumnFieldLists();
+
+		static bool Serialize(const World& world, const std::string& filePath);
+
+		// Like SceneSerializer::Deserialize, only ADDS entities -- the caller clears the world first. `jobs`
+		// decodes chunks in parallel; null decodes them on the calling thread.
+		static bool Deserialize(World& world, const std::string& filePath, JobSystem* jobs = nullptr);
+
+		// In-memory equivalents. SerializeToBytes never fails (an empty world is a valid scene);
+		// DeserializeFromBytes returns false on a truncated/foreign buffer (nothing is added) or a corrupt
+		// chunk (everything else is).
+		[[nodiscard]] static std::vector<uint8_t> SerializeToBytes(const World& world);
+		static bool DeserializeFromBytes(World& world, std::span<const uint8_t> bytes, JobSystem* jobs = nullptr);
+
+		// A scene of exactly `entities` (each needs an ID and a Tag; DoNotSerialize is not checked). World
+		// partitioning writes one of these per cell.
+		[[nodiscard]] static std::vector<uint8_t> SerializeEntitiesToBytes(std::span<const Entity> entities);
+		static bool SerializeEntities(std::span<const Entity> entities, const std::string& filePath);
+
+		// Decode without a World, for committing later (DecodedScene::CommitSlice). Same failure rules as
+		// DeserializeFromBytes: `out` is empty for a bad buffer, and misses only a corrupt chunk otherwise.
+		// Don't pass `jobs` when already running on one of its workers (ParallelFor there would deadlock).
+		static bool Decode(std::span<const uint8_t> bytes, DecodedScene& out, JobSystem* jobs = nullptr);
+		static bool DecodeFile(const std::string& filePath, DecodedScene& out, JobSystem* jobs = nullptr);
+
+		// Lossless JSON <-> binary conversion, through a scratch World (so both sides go through exactly the
+		// component handling the loaders use). Empty result on failure.
+		[[nodiscard]] static std::vector<uint8_t> ConvertJsonToBinary(const std::string& jsonText);
+		[[nodiscard]] static std::string ConvertBinaryToJson(std::span<const uint8_t> bytes);
+
+		// Convert a scene file to the other format; the direction follows the source's extension.
+		static bool ConvertFile(const std::string& sourcePath, const std::string& destinationPath);
+	};
+}
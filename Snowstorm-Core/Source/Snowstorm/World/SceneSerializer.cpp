@@ -1,11 +1,15 @@
 ﻿#include "SceneSerializer.hpp"
 
+#include "SceneBinarySerializer.hpp"
+
 #include "Snowstorm/Components/IDComponent.hpp"
 #include "Snowstorm/Components/TagComponent.hpp"
 #include "Snowstorm/Components/ComponentRegistry.hpp"
 #include "Snowstorm/Components/DoNotSerializeComponent.hpp"
 
 #include "Snowstorm/Assets/AssetManagerSingleton.hpp"
+#include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Components/MaterialComponent.hpp"
 #include "Snowstorm/Components/MaterialOverridesComponent.hpp"
 #include "Snowstorm/Components/MeshComponent.hpp"
@@ -93,7 +97,7 @@ namespace Snowstorm
 			return false;
 		}
 
-		bool DeserializeComponentOverride(const World& world, Entity entity, const std::string& typeName, const nlohmann::json& inJson)
+		bool DeserializeComponentOverride(Entity entity, const std::string& typeName, const nlohmann::json& inJson)
 		{
 			if (typeName == "Snowstorm::MeshComponent")
 			{
@@ -222,13 +226,7 @@ namespace Snowstorm
 				continue;
 			}
 
-			if (SerializeComponentOverride(entity, info.Type, comps[typeName]))
-			{
-				continue;
-			}
-
-			rttr::instance inst = info.GetInstanceFn(entity);
-			comps[typeName] = RttrInstanceToJson(inst);
+			SerializeComponent(entity, info, comps[typeName]);
 		}
 
 		out["Components"] = std::move(comps);
@@ -251,45 +249,65 @@ namespace Snowstorm
 
 		for (auto it = comps.begin(); it != comps.end(); ++it)
 		{
-			const std::string& compTypeName = it.key();
-			const json& compData = it.value();
+			DeserializeComponent(entity, it.key(), it.value());
+		}
 
-			// Override path first (assets, entity refs, etc.)
-			if (DeserializeComponentOverride(world, entity, compTypeName, compData))
-			{
-				continue;
-			}
+		return entity;
+	}
 
-			// Find matching component registration
-			const auto& registry = GetComponentRegistry();
-			auto found = std::ranges::find_if(registry,
-			                                  [&](const ComponentInfo& ci)
-			                                  {
-				                                  return ci.Type.is_valid() && ci.Type.get_name().to_string() == compTypeName;
-			                                  });
+	bool SceneSerializer::SerializeComponent(Entity entity, const ComponentInfo& info, json& out)
+	{
+		if (!info.Type.is_valid() || !info.GetInstanceFn)
+		{
+			return false;
+		}
 
-			if (found == registry.end())
-			{
-				continue;
-			}
+		if (SerializeComponentOverride(entity, info.Type, out))
+		{
+			return true;
+		}
 
-			if (!found->Serializable)
-			{
-				continue;
-			}
+		rttr::instance inst = info.GetInstanceFn(entity);
+		out = RttrInstanceToJson(inst);
+		return true;
+	}
 
-			if (!found->EmplaceDefaultFn || !found->GetInstanceFn)
-			{
-				continue;
-			}
+	bool SceneSerializer::DeserializeComponent(Entity entity, const std::string& compTypeName, const json& compData)
+	{
+		// Override path first (assets, entity refs, etc.)
+		if (DeserializeComponentOverride(entity, compTypeName, compData))
+		{
+			return true;
+		}
 
-			found->EmplaceDefaultFn(entity);
-			rttr::instance inst = found->GetInstanceFn(entity);
+		// Find matching component registration
+		const auto& registry = GetComponentRegistry();
+		auto found = std::ranges::find_if(registry,
+		                                  [&](const ComponentInfo& ci)
+		                                  {
+			                                  return ci.Type.is_valid() && ci.Type.get_name().to_string() == compTypeName;
+		                                  });
 
-			JsonToRttrInstance(compData, inst);
+		if (found == registry.end())
+		{
+			return false;
 		}
 
-		return entity;
+		if (!found->Serializable)
+		{
+			return false;
+		}
+
+		if (!found->EmplaceDefaultFn || !found->GetInstanceFn)
+		{
+			return false;
+		}
+
+		found->EmplaceDefaultFn(entity);
+		rttr::instance inst = found->GetInstanceFn(entity);
+
+		JsonToRttrInstance(compData, inst);
+		return true;
 	}
 
 	std::string SceneSerializer::SerializeToString(const World& world)
@@ -349,6 +367,11 @@ namespace Snowstorm
 
 	bool SceneSerializer::Serialize(const World& world, const std::string& filePath)
 	{
+		if (SceneBinarySerializer::IsBinaryScenePath(filePath))
+		{
+			return SceneBinarySerializer::Serialize(world, filePath);
+		}
+
 		std::ofstream out(filePath);
 		if (!out.is_open())
 		{
@@ -361,6 +384,17 @@ namespace Snowstorm
 
 	bool SceneSerializer::Deserialize(World& world, const std::string& filePath)
 	{
+		if (SceneBinarySerializer::IsBinaryScenePath(filePath))
+		{
+			// Chunks decode in parallel on the application's job pool when there is one (not in headless tests).
+			JobSystem* jobs = nullptr;
+			if (Application::Exists() && Application::Get().GetServiceManager().ServiceRegistered<JobSystem>())
+			{
+				jobs = &Application::Get().GetServiceManager().GetService<JobSystem>();
+			}
+			return SceneBinarySerializer::Deserialize(world, filePath, jobs);
+		}
+
 		std::ifstream in(filePath);
 		if (!in.is_open())
 		{
@@ -8,10 +8,13 @@
 namespace Snowstorm
 {
 	class Entity;
+	struct ComponentInfo;
 
 	class SceneSerializer
 	{
 	public:
+		// File entry points. A path ending in ".ssworld" goes through SceneBinarySerializer (the fast-load
+		// binary format); anything else is the JSON .world.
 		static bool Serialize(const World& world, const std::string& filePath);
 		static bool Deserialize(World& world, const std::string& filePath);
 
@@ -30,5 +33,12 @@ namespace Snowstorm
 		// Recreate an entity from a JSON object produced by SerializeEntity, preserving its UUID (so an
 		// undone delete returns with its original identity). Returns the new Entity (invalid on failure).
 		static Entity DeserializeEntity(World& world, const nlohmann::json& in);
+
+		// One component's JSON, exactly as SerializeEntity writes it under "Components" (the asset/entity-ref
+		// overrides, else the RTTR property walk), and its inverse onto an existing entity. Shared with the
+		// binary format, which stores components it has no generated codec for as this JSON. Both return
+		// false for a component type they can't handle.
+		static bool SerializeComponent(Entity entity, const ComponentInfo& info, nlohmann::json& out);
+		static bool DeserializeComponent(Entity entity, const std::string& typeName, const nlohmann::json& in);
 	};
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include "Snowstorm/Systems/ReflectionGeometrySingleton.hpp"
 #include "Snowstorm/Systems/TlasInstanceMapSingleton.hpp"
 #include "Snowstorm/World/EditorHooksSingleton.hpp"
+#include "Snowstorm/World/LevelStreamingSingleton.hpp"
 
 namespace Snowstorm
 {
@@ -33,6 +34,10 @@ namespace Snowstorm
 
 		m_SingletonManager->RegisterSingleton<AssetManagerSingleton>(this);
 
+		// Open world partition (.sspartition) and its cells' residency, driven by LevelStreamingSystem. Closed
+		// (and inert) unless a partitioned scene is opened.
+		m_SingletonManager->RegisterSingleton<LevelStreamingSingleton>(this);
+
 		// TLAS instance index -> entity table for RT editor picking (#118 follow-up). Written by
 		// TlasBuildSystem, read by the editor's pick path. Core-scoped so both the editor and a headless
 		// runtime carry it (harmless when unused: it just stays empty).
@@ -0,0 +1,401 @@
+#include "WorldPartition.hpp"
+
+#include "Entity.hpp"
+#include "SceneBinarySerializer.hpp"
+#include "World.hpp"
+
+#include "Snowstorm/Assets/AssetManagerSingleton.hpp"
+#include "Snowstorm/Assets/MaterialAssetIO.hpp"
+#include "Snowstorm/Assets/MeshMetaCache.hpp"
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/DoNotSerializeComponent.hpp"
+#include "Snowstorm/Components/IDComponent.hpp"
+#include "Snowstorm/Components/MaterialComponent.hpp"
+#include "Snowstorm/Components/MaterialOverridesComponent.hpp"
+#include "Snowstorm/Components/MeshComponent.hpp"
+#include "Snowstorm/Components/TagComponent.hpp"
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Lighting/EnvironmentComponent.hpp"
+#include "Snowstorm/Lighting/LightingComponents.hpp"
+#include "Snowstorm/Project/Project.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <set>
+
+namespace Snowstorm
+{
+	using json = nlohmann::json;
+
+	namespace
+	{
+		constexpr int kManifestVersion = 1;
+
+		json Vec3ToJson(const glm::vec3& v)
+		{
+			return json::array({v.x, v.y, v.z});
+		}
+
+		bool JsonToVec3(const json& j, glm::vec3& out)
+		{
+			if (!j.is_array() || j.size() != 3)
+			{
+				return false;
+			}
+			out = {j[0].get<float>(), j[1].get<float>(), j[2].get<float>()};
+			return true;
+		}
+
+		// Entities that belong to the whole map rather than a place on it.
+		bool IsPersistent(const Entity entity)
+		{
+			return !entity.HasComponent<TransformComponent>() || entity.HasComponent<CameraComponent>() ||
+			       entity.HasComponent<DirectionalLightComponent>() || entity.HasComponent<EnvironmentComponent>();
+		}
+
+		// World-space bounds of an entity: its mesh's (resident, else the cooked bounds sidecar), else a point.
+		AABB EntityBounds(const Entity entity)
+		{
+			const TransformComponent& transform = entity.GetComponent<TransformComponent>();
+			if (entity.HasComponent<MeshComponent>())
+			{
+				const MeshComponent& mc = entity.GetComponent<MeshComponent>();
+				if (mc.MeshInstance)
+				{
+					return TransformAABB(mc.MeshInstance->GetBounds().Box, transform.GetTransformMatrix());
+				}
+				if (const auto cached = MeshMetaCacheIO::Load(mc.MeshHandle))
+				{
+					return TransformAABB(cached->Bounds.Box, transform.GetTransformMatrix());
+				}
+			}
+			return {transform.Position, transform.Position};
+		}
+
+		void Expand(AABB& box, const AABB& other)
+		{
+			box.Min = glm::min(box.Min, other.Min);
+			box.Max = glm::max(box.Max, other.Max);
+		}
+
+		// On-disk size of an asset's source, as the estimate of what it costs resident. Submeshes of one model
+		// share the file, so sizes are counted per distinct file (`seen`); a material adds its textures.
+		uint64_t AssetFileBytes(AssetManagerSingleton& assets, const AssetHandle handle, std::set<std::filesystem::path>& seen)
+		{
+			const AssetMetadata* meta = assets.GetMetadata(handle);
+			const Ref<Project> project = Project::GetActive();
+			if (!meta || !project)
+			{
+				return 0;
+			}
+
+			std::string relative = meta->Path.string();
+			if (const size_t submesh = relative.find("?submesh="); submesh != std::string::npos)
+			{
+				relative.resize(submesh);
+			}
+			const std::filesystem::path path = project->GetProjectDirectory() / relative;
+			if (!seen.insert(path).second)
+			{
+				return 0;
+			}
+
+			std::error_code error;
+			const uintmax_t size = std::filesystem::file_size(path, error);
+			uint64_t bytes = error ? 0 : static_cast<uint64_t>(size);
+
+			MaterialAsset material{};
+			if (meta->Type == AssetType::Material && MaterialAssetIO::Load(path, material))
+			{
+				for (const AssetHandle texture : {material.AlbedoTexture, material.NormalTexture, material.MetallicRoughnessTexture,
+				                                  material.AOTexture, material.EmissiveTexture})
+				{
+					if (texture != 0)
+					{
+						bytes += AssetFileBytes(assets, texture, seen);
+					}
+				}
+			}
+			return bytes;
+		}
+
+		struct GridCoordLess
+		{
+			bool operator()(const glm::ivec2& a, const glm::ivec2& b) const
+			{
+				return a.x != b.x ? a.x < b.x : a.y < b.y;
+			}
+		};
+	}
+
+	bool WorldPartition::IsPartitionPath(const std::string& filePath)
+	{
+		return std::filesystem::path(filePath).extension() == kExtension;
+	}
+
+	bool WorldPartition::SaveManifest(const WorldPartitionManifest& manifest, const std::filesystem::path& filePath)
+	{
+		json root;
+		root["Type"] = "SnowstormWorldPartition";
+		root["Version"] = kManifestVersion;
+		root["CellSize"] = manifest.CellSize;
+		root["PersistentFile"] = manifest.PersistentFile;
+
+		json cells = json::array();
+		for (const StreamingCell& cell : manifest.Cells)
+		{
+			json entry;
+			entry["Coord"] = json::array({cell.Coord.x, cell.Coord.y});
+			entry["BoundsMin"] = Vec3ToJson(cell.Bounds.Min);
+			entry["BoundsMax"] = Vec3ToJson(cell.Bounds.Max);
+			entry["File"] = cell.File;
+			entry["MemoryBytes"] = cell.MemoryBytes;
+			entry["EntityCount"] = cell.EntityCount;
+			cells.push_back(std::move(entry));
+		}
+		root["Cells"] = std::move(cells);
+
+		std::ofstream out(filePath);
+		if (!out.is_open())
+		{
+			return false;
+		}
+		out << root.dump(2);
+		return static_cast<bool>(out);
+	}
+
+	std::optional<WorldPartitionManifest> WorldPartition::LoadManifest(const std::filesystem::path& filePath)
+	{
+		std::ifstream in(filePath);
+		if (!in.is_open())
+		{
+			SS_CORE_WARN("World partition: cannot open '{}'", filePath.string());
+			return std::nullopt;
+		}
+
+		const json root = json::parse(in, nullptr, false);
+		if (root.is_discarded() || root.value("Type", "") != "SnowstormWorldPartition")
+		{
+			SS_CORE_WARN("World partition: '{}' is not a .sspartition manifest", filePath.string());
+			return std::nullopt;
+		}
+		if (root.value("Version", 0) != kManifestVersion)
+		{
+			SS_CORE_WARN("World partition: '{}' has unsupported version {}", filePath.string(), root.value("Version", 0));
+			return std::nullopt;
+		}
+
+		WorldPartitionManifest manifest;
+		manifest.CellSize = root.value("CellSize", manifest.CellSize);
+		manifest.PersistentFile = root.value("PersistentFile", "");
+		if (const auto cells = root.find("Cells"); cells != root.end() && cells->is_array())
+		{
+			for (const json& entry : *cells)
+			{
+				StreamingCell cell;
+				const json coord = entry.value("Coord", json::array());
+				if (coord.is_array() && coord.size() == 2)
+				{
+					cell.Coord = {coord[0].get<int>(), coord[1].get<int>()};
+				}
+				const bool hasBounds = entry.contains("BoundsMin") && entry.contains("BoundsMax") &&
+				                       JsonToVec3(entry["BoundsMin"], cell.Bounds.Min) && JsonToVec3(entry["BoundsMax"], cell.Bounds.Max);
+				cell.File = entry.value("File", "");
+				cell.MemoryBytes = entry.value("MemoryBytes", uint64_t{0});
+				cell.EntityCount = entry.value("EntityCount", uint32_t{0});
+				if (!hasBounds || cell.File.empty())
+				{
+					SS_CORE_WARN("World partition: '{}' has a cell without bounds or file; skipped", filePath.string());
+					continue;
+				}
+				manifest.Cells.push_back(std::move(cell));
+			}
+		}
+		return manifest;
+	}
+
+	std::vector<AssetHandle> WorldPartition::CollectAssetReferences(const std::span<const Entity> entities)
+	{
+		std::vector<AssetHandle> handles;
+		for (const Entity entity : entities)
+		{
+			if (!entity.IsValid())
+			{
+				continue;
+			}
+			if (entity.HasComponent<MeshComponent>())
+			{
+				handles.push_back(entity.GetComponent<MeshComponent>().MeshHandle);
+			}
+			if (entity.HasComponent<MaterialComponent>())
+			{
+				handles.push_back(entity.GetComponent<MaterialComponent>().Material);
+			}
+			if (entity.HasComponent<MaterialOverridesComponent>())
+			{
+				for (const MaterialOverride& o : entity.GetComponent<MaterialOverridesComponent>().Overrides)
+				{
+					if (o.Type == MaterialOverrideType::Texture)
+					{
+						handles.push_back(o.Texture);
+					}
+				}
+			}
+		}
+
+		std::erase_if(handles, [](const AssetHandle h)
+		              { return h == 0; });
+		std::ranges::sort(handles, [](const AssetHandle a, const AssetHandle b)
+		                  { return a.Value() < b.Value(); });
+		const auto [first, last] = std::ranges::unique(handles);
+		handles.erase(first, last);
+		return handles;
+	}
+
+	bool WorldPartition::Split(const World& world, const float cellSize, const std::filesystem::path& manifestPath,
+	                           AssetManagerSingleton* assets)
+	{
+		if (!(cellSize > 0.0f))
+		{
+			SS_CORE_WARN("World partition: cell size must be positive (got {})", cellSize);
+			return false;
+		}
+
+		// Bucket the scene's entities (the serializer's set: identity, minus DoNotSerialize).
+		std::vector<Entity> persistent;
+		std::map<glm::ivec2, std::vector<Entity>, GridCoordLess> buckets;
+		auto& reg = world.GetRegistry();
+		for (const entt::entity e : reg.view<IDComponent, TagComponent>())
+		{
+			if (reg.any_of<DoNotSerializeComponent>(e))
+			{
+				continue;
+			}
+			const Entity entity{e, const_cast<World*>(&world)};
+			if (IsPersistent(entity))
+			{
+				persistent.push_back(entity);
+				continue;
+			}
+			const glm::vec3& position = entity.GetComponent<TransformComponent>().Position;
+			const glm::ivec2 coord{static_cast<int>(std::floor(position.x / cellSize)), static_cast<int>(std::floor(position.z / cellSize))};
+			buckets[coord].push_back(entity);
+		}
+
+		const std::filesystem::path directory = manifestPath.parent_path();
+		const std::string cellDirName = manifestPath.stem().string() + "_cells";
+		std::error_code error;
+		std::filesystem::create_directories(directory / cellDirName, error);
+		if (error)
+		{
+			SS_CORE_WARN("World partition: cannot create '{}': {}", (directory / cellDirName).string(), error.message());
+			return false;
+		}
+
+		WorldPartitionManifest manifest;
+		manifest.CellSize = cellSize;
+		manifest.PersistentFile = cellDirName + "/persistent" + SceneBinarySerializer::kExtension;
+		if (!SceneBinarySerializer::SerializeEntities(persistent, (directory / manifest.PersistentFile).string()))
+		{
+			SS_CORE_WARN("World partition: failed to write '{}'", manifest.PersistentFile);
+			return false;
+		}
+
+		for (const auto& [coord, entities] : buckets)
+		{
+			StreamingCell cell;
+			cell.Coord = coord;
+			cell.File = cellDirName + "/cell_" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + SceneBinarySerializer::kExtension;
+			cell.EntityCount = static_cast<uint32_t>(entities.size());
+
+			// The grid square, grown to everything in it.
+			cell.Bounds.Min = {static_cast<float>(coord.x) * cellSize, 0.0f, static_cast<float>(coord.y) * cellSize};
+			cell.Bounds.Max = cell.Bounds.Min + glm::vec3(cellSize, 0.0f, cellSize);
+			for (const Entity entity : entities)
+			{
+				Expand(cell.Bounds, EntityBounds(entity));
+			}
+
+			const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeEntitiesToBytes(entities);
+			std::ofstream out(directory / cell.File, std::ios::binary | std::ios::trunc);
+			out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			if (!out)
+			{
+				SS_CORE_WARN("World partition: failed to write '{}'", cell.File);
+				return false;
+			}
+
+			cell.MemoryBytes = bytes.size();
+			if (assets)
+			{
+				std::set<std::filesystem::path> seen;
+				for (const AssetHandle handle : CollectAssetReferences(entities))
+				{
+					cell.MemoryBytes += AssetFileBytes(*assets, handle, seen);
+				}
+			}
+			manifest.Cells.push_back(std::move(cell));
+		}
+
+		if (!SaveManifest(manifest, manifestPath))
+		{
+			SS_CORE_WARN("World partition: failed to write '{}'", manifestPath.string());
+			return false;
+		}
+		SS_CORE_INFO("World partition: split into {} cells ({} persistent entities) -> {}", manifest.Cells.size(), persistent.size(),
+		             manifestPath.string());
+		return true;
+	}
+
+	float WorldPartition::DistanceToCell(const StreamingCell& cell, const glm::vec3& point)
+	{
+		const float dx = std::max({cell.Bounds.Min.x - point.x, 0.0f, point.x - cell.Bounds.Max.x});
+		const float dz = std::max({cell.Bounds.Min.z - point.z, 0.0f, point.z - cell.Bounds.Max.z});
+		return std::sqrt(dx * dx + dz * dz);
+	}
+
+	StreamingPlan WorldPartition::PlanStreaming(const std::span<const StreamingCell> cells, const std::span<const CellResidency> residency,
+	                                            const StreamingPlanSettings& settings)
+	{
+		std::vector<float> distances(cells.size());
+		for (size_t i = 0; i < cells.size(); ++i)
+		{
+			distances[i] = DistanceToCell(cells[i], settings.Origin);
+		}
+		std::vector<uint32_t> order(cells.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::ranges::stable_sort(order, [&](const uint32_t a, const uint32_t b)
+		                         { return distances[a] < distances[b]; });
+
+		StreamingPlan plan;
+		uint64_t used = 0;
+		for (const uint32_t i : order)
+		{
+			const CellResidency state = i < residency.size() ? residency[i] : CellResidency::Unloaded;
+			const bool resident = state != CellResidency::Unloaded;
+			const float radius = resident ? std::max(settings.UnloadRadius, settings.LoadRadius) : settings.LoadRadius;
+
+			// Nearer cells claim the budget first, so when it runs out the farthest cells are the ones left out.
+			const bool wanted = distances[i] <= radius && used + cells[i].MemoryBytes <= settings.BudgetBytes;
+			if (wanted)
+			{
+				used += cells[i].MemoryBytes;
+				if (!resident && plan.Load.size() < settings.MaxNewLoads)
+				{
+					plan.Load.push_back(i);
+				}
+			}
+			else if (resident)
+			{
+				plan.Unload.push_back(i);
+			}
+		}
+		return plan;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Snowstorm/Assets/AssetTypes.hpp"
+#include "Snowstorm/Math/Bounds.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Snowstorm
+{
+	class AssetManagerSingleton;
+	class Entity;
+	class World;
+
+	// One spatial cell of a partitioned world: a binary scene (.ssworld) holding the entities placed in one
+	// square of the XZ grid. Bounds cover the square and everything in it (mesh bounds where known), so a
+	// tall or overhanging prop still counts as near when its square isn't.
+	struct StreamingCell
+	{
+		glm::ivec2 Coord{0};
+		AABB Bounds;
+		std::string File;         // relative to the manifest's directory
+		uint64_t MemoryBytes = 0; // estimate: cell file + the files of every asset it references
+		uint32_t EntityCount = 0;
+	};
+
+	// A partitioned world (.sspartition, JSON): the cells, plus one always-loaded "persistent" scene for what
+	// has no place on the grid -- cameras, the sun, the environment, anything without a Transform.
+	struct WorldPartitionManifest
+	{
+		float CellSize = 64.0f;
+		std::string PersistentFile; // relative to the manifest's directory
+		std::vector<StreamingCell> Cells;
+	};
+
+	// Where a cell is in its load, as the planner sees it (LevelStreamingSystem folds its finer states in).
+	enum class CellResidency : uint8_t
+	{
+		Unloaded,
+		Loading, // decoding on a worker, or being committed to the registry
+		Loaded
+	};
+
+	struct StreamingPlanSettings
+	{
+		glm::vec3 Origin{0.0f};
+		float LoadRadius = 0.0f;
+		float UnloadRadius = 0.0f; // >= LoadRadius; the hysteresis band between them keeps what's resident
+		uint64_t BudgetBytes = 0;
+		uint32_t MaxNewLoads = 0;
+	};
+
+	struct StreamingPlan
+	{
+		std::vector<uint32_t> Load;   // cell indices to start loading, nearest first
+		std::vector<uint32_t> Unload; // loaded or loading cells to drop
+	};
+
+	class WorldPartition
+	{
+	public:
+		static constexpr const char* kExtension = ".sspartition";
+
+		[[nodiscard]] static bool IsPartitionPath(const std::string& filePath);
+
+		static bool SaveManifest(const WorldPartitionManifest& manifest, const std::filesystem::path& filePath);
+		[[nodiscard]] static std::optional<WorldPartitionManifest> LoadManifest(const std::filesystem::path& filePath);
+
+		// Split a loaded scene into a partition: every serializable entity with a Transform (other than
+		// cameras, directional lights and environments) goes to the grid cell its position falls in, the rest
+		// to the persistent scene. Writes the cell files into "<manifest stem>_cells/" next to the manifest,
+		// then the manifest. `assets` (the project's asset manager) refines the cell bounds with resident mesh
+		// bounds and the memory estimate with asset file sizes; without it a cell's estimate is its own file.
+		static bool Split(const World& world, float cellSize, const std::filesystem::path& manifestPath,
+		                  AssetManagerSingleton* assets = nullptr);
+
+		// Every mesh, material and override texture the entities reference, sorted and unique: what a cell
+		// holds resident (and what its memory estimate counts).
+		[[nodiscard]] static std::vector<AssetHandle> CollectAssetReferences(std::span<const Entity> entities);
+
+		// XZ distance from `point` to the cell's bounds (0 inside). Height is ignored: streaming follows the
+		// camera over the map, not up into the sky.
+		[[nodiscard]] static float DistanceToCell(const StreamingCell& cell, const glm::vec3& point);
+
+		// Decide what to load and unload. Cells are taken nearest first; one is wanted while its distance is
+		// within LoadRadius (UnloadRadius if it's already loaded or loading) AND its estimate still fits the
+		// budget left by the nearer wanted cells. Wanted unloaded cells are returned to load (at most
+		// MaxNewLoads); unwanted resident ones to unload. Pure, so it's tested without a World.
+		[[nodiscard]] static StreamingPlan PlanStreaming(std::span<const StreamingCell> cells, std::span<const CellResidency> residency,
+		                                                 const StreamingPlanSettings& settings);
+	};
+}
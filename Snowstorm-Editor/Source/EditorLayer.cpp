@@ -48,7 +48,9 @@
 #include "Snowstorm/World/EditorHooksSingleton.hpp"
 #include "Snowstorm/Input/InputStateSingleton.hpp"
 #include "Snowstorm/World/SimulationStateSingleton.hpp"
+#include "Snowstorm/World/LevelStreamingSingleton.hpp"
 #include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/WorldPartition.hpp"
 #include "Snowstorm/Project/Project.hpp"
 #include "Snowstorm/Project/ProjectSerializer.hpp"
 
@@ -460,7 +462,11 @@ namespace Snowstorm
 		// world we're about to replace) — see EditorLayer::RegisterEditorSystems.
 		m_ActiveWorld->ClearSceneEntities();
 
-		if (!SceneSerializer::Deserialize(*m_ActiveWorld, scenePath))
+		// A partitioned world loads only its persistent scene here; LevelStreamingSystem streams the cells in
+		// around the camera from the next frame on.
+		const bool partitioned = WorldPartition::IsPartitionPath(scenePath);
+		if (partitioned ? !m_ActiveWorld->GetSingleton<LevelStreamingSingleton>().Open(scenePath)
+		                : !SceneSerializer::Deserialize(*m_ActiveWorld, scenePath))
 		{
 			SS_CORE_WARN("Failed to deserialize scene '{}'.", scenePath);
 			return false;
@@ -653,6 +659,14 @@ namespace Snowstorm
 			return false;
 		}
 
+		// Saving would write every currently streamed-in cell into one file (or over the manifest). Edit the
+		// source scene and split it again instead.
+		if (WorldPartition::IsPartitionPath(scenePath) || m_ActiveWorld->GetSingleton<LevelStreamingSingleton>().IsOpen())
+		{
+			SS_CORE_WARN("Not saving '{}': a streamed world partition can't be saved; edit its source scene and split it again.", scenePath);
+			return false;
+		}
+
 		SS_CORE_INFO("Saving scene '{}'", scenePath);
 
 		if (!SceneSerializer::Serialize(*m_ActiveWorld, scenePath))
@@ -737,7 +751,7 @@ namespace Snowstorm
 				// World::ClearSceneEntities used to do inline for selection, plus the history Clear that
 				// TryLoadWorldFromFile did separately.
 				auto& sel = world->GetSingleton<EditorSelectionSingleton>();
-				sel.Selected = {};
+				sel.ClearSelection();
 				sel.GizmoActive = false;
 				world->GetSingleton<EditorHistorySingleton>().Clear();
 			};
@@ -1241,7 +1255,16 @@ namespace Snowstorm
 				// are DoNotSerialize); only scene content is restored from the snapshot. ClearSceneEntities
 				// fires OnSceneCleared, which resets selection + drops undo history.
 				m_ActiveWorld->ClearSceneEntities();
-				SceneSerializer::DeserializeFromString(*m_ActiveWorld, m_PlaySnapshot);
+				if (WorldPartition::IsPartitionPath(m_ActiveScenePath))
+				{
+					// The snapshot holds whichever cells happened to be streamed in; reopen the partition
+					// instead, so the cells go back to being streamed (play edits are discarded either way).
+					m_ActiveWorld->GetSingleton<LevelStreamingSingleton>().Open(m_ActiveScenePath);
+				}
+				else
+				{
+					SceneSerializer::DeserializeFromString(*m_ActiveWorld, m_PlaySnapshot);
+				}
 				PrewarmSceneTextures();
 				m_PlaySnapshot.clear();
 			}
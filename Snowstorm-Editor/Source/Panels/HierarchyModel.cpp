@@ -0,0 +1,209 @@
+#include "HierarchyModel.hpp"
+
+#include "Snowstorm/Components/IDComponent.hpp"
+#include "Snowstorm/Components/TagComponent.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// Below this many names a search runs inline: a worker round trip (and a frame of stale rows) costs
+		// more than matching them. Refining a query usually lands here after the first few keystrokes.
+		constexpr size_t kInlineSearchRows = 4096;
+
+		std::string ToLower(const std::string_view text)
+		{
+			std::string lower(text);
+			std::ranges::transform(lower, lower.begin(), [](const unsigned char c)
+			                       { return static_cast<char>(std::tolower(c)); });
+			return lower;
+		}
+
+		// Indices of the names containing `query`, either among `candidates` or (refine == false) all of them.
+		std::vector<uint32_t> MatchNames(const std::vector<std::string>& names, const std::string& query,
+		                                 const std::vector<uint32_t>& candidates, const bool refine)
+		{
+			std::vector<uint32_t> matches;
+			if (refine)
+			{
+				for (const uint32_t i : candidates)
+				{
+					if (names[i].find(query) != std::string::npos)
+					{
+						matches.push_back(i);
+					}
+				}
+			}
+			else
+			{
+				for (uint32_t i = 0; i < names.size(); ++i)
+				{
+					if (names[i].find(query) != std::string::npos)
+					{
+						matches.push_back(i);
+					}
+				}
+			}
+			return matches;
+		}
+	}
+
+	void HierarchyModel::SetFilter(const std::string_view text)
+	{
+		if (text == m_Filter)
+		{
+			return;
+		}
+		m_Filter.assign(text);
+		m_Query = ToLower(text);
+		m_QueryDirty = true;
+	}
+
+	std::span<const entt::entity> HierarchyModel::GetRowRange(const size_t a, const size_t b) const
+	{
+		if (m_Rows.empty())
+		{
+			return {};
+		}
+		const size_t first = std::min(std::min(a, b), m_Rows.size() - 1);
+		const size_t last = std::min(std::max(a, b), m_Rows.size() - 1);
+		return std::span<const entt::entity>(m_Rows).subspan(first, last - first + 1);
+	}
+
+	void HierarchyModel::Update(const World& world, JobSystem* jobs)
+	{
+		const TrackedRegistry& reg = world.GetRegistry();
+
+		// Did the entity set change? Everything here is O(changes this frame), except the count, which is O(1).
+		if (!m_RowsDirty)
+		{
+			m_RowsDirty = world.SceneGeneration() != m_SceneGeneration || reg.AnyDestroyedThisFrame() ||
+			              reg.view<TagComponent>().size() != m_TagCount || !reg.AddedView<TagComponent>().empty() ||
+			              !reg.RemovedView<TagComponent>().empty();
+		}
+
+		const bool rebuilt = m_RowsDirty;
+		if (m_RowsDirty)
+		{
+			RebuildRows(world);
+		}
+
+		// A finished search applies if it ran on the current names -- even for an older query: its rows are
+		// still right for that query, and the current one refines them. (Not once the search box is cleared.)
+		if (m_Search.valid() && m_Search.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+		{
+			SearchResult result = m_Search.get();
+			if (result.Names == m_Names && !m_Query.empty())
+			{
+				ApplyResult(std::move(result));
+			}
+		}
+
+		if (m_Query.empty())
+		{
+			if (rebuilt || m_QueryDirty)
+			{
+				m_Rows = m_AllRows;
+				m_AppliedNames.reset();
+				m_AppliedQuery.clear();
+				m_AppliedMatches.clear();
+			}
+			m_QueryDirty = false;
+			return; // names stay dirty until a search needs them
+		}
+		m_QueryDirty = false;
+
+		if (rebuilt)
+		{
+			// Until the new search lands, keep showing the last result -- minus entities that are gone.
+			std::erase_if(m_Rows, [&](const entt::entity e)
+			              { return !reg.valid(e); });
+		}
+
+		if (m_NamesDirty || !m_Names)
+		{
+			SnapshotNames(world);
+		}
+
+		if (!m_Search.valid() && (m_AppliedNames != m_Names || m_AppliedQuery != m_Query))
+		{
+			StartSearch(jobs);
+		}
+	}
+
+	void HierarchyModel::RebuildRows(const World& world)
+	{
+		const TrackedRegistry& reg = world.GetRegistry();
+
+		m_AllRows.clear();
+		for (const auto view = reg.view<IDComponent, TagComponent>(); const entt::entity e : view)
+		{
+			m_AllRows.push_back(e);
+		}
+
+		m_TagCount = reg.view<TagComponent>().size();
+		m_SceneGeneration = world.SceneGeneration();
+		m_RowsDirty = false;
+
+		// Indices into the old list mean nothing now: a search in flight or applied must run again.
+		m_Names.reset();
+		m_NamesDirty = true;
+	}
+
+	void HierarchyModel::SnapshotNames(const World& world)
+	{
+		const TrackedRegistry& reg = world.GetRegistry();
+
+		auto names = std::make_shared<std::vector<std::string>>();
+		names->reserve(m_AllRows.size());
+		for (const entt::entity e : m_AllRows)
+		{
+			names->push_back(ToLower(reg.Read<TagComponent>(e).Tag));
+		}
+		m_Names = std::move(names);
+		m_NamesDirty = false;
+	}
+
+	void HierarchyModel::StartSearch(JobSystem* jobs)
+	{
+		// Typing more of the same query only narrows it: look at the last matches, not the whole scene.
+		const bool refine = m_AppliedNames == m_Names && !m_AppliedQuery.empty() &&
+		                    m_Query.find(m_AppliedQuery) != std::string::npos;
+		const size_t work = refine ? m_AppliedMatches.size() : m_Names->size();
+
+		auto search = [names = m_Names, query = m_Query, candidates = refine ? m_AppliedMatches : std::vector<uint32_t>{},
+		               refine]()
+		{
+			SearchResult result;
+			result.Matches = MatchNames(*names, query, candidates, refine);
+			result.Names = names;
+			result.Query = query;
+			return result;
+		};
+
+		if (!jobs || work < kInlineSearchRows)
+		{
+			ApplyResult(search());
+			return;
+		}
+		m_Search = jobs->Submit(std::move(search));
+	}
+
+	void HierarchyModel::ApplyResult(SearchResult&& result)
+	{
+		m_Rows.clear();
+		m_Rows.reserve(result.Matches.size());
+		for (const uint32_t i : result.Matches)
+		{
+			m_Rows.push_back(m_AllRows[i]);
+		}
+		m_AppliedNames = std::move(result.Names);
+		m_AppliedQuery = std::move(result.Query);
+		m_AppliedMatches = std::move(result.Matches);
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Snowstorm/World/World.hpp"
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Snowstorm
+{
+	class JobSystem;
+
+	// The Scene Hierarchy's rows, kept between frames instead of re-walked every frame. A 100k-entity scene
+	// (StressScene with a large RotatorCount) made the old panel -- a view iteration plus a TreeNode per entity
+	// per frame -- cost more than the whole simulation; the panel now draws only the visible slice of this list
+	// (ImGuiListClipper) and this list changes only when the scene's entities do.
+	//
+	// Rows are entity handles in registry order, for every scene entity (IDComponent + TagComponent). Names
+	// are NOT cached for drawing -- the panel reads the few visible TagComponents live -- only for the search
+	// filter, whose matching runs on a JobSystem worker against a snapshot of the names.
+	//
+	// Rebuilds are driven by the TrackedRegistry's frame tracking (Tag added/removed, entities destroyed), a
+	// scene generation bump, and a count check that catches changes made outside a tracking window (e.g. after
+	// the UI phase, cleared at frame end before the panel saw them). Renames aren't visible to that without
+	// scanning ChangedView every frame -- which holds every moved entity in a busy scene -- so the panel reports
+	// them (MarkNamesDirty) from the places that rename: its rename popup and undo/redo.
+	class HierarchyModel
+	{
+	public:
+		// Bring the rows up to date with the world and pick up a finished search. Call once per frame, before
+		// drawing. `jobs` may be null: matching then runs inline.
+		void Update(const World& world, JobSystem* jobs);
+
+		// Force a rebuild of the rows (and names) on the next Update.
+		void MarkDirty() { m_RowsDirty = true; }
+
+		// Names changed but the entity set didn't: only the search needs to look again.
+		void MarkNamesDirty() { m_NamesDirty = true; }
+
+		// Case-insensitive substring search over entity names; empty shows every row. Takes effect on the next
+		// Update. A query that extends the last one only searches that one's matches.
+		void SetFilter(std::string_view text);
+		[[nodiscard]] const std::string& GetFilter() const { return m_Filter; }
+
+		// The rows to draw, in order. While a search is in flight this is the previous result (minus any
+		// entities destroyed since).
+		[[nodiscard]] std::span<const entt::entity> GetRows() const { return m_Rows; }
+
+		// Rows a..b inclusive, in either order, clamped to the list: a Shift-click range.
+		[[nodiscard]] std::span<const entt::entity> GetRowRange(size_t a, size_t b) const;
+
+		// Every scene entity, filtered or not.
+		[[nodiscard]] size_t GetTotalRowCount() const { return m_AllRows.size(); }
+
+		// A search is running on a worker (the rows are still the previous result).
+		[[nodiscard]] bool IsSearching() const { return m_Search.valid(); }
+
+	private:
+		struct SearchResult
+		{
+			std::shared_ptr<const std::vector<std::string>> Names; // the snapshot the indices refer to
+			std::string Query;
+			std::vector<uint32_t> Matches; // indices into m_AllRows, ascending
+		};
+
+		void RebuildRows(const World& world);
+		void SnapshotNames(const World& world);
+		void StartSearch(JobSystem* jobs);
+		void ApplyResult(SearchResult&& result);
+
+		std::vector<entt::entity> m_AllRows;
+		std::vector<entt::entity> m_Rows;
+
+		uint64_t m_SceneGeneration = ~0ull;
+		size_t m_TagCount = 0;
+		bool m_RowsDirty = true;
+		bool m_NamesDirty = true;
+
+		std::string m_Filter; // as typed
+		std::string m_Query;  // lower-cased m_Filter: what the rows should match
+		bool m_QueryDirty = false;
+
+		// Lower-cased names parallel to m_AllRows, taken only while a search is active. Shared with the worker,
+		// which may still be reading an old one after a rebuild.
+		std::shared_ptr<const std::vector<std::string>> m_Names;
+
+		// The newest applied search (what m_Rows shows), so a longer query can refine it.
+		std::shared_ptr<const std::vector<std::string>> m_AppliedNames;
+		std::string m_AppliedQuery;
+		std::vector<uint32_t> m_AppliedMatches;
+
+		// At most one search in flight; a query typed meanwhile starts when it lands (refining it if it can).
+		std::future<SearchResult> m_Search;
+	};
+}
@@ -3,6 +3,7 @@
 #include <imgui.h>
 #include <rttr/registration.h>
 
+#include <algorithm>
 #include <cmath>
 
 #include "SceneHierarchyPanel.hpp"
@@ -19,6 +20,8 @@
 #include "Snowstorm/Components/TransformComponent.hpp"
 #include "Snowstorm/Components/ViewportComponent.hpp"
 #include "Snowstorm/Components/VisibilityComponents.hpp"
+#include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
 #include "Snowstorm/Core/KeyCodes.hpp"
 #include "Snowstorm/Lighting/LightingComponents.hpp"
 #include "Snowstorm/Core/Log.hpp"
@@ -30,9 +33,6 @@
 #include "Singletons/EditorSelectionSingleton.hpp"
 #include "Snowstorm/Assets/AssetManagerSingleton.hpp"
 #include "MaterialInspectorPanel.hpp"
-#include "Snowstorm/World/SceneSerializer.hpp"
-
-#include <nlohmann/json.hpp>
 
 #include "Service/EditorTheme.hpp"
 
@@ -180,6 +180,9 @@ namespace Snowstorm
 	void SceneHierarchyPanel::SetContext(World* context)
 	{
 		m_World = context;
+		m_Model = HierarchyModel{};
+		m_Model.SetFilter(m_SearchBuffer);
+		m_AnchorEntity = entt::null;
 		SetSelected({});
 	}
 
@@ -224,14 +227,17 @@ namespace Snowstorm
 
 		auto& cmds = m_World->GetSingleton<EditorCommandsSingleton>();
 
-		// Delete key removes the selected entity (same deferred path as the right-click Delete). Gated
+		// Delete key removes the selected entities (same deferred path as the right-click Delete). Gated
 		// on the keyboard not being captured (e.g. a rename field) so typing never deletes.
 		if (const auto& input = m_World->GetSingleton<InputStateSingleton>();
 		    input.PressedThisFrame.test(Key::Delete) && !input.WantTextInput)
 		{
-			if (const Entity sel = GetSelected(); sel && IsDeletable(sel))
+			for (const entt::entity e : m_World->GetSingleton<EditorSelectionSingleton>().Selection)
 			{
-				m_PendingDelete = sel;
+				if (const Entity sel{e, m_World}; m_World->GetRegistry().valid(e) && IsDeletable(sel))
+				{
+					m_PendingDeletes.push_back(sel);
+				}
 			}
 		}
 
@@ -356,13 +362,54 @@ namespace Snowstorm
 		}
 		ImGui::Separator();
 
-		// Only entities that are part of the scene model
-		auto view = m_World->GetRegistry().view<IDComponent, TagComponent>();
+		// Undo/redo may have renamed something the search has cached.
+		if (const uint64_t revision = m_World->GetSingleton<EditorHistorySingleton>().GetRevision();
+		    revision != m_HistoryRevision)
+		{
+			m_HistoryRevision = revision;
+			m_Model.MarkNamesDirty();
+		}
+
+		ImGui::SetNextItemWidth(-FLT_MIN);
+		if (ImGui::InputTextWithHint("##hierarchy_search", "Search", m_SearchBuffer, sizeof(m_SearchBuffer)))
+		{
+			m_Model.SetFilter(m_SearchBuffer);
+		}
+
+		JobSystem* jobs = nullptr;
+		if (auto& services = Application::Get().GetServiceManager(); services.ServiceRegistered<JobSystem>())
+		{
+			jobs = &services.GetService<JobSystem>();
+		}
+		m_Model.Update(*m_World, jobs);
+
+		// Only the rows in view are submitted: the clipper skips the rest with one Dummy-sized gap, so the cost
+		// is the visible rows, not the scene's entity count (scrolling and the scrollbar still cover every row).
+		const std::span<const entt::entity> rows = m_Model.GetRows();
+		if (!m_Model.GetFilter().empty())
+		{
+			ImGui::TextDisabled("%zu of %zu%s", rows.size(), m_Model.GetTotalRowCount(),
+			                    m_Model.IsSearching() ? "  (searching...)" : "");
+		}
 
-		for (const entt::entity e : view)
+		const auto& reg = m_World->GetRegistry();
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(rows.size()));
+		while (clipper.Step())
 		{
-			Entity entity{e, m_World};
-			DrawEntityNode(entity);
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+			{
+				const entt::entity e = rows[static_cast<size_t>(i)];
+				if (!reg.valid(e) || !reg.all_of<IDComponent, TagComponent>(e))
+				{
+					// Gone since the rows were built (destroyed outside a tracking window): keep the row's
+					// height so the clipper's layout holds, and rebuild next frame.
+					ImGui::Dummy(ImVec2(0.0f, ImGui::GetTextLineHeightWithSpacing()));
+					m_Model.MarkDirty();
+					continue;
+				}
+				DrawEntityNode(Entity{e, m_World}, static_cast<size_t>(i));
+			}
 		}
 
 		// Right-click empty hierarchy space -> the same Create menu (Unity/Unreal both do this). Window
@@ -395,22 +442,32 @@ namespace Snowstorm
 			}
 			m_PendingDuplicate = {};
 		}
-		if (m_PendingDelete)
+		if (!m_PendingDeletes.empty() && cmds.DeleteEntity)
 		{
-			if (GetSelected() == m_PendingDelete)
+			// m_PendingDeletes holds each entity once: the Delete key queues the (unique) selection set and the
+			// context menu skips an entity already queued.
+			std::vector<UUID> uuids;
+			uuids.reserve(m_PendingDeletes.size());
+			for (const Entity pending : m_PendingDeletes)
 			{
-				SetSelected({});
+				uuids.push_back(pending.GetComponent<IDComponent>().Id);
 			}
-			// Snapshot before destroying so the delete can be undone (restores same UUID/identity).
-			nlohmann::json snapshot;
-			const UUID uuid = m_PendingDelete.GetComponent<IDComponent>().Id;
-			if (SceneSerializer::SerializeEntity(m_PendingDelete, snapshot) && cmds.DeleteEntity)
+
+			// Snapshot them all before destroying so the delete can be undone (restores same UUIDs/identities).
+			// One undo step for the whole batch: deleting a multi-selection comes back with a single Ctrl+Z.
+			std::vector<uint8_t> snapshot = DeleteEntityCommand::CaptureEntities(m_PendingDeletes);
+			auto& selection = m_World->GetSingleton<EditorSelectionSingleton>();
+			for (const Entity entity : m_PendingDeletes)
 			{
-				cmds.DeleteEntity(m_PendingDelete); // deferred destroy at end of frame
-				history.Push(CreateRef<DeleteEntityCommand>(uuid, std::move(snapshot)));
+				if (selection.IsSelected(entity))
+				{
+					selection.ClearSelection();
+				}
+				cmds.DeleteEntity(entity); // deferred destroy at end of frame
 			}
-			m_PendingDelete = {};
+			history.Push(CreateRef<DeleteEntityCommand>(std::move(uuids), std::move(snapshot)));
 		}
+		m_PendingDeletes.clear();
 
 		// Rename modal (opened from the context menu).
 		if (m_OpenRenamePopup)
@@ -432,6 +489,7 @@ namespace Snowstorm
 					m_RenameTarget.WriteComponent<TagComponent>().Tag = after;
 					m_World->GetSingleton<EditorHistorySingleton>().Push(
 					    CreateRef<RenameCommand>(m_RenameTarget.GetComponent<IDComponent>().Id, before, after));
+					m_Model.MarkNamesDirty();
 				}
 				m_RenameTarget = {};
 				ImGui::CloseCurrentPopup();
@@ -449,6 +507,12 @@ namespace Snowstorm
 		EditorTheme::SectionHeader("Properties");
 		if (const Entity selected = GetSelected())
 		{
+			// With several selected, the inspector edits the primary one (the last clicked).
+			if (const size_t count = m_World->GetSingleton<EditorSelectionSingleton>().Selection.size(); count > 1)
+			{
+				ImGui::TextDisabled("%zu entities selected -- showing %s", count,
+				                    selected.GetComponent<TagComponent>().Tag.c_str());
+			}
 			DrawComponents(selected);
 		}
 		else if (const auto& sel = m_World->GetSingleton<EditorSelectionSingleton>();
@@ -468,18 +532,44 @@ namespace Snowstorm
 		FlushComponentRemovals();
 	}
 
-	void SceneHierarchyPanel::DrawEntityNode(Entity entity)
+	void SceneHierarchyPanel::DrawEntityNode(Entity entity, const size_t row)
 	{
 		const auto& tag = entity.GetComponent<TagComponent>().Tag;
+		auto& selection = m_World->GetSingleton<EditorSelectionSingleton>();
 
-		ImGuiTreeNodeFlags flags = ((GetSelected() == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_Leaf;
+		ImGuiTreeNodeFlags flags = (selection.IsSelected(entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_Leaf;
 
 		const bool opened = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<uintptr_t>(static_cast<uint32_t>(entity))),
 		                                      flags,
 		                                      "%s", tag.c_str());
 		if (ImGui::IsItemClicked())
 		{
-			SetSelected(entity);
+			// Shift: the rows from the anchor to here (added to the selection with Ctrl held). Ctrl: toggle this
+			// one. The range is a slice of the cached rows, so it costs its own length, not the scene's.
+			const ImGuiIO& io = ImGui::GetIO();
+			const std::span<const entt::entity> rows = m_Model.GetRows();
+			const bool anchored = m_AnchorRow < rows.size() && rows[m_AnchorRow] == m_AnchorEntity;
+			if (io.KeyShift && anchored)
+			{
+				if (!io.KeyCtrl)
+				{
+					selection.ClearSelection();
+				}
+				selection.AddEntities(m_Model.GetRowRange(m_AnchorRow, row), entity);
+			}
+			else
+			{
+				if (io.KeyCtrl)
+				{
+					selection.ToggleEntity(entity);
+				}
+				else
+				{
+					SetSelected(entity);
+				}
+				m_AnchorRow = row;
+				m_AnchorEntity = entity.Handle();
+			}
 		}
 
 		// Double-click focuses the camera on the entity (same as pressing F with it selected).
@@ -492,7 +582,10 @@ namespace Snowstorm
 		// Per-entity context menu: Rename / Duplicate / Delete (deferred to avoid view invalidation).
 		if (ImGui::BeginPopupContextItem())
 		{
-			SetSelected(entity);
+			if (!selection.IsSelected(entity))
+			{
+				SetSelected(entity);
+			}
 			if (ImGui::MenuItem("Rename"))
 			{
 				m_RenameTarget = entity;
@@ -507,7 +600,10 @@ namespace Snowstorm
 			// Structural entities (viewport, cameras) can't be deleted — show the item disabled.
 			if (ImGui::MenuItem("Delete", nullptr, false, IsDeletable(entity)))
 			{
-				m_PendingDelete = entity;
+				if (std::ranges::find(m_PendingDeletes, entity) == m_PendingDeletes.end())
+				{
+					m_PendingDeletes.push_back(entity);
+				}
 			}
 			ImGui::EndPopup();
 		}
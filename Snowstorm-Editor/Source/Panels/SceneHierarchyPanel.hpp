@@ -1,8 +1,12 @@
 #pragma once
 
+#include "HierarchyModel.hpp"
+
 #include "Snowstorm/World/World.hpp"
 #include "Snowstorm/World/Entity.hpp"
 
+#include <vector>
+
 namespace Snowstorm
 {
 	class SceneHierarchyPanel
@@ -16,7 +20,8 @@ namespace Snowstorm
 		void OnImGuiRender();
 
 	private:
-		void DrawEntityNode(Entity entity);
+		// `row` is the entity's index in m_Model's rows (the Shift-click range anchor).
+		void DrawEntityNode(Entity entity, size_t row);
 
 		static void DrawComponents(Entity entity);
 
@@ -28,8 +33,18 @@ namespace Snowstorm
 
 		World* m_World{};
 
+		// Cached, filtered rows; only the visible ones are drawn each frame.
+		HierarchyModel m_Model;
+		char m_SearchBuffer[128] = {};
+		uint64_t m_HistoryRevision = 0;
+
+		// Where the last plain/Ctrl click landed: a Shift-click selects the rows between it and the click.
+		// The entity is kept too, so a filter change that moved the row reads as "no anchor".
+		size_t m_AnchorRow = 0;
+		entt::entity m_AnchorEntity = entt::null;
+
 		// Deferred per-frame actions so we never mutate the ECS while iterating the hierarchy view.
-		Entity m_PendingDelete;
+		std::vector<Entity> m_PendingDeletes;
 		Entity m_PendingDuplicate;
 		Entity m_RenameTarget;
 		char m_RenameBuffer[256] = {};
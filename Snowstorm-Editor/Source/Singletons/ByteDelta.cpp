@@ -0,0 +1,146 @@
+#include "ByteDelta.hpp"
+
+#include "Snowstorm/Core/Base.hpp"
+
+#include <algorithm>
+
+namespace Snowstorm
+{
+	namespace
+	{
+		// A run header is two varints (2 bytes for any component-sized value), so an unchanged gap shorter
+		// than that costs more to skip than to store twice.
+		constexpr size_t kMinGap = 2;
+
+		void WriteVarint(std::vector<uint8_t>& out, size_t value)
+		{
+			while (value >= 0x80)
+			{
+				out.push_back(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			out.push_back(static_cast<uint8_t>(value));
+		}
+
+		size_t ReadVarint(const uint8_t*& cursor)
+		{
+			size_t value = 0;
+			for (uint32_t shift = 0;; shift += 7)
+			{
+				const uint8_t byte = *cursor++;
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+				{
+					return value;
+				}
+			}
+		}
+	}
+
+	ByteDelta ByteDelta::Diff(const std::span<const uint8_t> before, const std::span<const uint8_t> after)
+	{
+		return Diff(before, after, nullptr);
+	}
+
+	ByteDelta ByteDelta::Diff(const std::span<const uint8_t> before, const std::span<const uint8_t> after, const uint8_t* known)
+	{
+		SS_CORE_ASSERT(before.size() == after.size(), "ByteDelta::Diff of differently sized values");
+
+		ByteDelta delta;
+		const size_t n = std::min(before.size(), after.size());
+		delta.m_ValueSize = static_cast<uint32_t>(n);
+
+		size_t previousEnd = 0;
+		size_t i = 0;
+		while (i < n)
+		{
+			if (before[i] == after[i])
+			{
+				++i;
+				continue;
+			}
+
+			// Extend the run over differing bytes, and across gaps too short to be worth a new header.
+			size_t end = i + 1;
+			for (;;)
+			{
+				while (end < n && before[end] != after[end])
+				{
+					++end;
+				}
+				size_t next = end;
+				while (next < n && next - end < kMinGap && before[next] == after[next] && (!known || known[next]))
+				{
+					++next;
+				}
+				if (next == n || next - end >= kMinGap || before[next] == after[next])
+				{
+					break;
+				}
+				end = next;
+			}
+
+			WriteVarint(delta.m_Runs, i - previousEnd);
+			WriteVarint(delta.m_Runs, end - i);
+			delta.m_Runs.insert(delta.m_Runs.end(), before.begin() + static_cast<std::ptrdiff_t>(i), before.begin() + static_cast<std::ptrdiff_t>(end));
+			delta.m_Runs.insert(delta.m_Runs.end(), after.begin() + static_cast<std::ptrdiff_t>(i), after.begin() + static_cast<std::ptrdiff_t>(end));
+			previousEnd = end;
+			i = end;
+		}
+
+		delta.m_Runs.shrink_to_fit();
+		return delta;
+	}
+
+	ByteDelta ByteDelta::Merge(const ByteDelta& first, const ByteDelta& second)
+	{
+		SS_CORE_ASSERT(first.m_ValueSize == second.m_ValueSize, "ByteDelta::Merge of deltas of different values");
+
+		// Rebuild both ends over the union of the runs (everything else is unknown: zero on both sides, so it
+		// diffs away, and never folded into a run): the original value is `first`'s before, or `second`'s
+		// where only it changed; the final value is `second`'s after, or `first`'s where only it changed.
+		std::vector<uint8_t> from(first.m_ValueSize, 0);
+		std::vector<uint8_t> to(first.m_ValueSize, 0);
+		std::vector<uint8_t> known(first.m_ValueSize, 0);
+		second.ApplyBefore(from);
+		first.ApplyBefore(from);
+		first.ApplyAfter(to);
+		second.ApplyAfter(to);
+		first.MarkRuns(known);
+		second.MarkRuns(known);
+		return Diff(from, to, known.data());
+	}
+
+	void ByteDelta::Apply(const std::span<uint8_t> value, const bool after) const
+	{
+		SS_CORE_ASSERT(value.size() == m_ValueSize, "ByteDelta applied to a differently sized value");
+
+		const uint8_t* cursor = m_Runs.data();
+		const uint8_t* const end = cursor + m_Runs.size();
+		size_t offset = 0;
+		while (cursor < end)
+		{
+			offset += ReadVarint(cursor);
+			const size_t length = ReadVarint(cursor);
+			const uint8_t* source = after ? cursor + length : cursor;
+			std::copy_n(source, length, value.begin() + static_cast<std::ptrdiff_t>(offset));
+			offset += length;
+			cursor += 2 * length;
+		}
+	}
+
+	void ByteDelta::MarkRuns(const std::span<uint8_t> known) const
+	{
+		const uint8_t* cursor = m_Runs.data();
+		const uint8_t* const end = cursor + m_Runs.size();
+		size_t offset = 0;
+		while (cursor < end)
+		{
+			offset += ReadVarint(cursor);
+			const size_t length = ReadVarint(cursor);
+			std::fill_n(known.begin() + static_cast<std::ptrdiff_t>(offset), length, uint8_t{1});
+			offset += length;
+			cursor += 2 * length;
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Snowstorm
+{
+	// The difference between two same-sized byte images of a value (a trivially copyable component), for the
+	// undo history. Only the changed runs are kept, each with its before AND after bytes, so one delta both
+	// reverts and re-applies, in time proportional to the changed bytes -- a drag that moves Position stores
+	// 2x12 bytes + a 2-byte run header per entity, not the whole component twice.
+	//
+	// Runs write absolute bytes rather than XOR masks: a component that something else also wrote since the
+	// edit (an animation on an unselected axis) still ends up with exactly the recorded value, never a garbled
+	// mix. Unchanged gaps shorter than a run header are folded into the surrounding run.
+	class ByteDelta
+	{
+	public:
+		ByteDelta() = default;
+
+		[[nodiscard]] static ByteDelta Diff(std::span<const uint8_t> before, std::span<const uint8_t> after);
+
+		// The delta of `first` followed by `second` (both of the same value): bytes the pair changed back to
+		// their original value drop out.
+		[[nodiscard]] static ByteDelta Merge(const ByteDelta& first, const ByteDelta& second);
+
+		// Overwrite the changed runs of `value` with their before / after bytes.
+		void ApplyBefore(std::span<uint8_t> value) const { Apply(value, false); }
+		void ApplyAfter(std::span<uint8_t> value) const { Apply(value, true); }
+
+		[[nodiscard]] bool IsEmpty() const { return m_Runs.empty(); }
+		[[nodiscard]] size_t GetValueSize() const { return m_ValueSize; }
+		[[nodiscard]] size_t GetMemoryBytes() const { return sizeof(ByteDelta) + m_Runs.capacity(); }
+
+	private:
+		// `known` (optional, one flag per byte) limits gap folding to bytes whose value is actually known;
+		// Merge rebuilds only part of each value.
+		static ByteDelta Diff(std::span<const uint8_t> before, std::span<const uint8_t> after, const uint8_t* known);
+
+		void Apply(std::span<uint8_t> value, bool after) const;
+		void MarkRuns(std::span<uint8_t> known) const;
+
+		// Per run: varint gap since the previous run's end, varint length, `length` before bytes, `length`
+		// after bytes.
+		std::vector<uint8_t> m_Runs;
+		uint32_t m_ValueSize = 0;
+	};
+
+	template <typename T>
+	std::span<const uint8_t> AsBytes(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Byte deltas need a trivially copyable type");
+		return {reinterpret_cast<const uint8_t*>(&value), sizeof(T)};
+	}
+
+	template <typename T>
+	std::span<uint8_t> AsWritableBytes(T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Byte deltas need a trivially copyable type");
+		return {reinterpret_cast<uint8_t*>(&value), sizeof(T)};
+	}
+}
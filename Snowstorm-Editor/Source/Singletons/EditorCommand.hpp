@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace Snowstorm
 {
 	class World;
@@ -19,5 +21,13 @@ namespace Snowstorm
 
 		// Short human-readable label (for the Edit menu / tooltips), e.g. "Move", "Create Entity".
 		[[nodiscard]] virtual const char* Name() const = 0;
+
+		// Heap + object bytes this command holds, for EditorHistorySingleton's memory budget. May grow after
+		// Push (a create command snapshots its entity on Undo), so the history re-reads it on every move.
+		[[nodiscard]] virtual size_t GetMemoryBytes() const = 0;
+
+		// Fold `next` (pushed right after this one, and already applied) into this command, so one Undo
+		// reverts both. False leaves both untouched and `next` becomes its own step.
+		virtual bool TryMerge(const EditorCommand& /*next*/) { return false; }
 	};
 }
@@ -1,36 +1,96 @@
 #include "EditorCommands.hpp"
 
 #include "Snowstorm/Components/ComponentRegistry.hpp"
+#include "Snowstorm/Components/IDComponent.hpp"
 #include "Snowstorm/Components/TagComponent.hpp"
 #include "Snowstorm/Utility/JsonUtils.hpp"
 #include "Snowstorm/World/Entity.hpp"
-#include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/SceneBinarySerializer.hpp"
 #include "Snowstorm/World/World.hpp"
 
 #include <algorithm>
 
 namespace Snowstorm
 {
-	// ---- TransformCommand ----------------------------------------------------------------------------
+	// ---- ComponentDeltaCommand ---------------------------------------------------------------------
 
-	void TransformCommand::Undo(World& world)
+	namespace
 	{
-		Entity e = world.FindEntityByUUID(m_Target);
-		if (e && e.HasComponent<TransformComponent>())
+		bool ByTarget(const ComponentDeltaCommand::EntityDelta& a, const ComponentDeltaCommand::EntityDelta& b)
 		{
-			e.PatchComponent<TransformComponent>([&](TransformComponent& t)
-			                                     { t = m_Before; });
+			return a.Target.Value() < b.Target.Value();
 		}
 	}
 
-	void TransformCommand::Redo(World& world)
+	ComponentDeltaCommand::ComponentDeltaCommand(const char* label, const ApplyFn apply, std::vector<EntityDelta> entities, const bool coalesce)
+	    : m_Label(label), m_Apply(apply), m_Entities(std::move(entities)), m_Coalesce(coalesce), m_LastEdit(std::chrono::steady_clock::now())
 	{
-		Entity e = world.FindEntityByUUID(m_Target);
-		if (e && e.HasComponent<TransformComponent>())
+		std::ranges::sort(m_Entities, ByTarget);
+	}
+
+	void ComponentDeltaCommand::Apply(World& world, const bool after)
+	{
+		if (m_Entities.size() == 1)
 		{
-			e.PatchComponent<TransformComponent>([&](TransformComponent& t)
-			                                     { t = m_After; });
+			if (Entity e = world.FindEntityByUUID(m_Entities.front().Target))
+			{
+				m_Apply(e, m_Entities.front().Delta, after);
+			}
+			return;
 		}
+
+		// FindEntityByUUID walks the scene, so resolving thousands of targets one by one is quadratic. Walk it
+		// once instead and look each entity up in the (sorted) targets.
+		auto& reg = world.GetRegistry();
+		for (const auto view = reg.view<IDComponent>(); const entt::entity handle : view)
+		{
+			const EntityDelta probe{reg.Read<IDComponent>(handle).Id, {}};
+			const auto found = std::ranges::lower_bound(m_Entities, probe, ByTarget);
+			if (found != m_Entities.end() && found->Target == probe.Target)
+			{
+				m_Apply(Entity{handle, &world}, found->Delta, after);
+			}
+		}
+	}
+
+	size_t ComponentDeltaCommand::GetMemoryBytes() const
+	{
+		size_t bytes = sizeof(*this) + m_Entities.capacity() * sizeof(EntityDelta);
+		for (const EntityDelta& entity : m_Entities)
+		{
+			bytes += entity.Delta.GetMemoryBytes() - sizeof(ByteDelta); // the struct itself is counted above
+		}
+		return bytes;
+	}
+
+	bool ComponentDeltaCommand::TryMerge(const EditorCommand& next)
+	{
+		const auto* other = dynamic_cast<const ComponentDeltaCommand*>(&next);
+		if (!other || !m_Coalesce || !other->m_Coalesce || other->m_Apply != m_Apply ||
+		    other->m_LastEdit - m_LastEdit > kCoalesceWindow || other->m_Entities.size() != m_Entities.size())
+		{
+			return false;
+		}
+		// Both are sorted by target, so the same selection lines up entry by entry.
+		for (size_t i = 0; i < m_Entities.size(); ++i)
+		{
+			if (m_Entities[i].Target != other->m_Entities[i].Target)
+			{
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < m_Entities.size(); ++i)
+		{
+			m_Entities[i].Delta = ByteDelta::Merge(m_Entities[i].Delta, other->m_Entities[i].Delta);
+		}
+		m_LastEdit = other->m_LastEdit;
+		return true;
+	}
+
+	TransformCommand::TransformCommand(const UUID target, const TransformComponent& before, const TransformComponent& after)
+	    : ComponentDeltaCommand("Move", &ApplyTo<TransformComponent>, {{target, ByteDelta::Diff(AsBytes(before), AsBytes(after))}}, true)
+	{
 	}
 
 	// ---- AddEntityCommand (create / duplicate) -------------------------------------------------------
@@ -44,40 +104,112 @@ namespace Snowstorm
 		}
 
 		// Snapshot the full entity so Redo can bring it back exactly as it is now.
-		SceneSerializer::SerializeEntity(e, m_Snapshot);
+		m_Snapshot = DeleteEntityCommand::CaptureEntity(e);
 		world.DestroyEntity(e);
 	}
 
 	void AddEntityCommand::Redo(World& world)
 	{
-		if (m_Snapshot.is_null())
+		if (m_Snapshot.empty())
 		{
 			return; // first Redo after a normal Push never happens (the create already applied)
 		}
-		SceneSerializer::DeserializeEntity(world, m_Snapshot);
+		SceneBinarySerializer::DeserializeFromBytes(world, m_Snapshot);
 	}
 
 	// ---- DeleteEntityCommand -------------------------------------------------------------------------
 
+	DeleteEntityCommand::DeleteEntityCommand(std::vector<UUID> targets, std::vector<uint8_t> snapshot)
+	    : m_Targets(std::move(targets)), m_Snapshot(std::move(snapshot))
+	{
+		std::ranges::sort(m_Targets, {}, &UUID::Value);
+	}
+
+	std::vector<uint8_t> DeleteEntityCommand::CaptureEntity(const Entity entity)
+	{
+		return CaptureEntities(std::span(&entity, 1));
+	}
+
+	std::vector<uint8_t> DeleteEntityCommand::CaptureEntities(const std::span<const Entity> entities)
+	{
+		return SceneBinarySerializer::SerializeEntitiesToBytes(entities);
+	}
+
 	void DeleteEntityCommand::Undo(World& world)
 	{
-		if (!m_Snapshot.is_null())
+		if (!m_Snapshot.empty())
 		{
-			SceneSerializer::DeserializeEntity(world, m_Snapshot);
+			SceneBinarySerializer::DeserializeFromBytes(world, m_Snapshot);
 		}
 	}
 
 	void DeleteEntityCommand::Redo(World& world)
 	{
-		Entity e = world.FindEntityByUUID(m_Target);
-		if (e)
+		if (m_Targets.size() == 1)
 		{
-			world.DestroyEntity(e);
+			if (Entity e = world.FindEntityByUUID(m_Targets.front()))
+			{
+				world.DestroyEntity(e);
+			}
+			return;
+		}
+
+		// Same single pass as ComponentDeltaCommand::Apply: one walk of the scene against the sorted targets
+		// instead of a FindEntityByUUID scan per target. Collected first, destroyed after the walk.
+		auto& reg = world.GetRegistry();
+		std::vector<entt::entity> doomed;
+		doomed.reserve(m_Targets.size());
+		for (const auto view = reg.view<IDComponent>(); const entt::entity handle : view)
+		{
+			const uint64_t id = reg.Read<IDComponent>(handle).Id.Value();
+			if (const auto found = std::ranges::lower_bound(m_Targets, id, {}, &UUID::Value);
+			    found != m_Targets.end() && found->Value() == id)
+			{
+				doomed.push_back(handle);
+			}
+		}
+		for (const entt::entity handle : doomed)
+		{
+			world.DestroyEntity(Entity{handle, &world});
 		}
 	}
 
 	// ---- ComponentEditCommand ------------------------------------------------------------------------
 
+	ComponentEditCommand::ComponentEditCommand(const UUID target, std::string typeName, const nlohmann::json& before, const nlohmann::json& after)
+	    : m_Target(target), m_TypeName(std::move(typeName))
+	{
+		if (!before.is_object() || !after.is_object())
+		{
+			m_Before = before;
+			m_After = after;
+		}
+		else
+		{
+			// A field only one side has can't be put back by leaving it out, so it's kept too (the other side
+			// simply lacks it, exactly as the full snapshots did).
+			m_Before = nlohmann::json::object();
+			m_After = nlohmann::json::object();
+			for (const auto& [key, value] : before.items())
+			{
+				const auto other = after.find(key);
+				if (other == after.end() || *other != value)
+				{
+					m_Before[key] = value;
+				}
+			}
+			for (const auto& [key, value] : after.items())
+			{
+				const auto other = before.find(key);
+				if (other == before.end() || *other != value)
+				{
+					m_After[key] = value;
+				}
+			}
+		}
+		m_FieldBytes = m_Before.dump().size() + m_After.dump().size();
+	}
+
 	void ComponentEditCommand::Apply(World& world, const nlohmann::json& state)
 	{
 		Entity e = world.FindEntityByUUID(m_Target);
@@ -1,34 +1,107 @@
 #pragma once
 
 #include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Core/Base.hpp"
 #include "Snowstorm/Utility/UUID.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Singletons/ByteDelta.hpp"
 #include "Singletons/EditorCommand.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <nlohmann/json.hpp>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace Snowstorm
 {
-	class Entity;
-
-	// Move/rotate/scale a single entity. Records before/after TransformComponent; the live edit is
-	// applied at the call site (the gizmo writes each frame), so Push records "after" without re-applying.
-	class TransformCommand final : public EditorCommand
+	// An edit of one trivially copyable component type on any number of entities (a gizmo drag, a bulk tool),
+	// stored as one ByteDelta per entity -- only the bytes that changed. Undo/Redo resolve every target in
+	// one pass over the scene instead of a UUID search per entity, then patch just the changed runs.
+	//
+	// A coalescing command absorbs the next one of the same kind on the same entities when it follows within
+	// kCoalesceWindow (successive nudges of one selection read as one move), so the history holds one step
+	// for them and Undo jumps back over all of them.
+	class ComponentDeltaCommand : public EditorCommand
 	{
 	public:
-		TransformCommand(UUID target, const TransformComponent& before, const TransformComponent& after)
-		    : m_Target(target), m_Before(before), m_After(after)
+		static constexpr std::chrono::milliseconds kCoalesceWindow{750};
+
+		using ApplyFn = void (*)(Entity entity, const ByteDelta& delta, bool after);
+
+		struct EntityDelta
 		{
-		}
+			UUID Target;
+			ByteDelta Delta;
+		};
 
-		void Undo(World& world) override;
-		void Redo(World& world) override;
-		[[nodiscard]] const char* Name() const override { return "Move"; }
+		ComponentDeltaCommand(const char* label, ApplyFn apply, std::vector<EntityDelta> entities, bool coalesce);
+
+		// `before[i]` / `after[i]` are `targets[i]`'s component before and after the (already applied) edit.
+		// Unchanged entities are left out; null when nothing changed at all (Push ignores null).
+		template <typename T>
+		[[nodiscard]] static Ref<ComponentDeltaCommand> Create(const char* label, std::span<const UUID> targets, std::span<const T> before,
+		                                                       std::span<const T> after, bool coalesce = false);
+
+		void Undo(World& world) override { Apply(world, false); }
+		void Redo(World& world) override { Apply(world, true); }
+		[[nodiscard]] const char* Name() const override { return m_Label; }
+		[[nodiscard]] size_t GetMemoryBytes() const override;
+		bool TryMerge(const EditorCommand& next) override;
+
+		[[nodiscard]] size_t GetEntityCount() const { return m_Entities.size(); }
+
+		template <typename T>
+		static void ApplyTo(Entity entity, const ByteDelta& delta, const bool after)
+		{
+			if (!entity.HasComponent<T>())
+			{
+				return;
+			}
+			entity.PatchComponent<T>([&](T& component)
+			                         { after ? delta.ApplyAfter(AsWritableBytes(component)) : delta.ApplyBefore(AsWritableBytes(component)); });
+		}
 
 	private:
-		UUID m_Target;
-		TransformComponent m_Before;
-		TransformComponent m_After;
+		void Apply(World& world, bool after);
+
+		const char* m_Label;
+		ApplyFn m_Apply;
+		std::vector<EntityDelta> m_Entities; // sorted by UUID
+		bool m_Coalesce;
+		std::chrono::steady_clock::time_point m_LastEdit;
+	};
+
+	template <typename T>
+	Ref<ComponentDeltaCommand> ComponentDeltaCommand::Create(const char* label, const std::span<const UUID> targets, const std::span<const T> before,
+	                                                         const std::span<const T> after, const bool coalesce)
+	{
+		SS_CORE_ASSERT(targets.size() == before.size() && targets.size() == after.size(), "ComponentDeltaCommand: mismatched spans");
+
+		std::vector<EntityDelta> entities;
+		entities.reserve(targets.size());
+		for (size_t i = 0; i < targets.size(); ++i)
+		{
+			ByteDelta delta = ByteDelta::Diff(AsBytes(before[i]), AsBytes(after[i]));
+			if (!delta.IsEmpty())
+			{
+				entities.push_back({targets[i], std::move(delta)});
+			}
+		}
+		if (entities.empty())
+		{
+			return nullptr;
+		}
+		return CreateRef<ComponentDeltaCommand>(label, &ApplyTo<T>, std::move(entities), coalesce);
+	}
+
+	// Move/rotate/scale a single entity -- the gizmo's command. Coalesces with the next move of the same
+	// entity (see ComponentDeltaCommand).
+	class TransformCommand final : public ComponentDeltaCommand
+	{
+	public:
+		TransformCommand(UUID target, const TransformComponent& before, const TransformComponent& after);
 	};
 
 	// An entity that now exists because the user created or duplicated it. Undo removes it (snapshotting
@@ -45,48 +118,63 @@ namespace Snowstorm
 		void Undo(World& world) override;
 		void Redo(World& world) override;
 		[[nodiscard]] const char* Name() const override { return m_Label; }
+		[[nodiscard]] size_t GetMemoryBytes() const override { return sizeof(*this) + m_Snapshot.capacity(); }
 
 	private:
 		UUID m_Target;
 		const char* m_Label;
-		nlohmann::json m_Snapshot; // captured on Undo so Redo can restore the full entity
+		std::vector<uint8_t> m_Snapshot; // binary scene of the entity, captured on Undo so Redo can restore it
 	};
 
-	// Deletion of an entity. The snapshot is captured at construction (before the entity is destroyed at
-	// the call site). Undo restores it (same UUID/identity); Redo destroys it again.
+	// Deletion of one or more entities as one step: deleting a multi-selection is undone by a single Undo.
+	// The snapshot (CaptureEntity / CaptureEntities) is taken before the entities are destroyed at the call
+	// site. Undo restores them all (same UUIDs/identities); Redo destroys them again.
 	class DeleteEntityCommand final : public EditorCommand
 	{
 	public:
-		DeleteEntityCommand(UUID target, nlohmann::json snapshot)
-		    : m_Target(target), m_Snapshot(std::move(snapshot))
+		DeleteEntityCommand(UUID target, std::vector<uint8_t> snapshot)
+		    : m_Targets{target}, m_Snapshot(std::move(snapshot))
 		{
 		}
 
+		DeleteEntityCommand(std::vector<UUID> targets, std::vector<uint8_t> snapshot);
+
 		void Undo(World& world) override;
 		void Redo(World& world) override;
-		[[nodiscard]] const char* Name() const override { return "Delete Entity"; }
+		[[nodiscard]] const char* Name() const override { return m_Targets.size() == 1 ? "Delete Entity" : "Delete Entities"; }
+		[[nodiscard]] size_t GetMemoryBytes() const override
+		{
+			return sizeof(*this) + m_Targets.capacity() * sizeof(UUID) + m_Snapshot.capacity();
+		}
+
+		// Entities as one binary scene (SceneBinarySerializer): every serializable component, without the
+		// JSON tree a SceneSerializer snapshot allocates. A batch shares one string table and one set of chunks.
+		[[nodiscard]] static std::vector<uint8_t> CaptureEntity(Entity entity);
+		[[nodiscard]] static std::vector<uint8_t> CaptureEntities(std::span<const Entity> entities);
 
 	private:
-		UUID m_Target;
-		nlohmann::json m_Snapshot;
+		std::vector<UUID> m_Targets; // sorted by value
+		std::vector<uint8_t> m_Snapshot;
 	};
 
-	// A generic inspector edit of one component on one entity. Stores the component's serialized JSON
-	// before and after the edit, and applies whichever side by deserializing it onto the live component.
-	// Used for property edits (RTTR) where capturing typed before/after per property would be unwieldy;
-	// the whole-component snapshot is small and type-agnostic. A continuous drag is coalesced into one
-	// command at the inspector call site (push on edit-end, before captured on edit-begin).
+	// A generic inspector edit of one component on one entity, for property edits (RTTR) where a typed
+	// before/after would be unwieldy. Takes the component's serialized JSON before and after the edit but
+	// keeps only the top-level fields that differ: applying writes just those onto the live component, and
+	// the untouched rest of a big component costs nothing. A continuous drag is coalesced into one command
+	// at the inspector call site (push on edit-end, before captured on edit-begin).
 	class ComponentEditCommand final : public EditorCommand
 	{
 	public:
-		ComponentEditCommand(UUID target, std::string typeName, nlohmann::json before, nlohmann::json after)
-		    : m_Target(target), m_TypeName(std::move(typeName)), m_Before(std::move(before)), m_After(std::move(after))
-		{
-		}
+		ComponentEditCommand(UUID target, std::string typeName, const nlohmann::json& before, const nlohmann::json& after);
 
 		void Undo(World& world) override;
 		void Redo(World& world) override;
 		[[nodiscard]] const char* Name() const override { return "Edit"; }
+		[[nodiscard]] size_t GetMemoryBytes() const override { return sizeof(*this) + m_TypeName.capacity() + m_FieldBytes; }
+
+		// The fields kept (same keys in both); empty when nothing changed.
+		[[nodiscard]] const nlohmann::json& GetBefore() const { return m_Before; }
+		[[nodiscard]] const nlohmann::json& GetAfter() const { return m_After; }
 
 	private:
 		void Apply(World& world, const nlohmann::json& state);
@@ -95,6 +183,7 @@ namespace Snowstorm
 		std::string m_TypeName;
 		nlohmann::json m_Before;
 		nlohmann::json m_After;
+		size_t m_FieldBytes = 0; // serialized size of both sides, measured once
 	};
 
 	// Rename (TagComponent) of a single entity.
@@ -109,6 +198,7 @@ namespace Snowstorm
 		void Undo(World& world) override;
 		void Redo(World& world) override;
 		[[nodiscard]] const char* Name() const override { return "Rename"; }
+		[[nodiscard]] size_t GetMemoryBytes() const override { return sizeof(*this) + m_Before.capacity() + m_After.capacity(); }
 
 	private:
 		UUID m_Target;
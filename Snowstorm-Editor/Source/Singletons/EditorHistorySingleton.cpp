@@ -10,15 +10,33 @@ namespace Snowstorm
 		{
 			return;
 		}
+		++m_Revision;
+
+		// Coalesce into the top step only when the user is still "at" it: not after an Undo (the top is then
+		// a step they went back to, and the redo branch is about to go), and not into the saved state.
+		const bool canMerge = m_Redo.empty() && !m_Undo.empty() && m_Undo.size() != m_CleanIndex;
 
 		m_Redo.clear(); // a new action invalidates the redo branch
-		m_Undo.push_back(command);
+		m_RedoBytes = 0;
+		if (m_CleanIndex != kNoCleanIndex && m_CleanIndex > m_Undo.size())
+		{
+			m_CleanIndex = kNoCleanIndex; // the saved state was on that branch
+		}
 
-		// Bound memory: drop the oldest entries past the cap.
-		if (m_Undo.size() > kMaxDepth)
+		if (canMerge)
 		{
-			m_Undo.erase(m_Undo.begin(), m_Undo.begin() + static_cast<long>(m_Undo.size() - kMaxDepth));
+			const size_t before = m_Undo.back()->GetMemoryBytes();
+			if (m_Undo.back()->TryMerge(*command))
+			{
+				m_UndoBytes = m_UndoBytes - before + m_Undo.back()->GetMemoryBytes();
+				Trim();
+				return;
+			}
 		}
+
+		m_Undo.push_back(command);
+		m_UndoBytes += command->GetMemoryBytes();
+		Trim();
 	}
 
 	void EditorHistorySingleton::Undo(World& world)
@@ -27,11 +45,15 @@ namespace Snowstorm
 		{
 			return;
 		}
+		++m_Revision;
 
 		const Ref<EditorCommand> cmd = m_Undo.back();
 		m_Undo.pop_back();
+		m_UndoBytes -= cmd->GetMemoryBytes();
 		cmd->Undo(world);
 		m_Redo.push_back(cmd);
+		m_RedoBytes += cmd->GetMemoryBytes(); // re-read: undoing a create snapshots the entity
+		Trim();
 	}
 
 	void EditorHistorySingleton::Redo(World& world)
@@ -40,21 +62,65 @@ namespace Snowstorm
 		{
 			return;
 		}
+		++m_Revision;
 
 		const Ref<EditorCommand> cmd = m_Redo.back();
 		m_Redo.pop_back();
+		m_RedoBytes -= cmd->GetMemoryBytes();
 		cmd->Redo(world);
 		m_Undo.push_back(cmd);
+		m_UndoBytes += cmd->GetMemoryBytes();
+		Trim();
 	}
 
 	void EditorHistorySingleton::Clear()
 	{
+		++m_Revision;
 		m_Undo.clear();
 		m_Redo.clear();
+		m_UndoBytes = 0;
+		m_RedoBytes = 0;
 		m_PendingEdit = {};
 		m_CleanIndex = 0; // a freshly loaded/empty scene is clean
 	}
 
+	void EditorHistorySingleton::SetBudgetBytes(const size_t bytes)
+	{
+		m_BudgetBytes = bytes;
+		Trim();
+	}
+
+	void EditorHistorySingleton::Trim()
+	{
+		size_t dropped = 0;
+		while (GetMemoryBytes() > m_BudgetBytes && m_Undo.size() - dropped > 1)
+		{
+			m_UndoBytes -= m_Undo[dropped]->GetMemoryBytes();
+			++dropped;
+		}
+		if (dropped > 0)
+		{
+			m_Undo.erase(m_Undo.begin(), m_Undo.begin() + static_cast<long>(dropped));
+			if (m_CleanIndex != kNoCleanIndex)
+			{
+				m_CleanIndex = m_CleanIndex >= dropped ? m_CleanIndex - dropped : kNoCleanIndex;
+			}
+		}
+
+		// Still over with a single undo step left: the far end of the redo branch goes next.
+		dropped = 0;
+		while (GetMemoryBytes() > m_BudgetBytes && dropped < m_Redo.size() && m_Undo.size() + m_Redo.size() - dropped > 1)
+		{
+			m_RedoBytes -= m_Redo[dropped]->GetMemoryBytes();
+			++dropped;
+		}
+		m_Redo.erase(m_Redo.begin(), m_Redo.begin() + static_cast<long>(dropped));
+		if (m_CleanIndex != kNoCleanIndex && m_CleanIndex > m_Undo.size() + m_Redo.size())
+		{
+			m_CleanIndex = kNoCleanIndex;
+		}
+	}
+
 	void EditorHistorySingleton::BeginEdit(const UUID target, const std::string& typeName, nlohmann::json before)
 	{
 		m_PendingEdit.Active = true;
@@ -15,14 +15,17 @@ namespace Snowstorm
 
 	// Editor-wide undo/redo history. Holds two stacks of already-applied commands. Editor-only, never
 	// serialized. Must be Clear()ed when the scene changes (open/new) so commands never reference a
-	// destroyed world. Depth-capped to bound memory.
+	// destroyed world. Capped by memory, not depth: a rename costs bytes, a 5k-entity move costs what its
+	// deltas hold, and the oldest steps go once the total passes the budget.
 	class EditorHistorySingleton final : public Singleton
 	{
 	public:
-		static constexpr size_t kMaxDepth = 100;
+		static constexpr size_t kDefaultBudgetBytes = 64ull * 1024 * 1024;
 
 		// Record an action that has ALREADY been applied at its call site. Clears the redo stack (a new
-		// action invalidates any redo branch). Does not execute the command.
+		// action invalidates any redo branch). Does not execute the command. A command the top of the undo
+		// stack absorbs (EditorCommand::TryMerge) doesn't become a step of its own -- unless that would
+		// fold an edit into the saved state, or into a step the user came back to with Undo.
 		void Push(const Ref<EditorCommand>& command);
 
 		void Undo(World& world);
@@ -37,6 +40,18 @@ namespace Snowstorm
 		// Drop all history. Call on scene open/new — the old commands point at a world that no longer exists.
 		void Clear();
 
+		// Memory held by both stacks, and the cap on it. At least the newest step is always kept, however
+		// big. Lowering the budget trims right away.
+		[[nodiscard]] size_t GetMemoryBytes() const { return m_UndoBytes + m_RedoBytes; }
+		[[nodiscard]] size_t GetBudgetBytes() const { return m_BudgetBytes; }
+		void SetBudgetBytes(size_t bytes);
+
+		[[nodiscard]] size_t GetUndoDepth() const { return m_Undo.size(); }
+
+		// Changes on every Push/Undo/Redo/Clear: a cheap "the scene may have been edited through the history"
+		// check for views that cache scene state (the hierarchy's search names -- undoing a rename).
+		[[nodiscard]] uint64_t GetRevision() const { return m_Revision; }
+
 		// --- Unsaved-changes ("dirty") tracking ---
 		// Dirty = the undo stack has diverged from where it was at the last save. Undoing back to the
 		// saved point reads as clean again; any edit past it reads dirty. This rides the undo stack
@@ -55,13 +70,21 @@ namespace Snowstorm
 		void FinalizeEdit(nlohmann::json after);
 
 	private:
+		// Drop the oldest undo steps (then the redo branch) until both stacks fit the budget.
+		void Trim();
+
 		std::vector<Ref<EditorCommand>> m_Undo;
 		std::vector<Ref<EditorCommand>> m_Redo;
+		size_t m_UndoBytes = 0;
+		size_t m_RedoBytes = 0;
+		size_t m_BudgetBytes = kDefaultBudgetBytes;
+		uint64_t m_Revision = 0;
 
 		// Undo-stack depth at the last save (or scene load). IsDirty compares the current depth to this;
-		// Clear() resets it to 0 (a freshly loaded/empty scene is clean). Edge case: once the stack is
-		// capped at kMaxDepth, front entries are dropped and the depth comparison can misjudge after
-		// 100+ unsaved edits — acceptable for the editor's status indicator.
+		// Clear() resets it to 0 (a freshly loaded/empty scene is clean). Trimming the front shifts it down
+		// with the stack; once the saved step itself is trimmed it becomes unreachable (kNoCleanIndex) and the
+		// scene reads dirty until the next save.
+		static constexpr size_t kNoCleanIndex = static_cast<size_t>(-1);
 		size_t m_CleanIndex = 0;
 
 		struct PendingEdit
@@ -4,6 +4,9 @@
 #include "Snowstorm/ECS/Singleton.hpp"
 #include "Snowstorm/World/Entity.hpp"
 
+#include <span>
+#include <unordered_set>
+
 namespace Snowstorm
 {
 	// Editor-wide "currently selected entity", shared by the hierarchy panel, the inspector, the
@@ -12,8 +15,14 @@ namespace Snowstorm
 	class EditorSelectionSingleton final : public Singleton
 	{
 	public:
+		// The primary selection: what the inspector shows, the gizmo moves and F frames.
 		Entity Selected;
 
+		// Every selected entity -- the hierarchy's Ctrl/Shift multi-selection -- always including Selected. A
+		// set, so "is this row selected" is O(1) per drawn row and a Shift-click range costs the rows in it,
+		// not a pass over the scene. Change it through the functions below so the two stay in step.
+		std::unordered_set<entt::entity> Selection;
+
 		// True while the viewport gizmo is actively being dragged (ImGuizmo::IsUsing()). Set by
 		// ViewportDisplaySystem each frame. Systems that also write the selected entity's transform
 		// (e.g. RotatorSystem) skip it while this is set, so the animation doesn't fight the manual edit
@@ -29,16 +38,68 @@ namespace Snowstorm
 
 		void SelectEntity(const Entity e)
 		{
+			Selected = e;
+			Selection.clear();
+			if (e)
+			{
+				Selection.insert(e.Handle());
+			}
+			SelectedAsset = AssetHandle{0};
+			SelectedAssetType = AssetType::None;
+		}
+
+		// Shift-click: add a run of entities; `primary` (one of them) becomes Selected.
+		void AddEntities(const std::span<const entt::entity> entities, const Entity primary)
+		{
+			Selection.insert(entities.begin(), entities.end());
+			if (primary)
+			{
+				Selection.insert(primary.Handle());
+			}
+			Selected = primary;
+			SelectedAsset = AssetHandle{0};
+			SelectedAssetType = AssetType::None;
+		}
+
+		// Ctrl-click: flip one entity in or out. Added, it becomes Selected; removed while primary, another
+		// selected entity (if any) takes over.
+		void ToggleEntity(const Entity e)
+		{
+			if (!e)
+			{
+				return;
+			}
+			if (Selection.erase(e.Handle()) > 0)
+			{
+				if (Selected == e)
+				{
+					Selected = Selection.empty() ? Entity{} : Entity{*Selection.begin(), e.GetWorld()};
+				}
+				return;
+			}
+			Selection.insert(e.Handle());
 			Selected = e;
 			SelectedAsset = AssetHandle{0};
 			SelectedAssetType = AssetType::None;
 		}
 
+		[[nodiscard]] bool IsSelected(const Entity e) const
+		{
+			return e && Selection.contains(e.Handle());
+		}
+
+		void ClearSelection()
+		{
+			Selected = {};
+			Selection.clear();
+		}
+
 		void SelectAsset(const AssetHandle handle, const AssetType type)
 		{
 			SelectedAsset = handle;
 			SelectedAssetType = type;
 			Selected = {};
+			Selection.clear();
 			GizmoActive = false;
 		}
 	};
@@ -368,8 +368,23 @@ namespace Snowstorm
 		const float inputHeight = ImGui::GetFrameHeightWithSpacing() + ImGui::GetStyle().ItemSpacing.y;
 		if (ImGui::BeginChild("##log", ImVec2(0, -inputHeight), true, ImGuiWindowFlags_HorizontalScrollbar))
 		{
-			const std::vector<LogBuffer::Entry> entries = LogBuffer::Get().Snapshot();
-			for (const LogBuffer::Entry& e : entries)
+			m_NewLines.clear();
+			const LogBuffer::ReadResult read = LogBuffer::Get().ReadSince(m_ReadRevision, m_NewLines);
+			m_ReadRevision = read.Revision;
+			if (read.Cleared)
+			{
+				m_Lines.clear();
+			}
+			for (LogBuffer::Entry& e : m_NewLines)
+			{
+				m_Lines.push_back(std::move(e));
+			}
+			while (m_Lines.size() > LogBuffer::kCapacity)
+			{
+				m_Lines.pop_front();
+			}
+
+			for (const LogBuffer::Entry& e : m_Lines)
 			{
 				if (static_cast<int>(e.LevelValue) < m_LevelFilter)
 				{
@@ -379,11 +394,10 @@ namespace Snowstorm
 			}
 
 			// Autoscroll to the bottom when new lines arrived.
-			const uint64_t rev = LogBuffer::Get().Revision();
-			if (m_AutoScroll && rev != m_LastRevision)
+			if (m_AutoScroll && read.Revision != m_LastRevision)
 			{
 				ImGui::SetScrollHereY(1.0f);
-				m_LastRevision = rev;
+				m_LastRevision = read.Revision;
 			}
 		}
 		ImGui::EndChild();
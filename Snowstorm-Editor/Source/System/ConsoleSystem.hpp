@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Snowstorm/Core/LogBuffer.hpp"
 #include "Snowstorm/ECS/System.hpp"
 
+#include <deque>
 #include <string>
 #include <vector>
 
@@ -47,6 +49,12 @@ namespace Snowstorm
 		bool m_AutoScroll = true;
 		uint64_t m_LastRevision = 0; // last LogBuffer revision we scrolled for (autoscroll trigger)
 
+		// The console's own copy of the log, fed incrementally from LogBuffer::ReadSince each frame (only
+		// the new lines are copied) and capped at LogBuffer::kCapacity like the buffer itself.
+		std::deque<LogBuffer::Entry> m_Lines;
+		std::vector<LogBuffer::Entry> m_NewLines; // ReadSince scratch, reused across frames
+		uint64_t m_ReadRevision = 0;
+
 		// Autocomplete state: names matching the current prefix, shown in a popup and completed with Tab
 		// (repeated Tab cycles). Rebuilt on every edit via the input callback.
 		std::vector<std::string> m_Candidates;
@@ -3,7 +3,13 @@
 #include "Snowstorm/Assets/AssetManagerSingleton.hpp"
 #include "Snowstorm/Assets/MaterialAsset.hpp"
 #include "Snowstorm/Assets/MaterialAssetIO.hpp"
+#include "Snowstorm/Core/EngineCVars.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
 #include "Snowstorm/Project/Project.hpp"
+#include "Snowstorm/Render/Texture.hpp"
+#include "Snowstorm/World/SceneBinarySerializer.hpp"
+#include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/WorldPartition.hpp"
 #include "Singletons/EditorCommandsSingleton.hpp"
 #include "Singletons/EditorSelectionSingleton.hpp"
 #include "Service/EditorTheme.hpp"
@@ -11,38 +17,20 @@
 
 #include <imgui.h>
 
-#include <algorithm>
 #include <filesystem>
+#include <span>
 
 namespace Snowstorm
 {
 	namespace
 	{
-		// Map a file extension (lowercase, with dot) to an asset type. None means "not importable".
-		AssetType TypeFromExtension(const std::string& ext)
-		{
-			if (ext == ".obj" || ext == ".fbx" || ext == ".gltf" || ext == ".glb")
-			{
-				return AssetType::Mesh;
-			}
-			if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".dds" || ext == ".bmp")
-			{
-				return AssetType::Texture;
-			}
-			if (ext == ".ssmat")
-			{
-				return AssetType::Material;
-			}
-			if (ext == ".hlsl")
-			{
-				return AssetType::Shader;
-			}
-			if (ext == ".world")
-			{
-				return AssetType::Scene;
-			}
-			return AssetType::None;
-		}
+		// Registry checks resolved per frame. FindHandle is a hash lookup; Import just adds a registry row (no
+		// loading), so a few thousand cost well under a millisecond -- and a 200k-file first open still
+		// registers everything within a couple of seconds, while the panel already lists it.
+		constexpr size_t kRegistryChecksPerFrame = 2000;
+
+		// The atlas is 4 MB: re-uploaded at most this often while the worker is adding thumbnails.
+		constexpr float kAtlasUploadInterval = 0.25f;
 
 		ImVec4 TypeColor(const AssetType t)
 		{
@@ -64,123 +52,95 @@ namespace Snowstorm
 		}
 	}
 
-	void ContentBrowserSystem::Rescan()
+	void ContentBrowserSystem::ResolveRegistryChecks(AssetIndex& index)
 	{
-		m_Entries.clear();
-
-		// Scan the ACTIVE project's asset directory, not a CWD-relative literal — after a project
-		// switch the fresh World's ContentBrowserSystem rescans automatically (m_Scanned starts
-		// false), and it must list the new project's content.
-		const std::filesystem::path projectDir = Project::GetActive()->GetProjectDirectory();
-		const std::filesystem::path root = Project::GetActive()->GetAssetDirectory();
-		std::error_code ec;
-		if (!std::filesystem::exists(root, ec))
-		{
-			m_Scanned = true;
-			return;
-		}
+		// Auto-import: every discovered source file gets a registry handle so it is immediately usable in the
+		// inspector picker. Import is idempotent (case-insensitive dedup), so a re-check after every Open never
+		// creates duplicates. The index reports each file once per session plus every new one; the handle is
+		// confirmed back so the rows can match the selection without a registry lookup.
+		m_Checks.clear();
+		index.TakeRegistryChecks(m_Checks, kRegistryChecksPerFrame);
 
-		for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
-		     it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+		auto& assets = m_World->GetSingleton<AssetManagerSingleton>();
+		for (const AssetIndex::RegistryCheck& check : m_Checks)
 		{
-			if (ec)
+			AssetHandle handle = assets.FindHandle(check.Path, check.Type);
+			if (handle == 0)
 			{
-				continue;
+				handle = assets.Import(check.Path, check.Type);
+				m_RegistryDirty = true;
 			}
-
-			// Skip Engine/cache/: those are generated cooked artifacts (gitignored), not source
-			// assets — don't list or import them.
-			if (it->is_directory(ec) && it->path().filename() == "cache")
+			if (static_cast<uint64_t>(handle) != check.Handle)
 			{
-				it.disable_recursion_pending();
-				continue;
-			}
-
-			if (!it->is_regular_file(ec))
-			{
-				continue;
-			}
-
-			std::string ext = it->path().extension().string();
-			std::ranges::transform(ext, ext.begin(), [](const unsigned char c)
-			                       { return static_cast<char>(std::tolower(c)); });
-
-			const AssetType type = TypeFromExtension(ext);
-			if (type == AssetType::None)
-			{
-				continue; // skip scenes, json, meta caches, etc.
+				index.SetHandle(check.Path, handle);
 			}
+		}
 
-			Entry entry;
-			// Project-relative, matching the relative paths stored in AssetRegistry.json — an absolute
-			// path here would be imported verbatim into the registry (non-portable, and a duplicate of
-			// any existing relative entry for the same file). Identical to the old CWD-relative value
-			// while the project root == the working directory (today's bootstrap project).
-			entry.Path = it->path().lexically_relative(projectDir).generic_string();
-			entry.DisplayName = it->path().filename().string();
-			entry.Type = type;
-			m_Entries.push_back(std::move(entry));
+		// One save once the backlog is through, not one per frame of it.
+		if (m_RegistryDirty && m_Checks.size() < kRegistryChecksPerFrame)
+		{
+			assets.SaveRegistry(Project::GetActive()->GetAssetRegistryPath());
+			m_RegistryDirty = false;
 		}
+	}
 
-		std::ranges::sort(m_Entries, [](const Entry& a, const Entry& b)
-		                  {
-			if (a.Type != b.Type) return a.Type < b.Type;
-			return a.DisplayName < b.DisplayName; });
+	void ContentBrowserSystem::UpdateThumbnailAtlas(AssetIndex& index, const float seconds)
+	{
+		m_SinceAtlasUpload += seconds;
+		if (m_SinceAtlasUpload < kAtlasUploadInterval || !index.CopyThumbnailAtlas(m_AtlasPixels, m_AtlasRevision))
+		{
+			return;
+		}
+		m_SinceAtlasUpload = 0.0f;
 
-		// Auto-import: every discovered source file gets a registry handle so it is immediately
-		// usable in the inspector picker. Import is idempotent (case-insensitive dedup), so this is
-		// safe to run on every scan and never creates duplicates. This is the trivial current form of
-		// a real engine's import step (see CLAUDE.md "Think like a real engine"); the deliberate next
-		// step up is a file watcher so this happens without an explicit scan.
-		auto& assets = m_World->GetSingleton<AssetManagerSingleton>();
-		bool importedAny = false;
-		for (const Entry& entry : m_Entries)
+		const uint32_t back = m_AtlasFront ^ 1u;
+		if (!m_Atlas[back])
 		{
-			// Scenes are opened by path (double-click), not referenced by handle, so they are not
-			// registry assets — don't auto-import them.
-			if (entry.Type == AssetType::Scene)
-			{
-				continue;
-			}
-			if (assets.FindHandle(entry.Path, entry.Type) == 0)
-			{
-				assets.Import(entry.Path, entry.Type);
-				importedAny = true;
-			}
+			CookedTexture cooked;
+			cooked.Width = AssetIndex::kAtlasSize;
+			cooked.Height = AssetIndex::kAtlasSize;
+			cooked.Levels.push_back(m_AtlasPixels);
+			// UNorm: ImGui draws the texel values as they are, like its own font atlas.
+			m_Atlas[back] = Texture::CreateFromPixels(cooked, false, "ContentBrowserThumbnails");
 		}
-		if (importedAny)
+		else
 		{
-			assets.SaveRegistry(Project::GetActive()->GetAssetRegistryPath());
+			m_Atlas[back]->SetData(m_AtlasPixels.data(), static_cast<uint32_t>(m_AtlasPixels.size()));
 		}
-
-		m_Scanned = true;
+		m_AtlasFront = back;
 	}
 
-	void ContentBrowserSystem::Execute(Timestep)
+	void ContentBrowserSystem::Execute(const Timestep ts)
 	{
-		if (!m_Scanned)
-		{
-			Rescan();
-		}
+		// The index is application-scoped: a project switch (a fresh World, so a fresh system) reopens it on
+		// the new project's assets; the same project just keeps the running worker and its list.
+		auto& index = ServiceView<AssetIndex>();
+		const Ref<Project> project = Project::GetActive();
+		index.Open(project->GetProjectDirectory(), project->GetAssetDirectory(),
+		           AssetIndex::DefaultIndexPath(project->GetProjectDirectory()));
+
+		ResolveRegistryChecks(index);
+		UpdateThumbnailAtlas(index, ts.GetSeconds());
 
 		ImGui::Begin("Content Browser");
 
-		// Files under assets/ are auto-imported on scan, so this panel just lists them. Use Rescan
-		// after dropping in new files (until a file watcher makes even that unnecessary).
+		// The index follows the file watcher, so this is only for a tree changed while no watcher ran (or
+		// one that can't be trusted): it re-walks everything, off the main thread.
 		if (ImGui::Button("Rescan"))
 		{
-			Rescan();
+			index.RequestRescan();
 		}
 		ImGui::SameLine();
 
-		// New Material (#114): write a default .ssmat into the project's asset root, then rescan — the scan
-		// auto-imports and registers it like any dropped-in file, so it appears in the Materials tab and the
-		// inspector's picker with no further wiring. A fresh MaterialAsset{} is already a valid material
-		// (DefaultLit shader, white base color, no textures); the user edits it via the material inspector.
+		// New Material (#114): write a default .ssmat into the project's asset root and tell the index -- it
+		// lists the file and hands it back for auto-import like any dropped-in file, so it appears in the
+		// Materials tab and the inspector's picker with no further wiring. A fresh MaterialAsset{} is already a
+		// valid material (DefaultLit shader, white base color, no textures); the user edits it via the material
+		// inspector.
 		if (ImGui::Button("New Material"))
 		{
 			auto& notify = SingletonView<EditorNotificationsSingleton>();
-			const std::filesystem::path root = Project::GetActive()->GetAssetDirectory();
+			const std::filesystem::path root = project->GetAssetDirectory();
 			std::error_code ec;
 			if (std::filesystem::exists(root, ec) || std::filesystem::create_directories(root, ec))
 			{
@@ -192,7 +152,8 @@ namespace Snowstorm
 				}
 				if (MaterialAssetIO::Save(target, MaterialAsset{}))
 				{
-					Rescan(); // auto-imports + registers the new .ssmat
+					const std::string key = FileWatcher::MakeKey(target);
+					index.NotifyChanged(std::span(&key, 1));
 					notify.Push("Created " + target.filename().string(), EditorToastType::Success);
 				}
 				else
@@ -205,10 +166,13 @@ namespace Snowstorm
 				notify.Push("Asset directory missing; can't create material", EditorToastType::Error);
 			}
 		}
+
+		const std::shared_ptr<const AssetIndex::QueryResult> result = index.GetQueryResult();
 		ImGui::SameLine();
-		ImGui::TextDisabled("%zu files", m_Entries.size());
+		ImGui::TextDisabled("%zu files%s", result && result->Source ? result->Source->Entries.size() : size_t{0},
+		                    index.IsScanning() ? " (indexing...)" : "");
 
-		// Search box (filters by filename substring, case-insensitive).
+		// Search box: fuzzy over file names, case-insensitive; matched on the index worker.
 		ImGui::SetNextItemWidth(-1.0f);
 		ImGui::InputTextWithHint("##search", "Search...", m_Search, sizeof(m_Search));
 
@@ -234,117 +198,198 @@ namespace Snowstorm
 			ImGui::EndTabBar();
 		}
 
-		ImGui::Separator();
+		// A no-op unless the filter changed; the result for it arrives a frame or so later (until then the
+		// previous result stays on screen).
+		index.SetQuery(AssetIndex::Query{m_Filter, m_Search});
 
-		// Lowercase search needle for case-insensitive matching.
-		std::string needle = m_Search;
-		std::ranges::transform(needle, needle.begin(), [](const unsigned char c)
-		                       { return static_cast<char>(std::tolower(c)); });
+		ImGui::Separator();
 
-		const auto passesFilter = [&](const Entry& e)
+		if (ImGui::BeginChild("##content_list") && result && result->Source)
 		{
-			if (m_Filter != AssetType::None && e.Type != m_Filter)
-			{
-				return false;
-			}
-			if (!needle.empty())
+			auto& assets = m_World->GetSingleton<AssetManagerSingleton>();
+			auto& selection = SingletonView<EditorSelectionSingleton>();
+			const std::vector<AssetIndex::Entry>& entries = result->Source->Entries;
+
+			if (result->Source->Revision != m_SnapshotRevision)
 			{
-				std::string name = e.DisplayName;
-				std::ranges::transform(name, name.begin(), [](const unsigned char c)
-				                       { return static_cast<char>(std::tolower(c)); });
-				if (name.find(needle) == std::string::npos)
-				{
-					return false;
-				}
+				m_SnapshotRevision = result->Source->Revision;
+				m_ThumbnailsRequested.clear();
 			}
-			return true;
-		};
 
-		if (ImGui::BeginChild("##content_list"))
-		{
-			auto& assets = m_World->GetSingleton<AssetManagerSingleton>();
-			auto& selection = SingletonView<EditorSelectionSingleton>();
+			const Ref<Texture>& atlas = m_Atlas[m_AtlasFront];
+			const uint64_t atlasID = atlas ? atlas->GetDefaultView()->GetUIID() : 0;
+			constexpr uint32_t kPerRow = AssetIndex::kAtlasSize / AssetIndex::kThumbnailSize;
+			constexpr float kSlotUV = static_cast<float>(AssetIndex::kThumbnailSize) / AssetIndex::kAtlasSize;
 
-			// m_Entries is sorted by (Type, Name), so walking it groups naturally. In the "All" view
-			// emit a colored section header each time the type changes.
-			AssetType currentSection = AssetType::None;
+			const float iconSize = ImGui::GetFrameHeight();
+			std::vector<std::string> wantThumbnails;
 
-			for (int i = 0; i < static_cast<int>(m_Entries.size()); ++i)
+			// Only the visible rows are drawn: the list may be the whole 200k-file tree. Section headers
+			// (SeparatorText) are the same height as a row with the default style, which the clipper relies on.
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(result->Rows.size()), ImGui::GetFrameHeightWithSpacing());
+			while (clipper.Step())
 			{
-				const Entry& entry = m_Entries[i];
-				if (!passesFilter(entry))
+				for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r)
 				{
-					continue;
-				}
-
-				if (m_Filter == AssetType::None && entry.Type != currentSection)
-				{
-					currentSection = entry.Type;
-					ImGui::PushStyleColor(ImGuiCol_Text, TypeColor(entry.Type));
-					ImGui::SeparatorText(AssetTypeToString(entry.Type).c_str());
-					ImGui::PopStyleColor();
-				}
+					const uint32_t row = result->Rows[r];
+					if (row & AssetIndex::QueryResult::kHeaderBit)
+					{
+						const auto type = static_cast<AssetType>(row & 0xFFu);
+						ImGui::PushStyleColor(ImGuiCol_Text, TypeColor(type));
+						ImGui::SeparatorText(AssetTypeToString(type).c_str());
+						ImGui::PopStyleColor();
+						continue;
+					}
 
-				ImGui::PushID(i);
-				ImGui::Indent(8.0f);
+					const AssetIndex::Entry& entry = entries[row];
+					ImGui::PushID(static_cast<int>(row));
+					ImGui::Indent(8.0f);
 
-				const bool isSelectedAsset = selection.SelectedAssetType == entry.Type &&
-				                             selection.SelectedAsset != 0 &&
-				                             assets.FindHandle(entry.Path, entry.Type) == selection.SelectedAsset;
+					const bool isSelectedAsset = selection.SelectedAssetType == entry.Type && entry.Handle != 0 &&
+					                             static_cast<uint64_t>(selection.SelectedAsset) == entry.Handle;
 
-				if (ImGui::Selectable(entry.DisplayName.c_str(), isSelectedAsset))
-				{
-					// Single-click selects the asset for the Properties inspector. Only handle-referenced
-					// asset types (materials, textures, ...) — scenes are opened by path, not selected.
-					// The handle already exists (auto-import ran on scan). Materials are the only type with
-					// an inspector today; others just record the selection harmlessly.
-					if (entry.Type != AssetType::Scene)
+					if (ImGui::Selectable("##entry", isSelectedAsset, ImGuiSelectableFlags_None, ImVec2{0.0f, iconSize}))
 					{
-						if (const AssetHandle h = assets.FindHandle(entry.Path, entry.Type); h != 0)
+						// Single-click selects the asset for the Properties inspector. Only handle-referenced
+						// asset types (materials, textures, ...) — scenes are opened by path, not selected.
+						// The index knows the handle once the registry check for the file has run; right after
+						// a file appears, ask the registry. Materials are the only type with an inspector today;
+						// others just record the selection harmlessly.
+						if (entry.Type != AssetType::Scene)
 						{
-							selection.SelectAsset(h, entry.Type);
+							const AssetHandle h = entry.Handle != 0 ? AssetHandle{entry.Handle}
+							                                        : assets.FindHandle(entry.Path, entry.Type);
+							if (h != 0)
+							{
+								selection.SelectAsset(h, entry.Type);
+							}
 						}
 					}
-				}
 
-				if (entry.Type == AssetType::Scene && ImGui::IsItemHovered() &&
-				    ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
-				{
-					auto& cmds = SingletonView<EditorCommandsSingleton>();
-					auto& notify = SingletonView<EditorNotificationsSingleton>();
-					if (cmds.OpenScene)
+					// Icon (thumbnail, or the type's color) + name, drawn over the selectable.
 					{
-						const bool ok = cmds.OpenScene(entry.Path);
-						notify.Push(ok ? "Opened " + entry.DisplayName : "Failed to open " + entry.DisplayName,
-						            ok ? EditorToastType::Success : EditorToastType::Error);
+						const ImVec2 min = ImGui::GetItemRectMin();
+						const ImVec2 iconMax{min.x + iconSize, min.y + iconSize};
+						ImDrawList* dl = ImGui::GetWindowDrawList();
+						if (entry.Thumbnail != AssetIndex::kNoThumbnail && atlasID != 0)
+						{
+							const ImVec2 uv0{static_cast<float>(entry.Thumbnail % kPerRow) * kSlotUV,
+							                 static_cast<float>(entry.Thumbnail / kPerRow) * kSlotUV};
+							dl->AddImage(static_cast<ImTextureID>(atlasID), min, iconMax, uv0,
+							             ImVec2{uv0.x + kSlotUV, uv0.y + kSlotUV});
+						}
+						else
+						{
+							const float inset = iconSize * 0.25f;
+							dl->AddRectFilled(ImVec2{min.x + inset, min.y + inset}, ImVec2{iconMax.x - inset, iconMax.y - inset},
+							                  ImGui::GetColorU32(TypeColor(entry.Type)), 2.0f);
+							if (entry.Type == AssetType::Texture && !m_ThumbnailsRequested.contains(entry.Path))
+							{
+								m_ThumbnailsRequested.insert(entry.Path);
+								wantThumbnails.push_back(entry.Path);
+							}
+						}
+						dl->AddText(ImVec2{iconMax.x + ImGui::GetStyle().ItemSpacing.x,
+						                   min.y + (iconSize - ImGui::GetTextLineHeight()) * 0.5f},
+						            ImGui::GetColorU32(ImGuiCol_Text), entry.DisplayName.c_str());
 					}
-				}
 
-				// Right-click a scene -> context menu. "Set as Startup Scene" writes the project's StartScene
-				// (Godot's "Set as Main Scene" model). entry.Path is project-relative; the layer stores it as
-				// the StartScene and re-saves the .ssproj.
-				if (entry.Type == AssetType::Scene && ImGui::BeginPopupContextItem("scene_ctx"))
-				{
-					auto& cmds = SingletonView<EditorCommandsSingleton>();
-					auto& notify = SingletonView<EditorNotificationsSingleton>();
-					if (ImGui::MenuItem("Open Scene") && cmds.OpenScene)
+					if (entry.Type == AssetType::Scene && ImGui::IsItemHovered() &&
+					    ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
 					{
-						const bool ok = cmds.OpenScene(entry.Path);
-						notify.Push(ok ? "Opened " + entry.DisplayName : "Failed to open " + entry.DisplayName,
-						            ok ? EditorToastType::Success : EditorToastType::Error);
+						auto& cmds = SingletonView<EditorCommandsSingleton>();
+						auto& notify = SingletonView<EditorNotificationsSingleton>();
+						if (cmds.OpenScene)
+						{
+							const bool ok = cmds.OpenScene(entry.Path);
+							notify.Push(ok ? "Opened " + entry.DisplayName : "Failed to open " + entry.DisplayName,
+							            ok ? EditorToastType::Success : EditorToastType::Error);
+						}
 					}
-					if (ImGui::MenuItem("Set as Startup Scene") && cmds.SetStartupScene)
+
+					// Right-click a scene -> context menu. "Set as Startup Scene" writes the project's StartScene
+					// (Godot's "Set as Main Scene" model). entry.Path is project-relative; the layer stores it as
+					// the StartScene and re-saves the .ssproj.
+					if (entry.Type == AssetType::Scene && ImGui::BeginPopupContextItem("scene_ctx"))
 					{
-						const bool ok = cmds.SetStartupScene(entry.Path);
-						notify.Push(ok ? entry.DisplayName + " is now the startup scene" : "Failed to set startup scene",
-						            ok ? EditorToastType::Success : EditorToastType::Error);
+						auto& cmds = SingletonView<EditorCommandsSingleton>();
+						auto& notify = SingletonView<EditorNotificationsSingleton>();
+						if (ImGui::MenuItem("Open Scene") && cmds.OpenScene)
+						{
+							const bool ok = cmds.OpenScene(entry.Path);
+							notify.Push(ok ? "Opened " + entry.DisplayName : "Failed to open " + entry.DisplayName,
+							            ok ? EditorToastType::Success : EditorToastType::Error);
+						}
+						if (ImGui::MenuItem("Set as Startup Scene") && cmds.SetStartupScene)
+						{
+							const bool ok = cmds.SetStartupScene(entry.Path);
+							notify.Push(ok ? entry.DisplayName + " is now the startup scene" : "Failed to set startup scene",
+							            ok ? EditorToastType::Success : EditorToastType::Error);
+						}
+
+						std::filesystem::path source = entry.Path;
+						if (source.is_relative())
+						{
+							source = project->GetProjectDirectory() / source;
+						}
+
+						// Write the scene next to itself in the other format: the binary .ssworld loads fast, the
+						// JSON .world is what gets diffed and hand-edited. Never over an existing file (it may be a
+						// hand-edited .world): Scene.ssworld is taken -> Scene_1.ssworld, ... The index is told about
+						// the new file directly (the watcher would report it too, a moment later).
+						const bool isPartition = WorldPartition::IsPartitionPath(entry.Path);
+						const bool isBinary = SceneBinarySerializer::IsBinaryScenePath(entry.Path);
+						if (!isPartition && ImGui::MenuItem(isBinary ? "Convert to .world" : "Convert to .ssworld"))
+						{
+							const std::string extension = isBinary ? ".world" : SceneBinarySerializer::kExtension;
+							std::filesystem::path destination = source;
+							destination.replace_extension(extension);
+							std::error_code ec;
+							for (int i = 1; std::filesystem::exists(destination, ec); ++i)
+							{
+								destination = source.parent_path() / (source.stem().string() + "_" + std::to_string(i) + extension);
+							}
+
+							const bool ok = SceneBinarySerializer::ConvertFile(source.string(), destination.string());
+							notify.Push(ok ? "Wrote " + destination.filename().string() : "Failed to convert " + entry.DisplayName,
+							            ok ? EditorToastType::Success : EditorToastType::Error);
+							if (ok)
+							{
+								const std::string key = FileWatcher::MakeKey(destination);
+								index.NotifyChanged(std::span(&key, 1));
+							}
+						}
+
+						// Split the scene into streaming cells (world.streaming.cell_size grid) + a .sspartition
+						// manifest next to it. The source scene stays the one to edit; re-split after changing it.
+						if (!isPartition && ImGui::MenuItem("Split into Streaming Cells"))
+						{
+							std::filesystem::path manifest = source;
+							manifest.replace_extension(WorldPartition::kExtension);
+
+							World scratch;
+							const bool ok = SceneSerializer::Deserialize(scratch, source.string()) &&
+							                WorldPartition::Split(scratch, CVars::ClampedStreamingCellSize(), manifest,
+							                                      &SingletonView<AssetManagerSingleton>());
+							notify.Push(ok ? "Wrote " + manifest.filename().string() : "Failed to split " + entry.DisplayName,
+							            ok ? EditorToastType::Success : EditorToastType::Error);
+							if (ok)
+							{
+								const std::string key = FileWatcher::MakeKey(manifest);
+								index.NotifyChanged(std::span(&key, 1));
+							}
+						}
+						ImGui::EndPopup();
 					}
-					ImGui::EndPopup();
-				}
 
-				ImGui::Unindent(8.0f);
-				ImGui::PopID();
+					ImGui::Unindent(8.0f);
+					ImGui::PopID();
+				}
 			}
+
+			// Decoded on the index worker; they show up here a few frames later, with the next atlas upload.
+			index.RequestThumbnails(std::move(wantThumbnails));
 		}
 		ImGui::EndChild();
 
@@ -1,15 +1,24 @@
 #pragma once
 
 #include "Snowstorm/ECS/System.hpp"
+#include "Snowstorm/Assets/AssetIndex.hpp"
 #include "Snowstorm/Assets/AssetTypes.hpp"
 
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace Snowstorm
 {
+	class Texture;
+
 	// Lists files under assets/ and lets the user import them into the asset registry on demand, so
 	// new content becomes pickable in the inspector without hand-editing AssetRegistry.json.
+	//
+	// The listing comes from the AssetIndex service: a worker keeps it current (persisted between sessions,
+	// updated from FileWatcher changes) and runs the search, so this panel never touches the filesystem to
+	// draw. It only feeds the index's registry checks into AssetManagerSingleton (main-thread only), draws the
+	// visible rows, and uploads the thumbnail atlas when the worker has added to it.
 	class ContentBrowserSystem final : public System
 	{
 	public:
@@ -21,17 +30,27 @@ namespace Snowstorm
 		void Execute(Timestep ts) override;
 
 	private:
-		struct Entry
-		{
-			std::string Path;        // generic, relative to repo root (e.g. assets/meshes/cube.obj)
-			std::string DisplayName; // filename only
-			AssetType Type = AssetType::None;
-		};
-
-		void Rescan();
-
-		std::vector<Entry> m_Entries;
-		bool m_Scanned = false;
+		// Import whatever the index found that the registry doesn't know yet (a bounded slice per frame).
+		void ResolveRegistryChecks(AssetIndex& index);
+
+		// Upload the worker's thumbnail atlas if it changed (throttled).
+		void UpdateThumbnailAtlas(AssetIndex& index, float seconds);
+
+		std::vector<AssetIndex::RegistryCheck> m_Checks; // scratch
+		bool m_RegistryDirty = false;                    // imported since the last SaveRegistry
+
+		// Two GPU copies of the atlas, written alternately, so an upload never overwrites the image the
+		// previous frame's UI is still sampling.
+		Ref<Texture> m_Atlas[2];
+		uint32_t m_AtlasFront = 0;
+		uint64_t m_AtlasRevision = 0;
+		float m_SinceAtlasUpload = 0.0f;
+		std::vector<uint8_t> m_AtlasPixels;
+
+		// Textures already asked for a thumbnail; forgotten when the index publishes a new listing (a
+		// thumbnail may have been evicted from the atlas since).
+		std::unordered_set<std::string> m_ThumbnailsRequested;
+		uint64_t m_SnapshotRevision = 0;
 
 		// Active type filter. AssetType::None means "All". Drives the tab bar at the top of the panel.
 		AssetType m_Filter = AssetType::None;
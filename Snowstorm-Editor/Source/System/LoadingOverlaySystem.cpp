@@ -2,18 +2,33 @@
 
 #include "Snowstorm/Assets/AssetManagerSingleton.hpp"
 #include "Snowstorm/Core/Application.hpp"
+#include "Snowstorm/Events/DeferredEvents.hpp"
 #include "Snowstorm/Render/Shader.hpp"
 
 #include <imgui.h>
 
 namespace Snowstorm
 {
+	LoadingOverlaySystem::LoadingOverlaySystem(const WorldRef world)
+	    : System(world)
+	{
+		auto& bus = Application::Get().GetEventBus();
+		const auto refresh = [this](auto)
+		{
+			const auto& assets = SingletonView<AssetManagerSingleton>();
+			m_AssetPending = assets.PendingLoadCount();
+			m_AssetTotal = assets.PendingLoadTotal();
+		};
+		m_LoadsStarted = bus.SubscribeDeferred<AssetLoadsStartedEvent>(refresh);
+		m_LoadsLanded = bus.SubscribeDeferred<AssetLoadedEvent>(refresh);
+		m_LoadsSettled = bus.SubscribeDeferred<AssetLoadsSettledEvent>(refresh);
+	}
+
 	void LoadingOverlaySystem::Execute(Timestep)
 	{
-		auto& assets = SingletonView<AssetManagerSingleton>();
 		auto& shaderLib = Application::Get().GetServiceManager().GetService<ShaderLibrary>();
 
-		const uint32_t assetPending = assets.PendingLoadCount();
+		const uint32_t assetPending = m_AssetPending;
 		const uint32_t shaderPending = shaderLib.PendingCompileCount();
 
 		if (assetPending == 0 && shaderPending == 0)
@@ -55,7 +70,7 @@ namespace Snowstorm
 			}
 			if (assetPending > 0)
 			{
-				drawBar("Loading assets...", assetPending, assets.PendingLoadTotal());
+				drawBar("Loading assets...", assetPending, m_AssetTotal);
 			}
 		}
 		ImGui::End();
@@ -11,11 +11,17 @@ namespace Snowstorm
 	class LoadingOverlaySystem final : public System
 	{
 	public:
-		explicit LoadingOverlaySystem(const WorldRef world)
-		    : System(world)
-		{
-		}
+		explicit LoadingOverlaySystem(WorldRef world);
 
 		void Execute(Timestep ts) override;
+
+	private:
+		// The asset bar's figures, refreshed from the asset manager when a load burst starts, a load lands
+		// or the burst settles (the deferred asset events) instead of read every frame.
+		uint32_t m_AssetPending = 0;
+		uint32_t m_AssetTotal = 0;
+		EventBus::Connection m_LoadsStarted; // last: disconnect before the figures go away
+		EventBus::Connection m_LoadsLanded;
+		EventBus::Connection m_LoadsSettled;
 	};
 }
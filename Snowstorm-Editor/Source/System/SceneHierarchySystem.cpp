@@ -343,6 +343,41 @@ namespace Snowstorm
 						{
 							CVars::ShadowResolution.Set(kResolutions[idx]);
 						}
+
+						// Spot/point shadow atlas: every shadowed spot and point face gets a tile of it.
+						constexpr int kAtlasSizes[] = {2048, 4096, 8192};
+						const int currentAtlas = CVars::ClampedShadowAtlasSize();
+						int atlasIdx = 1; // default 4096
+						for (int i = 0; i < 3; ++i)
+						{
+							if (kAtlasSizes[i] == currentAtlas)
+							{
+								atlasIdx = i;
+							}
+						}
+						const char* atlasLabels[] = {"2048", "4096", "8192"};
+						if (ImGui::Combo("Atlas Size", &atlasIdx, atlasLabels, 3))
+						{
+							CVars::ShadowAtlasSize.Set(kAtlasSizes[atlasIdx]);
+						}
+
+						// Sun cascades: count, covered distance, split blend, and the far-cascade cache.
+						if (int cascades = CVars::ClampedShadowCascades(); ImGui::SliderInt("Cascades", &cascades, 1, 4, "%d", ImGuiSliderFlags_AlwaysClamp))
+						{
+							CVars::ShadowCascades.Set(cascades);
+						}
+						if (float distance = CVars::ShadowDistance.Get(); ImGui::SliderFloat("Shadow Distance", &distance, 10.0f, 1000.0f, "%.0f", ImGuiSliderFlags_Logarithmic))
+						{
+							CVars::ShadowDistance.Set(distance);
+						}
+						if (float lambda = CVars::ShadowSplitLambda.Get(); ImGui::SliderFloat("Split Lambda", &lambda, 0.0f, 1.0f, "%.2f", ImGuiSliderFlags_AlwaysClamp))
+						{
+							CVars::ShadowSplitLambda.Set(lambda);
+						}
+						if (bool cache = CVars::ShadowCascadeCache.Get(); ImGui::Checkbox("Cache Far Cascades", &cache))
+						{
+							CVars::ShadowCascadeCache.Set(cache);
+						}
 					}
 					ImGui::EndDisabled();
 
@@ -925,6 +960,13 @@ namespace Snowstorm
 				ImGui::Text("Batches:    %u", stats.Batches);
 				ImGui::Text("Instances:  %u", stats.Instances);
 				ImGui::Text("Triangles:  %u", stats.Triangles);
+				// Binds the command context dropped as already bound, thanks to the sorted batch order.
+				ImGui::Text("Binds skipped: %u pipeline, %u set, %u buffer", stats.PipelineBindsSkipped,
+				            stats.DescriptorBindsSkipped, stats.BufferBindsSkipped);
+				// Shadow caching: maps/tiles re-rendered this frame vs kept from last frame. A static scene
+				// should sit near 100% skipped; a low rate with nothing moving means a cache key is unstable.
+				ImGui::Text("Shadow tiles: %u drawn, %u skipped (%.0f%%)", stats.ShadowTilesRendered,
+				            stats.ShadowTilesSkipped, stats.ShadowTileSkipRate() * 100.0f);
 
 				// Upscaled-vs-ground-truth image quality (#45): shown when render.metrics + render.compare are on.
 				// PSNR in dB (higher = closer to ground truth), SSIM in [0,1] (1 = identical). Measures how well the
@@ -935,6 +977,26 @@ namespace Snowstorm
 					ImGui::Text("SSIM: %.4f", m.Ssim);
 				}
 
+				// Dataset export writer (#46): frames on disk vs captured, the bounded queue's fill, and how often
+				// (and how long) capture waited on it. Stalls climbing steadily = the disk or the compressor is the
+				// bottleneck; raise dataset.export.queue only to absorb bursts, not a sustained deficit.
+				if (CVars::DatasetExport.Get())
+				{
+					const DatasetExportStats& ds = ServiceView<RendererService>().GetDatasetExportStats();
+					ImGui::Text("Dataset:    %llu / %llu written", static_cast<unsigned long long>(ds.FramesWritten),
+					            static_cast<unsigned long long>(ds.FramesSubmitted));
+					ImGui::Text("  queue %u/%u, stalls %llu (%.0f ms)", ds.QueuedFrames, ds.QueueCapacity,
+					            static_cast<unsigned long long>(ds.Stalls), ds.StallMs);
+					if (ds.StoredBytes > 0 && ds.RawBytes != ds.StoredBytes)
+					{
+						ImGui::Text("  compression %.2fx", static_cast<double>(ds.RawBytes) / static_cast<double>(ds.StoredBytes));
+					}
+					if (ds.WriteErrors > 0)
+					{
+						ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), "  %llu write errors", static_cast<unsigned long long>(ds.WriteErrors));
+					}
+				}
+
 				// Frustum-culling effectiveness, summed over every camera's visibility cache this frame.
 				// "considered" = resolved + layer-matched renderables; "culled" = those the frustum rejected.
 				// Near-zero culling with many considered means scene-sized bounds (e.g. material-merged groups)
@@ -398,7 +398,7 @@ namespace Snowstorm
 		// typing in the console/a field just cancels the field (ImGui handles that) instead of deselecting.
 		if (selection.Selected && input.PressedThisFrame.test(Key::Escape) && !input.WantTextInput)
 		{
-			selection.Selected = {};
+			selection.ClearSelection();
 		}
 
 		// Deferred RT pick result: a GPU click-ray trace requested a frame or two ago has read back. Map
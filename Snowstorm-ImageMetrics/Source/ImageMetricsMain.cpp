@@ -0,0 +1,320 @@
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetReader.hpp"
+#include "Snowstorm/Render/DatasetExport/NpyReader.hpp"
+#include "Snowstorm/Render/Quality/ImageMetrics.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Headless image-quality scoring (CI quality gates without a GPU). Compares a test capture set against a
+// reference set with the CPU metrics of Quality/ImageMetrics (PSNR and Box7 SSIM match MetricsPass):
+//   - two .npy files: scored directly;
+//   - two dataset exports (directories with manifest.json): frame i's --key array (default gt_ldr) of each,
+//     loose or sharded/compressed;
+//   - two plain directories: every .npy under --test paired with the same relative path under --ref.
+// Prints per-pair and mean scores, optionally writes them as JSON, and applies the --min/--max gates to the
+// means.
+//
+//     Snowstorm-ImageMetrics --test <npy|dir> --ref <npy|dir> [--key NAME] [--window box|gaussian] [--ppd N]
+//                            [--no-flip] [--json <out.json>] [--min-psnr dB] [--min-ssim X] [--min-msssim X]
+//                            [--max-flip X]
+//
+// Exit 0 if at least one pair was scored and every gate passed, 1 otherwise.
+
+namespace
+{
+	using namespace Snowstorm;
+
+	struct Options
+	{
+		std::filesystem::path Test;
+		std::filesystem::path Ref;
+		std::filesystem::path Json;
+		std::string Key = "gt_ldr";
+		Quality::SsimWindow Window = Quality::SsimWindow::Box7;
+		float PixelsPerDegree = Quality::kFlipDefaultPixelsPerDegree;
+		bool Flip = true;
+		std::optional<double> MinPsnr;
+		std::optional<double> MinSsim;
+		std::optional<double> MinMsSsim;
+		std::optional<double> MaxFlip;
+	};
+
+	constexpr std::string_view kUsage = "usage: Snowstorm-ImageMetrics --test <npy|dir> --ref <npy|dir> [--key NAME] "
+	                                    "[--window box|gaussian] [--ppd N] [--no-flip] [--json <out>] [--min-psnr dB] "
+	                                    "[--min-ssim X] [--min-msssim X] [--max-flip X]";
+
+	bool ParseArgs(const int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--test" && hasValue)
+			{
+				options.Test = argv[++i];
+			}
+			else if (arg == "--ref" && hasValue)
+			{
+				options.Ref = argv[++i];
+			}
+			else if (arg == "--json" && hasValue)
+			{
+				options.Json = argv[++i];
+			}
+			else if (arg == "--key" && hasValue)
+			{
+				options.Key = argv[++i];
+			}
+			else if (arg == "--window" && hasValue)
+			{
+				const std::string_view window = argv[++i];
+				if (window != "box" && window != "gaussian")
+				{
+					SS_CORE_ERROR("Unknown --window {} ({})", window, kUsage);
+					return false;
+				}
+				options.Window = window == "box" ? Quality::SsimWindow::Box7 : Quality::SsimWindow::Gaussian11;
+			}
+			else if (arg == "--ppd" && hasValue)
+			{
+				options.PixelsPerDegree = std::strtof(argv[++i], nullptr);
+			}
+			else if (arg == "--no-flip")
+			{
+				options.Flip = false;
+			}
+			else if (arg == "--min-psnr" && hasValue)
+			{
+				options.MinPsnr = std::strtod(argv[++i], nullptr);
+			}
+			else if (arg == "--min-ssim" && hasValue)
+			{
+				options.MinSsim = std::strtod(argv[++i], nullptr);
+			}
+			else if (arg == "--min-msssim" && hasValue)
+			{
+				options.MinMsSsim = std::strtod(argv[++i], nullptr);
+			}
+			else if (arg == "--max-flip" && hasValue)
+			{
+				options.MaxFlip = std::strtod(argv[++i], nullptr);
+			}
+			else
+			{
+				SS_CORE_ERROR("Unknown argument {} ({})", arg, kUsage);
+				return false;
+			}
+		}
+		if (options.Test.empty() || options.Ref.empty())
+		{
+			SS_CORE_ERROR("--test and --ref are required ({})", kUsage);
+			return false;
+		}
+		if (options.PixelsPerDegree <= 0.0f)
+		{
+			SS_CORE_ERROR("--ppd must be positive ({})", kUsage);
+			return false;
+		}
+		if (options.MaxFlip && !options.Flip)
+		{
+			SS_CORE_ERROR("--max-flip needs FLIP (drop --no-flip)");
+			return false;
+		}
+		return true;
+	}
+
+	// One (test, reference) pair, loaded lazily so a large set never holds more than one pair in memory.
+	struct Pair
+	{
+		std::string Name;
+		std::function<std::optional<NpyArray>()> LoadTest;
+		std::function<std::optional<NpyArray>()> LoadRef;
+	};
+
+	std::optional<nlohmann::json> ReadManifest(const std::filesystem::path& dir)
+	{
+		std::ifstream in(dir / "manifest.json");
+		if (!in)
+		{
+			return std::nullopt;
+		}
+		nlohmann::json manifest = nlohmann::json::parse(in, nullptr, /*allow_exceptions*/ false);
+		if (!manifest.is_object() || !manifest.contains("frames") || !manifest["frames"].is_array())
+		{
+			SS_CORE_ERROR("ImageMetrics: {} is not a dataset manifest", (dir / "manifest.json").string());
+			return std::nullopt;
+		}
+		return manifest;
+	}
+
+	std::vector<Pair> CollectPairs(const Options& options)
+	{
+		std::vector<Pair> pairs;
+		const auto loadFile = [](std::filesystem::path path)
+		{ return [path = std::move(path)] { return ReadNpy(path.string()); }; };
+
+		if (!std::filesystem::is_directory(options.Test) || !std::filesystem::is_directory(options.Ref))
+		{
+			pairs.push_back({options.Test.filename().string(), loadFile(options.Test), loadFile(options.Ref)});
+			return pairs;
+		}
+
+		const auto testManifest = ReadManifest(options.Test);
+		const auto refManifest = ReadManifest(options.Ref);
+		if (testManifest && refManifest)
+		{
+			const nlohmann::json& testFrames = (*testManifest)["frames"];
+			const nlohmann::json& refFrames = (*refManifest)["frames"];
+			const size_t count = std::min(testFrames.size(), refFrames.size());
+			if (testFrames.size() != refFrames.size())
+			{
+				SS_CORE_WARN("ImageMetrics: {} vs {} frames; scoring the first {}", testFrames.size(), refFrames.size(), count);
+			}
+			for (size_t f = 0; f < count; ++f)
+			{
+				if (!testFrames[f].contains(options.Key) || !refFrames[f].contains(options.Key))
+				{
+					SS_CORE_WARN("ImageMetrics: frame {} has no '{}' array; skipped", f, options.Key);
+					continue;
+				}
+				pairs.push_back({"frame " + std::to_string(testFrames[f].value("frame", f)),
+				                 [dir = options.Test, entry = testFrames[f][options.Key]] { return ReadDatasetImage(dir, entry); },
+				                 [dir = options.Ref, entry = refFrames[f][options.Key]] { return ReadDatasetImage(dir, entry); }});
+			}
+			return pairs;
+		}
+
+		std::vector<std::filesystem::path> files;
+		std::error_code ec;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(options.Test, ec))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".npy")
+			{
+				files.push_back(std::filesystem::relative(entry.path(), options.Test));
+			}
+		}
+		std::sort(files.begin(), files.end());
+		for (const std::filesystem::path& relative : files)
+		{
+			if (!std::filesystem::exists(options.Ref / relative))
+			{
+				SS_CORE_WARN("ImageMetrics: no reference for {}; skipped", relative.generic_string());
+				continue;
+			}
+			pairs.push_back({relative.generic_string(), loadFile(options.Test / relative), loadFile(options.Ref / relative)});
+		}
+		return pairs;
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	Log::Init();
+
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		return 1;
+	}
+
+	JobSystem jobs;
+	nlohmann::json report = nlohmann::json::array();
+	double psnrSum = 0.0, ssimSum = 0.0, msSsimSum = 0.0, flipSum = 0.0;
+	size_t scored = 0;
+	for (const Pair& pair : CollectPairs(options))
+	{
+		const auto testNpy = pair.LoadTest();
+		const auto refNpy = pair.LoadRef();
+		const auto test = testNpy ? Quality::MetricImageFromNpy(*testNpy, pair.Name) : std::nullopt;
+		const auto ref = refNpy ? Quality::MetricImageFromNpy(*refNpy, pair.Name + " (reference)") : std::nullopt;
+		if (!test || !ref)
+		{
+			continue;
+		}
+
+		const auto psnr = Quality::Psnr(*test, *ref, &jobs);
+		const auto ssim = Quality::Ssim(*test, *ref, options.Window, &jobs);
+		const auto msSsim = Quality::MsSsim(*test, *ref, &jobs);
+		const auto flip = options.Flip ? Quality::Flip(*test, *ref, options.PixelsPerDegree, &jobs) : std::optional<double>(0.0);
+		if (!psnr || !ssim || !msSsim || !flip)
+		{
+			continue; // size mismatch, already logged
+		}
+
+		++scored;
+		psnrSum += *psnr;
+		ssimSum += *ssim;
+		msSsimSum += *msSsim;
+		flipSum += *flip;
+		nlohmann::json entry = {{"name", pair.Name}, {"psnr", *psnr}, {"ssim", *ssim}, {"ms_ssim", *msSsim}};
+		if (options.Flip)
+		{
+			entry["flip"] = *flip;
+			SS_CORE_INFO("  {}  PSNR {:.3f} dB  SSIM {:.5f}  MS-SSIM {:.5f}  FLIP {:.5f}", pair.Name, *psnr, *ssim, *msSsim, *flip);
+		}
+		else
+		{
+			SS_CORE_INFO("  {}  PSNR {:.3f} dB  SSIM {:.5f}  MS-SSIM {:.5f}", pair.Name, *psnr, *ssim, *msSsim);
+		}
+		report.push_back(std::move(entry));
+	}
+
+	if (scored == 0)
+	{
+		SS_CORE_ERROR("ImageMetrics: nothing scored ({} vs {})", options.Test.string(), options.Ref.string());
+		return 1;
+	}
+
+	const double n = static_cast<double>(scored);
+	const double psnr = psnrSum / n, ssim = ssimSum / n, msSsim = msSsimSum / n, flip = flipSum / n;
+	SS_CORE_INFO("ImageMetrics: {} pair(s)  mean PSNR {:.3f} dB  SSIM {:.5f}  MS-SSIM {:.5f}", scored, psnr, ssim, msSsim);
+	if (options.Flip)
+	{
+		SS_CORE_INFO("ImageMetrics: mean FLIP {:.5f} at {:.1f} px/deg", flip, options.PixelsPerDegree);
+	}
+
+	bool pass = true;
+	const auto gate = [&](const char* name, const double value, const std::optional<double>& limit, const bool atLeast)
+	{
+		if (limit && (atLeast ? value < *limit : value > *limit))
+		{
+			SS_CORE_ERROR("ImageMetrics: mean {} {:.5f} fails the gate ({} {})", name, value, atLeast ? ">=" : "<=", *limit);
+			pass = false;
+		}
+	};
+	gate("PSNR", psnr, options.MinPsnr, true);
+	gate("SSIM", ssim, options.MinSsim, true);
+	gate("MS-SSIM", msSsim, options.MinMsSsim, true);
+	gate("FLIP", flip, options.MaxFlip, false);
+
+	if (!options.Json.empty())
+	{
+		nlohmann::json out = {{"ssim_window", options.Window == Quality::SsimWindow::Box7 ? "box7" : "gaussian11"},
+		                      {"pairs", std::move(report)},
+		                      {"mean", {{"psnr", psnr}, {"ssim", ssim}, {"ms_ssim", msSsim}}},
+		                      {"pass", pass}};
+		if (options.Flip)
+		{
+			out["ppd"] = options.PixelsPerDegree;
+			out["mean"]["flip"] = flip;
+		}
+		std::ofstream file(options.Json);
+		file << out.dump(2) << '\n';
+		if (!file)
+		{
+			SS_CORE_ERROR("ImageMetrics: failed to write {}", options.Json.string());
+			return 1;
+		}
+	}
+	return pass ? 0 : 1;
+}
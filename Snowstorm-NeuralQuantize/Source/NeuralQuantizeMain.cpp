@@ -0,0 +1,326 @@
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetReader.hpp"
+#include "Snowstorm/Render/Neural/NeuralInference.hpp"
+#include "Snowstorm/Render/Neural/NeuralQuantization.hpp"
+#include "Snowstorm/Render/Neural/NeuralWeights.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Post-training quantization of a .ssnn upscaler (CI / model packaging). Headless, CPU-only:
+//   1. load the fp32 model and the (lr, mv, gt) tuples DatasetExportPass wrote;
+//   2. calibrate: run the fp32 model over the first --calib-frames inputs through CpuInference::RunObserved,
+//      recording every layer's input range;
+//   3. quantize (int8 per-channel weights + calibrated uint8 activations, or plain fp16 weights) and save a
+//      .ssnn v2 the engine loads directly;
+//   4. report, over every loaded frame, PSNR vs. the GT for the fp32 and quantized models (and the delta) plus
+//      CPU inference time for both — the number that says whether the quantized model is shippable.
+//
+//     Snowstorm-NeuralQuantize --model <in.ssnn> --dataset <dir with manifest.json> [--out <out.ssnn>]
+//                              [--mode int8|fp16] [--keep-ends] [--calib-frames N] [--max-frames N]
+//
+// Exit 0 if the model was written, 1 otherwise.
+
+namespace
+{
+	using namespace Snowstorm;
+
+	struct Options
+	{
+		std::filesystem::path Model;
+		std::filesystem::path Dataset;
+		std::filesystem::path Out;
+		bool Int8 = true;
+		bool KeepEnds = false;
+		size_t CalibFrames = 32;
+		size_t MaxFrames = 128;
+	};
+
+	constexpr std::string_view kUsage = "usage: Snowstorm-NeuralQuantize --model <ssnn> --dataset <dir> [--out <ssnn>] "
+	                                    "[--mode int8|fp16] [--keep-ends] [--calib-frames N] [--max-frames N]";
+
+	bool ParseArgs(const int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--model" && hasValue)
+			{
+				options.Model = argv[++i];
+			}
+			else if (arg == "--dataset" && hasValue)
+			{
+				options.Dataset = argv[++i];
+			}
+			else if (arg == "--out" && hasValue)
+			{
+				options.Out = argv[++i];
+			}
+			else if (arg == "--mode" && hasValue)
+			{
+				const std::string_view mode = argv[++i];
+				if (mode != "int8" && mode != "fp16")
+				{
+					SS_CORE_ERROR("Unknown --mode {} ({})", mode, kUsage);
+					return false;
+				}
+				options.Int8 = mode == "int8";
+			}
+			else if (arg == "--keep-ends")
+			{
+				options.KeepEnds = true;
+			}
+			else if (arg == "--calib-frames" && hasValue)
+			{
+				options.CalibFrames = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else if (arg == "--max-frames" && hasValue)
+			{
+				options.MaxFrames = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else
+			{
+				SS_CORE_ERROR("Unknown argument {} ({})", arg, kUsage);
+				return false;
+			}
+		}
+		if (options.Model.empty() || options.Dataset.empty())
+		{
+			SS_CORE_ERROR("--model and --dataset are required ({})", kUsage);
+			return false;
+		}
+		if (options.Out.empty())
+		{
+			options.Out = options.Model;
+			options.Out.replace_filename(options.Model.stem().string() + (options.Int8 ? "_int8" : "_fp16") + ".ssnn");
+		}
+		return true;
+	}
+
+	// One exported frame: the model input at GT resolution (bilinear base [+ zero history + motion]) and the
+	// GT it is scored against.
+	struct Sample
+	{
+		Neural::FeatureMap Input;
+		Neural::FeatureMap Base;
+		Neural::FeatureMap Truth;
+	};
+
+	// (h, w, 4) HWC dataset array (loose or sharded, see ReadDatasetImage) -> the first `channels` channels as CHW.
+	std::optional<Neural::FeatureMap> LoadChannels(const std::filesystem::path& dir, const nlohmann::json& image, const uint32_t channels)
+	{
+		const auto npy = ReadDatasetImage(dir, image);
+		if (!npy || npy->Shape.size() != 3 || npy->Shape[2] < channels)
+		{
+			SS_CORE_ERROR("NeuralQuantize: {} is not an (h, w, >={}) array", image.value("file", std::string("?")), channels);
+			return std::nullopt;
+		}
+		const size_t h = npy->Shape[0], w = npy->Shape[1], c = npy->Shape[2];
+		Neural::FeatureMap map;
+		map.Channels = channels;
+		map.Height = static_cast<uint32_t>(h);
+		map.Width = static_cast<uint32_t>(w);
+		map.Data.resize(channels * h * w);
+		for (uint32_t ch = 0; ch < channels; ++ch)
+		{
+			for (size_t i = 0; i < h * w; ++i)
+			{
+				map.Data[ch * h * w + i] = npy->Data[i * c + ch];
+			}
+		}
+		return map;
+	}
+
+	// Build the conv stack's input the way NeuralUpscalePass feeds it. Temporal models get the first-frame
+	// feature stack (no valid history -> zeros, as NeuralWarpHistory writes) plus the motion vectors.
+	std::optional<Sample> LoadSample(const std::filesystem::path& dir, const nlohmann::json& frame, const uint32_t inChannels)
+	{
+		const auto lr = LoadChannels(dir, frame["lr"], 3);
+		const auto gt = LoadChannels(dir, frame["gt"], 3);
+		if (!lr || !gt)
+		{
+			return std::nullopt;
+		}
+
+		Sample s;
+		s.Truth = *gt;
+		Neural::CpuInference::UpsampleBilinear(*lr, gt->Width, gt->Height, s.Base);
+		if (inChannels == 3)
+		{
+			s.Input = s.Base;
+			return s;
+		}
+
+		const auto mv = LoadChannels(dir, frame["mv"], 2);
+		if (!mv)
+		{
+			return std::nullopt;
+		}
+		Neural::FeatureMap mvFull;
+		Neural::CpuInference::UpsampleBilinear(*mv, gt->Width, gt->Height, mvFull);
+		const size_t plane = static_cast<size_t>(gt->Width) * gt->Height;
+		s.Input.Channels = inChannels;
+		s.Input.Height = gt->Height;
+		s.Input.Width = gt->Width;
+		s.Input.Data.assign(inChannels * plane, 0.0f);
+		std::copy(s.Base.Data.begin(), s.Base.Data.end(), s.Input.Data.begin());
+		std::copy(mvFull.Data.begin(), mvFull.Data.end(), s.Input.Data.begin() + 6 * plane);
+		return s;
+	}
+
+	// PSNR of the displayable range: prediction and GT clamped to [0, 1] (what the metrics pass scores).
+	double Psnr(const Neural::FeatureMap& prediction, const Neural::FeatureMap& truth)
+	{
+		double sum = 0.0;
+		for (size_t i = 0; i < truth.Data.size(); ++i)
+		{
+			const double d = std::clamp(prediction.Data[i], 0.0f, 1.0f) - std::clamp(truth.Data[i], 0.0f, 1.0f);
+			sum += d * d;
+		}
+		const double mse = sum / static_cast<double>(std::max<size_t>(truth.Data.size(), 1));
+		return mse > 0.0 ? 10.0 * std::log10(1.0 / mse) : 99.0;
+	}
+
+	struct Score
+	{
+		double Psnr = 0.0;
+		double Milliseconds = 0.0;
+	};
+
+	Score Evaluate(const Neural::NeuralModel& model, const std::vector<Sample>& samples, JobSystem& jobs)
+	{
+		Neural::CpuInference inference(model);
+		Neural::FeatureMap residual;
+		Score score;
+		for (const Sample& s : samples)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			inference.Run(s.Input, residual, &jobs);
+			score.Milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			for (size_t i = 0; i < residual.Data.size(); ++i)
+			{
+				residual.Data[i] += s.Base.Data[i]; // output = bilinear + residual
+			}
+			score.Psnr += Psnr(residual, s.Truth);
+		}
+		const double n = static_cast<double>(std::max<size_t>(samples.size(), 1));
+		score.Psnr /= n;
+		score.Milliseconds /= n;
+		return score;
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	Log::Init();
+
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		return 1;
+	}
+
+	Neural::NeuralModel model;
+	if (!Neural::LoadModel(options.Model.string(), model) || model.Layers.empty())
+	{
+		SS_CORE_ERROR("NeuralQuantize: cannot load {}", options.Model.string());
+		return 1;
+	}
+	const uint32_t inChannels = model.Layers.front().InChannels;
+	if ((inChannels != 3 && inChannels != 8) || model.Layers.back().OutChannels != 3)
+	{
+		SS_CORE_ERROR("NeuralQuantize: expected a 3- or 8-in / 3-out upscaler, got {}-in / {}-out", inChannels,
+		              model.Layers.back().OutChannels);
+		return 1;
+	}
+
+	nlohmann::json manifest;
+	{
+		std::ifstream in(options.Dataset / "manifest.json");
+		if (!in)
+		{
+			SS_CORE_ERROR("NeuralQuantize: no manifest.json in {}", options.Dataset.string());
+			return 1;
+		}
+		manifest = nlohmann::json::parse(in, nullptr, /*allow_exceptions*/ false);
+	}
+	if (!manifest.is_object() || !manifest.contains("frames") || !manifest["frames"].is_array())
+	{
+		SS_CORE_ERROR("NeuralQuantize: {} is not a dataset manifest", (options.Dataset / "manifest.json").string());
+		return 1;
+	}
+
+	std::vector<Sample> samples;
+	for (const nlohmann::json& frame : manifest["frames"])
+	{
+		if (samples.size() >= options.MaxFrames)
+		{
+			break;
+		}
+		if (auto sample = LoadSample(options.Dataset, frame, inChannels))
+		{
+			samples.push_back(std::move(*sample));
+		}
+	}
+	if (samples.empty())
+	{
+		SS_CORE_ERROR("NeuralQuantize: no usable frames in {}", options.Dataset.string());
+		return 1;
+	}
+
+	JobSystem jobs;
+	Neural::NeuralModel quantized = model;
+	if (options.Int8)
+	{
+		// Calibration: the fp32 model's per-layer input ranges over the calibration frames.
+		std::vector<Neural::ActivationRange> ranges(model.Layers.size());
+		Neural::CpuInference inference(model);
+		Neural::FeatureMap out;
+		const size_t calib = std::clamp<size_t>(options.CalibFrames, 1, samples.size());
+		for (size_t i = 0; i < calib; ++i)
+		{
+			inference.RunObserved(samples[i].Input, out, [&](const size_t layer, const std::span<const float> input)
+			                      { ranges[layer].Observe(input); }, &jobs);
+		}
+		if (!Neural::QuantizeModelInt8(quantized, ranges, options.KeepEnds))
+		{
+			return 1;
+		}
+		SS_CORE_INFO("NeuralQuantize: calibrated {} layer(s) on {} frame(s)", ranges.size(), calib);
+	}
+	else
+	{
+		for (Neural::ConvLayer& layer : quantized.Layers)
+		{
+			Neural::QuantizeWeightsFloat16(layer);
+		}
+	}
+
+	if (!Neural::SaveModel(options.Out.string(), quantized))
+	{
+		SS_CORE_ERROR("NeuralQuantize: failed to write {}", options.Out.string());
+		return 1;
+	}
+
+	const Score reference = Evaluate(model, samples, jobs);
+	const Score result = Evaluate(quantized, samples, jobs);
+	SS_CORE_INFO("NeuralQuantize: {} frame(s) at {}x{}", samples.size(), samples.front().Truth.Width, samples.front().Truth.Height);
+	SS_CORE_INFO("  fp32   PSNR {:.3f} dB  CPU {:.2f} ms/frame", reference.Psnr, reference.Milliseconds);
+	SS_CORE_INFO("  {}   PSNR {:.3f} dB  CPU {:.2f} ms/frame", options.Int8 ? "int8" : "fp16", result.Psnr, result.Milliseconds);
+	SS_CORE_INFO("  delta  {:+.3f} dB  speedup {:.2f}x", result.Psnr - reference.Psnr,
+	             result.Milliseconds > 0.0 ? reference.Milliseconds / result.Milliseconds : 0.0);
+	SS_CORE_INFO("NeuralQuantize: wrote {}", options.Out.string());
+	return 0;
+}
@@ -7,7 +7,9 @@
 #include "Snowstorm/Project/Project.hpp"
 #include "Snowstorm/Project/ProjectSerializer.hpp"
 #include "Snowstorm/Systems/CoreSystems.hpp"
+#include "Snowstorm/World/LevelStreamingSingleton.hpp"
 #include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/WorldPartition.hpp"
 
 #include "Snowstorm/Components/CameraComponent.hpp"
 #include "Snowstorm/Components/CameraControllerComponent.hpp"
@@ -82,7 +84,12 @@ namespace Snowstorm
 		{
 			m_ScenePath = sceneOverride;
 		}
-		if (!SceneSerializer::Deserialize(*m_World, m_ScenePath))
+		// A partitioned world (.sspartition) loads its persistent scene -- including the camera -- here and
+		// streams its cells in around that camera from the first frame.
+		const bool loaded = WorldPartition::IsPartitionPath(m_ScenePath)
+		                        ? m_World->GetSingleton<LevelStreamingSingleton>().Open(m_ScenePath)
+		                        : SceneSerializer::Deserialize(*m_World, m_ScenePath);
+		if (!loaded)
 		{
 			SS_CORE_ERROR("Runtime: failed to load startup scene '{}'. "
 			              "Run the editor once to author and save it.",
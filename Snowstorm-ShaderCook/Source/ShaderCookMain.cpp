@@ -0,0 +1,132 @@
+#include "Platform/Vulkan/VulkanShader.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Core/Log.hpp"
+#include "Snowstorm/Render/ShaderBundle.hpp"
+#include "Snowstorm/Render/ShaderPermutationManifest.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Offline shader cook (CI / packaging): expand the permutation manifest, compile every permutation across all
+// cores into the regular .spv cache, and pack the results into Engine/Shaders.ssbundle. Headless — no window,
+// no Vulkan device: it calls the same VulkanShader::CompileStage the runtime does, so the cache keys (and the
+// bundle entry names) are the engine's by construction rather than a second copy of the hashing rules.
+//
+// Run from the repo root (engine-relative paths resolve against the working directory, as in the editor):
+//     Snowstorm-ShaderCook [--manifest Engine/Shaders/Permutations.json] [--out Engine/Shaders.ssbundle]
+//
+// Exit 0 if every permutation compiled and the bundle was written, 1 otherwise.
+
+namespace
+{
+	struct Options
+	{
+		std::filesystem::path Manifest = Snowstorm::ShaderPermutationManifestIO::GetDefaultPath();
+		std::filesystem::path Out = Snowstorm::ShaderBundle::GetDefaultPath();
+	};
+
+	bool ParseArgs(const int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string_view arg = argv[i];
+			if (arg == "--manifest" && i + 1 < argc)
+			{
+				options.Manifest = argv[++i];
+			}
+			else if (arg == "--out" && i + 1 < argc)
+			{
+				options.Out = argv[++i];
+			}
+			else
+			{
+				SS_CORE_ERROR("Unknown argument {} (usage: Snowstorm-ShaderCook [--manifest <json>] [--out <bundle>])", arg);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::vector<uint8_t> ReadBytes(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+	}
+}
+
+int main(const int argc, char** argv)
+{
+	using namespace Snowstorm;
+
+	Log::Init();
+
+	Options options;
+	if (!ParseArgs(argc, argv, options))
+	{
+		return 1;
+	}
+
+	const auto jobs = ShaderPermutationManifestIO::Load(options.Manifest, std::filesystem::current_path());
+	if (!jobs)
+	{
+		SS_CORE_ERROR("ShaderCook: cannot read permutation manifest {}", options.Manifest.string());
+		return 1;
+	}
+	SS_CORE_INFO("ShaderCook: {} permutation(s) from {}", jobs->size(), options.Manifest.string());
+
+	const auto start = std::chrono::steady_clock::now();
+
+	// One permutation per task (grain 1): each is a dxc process of very uneven cost, so fine-grained tasks keep
+	// every core busy to the end. CompileStage already serializes same-output requests, and a warm cache entry
+	// is just an exists() check, so re-running the cook after a small edit only compiles what changed.
+	std::vector<std::string> spvPaths(jobs->size());
+	JobSystem jobSystem;
+	jobSystem.ParallelFor(jobs->size(), [&](const size_t begin, const size_t end)
+	                      {
+		for (size_t i = begin; i < end; ++i)
+		{
+			const ShaderPermutationJob& job = (*jobs)[i];
+			if (!VulkanShader::CompileStage(job.Source, job.Stage, job.Defines, /*debug*/ false, spvPaths[i]))
+			{
+				spvPaths[i].clear();
+			}
+		} }, 1);
+
+	std::vector<ShaderBundle::Entry> entries;
+	entries.reserve(spvPaths.size());
+	size_t failed = 0;
+	for (size_t i = 0; i < spvPaths.size(); ++i)
+	{
+		std::vector<uint8_t> bytes = spvPaths[i].empty() ? std::vector<uint8_t>{} : ReadBytes(spvPaths[i]);
+		if (bytes.empty())
+		{
+			SS_CORE_ERROR("ShaderCook: {} failed to compile", (*jobs)[i].Source);
+			++failed;
+			continue;
+		}
+		entries.push_back({std::filesystem::path(spvPaths[i]).filename().string(), std::move(bytes)});
+	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	SS_CORE_INFO("ShaderCook: compiled {}/{} permutation(s) in {:.1f}s on {} worker(s)", entries.size(), jobs->size(),
+	             seconds, jobSystem.WorkerCount() + 1);
+
+	// A partial bundle would make the runtime quietly fall back to dxc for the holes; fail the cook instead.
+	if (failed > 0)
+	{
+		return 1;
+	}
+
+	if (!ShaderBundle::Write(options.Out, entries))
+	{
+		SS_CORE_ERROR("ShaderCook: failed to write {}", options.Out.string());
+		return 1;
+	}
+	SS_CORE_INFO("ShaderCook: wrote {}", options.Out.string());
+	return 0;
+}
@@ -0,0 +1,195 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Assets/AssetIndex.hpp"
+#include "Snowstorm/Core/FileWatcher.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Snowstorm;
+
+// The asset index lists the asset directory from a worker, follows watcher changes file by file, survives a
+// restart through its on-disk cache, and answers type-filtered fuzzy queries without the main thread walking
+// anything.
+
+namespace
+{
+	void WriteFile(const std::filesystem::path& p, const std::string& text)
+	{
+		std::filesystem::create_directories(p.parent_path());
+		std::ofstream out(p, std::ios::binary | std::ios::trunc);
+		out << text;
+	}
+
+	const AssetIndex::Entry* Find(const AssetIndex::Snapshot& snapshot, const std::string& path)
+	{
+		const auto it = std::ranges::find(snapshot.Entries, path, &AssetIndex::Entry::Path);
+		return it != snapshot.Entries.end() ? &*it : nullptr;
+	}
+
+	std::vector<std::string> RowNames(const AssetIndex::QueryResult& result)
+	{
+		std::vector<std::string> names;
+		for (const uint32_t row : result.Rows)
+		{
+			names.push_back((row & AssetIndex::QueryResult::kHeaderBit) ? "#" + AssetTypeToString(static_cast<AssetType>(row & 0xFF))
+			                                                             : result.Source->Entries[row].DisplayName);
+		}
+		return names;
+	}
+}
+
+TEST_CASE("AssetIndex fuzzy score ranks prefixes and runs above scattered matches", "[assets][index]")
+{
+	CHECK(AssetIndex::FuzzyScore("brick_albedo.png", "xyz") == -1);
+	CHECK(AssetIndex::FuzzyScore("brick_albedo.png", "ab") >= 0); // in order, not adjacent
+	CHECK(AssetIndex::FuzzyScore("brick_albedo.png", "ba") >= 0);
+	CHECK(AssetIndex::FuzzyScore("abc", "cb") == -1); // out of order
+
+	// Substring at a word start > same word later in the name > scattered subsequence.
+	const int prefix = AssetIndex::FuzzyScore("albedo.png", "alb");
+	const int inner = AssetIndex::FuzzyScore("brick_albedo.png", "alb");
+	const int scattered = AssetIndex::FuzzyScore("a_long_bar.png", "alb");
+	CHECK(prefix > inner);
+	CHECK(inner > scattered);
+
+	// Word-start initials beat letters buried mid-word.
+	CHECK(AssetIndex::FuzzyScore("rock_normal.png", "rn") > AssetIndex::FuzzyScore("iron.png", "rn"));
+}
+
+TEST_CASE("AssetIndex thumbnails keep the aspect ratio on a transparent square", "[assets][index]")
+{
+	constexpr uint32_t k = AssetIndex::kThumbnailSize;
+
+	// A 64x16 opaque red image: 32x8 after the fit, centred vertically.
+	std::vector<uint8_t> image(64 * 16 * 4);
+	for (size_t i = 0; i < image.size(); i += 4)
+	{
+		image[i + 0] = 255;
+		image[i + 3] = 255;
+	}
+	std::vector<uint8_t> thumbnail(k * k * 4, 7);
+	AssetIndex::MakeThumbnail(image.data(), 64, 16, thumbnail.data());
+
+	const auto alpha = [&](const uint32_t x, const uint32_t y)
+	{ return thumbnail[(y * k + x) * 4 + 3]; };
+	CHECK(alpha(0, 0) == 0);
+	CHECK(alpha(16, 11) == 0);
+	CHECK(alpha(0, 12) == 255);
+	CHECK(alpha(31, 19) == 255);
+	CHECK(alpha(16, 20) == 0);
+	CHECK(thumbnail[(12 * k + 5) * 4 + 0] == 255);
+	CHECK(thumbnail[(12 * k + 5) * 4 + 1] == 0);
+
+	// Smaller images are enlarged: a 2x2 checker becomes four 16x16 blocks.
+	const uint8_t tiny[2 * 2 * 4] = {255, 255, 255, 255, 0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 255};
+	AssetIndex::MakeThumbnail(tiny, 2, 2, thumbnail.data());
+	CHECK(thumbnail[0] == 255);
+	CHECK(thumbnail[(k - 1) * 4] == 0);
+	CHECK(thumbnail[((k - 1) * k + k - 1) * 4] == 255);
+}
+
+TEST_CASE("AssetIndex walks, follows changes, persists and queries", "[assets][index]")
+{
+	const ScratchDirectory scratch("Snowstorm-AssetIndexTests");
+	const std::filesystem::path& project = scratch.GetPath();
+	const std::filesystem::path assets = project / "assets";
+	const std::filesystem::path indexPath = project / "index.bin";
+	WriteFile(assets / "meshes" / "cube.obj", "o cube\n");
+	WriteFile(assets / "meshes" / "sphere.gltf", "{}");
+	WriteFile(assets / "textures" / "brick_albedo.png", "not really a png");
+	WriteFile(assets / "scenes" / "main.world", "{}");
+	WriteFile(assets / "notes.txt", "not an asset");
+	WriteFile(assets / "cache" / "cooked.obj", "generated");
+
+	std::vector<AssetIndex::RegistryCheck> checks;
+	{
+		AssetIndex index;
+		index.Open(project, assets, indexPath);
+		index.Sync();
+		CHECK_FALSE(index.IsScanning());
+
+		auto snapshot = index.GetSnapshot();
+		REQUIRE(snapshot->Entries.size() == 4);
+		const AssetIndex::Entry* cube = Find(*snapshot, "assets/meshes/cube.obj");
+		REQUIRE(cube);
+		CHECK(cube->Type == AssetType::Mesh);
+		CHECK(cube->DisplayName == "cube.obj");
+		CHECK(cube->Size == 7);
+		CHECK_FALSE(Find(*snapshot, "assets/cache/cooked.obj"));
+
+		// Every importable file once; scenes are opened by path, not registered.
+		index.TakeRegistryChecks(checks, 100);
+		CHECK(checks.size() == 3);
+		CHECK(std::ranges::none_of(checks, [](const auto& c)
+		                           { return c.Type == AssetType::Scene; }));
+
+		// The unfiltered listing is grouped by type under header rows.
+		auto result = index.GetQueryResult();
+		REQUIRE(result);
+		CHECK(RowNames(*result) == std::vector<std::string>{"#Mesh", "cube.obj", "sphere.gltf", "#Texture",
+		                                                    "brick_albedo.png", "#Scene", "main.world"});
+
+		index.SetQuery({AssetType::Mesh, "sph"});
+		index.Sync();
+		result = index.GetQueryResult();
+		CHECK(RowNames(*result) == std::vector<std::string>{"sphere.gltf"});
+		index.SetQuery({});
+
+		// Watcher events: one file added, one deleted, a directory moved in.
+		WriteFile(assets / "materials" / "Rock.ssmat", "{}");
+		WriteFile(assets / "moved" / "a.png", "a");
+		WriteFile(assets / "moved" / "b.png", "b");
+		std::filesystem::remove(assets / "meshes" / "cube.obj");
+		const std::vector<std::string> changed = {
+		    FileWatcher::MakeKey(assets / "materials" / "Rock.ssmat"),
+		    FileWatcher::MakeKey(assets / "meshes" / "cube.obj"),
+		    FileWatcher::MakeKey(assets / "moved"),
+		    FileWatcher::MakeKey(project / "Engine" / "Shaders" / "Mesh.vert.hlsl"), // outside the assets: ignored
+		};
+		index.NotifyChanged(changed);
+		index.SetHandle("assets/meshes/sphere.gltf", 1234);
+		index.Sync();
+
+		snapshot = index.GetSnapshot();
+		CHECK(snapshot->Entries.size() == 6);
+		CHECK_FALSE(Find(*snapshot, "assets/meshes/cube.obj"));
+		REQUIRE(Find(*snapshot, "assets/materials/Rock.ssmat"));
+		CHECK(Find(*snapshot, "assets/materials/Rock.ssmat")->Type == AssetType::Material);
+		CHECK(Find(*snapshot, "assets/moved/b.png"));
+		CHECK(Find(*snapshot, "assets/meshes/sphere.gltf")->Handle == 1234);
+
+		checks.clear();
+		index.TakeRegistryChecks(checks, 100);
+		CHECK(checks.size() == 3); // the material and the two moved textures
+
+		// A deleted directory takes its files along.
+		std::filesystem::remove_all(assets / "moved");
+		const std::vector<std::string> removed = {FileWatcher::MakeKey(assets / "moved")};
+		index.NotifyChanged(removed);
+		index.Sync();
+		CHECK(index.GetSnapshot()->Entries.size() == 4);
+	}
+
+	// Reopened from the cache: the list (and the confirmed handle) is there, every entry is re-checked.
+	{
+		AssetIndex index;
+		index.Open(project, assets, indexPath);
+		index.Sync();
+		const auto snapshot = index.GetSnapshot();
+		CHECK(snapshot->Entries.size() == 4);
+		REQUIRE(Find(*snapshot, "assets/meshes/sphere.gltf"));
+		CHECK(Find(*snapshot, "assets/meshes/sphere.gltf")->Handle == 1234);
+
+		checks.clear();
+		index.TakeRegistryChecks(checks, 100);
+		CHECK(checks.size() == 3);
+		CHECK(std::ranges::any_of(checks, [](const auto& c)
+		                          { return c.Handle == 1234; }));
+	}
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Debug/Benchmark.hpp"
+
+#include <string>
+
+using namespace Snowstorm;
+using Catch::Approx;
+
+namespace
+{
+	bool Contains(const std::string& hay, const std::string& needle)
+	{
+		return hay.find(needle) != std::string::npos;
+	}
+}
+
+TEST_CASE("Benchmark stats are median and MAD, robust to an outlier", "[debug][benchmark]")
+{
+	// One 100 ms outlier: the mean would be 22, the median stays 3. |x - 3| = {2,1,0,1,97} -> MAD 1.
+	const BenchmarkStats odd = ComputeBenchmarkStats({4.0, 1.0, 100.0, 3.0, 2.0});
+	CHECK(odd.Samples == 5);
+	CHECK(odd.MedianMs == Approx(3.0));
+	CHECK(odd.MadMs == Approx(1.0));
+	CHECK(odd.MinMs == Approx(1.0));
+	CHECK(odd.MaxMs == Approx(100.0));
+
+	// Even count: mean of the middle two. Median 2.5; deviations {1.5,0.5,0.5,1.5} -> MAD 1.
+	const BenchmarkStats even = ComputeBenchmarkStats({1.0, 2.0, 3.0, 4.0});
+	CHECK(even.MedianMs == Approx(2.5));
+	CHECK(even.MadMs == Approx(1.0));
+
+	CHECK(ComputeBenchmarkStats({}).Samples == 0);
+}
+
+TEST_CASE("Benchmark runner warms up, repeats, filters and reports failures", "[debug][benchmark]")
+{
+	BenchmarkRunner runner;
+	int setups = 0;
+	int calls = 0;
+	runner.Add("area.counted", [&](BenchmarkContext& ctx)
+	{
+		ctx.Measure([&] { ++setups; }, [&] { ++calls; }, 4);
+	});
+	runner.Add("area.broken", [](BenchmarkContext& ctx) { ctx.Fail("no input"); });
+	runner.Add("area.lazy", [](BenchmarkContext&) {});
+	runner.Add("other.twice", [](BenchmarkContext& ctx)
+	{
+		ctx.Measure([] {});
+		ctx.Measure([] {});
+	});
+
+	CHECK(runner.Names("area.").size() == 3);
+
+	const auto results = runner.Run({2, 5, "area."});
+	REQUIRE(results.size() == 3);
+	CHECK(setups == 7);     // 2 warmup + 5 timed samples
+	CHECK(calls == 7 * 4);  // x4 iterations each
+	CHECK_FALSE(results[0].Failed);
+	CHECK(results[0].Stats.Samples == 5);
+	CHECK(results[0].Iterations == 4);
+	CHECK(results[1].Failed);
+	CHECK(results[2].Failed); // never measured
+
+	const auto twice = runner.Run({0, 1, "other."});
+	REQUIRE(twice.size() == 1);
+	CHECK(twice[0].Failed);
+}
+
+TEST_CASE("Benchmark JSON has the perf-bench shape, sorted, without failures", "[debug][benchmark]")
+{
+	BenchmarkResult zulu{"zulu.x", {2.0, 0.25, 1.5, 4.0, 9}, 1000, false};
+	BenchmarkResult alpha{"alpha.y", {1.0, 0.0, 1.0, 1.0, 9}, 1, false};
+	BenchmarkResult failed{"mike.z", {}, 0, true};
+
+	const std::string json = BenchmarkRunner::ToJson({zulu, failed, alpha}, "Test CPU", "headless", 9);
+	CHECK(Contains(json, "\"device\": \"Test CPU\""));
+	CHECK(Contains(json, "\"config\": \"headless\""));
+	CHECK(Contains(json, "\"frames\": 9"));
+	CHECK(Contains(json, "\"timestampsSupported\": true"));
+	CHECK(Contains(json, "\"totalGpuMs\": 3.0000"));
+	CHECK(Contains(json, "\"zulu.x\": { \"avgMs\": 2.0000, \"minMs\": 1.5000, \"maxMs\": 4.0000, \"madMs\": 0.2500, "
+	                     "\"iterations\": 1000, \"fragInvocations\": 0, \"depth\": 0 }"));
+	CHECK_FALSE(Contains(json, "mike.z"));
+	CHECK(json.find("\"alpha.y\"") < json.find("\"zulu.x\""));
+}
@@ -0,0 +1,226 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetCompression.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetReader.hpp"
+#include "Snowstorm/Render/DatasetExport/DatasetWriter.hpp"
+#include "Snowstorm/Render/DatasetExport/TarWriter.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	nlohmann::json ReadManifest(const std::filesystem::path& dir)
+	{
+		std::ifstream in(dir / "manifest.json");
+		nlohmann::json manifest;
+		in >> manifest;
+		return manifest;
+	}
+
+	// A (2, 3, 4) uint8 array whose codes depend on the frame, so a mixed-up member is caught.
+	std::vector<uint8_t> FrameCodes(const uint64_t frame)
+	{
+		std::vector<uint8_t> codes(2 * 3 * 4);
+		for (size_t i = 0; i < codes.size(); ++i)
+		{
+			codes[i] = static_cast<uint8_t>(frame * 7 + i);
+		}
+		return codes;
+	}
+
+	DatasetFrame MakeFrame(DatasetWriter& writer, const uint64_t index)
+	{
+		DatasetFrame frame;
+		frame.Index = index;
+		frame.JitterNdc = {0.25f, -0.5f};
+		frame.Scale = 0.5f;
+		for (const char* name : {"lr", "gt"})
+		{
+			DatasetImage image{.Name = name, .Width = 3, .Height = 2, .Channels = 4, .DType = NpyDType::UInt8, .Npy = writer.AcquireBuffer()};
+			const std::vector<uint8_t> codes = FrameCodes(index);
+			REQUIRE(EncodeNpy(image.Npy, codes.data(), codes.size(), {2, 3, 4}, NpyDType::UInt8));
+			frame.Images.push_back(std::move(image));
+		}
+		return frame;
+	}
+
+	// Every manifest frame reads back (through whatever layout the writer chose) as the codes it was given.
+	void CheckReadsBack(const std::filesystem::path& dir, const nlohmann::json& manifest, const size_t frameCount)
+	{
+		REQUIRE(manifest["frames"].size() == frameCount);
+		for (size_t f = 0; f < frameCount; ++f)
+		{
+			const nlohmann::json& entry = manifest["frames"][f];
+			CHECK(entry["frame"].get<uint64_t>() == f); // written in submission order
+			const std::vector<uint8_t> codes = FrameCodes(f);
+			for (const char* name : {"lr", "gt"})
+			{
+				const auto array = ReadDatasetImage(dir, entry[name]);
+				REQUIRE(array);
+				CHECK(array->Shape == std::vector<size_t>{2, 3, 4});
+				REQUIRE(array->Data.size() == codes.size());
+				for (size_t i = 0; i < codes.size(); ++i)
+				{
+					CHECK(array->Data[i] == static_cast<float>(codes[i]));
+				}
+			}
+		}
+	}
+}
+
+// The checksum field is what `tar` validates first; an off-by-one in its encoding makes every shard unreadable.
+TEST_CASE("Tar header is ustar with a valid checksum", "[dataset]")
+{
+	const std::array<uint8_t, 512> h = BuildTarHeader("frame_000001_lr.npy.zst", 1234);
+	CHECK(std::string(reinterpret_cast<const char*>(h.data())) == "frame_000001_lr.npy.zst");
+	CHECK(std::string(reinterpret_cast<const char*>(h.data()) + 124, 11) == "00000002322"); // 1234 in octal
+	CHECK(std::string(reinterpret_cast<const char*>(h.data()) + 257, 5) == "ustar");
+	CHECK(h[156] == '0');
+
+	uint32_t sum = 0;
+	for (size_t i = 0; i < h.size(); ++i)
+	{
+		sum += (i >= 148 && i < 156) ? ' ' : h[i];
+	}
+	CHECK(std::stoul(std::string(reinterpret_cast<const char*>(h.data()) + 148, 6), nullptr, 8) == sum);
+	CHECK(h[154] == 0);
+	CHECK(h[155] == ' ');
+}
+
+TEST_CASE("Dataset compression round-trips through zstd and LZ4", "[dataset]")
+{
+	std::vector<uint8_t> input(100000);
+	for (size_t i = 0; i < input.size(); ++i)
+	{
+		input[i] = static_cast<uint8_t>((i / 7) ^ (i % 13)); // compressible, not constant
+	}
+
+	for (const DatasetCompression codec : {DatasetCompression::Zstd, DatasetCompression::Lz4})
+	{
+		std::vector<uint8_t> packed, unpacked;
+		REQUIRE(CompressDatasetBytes(input, codec, 0, packed));
+		CHECK(packed.size() < input.size());
+		REQUIRE(DecompressDatasetBytes(packed, codec, unpacked));
+		CHECK(unpacked == input);
+
+		packed.resize(packed.size() / 2); // truncated member
+		CHECK_FALSE(DecompressDatasetBytes(packed, codec, unpacked));
+	}
+
+	CHECK(ParseDatasetCompression("zstd") == DatasetCompression::Zstd);
+	CHECK(ParseDatasetCompression("") == DatasetCompression::None);
+	CHECK_FALSE(ParseDatasetCompression("gzip"));
+}
+
+// An uncompressed loose export must stay byte-compatible with the v1 layout existing readers load with
+// np.load(root / file).
+TEST_CASE("DatasetWriter loose export keeps the v1 layout", "[dataset]")
+{
+	const ScratchDirectory scratch("ss_dataset_loose");
+	const std::filesystem::path& dir = scratch.GetPath();
+	{
+		DatasetWriter writer(nullptr);
+		REQUIRE(writer.Open({.OutputDir = dir.string()}));
+		for (uint64_t f = 0; f < 3; ++f)
+		{
+			writer.Submit(MakeFrame(writer, f));
+		}
+		writer.Flush();
+		CHECK(writer.GetStats().FramesWritten == 3);
+	}
+
+	const nlohmann::json manifest = ReadManifest(dir);
+	CHECK(manifest["format"] == "snowstorm-sr-dataset-v1");
+	CHECK(manifest["frames"][1]["lr"]["file"] == "frame_000001_lr.npy");
+	CHECK(!manifest["frames"][1]["lr"].contains("shard"));
+	CHECK(std::filesystem::exists(dir / "frame_000002_gt.npy"));
+	CheckReadsBack(dir, manifest, 3);
+}
+
+// Sharded + compressed through the JobSystem: frames compress out of order on the workers but must land in
+// submission order, split into ceil(frames / N) shards, each member addressable by its manifest offset.
+TEST_CASE("DatasetWriter shards and compresses on the JobSystem in order", "[dataset]")
+{
+	for (const DatasetCompression codec : {DatasetCompression::Zstd, DatasetCompression::Lz4})
+	{
+		const ScratchDirectory scratch("ss_dataset_sharded");
+		const std::filesystem::path& dir = scratch.GetPath();
+		JobSystem jobs;
+		{
+			DatasetWriter writer(&jobs);
+			REQUIRE(writer.Open({.OutputDir = dir.string(), .FramesPerShard = 4, .Compression = codec, .MaxQueuedFrames = 3}));
+			for (uint64_t f = 0; f < 10; ++f)
+			{
+				writer.Submit(MakeFrame(writer, f));
+			}
+			writer.Flush();
+
+			const DatasetExportStats stats = writer.GetStats();
+			CHECK(stats.FramesSubmitted == 10);
+			CHECK(stats.FramesWritten == 10);
+			CHECK(stats.QueuedFrames == 0);
+			CHECK(stats.Shards == 3);
+			CHECK(stats.WriteErrors == 0);
+		}
+
+		const nlohmann::json manifest = ReadManifest(dir);
+		CHECK(manifest["format"] == "snowstorm-sr-dataset-v2");
+		CHECK(manifest["compression"] == DatasetCompressionName(codec));
+		REQUIRE(manifest["shards"].size() == 3);
+		CHECK(manifest["shards"][2]["frames"] == 2);
+		CHECK(manifest["frames"][5]["gt"]["shard"] == "shard_000001.tar");
+		CHECK(manifest["frames"][5]["gt"]["raw_bytes"] == BuildNpyHeader({2, 3, 4}, NpyDType::UInt8).size() + 24);
+		// Tar framing: 512-byte headers, data padded to 512, two zero blocks at the end.
+		CHECK(std::filesystem::file_size(dir / "shard_000000.tar") % 512 == 0);
+		CHECK(manifest["frames"][0]["lr"]["offset"] == 512);
+		CheckReadsBack(dir, manifest, 10);
+	}
+}
+
+// With workers and a one-deep queue, a burst of submits can never have more than one frame outstanding;
+// whatever waiting that costs is what the overlay reports. An inline writer finishes each frame inside Submit
+// and so never stalls.
+TEST_CASE("DatasetWriter bounds its queue and counts stalls", "[dataset]")
+{
+	const ScratchDirectory scratch("ss_dataset_backpressure");
+	const std::filesystem::path& dir = scratch.GetPath();
+	{
+		DatasetWriter inlineWriter(nullptr);
+		REQUIRE(inlineWriter.Open({.OutputDir = dir.string(), .MaxQueuedFrames = 1}));
+		for (uint64_t f = 0; f < 4; ++f)
+		{
+			inlineWriter.Submit(MakeFrame(inlineWriter, f));
+		}
+		CHECK(inlineWriter.GetStats().FramesWritten == 4);
+		CHECK(inlineWriter.GetStats().Stalls == 0);
+	}
+
+	JobSystem jobs;
+	{
+		DatasetWriter writer(&jobs);
+		REQUIRE(writer.Open({.OutputDir = dir.string(), .FramesPerShard = 8, .Compression = DatasetCompression::Zstd, .MaxQueuedFrames = 1}));
+		for (uint64_t f = 0; f < 16; ++f)
+		{
+			writer.Submit(MakeFrame(writer, f));
+			CHECK(writer.GetStats().QueuedFrames <= 1);
+		}
+		writer.Flush();
+		const DatasetExportStats stats = writer.GetStats();
+		CHECK(stats.QueueCapacity == 1);
+		CHECK(stats.FramesWritten == 16);
+		CHECK(stats.Stalls <= 15);
+		CHECK(stats.StallMs >= 0.0);
+	}
+	CheckReadsBack(dir, ReadManifest(dir), 16);
+}
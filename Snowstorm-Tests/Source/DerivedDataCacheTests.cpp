@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Assets/ContentHash.hpp"
+#include "Snowstorm/Assets/ContentHashIndex.hpp"
+#include "Snowstorm/Assets/DerivedDataCache.hpp"
+#include "Snowstorm/Assets/TextureCache.hpp"
+#include "Snowstorm/Core/EngineCVars.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	void WriteFile(const std::filesystem::path& p, const std::string& bytes)
+	{
+		std::ofstream out(p, std::ios::binary | std::ios::trunc);
+		out << bytes;
+	}
+}
+
+// The content hash must be the real XXH64 (digests from the reference implementation), so a key computed by
+// any tool that speaks xxHash names the same artifact.
+TEST_CASE("ContentHasher matches reference XXH64 digests", "[ddc]")
+{
+	CHECK(HashBytes64("", 0) == 0xEF46DB3751D8E999ull);
+	CHECK(HashBytes64("abc", 3) == 0x44BC2CF5AD770999ull);
+
+	std::vector<uint8_t> bytes(100);
+	for (size_t i = 0; i < bytes.size(); ++i)
+	{
+		bytes[i] = static_cast<uint8_t>(i);
+	}
+	CHECK(HashBytes64(bytes.data(), bytes.size()) == 0x6AC1E58032166597ull);
+
+	// Streaming in arbitrary pieces (crossing the 32-byte stripe boundary) must equal the one-shot digest.
+	for (size_t split = 0; split <= bytes.size(); split += 7)
+	{
+		ContentHasher hasher;
+		hasher.Update(bytes.data(), split);
+		hasher.Update(bytes.data() + split, bytes.size() - split);
+		CHECK(hasher.Digest() == 0x6AC1E58032166597ull);
+	}
+}
+
+// The index exists so an unchanged file is not re-read: a fresh index over the saved file must serve the hash
+// without rehashing, and a content edit must produce a new hash (the old mtime gate's job, done by content).
+TEST_CASE("ContentHashIndex persists hashes and rehashes only changed files", "[ddc]")
+{
+	const ScratchDirectory scratch("ss_ddc_index");
+	const std::filesystem::path& dir = scratch.GetPath();
+	const auto source = dir / "source.bin";
+	const auto indexPath = dir / "hashindex.bin";
+	WriteFile(source, "vertex soup");
+	const uint64_t expected = HashBytes64("vertex soup", 11);
+
+	{
+		ContentHashIndex index(indexPath);
+		CHECK(index.GetHash(source) == expected);
+		CHECK(index.GetHash(source) == expected);
+		CHECK(index.RehashCount() == 1);
+		REQUIRE(index.Flush());
+	}
+
+	{
+		ContentHashIndex index(indexPath);
+		CHECK(index.GetHash(source) == expected);
+		CHECK(index.RehashCount() == 0); // served from the persisted index
+
+		WriteFile(source, "different vertex soup");
+		std::filesystem::last_write_time(source, std::filesystem::last_write_time(source) + std::chrono::seconds(5));
+		CHECK(index.GetHash(source) == HashBytes64("different vertex soup", 21));
+		CHECK(index.RehashCount() == 1);
+	}
+
+	CHECK_FALSE(ContentHashIndex(indexPath).GetHash(dir / "missing.bin").has_value());
+}
+
+// Each input of the key (kind, content, settings, cook version) must perturb it, else two different cooks
+// would collide on one file.
+TEST_CASE("DerivedDataCache keys are deterministic and input-sensitive", "[ddc]")
+{
+	const DerivedDataKey base = DerivedDataCache::MakeKey("mesh", 1, 2, 3);
+	CHECK(DerivedDataCache::MakeKey("mesh", 1, 2, 3) == base);
+	CHECK_FALSE(DerivedDataCache::MakeKey("texture", 1, 2, 3) == base);
+	CHECK_FALSE(DerivedDataCache::MakeKey("mesh", 9, 2, 3) == base);
+	CHECK_FALSE(DerivedDataCache::MakeKey("mesh", 1, 9, 3) == base);
+	CHECK_FALSE(DerivedDataCache::MakeKey("mesh", 1, 2, 9) == base);
+	CHECK(base.ToString().size() == 16);
+}
+
+// A blob cooked on one "machine" must be usable by another that only shares the DDC directory: Save publishes
+// to the shared tier, and a Load with an empty local cache pulls it back down.
+TEST_CASE("Texture cook round-trips through the shared DDC", "[ddc]")
+{
+	const ScratchDirectory scratch("ss_ddc_shared");
+	const std::filesystem::path& shared = scratch.GetPath();
+	CVars::DdcSharedPath.Set(shared.string());
+
+	CookedTexture src;
+	src.Width = 2;
+	src.Height = 1;
+	src.Levels = {{1, 2, 3, 4, 5, 6, 7, 8}, {9, 10, 11, 12}};
+
+	const DerivedDataKey key = TextureCacheIO::MakeKey(HashBytes64("texels", 6));
+	REQUIRE(TextureCacheIO::Save(key, src));
+	CHECK(std::filesystem::exists(shared / "texture" / (key.ToString() + ".sstex")));
+
+	// Drop the local copy: the next load must come from the shared tier (and repopulate local).
+	std::error_code ec;
+	std::filesystem::remove(TextureCacheIO::GetCachePath(key), ec);
+	const std::optional<CookedTexture> loaded = TextureCacheIO::Load(key);
+	REQUIRE(loaded.has_value());
+	CHECK(loaded->Width == src.Width);
+	CHECK(loaded->Height == src.Height);
+	CHECK(loaded->Levels == src.Levels);
+	CHECK(std::filesystem::exists(TextureCacheIO::GetCachePath(key)));
+
+	// A different key is a miss in every tier.
+	CHECK_FALSE(TextureCacheIO::Load(TextureCacheIO::MakeKey(HashBytes64("other", 5))).has_value());
+
+	CVars::DdcSharedPath.Set("");
+	std::filesystem::remove(TextureCacheIO::GetCachePath(key), ec);
+}
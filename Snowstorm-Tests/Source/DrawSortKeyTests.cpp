@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/DrawSortKey.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace Snowstorm;
+
+TEST_CASE("Draw sort keys order by pipeline, then material, then mesh", "[render][sort]")
+{
+	// A higher field outranks any value of the fields below it.
+	CHECK(MakeDrawSortKey(1, 0, 0) > MakeDrawSortKey(0, 0xFFFFFF, 0xFFFFFF));
+	CHECK(MakeDrawSortKey(0, 1, 0) > MakeDrawSortKey(0, 0, 0xFFFFFF));
+	CHECK(MakeDrawSortKey(0, 0, 1) > MakeDrawSortKey(0, 0, 0));
+
+	// Out-of-range ids saturate instead of spilling into the neighbouring field.
+	CHECK(MakeDrawSortKey(70000, 0, 0) == MakeDrawSortKey(0xFFFF, 0, 0));
+	CHECK(MakeDrawSortKey(0, 0, 0x2000000) == MakeDrawSortKey(0, 0, 0xFFFFFF));
+	CHECK(MakeDrawSortKey(0, 0, 0x2000000) < MakeDrawSortKey(0, 1, 0));
+}
+
+TEST_CASE("Radix sort of draws matches a stable sort", "[render][sort]")
+{
+	std::mt19937 rng(7);
+	std::vector<DrawSortEntry> scratch;
+
+	for (const uint32_t count : {0u, 1u, 2u, 17u, 1000u})
+	{
+		// Few distinct ids, as a real frame has: plenty of equal keys, so stability is exercised.
+		std::uniform_int_distribution<uint32_t> pipeline(0, 3), material(0, 20), mesh(0, 9);
+		std::vector<DrawSortEntry> entries(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			entries[i] = {MakeDrawSortKey(pipeline(rng), material(rng), mesh(rng)), i};
+		}
+
+		std::vector<DrawSortEntry> expected = entries;
+		std::ranges::stable_sort(expected, {}, &DrawSortEntry::Key);
+
+		RadixSortDraws(entries, scratch);
+		REQUIRE(entries.size() == expected.size());
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			CHECK(entries[i].Key == expected[i].Key);
+			CHECK(entries[i].Index == expected[i].Index);
+		}
+	}
+
+	// Keys that differ in a single byte sort in one pass, which leaves the result in the scratch buffer.
+	std::vector<DrawSortEntry> oneByte{{MakeDrawSortKey(0, 0, 3), 0}, {MakeDrawSortKey(0, 0, 1), 1},
+	                                   {MakeDrawSortKey(0, 0, 2), 2}};
+	RadixSortDraws(oneByte, scratch);
+	CHECK(oneByte[0].Index == 1);
+	CHECK(oneByte[1].Index == 2);
+	CHECK(oneByte[2].Index == 0);
+}
@@ -141,13 +141,13 @@ TEST_CASE("DeleteEntityCommand undo restores snapshot, redo deletes again", "[ed
 	const UUID id = e.GetComponent<IDComponent>().Id;
 
 	// Mirror the hierarchy panel: snapshot, then destroy, then push the command.
-	nlohmann::json snap;
-	REQUIRE(SceneSerializer::SerializeEntity(e, snap));
+	std::vector<uint8_t> snap = DeleteEntityCommand::CaptureEntity(e);
+	REQUIRE_FALSE(snap.empty());
 	world.DestroyEntity(e);
 	world.FlushDestroyQueue();
 
 	EditorHistorySingleton history;
-	history.Push(CreateRef<DeleteEntityCommand>(id, snap));
+	history.Push(CreateRef<DeleteEntityCommand>(id, std::move(snap)));
 
 	// Undo brings it back.
 	history.Undo(world);
@@ -161,6 +161,51 @@ TEST_CASE("DeleteEntityCommand undo restores snapshot, redo deletes again", "[ed
 	REQUIRE_FALSE(world.FindEntityByUUID(id).IsValid());
 }
 
+TEST_CASE("Deleting several entities is one undo step", "[editor][undo]")
+{
+	World world;
+	std::vector<Entity> doomed;
+	std::vector<UUID> ids;
+	for (int i = 0; i < 3; ++i)
+	{
+		Entity e = world.CreateEntity("Doomed");
+		e.AddComponent<TransformComponent>().Position = glm::vec3(static_cast<float>(i));
+		doomed.push_back(e);
+		ids.push_back(e.GetComponent<IDComponent>().Id);
+	}
+
+	// Mirror the hierarchy panel's multi-delete: one snapshot of the batch, then destroy, then one command.
+	std::vector<uint8_t> snap = DeleteEntityCommand::CaptureEntities(doomed);
+	for (const Entity e : doomed)
+	{
+		world.DestroyEntity(e);
+	}
+	world.FlushDestroyQueue();
+
+	EditorHistorySingleton history;
+	history.Push(CreateRef<DeleteEntityCommand>(ids, std::move(snap)));
+	REQUIRE(history.GetUndoDepth() == 1);
+	CHECK(std::string(history.PeekUndoName()) == "Delete Entities");
+
+	// A single Undo brings every entity back.
+	history.Undo(world);
+	for (int i = 0; i < 3; ++i)
+	{
+		const Entity restored = world.FindEntityByUUID(ids[i]);
+		REQUIRE(restored.IsValid());
+		CHECK(restored.GetComponent<TransformComponent>().Position.x == static_cast<float>(i));
+	}
+	CHECK_FALSE(history.CanUndo());
+
+	// A single Redo deletes them all again.
+	history.Redo(world);
+	world.FlushDestroyQueue();
+	for (const UUID id : ids)
+	{
+		CHECK_FALSE(world.FindEntityByUUID(id).IsValid());
+	}
+}
+
 TEST_CASE("ComponentEditCommand undo/redo restores serialized before/after", "[editor][undo]")
 {
 	World world;
@@ -217,3 +262,170 @@ TEST_CASE("History: a new action clears the redo stack", "[editor][undo]")
 	history.Push(CreateRef<RenameCommand>(id, "E", "E2"));
 	REQUIRE_FALSE(history.CanRedo());
 }
+
+TEST_CASE("ByteDelta stores only changed runs and applies both ways", "[editor][undo]")
+{
+	TransformComponent before;
+	TransformComponent after = before;
+	after.Position.y = 4.0f;
+	after.Scale.z = 2.0f;
+
+	const ByteDelta delta = ByteDelta::Diff(AsBytes(before), AsBytes(after));
+	REQUIRE_FALSE(delta.IsEmpty());
+	CHECK(delta.GetMemoryBytes() - sizeof(ByteDelta) < 2 * sizeof(TransformComponent));
+
+	TransformComponent value = after;
+	delta.ApplyBefore(AsWritableBytes(value));
+	CHECK(value.Position.y == 0.0f);
+	CHECK(value.Scale.z == 1.0f);
+	delta.ApplyAfter(AsWritableBytes(value));
+	CHECK(value.Position.y == 4.0f);
+	CHECK(value.Scale.z == 2.0f);
+
+	CHECK(ByteDelta::Diff(AsBytes(before), AsBytes(before)).IsEmpty());
+
+	SECTION("Merging keeps the first before and the last after")
+	{
+		TransformComponent last = after;
+		last.Position.x = 9.0f;
+		last.Scale.z = 1.0f; // back to where it started
+		const ByteDelta merged = ByteDelta::Merge(delta, ByteDelta::Diff(AsBytes(after), AsBytes(last)));
+
+		value = last;
+		merged.ApplyBefore(AsWritableBytes(value));
+		CHECK(value.Position == before.Position);
+		CHECK(value.Scale == before.Scale);
+		merged.ApplyAfter(AsWritableBytes(value));
+		CHECK(value.Position == last.Position);
+
+		const ByteDelta roundTrip = ByteDelta::Merge(delta, ByteDelta::Diff(AsBytes(after), AsBytes(before)));
+		CHECK(roundTrip.IsEmpty());
+	}
+}
+
+TEST_CASE("A batched component delta moves thousands of entities in one step", "[editor][undo]")
+{
+	World world;
+	std::vector<UUID> ids;
+	std::vector<TransformComponent> before;
+	std::vector<TransformComponent> after;
+	for (int i = 0; i < 5000; ++i)
+	{
+		Entity e = world.CreateEntity("E");
+		TransformComponent& t = e.AddComponent<TransformComponent>();
+		t.Position = glm::vec3(static_cast<float>(i), 1.0f, 2.0f);
+		ids.push_back(e.GetComponent<IDComponent>().Id);
+		before.push_back(t);
+		t.Position.x += 10.0f;
+		after.push_back(t);
+	}
+	world.CreateEntity("Bystander").AddComponent<TransformComponent>().Position = glm::vec3(-1.0f);
+
+	const Ref<ComponentDeltaCommand> command =
+	    ComponentDeltaCommand::Create<TransformComponent>("Move", ids, before, after);
+	REQUIRE(command);
+	CHECK(command->GetEntityCount() == 5000);
+	// Deltas of one float each, well under two whole components per entity.
+	CHECK(command->GetMemoryBytes() < ids.size() * 2 * sizeof(TransformComponent));
+
+	EditorHistorySingleton history;
+	history.Push(command);
+
+	history.Undo(world);
+	for (size_t i = 0; i < ids.size(); i += 997)
+	{
+		CHECK(world.FindEntityByUUID(ids[i]).GetComponent<TransformComponent>().Position == before[i].Position);
+	}
+	history.Redo(world);
+	for (size_t i = 0; i < ids.size(); i += 997)
+	{
+		CHECK(world.FindEntityByUUID(ids[i]).GetComponent<TransformComponent>().Position == after[i].Position);
+	}
+
+	// Nothing changed: no command at all.
+	CHECK_FALSE(ComponentDeltaCommand::Create<TransformComponent>("Move", ids, before, before));
+}
+
+TEST_CASE("History: consecutive moves of the same entity coalesce", "[editor][undo]")
+{
+	World world;
+	Entity a = world.CreateEntity("A");
+	a.AddComponent<TransformComponent>();
+	Entity b = world.CreateEntity("B");
+	b.AddComponent<TransformComponent>();
+	const UUID idA = a.GetComponent<IDComponent>().Id;
+	const UUID idB = b.GetComponent<IDComponent>().Id;
+
+	EditorHistorySingleton history;
+	const auto move = [&](Entity e, const UUID id, const float x)
+	{
+		const TransformComponent from = e.GetComponent<TransformComponent>();
+		TransformComponent to = from;
+		to.Position.x = x;
+		e.PatchComponent<TransformComponent>([&](TransformComponent& t)
+		                                     { t = to; });
+		history.Push(CreateRef<TransformCommand>(id, from, to));
+	};
+
+	move(a, idA, 1.0f);
+	move(a, idA, 2.0f);
+	move(a, idA, 3.0f);
+	CHECK(history.GetUndoDepth() == 1);
+
+	move(b, idB, 5.0f); // another entity: its own step
+	CHECK(history.GetUndoDepth() == 2);
+
+	history.Undo(world);
+	history.Undo(world);
+	CHECK(world.FindEntityByUUID(idA).GetComponent<TransformComponent>().Position.x == 0.0f);
+	history.Redo(world);
+	CHECK(world.FindEntityByUUID(idA).GetComponent<TransformComponent>().Position.x == 3.0f);
+
+	// Never into the saved state: after a save the next move is a step of its own.
+	history.Redo(world);
+	history.MarkSaved();
+	move(b, idB, 6.0f);
+	CHECK(history.GetUndoDepth() == 3);
+	CHECK(history.IsDirty());
+	history.Undo(world);
+	CHECK_FALSE(history.IsDirty());
+}
+
+TEST_CASE("History: the oldest steps go once the byte budget is exceeded", "[editor][undo]")
+{
+	World world;
+	Entity e = world.CreateEntity("E");
+	const UUID id = e.GetComponent<IDComponent>().Id;
+
+	EditorHistorySingleton history;
+	history.MarkSaved();
+	for (int i = 0; i < 10; ++i)
+	{
+		history.Push(CreateRef<RenameCommand>(id, "Name" + std::to_string(i), "Name" + std::to_string(i + 1)));
+	}
+	REQUIRE(history.GetUndoDepth() == 10);
+	const size_t perStep = history.GetMemoryBytes() / 10;
+
+	history.SetBudgetBytes(perStep * 4);
+	CHECK(history.GetUndoDepth() <= 4);
+	CHECK(history.GetMemoryBytes() <= history.GetBudgetBytes());
+	CHECK(history.IsDirty()); // the saved state was trimmed away: dirty until the next save
+
+	// The newest step survives any budget.
+	history.SetBudgetBytes(1);
+	CHECK(history.GetUndoDepth() == 1);
+	history.Undo(world);
+	CHECK(world.FindEntityByUUID(id).GetComponent<TagComponent>().Tag == "Name9");
+}
+
+TEST_CASE("ComponentEditCommand keeps only the fields the edit changed", "[editor][undo]")
+{
+	const nlohmann::json before = {{"Position", {1.0f, 1.0f, 1.0f}}, {"Rotation", {0.0f, 0.0f, 0.0f}}, {"Scale", {1.0f, 1.0f, 1.0f}}};
+	nlohmann::json after = before;
+	after["Position"] = {5.0f, 1.0f, 1.0f};
+
+	const ComponentEditCommand command(UUID{1}, "Snowstorm::TransformComponent", before, after);
+	CHECK(command.GetBefore().size() == 1);
+	CHECK(command.GetBefore().contains("Position"));
+	CHECK(command.GetAfter()["Position"][0] == 5.0f);
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Events/EventBus.hpp"
+#include "Snowstorm/Events/KeyEvent.hpp"
+
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace Snowstorm;
+
+// Immediate handlers run in priority order inside Publish; deferred events are posted from any thread and
+// delivered to each handler as one batch per DispatchDeferred, in posting order per thread, none lost.
+
+namespace
+{
+	struct TestProgressEvent
+	{
+		int Thread = 0;
+		int Sequence = 0;
+	};
+
+	struct TestOtherEvent
+	{
+		int Value = 0;
+	};
+}
+
+TEST_CASE("EventBus runs immediate handlers by priority and stops when consumed", "[events]")
+{
+	EventBus bus;
+	std::vector<int> order;
+
+	auto low = bus.Subscribe<KeyPressedEvent>([&](const KeyPressedEvent&)
+	                                          { order.push_back(0); return false; }, 0);
+	auto high = bus.Subscribe<KeyPressedEvent>([&](const KeyPressedEvent&)
+	                                           { order.push_back(2); return false; }, 10);
+	auto lowSecond = bus.Subscribe<KeyPressedEvent>([&](const KeyPressedEvent&)
+	                                                { order.push_back(1); return false; }, 0);
+
+	KeyPressedEvent press(65, false);
+	bus.Publish(press);
+	CHECK(order == std::vector<int>{2, 0, 1}); // equal priorities keep subscription order
+
+	// A consuming handler stops propagation; a disconnected one no longer runs.
+	order.clear();
+	auto consumer = bus.Subscribe<KeyPressedEvent>([&](const KeyPressedEvent&)
+	                                               { order.push_back(5); return true; }, 5);
+	high.Disconnect();
+	KeyPressedEvent again(65, false);
+	bus.Publish(again);
+	CHECK(order == std::vector<int>{5});
+	CHECK(again.Handled);
+}
+
+TEST_CASE("EventBus delivers deferred events in one batch per dispatch", "[events]")
+{
+	EventBus bus;
+	int calls = 0;
+	std::vector<int> received;
+	auto connection = bus.SubscribeDeferred<TestOtherEvent>([&](const std::span<const TestOtherEvent> batch)
+	                                                        {
+		++calls;
+		for (const TestOtherEvent& e : batch)
+		{
+			received.push_back(e.Value);
+		} });
+
+	bus.DispatchDeferred();
+	CHECK(calls == 0); // nothing posted: no call
+
+	for (int i = 0; i < 5; ++i)
+	{
+		bus.Post(TestOtherEvent{i});
+	}
+	bus.Post(TestProgressEvent{}); // another channel: not delivered to this handler
+	CHECK(received.empty());       // nothing runs before the dispatch
+
+	bus.DispatchDeferred();
+	CHECK(calls == 1);
+	CHECK(received == std::vector<int>{0, 1, 2, 3, 4});
+
+	bus.DispatchDeferred();
+	CHECK(calls == 1);
+
+	connection.Disconnect();
+	bus.Post(TestOtherEvent{9});
+	bus.DispatchDeferred();
+	CHECK(calls == 1);
+}
+
+TEST_CASE("EventBus deferred handlers may subscribe and disconnect during a dispatch", "[events]")
+{
+	EventBus bus;
+	int first = 0;
+	int added = 0;
+	EventBus::Connection late;
+	EventBus::Connection self;
+	self = bus.SubscribeDeferred<TestOtherEvent>([&](std::span<const TestOtherEvent>)
+	                                             {
+		++first;
+		self.Disconnect(); // one-shot
+		late = bus.SubscribeDeferred<TestOtherEvent>([&](std::span<const TestOtherEvent>) { ++added; }); });
+
+	bus.Post(TestOtherEvent{1});
+	bus.DispatchDeferred();
+	CHECK(first == 1);
+	CHECK(added == 0); // joined after this dispatch
+
+	bus.Post(TestOtherEvent{2});
+	bus.DispatchDeferred();
+	CHECK(first == 1);
+	CHECK(added == 1);
+}
+
+TEST_CASE("EventBus deferred posts from many threads arrive complete and in per-thread order", "[events]")
+{
+	EventBus bus;
+	constexpr int kThreads = 8;
+	// More than one queue's worth in total, so posting spills into the overflow path too.
+	constexpr int kPerThread = 2 * static_cast<int>(EventBus::kDeferredQueueCapacity) / kThreads + 100;
+
+	std::vector<int> next(kThreads, 0);
+	size_t received = 0;
+	bool ordered = true;
+	auto connection = bus.SubscribeDeferred<TestProgressEvent>([&](const std::span<const TestProgressEvent> batch)
+	                                                           {
+		for (const TestProgressEvent& e : batch)
+		{
+			ordered &= e.Sequence == next[e.Thread];
+			next[e.Thread] = e.Sequence + 1;
+			++received;
+		} });
+
+	// Dispatch on this thread while the workers post, as the frame loop would.
+	std::atomic<int> running = kThreads;
+	std::vector<std::thread> workers;
+	workers.reserve(kThreads);
+	for (int t = 0; t < kThreads; ++t)
+	{
+		workers.emplace_back([&bus, &running, t]
+		                     {
+			for (int i = 0; i < kPerThread; ++i)
+			{
+				bus.Post(TestProgressEvent{t, i});
+			}
+			--running; });
+	}
+	while (running > 0)
+	{
+		bus.DispatchDeferred();
+	}
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	bus.DispatchDeferred();
+	bus.DispatchDeferred(); // a slot claimed but not yet filled during the previous pass lands now
+
+	CHECK(ordered);
+	CHECK(received == static_cast<size_t>(kThreads) * kPerThread);
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Panels/HierarchyModel.hpp"
+#include "Singletons/EditorSelectionSingleton.hpp"
+#include "Snowstorm/Components/TagComponent.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Snowstorm/World/World.hpp"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+using namespace Snowstorm;
+
+// The hierarchy's cached rows follow entity adds/removes and renames, and its search runs inline for small
+// scenes and on a worker for large ones, refining the previous matches when the query grows.
+
+namespace
+{
+	// One editor frame's worth: update the model, then end the frame (tracking is cleared, as SystemManager does).
+	void Frame(HierarchyModel& model, World& world, JobSystem* jobs = nullptr)
+	{
+		model.Update(world, jobs);
+		world.GetRegistry().ClearTrackedComponents();
+	}
+
+	bool HasRow(const HierarchyModel& model, const Entity e)
+	{
+		const auto rows = model.GetRows();
+		return std::ranges::find(rows, e.Handle()) != rows.end();
+	}
+}
+
+TEST_CASE("HierarchyModel rows follow adds, destroys and renames", "[editor][hierarchy]")
+{
+	World world;
+	HierarchyModel model;
+
+	const Entity alpha = world.CreateEntity("Alpha");
+	const Entity beta = world.CreateEntity("beta");
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 2);
+
+	const Entity gamma = world.CreateEntity("Gamma");
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 3);
+	CHECK(HasRow(model, gamma));
+
+	// Case-insensitive substring.
+	model.SetFilter("AL");
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 1);
+	CHECK(HasRow(model, alpha));
+	CHECK(model.GetTotalRowCount() == 3);
+
+	// A rename is reported, not discovered.
+	gamma.WriteComponent<TagComponent>().Tag = "Gallery";
+	model.MarkNamesDirty();
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 2);
+	CHECK(HasRow(model, gamma));
+
+	world.DestroyEntity(alpha);
+	world.FlushDestroyQueue();
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 1);
+	CHECK(HasRow(model, gamma));
+
+	model.SetFilter("");
+	Frame(model, world);
+	CHECK(model.GetRows().size() == 2);
+	CHECK(HasRow(model, beta));
+}
+
+TEST_CASE("HierarchyModel searches large scenes on a worker and refines the last result", "[editor][hierarchy]")
+{
+	World world;
+	JobSystem jobs;
+	HierarchyModel model;
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		world.CreateEntity("Rotator " + std::to_string(i));
+	}
+	Frame(model, world, &jobs);
+	REQUIRE(model.GetRows().size() == 10000);
+
+	const auto settle = [&]
+	{
+		Frame(model, world, &jobs);
+		while (model.IsSearching())
+		{
+			std::this_thread::yield();
+			Frame(model, world, &jobs);
+		}
+	};
+
+	// "rotator 99", 990..999, 9900..9999.
+	model.SetFilter("rotator 99");
+	settle();
+	CHECK(model.GetRows().size() == 111);
+
+	// Narrowing only looks at those 111 (inline): 999 and 9990..9999.
+	model.SetFilter("rotator 999");
+	settle();
+	CHECK(model.GetRows().size() == 11);
+
+	// A new entity joins the search once the rows are rebuilt.
+	world.CreateEntity("Rotator 9990000");
+	settle();
+	CHECK(model.GetRows().size() == 12);
+}
+
+TEST_CASE("Hierarchy multi-select ranges are slices of the rows", "[editor][hierarchy]")
+{
+	World world;
+	HierarchyModel model;
+	for (int i = 0; i < 10; ++i)
+	{
+		world.CreateEntity("E" + std::to_string(i));
+	}
+	Frame(model, world);
+
+	const auto rows = model.GetRows();
+	CHECK(model.GetRowRange(7, 3).size() == 5); // either order, inclusive
+	CHECK(model.GetRowRange(8, 50).size() == 2);  // clamped to the list
+
+	EditorSelectionSingleton selection;
+	const Entity first{rows[2], &world};
+	const Entity last{rows[5], &world};
+	selection.SelectEntity(first);
+	selection.AddEntities(model.GetRowRange(2, 5), last);
+	CHECK(selection.Selection.size() == 4);
+	CHECK(selection.Selected == last);
+	CHECK(selection.IsSelected(Entity{rows[3], &world}));
+	CHECK_FALSE(selection.IsSelected(Entity{rows[6], &world}));
+
+	// Ctrl-click the primary off: another selected entity takes over.
+	selection.ToggleEntity(last);
+	CHECK(selection.Selection.size() == 3);
+	CHECK(selection.Selected);
+	CHECK(selection.IsSelected(selection.Selected));
+
+	selection.SelectEntity(first);
+	CHECK(selection.Selection.size() == 1);
+	selection.ClearSelection();
+	CHECK(selection.Selection.empty());
+	CHECK_FALSE(selection.Selected);
+}
@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/FileWatcher.hpp"
+#include "Snowstorm/Core/SpscQueue.hpp"
+#include "Snowstorm/Render/ShaderDependencies.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	void WriteFile(const std::filesystem::path& p, const std::string& text)
+	{
+		std::filesystem::create_directories(p.parent_path());
+		std::ofstream out(p, std::ios::binary | std::ios::trunc);
+		out << text;
+	}
+
+	std::filesystem::path Normal(const std::filesystem::path& p)
+	{
+		return std::filesystem::absolute(p).lexically_normal();
+	}
+}
+
+TEST_CASE("ParseShaderIncludes finds directives and skips comments", "[hotreload]")
+{
+	const std::string source =
+	    "#include \"Include/Engine.hlsli\"\n"
+	    "  #  include <SkyCommon.hlsli>\n"
+	    "// #include \"Commented.hlsli\"\n"
+	    "/* #include \"Block.hlsli\"\n"
+	    "   #include \"StillBlock.hlsli\" */ #include \"AfterBlock.hlsli\"\n"
+	    "#ifdef SS_RAYTRACING\n"
+	    "#include \"Include/RTGeometry.hlsli\" // trailing comment\n"
+	    "#endif\n"
+	    "#define INCLUDE_ME 1\n"
+	    "#include \"\"\n";
+
+	const std::vector<std::string> includes = ParseShaderIncludes(source);
+	// The conditional include counts: over-reporting a dependency only costs a spurious recompile.
+	CHECK(includes == std::vector<std::string>{"Include/Engine.hlsli", "SkyCommon.hlsli", "AfterBlock.hlsli", "Include/RTGeometry.hlsli"});
+}
+
+// The dependency map must cover exactly what a shader reaches: transitive includes resolved relative to the
+// includer first and then the include dir, cycles cut, and unrelated headers in the same folder left out (the
+// old key hashed every header into every shader).
+TEST_CASE("CollectShaderIncludes returns the transitive closure only", "[hotreload]")
+{
+	const ScratchDirectory scratch("ss_shader_deps");
+	const std::filesystem::path& dir = scratch.GetPath();
+	WriteFile(dir / "Lit.frag.hlsl", "#include \"Include/Engine.hlsli\"\n#include \"Missing.hlsli\"\n");
+	WriteFile(dir / "Include" / "Engine.hlsli", "#include \"GBufferEncode.hlsli\"\n#include \"Include/MeshInput.hlsli\"\n");
+	WriteFile(dir / "Include" / "GBufferEncode.hlsli", "#include \"Engine.hlsli\"\n"); // cycle back
+	WriteFile(dir / "Include" / "MeshInput.hlsli", "float4 Dummy;\n");                 // via the include dir
+	WriteFile(dir / "Include" / "RTGeometry.hlsli", "float4 Unrelated;\n");
+
+	const std::vector<std::filesystem::path> closure = CollectShaderIncludes(dir / "Lit.frag.hlsl", {dir});
+	CHECK(closure == std::vector<std::filesystem::path>{
+	                     Normal(dir / "Include" / "Engine.hlsli"),
+	                     Normal(dir / "Include" / "GBufferEncode.hlsli"),
+	                     Normal(dir / "Include" / "MeshInput.hlsli"),
+	                 });
+
+	// A header's own closure excludes itself even through a cycle.
+	CHECK(CollectShaderIncludes(dir / "Include" / "GBufferEncode.hlsli", {dir}) ==
+	      std::vector<std::filesystem::path>{Normal(dir / "Include" / "Engine.hlsli"), Normal(dir / "Include" / "MeshInput.hlsli")});
+}
+
+TEST_CASE("FileWatcher keys are absolute and separator-normalized", "[hotreload]")
+{
+	CHECK(FileWatcher::MakeKey("Engine/Shaders/../Shaders/Include/Engine.hlsli") == FileWatcher::MakeKey("Engine/Shaders/Include/Engine.hlsli"));
+	CHECK(std::filesystem::path(FileWatcher::MakeKey("Engine/Shaders")).is_absolute());
+	CHECK(FileWatcher::MakeKey("Engine/Shaders").find('\\') == std::string::npos);
+}
+
+TEST_CASE("SpscQueue is a bounded FIFO", "[hotreload]")
+{
+	SpscQueue<int> queue(3);
+	REQUIRE(queue.Capacity() == 4); // rounded up to a power of two
+
+	for (int i = 0; i < 4; ++i)
+	{
+		CHECK(queue.TryPush(i));
+	}
+	CHECK_FALSE(queue.TryPush(99)); // full is reported, not waited out
+	CHECK(queue.SizeApprox() == 4);
+
+	int value = -1;
+	for (int i = 0; i < 4; ++i)
+	{
+		REQUIRE(queue.TryPop(value));
+		CHECK(value == i);
+	}
+	CHECK_FALSE(queue.TryPop(value));
+
+	// Indices keep counting past the capacity: wraparound must preserve order.
+	for (int round = 0; round < 10; ++round)
+	{
+		CHECK(queue.TryPush(round));
+		REQUIRE(queue.TryPop(value));
+		CHECK(value == round);
+	}
+}
+
+// One producer and one consumer thread, no locks: every item arrives exactly once and in order.
+TEST_CASE("SpscQueue preserves order across threads", "[hotreload]")
+{
+	constexpr int kCount = 200000;
+	SpscQueue<int> queue(64);
+
+	std::thread producer([&]
+	                     {
+		for (int i = 0; i < kCount;)
+		{
+			if (queue.TryPush(i))
+			{
+				++i;
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		} });
+
+	int expected = 0;
+	bool inOrder = true;
+	while (expected < kCount)
+	{
+		int value = 0;
+		if (queue.TryPop(value))
+		{
+			inOrder = inOrder && value == expected;
+			++expected;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	producer.join();
+
+	CHECK(inOrder);
+	CHECK(queue.SizeApprox() == 0);
+}
@@ -0,0 +1,182 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Render/Quality/ImageMetrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace Snowstorm;
+using namespace Snowstorm::Quality;
+
+namespace
+{
+	MetricImage Noise(const uint32_t w, const uint32_t h, const uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+		MetricImage image{w, h, std::vector<float>(3 * static_cast<size_t>(w) * h)};
+		for (float& v : image.Planes)
+		{
+			v = dist(rng);
+		}
+		return image;
+	}
+
+	// A smooth test card (gradients + a few edges) so the multi-scale and feature terms have structure.
+	MetricImage Card(const uint32_t w, const uint32_t h)
+	{
+		MetricImage image{w, h, std::vector<float>(3 * static_cast<size_t>(w) * h)};
+		const size_t n = static_cast<size_t>(w) * h;
+		for (uint32_t y = 0; y < h; ++y)
+		{
+			for (uint32_t x = 0; x < w; ++x)
+			{
+				const size_t i = static_cast<size_t>(y) * w + x;
+				const float checker = ((x / 8 + y / 8) % 2) ? 0.8f : 0.2f;
+				image.Planes[i] = static_cast<float>(x) / w;
+				image.Planes[n + i] = checker;
+				image.Planes[2 * n + i] = 0.5f + 0.4f * std::sin(0.2f * static_cast<float>(x + y));
+			}
+		}
+		return image;
+	}
+
+	MetricImage AddNoise(MetricImage image, const float amplitude, const uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> dist(-amplitude, amplitude);
+		for (float& v : image.Planes)
+		{
+			v = std::clamp(v + dist(rng), 0.0f, 1.0f);
+		}
+		return image;
+	}
+
+	// Metrics.comp.hlsl's windowed SSIM, transcribed literally: per pixel, a clamped 7x7 box of luma moments.
+	double ShaderSsim(const MetricImage& test, const MetricImage& reference)
+	{
+		const std::vector<float> a = Luma(test);
+		const std::vector<float> b = Luma(reference);
+		const int w = static_cast<int>(test.Width), h = static_cast<int>(test.Height);
+		double total = 0.0;
+		for (int py = 0; py < h; ++py)
+		{
+			for (int px = 0; px < w; ++px)
+			{
+				float sa = 0, sb = 0, saa = 0, sbb = 0, sab = 0, count = 0;
+				for (int dy = -3; dy <= 3; ++dy)
+				{
+					for (int dx = -3; dx <= 3; ++dx)
+					{
+						const size_t q = static_cast<size_t>(std::clamp(py + dy, 0, h - 1)) * w + std::clamp(px + dx, 0, w - 1);
+						sa += a[q];
+						sb += b[q];
+						saa += a[q] * a[q];
+						sbb += b[q] * b[q];
+						sab += a[q] * b[q];
+						count += 1.0f;
+					}
+				}
+				const float inv = 1.0f / count;
+				const float ma = sa * inv, mb = sb * inv;
+				const float va = std::max(saa * inv - ma * ma, 0.0f);
+				const float vb = std::max(sbb * inv - mb * mb, 0.0f);
+				const float cab = sab * inv - ma * mb;
+				const float num = (2.0f * ma * mb + 0.0001f) * (2.0f * cab + 0.0009f);
+				const float den = (ma * ma + mb * mb + 0.0001f) * (va + vb + 0.0009f);
+				total += std::clamp(num / den, 0.0f, 1.0f);
+			}
+		}
+		return total / (static_cast<double>(w) * h);
+	}
+}
+
+TEST_CASE("Image metrics of identical images are ideal", "[quality]")
+{
+	const MetricImage card = Card(64, 48);
+	CHECK(*Psnr(card, card) == 100.0);
+	CHECK(std::abs(*Ssim(card, card) - 1.0) < 1e-9);
+	CHECK(std::abs(*Ssim(card, card, SsimWindow::Gaussian11) - 1.0) < 1e-9);
+	CHECK(std::abs(*MsSsim(card, card) - 1.0) < 1e-9);
+	CHECK(*Flip(card, card) == 0.0);
+
+	const MetricImage other = Card(32, 48);
+	CHECK_FALSE(Psnr(card, other));
+	CHECK_FALSE(Flip(card, other));
+}
+
+// A uniform 0.1 luma offset is an MSE of 0.01: exactly 20 dB.
+TEST_CASE("PSNR of a constant offset", "[quality]")
+{
+	MetricImage a{16, 16, std::vector<float>(3 * 256, 0.3f)};
+	MetricImage b{16, 16, std::vector<float>(3 * 256, 0.4f)};
+	CHECK(std::abs(*Psnr(a, b) - 20.0) < 1e-4);
+}
+
+// The CPU gate is only useful if it agrees with the GPU pass it stands in for.
+TEST_CASE("Box7 SSIM matches the MetricsPass shader", "[quality]")
+{
+	const MetricImage ref = Card(45, 37);
+	for (const float amplitude : {0.02f, 0.1f, 0.4f})
+	{
+		const MetricImage test = AddNoise(ref, amplitude, 7);
+		CHECK(std::abs(*Ssim(test, ref) - ShaderSsim(test, ref)) < 1e-5);
+	}
+	const MetricImage a = Noise(23, 19, 1), b = Noise(23, 19, 2);
+	CHECK(std::abs(*Ssim(a, b) - ShaderSsim(a, b)) < 1e-5);
+}
+
+// Row bands on workers must not change a single bit: CI baselines are compared exactly across machines with
+// different core counts.
+TEST_CASE("Threaded image metrics are bit-identical to serial", "[quality]")
+{
+	const MetricImage ref = Card(160, 120);
+	const MetricImage test = AddNoise(ref, 0.15f, 3);
+	JobSystem jobs;
+	CHECK(*Psnr(test, ref, &jobs) == *Psnr(test, ref));
+	CHECK(*Ssim(test, ref, SsimWindow::Gaussian11, &jobs) == *Ssim(test, ref, SsimWindow::Gaussian11));
+	CHECK(*MsSsim(test, ref, &jobs) == *MsSsim(test, ref));
+	CHECK(*Flip(test, ref, kFlipDefaultPixelsPerDegree, &jobs) == *Flip(test, ref));
+}
+
+TEST_CASE("SSIM, MS-SSIM and FLIP degrade monotonically with noise", "[quality]")
+{
+	const MetricImage ref = Card(128, 96);
+	double lastSsim = 1.0, lastMsSsim = 1.0, lastFlip = 0.0;
+	for (const float amplitude : {0.02f, 0.08f, 0.3f})
+	{
+		const MetricImage test = AddNoise(ref, amplitude, 11);
+		const double ssim = *Ssim(test, ref, SsimWindow::Gaussian11);
+		const double msSsim = *MsSsim(test, ref);
+		const double flip = *Flip(test, ref);
+		CHECK(ssim < lastSsim);
+		CHECK(msSsim < lastMsSsim);
+		CHECK(flip > lastFlip);
+		CHECK(flip <= 1.0);
+		lastSsim = ssim;
+		lastMsSsim = msSsim;
+		lastFlip = flip;
+	}
+}
+
+TEST_CASE("MetricImageFromNpy normalizes uint8 captures", "[quality]")
+{
+	NpyArray npy;
+	npy.Shape = {1, 2, 4};
+	npy.DType = NpyDType::UInt8;
+	npy.Data = {255, 0, 51, 255, 0, 102, 255, 255};
+	const auto image = MetricImageFromNpy(npy, "capture");
+	REQUIRE(image);
+	CHECK(image->Width == 2);
+	CHECK(image->Height == 1);
+	CHECK(image->Plane(0)[0] == 1.0f);
+	CHECK(image->Plane(1)[1] == 102.0f / 255.0f);
+	CHECK(image->Plane(2)[0] == 51.0f / 255.0f);
+
+	npy.Shape = {2, 4};
+	CHECK_FALSE(MetricImageFromNpy(npy, "flat"));
+}
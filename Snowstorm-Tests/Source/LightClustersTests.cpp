@@ -0,0 +1,223 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Lighting/LightClusters.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	LightClusterView MakeView(const glm::mat4& projection)
+	{
+		LightClusterView view;
+		view.View = glm::lookAtRH(glm::vec3(3.0f, 2.0f, 12.0f), glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		view.ViewProjection = projection * view.View;
+		return view;
+	}
+
+	glm::mat4 MakePerspective()
+	{
+		return glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+	}
+
+	struct Scene
+	{
+		std::vector<GPUPointLight> Points;
+		std::vector<GPUSpotLight> Spots;
+	};
+
+	// More lights than the old 16 + 16 FrameCB arrays could hold, scattered through the view.
+	Scene RandomScene(const uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> xy(-30.0f, 30.0f);
+		std::uniform_real_distribution<float> z(-90.0f, 10.0f);
+		std::uniform_real_distribution<float> range(0.5f, 12.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::uniform_real_distribution<float> angle(5.0f, 80.0f);
+
+		Scene scene;
+		for (int i = 0; i < 300; ++i)
+		{
+			GPUPointLight light{};
+			light.Position = {xy(rng), xy(rng) * 0.5f, z(rng)};
+			light.Range = range(rng);
+			scene.Points.push_back(light);
+		}
+		for (int i = 0; i < 120; ++i)
+		{
+			GPUSpotLight light{};
+			light.Position = {xy(rng), xy(rng) * 0.5f, z(rng)};
+			light.Range = range(rng) * 2.0f;
+			glm::vec3 direction{unit(rng), unit(rng), unit(rng)};
+			if (glm::dot(direction, direction) < 1e-3f)
+			{
+				direction = {0.0f, -1.0f, 0.0f};
+			}
+			light.Direction = glm::normalize(direction);
+			light.CosOuter = std::cos(glm::radians(angle(rng)));
+			light.CosInner = std::min(light.CosOuter + 0.05f, 1.0f);
+			scene.Spots.push_back(light);
+		}
+		return scene;
+	}
+
+	// Brute-force influence: inside the range sphere, and for a spot also inside its outer cone.
+	bool PointReaches(const GPUPointLight& light, const glm::vec3& p)
+	{
+		return glm::length(p - light.Position) < light.Range * 0.999f;
+	}
+
+	bool SpotReaches(const GPUSpotLight& light, const glm::vec3& p)
+	{
+		const glm::vec3 toP = p - light.Position;
+		const float dist = glm::length(toP);
+		if (dist >= light.Range * 0.999f)
+		{
+			return false;
+		}
+		return dist < 1e-4f || glm::dot(toP / dist, light.Direction) > light.CosOuter + 1e-4f;
+	}
+
+	// World positions spread over the visible frustum (inverse-projected random NDC points).
+	std::vector<glm::vec3> SampleFrustum(const glm::mat4& viewProjection, const uint32_t seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> ndc(-0.999f, 0.999f);
+		std::uniform_real_distribution<float> depth(0.0f, 0.9999f);
+		const glm::mat4 inverse = glm::inverse(viewProjection);
+		std::vector<glm::vec3> samples;
+		for (int i = 0; i < 4000; ++i)
+		{
+			const glm::vec4 p = inverse * glm::vec4(ndc(rng), ndc(rng), depth(rng), 1.0f);
+			samples.push_back(glm::vec3(p) / p.w);
+		}
+		return samples;
+	}
+
+	bool Lists(const LightClusterGrid& grid, const GPULightCluster& cluster, const uint32_t first, const uint32_t count,
+	           const uint32_t light)
+	{
+		const auto begin = grid.LightIndices.begin() + cluster.Offset + first;
+		return std::binary_search(begin, begin + count, light);
+	}
+
+	void CheckConservative(const LightClusterView& view, const Scene& scene, const LightClusterGrid& grid)
+	{
+		for (const glm::vec3& p : SampleFrustum(view.ViewProjection, 5))
+		{
+			const uint32_t index = LightClusterIndexAt(grid, view.ViewProjection, p);
+			REQUIRE(index < kLightClusterCount);
+			const GPULightCluster& cluster = grid.Clusters[index];
+			for (uint32_t i = 0; i < scene.Points.size(); ++i)
+			{
+				if (PointReaches(scene.Points[i], p))
+				{
+					CHECK(Lists(grid, cluster, 0, cluster.PointCount, i));
+				}
+			}
+			for (uint32_t i = 0; i < scene.Spots.size(); ++i)
+			{
+				if (SpotReaches(scene.Spots[i], p))
+				{
+					CHECK(Lists(grid, cluster, cluster.PointCount, cluster.SpotCount, i));
+				}
+			}
+		}
+	}
+}
+
+// The grid may over-include (that's only wasted shading), but a light missing from the froxel of a pixel it
+// reaches is a visible hole -- so bin against a brute-force reference over random frustum points.
+TEST_CASE("Light clusters list every light that reaches a point", "[lighting]")
+{
+	const LightClusterView view = MakeView(MakePerspective());
+	const Scene scene = RandomScene(1);
+
+	LightClusterGrid grid;
+	BuildLightClusters(view, scene.Points, scene.Spots, grid);
+	REQUIRE(grid.Params.Enabled == 1);
+	REQUIRE(grid.Clusters.size() == kLightClusterCount);
+	CheckConservative(view, scene, grid);
+
+	// Culling must actually cull: the average froxel sees a small fraction of the lights.
+	size_t listed = 0;
+	for (const GPULightCluster& cluster : grid.Clusters)
+	{
+		CHECK(cluster.Offset + cluster.PointCount + cluster.SpotCount <= grid.LightIndices.size());
+		CHECK(std::is_sorted(grid.LightIndices.begin() + cluster.Offset, grid.LightIndices.begin() + cluster.Offset + cluster.PointCount));
+		CHECK(std::is_sorted(grid.LightIndices.begin() + cluster.Offset + cluster.PointCount,
+		                     grid.LightIndices.begin() + cluster.Offset + cluster.PointCount + cluster.SpotCount));
+		listed += cluster.PointCount + cluster.SpotCount;
+	}
+	CHECK(listed / kLightClusterCount < (scene.Points.size() + scene.Spots.size()) / 10);
+}
+
+TEST_CASE("Light cluster slices follow the view depth", "[lighting]")
+{
+	const LightClusterView view = MakeView(MakePerspective());
+	LightClusterGrid grid;
+	BuildLightClusters(view, {}, {}, grid);
+	REQUIRE(grid.Params.Enabled == 1);
+	CHECK(grid.LightIndices.empty());
+
+	// Straight down the view axis: the slice index grows monotonically with distance, from 0 at near to the
+	// last slice at far.
+	const glm::mat4 viewToWorld = glm::inverse(view.View);
+	uint32_t lastSlice = 0;
+	for (const float depth : {0.1f, 0.5f, 2.0f, 10.0f, 50.0f, 199.0f})
+	{
+		const glm::vec3 p = glm::vec3(viewToWorld * glm::vec4(0.0f, 0.0f, -depth, 1.0f));
+		const uint32_t slice = LightClusterIndexAt(grid, view.ViewProjection, p) / (kLightClusterTilesX * kLightClusterTilesY);
+		CHECK(slice >= lastSlice);
+		lastSlice = slice;
+	}
+	CHECK(lastSlice == kLightClusterSlices - 1);
+}
+
+// One slice per job: the threaded build must produce the same buffers as the inline one.
+TEST_CASE("Threaded light clustering matches serial", "[lighting]")
+{
+	const LightClusterView view = MakeView(MakePerspective());
+	const Scene scene = RandomScene(2);
+
+	LightClusterGrid serial;
+	BuildLightClusters(view, scene.Points, scene.Spots, serial);
+
+	JobSystem jobs;
+	LightClusterGrid threaded;
+	BuildLightClusters(view, scene.Points, scene.Spots, threaded, &jobs);
+
+	REQUIRE(threaded.LightIndices == serial.LightIndices);
+	for (uint32_t i = 0; i < kLightClusterCount; ++i)
+	{
+		CHECK(threaded.Clusters[i].Offset == serial.Clusters[i].Offset);
+		CHECK(threaded.Clusters[i].PointCount == serial.Clusters[i].PointCount);
+		CHECK(threaded.Clusters[i].SpotCount == serial.Clusters[i].SpotCount);
+	}
+}
+
+TEST_CASE("Orthographic views cluster; degenerate ones disable the grid", "[lighting]")
+{
+	const LightClusterView ortho = MakeView(glm::orthoRH_ZO(-20.0f, 20.0f, -11.25f, 11.25f, 0.0f, 150.0f));
+	const Scene scene = RandomScene(3);
+	LightClusterGrid grid;
+	BuildLightClusters(ortho, scene.Points, scene.Spots, grid);
+	REQUIRE(grid.Params.Enabled == 1);
+	CheckConservative(ortho, scene, grid);
+
+	LightClusterView flat;
+	flat.ViewProjection = glm::mat4(0.0f);
+	BuildLightClusters(flat, scene.Points, scene.Spots, grid);
+	CHECK(grid.Params.Enabled == 0);
+	CHECK(LightClusterIndexAt(grid, flat.ViewProjection, glm::vec3(0.0f)) == std::numeric_limits<uint32_t>::max());
+}
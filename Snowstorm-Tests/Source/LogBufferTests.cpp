@@ -1,7 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "Snowstorm/Core/Log.hpp"
 #include "Snowstorm/Core/LogBuffer.hpp"
 
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -72,3 +74,115 @@ TEST_CASE("LogBuffer survives concurrent pushes without corruption", "[log]")
 
 	buf.Clear();
 }
+
+TEST_CASE("LogBuffer overwrites its oldest entries once full", "[log]")
+{
+	auto& buf = LogBuffer::Get();
+	buf.Clear();
+
+	constexpr size_t kExtra = 10;
+	for (size_t i = 0; i < LogBuffer::kCapacity + kExtra; ++i)
+	{
+		buf.Push(LogBuffer::Level::Info, std::to_string(i));
+	}
+
+	const auto snap = buf.Snapshot();
+	REQUIRE(snap.size() == LogBuffer::kCapacity);
+	CHECK(snap.front().Text == std::to_string(kExtra));
+	CHECK(snap.back().Text == std::to_string(LogBuffer::kCapacity + kExtra - 1));
+
+	buf.Clear();
+}
+
+TEST_CASE("LogBuffer ReadSince returns only the lines a reader hasn't seen", "[log]")
+{
+	auto& buf = LogBuffer::Get();
+	buf.Clear();
+
+	std::vector<LogBuffer::Entry> lines;
+	LogBuffer::ReadResult read = buf.ReadSince(0, lines);
+	CHECK(lines.empty());
+
+	buf.Push(LogBuffer::Level::Info, "a");
+	buf.Push(LogBuffer::Level::Warn, "b");
+	read = buf.ReadSince(read.Revision, lines);
+	CHECK_FALSE(read.Cleared);
+	REQUIRE(lines.size() == 2);
+	CHECK(lines[1].Text == "b");
+
+	lines.clear();
+	buf.Push(LogBuffer::Level::Info, "c");
+	read = buf.ReadSince(read.Revision, lines);
+	REQUIRE(lines.size() == 1);
+	CHECK(lines[0].Text == "c");
+
+	// Nothing new: nothing copied.
+	lines.clear();
+	read = buf.ReadSince(read.Revision, lines);
+	CHECK(lines.empty());
+
+	// A Clear in between is reported, followed by just the lines pushed after it.
+	buf.Push(LogBuffer::Level::Info, "gone");
+	buf.Clear();
+	buf.Push(LogBuffer::Level::Info, "d");
+	read = buf.ReadSince(read.Revision, lines);
+	CHECK(read.Cleared);
+	REQUIRE(lines.size() == 1);
+	CHECK(lines[0].Text == "d");
+
+	buf.Clear();
+}
+
+TEST_CASE("Log lines from worker threads reach the sinks in order after a flush", "[log]")
+{
+	// SS_* calls only queue a record; the log thread formats it. Flush waits for everything logged so far.
+	auto& buf = LogBuffer::Get();
+	Log::Flush();
+	buf.Clear();
+
+	constexpr int kThreads = 4;
+	constexpr int kPerThread = 200;
+
+	std::vector<std::thread> workers;
+	workers.reserve(kThreads);
+	for (int t = 0; t < kThreads; ++t)
+	{
+		workers.emplace_back([t]
+		                     {
+			const std::string name = "worker" + std::to_string(t);
+			for (int i = 0; i < kPerThread; ++i)
+			{
+				SS_CORE_TRACE("async-test {} {} {:.1f}", name, i, 0.5);
+			} });
+	}
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	Log::Flush();
+
+	std::vector<int> next(kThreads, 0);
+	size_t seen = 0;
+	for (const auto& e : buf.Snapshot())
+	{
+		const size_t at = e.Text.find("async-test worker");
+		if (at == std::string::npos)
+		{
+			continue;
+		}
+		// "async-test worker<t> <i> 0.5"
+		const std::string rest = e.Text.substr(at + 17);
+		const int t = std::stoi(rest);
+		const int i = std::stoi(rest.substr(rest.find(' ') + 1));
+		REQUIRE(t >= 0);
+		REQUIRE(t < kThreads);
+		CHECK(i == next[t]);
+		next[t] = i + 1;
+		CHECK(e.Text.ends_with(" 0.5"));
+		CHECK(e.LevelValue == LogBuffer::Level::Trace);
+		++seen;
+	}
+	CHECK(seen == static_cast<size_t>(kThreads) * kPerThread);
+
+	buf.Clear();
+}
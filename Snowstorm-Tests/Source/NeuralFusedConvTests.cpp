@@ -0,0 +1,156 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/Neural/NeuralFusedConv.hpp"
+
+#include <random>
+
+using namespace Snowstorm::Neural;
+
+namespace
+{
+	FeatureMap RandomMap(const uint32_t c, const uint32_t h, const uint32_t w, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		FeatureMap f;
+		f.Channels = c;
+		f.Height = h;
+		f.Width = w;
+		f.Data.resize(static_cast<size_t>(c) * h * w);
+		for (float& v : f.Data)
+		{
+			v = dist(rng);
+		}
+		return f;
+	}
+
+	ConvLayer RandomLayer(const uint32_t inC, const uint32_t outC, const uint32_t k, const Activation act, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+		ConvLayer l;
+		l.InChannels = inC;
+		l.OutChannels = outC;
+		l.KernelSize = k;
+		l.Act = act;
+		l.Weights.resize(static_cast<size_t>(outC) * inC * k * k);
+		l.Bias.resize(outC);
+		for (float& v : l.Weights)
+		{
+			v = dist(rng);
+		}
+		for (float& v : l.Bias)
+		{
+			v = dist(rng);
+		}
+		return l;
+	}
+
+	FeatureMap ReferenceStack(const NeuralModel& model, FeatureMap x)
+	{
+		for (const ConvLayer& layer : model.Layers)
+		{
+			x = Conv2DReference(x, layer);
+		}
+		return x;
+	}
+
+	// The fused schedule accumulates in the reference's order and skips the same padding taps, so the dump must
+	// match exactly — any difference is a region/halo bug, not rounding.
+	void RequireIdentical(const FeatureMap& fused, const FeatureMap& expected)
+	{
+		REQUIRE(fused.Channels == expected.Channels);
+		REQUIRE(fused.Height == expected.Height);
+		REQUIRE(fused.Width == expected.Width);
+		size_t mismatches = 0;
+		for (size_t i = 0; i < fused.Data.size(); ++i)
+		{
+			mismatches += fused.Data[i] != expected.Data[i] ? 1 : 0;
+		}
+		CHECK(mismatches == 0);
+	}
+}
+
+// The spatial and temporal refiner shapes (3/8 -> 16 -> 16 -> 3) at sizes that leave partial edge tiles, are
+// smaller than one tile, or are a single row/column (the halo lies entirely outside the image on a side).
+TEST_CASE("Fused conv matches the per-layer reference bit for bit", "[neural][fused]")
+{
+	std::mt19937 rng(2024);
+	for (const uint32_t inChannels : {3u, 8u})
+	{
+		NeuralModel model;
+		model.Layers.push_back(RandomLayer(inChannels, 16, 3, Activation::ReLU, rng));
+		model.Layers.push_back(RandomLayer(16, 16, 3, Activation::ReLU, rng));
+		model.Layers.push_back(RandomLayer(16, 3, 3, Activation::None, rng));
+		REQUIRE(PlanFusedConv(model).Fusable);
+
+		for (const auto [h, w] : {std::pair{1u, 1u}, std::pair{1u, 21u}, std::pair{19u, 1u}, std::pair{5u, 7u}, std::pair{8u, 8u}, std::pair{23u, 41u}})
+		{
+			const FeatureMap input = RandomMap(inChannels, h, w, rng);
+			FeatureMap fused;
+			REQUIRE(RunFusedReference(model, input, fused));
+			RequireIdentical(fused, ReferenceStack(model, input));
+		}
+	}
+}
+
+TEST_CASE("Fused conv handles mixed kernel sizes and a single layer", "[neural][fused]")
+{
+	std::mt19937 rng(77);
+
+	NeuralModel mixed;
+	mixed.Layers.push_back(RandomLayer(3, 12, 5, Activation::ReLU, rng));
+	mixed.Layers.push_back(RandomLayer(12, 8, 1, Activation::ReLU, rng));
+	mixed.Layers.push_back(RandomLayer(8, 3, 3, Activation::None, rng));
+	const FusedConvPlan plan = PlanFusedConv(mixed);
+	REQUIRE(plan.Fusable);
+	CHECK(plan.Halo == 3); // 2 + 0 + 1
+
+	NeuralModel single;
+	single.Layers.push_back(RandomLayer(3, 3, 3, Activation::None, rng));
+	REQUIRE(PlanFusedConv(single).Fusable);
+
+	for (const NeuralModel* model : {&mixed, &single})
+	{
+		const FeatureMap input = RandomMap(3, 13, 30, rng);
+		FeatureMap fused;
+		REQUIRE(RunFusedReference(*model, input, fused));
+		RequireIdentical(fused, ReferenceStack(*model, input));
+	}
+}
+
+// The default identity refiners must take the fused path (they're what ships without trained weights), and
+// the shapes the kernel can't hold must be rejected so the pass keeps its per-layer dispatches.
+TEST_CASE("PlanFusedConv picks the path from the layer list", "[neural][fused]")
+{
+	std::mt19937 rng(5);
+
+	const FusedConvPlan spatial = PlanFusedConv(MakeIdentityRefiner(3));
+	CHECK(spatial.Fusable);
+	CHECK(spatial.Halo == 3);
+	CHECK(spatial.PeakPlaneFloats == 16 * 12 * 12); // layer 0's output region
+	CHECK(PlanFusedConv(MakeIdentityRefiner(8)).Fusable);
+
+	NeuralModel wide; // 32-wide hidden layers: a 12x12 region is 4608 floats, past one plane
+	wide.Layers.push_back(RandomLayer(3, 32, 3, Activation::ReLU, rng));
+	wide.Layers.push_back(RandomLayer(32, 32, 3, Activation::ReLU, rng));
+	wide.Layers.push_back(RandomLayer(32, 3, 3, Activation::None, rng));
+	CHECK_FALSE(PlanFusedConv(wide).Fusable);
+
+	NeuralModel notResidual;
+	notResidual.Layers.push_back(RandomLayer(3, 4, 3, Activation::None, rng));
+	CHECK_FALSE(PlanFusedConv(notResidual).Fusable);
+
+	NeuralModel quantized = MakeIdentityRefiner(3);
+	quantized.Layers[1].Quant.Storage = WeightStorage::Int8;
+	CHECK_FALSE(PlanFusedConv(quantized).Fusable);
+
+	NeuralModel deep;
+	for (uint32_t i = 0; i <= kFusedMaxLayers; ++i)
+	{
+		deep.Layers.push_back(RandomLayer(3, 3, 1, Activation::ReLU, rng));
+	}
+	CHECK_FALSE(PlanFusedConv(deep).Fusable);
+
+	FeatureMap out;
+	CHECK_FALSE(RunFusedReference(wide, RandomMap(3, 4, 4, rng), out));
+	CHECK_FALSE(RunFusedReference(MakeIdentityRefiner(3), RandomMap(8, 4, 4, rng), out)); // channel mismatch
+}
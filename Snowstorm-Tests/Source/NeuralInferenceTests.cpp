@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Render/Neural/NeuralInference.hpp"
+
+#include <cmath>
+#include <random>
+
+using namespace Snowstorm;
+using namespace Snowstorm::Neural;
+
+namespace
+{
+	FeatureMap RandomMap(const uint32_t c, const uint32_t h, const uint32_t w, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		FeatureMap f;
+		f.Channels = c;
+		f.Height = h;
+		f.Width = w;
+		f.Data.resize(static_cast<size_t>(c) * h * w);
+		for (float& v : f.Data)
+		{
+			v = dist(rng);
+		}
+		return f;
+	}
+
+	ConvLayer RandomLayer(const uint32_t inC, const uint32_t outC, const uint32_t k, const Activation act, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+		ConvLayer l;
+		l.InChannels = inC;
+		l.OutChannels = outC;
+		l.KernelSize = k;
+		l.Act = act;
+		l.Weights.resize(static_cast<size_t>(outC) * inC * k * k);
+		l.Bias.resize(outC);
+		for (float& v : l.Weights)
+		{
+			v = dist(rng);
+		}
+		for (float& v : l.Bias)
+		{
+			v = dist(rng);
+		}
+		return l;
+	}
+
+	FeatureMap ReferenceStack(const NeuralModel& model, FeatureMap x)
+	{
+		for (const ConvLayer& layer : model.Layers)
+		{
+			x = Conv2DReference(x, layer);
+		}
+		return x;
+	}
+
+	// GEMM accumulates in a different order than the 7-deep reference loop, so compare with a tolerance
+	// scaled to the magnitude rather than bit-exactly.
+	void RequireClose(const FeatureMap& a, const FeatureMap& b)
+	{
+		REQUIRE(a.Channels == b.Channels);
+		REQUIRE(a.Height == b.Height);
+		REQUIRE(a.Width == b.Width);
+		REQUIRE(a.Data.size() == b.Data.size());
+		float worst = 0.0f;
+		for (size_t i = 0; i < a.Data.size(); ++i)
+		{
+			worst = std::max(worst, std::abs(a.Data[i] - b.Data[i]) / (1.0f + std::abs(b.Data[i])));
+		}
+		CHECK(worst < 1e-5f);
+	}
+}
+
+// The production path must reproduce the oracle on the real architecture (3->16->16->3, 3x3, ReLU hidden)
+// at sizes that exercise the tile remainder (width not a multiple of the tile or pixel block), single rows
+// and columns (every tap zero-padded on one side), and the oc remainder (3 output channels).
+TEST_CASE("CpuInference matches Conv2DReference on the refiner architecture", "[neural][inference]")
+{
+	std::mt19937 rng(1234);
+	NeuralModel model;
+	model.Layers.push_back(RandomLayer(3, 16, 3, Activation::ReLU, rng));
+	model.Layers.push_back(RandomLayer(16, 16, 3, Activation::ReLU, rng));
+	model.Layers.push_back(RandomLayer(16, 3, 3, Activation::None, rng));
+
+	CpuInference inference(model);
+	JobSystem jobs;
+
+	for (const auto [h, w] : {std::pair{1u, 1u}, std::pair{1u, 37u}, std::pair{29u, 1u}, std::pair{13u, 137u}, std::pair{40u, 300u}})
+	{
+		const FeatureMap input = RandomMap(3, h, w, rng);
+		const FeatureMap expected = ReferenceStack(model, input);
+
+		FeatureMap serial;
+		REQUIRE(inference.Run(input, serial));
+		RequireClose(serial, expected);
+
+		FeatureMap threaded;
+		REQUIRE(inference.Run(input, threaded, &jobs));
+		RequireClose(threaded, expected);
+	}
+}
+
+TEST_CASE("CpuInference handles 1x1 kernels and wide temporal inputs", "[neural][inference]")
+{
+	std::mt19937 rng(99);
+	NeuralModel model;
+	model.Layers.push_back(RandomLayer(8, 16, 3, Activation::ReLU, rng)); // temporal feature stack width
+	model.Layers.push_back(RandomLayer(16, 5, 1, Activation::ReLU, rng));
+	model.Layers.push_back(RandomLayer(5, 3, 1, Activation::None, rng));
+
+	CpuInference inference(model);
+	JobSystem jobs;
+	const FeatureMap input = RandomMap(8, 17, 70, rng);
+	FeatureMap out;
+	REQUIRE(inference.Run(input, out, &jobs));
+	RequireClose(out, ReferenceStack(model, input));
+}
+
+// Steady state allocates nothing: a second frame of the same size reuses the arena as-is.
+TEST_CASE("CpuInference reuses its arena across frames", "[neural][inference]")
+{
+	std::mt19937 rng(7);
+	CpuInference inference(MakeIdentityRefiner(3));
+	const FeatureMap input = RandomMap(3, 24, 48, rng);
+
+	FeatureMap out;
+	REQUIRE(inference.Run(input, out));
+	const size_t arena = inference.ArenaFloats();
+	const float* storage = out.Data.data();
+	CHECK(arena > 0);
+
+	REQUIRE(inference.Run(input, out));
+	CHECK(inference.ArenaFloats() == arena);
+	CHECK(out.Data.data() == storage);
+
+	FeatureMap wrong = RandomMap(4, 24, 48, rng);
+	CHECK_FALSE(inference.Run(wrong, out)); // channel mismatch is rejected, not read out of bounds
+}
+
+// The identity refiner's residual is exactly zero, so the CPU upscaler must return the bilinear base — the
+// same no-op property the GPU chain is validated with.
+TEST_CASE("CpuInference upscale with the identity refiner is bilinear", "[neural][inference]")
+{
+	std::mt19937 rng(5);
+	CpuInference inference(MakeIdentityRefiner(3));
+	const FeatureMap lowRes = RandomMap(3, 9, 16, rng);
+
+	FeatureMap out;
+	REQUIRE(inference.Upscale(lowRes, 32, 18, out));
+
+	FeatureMap bilinear;
+	CpuInference::UpsampleBilinear(lowRes, 32, 18, bilinear);
+	REQUIRE(out.Data.size() == bilinear.Data.size());
+	for (size_t i = 0; i < out.Data.size(); ++i)
+	{
+		REQUIRE(out.Data[i] == bilinear.Data[i]);
+	}
+
+	// 2x upsample of a constant stays constant; edges clamp rather than fade to zero.
+	FeatureMap flat;
+	flat.Channels = 3;
+	flat.Height = 2;
+	flat.Width = 2;
+	flat.Data.assign(12, 0.25f);
+	CpuInference::UpsampleBilinear(flat, 4, 4, bilinear);
+	for (const float v : bilinear.Data)
+	{
+		CHECK(v == 0.25f); // lerp between equal taps is exact
+	}
+}
@@ -0,0 +1,275 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Render/Neural/NeuralInference.hpp"
+#include "Snowstorm/Render/Neural/NeuralQuantization.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace Snowstorm;
+using namespace Snowstorm::Neural;
+
+namespace
+{
+	FeatureMap RandomMap(const uint32_t c, const uint32_t h, const uint32_t w, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		FeatureMap f;
+		f.Channels = c;
+		f.Height = h;
+		f.Width = w;
+		f.Data.resize(static_cast<size_t>(c) * h * w);
+		for (float& v : f.Data)
+		{
+			v = dist(rng);
+		}
+		return f;
+	}
+
+	ConvLayer RandomLayer(const uint32_t inC, const uint32_t outC, const uint32_t k, const Activation act, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> dist(-0.3f, 0.3f);
+		ConvLayer l;
+		l.InChannels = inC;
+		l.OutChannels = outC;
+		l.KernelSize = k;
+		l.Act = act;
+		l.Weights.resize(static_cast<size_t>(outC) * inC * k * k);
+		l.Bias.resize(outC);
+		for (float& v : l.Weights)
+		{
+			v = dist(rng);
+		}
+		for (float& v : l.Bias)
+		{
+			v = dist(rng);
+		}
+		return l;
+	}
+
+	// The refiner architecture, every layer int8, calibrated on `calibration`.
+	NeuralModel CalibratedInt8Model(const FeatureMap& calibration, std::mt19937& rng)
+	{
+		NeuralModel model;
+		model.Layers.push_back(RandomLayer(3, 16, 3, Activation::ReLU, rng));
+		model.Layers.push_back(RandomLayer(16, 16, 3, Activation::ReLU, rng));
+		model.Layers.push_back(RandomLayer(16, 3, 3, Activation::None, rng));
+
+		std::vector<ActivationRange> ranges(model.Layers.size());
+		CpuInference inference(model);
+		FeatureMap out;
+		REQUIRE(inference.RunObserved(calibration, out, [&](const size_t layer, const std::span<const float> input)
+		                              { ranges[layer].Observe(input); }));
+		REQUIRE(QuantizeModelInt8(model, ranges, false));
+		return model;
+	}
+
+	float MaxAbsDiff(const FeatureMap& a, const FeatureMap& b)
+	{
+		REQUIRE(a.Data.size() == b.Data.size());
+		float worst = 0.0f;
+		for (size_t i = 0; i < a.Data.size(); ++i)
+		{
+			worst = std::max(worst, std::abs(a.Data[i] - b.Data[i]));
+		}
+		return worst;
+	}
+}
+
+TEST_CASE("Half conversion rounds to nearest even and round-trips every half", "[neural][quant]")
+{
+	CHECK(FloatToHalf(0.0f) == 0x0000);
+	CHECK(FloatToHalf(-0.0f) == 0x8000);
+	CHECK(FloatToHalf(1.0f) == 0x3C00);
+	CHECK(FloatToHalf(-2.0f) == 0xC000);
+	CHECK(FloatToHalf(65504.0f) == 0x7BFF);
+	CHECK(FloatToHalf(70000.0f) == 0x7C00);              // overflow -> inf
+	CHECK(FloatToHalf(5.9604644775390625e-8f) == 0x0001); // smallest denormal
+	CHECK(FloatToHalf(1.0f + 1.0f / 2048.0f) == 0x3C00);  // exact tie -> even (down)
+	CHECK(FloatToHalf(1.0f + 3.0f / 2048.0f) == 0x3C02);  // exact tie -> even (up)
+	CHECK(std::isnan(HalfToFloat(FloatToHalf(std::nanf("")))));
+
+	for (uint32_t bits = 0; bits < 0x10000; ++bits)
+	{
+		const uint16_t h = static_cast<uint16_t>(bits);
+		if ((h & 0x7C00) == 0x7C00 && (h & 0x03FF) != 0)
+		{
+			continue; // NaN payloads are not preserved bit-exactly
+		}
+		REQUIRE(FloatToHalf(HalfToFloat(h)) == h);
+	}
+}
+
+// The per-channel symmetric scheme: the largest |w| in each channel maps to +-127 and dequantization error is
+// at most half a step.
+TEST_CASE("Int8 weight quantization is per-channel symmetric", "[neural][quant]")
+{
+	std::mt19937 rng(3);
+	ConvLayer layer = RandomLayer(4, 3, 3, Activation::None, rng);
+	std::fill_n(layer.Weights.begin() + 36, 36, 0.0f); // an all-zero channel keeps scale 1
+	const std::vector<float> original = layer.Weights;
+	QuantizeWeightsInt8(layer);
+
+	REQUIRE(layer.Quant.Storage == WeightStorage::Int8);
+	REQUIRE(layer.Quant.WeightScales.size() == 3);
+	CHECK(layer.Quant.WeightScales[1] == 1.0f);
+	for (uint32_t oc = 0; oc < 3; ++oc)
+	{
+		int maxCode = 0;
+		for (size_t i = oc * 36; i < (oc + 1) * 36; ++i)
+		{
+			maxCode = std::max(maxCode, std::abs(static_cast<int>(layer.Quant.QWeights[i])));
+			CHECK(std::abs(layer.Weights[i] - original[i]) <= 0.5f * layer.Quant.WeightScales[oc] * 1.0001f);
+		}
+		CHECK(maxCode == (oc == 1 ? 0 : 127));
+	}
+}
+
+TEST_CASE("SSNN v2 round-trips fp16 and int8 layers", "[neural][quant]")
+{
+	std::mt19937 rng(11);
+	NeuralModel model;
+	model.Layers.push_back(RandomLayer(3, 8, 3, Activation::ReLU, rng));
+	model.Layers.push_back(RandomLayer(8, 8, 3, Activation::ReLU, rng));
+	model.Layers.push_back(RandomLayer(8, 3, 1, Activation::None, rng));
+	QuantizeWeightsFloat16(model.Layers[0]);
+	QuantizeWeightsInt8(model.Layers[1]);
+	ApplyInputRange(model.Layers[1], ActivationRange{0.0f, 3.0f, true});
+	// Layer 2 stays fp32 inside a v2 file.
+
+	const std::string path = "ssnn_v2_roundtrip_test.ssnn";
+	REQUIRE(SaveModel(path, model));
+	NeuralModel loaded;
+	REQUIRE(LoadModel(path, loaded));
+	std::remove(path.c_str());
+
+	REQUIRE(loaded.Layers.size() == 3);
+	for (size_t li = 0; li < 3; ++li)
+	{
+		const ConvLayer& e = model.Layers[li];
+		const ConvLayer& g = loaded.Layers[li];
+		CHECK(g.Quant.Storage == e.Quant.Storage);
+		CHECK(g.Act == e.Act);
+		CHECK(g.Weights == e.Weights); // fp16 and int8 weights are already the stored values in memory
+		CHECK(g.Bias == e.Bias);
+	}
+	CHECK(loaded.Layers[1].Quant.QWeights == model.Layers[1].Quant.QWeights);
+	CHECK(loaded.Layers[1].Quant.WeightScales == model.Layers[1].Quant.WeightScales);
+	CHECK(loaded.Layers[1].Quant.InputScale == model.Layers[1].Quant.InputScale);
+	CHECK(loaded.Layers[1].Quant.InputZeroPoint == 0);
+
+	// An all-fp32 model still writes version 1 (Tools/neural/ssnn.py byte parity).
+	NeuralModel plain;
+	plain.Layers.push_back(RandomLayer(3, 3, 1, Activation::None, rng));
+	REQUIRE(SaveModel(path, plain));
+	std::ifstream f(path, std::ios::binary);
+	char header[8] = {};
+	f.read(header, 8);
+	f.close();
+	std::remove(path.c_str());
+	CHECK(header[4] == 1);
+}
+
+// The production int8 kernel does the oracle's exact integer math; only the final float rescale may round
+// differently, so the two agree to float precision (not a quantization tolerance).
+TEST_CASE("CpuInference int8 path matches Conv2DInt8Reference", "[neural][quant]")
+{
+	std::mt19937 rng(21);
+	const FeatureMap calibration = RandomMap(3, 16, 40, rng);
+	const NeuralModel model = CalibratedInt8Model(calibration, rng);
+
+	CpuInference inference(model);
+	JobSystem jobs;
+	for (const auto [h, w] : {std::pair{1u, 1u}, std::pair{7u, 33u}, std::pair{20u, 150u}})
+	{
+		const FeatureMap input = RandomMap(3, h, w, rng);
+		FeatureMap expected = input;
+		for (const ConvLayer& layer : model.Layers)
+		{
+			expected = Conv2DInt8Reference(expected, layer);
+		}
+
+		FeatureMap out;
+		REQUIRE(inference.Run(input, out, &jobs));
+		CHECK(MaxAbsDiff(out, expected) < 1e-4f);
+	}
+}
+
+// Quantization error budget: the calibrated int8 model stays close to the fp32 model it came from.
+TEST_CASE("Calibrated int8 model tracks the fp32 model", "[neural][quant]")
+{
+	std::mt19937 rng(5);
+	const FeatureMap input = RandomMap(3, 24, 32, rng);
+	std::mt19937 modelRng(8);
+	const NeuralModel int8 = CalibratedInt8Model(input, modelRng);
+	std::mt19937 floatRng(8);
+	NeuralModel fp32;
+	fp32.Layers.push_back(RandomLayer(3, 16, 3, Activation::ReLU, floatRng));
+	fp32.Layers.push_back(RandomLayer(16, 16, 3, Activation::ReLU, floatRng));
+	fp32.Layers.push_back(RandomLayer(16, 3, 3, Activation::None, floatRng));
+
+	FeatureMap a, b;
+	REQUIRE(CpuInference(fp32).Run(input, a));
+	REQUIRE(CpuInference(int8).Run(input, b));
+	float peak = 0.0f;
+	for (const float v : a.Data)
+	{
+		peak = std::max(peak, std::abs(v));
+	}
+	CHECK(MaxAbsDiff(a, b) < 0.05f * peak);
+}
+
+// The shader's formulation: signed-byte activations (q - 128) against the packed words, plus the per-channel
+// correction, equals sum((q - z) * w). Emulated here on the packed buffers NeuralUpscalePass uploads.
+TEST_CASE("GPU int8 packing reproduces the integer conv", "[neural][quant]")
+{
+	std::mt19937 rng(31);
+	const FeatureMap input = RandomMap(3, 6, 9, rng);
+	const NeuralModel model = CalibratedInt8Model(input, rng);
+	const Int8GpuWeights packed = PackInt8ForGpu(model);
+
+	FeatureMap x = input;
+	for (size_t li = 0; li < model.Layers.size(); ++li)
+	{
+		const ConvLayer& l = model.Layers[li];
+		const FeatureMap expected = Conv2DInt8Reference(x, l);
+
+		const uint32_t taps = l.KernelSize * l.KernelSize;
+		const uint32_t words = Int8WordsPerInputChannel(l.KernelSize);
+		const int kR = static_cast<int>(l.KernelSize / 2);
+		const float* params = packed.Params.data() + packed.ParamOffsets[li];
+		FeatureMap out = expected;
+		for (uint32_t y = 0; y < x.Height; ++y)
+		{
+			for (uint32_t px = 0; px < x.Width; ++px)
+			{
+				for (uint32_t oc = 0; oc < l.OutChannels; ++oc)
+				{
+					float acc = 0.0f;
+					for (uint32_t ic = 0; ic < l.InChannels; ++ic)
+					{
+						int s = 0;
+						for (uint32_t t = 0; t < taps; ++t)
+						{
+							const int sy = static_cast<int>(y) + static_cast<int>(t / l.KernelSize) - kR;
+							const int sx = static_cast<int>(px) + static_cast<int>(t % l.KernelSize) - kR;
+							const bool inside = sy >= 0 && sx >= 0 && sy < static_cast<int>(x.Height) && sx < static_cast<int>(x.Width);
+							const float v = inside ? x.At(ic, static_cast<uint32_t>(sy), static_cast<uint32_t>(sx)) : 0.0f;
+							const int a = static_cast<int>(QuantizeActivation(v, 1.0f / l.Quant.InputScale, l.Quant.InputZeroPoint)) - 128;
+							const uint32_t word = packed.Words[packed.WordOffsets[li] + (oc * l.InChannels + ic) * words + t / 4];
+							s += a * static_cast<int8_t>((word >> (8 * (t % 4))) & 0xFFu);
+						}
+						acc += static_cast<float>(s);
+					}
+					const float v = params[2 * l.OutChannels + oc] + (acc + params[l.OutChannels + oc]) * params[oc];
+					out.At(oc, y, px) = l.Act == Activation::ReLU ? std::max(v, 0.0f) : v;
+				}
+			}
+		}
+		CHECK(MaxAbsDiff(out, expected) < 1e-4f);
+		x = expected;
+	}
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "Snowstorm/Render/DatasetExport/NpyReader.hpp"
 #include "Snowstorm/Render/DatasetExport/NpyWriter.hpp"
 
 #include <algorithm>
@@ -96,3 +97,41 @@ TEST_CASE("WriteNpy round-trips header + payload to disk", "[npy]")
 
 	std::remove(path.c_str());
 }
+
+// The reader is the writer's inverse for every export dtype: same shape back, halves widened exactly, u8 as
+// raw codes. A truncated payload is rejected rather than zero-filled.
+TEST_CASE("ReadNpy reads back what WriteNpy wrote", "[npy]")
+{
+	const std::string path = "npy_read_test.npy";
+
+	const std::vector<uint16_t> halves = {0x0000, 0x3C00, 0xC000, 0x3800, 0x7BFF, 0x0001}; // 0, 1, -2, 0.5, 65504, 2^-24
+	REQUIRE(WriteNpy(path, halves.data(), halves.size() * 2, {1, 2, 3}, NpyDType::Float16));
+	auto f16 = ReadNpy(path);
+	REQUIRE(f16);
+	CHECK(f16->Shape == std::vector<size_t>{1, 2, 3});
+	CHECK(f16->DType == NpyDType::Float16);
+	CHECK(f16->Data == std::vector<float>{0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 5.9604644775390625e-8f});
+
+	const std::vector<uint8_t> codes = {0, 17, 255, 128};
+	REQUIRE(WriteNpy(path, codes.data(), codes.size(), {2, 2}, NpyDType::UInt8));
+	auto u8 = ReadNpy(path);
+	REQUIRE(u8);
+	CHECK(u8->Data == std::vector<float>{0.0f, 17.0f, 255.0f, 128.0f});
+
+	const std::vector<float> floats = {1.25f, -3.5f};
+	REQUIRE(WriteNpy(path, floats.data(), floats.size() * 4, {2}, NpyDType::Float32));
+	auto f32 = ReadNpy(path);
+	REQUIRE(f32);
+	CHECK(f32->Shape == std::vector<size_t>{2});
+	CHECK(f32->Data == floats);
+
+	{
+		const std::vector<uint8_t> header = BuildNpyHeader({4, 4}, NpyDType::Float32);
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+		out.write(reinterpret_cast<const char*>(floats.data()), 8); // 2 of 16 floats
+	}
+	CHECK_FALSE(ReadNpy(path));
+
+	std::remove(path.c_str());
+}
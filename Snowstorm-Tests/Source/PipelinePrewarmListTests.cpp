@@ -0,0 +1,31 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/PipelinePrewarmList.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace Snowstorm;
+
+// The pre-warm list is the only cross-session memory of which material pipelines to compile early; it must
+// round-trip in first-use order and tolerate hand edits (comments, CRLF, duplicates).
+TEST_CASE("PipelinePrewarmList round-trips and tolerates hand edits", "[pipeline]")
+{
+	const ScratchDirectory scratch("ss_prewarm");
+	const auto path = scratch.GetPath() / "nested" / "prewarm.txt";
+
+	CHECK(PipelinePrewarmListIO::Load(path).empty()); // missing file = nothing to pre-warm
+
+	const std::vector<std::string> shaders = {"Engine/Shaders/DefaultLit.frag.hlsl", "Assets/Shaders/Water.frag.hlsl"};
+	REQUIRE(PipelinePrewarmListIO::Save(path, shaders));
+	CHECK(PipelinePrewarmListIO::Load(path) == shaders);
+
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << "# comment\r\nA.frag.hlsl\r\n\r\nB.frag.hlsl\nA.frag.hlsl\n";
+	}
+	CHECK(PipelinePrewarmListIO::Load(path) == std::vector<std::string>{"A.frag.hlsl", "B.frag.hlsl"});
+}
@@ -0,0 +1,299 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Platform/Null/NullRendererAPI.hpp"
+#include "Platform/Null/NullResources.hpp"
+#include "Platform/Null/RecordingCommandContext.hpp"
+
+#include "Snowstorm/Render/MaterialInstance.hpp"
+#include "Snowstorm/Render/Mesh.hpp"
+#include "Snowstorm/Render/RenderGraph.hpp"
+#include "Snowstorm/Render/Renderer.hpp"
+#include "Snowstorm/Render/RendererService.hpp"
+
+using namespace Snowstorm;
+
+namespace
+{
+	Ref<NullTexture> MakeTexture(const PixelFormat format, const TextureUsage usage)
+	{
+		TextureDesc desc;
+		desc.Format = format;
+		desc.Usage = usage;
+		desc.Width = 64;
+		desc.Height = 32;
+		return CreateRef<NullTexture>(desc);
+	}
+
+	Ref<Pipeline> MakePipeline(const PipelineType type, const std::string& name)
+	{
+		PipelineDesc desc;
+		desc.Type = type;
+		desc.DebugName = name;
+		return CreateRef<NullPipeline>(desc);
+	}
+
+	Ref<DescriptorSet> MakeSet(const Ref<Pipeline>& pipeline, const uint32_t set)
+	{
+		return CreateRef<NullDescriptorSet>(pipeline->GetSetLayouts()[set], DescriptorSetDesc{});
+	}
+
+	// Selects the Null backend for one test and restores the device backend afterwards, so a later test (or
+	// a test binary run on a machine with a GPU) never inherits it.
+	struct ScopedNullRenderer
+	{
+		ScopedNullRenderer()
+		{
+			RendererAPI::SetAPI(RendererAPI::API::Null);
+			Renderer::Init(nullptr);
+		}
+
+		~ScopedNullRenderer()
+		{
+			Renderer::Shutdown();
+			RendererAPI::SetAPI(RendererAPI::API::Vulkan);
+		}
+
+		ScopedNullRenderer(const ScopedNullRenderer&) = delete;
+		ScopedNullRenderer& operator=(const ScopedNullRenderer&) = delete;
+
+		static RecordingCommandContext& Recording()
+		{
+			return static_cast<NullRendererAPI&>(Renderer::GetAPI()).GetRecordingContext();
+		}
+	};
+}
+
+TEST_CASE("Recording context emits the attachment barriers a graph frame needs, once", "[render][null]")
+{
+	const Ref<NullTexture> color = MakeTexture(PixelFormat::RGBA16_SFloat, TextureUsage::ColorAttachment | TextureUsage::Sampled);
+	const Ref<NullTexture> depth = MakeTexture(PixelFormat::D32_Float, TextureUsage::DepthStencil | TextureUsage::Sampled);
+
+	RenderTargetDesc targetDesc;
+	targetDesc.Width = 64;
+	targetDesc.Height = 32;
+	targetDesc.ColorAttachments.push_back({.View = color->GetDefaultView()});
+	targetDesc.DepthAttachment = DepthStencilAttachment{.View = depth->GetDefaultView()};
+	const Ref<RenderTarget> target = CreateRef<NullRenderTarget>(targetDesc);
+
+	const Ref<Pipeline> lit = MakePipeline(PipelineType::Graphics, "Lit");
+	const Ref<Pipeline> post = MakePipeline(PipelineType::Compute, "Post");
+	const std::vector<Ref<DescriptorSet>> sets{MakeSet(lit, 0), MakeSet(lit, 1), MakeSet(lit, 2)};
+	const Ref<Buffer> indices = CreateRef<NullBuffer>(36 * sizeof(uint32_t), BufferUsage::Index, nullptr, false);
+
+	RenderGraph graph;
+	graph.AddPass({.Name = "Forward", .Target = target, .Execute = [&](CommandContext& ctx)
+	{
+		// Two draws through the same state: the second pipeline, set and index buffer binds change nothing.
+		for (int i = 0; i < 2; ++i)
+		{
+			ctx.BindPipeline(lit);
+			ctx.BindDescriptorSets(0, sets);
+			ctx.BindGlobalResources();
+			ctx.DrawIndexed(indices, 36, 4);
+		}
+	}});
+	graph.AddPass({.Name = "Post", .IsCompute = true, .Reads = {{color, RenderGraph::AccessState::Sampled}},
+	               .Execute = [&](CommandContext& ctx)
+	{
+		ctx.BindPipeline(post);
+		ctx.Dispatch(8, 4, 1);
+	}});
+
+	RecordingCommandContext ctx;
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		ctx.Reset();
+		graph.Execute(ctx);
+
+		const RecordedCommandStats& stats = ctx.Stats();
+		CHECK(stats.RenderPasses == 1);
+		CHECK(stats.DrawCalls == 2);
+		CHECK(stats.Instances == 8);
+		CHECK(stats.Triangles == 96); // 2 draws x 12 triangles x 4 instances
+		CHECK(stats.Dispatches == 1);
+		CHECK(stats.PipelineBinds == 2);
+		CHECK(stats.DescriptorBinds == 2);
+		CHECK(stats.DescriptorSetsBound == 4);
+		CHECK(stats.IndexBufferBinds == 1);
+		CHECK(stats.DynamicStateSets == 2); // the pass's default viewport + scissor
+
+		// The repeats were filtered, not recorded.
+		const SkippedBindStats skipped = ctx.GetSkippedBinds();
+		CHECK(skipped.PipelineBinds == 1);
+		CHECK(skipped.DescriptorSets == 4); // the repeated sets 0..2 and the repeated bindless set
+		CHECK(skipped.IndexBuffers == 1);
+		CHECK(skipped.VertexBuffers == 0);
+
+		// Color + depth into the attachment layout and back to sampled; the compute read then finds the
+		// color already sampled (no transition) but still gets the write -> compute-read dependency.
+		CHECK(stats.Barriers == 5);
+		CHECK_FALSE(color->HasPendingWrite());
+		CHECK(color->GetLayout() == NullTextureLayout::Sampled);
+		CHECK(depth->GetLayout() == NullTextureLayout::Sampled);
+	}
+
+	// Passes are bracketed by named scopes, in graph order.
+	REQUIRE(ctx.Count(RecordedOp::BeginScope) == 2);
+	CHECK(ctx.Count(RecordedOp::EndScope) == 2);
+	CHECK(ctx.Names() == std::vector<std::string>{"Forward", "Post"});
+	CHECK(ctx.Commands().front().Op == RecordedOp::BeginScope);
+	CHECK(ctx.Commands().back().Op == RecordedOp::EndScope);
+}
+
+TEST_CASE("Recording context drops bind tracking across pipelines and ResetState", "[render][null]")
+{
+	const Ref<Pipeline> graphics = MakePipeline(PipelineType::Graphics, "G");
+	const Ref<Pipeline> compute = MakePipeline(PipelineType::Compute, "C");
+	const Ref<DescriptorSet> set = MakeSet(graphics, 0);
+
+	RecordingCommandContext ctx;
+	ctx.BindPipeline(graphics);
+	ctx.BindDescriptorSet(set, 0);
+	ctx.BindPipeline(compute); // a new layout / bind point: nothing is bound for it yet
+	ctx.BindDescriptorSet(set, 0);
+	ctx.BindPipeline(compute); // repeats: both dropped
+	ctx.BindDescriptorSet(set, 0);
+	ctx.ResetState();
+	ctx.BindPipeline(compute);
+	ctx.BindDescriptorSet(set, 0);
+	const uint32_t offset = 256;
+	ctx.BindDescriptorSet(set, 0, &offset, 1); // a dynamic offset may point at another slice
+	ctx.BindDescriptorSet(set, 0);              // ...so what's bound after it is unknown
+
+	CHECK(ctx.Stats().PipelineBinds == 3);
+	CHECK(ctx.GetSkippedBinds().PipelineBinds == 1);
+	CHECK(ctx.Stats().DescriptorBinds == 5);
+	CHECK(ctx.GetSkippedBinds().DescriptorSets == 1);
+	CHECK(ctx.Count(RecordedOp::BindDescriptorSets) == 5);
+}
+
+TEST_CASE("Recording context trims a set range to the sets that changed", "[render][null]")
+{
+	const Ref<Pipeline> lit = MakePipeline(PipelineType::Graphics, "Lit");
+	const Ref<DescriptorSet> frame = MakeSet(lit, 0);
+	const Ref<DescriptorSet> red = MakeSet(lit, 1);
+	const Ref<DescriptorSet> blue = MakeSet(lit, 1);
+	const Ref<DescriptorSet> objects = MakeSet(lit, 2);
+	const Ref<Buffer> vertices = CreateRef<NullBuffer>(64, BufferUsage::Vertex, nullptr, false);
+
+	RecordingCommandContext ctx;
+	ctx.BindPipeline(lit);
+	ctx.BindDescriptorSets(0, {frame, red, objects});
+	ctx.BindDescriptorSets(0, {frame, blue, objects}); // only set 1 reaches the log
+	ctx.BindVertexBuffer(vertices, 0, 0);
+	ctx.BindVertexBuffer(vertices, 0, 0);
+	ctx.BindVertexBuffer(vertices, 0, 32); // same buffer, new offset
+
+	REQUIRE(ctx.Count(RecordedOp::BindDescriptorSets) == 2);
+	const RecordedCommand& trimmed = ctx.Commands()[2];
+	CHECK(trimmed.Op == RecordedOp::BindDescriptorSets);
+	CHECK(trimmed.A == 1); // first set
+	CHECK(trimmed.B == 1); // set count
+	CHECK(trimmed.Object == blue.get());
+	CHECK(ctx.Stats().DescriptorSetsBound == 4);
+	CHECK(ctx.GetSkippedBinds().DescriptorSets == 2);
+	CHECK(ctx.Stats().VertexBufferBinds == 2);
+	CHECK(ctx.GetSkippedBinds().VertexBuffers == 1);
+}
+
+TEST_CASE("Null backend runs RendererService batching headless", "[render][null]")
+{
+	ScopedNullRenderer renderer;
+	RecordingCommandContext& recording = ScopedNullRenderer::Recording();
+	CHECK_FALSE(Renderer::GetAPI().IsRayTracingSupported());
+
+	PipelineDesc pipelineDesc;
+	pipelineDesc.DebugName = "Lit";
+	const Ref<Material> material = CreateRef<Material>(Pipeline::Create(pipelineDesc));
+	const Ref<MaterialInstance> red = CreateRef<MaterialInstance>(material);
+	const Ref<MaterialInstance> blue = CreateRef<MaterialInstance>(material);
+
+	const std::vector<Vertex> vertices(3);
+	const Ref<Mesh> triangle = CreateRef<Mesh>(vertices, std::vector<uint32_t>{0, 1, 2});
+
+	REQUIRE(Renderer::GetAPI().BeginFrame());
+	const Ref<CommandContext> ctx = Renderer::GetAPI().GetGraphicsCommandContext();
+	const uint32_t frameIndex = Renderer::GetAPI().GetCurrentFrameIndex();
+
+	RendererService service;
+	service.NewFrame();
+	ctx->BeginRenderPass(*Renderer::GetAPI().GetSwapchainTarget());
+	service.BeginScene(CameraRuntimeComponent{}, glm::vec3(0.0f), ctx, frameIndex);
+	for (int i = 0; i < 10; ++i)
+	{
+		service.DrawMesh(glm::mat4(1.0f), triangle, i % 2 == 0 ? red : blue);
+	}
+	service.EndScene();
+	ctx->EndRenderPass();
+	Renderer::GetAPI().EndFrame();
+
+	// Two (mesh, material instance) batches -> two instanced draws; the engine's stats and the recording agree.
+	const RenderStats& stats = service.GetStats();
+	CHECK(stats.Batches == 2);
+	CHECK(stats.DrawCalls == 2);
+	CHECK(stats.Instances == 10);
+
+	const RecordedCommandStats& recorded = recording.Stats();
+	CHECK(recorded.DrawCalls == stats.DrawCalls);
+	CHECK(recorded.Instances == stats.Instances);
+	CHECK(recorded.Triangles == stats.Triangles);
+	CHECK(recorded.RenderPasses == 1);
+
+	// Both batches share the pipeline, frame + object sets, bindless set and mesh: the second batch only
+	// rebinds its material set, and RenderStats reports the rest as skipped.
+	CHECK(recorded.PipelineBinds == 1);
+	CHECK(recorded.DescriptorBinds == 3);
+	CHECK(recorded.VertexBufferBinds == 1);
+	CHECK(stats.PipelineBindsSkipped == 1);
+	CHECK(stats.DescriptorBindsSkipped == 3);
+	CHECK(stats.BufferBindsSkipped == 2);
+}
+
+TEST_CASE("RendererService submits batches grouped by pipeline", "[render][null]")
+{
+	ScopedNullRenderer renderer;
+	RecordingCommandContext& recording = ScopedNullRenderer::Recording();
+
+	PipelineDesc litDesc;
+	litDesc.DebugName = "Lit";
+	PipelineDesc unlitDesc;
+	unlitDesc.DebugName = "Unlit";
+	const Ref<Material> lit = CreateRef<Material>(Pipeline::Create(litDesc));
+	const Ref<Material> unlit = CreateRef<Material>(Pipeline::Create(unlitDesc));
+	// Inserted alternating between the two pipelines, as a scene walk would meet them.
+	const std::vector<Ref<MaterialInstance>> instances{CreateRef<MaterialInstance>(lit), CreateRef<MaterialInstance>(unlit),
+	                                                   CreateRef<MaterialInstance>(lit), CreateRef<MaterialInstance>(unlit)};
+
+	const std::vector<Vertex> vertices(3);
+	const Ref<Mesh> triangle = CreateRef<Mesh>(vertices, std::vector<uint32_t>{0, 1, 2});
+
+	REQUIRE(Renderer::GetAPI().BeginFrame());
+	const Ref<CommandContext> ctx = Renderer::GetAPI().GetGraphicsCommandContext();
+
+	RendererService service;
+	service.NewFrame();
+	ctx->BeginRenderPass(*Renderer::GetAPI().GetSwapchainTarget());
+	service.BeginScene(CameraRuntimeComponent{}, glm::vec3(0.0f), ctx, Renderer::GetAPI().GetCurrentFrameIndex());
+	for (const Ref<MaterialInstance>& instance : instances)
+	{
+		service.DrawMesh(glm::mat4(1.0f), triangle, instance);
+	}
+	service.EndScene();
+	ctx->EndRenderPass();
+	Renderer::GetAPI().EndFrame();
+
+	// Sorted: Lit, Lit, Unlit, Unlit -- one bind per pipeline instead of four.
+	CHECK(service.GetStats().DrawCalls == 4);
+	CHECK(recording.Stats().PipelineBinds == 2);
+	CHECK(service.GetStats().PipelineBindsSkipped == 2);
+
+	std::vector<const void*> bound;
+	for (const RecordedCommand& command : recording.Commands())
+	{
+		if (command.Op == RecordedOp::BindPipeline)
+		{
+			bound.push_back(command.Object);
+		}
+	}
+	CHECK(bound == std::vector<const void*>{lit->GetPipeline().get(), unlit->GetPipeline().get()});
+}
@@ -0,0 +1,252 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/CameraTargetComponent.hpp"
+#include "Snowstorm/Components/DoNotSerializeComponent.hpp"
+#include "Snowstorm/Components/IDComponent.hpp"
+#include "Snowstorm/Components/MaterialComponent.hpp"
+#include "Snowstorm/Components/MaterialOverridesComponent.hpp"
+#include "Snowstorm/Components/MeshComponent.hpp"
+#include "Snowstorm/Components/RotatorComponent.hpp"
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/Components/VisibilityComponents.hpp"
+#include "Snowstorm/Core/JobSystem.hpp"
+#include "Snowstorm/Lighting/LightingComponents.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Snowstorm/World/SceneBinarySerializer.hpp"
+#include "Snowstorm/World/SceneSerializer.hpp"
+#include "Snowstorm/World/World.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <nlohmann/json.hpp>
+#include <rttr/type>
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <set>
+
+using namespace Snowstorm;
+
+namespace
+{
+	// Every entity's SerializeEntity JSON, keyed by UUID: two worlds hold the same scene iff these match
+	// (entity order is not part of a scene).
+	std::map<std::string, nlohmann::json> Snapshot(World& world)
+	{
+		std::map<std::string, nlohmann::json> entities;
+		for (auto view = world.GetRegistry().view<IDComponent>(); const auto e : view)
+		{
+			nlohmann::json entity;
+			REQUIRE(SceneSerializer::SerializeEntity(Entity{e, &world}, entity));
+			entities[entity["UUID"].get<std::string>()] = std::move(entity);
+		}
+		return entities;
+	}
+
+	// A small scene touching both chunk encodings: every component with generated columns, each with
+	// non-default values, and the JSON fallback (material overrides).
+	void PopulateScene(World& world)
+	{
+		Entity sun = world.CreateEntity("Sun");
+		sun.AddComponent<DirectionalLightComponent>() = {.Enabled = true, .Direction = {0.2f, -1.0f, 0.1f}, .Color = {1.0f, 0.9f, 0.8f}, .Intensity = 3.5f, .CastShadows = false};
+
+		for (int i = 0; i < 5; ++i)
+		{
+			Entity prop = world.CreateEntity("Crate"); // repeated tag: one string table entry
+			auto& transform = prop.AddComponent<TransformComponent>();
+			transform.Position = {static_cast<float>(i), 2.0f, -static_cast<float>(i)};
+			transform.Rotation = {0.0f, 0.5f * static_cast<float>(i), 0.0f};
+			transform.Scale = {1.0f, 1.0f + static_cast<float>(i), 1.0f};
+			prop.AddComponent<MeshComponent>().MeshHandle = UUID(1000 + i);
+			prop.AddComponent<MaterialComponent>().Material = UUID(2000 + i);
+		}
+
+		Entity spinner = world.CreateEntity("Spinner");
+		spinner.AddComponent<TransformComponent>();
+		spinner.AddComponent<RotatorComponent>() = {.Axis = {1.0f, 0.0f, 0.5f}, .SpeedDegPerSec = -45.0f};
+		spinner.AddComponent<VisibilityComponent>().Mask = Visibility::Game | Visibility::MaterialPreview;
+
+		Entity bulb = world.CreateEntity("Bulb");
+		bulb.AddComponent<TransformComponent>().Position = {-1.0f, 2.5f, 0.0f};
+		bulb.AddComponent<PointLightComponent>() = {.Enabled = false, .Color = {0.3f, 0.6f, 1.0f}, .Intensity = 8.0f, .Range = 12.0f, .CastShadows = false, .ShadowPriority = 0.5f};
+
+		Entity lamp = world.CreateEntity("Lamp");
+		lamp.AddComponent<TransformComponent>().Position = {4.0f, 3.0f, 2.0f};
+		auto& spot = lamp.AddComponent<SpotLightComponent>();
+		spot.Range = 25.0f;
+		spot.InnerAngleDeg = 12.0f;
+		spot.ShadowPriority = 2.0f;
+		auto& overrides = lamp.AddComponent<MaterialOverridesComponent>();
+		overrides.Overrides.push_back({.Name = "BaseColor", .Type = MaterialOverrideType::Color, .Color = {0.1f, 0.2f, 0.3f, 1.0f}});
+		overrides.Overrides.push_back({.Name = "AlbedoTexture", .Type = MaterialOverrideType::Texture, .Texture = UUID(77)});
+
+		Entity camera = world.CreateEntity("Camera");
+		camera.AddComponent<TransformComponent>();
+		auto& cc = camera.AddComponent<CameraComponent>();
+		cc.Projection = CameraComponent::ProjectionType::Orthographic;
+		cc.OrthographicSize = 42.0f;
+		cc.Primary = false;
+		camera.AddComponent<CameraVisibilityComponent>().Mask = Visibility::Game;
+		camera.AddComponent<CameraTargetComponent>().TargetViewportUUID = UUID(31337);
+	}
+}
+
+TEST_CASE("Binary scenes round-trip every serialized component", "[scene][serialize]")
+{
+	World source;
+	PopulateScene(source);
+
+	// Editor-owned entities stay out of the file, as in the JSON format.
+	Entity editorCamera = source.CreateEntity("EditorCamera");
+	editorCamera.AddComponent<DoNotSerializeComponent>();
+	const std::string editorCameraUuid = editorCamera.GetComponent<IDComponent>().Id.ToString();
+
+	const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(source);
+	REQUIRE_FALSE(bytes.empty());
+
+	World loaded;
+	REQUIRE(SceneBinarySerializer::DeserializeFromBytes(loaded, bytes));
+
+	std::map<std::string, nlohmann::json> expected = Snapshot(source);
+	expected.erase(editorCameraUuid);
+	CHECK(Snapshot(loaded) == expected);
+
+	// Mesh handles came back through the generated column codec.
+	std::vector<uint64_t> meshes;
+	for (auto view = loaded.GetRegistry().view<MeshComponent>(); const auto e : view)
+	{
+		meshes.push_back(Entity{e, &loaded}.GetComponent<MeshComponent>().MeshHandle.Value());
+	}
+	std::ranges::sort(meshes);
+	CHECK(meshes == std::vector<uint64_t>{1000, 1001, 1002, 1003, 1004});
+}
+
+TEST_CASE("Binary scenes decode in parallel to the same world as serially", "[scene][serialize]")
+{
+	// More entities than one chunk holds, so the transform column splits into several decode tasks.
+	World source;
+	for (int i = 0; i < 20000; ++i)
+	{
+		Entity entity = source.CreateEntity(i % 2 ? "Odd" : "Even");
+		entity.AddComponent<TransformComponent>().Position = {static_cast<float>(i), 0.0f, 0.0f};
+		if (i % 7 == 0)
+		{
+			entity.AddComponent<PointLightComponent>().Range = static_cast<float>(i % 100);
+		}
+	}
+	const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(source);
+
+	JobSystem jobs;
+	World parallel;
+	REQUIRE(SceneBinarySerializer::DeserializeFromBytes(parallel, bytes, &jobs));
+	World serial;
+	REQUIRE(SceneBinarySerializer::DeserializeFromBytes(serial, bytes));
+
+	const std::map<std::string, nlohmann::json> expected = Snapshot(source);
+	CHECK(expected.size() == 20000);
+	CHECK(Snapshot(parallel) == expected);
+	CHECK(Snapshot(serial) == expected);
+}
+
+TEST_CASE("Binary scenes committed in slices match a whole load", "[scene][serialize]")
+{
+	World source;
+	PopulateScene(source);
+	const std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(source);
+
+	DecodedScene decoded;
+	REQUIRE(SceneBinarySerializer::Decode(bytes, decoded));
+	World sliced;
+	std::vector<Entity> created;
+	while (!decoded.IsFullyCommitted())
+	{
+		REQUIRE(decoded.CommitSlice(sliced, 2, &created) > 0);
+	}
+	CHECK(created.size() == decoded.GetEntityCount());
+	CHECK(decoded.CommitSlice(sliced, 2) == 0);
+
+	World whole;
+	REQUIRE(SceneBinarySerializer::DeserializeFromBytes(whole, bytes));
+	CHECK(Snapshot(sliced) == Snapshot(whole));
+}
+
+TEST_CASE("JSON and binary scenes convert losslessly", "[scene][serialize]")
+{
+	World source;
+	PopulateScene(source);
+	const std::string json = SceneSerializer::SerializeToString(source);
+
+	const std::vector<uint8_t> binary = SceneBinarySerializer::ConvertJsonToBinary(json);
+	REQUIRE_FALSE(binary.empty());
+	const std::string roundTripped = SceneBinarySerializer::ConvertBinaryToJson(binary);
+	REQUIRE_FALSE(roundTripped.empty());
+
+	World fromJson;
+	REQUIRE(SceneSerializer::DeserializeFromString(fromJson, json));
+	World fromRoundTrip;
+	REQUIRE(SceneSerializer::DeserializeFromString(fromRoundTrip, roundTripped));
+	CHECK(Snapshot(fromRoundTrip) == Snapshot(fromJson));
+
+	// And through files: SceneSerializer picks the format by extension.
+	const ScratchDirectory scratch("Snowstorm-SceneBinarySerializerTests");
+	const std::string worldPath = (scratch.GetPath() / "Scene.world").string();
+	const std::string binaryPath = (scratch.GetPath() / "Scene.ssworld").string();
+	REQUIRE(SceneSerializer::Serialize(source, worldPath));
+	REQUIRE(SceneBinarySerializer::ConvertFile(worldPath, binaryPath));
+
+	World fromFile;
+	REQUIRE(SceneSerializer::Deserialize(fromFile, binaryPath));
+	CHECK(Snapshot(fromFile) == Snapshot(source));
+}
+
+TEST_CASE("Binary column lists cover every reflected property", "[scene][serialize]")
+{
+	// A property missing from a component's field list would silently not be saved by the binary format.
+	const std::vector<SceneBinarySerializer::ColumnFieldList> lists = SceneBinarySerializer::GetColumnFieldLists();
+	CHECK(lists.size() == 11);
+	for (const SceneBinarySerializer::ColumnFieldList& list : lists)
+	{
+		INFO(list.TypeName);
+		const rttr::type type = rttr::type::get_by_name(list.TypeName);
+		REQUIRE(type.is_valid());
+
+		std::set<std::string> reflected;
+		for (const rttr::property& property : type.get_properties())
+		{
+			reflected.insert(property.get_name().to_string());
+		}
+		const std::set<std::string> listed(list.Fields.begin(), list.Fields.end());
+		CHECK(listed.size() == list.Fields.size());
+		CHECK(listed == reflected);
+	}
+}
+
+TEST_CASE("Binary scene loading rejects foreign and truncated data", "[scene][serialize]")
+{
+	World source;
+	PopulateScene(source);
+	std::vector<uint8_t> bytes = SceneBinarySerializer::SerializeToBytes(source);
+
+	World world;
+	SECTION("Not a scene")
+	{
+		const std::vector<uint8_t> text = {'{', '}', '\n', 0, 0, 0, 0, 0};
+		CHECK_FALSE(SceneBinarySerializer::DeserializeFromBytes(world, text));
+	}
+
+	SECTION("Truncated")
+	{
+		bytes.resize(bytes.size() - 3);
+		CHECK_FALSE(SceneBinarySerializer::DeserializeFromBytes(world, bytes));
+	}
+
+	SECTION("Empty")
+	{
+		CHECK_FALSE(SceneBinarySerializer::DeserializeFromBytes(world, {}));
+	}
+
+	// Rejected before any entity is created.
+	CHECK(Snapshot(world).empty());
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+
+namespace Snowstorm
+{
+	// A fresh, empty directory under the system temp directory for one test, removed again when it goes out of
+	// scope — including when a REQUIRE aborts the test case halfway, which is what a trailing remove_all missed.
+	// The random suffix matters: ctest -j runs test processes side by side, and two of them must never clear or
+	// write the same directory.
+	class ScratchDirectory
+	{
+	public:
+		explicit ScratchDirectory(const char* name)
+			: m_Path(std::filesystem::temp_directory_path() / (std::string(name) + "-" + std::to_string(std::random_device{}())))
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_Path, ec);
+			std::filesystem::create_directories(m_Path);
+		}
+
+		~ScratchDirectory()
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(m_Path, ec);
+		}
+
+		ScratchDirectory(const ScratchDirectory&) = delete;
+		ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+		[[nodiscard]] const std::filesystem::path& GetPath() const { return m_Path; }
+
+	private:
+		std::filesystem::path m_Path;
+	};
+}
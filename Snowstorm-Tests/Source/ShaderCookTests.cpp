@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/ShaderBundle.hpp"
+#include "Snowstorm/Render/ShaderPermutationManifest.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	void WriteFile(const std::filesystem::path& p, const std::string& text)
+	{
+		std::filesystem::create_directories(p.parent_path());
+		std::ofstream out(p, std::ios::binary | std::ios::trunc);
+		out << text;
+	}
+
+	std::string ReadFile(const std::filesystem::path& p)
+	{
+		std::ifstream in(p, std::ios::binary);
+		return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+	}
+
+	std::vector<uint8_t> Bytes(const std::string& s)
+	{
+		return {s.begin(), s.end()};
+	}
+}
+
+TEST_CASE("ShaderBundle round-trips entries and extracts them into the cache", "[shadercook]")
+{
+	const ScratchDirectory scratch("ss_shaderbundle_test");
+	const std::filesystem::path& dir = scratch.GetPath();
+	const auto path = dir / "Shaders.ssbundle";
+
+	const std::vector<ShaderBundle::Entry> entries{
+	    {"Sky.frag_00000000000000aa.spv", Bytes("frag-spirv")},
+	    {"AO.comp_00000000000000bb.spv", Bytes("comp-spirv-longer")},
+	    {"Sky.frag_00000000000000aa.spv", Bytes("duplicate-dropped")},
+	};
+	REQUIRE(ShaderBundle::Write(path, entries));
+
+	const auto bundle = ShaderBundle::Open(path);
+	REQUIRE(bundle.has_value());
+	CHECK(bundle->Size() == 2);
+	CHECK(bundle->Contains("AO.comp_00000000000000bb.spv"));
+	CHECK_FALSE(bundle->Contains("Missing_0000000000000000.spv"));
+
+	// First entry wins on a duplicate name.
+	CHECK(bundle->Read("Sky.frag_00000000000000aa.spv") == Bytes("frag-spirv"));
+	CHECK(bundle->Read("AO.comp_00000000000000bb.spv") == Bytes("comp-spirv-longer"));
+	CHECK_FALSE(bundle->Read("Missing_0000000000000000.spv").has_value());
+
+	// Extract is the runtime cache fill: the file appears under the requested path with the exact bytes.
+	const auto dst = dir / "cache" / "shaders" / "AO.comp_00000000000000bb.spv";
+	REQUIRE(bundle->Extract("AO.comp_00000000000000bb.spv", dst));
+	CHECK(ReadFile(dst) == "comp-spirv-longer");
+	CHECK_FALSE(bundle->Extract("Missing_0000000000000000.spv", dir / "cache" / "missing.spv"));
+}
+
+// A damaged bundle must read as "no bundle" (the runtime then compiles), never as wrong SPIR-V.
+TEST_CASE("ShaderBundle rejects missing, foreign and truncated files", "[shadercook]")
+{
+	const ScratchDirectory scratch("ss_shaderbundle_corrupt_test");
+	const std::filesystem::path& dir = scratch.GetPath();
+
+	CHECK_FALSE(ShaderBundle::Open(dir / "absent.ssbundle").has_value());
+
+	WriteFile(dir / "foreign.ssbundle", "not a shader bundle at all");
+	CHECK_FALSE(ShaderBundle::Open(dir / "foreign.ssbundle").has_value());
+
+	const auto path = dir / "truncated.ssbundle";
+	REQUIRE(ShaderBundle::Write(path, {{"Big.comp_0000000000000001.spv", std::vector<uint8_t>(4096, 0x23)}}));
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+	CHECK_FALSE(ShaderBundle::Open(path).has_value());
+}
+
+TEST_CASE("Permutation manifest expands wildcards across the default variants", "[shadercook]")
+{
+	const ScratchDirectory scratch("ss_permutations_test");
+	const std::filesystem::path& root = scratch.GetPath();
+	WriteFile(root / "Engine/Shaders/Mesh.vert.hlsl", "");
+	WriteFile(root / "Engine/Shaders/Sky.frag.hlsl", "");
+	WriteFile(root / "Engine/Shaders/AO.comp.hlsl", "");
+	WriteFile(root / "Engine/Shaders/IBLBRDFLut.hlsl", "");
+	WriteFile(root / "Engine/Shaders/Include/Engine.hlsli", "");
+	WriteFile(root / "Engine/Shaders/README.md", "");
+	WriteFile(root / "Engine/Shaders/Permutations.json", R"({
+		"Type": "SnowstormShaderPermutations", "Version": 1,
+		"DefaultVariants": [[], ["SS_RAYTRACING=1"]],
+		"Shaders": [ { "Source": "Engine/Shaders/*.hlsl" } ]
+	})");
+
+	const auto jobs = ShaderPermutationManifestIO::Load(root / "Engine/Shaders/Permutations.json", root);
+	REQUIRE(jobs.has_value());
+	// 4 sources (headers in Include/ and non-.hlsl files excluded) x 2 variants.
+	REQUIRE(jobs->size() == 8);
+
+	const auto stageOf = [&](const std::string& source)
+	{
+		for (const ShaderPermutationJob& job : *jobs)
+		{
+			if (job.Source == source)
+				return job.Stage;
+		}
+		FAIL("missing " << source);
+		return ShaderStageKind::Compute;
+	};
+	CHECK(stageOf("Engine/Shaders/Mesh.vert.hlsl") == ShaderStageKind::Vertex);
+	CHECK(stageOf("Engine/Shaders/Sky.frag.hlsl") == ShaderStageKind::Fragment);
+	CHECK(stageOf("Engine/Shaders/AO.comp.hlsl") == ShaderStageKind::Compute);
+	CHECK(stageOf("Engine/Shaders/IBLBRDFLut.hlsl") == ShaderStageKind::Compute); // stage-less == compute
+}
+
+TEST_CASE("Permutation manifest honours per-entry overrides and drops duplicates", "[shadercook]")
+{
+	const ScratchDirectory scratch("ss_permutations_override_test");
+	const std::filesystem::path& root = scratch.GetPath();
+	WriteFile(root / "Engine/Shaders/NeuralConv.comp.hlsl", "");
+	WriteFile(root / "Engine/Shaders/Sky.frag.hlsl", "");
+	WriteFile(root / "Permutations.json", R"({
+		"Type": "SnowstormShaderPermutations", "Version": 1,
+		"DefaultVariants": [[]],
+		"Shaders": [
+			{ "Source": "Engine/Shaders/*.hlsl" },
+			{ "Source": "Engine/Shaders/NeuralConv.comp.hlsl", "Variants": [[], ["SS_FP16=1"]] },
+			{ "Source": "Engine/Shaders/Sky.frag.hlsl", "Stage": "Compute" }
+		]
+	})");
+
+	const auto jobs = ShaderPermutationManifestIO::Load(root / "Permutations.json", root);
+	REQUIRE(jobs.has_value());
+
+	// NeuralConv: [] from the wildcard and [] again from its override collapse to one, plus the fp16 variant.
+	// Sky: the wildcard's Fragment build plus the explicit Compute one (a different profile, so both stay).
+	size_t neural = 0, skyFragment = 0, skyCompute = 0;
+	for (const ShaderPermutationJob& job : *jobs)
+	{
+		if (job.Source == "Engine/Shaders/NeuralConv.comp.hlsl")
+			++neural;
+		else if (job.Source == "Engine/Shaders/Sky.frag.hlsl")
+			(job.Stage == ShaderStageKind::Fragment ? skyFragment : skyCompute)++;
+	}
+	CHECK(neural == 2);
+	CHECK(skyFragment == 1);
+	CHECK(skyCompute == 1);
+	CHECK(jobs->size() == 4);
+}
+
+TEST_CASE("Permutation manifest rejects malformed input", "[shadercook]")
+{
+	const ScratchDirectory scratch("ss_permutations_bad_test");
+	const std::filesystem::path& root = scratch.GetPath();
+
+	CHECK_FALSE(ShaderPermutationManifestIO::Load(root / "absent.json", root).has_value());
+
+	WriteFile(root / "wrongtype.json", R"({ "Type": "SnowstormProject", "Shaders": [] })");
+	CHECK_FALSE(ShaderPermutationManifestIO::Load(root / "wrongtype.json", root).has_value());
+
+	WriteFile(root / "badstage.json", R"({ "Type": "SnowstormShaderPermutations",
+		"Shaders": [ { "Source": "A.hlsl", "Stage": "Geometry" } ] })");
+	CHECK_FALSE(ShaderPermutationManifestIO::Load(root / "badstage.json", root).has_value());
+
+	WriteFile(root / "badvariants.json", R"({ "Type": "SnowstormShaderPermutations",
+		"DefaultVariants": ["SS_FP16=1"], "Shaders": [] })");
+	CHECK_FALSE(ShaderPermutationManifestIO::Load(root / "badvariants.json", root).has_value());
+}
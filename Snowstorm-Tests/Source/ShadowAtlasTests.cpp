@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/ShadowAtlas.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace Snowstorm;
+
+namespace
+{
+	std::vector<ShadowAtlasTile> Place(ShadowAtlasAllocator& atlas, const std::vector<ShadowAtlasRequest>& requests)
+	{
+		std::vector<ShadowAtlasTile> tiles;
+		atlas.Allocate(requests, tiles);
+		REQUIRE(tiles.size() == requests.size());
+		return tiles;
+	}
+
+	// Every placed tile is inside the atlas, aligned to its own size, and disjoint from every other.
+	void CheckPacking(const ShadowAtlasAllocator& atlas, const std::vector<ShadowAtlasTile>& tiles)
+	{
+		for (size_t i = 0; i < tiles.size(); ++i)
+		{
+			const ShadowAtlasTile& a = tiles[i];
+			if (a.Size == 0)
+			{
+				continue;
+			}
+			CHECK(a.X % a.Size == 0);
+			CHECK(a.Y % a.Size == 0);
+			CHECK(a.X + a.Size <= atlas.GetAtlasSize());
+			CHECK(a.Y + a.Size <= atlas.GetAtlasSize());
+			for (size_t j = i + 1; j < tiles.size(); ++j)
+			{
+				const ShadowAtlasTile& b = tiles[j];
+				if (b.Size == 0)
+				{
+					continue;
+				}
+				const bool disjoint = a.X + a.Size <= b.X || b.X + b.Size <= a.X || a.Y + a.Size <= b.Y || b.Y + b.Size <= a.Y;
+				CHECK(disjoint);
+			}
+		}
+	}
+
+	bool SameTile(const ShadowAtlasTile& a, const ShadowAtlasTile& b)
+	{
+		return a.X == b.X && a.Y == b.Y && a.Size == b.Size;
+	}
+}
+
+TEST_CASE("Shadow atlas packs mixed tile sizes without overlap", "[shadows]")
+{
+	ShadowAtlasAllocator atlas;
+	atlas.Configure(4096, 1024);
+	REQUIRE(atlas.GetAtlasSize() == 4096);
+
+	// Exactly the atlas area: 4 x 1024^2 + 32 x 512^2 + 64 x 256^2 = 4 + 8 + 4 = 16 Mtexels.
+	std::vector<ShadowAtlasRequest> requests;
+	uint64_t key = 1;
+	for (int i = 0; i < 64; ++i)
+	{
+		requests.push_back({.Key = key++, .IdealSize = 256.0f, .Priority = 1.0f});
+	}
+	for (int i = 0; i < 32; ++i)
+	{
+		requests.push_back({.Key = key++, .IdealSize = 512.0f, .Priority = 2.0f});
+	}
+	for (int i = 0; i < 4; ++i)
+	{
+		requests.push_back({.Key = key++, .IdealSize = 1000.0f, .Priority = 3.0f}); // quantizes to 1024
+	}
+
+	const auto tiles = Place(atlas, requests);
+	CheckPacking(atlas, tiles);
+	for (size_t i = 0; i < requests.size(); ++i)
+	{
+		CHECK(tiles[i].Size == (i < 64 ? 256u : i < 96 ? 512u : 1024u));
+	}
+	CHECK(atlas.GetOccupancy() == 1.0f);
+
+	// Sizes clamp to [kMinTileSize, max tile].
+	ShadowAtlasAllocator small;
+	small.Configure(2048, 512);
+	const auto clamped = Place(small, {{.Key = 1, .IdealSize = 5000.0f, .Priority = 1.0f}, {.Key = 2, .IdealSize = 3.0f, .Priority = 1.0f}});
+	CHECK(clamped[0].Size == 512);
+	CHECK(clamped[1].Size == ShadowAtlasAllocator::kMinTileSize);
+}
+
+TEST_CASE("Shadow atlas serves priority first when it runs out of room", "[shadows]")
+{
+	ShadowAtlasAllocator atlas;
+	atlas.Configure(2048, 1024);
+
+	// 40 spots all wanting 1024^2 -- ten times what fits. Everyone shrinks to share the atlas, low priorities
+	// first and furthest, and nothing overlaps.
+	std::vector<ShadowAtlasRequest> requests;
+	for (uint64_t i = 0; i < 40; ++i)
+	{
+		requests.push_back({.Key = i, .IdealSize = 1024.0f, .Priority = static_cast<float>(i)});
+	}
+	const auto tiles = Place(atlas, requests);
+	CheckPacking(atlas, tiles);
+	CHECK(tiles[39].Size == 512);
+	CHECK(tiles[0].Size == 256);
+	CHECK(atlas.GetOccupancy() > 0.9f);
+	uint32_t placed = 0;
+	for (size_t i = 0; i < tiles.size(); ++i)
+	{
+		placed += tiles[i].Size > 0 ? 1 : 0;
+		if (i > 0 && tiles[i - 1].Size > 0)
+		{
+			CHECK(tiles[i].Size >= tiles[i - 1].Size); // never a bigger tile for a lower priority
+		}
+	}
+	CHECK(placed == 40); // dozens of shadowed spots in one atlas
+
+	// A full atlas of low-priority minimum tiles: a new high-priority light evicts its way in.
+	ShadowAtlasAllocator full;
+	full.Configure(256, 256);
+	std::vector<ShadowAtlasRequest> crowd;
+	for (uint64_t i = 0; i < 16; ++i)
+	{
+		crowd.push_back({.Key = i, .IdealSize = 64.0f, .Priority = 1.0f + static_cast<float>(i)});
+	}
+	CheckPacking(full, Place(full, crowd));
+	crowd.push_back({.Key = 100, .IdealSize = 64.0f, .Priority = 100.0f});
+	const auto after = Place(full, crowd);
+	CheckPacking(full, after);
+	CHECK(after[16].Size == 64);
+	CHECK(after[0].Size == 0); // the lowest priority lost its tile
+	CHECK(after[15].Size == 64);
+}
+
+// Placement stability: tiles must not thrash between frames, or every moved tile re-renders (and the shadow
+// tile cache, keyed by rect, misses).
+TEST_CASE("Shadow atlas keeps placements stable across frames", "[shadows]")
+{
+	ShadowAtlasAllocator atlas;
+	atlas.Configure(4096, 1024);
+
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> size(100.0f, 1100.0f);
+	std::vector<ShadowAtlasRequest> requests;
+	for (uint64_t i = 0; i < 30; ++i)
+	{
+		requests.push_back({.Key = i * 7 + 1, .IdealSize = size(rng), .Priority = size(rng)});
+	}
+	const auto first = Place(atlas, requests);
+	CheckPacking(atlas, first);
+
+	// Same requests: identical placement.
+	const auto same = Place(atlas, requests);
+	for (size_t i = 0; i < requests.size(); ++i)
+	{
+		CHECK(SameTile(first[i], same[i]));
+	}
+
+	// Wanted sizes drifting by less than the hysteresis band (+-25%, i.e. < 0.75 octave from the size held,
+	// even from right at a rounding boundary): nothing moves or resizes.
+	auto jittered = requests;
+	std::uniform_real_distribution<float> drift(0.8f, 1.25f);
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			jittered[i].IdealSize = static_cast<float>(first[i].Size) * drift(rng);
+			jittered[i].Priority = requests[i].Priority * drift(rng);
+		}
+		const auto tiles = Place(atlas, jittered);
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			CHECK(SameTile(first[i], tiles[i]));
+		}
+	}
+
+	// A light leaving, and a new one arriving, leave everyone else where they were.
+	auto fewer = requests;
+	fewer.erase(fewer.begin() + 5);
+	fewer.push_back({.Key = 999, .IdealSize = 256.0f, .Priority = 1.0f});
+	const auto churned = Place(atlas, fewer);
+	CheckPacking(atlas, churned);
+	for (size_t i = 0; i + 1 < fewer.size(); ++i)
+	{
+		const size_t original = i < 5 ? i : i + 1;
+		CHECK(SameTile(first[original], churned[i]));
+	}
+	CHECK(churned.back().Size == 256);
+}
+
+TEST_CASE("Shadow atlas merges freed tiles and resets on resize", "[shadows]")
+{
+	ShadowAtlasAllocator atlas;
+	atlas.Configure(1024, 1024);
+
+	std::vector<ShadowAtlasRequest> many;
+	for (uint64_t i = 0; i < 64; ++i)
+	{
+		many.push_back({.Key = i, .IdealSize = 128.0f, .Priority = 1.0f});
+	}
+	CheckPacking(atlas, Place(atlas, many));
+	CHECK(atlas.GetOccupancy() == 1.0f);
+
+	// Every small tile released: the quadtree merges back into one free root, which holds a full-size tile.
+	const auto whole = Place(atlas, {{.Key = 500, .IdealSize = 1024.0f, .Priority = 1.0f}});
+	CHECK(whole[0].Size == 1024);
+	CHECK(whole[0].X == 0);
+	CHECK(whole[0].Y == 0);
+
+	// Growing: a tile whose wanted size doubles moves once room is free.
+	const auto grown = Place(atlas, {{.Key = 500, .IdealSize = 256.0f, .Priority = 1.0f}});
+	CHECK(grown[0].Size == 256);
+
+	atlas.Configure(2048, 1024);
+	CHECK(atlas.GetAtlasSize() == 2048);
+	CHECK(atlas.GetOccupancy() == 0.0f);
+	atlas.Configure(3000, 100000); // powers of two, tile <= atlas
+	CHECK(atlas.GetAtlasSize() == 2048);
+	CHECK(atlas.GetMaxTileSize() == 2048);
+}
+
+TEST_CASE("Shadow screen coverage follows distance, not direction", "[shadows]")
+{
+	const glm::mat4 view = glm::lookAtRH(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(90.0f), 1.0f, 0.1f, 500.0f);
+
+	CHECK(ShadowScreenCoverage(view, proj, {0.0f, 0.0f, -2.0f}, 5.0f) == 1.0f); // camera inside the light
+	const float near = ShadowScreenCoverage(view, proj, {0.0f, 0.0f, -20.0f}, 5.0f);
+	const float far = ShadowScreenCoverage(view, proj, {0.0f, 0.0f, -80.0f}, 5.0f);
+	const float behind = ShadowScreenCoverage(view, proj, {0.0f, 0.0f, 80.0f}, 5.0f);
+	CHECK(near > far);
+	CHECK(far > 0.0f);
+	CHECK(behind == far);
+	// 90-degree FOV: a sphere at distance d with radius r spans tan(asin(r/d)) of the half-height.
+	CHECK(std::abs(far - 5.0f / std::sqrt(80.0f * 80.0f - 25.0f)) < 1e-4f);
+	CHECK(ShadowScreenCoverage(view, proj, {0.0f, 0.0f, -20.0f}, 0.0f) == 0.0f);
+
+	const glm::mat4 ortho = glm::orthoRH_ZO(-10.0f, 10.0f, -10.0f, 10.0f, 0.0f, 100.0f);
+	CHECK(std::abs(ShadowScreenCoverage(view, ortho, {0.0f, 0.0f, -50.0f}, 2.0f) - 0.2f) < 1e-5f);
+}
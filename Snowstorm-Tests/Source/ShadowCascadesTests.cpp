@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/ShadowCascades.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <random>
+
+using namespace Snowstorm;
+
+namespace
+{
+	const glm::vec3 kSunDir = glm::normalize(glm::vec3(0.3f, -1.0f, 0.45f));
+	const AABB kScene{{-200.0f, -5.0f, -200.0f}, {200.0f, 40.0f, 200.0f}};
+
+	glm::mat4 MakeProjection()
+	{
+		return glm::perspectiveRH_ZO(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+	}
+
+	glm::mat4 MakeView(const glm::vec3& eye, const float yaw)
+	{
+		const glm::vec3 forward{std::sin(yaw), -0.2f, -std::cos(yaw)};
+		return glm::lookAtRH(eye, eye + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	ShadowCascadeSet Fit(const glm::mat4& view, const ShadowCascadeSettings& settings)
+	{
+		ShadowCascadeSet set;
+		REQUIRE(FitShadowCascades(view, MakeProjection(), kSunDir, kScene, settings, set));
+		return set;
+	}
+
+	bool Contains(const AABB& box, const glm::vec3& p)
+	{
+		return p.x >= box.Min.x && p.y >= box.Min.y && p.z >= box.Min.z && p.x <= box.Max.x && p.y <= box.Max.y &&
+		       p.z <= box.Max.z;
+	}
+
+	// Where the world origin lands in a cascade's map, in texels. Texel-snapped cascades keep this integral
+	// (up to float noise) wherever the camera is.
+	glm::vec2 OriginTexel(const ShadowCascade& cascade, const uint32_t resolution)
+	{
+		const glm::vec4 clip = cascade.ViewProj * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		return glm::vec2(clip.x, clip.y) * (0.5f * static_cast<float>(resolution));
+	}
+}
+
+TEST_CASE("Shadow cascade splits blend uniform and logarithmic", "[shadows]")
+{
+	const auto uniform = ComputeShadowCascadeSplits(1.0f, 101.0f, 4, 0.0f);
+	CHECK(uniform[0] == 1.0f);
+	CHECK(std::abs(uniform[1] - 26.0f) < 1e-4f);
+	CHECK(std::abs(uniform[2] - 51.0f) < 1e-4f);
+	CHECK(uniform[4] == 101.0f);
+
+	const auto logarithmic = ComputeShadowCascadeSplits(1.0f, 10000.0f, 4, 1.0f);
+	CHECK(std::abs(logarithmic[1] - 10.0f) < 1e-3f);
+	CHECK(std::abs(logarithmic[2] - 100.0f) < 1e-2f);
+	CHECK(std::abs(logarithmic[3] - 1000.0f) < 1e-1f);
+
+	// Fewer cascades: the unused tail reads as far.
+	const auto two = ComputeShadowCascadeSplits(0.1f, 150.0f, 2, 0.75f);
+	CHECK(two[1] > 0.1f);
+	CHECK(two[1] < 75.05f);
+	CHECK(two[2] == 150.0f);
+	CHECK(two[4] == 150.0f);
+}
+
+// Every point of a camera slice, and every caster between it and the sun, must land inside its cascade's
+// map -- otherwise the slice's receivers read as lit at the cascade border.
+TEST_CASE("Shadow cascades cover their slice and the casters above it", "[shadows]")
+{
+	ShadowCascadeSettings settings;
+	settings.Count = 4;
+	settings.FirstCachedCascade = 2;
+	const glm::mat4 view = MakeView({12.0f, 3.0f, -7.0f}, 0.6f);
+	const ShadowCascadeSet set = Fit(view, settings);
+	REQUIRE(set.Count == 4);
+	CHECK(set.Cascades[3].SplitFar == settings.MaxDistance);
+
+	const glm::mat4 viewToWorld = glm::inverse(view);
+	const glm::mat4 clipToView = glm::inverse(MakeProjection());
+	std::mt19937 rng(4);
+	std::uniform_real_distribution<float> ndc(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	for (uint32_t i = 0; i < set.Count; ++i)
+	{
+		const ShadowCascade& cascade = set.Cascades[i];
+		CHECK(cascade.Cacheable == (i >= 2));
+		CHECK(cascade.SplitNear < cascade.SplitFar);
+		for (int s = 0; s < 500; ++s)
+		{
+			// A random point of the slice: a random NDC ray at a random depth in [SplitNear, SplitFar].
+			const float x = s < 4 ? ((s & 1) ? 1.0f : -1.0f) : ndc(rng);
+			const float y = s < 4 ? ((s & 2) ? 1.0f : -1.0f) : ndc(rng);
+			glm::vec4 a = clipToView * glm::vec4(x, y, 0.0f, 1.0f);
+			glm::vec4 b = clipToView * glm::vec4(x, y, 1.0f, 1.0f);
+			const glm::vec3 rayNear = glm::vec3(a) / a.w;
+			const glm::vec3 rayFar = glm::vec3(b) / b.w;
+			const float depth = cascade.SplitNear + (cascade.SplitFar - cascade.SplitNear) * (s < 4 ? 1.0f : unit(rng));
+			const float t = (-depth - rayNear.z) / (rayFar.z - rayNear.z);
+			const glm::vec3 p = glm::vec3(viewToWorld * glm::vec4(rayNear + (rayFar - rayNear) * t, 1.0f));
+
+			const glm::vec4 clip = cascade.ViewProj * glm::vec4(p, 1.0f);
+			CHECK(std::abs(clip.x) <= 1.0f);
+			CHECK(std::abs(clip.y) <= 1.0f);
+
+			// A caster straight up-sun of the receiver is inside the depth range, as long as it's part of the
+			// scene (the range is fitted to the caster bounds).
+			const glm::vec3 above = p - kSunDir * 30.0f;
+			if (Contains(kScene, above))
+			{
+				const glm::vec4 caster = cascade.ViewProj * glm::vec4(above, 1.0f);
+				CHECK(caster.z >= 0.0f);
+				CHECK(caster.z <= 1.0f);
+			}
+		}
+	}
+}
+
+// Stability: translating the camera slides each map by whole texels, and turning it never rescales a map.
+TEST_CASE("Shadow cascades are texel-snapped and rotation invariant", "[shadows]")
+{
+	ShadowCascadeSettings settings;
+	settings.Count = 3;
+	const ShadowCascadeSet reference = Fit(MakeView({0.0f, 2.0f, 0.0f}, 0.0f), settings);
+
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> offset(-20.0f, 20.0f);
+	std::uniform_real_distribution<float> yaw(-3.0f, 3.0f);
+	for (int trial = 0; trial < 50; ++trial)
+	{
+		const glm::vec3 eye{offset(rng), 2.0f + 0.1f * offset(rng), offset(rng)};
+		const ShadowCascadeSet set = Fit(MakeView(eye, yaw(rng)), settings);
+		for (uint32_t i = 0; i < set.Count; ++i)
+		{
+			const glm::vec2 texel = OriginTexel(set.Cascades[i], settings.Resolution);
+			CHECK(std::abs(texel.x - std::round(texel.x)) < 0.02f);
+			CHECK(std::abs(texel.y - std::round(texel.y)) < 0.02f);
+			CHECK(set.Cascades[i].TexelSize == reference.Cascades[i].TexelSize);
+		}
+	}
+}
+
+TEST_CASE("Cached shadow cascades hold their matrix across small camera moves", "[shadows]")
+{
+	ShadowCascadeSettings settings;
+	settings.Count = 3;
+	settings.FirstCachedCascade = 2;
+	const ShadowCascadeSet before = Fit(MakeView({0.3f, 2.0f, 0.4f}, 0.2f), settings);
+	const ShadowCascadeSet after = Fit(MakeView({0.3f + 0.05f, 2.0f, 0.4f - 0.05f}, 0.2f), settings);
+
+	// The near cascade follows every texel; the cached far one stays put until its coarse step is crossed.
+	CHECK(before.Cascades[0].ViewProj != after.Cascades[0].ViewProj);
+	CHECK(before.Cascades[2].ViewProj == after.Cascades[2].ViewProj);
+
+	ShadowCascadeCache cache;
+	const glm::mat4& vp = before.Cascades[2].ViewProj;
+	CHECK(cache.NeedsRender(2, vp, 7, 2048));
+	CHECK_FALSE(cache.NeedsRender(2, after.Cascades[2].ViewProj, 7, 2048));
+	CHECK(cache.NeedsRender(2, vp, 8, 2048));   // a caster inside it changed
+	CHECK(cache.NeedsRender(2, vp, 8, 4096));   // the map was resized
+	CHECK_FALSE(cache.NeedsRender(2, vp, 8, 4096));
+	cache.Invalidate(2);
+	CHECK(cache.NeedsRender(2, vp, 8, 4096));
+	CHECK(cache.NeedsRender(1, vp, 8, 4096)); // independent per cascade
+}
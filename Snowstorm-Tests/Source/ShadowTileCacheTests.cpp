@@ -0,0 +1,66 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/ShadowTileCache.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Snowstorm;
+
+namespace
+{
+	glm::mat4 SpotMatrix(const glm::vec3& position)
+	{
+		const glm::mat4 view = glm::lookAtRH(position, position + glm::vec3(0.0f, -1.0f, 0.1f), glm::vec3(0.0f, 1.0f, 0.0f));
+		return glm::perspectiveRH_ZO(glm::radians(60.0f), 1.0f, 0.05f, 20.0f) * view;
+	}
+}
+
+TEST_CASE("Shadow tiles re-render only when their light or casters change", "[shadows]")
+{
+	ShadowTileCache cache;
+	const glm::mat4 light = SpotMatrix({0.0f, 5.0f, 0.0f});
+
+	CHECK(cache.NeedsRender(3, light, 11, false, 1024)); // first sight
+	CHECK_FALSE(cache.NeedsRender(3, light, 11, false, 1024));
+
+	CHECK(cache.NeedsRender(3, light, 11, true, 1024)); // a kept caster moved
+	CHECK_FALSE(cache.NeedsRender(3, light, 11, false, 1024));
+
+	CHECK(cache.NeedsRender(3, light, 12, false, 1024)); // a caster entered/left the frustum
+	CHECK(cache.NeedsRender(3, SpotMatrix({0.0f, 5.0f, 0.5f}), 12, false, 1024)); // the light moved
+	CHECK(cache.NeedsRender(3, SpotMatrix({0.0f, 5.0f, 0.5f}), 12, false, 2048)); // the atlas was resized
+	CHECK_FALSE(cache.NeedsRender(3, SpotMatrix({0.0f, 5.0f, 0.5f}), 12, false, 2048));
+
+	// Tiles are independent; one tile's failed render doesn't disturb another.
+	CHECK(cache.NeedsRender(0, light, 11, false, 2048));
+	cache.Invalidate(3);
+	CHECK(cache.NeedsRender(3, SpotMatrix({0.0f, 5.0f, 0.5f}), 12, false, 2048));
+	CHECK_FALSE(cache.NeedsRender(0, light, 11, false, 2048));
+
+	cache.InvalidateAll();
+	CHECK(cache.NeedsRender(0, light, 11, false, 2048));
+}
+
+// Motion is tracked per frame, so a tile skipped for a frame (its light lost its slot) may have missed a
+// move: it must not come back as a cache hit.
+TEST_CASE("Shadow tiles not checked for a frame are retired", "[shadows]")
+{
+	ShadowTileCache cache;
+	const glm::mat4 light = SpotMatrix({2.0f, 4.0f, -1.0f});
+
+	CHECK(cache.NeedsRender(0, light, 5, false, 512));
+	CHECK(cache.NeedsRender(1, light, 5, false, 512));
+	cache.RetireUnchecked();
+
+	// Frame 2: only tile 0 is live.
+	CHECK_FALSE(cache.NeedsRender(0, light, 5, false, 512));
+	cache.RetireUnchecked();
+
+	// Frame 3: tile 1 is back with the same key, but it wasn't watched in frame 2.
+	CHECK_FALSE(cache.NeedsRender(0, light, 5, false, 512));
+	CHECK(cache.NeedsRender(1, light, 5, false, 512));
+	cache.RetireUnchecked();
+
+	CHECK_FALSE(cache.NeedsRender(1, light, 5, false, 512));
+	cache.Invalidate(42); // out of range: ignored
+}
@@ -0,0 +1,203 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Render/TlasInstanceTable.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Snowstorm;
+
+namespace
+{
+	struct TestRecord
+	{
+		uint32_t Material = 0;
+		glm::mat4 Model{1.0f};
+
+		bool operator==(const TestRecord&) const = default;
+	};
+
+	using Table = TlasInstanceTable<TestRecord>;
+
+	glm::mat4 At(const float x)
+	{
+		return glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 0.0f));
+	}
+
+	TLASInstance Instance(const float x, const uint64_t blas = 100)
+	{
+		return {.Transform = At(x), .BlasAddress = blas};
+	}
+
+	// A full scene sync of keys [0, count), key k at x = k.
+	void SyncScene(Table& table, const uint64_t count)
+	{
+		table.BeginSync();
+		for (uint64_t key = 0; key < count; ++key)
+		{
+			table.Upsert(key, Instance(static_cast<float>(key)), {.Material = 1, .Model = At(static_cast<float>(key))});
+		}
+		table.EndSync();
+	}
+
+	// Move `key` the way TlasBuildSystem does for a changed transform: same instance, new placement.
+	void Move(Table& table, const uint64_t key, const float x)
+	{
+		const uint32_t slot = *table.FindSlot(key);
+		TLASInstance instance = table.GetInstances()[slot];
+		TestRecord record = table.GetRecords()[slot];
+		instance.Transform = At(x);
+		record.Model = At(x);
+		table.Upsert(key, instance, record);
+	}
+}
+
+TEST_CASE("TLAS instance table refits transform-only changes and rebuilds on topology changes", "[tlas]")
+{
+	Table table;
+	SyncScene(table, 8);
+	TlasUpdatePlan plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::Rebuild);
+	REQUIRE(plan.InstanceRanges.size() == 1);
+	CHECK(plan.InstanceRanges[0].First == 0);
+	CHECK(plan.InstanceRanges[0].Count == 8);
+	REQUIRE(plan.RecordRanges.size() == 1);
+	CHECK(plan.RecordRanges[0].Count == 8);
+
+	// Re-syncing an unchanged scene (a streaming or material-dirty frame) does nothing.
+	SyncScene(table, 8);
+	plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::None);
+	CHECK(plan.InstanceRanges.empty());
+	CHECK(plan.RecordRanges.empty());
+
+	// Moving props refits, and only their slots are rewritten.
+	Move(table, 2, 20.0f);
+	Move(table, 3, 30.0f);
+	Move(table, 6, 60.0f);
+	plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::Refit);
+	REQUIRE(plan.InstanceRanges.size() == 2);
+	CHECK(plan.InstanceRanges[0].First == 2);
+	CHECK(plan.InstanceRanges[0].Count == 2);
+	CHECK(plan.InstanceRanges[1].First == 6);
+	CHECK(plan.InstanceRanges[1].Count == 1);
+	CHECK(plan.RecordRanges.size() == 2);
+	CHECK(table.GetInstances()[*table.FindSlot(6)].Transform == At(60.0f));
+
+	// A record-only change (a material landed) uploads the record and leaves the TLAS alone.
+	{
+		const uint32_t slot = *table.FindSlot(5);
+		TestRecord record = table.GetRecords()[slot];
+		record.Material = 7;
+		table.Upsert(5, table.GetInstances()[slot], record);
+	}
+	plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::None);
+	REQUIRE(plan.RecordRanges.size() == 1);
+	CHECK(plan.RecordRanges[0].First == 5);
+
+	// A swapped BLAS (OMM baked, mesh swapped) can't be refit.
+	{
+		const uint32_t slot = *table.FindSlot(1);
+		table.Upsert(1, Instance(1.0f, 200), table.GetRecords()[slot]);
+	}
+	CHECK(table.Commit(16).Kind == TlasUpdateKind::Rebuild);
+
+	// Neither can a flipped opacity flag.
+	{
+		const uint32_t slot = *table.FindSlot(4);
+		TLASInstance instance = table.GetInstances()[slot];
+		instance.ForceNonOpaque = true;
+		table.Upsert(4, instance, table.GetRecords()[slot]);
+	}
+	CHECK(table.Commit(16).Kind == TlasUpdateKind::Rebuild);
+
+	// Nor a new instance.
+	table.Upsert(100, Instance(-1.0f), {});
+	plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::Rebuild);
+	CHECK(plan.InstanceRanges[0].Count == 9);
+}
+
+TEST_CASE("TLAS instance table keeps slots dense and the key map consistent", "[tlas]")
+{
+	Table table;
+	SyncScene(table, 6);
+	table.Commit(16);
+
+	// Drop keys 1 and 4: the last slots move into the holes, everything else stays put.
+	table.BeginSync();
+	for (const uint64_t key : {0, 2, 3, 5})
+	{
+		table.Upsert(key, Instance(static_cast<float>(key)), {.Material = 1, .Model = At(static_cast<float>(key))});
+	}
+	table.EndSync();
+	const TlasUpdatePlan plan = table.Commit(16);
+	CHECK(plan.Kind == TlasUpdateKind::Rebuild);
+
+	REQUIRE(table.GetInstances().size() == 4);
+	REQUIRE(table.GetKeys().size() == 4);
+	CHECK_FALSE(table.FindSlot(1).has_value());
+	CHECK_FALSE(table.FindSlot(4).has_value());
+	CHECK(*table.FindSlot(0) == 0);
+	CHECK(*table.FindSlot(2) == 2);
+	CHECK(*table.FindSlot(3) == 3);
+	for (uint32_t slot = 0; slot < 4; ++slot)
+	{
+		// Slot, key, instance and record stay in lockstep: instance i is record i is entity i.
+		const uint64_t key = table.GetKeys()[slot];
+		CHECK(*table.FindSlot(key) == slot);
+		CHECK(table.GetInstances()[slot].Transform == At(static_cast<float>(key)));
+		CHECK(table.GetRecords()[slot].Model == At(static_cast<float>(key)));
+	}
+	// The record moved into a hole must be re-uploaded at its new slot; stale slots past the end are not.
+	for (const TlasSlotRange& range : plan.RecordRanges)
+	{
+		CHECK(range.First + range.Count <= 4);
+	}
+	CHECK_FALSE(plan.RecordRanges.empty());
+
+	CHECK(table.Remove(0));
+	CHECK_FALSE(table.Remove(0));
+	CHECK(table.Commit(16).Kind == TlasUpdateKind::Rebuild);
+	table.Clear();
+	CHECK(table.Commit(16).Kind == TlasUpdateKind::Rebuild); // now empty: an empty TLAS
+	CHECK(table.Commit(16).Kind == TlasUpdateKind::None);
+}
+
+TEST_CASE("TLAS instance table rebuilds once the refit budget is spent", "[tlas]")
+{
+	Table table;
+	SyncScene(table, 4);
+	table.Commit(3);
+
+	for (int frame = 1; frame <= 3; ++frame)
+	{
+		Move(table, 0, static_cast<float>(frame));
+		CHECK(table.Commit(3).Kind == TlasUpdateKind::Refit);
+		table.RecordRefit();
+		CHECK(table.GetRefitsSinceRebuild() == static_cast<uint32_t>(frame));
+	}
+	Move(table, 0, 10.0f);
+	CHECK(table.Commit(3).Kind == TlasUpdateKind::Rebuild);
+	table.RecordRebuild();
+	CHECK(table.GetRefitsSinceRebuild() == 0);
+
+	// A planned refit the backend refused ran as a full build: it spends no budget and resets the count.
+	Move(table, 0, 12.0f);
+	CHECK(table.Commit(3).Kind == TlasUpdateKind::Refit);
+	table.RecordRefit();
+	Move(table, 0, 13.0f);
+	CHECK(table.Commit(3).Kind == TlasUpdateKind::Refit);
+	table.RecordRebuild();
+	CHECK(table.GetRefitsSinceRebuild() == 0);
+
+	// A static frame doesn't spend the budget, and 0 disables refits.
+	CHECK(table.Commit(3).Kind == TlasUpdateKind::None);
+	Move(table, 1, 11.0f);
+	CHECK(table.Commit(0).Kind == TlasUpdateKind::Rebuild);
+
+	// A lost TLAS forces a rebuild even with nothing dirty.
+	table.InvalidateTopology();
+	CHECK(table.Commit(3).Kind == TlasUpdateKind::Rebuild);
+}
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Snowstorm/Components/CameraComponent.hpp"
+#include "Snowstorm/Components/TagComponent.hpp"
+#include "Snowstorm/Components/TransformComponent.hpp"
+#include "Snowstorm/World/Entity.hpp"
+#include "Snowstorm/World/LevelStreamingSingleton.hpp"
+#include "Snowstorm/World/World.hpp"
+#include "Snowstorm/World/WorldPartition.hpp"
+
+#include "ScratchDirectory.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+
+using namespace Snowstorm;
+
+namespace
+{
+	// A 1x1 cell (in XZ) centered on x, costing `bytes`.
+	StreamingCell CellAt(const float x, const uint64_t bytes = 100)
+	{
+		StreamingCell cell;
+		cell.Bounds.Min = {x - 0.5f, 0.0f, -0.5f};
+		cell.Bounds.Max = {x + 0.5f, 10.0f, 0.5f};
+		cell.MemoryBytes = bytes;
+		return cell;
+	}
+
+	StreamingPlanSettings Settings(const float loadRadius, const float unloadRadius, const uint64_t budget = 1000000, const uint32_t maxLoads = 16)
+	{
+		return {.Origin = {0.0f, 0.0f, 0.0f}, .LoadRadius = loadRadius, .UnloadRadius = unloadRadius, .BudgetBytes = budget, .MaxNewLoads = maxLoads};
+	}
+
+	size_t CountTagged(World& world, const std::string& tag)
+	{
+		size_t count = 0;
+		for (auto view = world.GetRegistry().view<TagComponent>(); const auto e : view)
+		{
+			count += Entity{e, &world}.GetComponent<TagComponent>().Tag == tag ? 1 : 0;
+		}
+		return count;
+	}
+}
+
+TEST_CASE("Streaming plan loads the nearest cells in range and unloads past the margin", "[streaming]")
+{
+	const std::vector<StreamingCell> cells = {CellAt(30.0f), CellAt(5.0f), CellAt(12.0f), CellAt(60.0f)};
+
+	SECTION("Cells in range load nearest first, capped per frame")
+	{
+		const std::vector<CellResidency> residency(cells.size(), CellResidency::Unloaded);
+		StreamingPlan plan = WorldPartition::PlanStreaming(cells, residency, Settings(20.0f, 40.0f));
+		CHECK(plan.Load == std::vector<uint32_t>{1, 2});
+		CHECK(plan.Unload.empty());
+
+		plan = WorldPartition::PlanStreaming(cells, residency, Settings(20.0f, 40.0f, 1000000, 1));
+		CHECK(plan.Load == std::vector<uint32_t>{1});
+	}
+
+	SECTION("A resident cell stays until it is past the unload radius")
+	{
+		std::vector<CellResidency> residency(cells.size(), CellResidency::Loaded);
+		const StreamingPlan plan = WorldPartition::PlanStreaming(cells, residency, Settings(20.0f, 40.0f));
+		CHECK(plan.Load.empty());
+		CHECK(plan.Unload == std::vector<uint32_t>{3}); // 30 is inside the margin band, 60 is not
+	}
+
+	SECTION("Over budget, the farthest cells lose out")
+	{
+		std::vector<CellResidency> residency(cells.size(), CellResidency::Unloaded);
+		residency[2] = CellResidency::Loaded; // at 12
+		const std::vector<StreamingCell> heavy = {CellAt(30.0f), CellAt(5.0f, 600), CellAt(12.0f, 600), CellAt(60.0f)};
+		const StreamingPlan plan = WorldPartition::PlanStreaming(heavy, residency, Settings(20.0f, 40.0f, 1000));
+		CHECK(plan.Load == std::vector<uint32_t>{1});
+		CHECK(plan.Unload == std::vector<uint32_t>{2});
+	}
+
+	SECTION("Distance ignores height and is zero inside the bounds")
+	{
+		CHECK(WorldPartition::DistanceToCell(cells[1], {5.2f, 500.0f, 0.0f}) == 0.0f);
+		CHECK(WorldPartition::DistanceToCell(cells[1], {5.0f, 0.0f, 3.5f}) == 3.0f);
+	}
+}
+
+TEST_CASE("A split world streams its cells in and out around the camera", "[streaming]")
+{
+	const ScratchDirectory scratch("Snowstorm-WorldPartitionTests");
+	const std::filesystem::path& dir = scratch.GetPath();
+	const std::filesystem::path manifestPath = dir / "Map.sspartition";
+
+	{
+		World source;
+		Entity camera = source.CreateEntity("Camera");
+		camera.AddComponent<TransformComponent>();
+		camera.AddComponent<CameraComponent>();
+		for (int i = 0; i < 40; ++i)
+		{
+			source.CreateEntity("Near").AddComponent<TransformComponent>().Position = {static_cast<float>(i), 0.0f, 10.0f};
+			source.CreateEntity("Far").AddComponent<TransformComponent>().Position = {5000.0f + static_cast<float>(i), 0.0f, 10.0f};
+		}
+		source.CreateEntity("Settings"); // no transform: persistent
+		REQUIRE(WorldPartition::Split(source, 64.0f, manifestPath));
+	}
+
+	const std::optional<WorldPartitionManifest> manifest = WorldPartition::LoadManifest(manifestPath);
+	REQUIRE(manifest);
+	CHECK(manifest->CellSize == 64.0f);
+	REQUIRE(manifest->Cells.size() == 2);
+	for (const StreamingCell& cell : manifest->Cells)
+	{
+		CHECK(cell.EntityCount == 40);
+		CHECK(cell.MemoryBytes > 0);
+		CHECK(std::filesystem::exists(dir / cell.File));
+	}
+
+	World world;
+	auto& streaming = world.GetSingleton<LevelStreamingSingleton>();
+	REQUIRE(streaming.Open(manifestPath));
+	CHECK(CountTagged(world, "Camera") == 1);
+	CHECK(CountTagged(world, "Settings") == 1);
+	CHECK(CountTagged(world, "Near") == 0);
+
+	// No JobSystem: cells decode inline and commit the same frame (40 entities fit one frame's slice).
+	streaming.Update({0.0f, 0.0f, 0.0f}, nullptr);
+	CHECK(CountTagged(world, "Near") == 40);
+	CHECK(CountTagged(world, "Far") == 0);
+
+	// Fly to the far cluster: the near cell unloads (its entities go at the end of the frame), the far one loads.
+	streaming.Update({5000.0f, 0.0f, 0.0f}, nullptr);
+	world.FlushDestroyQueue();
+	CHECK(CountTagged(world, "Near") == 0);
+	CHECK(CountTagged(world, "Far") == 40);
+
+	// Closing removes everything the partition created, persistent scene included.
+	streaming.Close();
+	world.FlushDestroyQueue();
+	CHECK(CountTagged(world, "Far") == 0);
+	CHECK(CountTagged(world, "Camera") == 0);
+	CHECK_FALSE(streaming.IsOpen());
+}
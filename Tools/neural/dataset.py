@@ -8,6 +8,12 @@ The engine's dataset.export writes, per frame along the scripted camera path:
     frame_*_gt.npy     -> (h,  w,  4) float16  full-res HDR ground truth (linear)
     frame_*_gt_ldr.npy -> (h,  w,  4) uint8    full-res tonemapped LDR ground truth (sRGB bytes) (#102)
 
+With dataset.export.shard > 0 and/or dataset.export.compression set, the manifest is
+"snowstorm-sr-dataset-v2": the arrays live as members of shard_*.tar archives (each entry adds
+"shard", "offset", "bytes" — the member's data position, so no tar scan is needed) and/or are stored
+zstd/LZ4-compressed (entry adds "compression", "raw_bytes"; file names gain .zst/.lz4). load_array
+handles every layout; the `zstandard` / `lz4` packages are only needed for compressed sets.
+
 Two loaders: SRCropDataset (single-frame, spatial #47/#102) and SRSequenceDataset (consecutive-frame
 windows with the mv channel, for the recurrent temporal upscaler #98).
 
@@ -21,6 +27,7 @@ upsampled by 1/scale). Cropping keeps training fast and gives many samples per f
 
 from __future__ import annotations
 
+import io
 import json
 import os
 import random
@@ -30,21 +37,43 @@ import torch
 from torch.utils.data import Dataset
 
 
-def _load_rgb(path: str) -> np.ndarray:
-    """Load an (H,W,4) float16 HDR .npy as an (H,W,3) float32 array (drop alpha)."""
-    a = np.load(path).astype(np.float32)
+def load_array(root: str, desc: dict) -> np.ndarray:
+    """Load one manifest array entry (e.g. frame["lr"]), loose or sharded, raw or compressed."""
+    if "shard" in desc:
+        with open(os.path.join(root, desc["shard"]), "rb") as f:
+            f.seek(desc["offset"])
+            data = f.read(desc["bytes"])
+    else:
+        with open(os.path.join(root, desc["file"]), "rb") as f:
+            data = f.read()
+
+    codec = desc.get("compression", "none")
+    if codec == "zstd":
+        import zstandard
+        data = zstandard.ZstdDecompressor().decompress(data)
+    elif codec == "lz4":
+        import lz4.frame
+        data = lz4.frame.decompress(data)
+    elif codec != "none":
+        raise ValueError(f"{desc['file']}: unknown compression '{codec}'")
+    return np.load(io.BytesIO(data))
+
+
+def _load_rgb(root: str, desc: dict) -> np.ndarray:
+    """Load an (H,W,4) float16 HDR array as an (H,W,3) float32 array (drop alpha)."""
+    a = load_array(root, desc).astype(np.float32)
     return a[..., :3]
 
 
-def _load_rgb_ldr(path: str) -> np.ndarray:
-    """Load an (H,W,4) uint8 sRGB .npy as an (H,W,3) float32 array in [0,1] (drop alpha, /255)."""
-    a = np.load(path).astype(np.float32) / 255.0
+def _load_rgb_ldr(root: str, desc: dict) -> np.ndarray:
+    """Load an (H,W,4) uint8 sRGB array as an (H,W,3) float32 array in [0,1] (drop alpha, /255)."""
+    a = load_array(root, desc).astype(np.float32) / 255.0
     return a[..., :3]
 
 
-def _load_mv(path: str) -> np.ndarray:
-    """Load an (H,W,4) float16 motion-vector .npy as an (H,W,2) float32 array (.xy = curr_uv - prev_uv)."""
-    a = np.load(path).astype(np.float32)
+def _load_mv(root: str, desc: dict) -> np.ndarray:
+    """Load an (H,W,4) float16 motion-vector array as an (H,W,2) float32 array (.xy = curr_uv - prev_uv)."""
+    a = load_array(root, desc).astype(np.float32)
     return a[..., :2]
 
 
@@ -76,11 +105,11 @@ class SRCropDataset(Dataset):
         all_lr, all_gt, all_meta = [], [], []
         dropped = 0
         for f in frames:
-            gt_ldr = _load_rgb_ldr(os.path.join(root, f["gt_ldr"]["file"]))
+            gt_ldr = _load_rgb_ldr(root, f["gt_ldr"])
             if float(gt_ldr.max()) < 1e-4:
                 dropped += 1
                 continue
-            all_lr.append(_load_rgb(os.path.join(root, f["lr"]["file"])))
+            all_lr.append(_load_rgb(root, f["lr"]))
             all_gt.append(gt_ldr)
             all_meta.append(f)
         if not all_lr:
@@ -178,12 +207,12 @@ class SRSequenceDataset(Dataset):
         lr, mv, gt = [], [], []
         dropped = 0
         for f in frames:
-            g = _load_rgb_ldr(os.path.join(root, f["gt_ldr"]["file"]))
+            g = _load_rgb_ldr(root, f["gt_ldr"])
             if float(g.max()) < 1e-4:
                 dropped += 1
                 continue
-            lr.append(_load_rgb(os.path.join(root, f["lr"]["file"])))
-            mv.append(_load_mv(os.path.join(root, f["mv"]["file"])))
+            lr.append(_load_rgb(root, f["lr"]))
+            mv.append(_load_mv(root, f["mv"]))
             gt.append(g)
         if len(lr) < seq + 1:
             raise ValueError(f"{root}: only {len(lr)} usable frames, need >= {seq + 1} for seq={seq}")
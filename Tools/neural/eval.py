@@ -22,6 +22,7 @@ import numpy as np
 import torch
 import torch.nn.functional as F
 
+from dataset import load_array
 from model import ResidualRefiner
 from ssnn import load_ssnn
 from tonemap import to_display
@@ -39,15 +40,15 @@ def psnr(mse: float) -> float:
 
 
 def _load_lr(dataset, fr):
-    return np.load(os.path.join(dataset, fr["lr"]["file"])).astype(np.float32)[..., :3]
+    return load_array(dataset, fr["lr"]).astype(np.float32)[..., :3]
 
 
 def _load_gt(dataset, fr):
-    return np.load(os.path.join(dataset, fr["gt_ldr"]["file"])).astype(np.float32)[..., :3] / 255.0
+    return load_array(dataset, fr["gt_ldr"]).astype(np.float32)[..., :3] / 255.0
 
 
 def _load_mv(dataset, fr):
-    return np.load(os.path.join(dataset, fr["mv"]["file"])).astype(np.float32)[..., :2]
+    return load_array(dataset, fr["mv"]).astype(np.float32)[..., :2]
 
 
 def eval_spatial(model, dataset, frames, device, margin):
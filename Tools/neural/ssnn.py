@@ -16,6 +16,14 @@ Format (little-endian, tightly packed):
         uint32  activation      # 0 = none, 1 = ReLU
         float32[out*in*kh*kw]   weights, laid out [outC][inC][kH][kW]  (PyTorch conv weight order)
         float32[out]            bias
+
+Version 2 (written by the engine's post-training quantizer, Snowstorm-NeuralQuantize) adds a uint32
+storage tag after `activation` (0 = float32, 1 = float16, 2 = int8) and stores the weight block as:
+    float32: float32 weights, float32[out] bias
+    float16: float16 weights, float32[out] bias
+    int8:    int8 weights, float32[out] per-channel scales, float32 input scale, uint32 input zero point,
+             float32[out] bias
+load_ssnn reads both versions, returning dequantized float weights; save_ssnn always writes version 1.
 """
 
 from __future__ import annotations
@@ -25,6 +33,11 @@ from dataclasses import dataclass
 
 MAGIC = b"SSNN"
 VERSION = 1
+VERSION_QUANTIZED = 2
+
+STORAGE_FLOAT32 = 0
+STORAGE_FLOAT16 = 1
+STORAGE_INT8 = 2
 
 ACT_NONE = 0
 ACT_RELU = 1
@@ -65,16 +78,33 @@ def load_ssnn(path: str) -> list[Layer]:
     off = 4
     version, layer_count = struct.unpack_from("<II", data, off)
     off += 8
-    if version != VERSION:
+    if version not in (VERSION, VERSION_QUANTIZED):
         raise ValueError(f"{path}: unsupported version {version}")
 
     layers: list[Layer] = []
     for _ in range(layer_count):
         in_c, out_c, k, act = struct.unpack_from("<IIII", data, off)
         off += 16
+        storage = STORAGE_FLOAT32
+        if version == VERSION_QUANTIZED:
+            (storage,) = struct.unpack_from("<I", data, off)
+            off += 4
         wn = out_c * in_c * k * k
-        weights = list(struct.unpack_from(f"<{wn}f", data, off))
-        off += wn * 4
+        if storage == STORAGE_FLOAT32:
+            weights = list(struct.unpack_from(f"<{wn}f", data, off))
+            off += wn * 4
+        elif storage == STORAGE_FLOAT16:
+            weights = list(struct.unpack_from(f"<{wn}e", data, off))
+            off += wn * 2
+        elif storage == STORAGE_INT8:
+            codes = struct.unpack_from(f"<{wn}b", data, off)
+            off += wn
+            scales = struct.unpack_from(f"<{out_c}f", data, off)
+            off += out_c * 4 + 8  # + input scale, input zero point (activation quantization; not needed here)
+            per_oc = wn // out_c if out_c else 0
+            weights = [c * scales[i // per_oc] for i, c in enumerate(codes)]
+        else:
+            raise ValueError(f"{path}: unknown weight storage {storage}")
         bias = list(struct.unpack_from(f"<{out_c}f", data, off))
         off += out_c * 4
         layers.append(Layer(in_c, out_c, k, act, weights, bias))